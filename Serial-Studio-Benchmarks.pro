@@ -0,0 +1,48 @@
+#
+# Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+
+#-----------------------------------------------------------------------------------------
+# Pipeline micro-benchmark harness (see benchmarks/Benchmarks.cpp)
+#
+# The benchmark target shares the application sources & libraries with the main
+# project, only the entry point is replaced. Build & run with:
+#
+#   qmake Serial-Studio-Benchmarks.pro && make
+#   ./serial-studio-benchmarks
+#-----------------------------------------------------------------------------------------
+
+include(Serial-Studio.pro)
+
+TARGET = serial-studio-benchmarks
+
+# Replace the application entry point with the benchmark harness, the benchmarks
+# always build in the regular (non-unity) configuration so that the harness can
+# link against the individual translation units
+CONFIG  -= unity_build
+DEFINES -= UNITY_BUILD=1
+SOURCES -= src/main.cpp
+SOURCES -= src/SingleCompilationUnit.cpp
+SOURCES += benchmarks/Benchmarks.cpp
+
+# Disable the installation targets inherited from the main project, the benchmark
+# binary is meant to run from the build directory
+INSTALLS =
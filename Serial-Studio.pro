@@ -49,6 +49,7 @@ QT += core
 QT += quick
 QT += widgets
 QT += serialport
+QT += websockets
 QT += printsupport
 QT += quickcontrols2
 
@@ -62,7 +63,7 @@ DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x050F00
 # Compiler options
 #-----------------------------------------------------------------------------------------
 
-CONFIG += c++11
+CONFIG += c++14
 CONFIG += silent
 
 CONFIG(debug, debug|release) {
@@ -73,6 +74,11 @@ CONFIG(debug, debug|release) {
 CONFIG(release, debug|release) {
     CONFIG += unity_build
 
+    # Let the compiler vectorize the numeric hot loops (FFT passes, plot
+    # decimation) with the baseline SIMD instruction set of the target
+    # architecture (SSE2 on x86_64, NEON on ARM64)
+    *g++*|*clang*: QMAKE_CXXFLAGS_RELEASE *= -O3 -ftree-vectorize
+
     *msvc*: {
         QMAKE_CXXFLAGS *= -MP
         INCLUDEPATH += $$OUT_PWD
@@ -87,6 +93,54 @@ CONFIG(unity_build) {
     SOURCES += src/SingleCompilationUnit.cpp    # Include single compilation unit in code
 }
 
+#-----------------------------------------------------------------------------------------
+# Precompiled headers
+#-----------------------------------------------------------------------------------------
+
+# Share one precompiled header between every translation unit. The Qt-heavy
+# bundled libraries & the (incremental) debug builds compile file-by-file, so
+# re-parsing the Qt module headers dominates their compile time otherwise.
+CONFIG += precompile_header
+PRECOMPILED_HEADER = src/PrecompiledHeaders.h
+
+#-----------------------------------------------------------------------------------------
+# Profile-guided optimization
+#-----------------------------------------------------------------------------------------
+
+# Two-phase release build: compile an instrumented binary, run the bundled training
+# workload (replays representative synthetic captures through the full ingestion
+# pipeline, see src/PgoTraining.cpp) & rebuild with the recorded profile plus full
+# link-time optimization. Use "make clean" (not distclean) between the phases so
+# that the profile data written next to the object files survives:
+#
+#   qmake Serial-Studio.pro CONFIG+=pgo_generate && make
+#   ./serial-studio --pgo-train
+#   make clean && qmake Serial-Studio.pro CONFIG+=pgo_use && make
+
+CONFIG(pgo_generate) {
+    *g++*|*clang* {
+        QMAKE_CXXFLAGS += -fprofile-generate
+        QMAKE_LFLAGS   += -fprofile-generate
+    }
+
+    # The pipeline threads bump the same counters, keep the updates atomic so the
+    # profile is not skewed by lost increments
+    *g++*: QMAKE_CXXFLAGS += -fprofile-update=atomic
+}
+
+CONFIG(pgo_use) {
+    CONFIG += ltcg
+
+    *g++*|*clang* {
+        QMAKE_CXXFLAGS += -fprofile-use
+        QMAKE_LFLAGS   += -fprofile-use
+    }
+
+    # main() of the training run exits before some cold paths execute, tolerate
+    # partial & slightly inconsistent profiles instead of failing the build
+    *g++*: QMAKE_CXXFLAGS += -fprofile-correction -Wno-missing-profile
+}
+
 #-----------------------------------------------------------------------------------------
 # Serial Studio compile-time settings
 #-----------------------------------------------------------------------------------------
@@ -154,38 +208,69 @@ INCLUDEPATH += src
 
 HEADERS += \
     src/AppInfo.h \
+    src/CSV/ColumnarExport.h \
     src/CSV/Export.h \
     src/CSV/Player.h \
     src/DataTypes.h \
+    src/IO/Capture.h \
     src/IO/Checksum.h \
+    src/IO/CircularBuffer.h \
     src/IO/Console.h \
+    src/IO/DataSources/Generator.h \
     src/IO/DataSources/Network.h \
     src/IO/DataSources/Serial.h \
+    src/IO/DataSources/WebSocket.h \
+    src/IO/DataSources/Relay.h \
+    src/IO/FrameQueue.h \
+    src/IO/FrameReader.h \
     src/IO/Manager.h \
+    src/IO/Pipeline.h \
+    src/IO/Replay.h \
+    src/IO/SequenceMatcher.h \
     src/JSON/Dataset.h \
     src/JSON/Editor.h \
+    src/JSON/Expressions.h \
     src/JSON/Frame.h \
+    src/JSON/FrameParser.h \
     src/JSON/Generator.h \
     src/JSON/Group.h \
+    src/JSON/StringPool.h \
     src/MQTT/Client.h \
+    src/Misc/Clock.h \
+    src/Misc/LatencyTracer.h \
     src/Misc/MacExtras.h \
+    src/Misc/MemoryRegistry.h \
     src/Misc/ModuleManager.h \
+    src/Misc/SessionSnapshot.h \
+    src/Misc/SettingsCache.h \
     src/Misc/ThemeManager.h \
+    src/Misc/ThreadPolicy.h \
+    src/Misc/Watchdog.h \
     src/Misc/TimerEvents.h \
     src/Misc/Translator.h \
     src/Misc/Utilities.h \
+    src/PgoTraining.h \
     src/Plugins/Server.h \
+    src/UI/Alarms.h \
     src/UI/Dashboard.h \
     src/UI/DashboardWidget.h \
     src/UI/DeclarativeWidget.h \
+    src/UI/HistoryStore.h \
+    src/UI/PaintProfiler.h \
+    src/UI/PlotBuffer.h \
+    src/UI/QuickPlot.h \
+    src/UI/Statistics.h \
     src/UI/Widgets/Terminal.h \
     src/UI/Widgets/Accelerometer.h \
     src/UI/Widgets/Bar.h \
     src/UI/Widgets/Common/AnalogGauge.h \
     src/UI/Widgets/Common/AttitudeIndicator.h \
     src/UI/Widgets/Common/BaseWidget.h \
+    src/UI/Widgets/Common/ConsoleView.h \
     src/UI/Widgets/Common/ElidedLabel.h \
+    src/UI/Widgets/Common/FFTPlanCache.h \
     src/UI/Widgets/Common/KLed.h \
+    src/UI/Widgets/Common/PlotSeriesData.h \
     src/UI/Widgets/Compass.h \
     src/UI/Widgets/DataGroup.h \
     src/UI/Widgets/FFTPlot.h \
@@ -194,40 +279,72 @@ HEADERS += \
     src/UI/Widgets/Gyroscope.h \
     src/UI/Widgets/LEDPanel.h \
     src/UI/Widgets/MultiPlot.h \
-    src/UI/Widgets/Plot.h
+    src/UI/Widgets/Plot.h \
+    src/UI/Widgets/Spectrogram.h
 
 SOURCES += \
+    src/CSV/ColumnarExport.cpp \
     src/CSV/Export.cpp \
     src/CSV/Player.cpp \
+    src/IO/Capture.cpp \
     src/IO/Checksum.cpp \
+    src/IO/CircularBuffer.cpp \
     src/IO/Console.cpp \
+    src/IO/DataSources/Generator.cpp \
     src/IO/DataSources/Network.cpp \
     src/IO/DataSources/Serial.cpp \
+    src/IO/DataSources/WebSocket.cpp \
+    src/IO/DataSources/Relay.cpp \
+    src/IO/FrameQueue.cpp \
+    src/IO/FrameReader.cpp \
     src/IO/Manager.cpp \
+    src/IO/Pipeline.cpp \
+    src/IO/Replay.cpp \
+    src/IO/SequenceMatcher.cpp \
     src/JSON/Dataset.cpp \
     src/JSON/Editor.cpp \
+    src/JSON/Expressions.cpp \
     src/JSON/Frame.cpp \
+    src/JSON/FrameParser.cpp \
     src/JSON/Generator.cpp \
     src/JSON/Group.cpp \
+    src/JSON/StringPool.cpp \
     src/MQTT/Client.cpp \
+    src/Misc/Clock.cpp \
+    src/Misc/LatencyTracer.cpp \
     src/Misc/MacExtras.cpp \
+    src/Misc/MemoryRegistry.cpp \
     src/Misc/ModuleManager.cpp \
+    src/Misc/SessionSnapshot.cpp \
+    src/Misc/SettingsCache.cpp \
     src/Misc/ThemeManager.cpp \
+    src/Misc/ThreadPolicy.cpp \
+    src/Misc/Watchdog.cpp \
     src/Misc/TimerEvents.cpp \
     src/Misc/Translator.cpp \
     src/Misc/Utilities.cpp \
+    src/PgoTraining.cpp \
     src/Plugins/Server.cpp \
+    src/UI/Alarms.cpp \
     src/UI/Dashboard.cpp \
     src/UI/DashboardWidget.cpp \
     src/UI/DeclarativeWidget.cpp \
+    src/UI/HistoryStore.cpp \
+    src/UI/PaintProfiler.cpp \
+    src/UI/PlotBuffer.cpp \
+    src/UI/QuickPlot.cpp \
+    src/UI/Statistics.cpp \
     src/UI/Widgets/Terminal.cpp \
     src/UI/Widgets/Accelerometer.cpp \
     src/UI/Widgets/Bar.cpp \
     src/UI/Widgets/Common/AnalogGauge.cpp \
     src/UI/Widgets/Common/AttitudeIndicator.cpp \
     src/UI/Widgets/Common/BaseWidget.cpp \
+    src/UI/Widgets/Common/ConsoleView.cpp \
     src/UI/Widgets/Common/ElidedLabel.cpp \
+    src/UI/Widgets/Common/FFTPlanCache.cpp \
     src/UI/Widgets/Common/KLed.cpp \
+    src/UI/Widgets/Common/PlotSeriesData.cpp \
     src/UI/Widgets/Compass.cpp \
     src/UI/Widgets/DataGroup.cpp \
     src/UI/Widgets/FFTPlot.cpp \
@@ -237,6 +354,7 @@ SOURCES += \
     src/UI/Widgets/LEDPanel.cpp \
     src/UI/Widgets/MultiPlot.cpp \
     src/UI/Widgets/Plot.cpp \
+    src/UI/Widgets/Spectrogram.cpp \
     src/main.cpp
 
 #-----------------------------------------------------------------------------------------
@@ -80,6 +80,25 @@ Rectangle {
             Layout.fillWidth: true
         }
 
+        Button {
+            flat: true
+            id: alarmBt
+            font.bold: true
+            visible: Cpp_UI_Alarms.count > 0
+            Layout.alignment: Qt.AlignVCenter
+            icon.source: "qrc:/icons/warning.svg"
+            onClicked: Cpp_UI_Alarms.acknowledge()
+            icon.color: "#d72d60"
+            palette.buttonText: "#d72d60"
+            palette.button: Cpp_ThemeManager.windowGradient1
+            palette.window: Cpp_ThemeManager.windowGradient1
+            text: qsTr("Alarms") + " (" + Cpp_UI_Alarms.count + ")"
+
+            ToolTip.delay: 500
+            ToolTip.visible: hovered
+            ToolTip.text: Cpp_UI_Alarms.alarms.join("\n")
+        }
+
         Button {
             flat: true
             id: consoleBt
@@ -25,6 +25,8 @@ import QtQuick.Layouts 1.3
 import QtQuick.Controls 2.3
 import Qt.labs.settings 1.0
 
+import SerialStudio 1.0
+
 import "../Widgets" as Widgets
 
 Widgets.Window {
@@ -78,6 +80,10 @@ Widgets.Window {
         property alias points: plotPoints.value
         property alias widgetSize: widgetSize.value
         property alias decimalPlaces: decimalPlaces.value
+        property alias targetFramerate: targetFramerate.value
+        property alias groupUpdateRate: groupUpdateRate.value
+        property alias fftDecibels: fftDecibels.checked
+        property alias hardwareAcceleration: openGL.checked
     }
 
     //
@@ -200,6 +206,129 @@ Widgets.Window {
                     Layout.fillWidth: true
                     onValueChanged: widgetSizeChanged(value)
                 } Item {}
+
+                //
+                // Target framerate
+                //
+                Label {
+                    text: qsTr("Target framerate:")
+                } Slider {
+                    id: targetFramerate
+                    to: 60
+                    from: 5
+                    value: 20
+                    stepSize: 5
+                    Layout.fillWidth: true
+                    onValueChanged: Cpp_Misc_TimerEvents.targetFramerate = value
+                } Label {
+                    text: Cpp_Misc_TimerEvents.targetFramerate + " Hz"
+                }
+
+                //
+                // Update rate of the text-heavy widgets
+                //
+                Label {
+                    text: qsTr("Text widget update rate:")
+                    visible: Cpp_UI_Dashboard.groupCount > 0 || Cpp_UI_Dashboard.ledCount > 0 || Cpp_UI_Dashboard.barCount > 0
+                } Slider {
+                    id: groupUpdateRate
+                    to: 20
+                    from: 1
+                    value: 5
+                    stepSize: 1
+                    Layout.fillWidth: true
+                    visible: Cpp_UI_Dashboard.groupCount > 0 || Cpp_UI_Dashboard.ledCount > 0 || Cpp_UI_Dashboard.barCount > 0
+                    onValueChanged: Cpp_UI_Dashboard.groupUpdateRate = value
+                } Label {
+                    text: Cpp_UI_Dashboard.groupUpdateRate + " Hz"
+                    visible: Cpp_UI_Dashboard.groupCount > 0 || Cpp_UI_Dashboard.ledCount > 0 || Cpp_UI_Dashboard.barCount > 0
+                }
+
+                //
+                // Oscilloscope-style plot trigger
+                //
+                Label {
+                    text: qsTr("Trigger mode:")
+                    visible: Cpp_UI_Dashboard.plotCount > 0
+                } CheckBox {
+                    id: triggerMode
+                    checked: false
+                    Layout.leftMargin: -app.spacing
+                    visible: Cpp_UI_Dashboard.plotCount > 0
+                    onCheckedChanged: {
+                        if (Cpp_UI_Dashboard.triggerEnabled !== checked)
+                            Cpp_UI_Dashboard.triggerEnabled = checked
+                    }
+                } Item {}
+
+                Label {
+                    text: qsTr("Trigger source:")
+                    visible: triggerMode.checked && Cpp_UI_Dashboard.plotCount > 0
+                } ComboBox {
+                    Layout.fillWidth: true
+                    model: Cpp_UI_Dashboard.plotTitles
+                    visible: triggerMode.checked && Cpp_UI_Dashboard.plotCount > 0
+                    onCurrentIndexChanged: Cpp_UI_Dashboard.triggerDataset = currentIndex
+                } Item {}
+
+                Label {
+                    text: qsTr("Trigger level:")
+                    visible: triggerMode.checked && Cpp_UI_Dashboard.plotCount > 0
+                } TextField {
+                    text: "0"
+                    Layout.fillWidth: true
+                    visible: triggerMode.checked && Cpp_UI_Dashboard.plotCount > 0
+                    validator: DoubleValidator {}
+                    onTextChanged: {
+                        var level = parseFloat(text)
+                        if (!isNaN(level))
+                            Cpp_UI_Dashboard.triggerLevel = level
+                    }
+                } Item {}
+
+                Label {
+                    text: qsTr("Trigger slope:")
+                    visible: triggerMode.checked && Cpp_UI_Dashboard.plotCount > 0
+                } ComboBox {
+                    Layout.fillWidth: true
+                    visible: triggerMode.checked && Cpp_UI_Dashboard.plotCount > 0
+                    model: [qsTr("Rising edge"), qsTr("Falling edge")]
+                    onCurrentIndexChanged: Cpp_UI_Dashboard.triggerRisingEdge = (currentIndex === 0)
+                } Item {}
+
+                //
+                // FFT decibel scale
+                //
+                Label {
+                    text: qsTr("FFT in decibels:")
+                    visible: Cpp_UI_Dashboard.fftCount > 0
+                } CheckBox {
+                    id: fftDecibels
+                    checked: false
+                    Layout.leftMargin: -app.spacing
+                    visible: Cpp_UI_Dashboard.fftCount > 0
+                    onCheckedChanged: {
+                        if (Cpp_UI_Dashboard.fftDecibels !== checked)
+                            Cpp_UI_Dashboard.fftDecibels = checked
+                    }
+                } Item {}
+
+                //
+                // OpenGL plot rendering
+                //
+                Label {
+                    text: qsTr("Hardware acceleration:")
+                    visible: Cpp_UI_Dashboard.plotCount > 0 || Cpp_UI_Dashboard.multiPlotCount > 0 || Cpp_UI_Dashboard.fftCount > 0
+                } CheckBox {
+                    id: openGL
+                    checked: false
+                    Layout.leftMargin: -app.spacing
+                    visible: Cpp_UI_Dashboard.plotCount > 0 || Cpp_UI_Dashboard.multiPlotCount > 0 || Cpp_UI_Dashboard.fftCount > 0
+                    onCheckedChanged: {
+                        if (Cpp_UI_Dashboard.hardwareAcceleration !== checked)
+                            Cpp_UI_Dashboard.hardwareAcceleration = checked
+                    }
+                } Item {}
             }
 
             //
@@ -215,6 +344,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("Datasets")
                 icon: "qrc:/icons/group.svg"
+                widgetFamily: Dashboard.Group
                 count: Cpp_UI_Dashboard.groupCount
                 titles: Cpp_UI_Dashboard.groupTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setGroupVisible(index, checked)
@@ -226,6 +356,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("Multiple data plots")
                 icon: "qrc:/icons/multiplot.svg"
+                widgetFamily: Dashboard.MultiPlot
                 count: Cpp_UI_Dashboard.multiPlotCount
                 titles: Cpp_UI_Dashboard.multiPlotTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setMultiplotVisible(index, checked)
@@ -237,6 +368,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("LED Panels")
                 icon: "qrc:/icons/led.svg"
+                widgetFamily: Dashboard.LED
                 count: Cpp_UI_Dashboard.ledCount
                 titles: Cpp_UI_Dashboard.ledTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setLedVisible(index, checked)
@@ -248,17 +380,31 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("FFT plots")
                 icon: "qrc:/icons/fft.svg"
+                widgetFamily: Dashboard.FFT
                 count: Cpp_UI_Dashboard.fftCount
                 titles: Cpp_UI_Dashboard.fftTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setFFTVisible(index, checked)
             }
 
+            //
+            // Spectrograms
+            //
+            ViewOptionsDelegate {
+                title: qsTr("Spectrograms")
+                icon: "qrc:/icons/fft.svg"
+                widgetFamily: Dashboard.Spectrogram
+                count: Cpp_UI_Dashboard.spectrogramCount
+                titles: Cpp_UI_Dashboard.spectrogramTitles
+                onCheckedChanged: Cpp_UI_Dashboard.setSpectrogramVisible(index, checked)
+            }
+
             //
             // Plots
             //
             ViewOptionsDelegate {
                 title: qsTr("Data plots")
                 icon: "qrc:/icons/plot.svg"
+                widgetFamily: Dashboard.Plot
                 count: Cpp_UI_Dashboard.plotCount
                 titles: Cpp_UI_Dashboard.plotTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setPlotVisible(index, checked)
@@ -270,6 +416,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("Bars")
                 icon: "qrc:/icons/bar.svg"
+                widgetFamily: Dashboard.Bar
                 count: Cpp_UI_Dashboard.barCount
                 titles: Cpp_UI_Dashboard.barTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setBarVisible(index, checked)
@@ -281,6 +428,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("Gauges")
                 icon: "qrc:/icons/gauge.svg"
+                widgetFamily: Dashboard.Gauge
                 count: Cpp_UI_Dashboard.gaugeCount
                 titles: Cpp_UI_Dashboard.gaugeTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setGaugeVisible(index, checked)
@@ -292,6 +440,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("Compasses")
                 icon: "qrc:/icons/compass.svg"
+                widgetFamily: Dashboard.Compass
                 count: Cpp_UI_Dashboard.compassCount
                 titles: Cpp_UI_Dashboard.compassTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setCompassVisible(index, checked)
@@ -303,6 +452,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("Gyroscopes")
                 icon: "qrc:/icons/gyro.svg"
+                widgetFamily: Dashboard.Gyroscope
                 count: Cpp_UI_Dashboard.gyroscopeCount
                 titles: Cpp_UI_Dashboard.gyroscopeTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setGyroscopeVisible(index, checked)
@@ -314,6 +464,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("Accelerometers")
                 icon: "qrc:/icons/accelerometer.svg"
+                widgetFamily: Dashboard.Accelerometer
                 count: Cpp_UI_Dashboard.accelerometerCount
                 titles: Cpp_UI_Dashboard.accelerometerTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setAccelerometerVisible(index, checked)
@@ -325,6 +476,7 @@ Widgets.Window {
             ViewOptionsDelegate {
                 title: qsTr("GPS")
                 icon: "qrc:/icons/gps.svg"
+                widgetFamily: Dashboard.GPS
                 count: Cpp_UI_Dashboard.gpsCount
                 titles: Cpp_UI_Dashboard.gpsTitles
                 onCheckedChanged: Cpp_UI_Dashboard.setGpsVisible(index, checked)
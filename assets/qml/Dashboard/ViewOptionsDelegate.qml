@@ -14,6 +14,13 @@ ColumnLayout {
     property string icon: ""
     property string title: ""
 
+    //
+    // Widget family (Dashboard.WidgetType value) of this group, used to
+    // detach the whole group into its own dashboard window. Groups that do
+    // not set it hide the detach button.
+    //
+    property int widgetFamily: -1
+
     signal checkedChanged(var index, var checked)
 
     Connections {
@@ -46,6 +53,22 @@ ColumnLayout {
             Layout.fillWidth: true
         }
 
+        RoundButton {
+            id: detach
+            width: 24
+            height: 24
+            flat: true
+            icon.color: palette.text
+            visible: root.widgetFamily >= 0
+            icon.source: "qrc:/icons/expand.svg"
+            onClicked: {
+                if (windowLoader.active)
+                    windowLoader.item.showNormal()
+                else
+                    windowLoader.active = true
+            }
+        }
+
         RoundButton {
             id: hideAll
             width: 24
@@ -62,6 +85,23 @@ ColumnLayout {
         }
     }
 
+    //
+    // Detached window with every widget of this group, created on demand &
+    // rendered by its own render thread (see WidgetGroupWindow.qml)
+    //
+    Loader {
+        id: windowLoader
+
+        active: false
+        asynchronous: true
+
+        sourceComponent: WidgetGroupWindow {
+            familyTitle: root.title
+            widgetFamily: root.widgetFamily
+            Component.onCompleted: showNormal()
+        }
+    }
+
     Repeater {
         model: hideAll.checked ? 0 : root.count
         delegate: Switch {
@@ -35,11 +35,19 @@ Item {
     property int widgetIndex: -1
     property FramelessWindow.CustomWindow externalWindow: null
 
+    //
+    // Plain plot widgets are rendered through the scene graph plot item,
+    // which uploads the curve as vertex data instead of rasterizing a Qwt
+    // canvas into a pixmap. Everything else goes through the widget bridge.
+    //
+    readonly property bool nativePlot: widgetIndex >= 0 &&
+                                       Cpp_UI_Dashboard.useQuickPlot(widgetIndex)
+
     Widgets.Window {
         id: window
         anchors.fill: parent
-        title: widget.widgetTitle
-        icon.source: widget.widgetIcon
+        title: root.nativePlot ? quickPlot.widgetTitle : widget.widgetTitle
+        icon.source: root.nativePlot ? quickPlot.widgetIcon : widget.widgetIcon
         headerDoubleClickEnabled: true
         borderColor: Cpp_ThemeManager.widgetWindowBorder
         onHeaderDoubleClicked: {
@@ -51,7 +59,8 @@ Item {
 
         DashboardWidget {
             id: widget
-            widgetIndex: root.widgetIndex
+            visible: !root.nativePlot
+            widgetIndex: root.nativePlot ? -1 : root.widgetIndex
             anchors {
                 fill: parent
                 leftMargin: window.borderWidth
@@ -59,6 +68,84 @@ Item {
                 bottomMargin: window.borderWidth
             }
         }
+
+        QuickPlot {
+            id: quickPlot
+            visible: root.nativePlot
+            widgetIndex: root.nativePlot ? root.widgetIndex : -1
+            anchors {
+                fill: parent
+                margins: 24
+                leftMargin: window.borderWidth + 24
+                rightMargin: window.borderWidth + 24
+                bottomMargin: window.borderWidth + 24
+            }
+        }
+
+        //
+        // Plot image export button, only visible for plot-based widgets
+        // rendered through the widget bridge (the scene graph plot does not
+        // have a Qwt plot to clone for the snapshot export)
+        //
+        Button {
+            id: exportButton
+            text: qsTr("Save image")
+            opacity: hovered ? 1 : 0.5
+            visible: !root.nativePlot && widget.widgetIndex >= 0 &&
+                     widget.supportsImageExport()
+            onClicked: widget.exportPlotImage()
+
+            anchors {
+                right: parent.right
+                bottom: parent.bottom
+                margins: window.borderWidth + 4
+            }
+        }
+
+        //
+        // Paint-time heat badge, only visible while the paint profiler is
+        // enabled from the diagnostics pane
+        //
+        Rectangle {
+            id: heatBadge
+
+            property real heat: 0
+
+            radius: 2
+            height: heatLabel.implicitHeight + 4
+            width: heatLabel.implicitWidth + 8
+            visible: Cpp_UI_PaintProfiler.enabled && heatLabel.text !== ""
+            color: Qt.rgba(Math.min(1, 0.4 + 0.6 * heat), 0.6 * (1 - heat), 0.1, 0.85)
+
+            anchors {
+                top: parent.top
+                right: parent.right
+                margins: window.borderWidth + 4
+                topMargin: window.headerHeight + 4
+            }
+
+            Label {
+                id: heatLabel
+                color: "#ffffff"
+                font.pixelSize: 10
+                font.family: app.monoFont
+                anchors.centerIn: parent
+            }
+
+            Connections {
+                target: Cpp_UI_PaintProfiler
+
+                function onStatisticsChanged() {
+                    heatBadge.heat = Cpp_UI_PaintProfiler.heat(window.title)
+                    heatLabel.text = Cpp_UI_PaintProfiler.badgeText(window.title)
+                }
+
+                function onEnabledChanged() {
+                    heatBadge.heat = 0
+                    heatLabel.text = ""
+                }
+            }
+        }
     }
 
     Loader {
@@ -71,7 +158,8 @@ Item {
             id: _window
             minimumWidth: 640 + shadowMargin
             minimumHeight: 480 + shadowMargin
-            title: externalWidget.widgetTitle
+            title: root.nativePlot ? externalQuickPlot.widgetTitle
+                                   : externalWidget.widgetTitle
             titlebarText: Cpp_ThemeManager.text
             titlebarColor: Cpp_ThemeManager.widgetWindowBackground
             backgroundColor: Cpp_ThemeManager.widgetWindowBackground
@@ -111,10 +199,20 @@ Item {
                     id: externalWidget
                     anchors.fill: parent
                     isExternalWindow: true
-                    widgetIndex: root.widgetIndex
-                    widgetVisible: _window.visible
+                    visible: !root.nativePlot
+                    widgetVisible: _window.visible && !root.nativePlot
+                    widgetIndex: root.nativePlot ? -1 : root.widgetIndex
                     anchors.margins: _window.radius
                 }
+
+                QuickPlot {
+                    id: externalQuickPlot
+                    anchors.fill: parent
+                    visible: root.nativePlot
+                    widgetVisible: _window.visible && root.nativePlot
+                    widgetIndex: root.nativePlot ? root.widgetIndex : -1
+                    anchors.margins: _window.radius + 24
+                }
             }
 
             FramelessWindow.ResizeHandles {
@@ -54,6 +54,7 @@ Widgets.Window {
         anchors.fill: parent
 
         Flickable {
+            id: flickable
             contentWidth: width
             contentHeight: grid.height
 
@@ -104,6 +105,8 @@ Widgets.Window {
                     id: model
                     cellWidth: root.cellWidth
                     cellHeight: root.cellHeight
+                    viewportY: flickable.contentY
+                    viewportHeight: flickable.height
                     model: Cpp_UI_Dashboard.totalWidgetCount
                 }
             }
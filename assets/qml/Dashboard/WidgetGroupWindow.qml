@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.3
+import QtQuick.Layouts 1.3
+import QtQuick.Controls 2.3
+
+import SerialStudio 1.0
+
+import "../FramelessWindow" as FramelessWindow
+
+//
+// Detached dashboard window that hosts every widget of one family (plots,
+// gauges, etc.) so that the operator can move a whole widget group to another
+// monitor. Being a separate QQuickWindow, the window gets its own scene graph
+// sync/render cycle: with the threaded render loop a heavy plot wall in one
+// window cannot drop the frames of the others. The widgets are fed from the
+// shared Cpp_UI_Dashboard data, just like the ones in the main window.
+//
+FramelessWindow.CustomWindow {
+    id: root
+
+    //
+    // Widget family displayed by this window, compared against the return
+    // value of Cpp_UI_Dashboard.widgetType() for every global widget index
+    //
+    property int widgetFamily: Dashboard.Unknown
+    property string familyTitle: ""
+
+    //
+    // Window geometry
+    //
+    minimumWidth: 640 + shadowMargin
+    minimumHeight: 480 + shadowMargin
+
+    //
+    // Window style
+    //
+    title: root.familyTitle
+    titlebarText: Cpp_ThemeManager.text
+    titlebarColor: Cpp_ThemeManager.paneWindowBackground
+    backgroundColor: Cpp_ThemeManager.paneWindowBackground
+    borderColor: isMaximized ? backgroundColor : Cpp_ThemeManager.highlight
+    extraFlags: Qt.Dialog | Qt.WindowCloseButtonHint | Qt.WindowTitleHint
+
+    //
+    // Grid sizing, same cell aspect ratio as the main dashboard grid
+    //
+    readonly property int cellHeight: cellWidth * (2/3)
+    readonly property int columns: Math.max(1, Math.floor(flickable.width / 480))
+    readonly property int cellWidth: (flickable.width - (columns - 1) * app.spacing)
+                                     / columns
+
+    Rectangle {
+        clip: true
+        anchors.fill: parent
+        radius: root.radius
+        anchors.margins: root.shadowMargin
+        color: Cpp_ThemeManager.paneWindowBackground
+        anchors.topMargin: root.titlebar.height + root.shadowMargin
+
+        Flickable {
+            id: flickable
+            contentWidth: width
+            contentHeight: grid.height
+
+            anchors {
+                fill: parent
+                margins: app.spacing
+            }
+
+            ScrollBar.vertical: ScrollBar {}
+
+            Grid {
+                id: grid
+                width: parent.width
+                columns: root.columns
+                rowSpacing: app.spacing
+                columnSpacing: app.spacing
+                height: childrenRect.height
+
+                Repeater {
+                    model: Cpp_UI_Dashboard.totalWidgetCount
+
+                    delegate: Loader {
+                        id: loader
+
+                        //
+                        // Only the widgets of the family assigned to this
+                        // window are instantiated, the rest of the global
+                        // index range is skipped by the grid. Widgets are
+                        // released while the window is closed so that a
+                        // hidden group costs nothing.
+                        //
+                        readonly property bool matches:
+                            Cpp_UI_Dashboard.widgetType(index) === root.widgetFamily
+
+                        visible: matches
+                        active: matches && root.visible
+                        width: matches ? root.cellWidth : 0
+                        height: matches ? root.cellHeight : 0
+
+                        sourceComponent: WidgetDelegate {
+                            widgetIndex: index
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    FramelessWindow.ResizeHandles {
+        window: root
+        anchors.fill: parent
+        handleSize: root.handleSize
+    }
+}
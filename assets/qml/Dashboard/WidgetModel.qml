@@ -28,12 +28,32 @@ Repeater {
     property real cellWidth: 0
     property real cellHeight: 0
 
+    //
+    // Visible region of the flickable that contains the grid, used to decide
+    // which cells deserve a live widget instance
+    //
+    property real viewportY: 0
+    property real viewportHeight: 0
+
     delegate: Loader {
         id: loader
         asynchronous: true
         width: root.cellWidth
         height: root.cellHeight
 
+        //
+        // Delegate virtualization: only instantiate the widget (and the Qwt
+        // plot behind it) while the cell is inside the viewport or within one
+        // viewport-height of it, cells scrolled far away release their widget
+        // again. The dashboard data (plot buffers, values, etc.) lives in
+        // Cpp_UI_Dashboard, so a re-instantiated widget picks up the full
+        // state without losing any samples. Widgets popped out into an
+        // external window stay alive regardless of the scroll position.
+        //
+        readonly property bool nearViewport: (y + height) >= (root.viewportY - root.viewportHeight) &&
+                                             y <= (root.viewportY + 2 * root.viewportHeight)
+        active: nearViewport || (item !== null && item.externalWindow !== null)
+
         sourceComponent: WidgetDelegate {
             widgetIndex: index
         }
@@ -176,6 +176,24 @@ Rectangle {
                 }
             }
         }
+
+        //
+        // Float32 storage switch
+        //
+        RowLayout {
+            spacing: app.spacing
+            Layout.fillWidth: true
+            Layout.columnSpan: 2
+
+            CheckBox {
+                checked: Cpp_JSON_Editor.fp32Storage
+                text: qsTr("Store plot data as 32-bit floats (halves memory usage)")
+                onCheckedChanged: {
+                    if (Cpp_JSON_Editor.fp32Storage !== checked)
+                        Cpp_JSON_Editor.fp32Storage = checked
+                }
+            }
+        }
     }
 
     anchors {
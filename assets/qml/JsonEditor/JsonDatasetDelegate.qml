@@ -56,7 +56,11 @@ Widgets.Window {
     //
     // Convenience variables
     //
-    readonly property bool fftSamplesVisible: fftCheck.checked
+    readonly property bool fftSamplesVisible: fftCheck.checked ||
+                                              spectrogramCheck.checked
+    readonly property bool plotPointsVisible: logPlot.checked ||
+                                              linearPlot.checked ||
+                                              root.multiplotGroup
     readonly property bool alarmVisible: widget.currentIndex === 2
     readonly property bool minMaxVisible: widget.currentIndex === 1 ||
                                           widget.currentIndex === 2 ||
@@ -129,6 +133,34 @@ Widgets.Window {
             onCheckedChanged: Cpp_JSON_Editor.setDatasetLED(group, dataset, checked)
         }
 
+        //
+        // Bitmask LED expansion
+        //
+        Label {
+            text: qsTr("Status bitmask:")
+            visible: led.checked
+        } CheckBox {
+            id: ledBitmask
+            visible: led.checked
+            Layout.leftMargin: -app.spacing
+            checked: Cpp_JSON_Editor.datasetLedBitmask(group, dataset)
+            onCheckedChanged: Cpp_JSON_Editor.setDatasetLedBitmask(group, dataset, checked)
+        }
+
+        //
+        // Bit labels of bitmask datasets
+        //
+        Label {
+            text: qsTr("Bit labels:")
+            visible: led.checked && ledBitmask.checked
+        } TextField {
+            Layout.fillWidth: true
+            visible: led.checked && ledBitmask.checked
+            text: Cpp_JSON_Editor.datasetLedLabels(group, dataset)
+            placeholderText: qsTr("Armed, GPS fix, Low battery, ...")
+            onTextChanged: Cpp_JSON_Editor.setDatasetLedLabels(group, dataset, text)
+        }
+
         //
         // Dataset graph
         //
@@ -172,6 +204,18 @@ Widgets.Window {
             onCheckedChanged: Cpp_JSON_Editor.setDatasetFftPlot(group, dataset, checked)
         }
 
+        //
+        // Spectrogram
+        //
+        Label {
+            text: qsTr("Spectrogram:")
+        } Switch {
+            id: spectrogramCheck
+            Layout.leftMargin: -app.spacing
+            checked: Cpp_JSON_Editor.datasetSpectrogram(group, dataset)
+            onCheckedChanged: Cpp_JSON_Editor.setDatasetSpectrogram(group, dataset, checked)
+        }
+
         //
         // Dataset widget (user selectable or group-level constant)
         //
@@ -215,6 +259,25 @@ Widgets.Window {
             }
         }
 
+        //
+        // Plot history depth, 0 = use the global dashboard setting
+        //
+        Label {
+            text: qsTr("Plot points:")
+            visible: root.plotPointsVisible
+        } TextField {
+            id: plotPoints
+            Layout.fillWidth: true
+            visible: root.plotPointsVisible
+            placeholderText: qsTr("Default")
+            text: Cpp_JSON_Editor.datasetPlotPoints(group, dataset)
+            onTextChanged: Cpp_JSON_Editor.setDatasetPlotPoints(group, dataset, parseInt(text))
+            validator: IntValidator {
+                bottom: 0
+                top: 1000 * 1000
+            }
+        }
+
         //
         // Widget minimum value
         //
@@ -269,6 +332,52 @@ Widgets.Window {
             }
         }
 
+        //
+        // Low alarm level
+        //
+        Label {
+            text: qsTr("Alarm low level:")
+        } TextField {
+            id: alarmLow
+            Layout.fillWidth: true
+            placeholderText: qsTr("Disabled")
+            text: Cpp_JSON_Editor.datasetAlarmLow(group, dataset)
+            onTextChanged: Cpp_JSON_Editor.setDatasetAlarmLow(group, dataset, text)
+
+            validator: DoubleValidator {
+            }
+        }
+
+        //
+        // Rate-of-change alarm
+        //
+        Label {
+            text: qsTr("Alarm rate limit (units/s):")
+        } TextField {
+            id: alarmRate
+            Layout.fillWidth: true
+            placeholderText: qsTr("Disabled")
+            text: Cpp_JSON_Editor.datasetAlarmRate(group, dataset)
+            onTextChanged: Cpp_JSON_Editor.setDatasetAlarmRate(group, dataset, text)
+
+            validator: DoubleValidator {
+                bottom: 0
+            }
+        }
+
+        //
+        // Derived dataset expression
+        //
+        Label {
+            text: qsTr("Expression:")
+        } TextField {
+            id: expression
+            Layout.fillWidth: true
+            placeholderText: qsTr("e.g. v1 * v2 (optional)")
+            text: Cpp_JSON_Editor.datasetExpression(group, dataset)
+            onTextChanged: Cpp_JSON_Editor.setDatasetExpression(group, dataset, text)
+        }
+
         //
         // Vertical spacer
         //
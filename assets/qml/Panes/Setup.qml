@@ -91,6 +91,14 @@ Item {
         property alias udpRemotePort: network.udpRemotePort
         property alias udpMulticastEnabled: network.udpMulticastEnabled
 
+        //
+        // Frame generator settings
+        //
+        property alias generatorRate: generator.frameRate
+        property alias generatorDatasets: generator.datasetCount
+        property alias generatorPadding: generator.paddingBytes
+        property alias generatorCorruption: generator.corruptionRate
+
         //
         // MQTT settings
         //
@@ -102,6 +110,13 @@ Item {
         property alias mqttVersion: mqtt.version
         property alias mqttPassword: mqtt.password
 
+        //
+        // Relay settings
+        //
+        property alias relayAddress: relay.address
+        property alias relayViewerPort: relay.viewerPort
+        property alias relayServerPort: relay.serverPort
+
         //
         // App settings
         //
@@ -120,6 +135,7 @@ Item {
         function onOperationModeChanged() {
             commAuto.checked = (Cpp_JSON_Generator.operationMode === 1)
             commManual.checked = (Cpp_JSON_Generator.operationMode === 0)
+            commBinary.checked = (Cpp_JSON_Generator.operationMode === 2)
         }
     }
 
@@ -159,8 +175,6 @@ Item {
                 onCheckedChanged: {
                     if (checked)
                         Cpp_JSON_Generator.setOperationMode(1)
-                    else
-                        Cpp_JSON_Generator.setOperationMode(0)
                 }
             } RadioButton {
                 id: commManual
@@ -170,8 +184,15 @@ Item {
                 onCheckedChanged: {
                     if (checked)
                         Cpp_JSON_Generator.setOperationMode(0)
-                    else
-                        Cpp_JSON_Generator.setOperationMode(1)
+                }
+            } RadioButton {
+                id: commBinary
+                checked: false
+                Layout.maximumWidth: root.maxItemWidth
+                text: qsTr("Parse binary data via JSON project file (MessagePack)")
+                onCheckedChanged: {
+                    if (checked)
+                        Cpp_JSON_Generator.setOperationMode(2)
                 }
             }
 
@@ -181,7 +202,7 @@ Item {
             Button {
                 Layout.fillWidth: true
                 opacity: enabled ? 1 : 0.5
-                enabled: commManual.checked
+                enabled: commManual.checked || commBinary.checked
                 Layout.maximumWidth: root.maxItemWidth
                 onClicked: Cpp_JSON_Generator.loadJsonMap()
                 text: (Cpp_JSON_Generator.jsonMapFilename.length ? qsTr("Change project file (%1)").arg(Cpp_JSON_Generator.jsonMapFilename) :
@@ -229,6 +250,142 @@ Item {
                 }
             }
 
+            //
+            // Binary logging format & log-to-CSV converter
+            //
+            RowLayout {
+                Layout.fillWidth: true
+
+                Switch {
+                    id: binaryLogging
+                    opacity: enabled ? 1 : 0.5
+                    enabled: csvLogging.checked
+                    text: qsTr("Binary log format")
+                    Layout.alignment: Qt.AlignVCenter
+                    checked: Cpp_CSV_Export.binaryFormat
+                    Layout.maximumWidth: root.maxItemWidth
+                    palette.highlight: Cpp_ThemeManager.csvCheckbox
+
+                    onCheckedChanged:  {
+                        if (Cpp_CSV_Export.binaryFormat !== checked)
+                            Cpp_CSV_Export.binaryFormat = checked
+                    }
+                }
+
+                Item {
+                    Layout.fillWidth: true
+                }
+
+                RoundButton {
+                    icon.width: 24
+                    icon.height: 24
+                    icon.color: Cpp_ThemeManager.text
+                    Layout.alignment: Qt.AlignVCenter
+                    icon.source: "qrc:/icons/open.svg"
+                    onClicked: Cpp_CSV_Export.convertBinaryLog()
+                    ToolTip.visible: hovered
+                    ToolTip.text: qsTr("Convert binary log file to CSV")
+                }
+            }
+
+            //
+            // Compress generated CSV files with gzip
+            //
+            Switch {
+                id: csvCompression
+                opacity: enabled ? 1 : 0.5
+                text: qsTr("Compress CSV file (gzip)")
+                checked: Cpp_CSV_Export.compression
+                Layout.maximumWidth: root.maxItemWidth
+                palette.highlight: Cpp_ThemeManager.csvCheckbox
+                enabled: csvLogging.checked && !binaryLogging.checked
+
+                onCheckedChanged:  {
+                    if (Cpp_CSV_Export.compression !== checked)
+                        Cpp_CSV_Export.compression = checked
+                }
+            }
+
+            //
+            // Log rotation policy
+            //
+            RowLayout {
+                Layout.fillWidth: true
+                Layout.maximumWidth: root.maxItemWidth
+
+                Label {
+                    opacity: enabled ? 1 : 0.5
+                    text: qsTr("Rotate log file") + ":"
+                    enabled: csvLogging.checked
+                } ComboBox {
+                    id: csvRotation
+                    Layout.fillWidth: true
+                    opacity: enabled ? 1 : 0.5
+                    enabled: csvLogging.checked
+                    model: Cpp_CSV_Export.rotationPolicyOptions
+                    currentIndex: Cpp_CSV_Export.rotationPolicy
+                    onCurrentIndexChanged: {
+                        if (currentIndex !== Cpp_CSV_Export.rotationPolicy)
+                            Cpp_CSV_Export.rotationPolicy = currentIndex
+                    }
+                }
+            }
+
+            //
+            // Log durability policy
+            //
+            RowLayout {
+                Layout.fillWidth: true
+                Layout.maximumWidth: root.maxItemWidth
+
+                Label {
+                    opacity: enabled ? 1 : 0.5
+                    text: qsTr("Sync log to disk") + ":"
+                    enabled: csvLogging.checked
+                } ComboBox {
+                    id: csvDurability
+                    Layout.fillWidth: true
+                    opacity: enabled ? 1 : 0.5
+                    enabled: csvLogging.checked
+                    model: Cpp_CSV_Export.durabilityPolicyOptions
+                    currentIndex: Cpp_CSV_Export.durabilityPolicy
+                    onCurrentIndexChanged: {
+                        if (currentIndex !== Cpp_CSV_Export.durabilityPolicy)
+                            Cpp_CSV_Export.durabilityPolicy = currentIndex
+                    }
+                }
+            }
+
+            //
+            // Preallocate rotated segment files
+            //
+            Switch {
+                id: csvPreallocation
+                opacity: enabled ? 1 : 0.5
+                text: qsTr("Preallocate segment files")
+                Layout.maximumWidth: root.maxItemWidth
+                palette.highlight: Cpp_ThemeManager.csvCheckbox
+                checked: Cpp_CSV_Export.segmentPreallocation
+                enabled: csvLogging.checked && csvRotation.currentIndex > 0
+
+                onCheckedChanged:  {
+                    if (Cpp_CSV_Export.segmentPreallocation !== checked)
+                        Cpp_CSV_Export.segmentPreallocation = checked
+                }
+            }
+
+            //
+            // Columnar (NumPy) export of the session history
+            //
+            Button {
+                Layout.fillWidth: true
+                enabled: !Cpp_CSV_ColumnarExport.busy
+                Layout.maximumWidth: root.maxItemWidth
+                onClicked: Cpp_CSV_ColumnarExport.exportHistory()
+                text: Cpp_CSV_ColumnarExport.busy ? qsTr("Exporting session history") + "..." :
+                                                    qsTr("Export session history (NumPy)")
+            }
+
             //
             // Spacer
             //
@@ -245,7 +402,7 @@ Item {
                 Layout.fillWidth: true
                 Layout.maximumWidth: root.maxItemWidth
                 onCurrentIndexChanged: {
-                    if (currentIndex < 2 && currentIndex !== Cpp_IO_Manager.dataSource)
+                    if (currentIndex < 5 && currentIndex !== Cpp_IO_Manager.dataSource)
                         Cpp_IO_Manager.dataSource = currentIndex
                 }
 
@@ -261,6 +418,24 @@ Item {
                     width: implicitWidth + 2 * app.spacing
                 }
 
+                TabButton {
+                    text: qsTr("Generator")
+                    height: tab.height + 3
+                    width: implicitWidth + 2 * app.spacing
+                }
+
+                TabButton {
+                    text: qsTr("WebSocket")
+                    height: tab.height + 3
+                    width: implicitWidth + 2 * app.spacing
+                }
+
+                TabButton {
+                    text: qsTr("Relay")
+                    height: tab.height + 3
+                    width: implicitWidth + 2 * app.spacing
+                }
+
                 TabButton {
                     text: qsTr("MQTT")
                     height: tab.height + 3
@@ -272,6 +447,12 @@ Item {
                     height: tab.height + 3
                     width: implicitWidth + 2 * app.spacing
                 }
+
+                TabButton {
+                    text: qsTr("Diagnostics")
+                    height: tab.height + 3
+                    width: implicitWidth + 2 * app.spacing
+                }
             }
 
             //
@@ -301,11 +482,23 @@ Item {
                         stack.implicitHeight = network.implicitHeight
                         break
                     case 2:
-                        stack.implicitHeight = mqtt.implicitHeight
+                        stack.implicitHeight = generator.implicitHeight
                         break
                     case 3:
+                        stack.implicitHeight = websocket.implicitHeight
+                        break
+                    case 4:
+                        stack.implicitHeight = relay.implicitHeight
+                        break
+                    case 5:
+                        stack.implicitHeight = mqtt.implicitHeight
+                        break
+                    case 6:
                         stack.implicitHeight = settings.implicitHeight
                         break
+                    case 7:
+                        stack.implicitHeight = diagnostics.implicitHeight
+                        break
                     default:
                         stack.implicitHeight = 0
                         break
@@ -336,6 +529,30 @@ Item {
                     }
                 }
 
+                SetupPanes.Generator {
+                    id: generator
+                    background: TextField {
+                        enabled: false
+                        palette.base: Cpp_ThemeManager.setupPanelBackground
+                    }
+                }
+
+                SetupPanes.WebSocket {
+                    id: websocket
+                    background: TextField {
+                        enabled: false
+                        palette.base: Cpp_ThemeManager.setupPanelBackground
+                    }
+                }
+
+                SetupPanes.Relay {
+                    id: relay
+                    background: TextField {
+                        enabled: false
+                        palette.base: Cpp_ThemeManager.setupPanelBackground
+                    }
+                }
+
                 SetupPanes.MQTT {
                     id: mqtt
                     background: TextField {
@@ -351,6 +568,15 @@ Item {
                         palette.base: Cpp_ThemeManager.setupPanelBackground
                     }
                 }
+
+                SetupPanes.Diagnostics {
+                    id: diagnostics
+                    onUiChanged: timer.start()
+                    background: TextField {
+                        enabled: false
+                        palette.base: Cpp_ThemeManager.setupPanelBackground
+                    }
+                }
             }
 
             //
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.3
+import QtQuick.Layouts 1.3
+import QtQuick.Controls 2.3
+
+Control {
+    id: root
+    implicitHeight: layout.implicitHeight + app.spacing * 2
+
+    //
+    // Signals
+    //
+    signal uiChanged()
+
+    //
+    // Update the pane height when the statistics rows change
+    //
+    Connections {
+        target: Cpp_Misc_LatencyTracer
+
+        function onStatisticsChanged() {
+            root.uiChanged()
+        }
+    }
+
+    Connections {
+        target: Cpp_Misc_MemoryRegistry
+
+        function onStatisticsChanged() {
+            root.uiChanged()
+        }
+    }
+
+    Connections {
+        target: Cpp_Misc_Watchdog
+
+        function onStatisticsChanged() {
+            root.uiChanged()
+        }
+    }
+
+    Connections {
+        target: Cpp_UI_PaintProfiler
+
+        function onStatisticsChanged() {
+            root.uiChanged()
+        }
+    }
+
+    //
+    // Layout
+    //
+    ColumnLayout {
+        id: layout
+        anchors.fill: parent
+        anchors.margins: app.spacing
+
+        //
+        // Latency tracing switch
+        //
+        Switch {
+            id: _tracing
+            text: qsTr("Trace frame latency")
+            checked: Cpp_Misc_LatencyTracer.enabled
+            palette.highlight: Cpp_ThemeManager.alternativeHighlight
+
+            onCheckedChanged: {
+                if (Cpp_Misc_LatencyTracer.enabled !== checked)
+                    Cpp_Misc_LatencyTracer.enabled = checked
+            }
+        }
+
+        //
+        // Explanation label
+        //
+        Label {
+            opacity: 0.5
+            font.pixelSize: 12
+            Layout.fillWidth: true
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr("Measures the arrival-to-display latency of each frame " +
+                       "and accumulates per-stage histograms (parse, dashboard " +
+                       "rebuild & paint)")
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            height: app.spacing
+        }
+
+        //
+        // Per-stage latency statistics
+        //
+        Repeater {
+            model: Cpp_Misc_LatencyTracer.statistics
+            delegate: Label {
+                opacity: 0.8
+                text: modelData
+                font.pixelSize: 11
+                font.family: app.monoFont
+                Layout.fillWidth: true
+                elide: Label.ElideRight
+                Layout.maximumWidth: root.width - 2 * app.spacing
+            }
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            height: app.spacing
+        }
+
+        //
+        // Memory accounting label
+        //
+        Label {
+            opacity: 0.5
+            font.pixelSize: 12
+            text: qsTr("Pipeline buffers") + ":"
+        }
+
+        //
+        // Per-buffer memory statistics
+        //
+        Repeater {
+            model: Cpp_Misc_MemoryRegistry.statistics
+            delegate: Label {
+                opacity: 0.8
+                text: modelData
+                font.pixelSize: 11
+                font.family: app.monoFont
+                Layout.fillWidth: true
+                elide: Label.ElideRight
+                Layout.maximumWidth: root.width - 2 * app.spacing
+            }
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            height: app.spacing
+        }
+
+        //
+        // Event loop responsiveness label
+        //
+        Label {
+            opacity: 0.5
+            font.pixelSize: 12
+            text: qsTr("Event loop") + ":"
+        }
+
+        //
+        // Stall detector statistics
+        //
+        Repeater {
+            model: Cpp_Misc_Watchdog.statistics
+            delegate: Label {
+                opacity: 0.8
+                text: modelData
+                font.pixelSize: 11
+                font.family: app.monoFont
+                Layout.fillWidth: true
+                elide: Label.ElideRight
+                Layout.maximumWidth: root.width - 2 * app.spacing
+            }
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            height: app.spacing
+        }
+
+        //
+        // Paint profiling switch
+        //
+        Switch {
+            id: _painting
+            text: qsTr("Profile widget painting")
+            checked: Cpp_UI_PaintProfiler.enabled
+            palette.highlight: Cpp_ThemeManager.alternativeHighlight
+
+            onCheckedChanged: {
+                if (Cpp_UI_PaintProfiler.enabled !== checked)
+                    Cpp_UI_PaintProfiler.enabled = checked
+            }
+        }
+
+        //
+        // Explanation label
+        //
+        Label {
+            opacity: 0.5
+            font.pixelSize: 12
+            Layout.fillWidth: true
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr("Measures the render time of every dashboard widget, " +
+                       "shows a heat badge on each widget and ranks the " +
+                       "widgets by cost in the list below")
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            height: app.spacing
+        }
+
+        //
+        // Ranked per-widget paint statistics
+        //
+        Repeater {
+            model: Cpp_UI_PaintProfiler.statistics
+            delegate: Label {
+                opacity: 0.8
+                text: modelData
+                font.pixelSize: 11
+                font.family: app.monoFont
+                Layout.fillWidth: true
+                elide: Label.ElideRight
+                Layout.maximumWidth: root.width - 2 * app.spacing
+            }
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            height: app.spacing
+        }
+
+        //
+        // Reset button
+        //
+        Button {
+            Layout.fillWidth: true
+            text: qsTr("Reset statistics")
+            onClicked: {
+                Cpp_Misc_Watchdog.resetStatistics()
+                Cpp_Misc_LatencyTracer.resetStatistics()
+                Cpp_Misc_MemoryRegistry.resetPeaks()
+                Cpp_UI_PaintProfiler.resetStatistics()
+            }
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+        }
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.3
+import QtQuick.Layouts 1.3
+import QtQuick.Controls 2.3
+
+Control {
+    id: root
+    implicitHeight: layout.implicitHeight + app.spacing * 2
+
+    //
+    // Access to properties
+    //
+    property alias frameRate: _frameRate.text
+    property alias datasetCount: _datasetCount.text
+    property alias paddingBytes: _paddingBytes.text
+    property alias corruptionRate: _corruptionRate.text
+
+    //
+    // Layout
+    //
+    ColumnLayout {
+        id: layout
+        anchors.fill: parent
+        anchors.margins: app.spacing
+
+        GridLayout {
+            columns: 2
+            Layout.fillWidth: true
+            rowSpacing: app.spacing
+            columnSpacing: app.spacing
+
+            //
+            // Frame rate
+            //
+            Label {
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                text: qsTr("Frames per second") + ":"
+            } TextField {
+                id: _frameRate
+                Layout.fillWidth: true
+                Component.onCompleted: text = Cpp_IO_Generator.frameRate
+                onTextChanged: {
+                    if (Cpp_IO_Generator.frameRate !== text && text.length > 0)
+                        Cpp_IO_Generator.frameRate = text
+                }
+
+                validator: IntValidator {
+                    bottom: 1
+                    top: 100000
+                }
+            }
+
+            //
+            // Dataset count
+            //
+            Label {
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                text: qsTr("Datasets per frame") + ":"
+            } TextField {
+                id: _datasetCount
+                Layout.fillWidth: true
+                Component.onCompleted: text = Cpp_IO_Generator.datasetCount
+                onTextChanged: {
+                    if (Cpp_IO_Generator.datasetCount !== text && text.length > 0)
+                        Cpp_IO_Generator.datasetCount = text
+                }
+
+                validator: IntValidator {
+                    bottom: 1
+                    top: 128
+                }
+            }
+
+            //
+            // Payload padding
+            //
+            Label {
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                text: qsTr("Payload padding (bytes)") + ":"
+            } TextField {
+                id: _paddingBytes
+                Layout.fillWidth: true
+                Component.onCompleted: text = Cpp_IO_Generator.paddingBytes
+                onTextChanged: {
+                    if (Cpp_IO_Generator.paddingBytes !== text && text.length > 0)
+                        Cpp_IO_Generator.paddingBytes = text
+                }
+
+                validator: IntValidator {
+                    bottom: 0
+                    top: 65536
+                }
+            }
+
+            //
+            // Corruption rate
+            //
+            Label {
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                text: qsTr("Corrupted frames (%)") + ":"
+            } TextField {
+                id: _corruptionRate
+                Layout.fillWidth: true
+                Component.onCompleted: text = Cpp_IO_Generator.corruptionRate
+                onTextChanged: {
+                    if (Cpp_IO_Generator.corruptionRate !== text && text.length > 0)
+                        Cpp_IO_Generator.corruptionRate = text
+                }
+
+                validator: IntValidator {
+                    bottom: 0
+                    top: 100
+                }
+            }
+        }
+
+        //
+        // Explanation label
+        //
+        Label {
+            opacity: 0.5
+            font.pixelSize: 12
+            Layout.fillWidth: true
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr("Generates synthetic sine-wave frames internally, " +
+                       "useful for stress-testing dashboards without a device")
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+            Layout.minimumHeight: app.spacing
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+        }
+    }
+}
@@ -241,6 +241,29 @@ Control {
                     root.uiChanged()
                 }
             }
+
+            //
+            // Multicast source address (IGMPv3 source-specific multicast)
+            //
+            Label {
+                opacity: enabled ? 1 : 0.5
+                text: qsTr("Multicast source") + ":"
+                enabled: !Cpp_IO_Manager.connected
+                visible: Cpp_IO_Network.socketTypeIndex === 1 && udpMulticastEnabled
+            } TextField {
+                id: _multicastSource
+                Layout.fillWidth: true
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                placeholderText: qsTr("Leave empty to accept all senders")
+                Component.onCompleted: text = Cpp_IO_Network.multicastSource
+                visible: Cpp_IO_Network.socketTypeIndex === 1 && udpMulticastEnabled
+
+                onTextChanged: {
+                    if (Cpp_IO_Network.multicastSource !== text)
+                        Cpp_IO_Network.multicastSource = text
+                }
+            }
         }
 
         //
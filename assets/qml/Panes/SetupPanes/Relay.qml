@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.3
+import QtQuick.Layouts 1.3
+import QtQuick.Controls 2.3
+
+Control {
+    id: root
+    implicitHeight: layout.implicitHeight + app.spacing * 2
+
+    //
+    // Access to properties
+    //
+    property alias address: _address.text
+    property alias viewerPort: _viewerPort.text
+    property alias serverPort: _serverPort.text
+    property alias serverEnabled: _serverEnabled.checked
+
+    //
+    // Layout
+    //
+    ColumnLayout {
+        id: layout
+        anchors.fill: parent
+        anchors.margins: app.spacing
+
+        GridLayout {
+            columns: 2
+            Layout.fillWidth: true
+            rowSpacing: app.spacing
+            columnSpacing: app.spacing
+
+            //
+            // Address of the ingest node
+            //
+            Label {
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                text: qsTr("Ingest node address") + ":"
+            } TextField {
+                id: _address
+                Layout.fillWidth: true
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                placeholderText: Cpp_IO_Relay.defaultAddress
+                Component.onCompleted: text = Cpp_IO_Relay.remoteAddress
+                onTextChanged: {
+                    if (Cpp_IO_Relay.remoteAddress !== text && text.length > 0)
+                        Cpp_IO_Relay.remoteAddress = text
+
+                    if (text.length === 0)
+                        Cpp_IO_Relay.remoteAddress = Cpp_IO_Relay.defaultAddress
+                }
+            }
+
+            //
+            // Port of the ingest node
+            //
+            Label {
+                text: qsTr("Port") + ":"
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+            } TextField {
+                id: _viewerPort
+                Layout.fillWidth: true
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Manager.connected
+                placeholderText: Cpp_IO_Relay.defaultPort
+                Component.onCompleted: text = Cpp_IO_Relay.tcpPort
+                onTextChanged: {
+                    if (Cpp_IO_Relay.tcpPort !== text && text.length > 0)
+                        Cpp_IO_Relay.tcpPort = text
+
+                    if (text.length === 0)
+                        Cpp_IO_Relay.tcpPort = Cpp_IO_Relay.defaultPort
+                }
+
+                validator: IntValidator {
+                    bottom: 0
+                    top: 65535
+                }
+            }
+
+            //
+            // Relay server switch
+            //
+            Label {
+                text: qsTr("Share this session") + ":"
+            } CheckBox {
+                id: _serverEnabled
+                Layout.leftMargin: -app.spacing
+                checked: Cpp_IO_Relay.serverEnabled
+                onCheckedChanged: {
+                    if (Cpp_IO_Relay.serverEnabled !== checked)
+                        Cpp_IO_Relay.serverEnabled = checked
+                }
+            }
+
+            //
+            // Relay server port
+            //
+            Label {
+                opacity: enabled ? 1 : 0.5
+                text: qsTr("Server port") + ":"
+                enabled: !Cpp_IO_Relay.serverEnabled
+            } TextField {
+                id: _serverPort
+                Layout.fillWidth: true
+                opacity: enabled ? 1 : 0.5
+                enabled: !Cpp_IO_Relay.serverEnabled
+                placeholderText: Cpp_IO_Relay.defaultPort
+                Component.onCompleted: text = Cpp_IO_Relay.serverPort
+                onTextChanged: {
+                    if (Cpp_IO_Relay.serverPort !== text && text.length > 0)
+                        Cpp_IO_Relay.serverPort = text
+
+                    if (text.length === 0)
+                        Cpp_IO_Relay.serverPort = Cpp_IO_Relay.defaultPort
+                }
+
+                validator: IntValidator {
+                    bottom: 0
+                    top: 65535
+                }
+            }
+
+            //
+            // Connected viewer count
+            //
+            Label {
+                visible: Cpp_IO_Relay.serverEnabled
+                text: qsTr("Connected viewers") + ":"
+            } Label {
+                font.bold: true
+                visible: Cpp_IO_Relay.serverEnabled
+                text: Cpp_IO_Relay.viewerCount
+            }
+        }
+
+        //
+        // Explanation label
+        //
+        Label {
+            opacity: 0.5
+            font.pixelSize: 12
+            Layout.fillWidth: true
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr("Watches the live session of another Serial Studio " +
+                       "instance. Enable \"Share this session\" on the machine " +
+                       "that owns the device to let other seats connect as viewers.")
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+            Layout.minimumHeight: app.spacing
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+        }
+    }
+}
@@ -137,6 +137,22 @@ Control {
                 }
             }
 
+            //
+            // Low latency mode
+            //
+            Label {
+                text: qsTr("Low latency mode") + ":"
+            } CheckBox {
+                id: _lowlatency
+                Layout.alignment: Qt.AlignLeft
+                Layout.leftMargin: -app.spacing
+                checked: Cpp_IO_Serial.lowLatencyMode
+                onCheckedChanged: {
+                    if (Cpp_IO_Serial.lowLatencyMode !== checked)
+                        Cpp_IO_Serial.lowLatencyMode = checked
+                }
+            }
+
             //
             // Spacer
             //
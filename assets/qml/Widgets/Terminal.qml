@@ -104,6 +104,13 @@ Item {
             enabled: Cpp_IO_Console.saveAvailable
         }
 
+        MenuItem {
+            opacity: enabled ? 1 : 0.5
+            text: qsTr("Show earlier output")
+            enabled: Cpp_IO_Console.saveAvailable
+            onTriggered: textEdit.loadScrollback()
+        }
+
         MenuSeparator {}
 
         MenuItem {
@@ -164,6 +171,37 @@ Item {
                     }
                 }
             }
+
+            //
+            // New-lines pill, displayed while the user is scrolled back &
+            // arriving text is withheld from the view; clicking it jumps
+            // back to the tail of the stream
+            //
+            Rectangle {
+                id: newLinesPill
+                radius: height / 2
+                height: newLinesLabel.implicitHeight + app.spacing
+                width: newLinesLabel.implicitWidth + app.spacing * 3
+                visible: textEdit.newLineCount > 0 && !Cpp_IO_Console.autoscroll
+                color: Cpp_ThemeManager.consoleHighlight
+
+                anchors.bottom: parent.bottom
+                anchors.margins: app.spacing * 2
+                anchors.horizontalCenter: parent.horizontalCenter
+
+                Label {
+                    id: newLinesLabel
+                    anchors.centerIn: parent
+                    color: Cpp_ThemeManager.consoleHighlightedText
+                    text: qsTr("%1 new lines").arg(textEdit.newLineCount) + " ↓"
+                }
+
+                MouseArea {
+                    anchors.fill: parent
+                    cursorShape: Qt.PointingHandCursor
+                    onClicked: Cpp_IO_Console.autoscroll = true
+                }
+            }
         }
 
         //
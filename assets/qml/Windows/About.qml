@@ -169,6 +169,36 @@ FramelessWindow.CustomWindow {
                 height: app.spacing
             }
 
+            //
+            // Startup timing table, lets engineers compare the startup latency of
+            // different releases (also available as JSON through
+            // Cpp_ModuleManager.startupTimingsJson())
+            //
+            ColumnLayout {
+                spacing: 0
+                Layout.fillWidth: true
+
+                Label {
+                    opacity: 0.8
+                    font.pixelSize: 12
+                    text: qsTr("Startup timings") + ":"
+                }
+
+                Repeater {
+                    model: Cpp_ModuleManager.startupPhases
+                    delegate: Label {
+                        opacity: 0.5
+                        text: modelData
+                        font.pixelSize: 12
+                        font.family: app.monoFont
+                    }
+                }
+            }
+
+            Item {
+                height: app.spacing
+            }
+
             Button {
                 Layout.fillWidth: true
                 text: qsTr("Website")
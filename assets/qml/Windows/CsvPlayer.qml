@@ -117,6 +117,85 @@ FramelessWindow.CustomWindow {
                 Layout.alignment: Qt.AlignLeft
             }
 
+            //
+            // Overview timeline, one min/max strip per channel. Clicking the
+            // thumbnail seeks straight to that point of the log.
+            //
+            Canvas {
+                id: overview
+                implicitHeight: 48
+                Layout.fillWidth: true
+                visible: Cpp_CSV_Player.overviewChannelCount > 0
+
+                Connections {
+                    target: Cpp_CSV_Player
+                    function onOverviewChanged() {
+                        overview.requestPaint()
+                    }
+                }
+
+                onVisibleChanged: requestPaint()
+                onPaint: {
+                    var ctx = getContext("2d")
+                    ctx.clearRect(0, 0, width, height)
+
+                    var channels = Cpp_CSV_Player.overviewChannelCount
+                    if (channels <= 0)
+                        return
+
+                    var stripHeight = height / channels
+                    var colors = Cpp_ThemeManager.widgetColors
+                    for (var c = 0; c < channels; ++c) {
+                        var strip = Cpp_CSV_Player.overviewStrip(c)
+                        var bins = strip.length / 2
+                        if (bins <= 0)
+                            continue
+
+                        // Draw the filled band between the min & max lines of
+                        // the channel, values are normalized to [0, 1]
+                        var top = c * stripHeight
+                        ctx.fillStyle = colors[c % colors.length]
+                        ctx.beginPath()
+                        for (var b = 0; b < bins; ++b) {
+                            var x = (b + 0.5) * width / bins
+                            var y = top + (1 - strip[b * 2 + 1]) * stripHeight
+                            if (b === 0)
+                                ctx.moveTo(x, y)
+                            else
+                                ctx.lineTo(x, y)
+                        }
+
+                        for (b = bins - 1; b >= 0; --b) {
+                            x = (b + 0.5) * width / bins
+                            y = top + (1 - strip[b * 2]) * stripHeight
+                            ctx.lineTo(x, y + 1)
+                        }
+
+                        ctx.closePath()
+                        ctx.fill()
+                    }
+                }
+
+                //
+                // Shade the A-B repeat region over the thumbnail
+                //
+                Rectangle {
+                    opacity: 0.3
+                    height: parent.height
+                    color: Cpp_ThemeManager.highlight
+                    x: Cpp_CSV_Player.regionStart * parent.width
+                    width: (Cpp_CSV_Player.regionEnd - Cpp_CSV_Player.regionStart) *
+                           parent.width
+                    visible: Cpp_CSV_Player.regionStart > 0 ||
+                             Cpp_CSV_Player.regionEnd < 1
+                }
+
+                MouseArea {
+                    anchors.fill: parent
+                    onClicked: Cpp_CSV_Player.setProgress(mouse.x / parent.width)
+                }
+            }
+
             //
             // Progress display
             //
@@ -166,6 +245,46 @@ FramelessWindow.CustomWindow {
                     enabled: Cpp_CSV_Player.progress < 1 && !Cpp_CSV_Player.isPlaying
                 }
             }
+
+            //
+            // Loop & A-B region controls, used to replay a representative
+            // capture (or a region of it) for hours during soak tests
+            //
+            RowLayout {
+                spacing: app.spacing
+                Layout.fillWidth: true
+                Layout.alignment: Qt.AlignHCenter
+
+                CheckBox {
+                    text: qsTr("Loop")
+                    checked: Cpp_CSV_Player.loopEnabled
+                    onCheckedChanged: {
+                        if (checked !== Cpp_CSV_Player.loopEnabled)
+                            Cpp_CSV_Player.setLoopEnabled(checked)
+                    }
+                }
+
+                Button {
+                    text: qsTr("Set A")
+                    Layout.alignment: Qt.AlignVCenter
+                    onClicked: Cpp_CSV_Player.setRegionStart(Cpp_CSV_Player.progress)
+                }
+
+                Button {
+                    text: qsTr("Set B")
+                    Layout.alignment: Qt.AlignVCenter
+                    onClicked: Cpp_CSV_Player.setRegionEnd(Cpp_CSV_Player.progress)
+                }
+
+                Button {
+                    opacity: enabled ? 1 : 0.5
+                    text: qsTr("Clear region")
+                    Layout.alignment: Qt.AlignVCenter
+                    onClicked: Cpp_CSV_Player.clearRegion()
+                    enabled: Cpp_CSV_Player.regionStart > 0 ||
+                             Cpp_CSV_Player.regionEnd < 1
+                }
+            }
         }
     }
 }
@@ -431,6 +431,48 @@ FramelessWindow.CustomWindow {
                     height: app.spacing
                 }
 
+                //
+                // Burst conflation title
+                //
+                Label {
+                    text: qsTr("Conflate bursts") + ":"
+                    opacity: enabled ? 1 : 0.5
+                    enabled: Cpp_MQTT_Client.clientMode === 1
+                } Item {
+                    Layout.fillWidth: true
+                }
+
+                //
+                // Burst conflation checkbox, only parses the newest frame of large
+                // catch-up batches (e.g. broker replay after a reconnection), the
+                // CSV export & plugin modules still receive every frame
+                //
+                CheckBox {
+                    id: _conflation
+                    Layout.fillWidth: true
+                    opacity: enabled ? 1 : 0.5
+                    Layout.leftMargin: -app.spacing
+                    text: qsTr("Display newest frame only")
+                    enabled: Cpp_MQTT_Client.clientMode === 1
+                    checked: Cpp_MQTT_Client.subscriberConflation
+
+                    onCheckedChanged: {
+                        if (Cpp_MQTT_Client.subscriberConflation != checked)
+                            Cpp_MQTT_Client.subscriberConflation = checked
+                    }
+                } Item {
+                    Layout.fillWidth: true
+                }
+
+                //
+                // Spacers
+                //
+                Item {
+                    height: app.spacing
+                } Item {
+                    height: app.spacing
+                }
+
                 //
                 // SSL & certificate titles
                 //
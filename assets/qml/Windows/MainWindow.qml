@@ -52,9 +52,10 @@ FramelessWindow.CustomWindow {
     //
     // Global properties
     //
-    readonly property bool setupVisible: setup.visible
+    readonly property bool setupVisible: setupLoader.status === Loader.Ready &&
+                                         setupLoader.item.visible
     readonly property bool consoleVisible: terminal.visible
-    readonly property bool dashboardVisible: dashboard.visible
+    readonly property bool dashboardVisible: dashboardLoader.visible
 
     //
     // Custom properties
@@ -71,6 +72,20 @@ FramelessWindow.CustomWindow {
     function showConsole()   { toolbar.consoleClicked()   }
     function showDashboard() { dbTimer.start() }
 
+    //
+    // Setup pane functions, the pane is instantiated asynchronously & these
+    // guards avoid calling into it before it finishes loading
+    //
+    function setupShow() {
+        if (setupLoader.item)
+            setupLoader.item.show()
+    }
+
+    function setupHide() {
+        if (setupLoader.item)
+            setupLoader.item.hide()
+    }
+
     //
     // Wait a little before showing the dashboard to avoid UI glitches and/or overloading
     // the rendering engine
@@ -134,21 +149,31 @@ FramelessWindow.CustomWindow {
         // Show donations dialog every 15 launches
         if (root.appLaunchCount % 15 == 0 && !app.donateDialog.doNotShowAgain)
             app.donateDialog.showAutomatically()
+    }
 
-        // Ask user if he/she wants to enable automatic updates
-        if (root.appLaunchCount == 2 && Cpp_UpdaterEnabled) {
-            if (Cpp_Misc_Utilities.askAutomaticUpdates()) {
-                root.automaticUpdates = true
-                Cpp_Updater.checkForUpdates(Cpp_AppUpdaterUrl)
+    //
+    // Deferred startup tasks, requested by the C++ side once the interface has
+    // painted & the event loop is quiet so that update checks never stall startup
+    //
+    Connections {
+        target: Cpp_ModuleManager
+
+        function onDeferredStartupTasksRequested() {
+            // Ask user if he/she wants to enable automatic updates
+            if (root.appLaunchCount == 2 && Cpp_UpdaterEnabled) {
+                if (Cpp_Misc_Utilities.askAutomaticUpdates()) {
+                    root.automaticUpdates = true
+                    Cpp_Updater.checkForUpdates(Cpp_AppUpdaterUrl)
+                }
+
+                else
+                    root.automaticUpdates = false
             }
 
-            else
-                root.automaticUpdates = false
+            // Check for updates (if we are allowed)
+            else if (root.automaticUpdates && Cpp_UpdaterEnabled)
+                Cpp_Updater.checkForUpdates(Cpp_AppUpdaterUrl)
         }
-
-        // Check for updates (if we are allowed)
-        if (root.automaticUpdates && Cpp_UpdaterEnabled)
-            Cpp_Updater.checkForUpdates(Cpp_AppUpdaterUrl)
     }
 
     //
@@ -162,13 +187,13 @@ FramelessWindow.CustomWindow {
                 return
 
             if ((Cpp_IO_Manager.connected || Cpp_CSV_Player.isOpen) && Cpp_UI_Dashboard.frameValid()) {
-                setup.hide()
+                root.setupHide()
                 root.showDashboard()
                 root.firstValidFrame = true
             }
 
             else {
-                setup.show()
+                root.setupShow()
                 root.showConsole()
                 root.firstValidFrame = false
             }
@@ -181,7 +206,7 @@ FramelessWindow.CustomWindow {
     Connections {
         target: Cpp_UI_Dashboard
         function onDataReset() {
-            setup.show()
+            root.setupShow()
             root.showConsole()
             root.firstValidFrame = false
         }
@@ -295,14 +320,14 @@ FramelessWindow.CustomWindow {
                 consoleChecked: root.consoleVisible
                 dashboardChecked: root.dashboardVisible
                 onJsonEditorClicked: app.jsonEditorWindow.show()
-                onSetupClicked: setup.visible ? setup.hide() : setup.show()
+                onSetupClicked: root.setupVisible ? root.setupHide() : root.setupShow()
 
                 onDashboardClicked: {
                     if (Cpp_UI_Dashboard.available) {
                         consoleChecked = 0
                         dashboardChecked = 1
-                        if (stack.currentItem != dashboard)
-                            stack.push(dashboard)
+                        if (stack.currentItem != dashboardLoader)
+                            stack.push(dashboardLoader)
                     }
 
                     else
@@ -338,21 +363,34 @@ FramelessWindow.CustomWindow {
                             height: parent.height
                         },
 
-                        Dashboard {
-                            id: dashboard
+                        //
+                        // The dashboard pane & its widgets are instantiated in the
+                        // background, the console stays interactive while the heavy
+                        // pane loads
+                        //
+                        Loader {
+                            id: dashboardLoader
                             visible: false
+                            asynchronous: true
                             width: parent.width
                             height: parent.height
+                            sourceComponent: Dashboard {}
                         }
                     ]
                 }
 
-                Setup {
-                    id: setup
+                //
+                // The setup pane is instantiated in the background, the window shell
+                // & the console are shown before the pane finishes loading
+                //
+                Loader {
+                    id: setupLoader
+                    asynchronous: true
                     Layout.fillHeight: true
-                    Layout.rightMargin: setupMargin
-                    Layout.minimumWidth: displayedWidth
-                    Layout.maximumWidth: displayedWidth
+                    Layout.rightMargin: item ? item.setupMargin : 0
+                    Layout.minimumWidth: item ? item.displayedWidth : 0
+                    Layout.maximumWidth: item ? item.displayedWidth : 0
+                    sourceComponent: Setup {}
                 }
             }
         }
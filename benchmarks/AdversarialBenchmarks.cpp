@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Adversarial robustness harness for the frame scanner. In the field the
+// scanner faces hostile input — corrupt delimiters, truncated checksum
+// trailers, megabyte runs of garbage — and its worst-case per-chunk cost is
+// what stalls a rig, not the average. The harness replays generated (and
+// optionally recorded) adversarial byte corpora through @c IO::FrameReader in
+// fixed 64 KB chunks & reports the worst-case chunk scan time together with
+// the resync & checksum-error counters, so a bound like "no corpus makes a
+// 64 KB chunk take more than 1 ms to scan" can be stated & re-verified per
+// release.
+//
+// Build & run:
+//   qmake Serial-Studio-AdversarialBenchmarks.pro && make
+//   ./serial-studio-adversarial-benchmarks [recorded-corpus-files...]
+//
+// Recorded corpora (e.g. captures of misbehaving devices) given on the
+// command line are replayed after the generated ones with the same reporting.
+//
+
+#include <cstdio>
+
+#include <QFile>
+#include <QVector>
+#include <QByteArray>
+#include <QApplication>
+#include <QElapsedTimer>
+
+#include <IO/FrameQueue.h>
+#include <IO/FrameReader.h>
+
+/**
+ * Every corpus is replayed in chunks of this size, which matches the blocks a
+ * fast TCP or USB device can deliver in a single readyRead event.
+ */
+static const int kChunkSize = 64 * 1024;
+
+/**
+ * Each corpus is replayed for roughly this long, which is long enough for the
+ * worst-case chunk to show up & short enough to keep the suite usable in an
+ * acceptance pipeline.
+ */
+static const qint64 kRunMsecs = 1000;
+
+/**
+ * Deterministic pseudo-random byte generator (xorshift), the corpora must be
+ * identical from run to run so that worst-case numbers are comparable across
+ * releases.
+ */
+static quint32 g_randomState = 0x12345678;
+static quint8 RandomByte()
+{
+    g_randomState ^= g_randomState << 13;
+    g_randomState ^= g_randomState >> 17;
+    g_randomState ^= g_randomState << 5;
+    return static_cast<quint8>(g_randomState);
+}
+
+/**
+ * Replays the given @a corpus through a fresh frame reader in fixed 64 KB
+ * chunks & reports throughput, worst-case chunk scan time & the resync and
+ * checksum-error counters. The @a mode selects the framing decoder under test.
+ */
+static void ReplayCorpus(const char *name, const QByteArray &corpus,
+                         const IO::FrameReader::FrameMode mode)
+{
+    IO::FrameQueue queue(4096);
+    IO::FrameReader reader(&queue);
+    reader.setFrameMode(static_cast<int>(mode));
+    reader.setCoalesceSettings(1, 0);
+
+    qint64 bytes = 0;
+    qint64 worstNsecs = 0;
+    QVector<QByteArray> batch;
+    QElapsedTimer timer;
+    QElapsedTimer chunkTimer;
+    timer.start();
+    while (timer.elapsed() < kRunMsecs)
+    {
+        for (int offset = 0; offset < corpus.size(); offset += kChunkSize)
+        {
+            const auto chunk = corpus.mid(offset, kChunkSize);
+            chunkTimer.start();
+            reader.processData(chunk);
+            worstNsecs = qMax(worstNsecs, chunkTimer.nsecsElapsed());
+            bytes += chunk.size();
+
+            // Drain the output queue so back-pressure drops do not distort
+            // the next chunk
+            queue.dequeue(batch, queue.capacity());
+            batch.clear();
+        }
+    }
+
+    const double secs = timer.nsecsElapsed() / 1e9;
+    printf("%-28s %8.2f MB/s  worst chunk %7.3f ms  frames %9llu  "
+           "resyncs %7llu  crc errors %5llu\n",
+           name, bytes / 1e6 / secs, worstNsecs / 1e6,
+           static_cast<unsigned long long>(reader.frameCount()),
+           static_cast<unsigned long long>(reader.resyncCount()),
+           static_cast<unsigned long long>(reader.checksumErrorCount()));
+    fflush(stdout);
+}
+
+/**
+ * Builds a corpus of well-formed delimited frames, the baseline the
+ * adversarial numbers are compared against.
+ */
+static QByteArray BuildCleanCorpus()
+{
+    QByteArray corpus;
+    while (corpus.size() < kChunkSize * 4)
+    {
+        corpus.append("/*");
+        for (int i = 0; i < 16; ++i)
+        {
+            if (i > 0)
+                corpus.append(',');
+            corpus.append(QByteArray::number(i * 1.0 + 0.5, 'f', 2));
+        }
+        corpus.append("*/");
+    }
+
+    return corpus;
+}
+
+/**
+ * Builds a corpus of uniformly random bytes, the scanner finds no frames & has
+ * to discard the data at line rate.
+ */
+static QByteArray BuildGarbageCorpus()
+{
+    QByteArray corpus;
+    corpus.resize(kChunkSize * 4);
+    for (int i = 0; i < corpus.size(); ++i)
+        corpus[i] = static_cast<char>(RandomByte());
+
+    return corpus;
+}
+
+/**
+ * Builds a corpus consisting only of start sequences, every candidate frame is
+ * truncated by the next one, which drives the resync path on every scan.
+ */
+static QByteArray BuildStartFloodCorpus()
+{
+    QByteArray corpus;
+    while (corpus.size() < kChunkSize * 4)
+        corpus.append("/*");
+
+    return corpus;
+}
+
+/**
+ * Builds a corpus of truncated frames: every frame opens correctly & is cut
+ * mid-payload by the start of the next one.
+ */
+static QByteArray BuildTruncatedCorpus()
+{
+    QByteArray corpus;
+    while (corpus.size() < kChunkSize * 4)
+    {
+        corpus.append("/*");
+        const int payload = 1 + RandomByte() % 32;
+        for (int i = 0; i < payload; ++i)
+            corpus.append(static_cast<char>('0' + RandomByte() % 10));
+    }
+
+    return corpus;
+}
+
+/**
+ * Builds a corpus that mixes delimiter fragments with random bytes, so partial
+ * matches of the start & finish sequences appear at every offset.
+ */
+static QByteArray BuildDelimiterSoupCorpus()
+{
+    QByteArray corpus;
+    while (corpus.size() < kChunkSize * 4)
+    {
+        switch (RandomByte() % 4)
+        {
+            case 0:
+                corpus.append("/*");
+                break;
+            case 1:
+                corpus.append("*/");
+                break;
+            case 2:
+                corpus.append('*');
+                break;
+            default:
+                corpus.append(static_cast<char>(RandomByte()));
+                break;
+        }
+    }
+
+    return corpus;
+}
+
+/**
+ * Builds a corpus of valid frames separated by random inter-frame garbage,
+ * which exercises the checksum-trailer probing after every finish sequence.
+ */
+static QByteArray BuildTrailerGarbageCorpus()
+{
+    QByteArray corpus;
+    while (corpus.size() < kChunkSize * 4)
+    {
+        corpus.append("/*");
+        for (int i = 0; i < 8; ++i)
+        {
+            if (i > 0)
+                corpus.append(',');
+            corpus.append(QByteArray::number(i + 0.5, 'f', 2));
+        }
+        corpus.append("*/");
+
+        // Random trailer bytes, occasionally a plausible-but-wrong checksum
+        const int trailer = RandomByte() % 5;
+        for (int i = 0; i < trailer; ++i)
+            corpus.append(static_cast<char>(RandomByte()));
+    }
+
+    return corpus;
+}
+
+/**
+ * Builds a hostile corpus for the binary length-prefix decoder: random length
+ * claims (including maximum-length ones) followed by too little data, the
+ * decoder has to bound its buffering & resynchronize.
+ */
+static QByteArray BuildLengthPrefixCorpus()
+{
+    QByteArray corpus;
+    while (corpus.size() < kChunkSize * 4)
+    {
+        // Random 16-bit length claim, most of them never satisfied
+        corpus.append(static_cast<char>(RandomByte()));
+        corpus.append(static_cast<char>(RandomByte()));
+
+        const int payload = RandomByte() % 64;
+        for (int i = 0; i < payload; ++i)
+            corpus.append(static_cast<char>(RandomByte()));
+    }
+
+    return corpus;
+}
+
+/**
+ * Replays a recorded corpus file given on the command line
+ */
+static void ReplayRecordedCorpus(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        printf("%-28s skipped (cannot open file)\n", qPrintable(path));
+        return;
+    }
+
+    const QByteArray corpus = file.readAll();
+    ReplayCorpus(qPrintable(path), corpus, IO::FrameReader::FrameMode::TextDelimiters);
+}
+
+/**
+ * @brief Entry-point function of the adversarial scanner harness
+ */
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+    app.setApplicationName("Serial Studio Benchmarks");
+    app.setOrganizationName("Serial Studio Benchmarks");
+
+    printf("Serial Studio adversarial scanner benchmarks (Qt %s, 64 KB chunks)\n",
+           qVersion());
+    printf("--------------------------------------------------------------------"
+           "----------\n");
+
+    const auto text = IO::FrameReader::FrameMode::TextDelimiters;
+    const auto binary = IO::FrameReader::FrameMode::BinaryLengthPrefix;
+    ReplayCorpus("Clean frames (baseline)", BuildCleanCorpus(), text);
+    ReplayCorpus("Random garbage", BuildGarbageCorpus(), text);
+    ReplayCorpus("Start-sequence flood", BuildStartFloodCorpus(), text);
+    ReplayCorpus("Truncated frames", BuildTruncatedCorpus(), text);
+    ReplayCorpus("Delimiter soup", BuildDelimiterSoupCorpus(), text);
+    ReplayCorpus("Checksum-trailer garbage", BuildTrailerGarbageCorpus(), text);
+    ReplayCorpus("Hostile length prefixes", BuildLengthPrefixCorpus(), binary);
+
+    // Replay the recorded corpora given on the command line (if any)
+    for (int i = 1; i < app.arguments().count(); ++i)
+    {
+        const auto &argument = app.arguments().at(i);
+        if (!argument.startsWith("-"))
+            ReplayRecordedCorpus(argument);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Micro-benchmark harness for the data pipeline. The harness feeds synthetic data
+// into the real hot paths (frame delimiter scanning, CRC kernels, JSON generator in
+// automatic & manual mode, console hex-dump formatting) & reports the sustained
+// throughput of each stage in bytes/sec and frames/sec.
+//
+// Build & run:
+//   qmake Serial-Studio-Benchmarks.pro && make
+//   ./serial-studio-benchmarks
+//
+// The numbers are meant to be archived per build & compared across releases, so
+// that optimization claims (and regressions) are backed by data instead of
+// anecdotes.
+//
+
+#include <cstdio>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QTemporaryFile>
+
+#include <IO/Checksum.h>
+#include <IO/Console.h>
+#include <IO/FrameQueue.h>
+#include <IO/FrameReader.h>
+#include <JSON/Generator.h>
+
+/**
+ * Each benchmark runs for roughly this long, which is long enough for the
+ * throughput to stabilize & short enough to keep the suite usable in an
+ * acceptance pipeline.
+ */
+static const qint64 kRunMsecs = 1000;
+
+/**
+ * Prints the name & sustained throughput of a benchmark, @a frames can be 0 for
+ * the stages that are not frame-oriented (e.g. the CRC kernels).
+ */
+static void Report(const char *name, const qint64 bytes, const qint64 frames,
+                   const qint64 nsecs)
+{
+    const double secs = nsecs / 1e9;
+    if (frames > 0)
+        printf("%-32s %10.2f MB/s %14.0f frames/s\n", name, bytes / 1e6 / secs,
+               frames / secs);
+    else
+        printf("%-32s %10.2f MB/s\n", name, bytes / 1e6 / secs);
+
+    fflush(stdout);
+}
+
+/**
+ * Generates a comma-separated frame with the given number of @a datasets, wrapped
+ * in the default start/finish delimiter sequences of the frame reader.
+ */
+static QByteArray BuildDelimitedFrame(const int datasets)
+{
+    QByteArray frame = "/*";
+    for (int i = 0; i < datasets; ++i)
+    {
+        if (i > 0)
+            frame.append(',');
+        frame.append(QByteArray::number(i * 1.0 + 0.5, 'f', 2));
+    }
+
+    frame.append("*/");
+    return frame;
+}
+
+/**
+ * Measures the frame extraction rate of the @c IO::FrameReader delimiter scanner
+ * with chunks that contain several delimited frames each, which mimics a device
+ * pushing data at line rate.
+ */
+static void BenchmarkFrameReader()
+{
+    IO::FrameQueue queue(4096);
+    IO::FrameReader reader(&queue);
+    reader.setCoalesceSettings(1, 0);
+
+    // Build a chunk with 100 frames of 16 datasets each
+    QByteArray chunk;
+    const auto frame = BuildDelimitedFrame(16);
+    for (int i = 0; i < 100; ++i)
+        chunk.append(frame);
+
+    // Feed the chunk repeatedly & drain the output queue
+    qint64 bytes = 0;
+    qint64 frames = 0;
+    QVector<QByteArray> batch;
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kRunMsecs)
+    {
+        reader.processData(chunk);
+        bytes += chunk.size();
+        frames += queue.dequeue(batch, queue.capacity());
+        batch.clear();
+    }
+
+    Report("FrameReader (text delimiters)", bytes, frames, timer.nsecsElapsed());
+}
+
+/**
+ * Measures the throughput of the table-driven CRC kernels over a 64 KB buffer.
+ */
+static void BenchmarkChecksums()
+{
+    QByteArray buffer(64 * 1024, '\0');
+    for (int i = 0; i < buffer.size(); ++i)
+        buffer[i] = static_cast<char>(i * 31);
+
+    struct
+    {
+        const char *name;
+        quint32 (*kernel)(const char *, const int);
+    } kernels[] = {
+        { "Checksum (CRC-8)",
+          [](const char *d, const int l) { return quint32(IO::crc8(d, l)); } },
+        { "Checksum (CRC-16)",
+          [](const char *d, const int l) { return quint32(IO::crc16(d, l)); } },
+        { "Checksum (CRC-32)",
+          [](const char *d, const int l) { return IO::crc32(d, l); } },
+    };
+
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); ++i)
+    {
+        qint64 bytes = 0;
+        volatile quint32 sink = 0;
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < kRunMsecs)
+        {
+            sink = sink + kernels[i].kernel(buffer.constData(), buffer.size());
+            bytes += buffer.size();
+        }
+
+        Q_UNUSED(sink);
+        Report(kernels[i].name, bytes, 0, timer.nsecsElapsed());
+    }
+}
+
+/**
+ * Measures @c JSON::Generator::readData() in automatic mode with a synthetic JSON
+ * frame of 3 groups & 8 datasets each.
+ */
+static void BenchmarkGeneratorAuto()
+{
+    auto &generator = JSON::Generator::instance();
+    generator.setOperationMode(JSON::Generator::kAutomatic);
+
+    // Build a representative JSON frame
+    QJsonArray groups;
+    for (int g = 0; g < 3; ++g)
+    {
+        QJsonArray datasets;
+        for (int d = 0; d < 8; ++d)
+        {
+            QJsonObject dataset;
+            dataset.insert("title", QString("Channel %1").arg(d));
+            dataset.insert("value", QString::number(g * 8 + d + 0.5, 'f', 2));
+            dataset.insert("units", "V");
+            dataset.insert("graph", true);
+            datasets.append(dataset);
+        }
+
+        QJsonObject group;
+        group.insert("title", QString("Group %1").arg(g));
+        group.insert("widget", "");
+        group.insert("datasets", datasets);
+        groups.append(group);
+    }
+
+    QJsonObject object;
+    object.insert("title", "Benchmark");
+    object.insert("groups", groups);
+    const auto frame = QJsonDocument(object).toJson(QJsonDocument::Compact);
+
+    // Parse the frame repeatedly
+    qint64 bytes = 0;
+    qint64 frames = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kRunMsecs)
+    {
+        QMetaObject::invokeMethod(&generator, "readData", Qt::DirectConnection,
+                                  Q_ARG(QByteArray, frame));
+        bytes += frame.size();
+        ++frames;
+    }
+
+    Report("Generator (automatic mode)", bytes, frames, timer.nsecsElapsed());
+}
+
+/**
+ * Measures @c JSON::Generator::readData() in manual mode, the benchmark generates
+ * a temporary JSON map file with 16 value placeholders & feeds comma-separated
+ * frames through the compiled template.
+ */
+static void BenchmarkGeneratorManual()
+{
+    // Build a JSON map with one group & 16 datasets mapped to "%1".."%16"
+    QJsonArray datasets;
+    for (int d = 0; d < 16; ++d)
+    {
+        QJsonObject dataset;
+        dataset.insert("title", QString("Channel %1").arg(d + 1));
+        dataset.insert("value", QString("%%1").arg(d + 1));
+        dataset.insert("graph", true);
+        datasets.append(dataset);
+    }
+
+    QJsonObject group;
+    group.insert("title", "Group");
+    group.insert("widget", "");
+    group.insert("datasets", datasets);
+
+    QJsonObject object;
+    object.insert("title", "Benchmark");
+    object.insert("groups", QJsonArray { group });
+
+    // Write the map to a temporary file & load it
+    QTemporaryFile mapFile;
+    if (!mapFile.open())
+    {
+        printf("%-32s skipped (cannot create temporary map file)\n",
+               "Generator (manual mode)");
+        return;
+    }
+
+    mapFile.write(QJsonDocument(object).toJson(QJsonDocument::Indented));
+    mapFile.flush();
+
+    auto &generator = JSON::Generator::instance();
+    generator.loadJsonMap(mapFile.fileName());
+    generator.setOperationMode(JSON::Generator::kManual);
+
+    // Build a comma-separated frame with 16 values
+    QByteArray frame;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (i > 0)
+            frame.append(',');
+        frame.append(QByteArray::number(i + 0.5, 'f', 2));
+    }
+
+    // Feed the frame repeatedly
+    qint64 bytes = 0;
+    qint64 frames = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kRunMsecs)
+    {
+        QMetaObject::invokeMethod(&generator, "readData", Qt::DirectConnection,
+                                  Q_ARG(QByteArray, frame));
+        bytes += frame.size();
+        ++frames;
+    }
+
+    Report("Generator (manual mode)", bytes, frames, timer.nsecsElapsed());
+    generator.setOperationMode(JSON::Generator::kAutomatic);
+}
+
+/**
+ * Measures the console hex-dump formatter with 4 KB chunks, which corresponds to
+ * the display path used when the console is set to hexadecimal mode.
+ */
+static void BenchmarkHexDump()
+{
+    auto &console = IO::Console::instance();
+    console.setEcho(false);
+    console.setDisplayMode(IO::Console::DisplayMode::DisplayHexadecimal);
+
+    QByteArray chunk(4096, '\0');
+    for (int i = 0; i < chunk.size(); ++i)
+        chunk[i] = static_cast<char>(i * 17);
+
+    qint64 bytes = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kRunMsecs)
+    {
+        QMetaObject::invokeMethod(&console, "onDataReceived", Qt::DirectConnection,
+                                  Q_ARG(QByteArray, chunk));
+        bytes += chunk.size();
+    }
+
+    Report("Console (hex dump)", bytes, 0, timer.nsecsElapsed());
+}
+
+/**
+ * @brief Entry-point function of the benchmark harness
+ *
+ * The application name is changed so that the benchmarks do not clobber the
+ * settings of a regular Serial Studio installation (e.g. the JSON map location
+ * written by the manual-mode benchmark).
+ */
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+    app.setApplicationName("Serial Studio Benchmarks");
+    app.setOrganizationName("Serial Studio Benchmarks");
+
+    printf("Serial Studio pipeline benchmarks (Qt %s)\n", qVersion());
+    printf("----------------------------------------------------------------\n");
+
+    BenchmarkFrameReader();
+    BenchmarkChecksums();
+    BenchmarkGeneratorAuto();
+    BenchmarkGeneratorManual();
+    BenchmarkHexDump();
+
+    return EXIT_SUCCESS;
+}
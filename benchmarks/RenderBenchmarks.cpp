@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Offscreen render benchmark for the dashboard widgets. The harness feeds
+// synthetic frames through the real JSON generator & dashboard pipeline,
+// instantiates each widget class & measures how long a single offscreen paint
+// takes at several dataset & point counts.
+//
+// Build & run:
+//   qmake Serial-Studio-RenderBenchmarks.pro && make
+//   ./serial-studio-render-benchmarks -platform offscreen
+//
+// The numbers are meant to be archived per build & compared across releases
+// (e.g. "Plot: 1.8 ms @ 100k points"), so that render regressions are caught
+// before they reach rigs where the dashboard must hold 20 FPS.
+//
+
+#include <cstdio>
+
+#include <QtMath>
+#include <QImage>
+#include <QWidget>
+#include <QPainter>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+
+#include <UI/Dashboard.h>
+#include <JSON/Generator.h>
+#include <UI/Widgets/Plot.h>
+#include <UI/Widgets/Gauge.h>
+#include <UI/Widgets/FFTPlot.h>
+#include <UI/Widgets/LEDPanel.h>
+#include <UI/Widgets/MultiPlot.h>
+#include <UI/Widgets/DataGroup.h>
+
+/**
+ * Each paint loop runs for roughly this long, which is long enough for the
+ * per-paint time to stabilize & short enough to keep the suite usable in an
+ * acceptance pipeline.
+ */
+static const qint64 kRunMsecs = 1000;
+
+/**
+ * Widgets are rendered at a typical dashboard cell size
+ */
+static const int kCanvasWidth = 800;
+static const int kCanvasHeight = 600;
+
+/**
+ * Builds a dataset object of the synthetic project frame, @a value is encoded
+ * with two decimals like the values generated by a real device would be.
+ */
+static QJsonObject BuildDataset(const int index, const double value,
+                                const QString &widget)
+{
+    QJsonObject dataset;
+    dataset.insert("title", QString("Channel %1").arg(index + 1));
+    dataset.insert("value", QString::number(value, 'f', 2));
+    dataset.insert("units", "V");
+    dataset.insert("widget", widget);
+    return dataset;
+}
+
+/**
+ * Feeds @a count synthetic frames generated by the given @a builder function
+ * through the JSON generator & consumes them on the dashboard, so the widget
+ * vectors & plot buffers reflect the synthetic project when the loop returns.
+ * The builder receives the frame number & returns the full frame object.
+ */
+template<typename Builder>
+static void FeedFrames(const int count, Builder builder)
+{
+    auto &generator = JSON::Generator::instance();
+    auto &dashboard = UI::Dashboard::instance();
+
+    for (int i = 0; i < count; ++i)
+    {
+        const auto json = QJsonDocument(builder(i)).toJson(QJsonDocument::Compact);
+        QMetaObject::invokeMethod(&generator, "readData", Qt::DirectConnection,
+                                  Q_ARG(QByteArray, json));
+        QMetaObject::invokeMethod(&dashboard, "consumePendingFrame",
+                                  Qt::DirectConnection);
+    }
+}
+
+/**
+ * Measures the offscreen paint time of the given @a widget & prints it next to
+ * the @a name & @a config of the scenario. The data of the widget is updated
+ * once before the loop, so the reported time covers painting only.
+ */
+static void MeasurePaint(QWidget &widget, const char *name, const QString &config)
+{
+    widget.resize(kCanvasWidth, kCanvasHeight);
+    QMetaObject::invokeMethod(&widget, "updateData", Qt::DirectConnection);
+
+    // Let the widget process its pending layout/polish events
+    QCoreApplication::processEvents();
+
+    // Paint repeatedly into an offscreen image
+    QImage canvas(kCanvasWidth, kCanvasHeight, QImage::Format_RGB32);
+    qint64 paints = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kRunMsecs)
+    {
+        QPainter painter(&canvas);
+        widget.render(&painter);
+        ++paints;
+    }
+
+    const double msecs = timer.nsecsElapsed() / 1e6 / qMax(qint64(1), paints);
+    printf("%-12s %8.3f ms/paint @ %s\n", name, msecs,
+           config.toStdString().c_str());
+    fflush(stdout);
+}
+
+/**
+ * Measures @c Widgets::Plot with a single graph dataset at several point
+ * counts, the point count is applied through the global plot-points setting of
+ * the dashboard.
+ */
+static void BenchmarkPlot()
+{
+    const int pointCounts[] = { 1000, 10000, 100000 };
+    for (size_t p = 0; p < sizeof(pointCounts) / sizeof(pointCounts[0]); ++p)
+    {
+        const int points = pointCounts[p];
+        UI::Dashboard::instance().setPoints(points);
+
+        FeedFrames(16, [](const int n) {
+            QJsonObject dataset = BuildDataset(0, qSin(n * 0.1) * 10, "");
+            dataset.insert("graph", true);
+
+            QJsonObject group;
+            group.insert("title", "Group");
+            group.insert("widget", "");
+            group.insert("datasets", QJsonArray { dataset });
+
+            QJsonObject object;
+            object.insert("title", "Render benchmark (plot)");
+            object.insert("groups", QJsonArray { group });
+            return object;
+        });
+
+        Widgets::Plot widget(0);
+        MeasurePaint(widget, "Plot", QString("%1 points").arg(points));
+    }
+
+    UI::Dashboard::instance().setPoints(100);
+}
+
+/**
+ * Measures @c Widgets::MultiPlot with a multiplot group at several dataset
+ * counts, every curve holds the default number of points.
+ */
+static void BenchmarkMultiPlot()
+{
+    const int datasetCounts[] = { 4, 16 };
+    for (size_t d = 0; d < sizeof(datasetCounts) / sizeof(datasetCounts[0]); ++d)
+    {
+        const int datasets = datasetCounts[d];
+        FeedFrames(16, [datasets](const int n) {
+            QJsonArray array;
+            for (int i = 0; i < datasets; ++i)
+            {
+                QJsonObject dataset = BuildDataset(i, qSin((n + i) * 0.1) * 10, "");
+                dataset.insert("graph", false);
+                array.append(dataset);
+            }
+
+            QJsonObject group;
+            group.insert("title", "Group");
+            group.insert("widget", "multiplot");
+            group.insert("datasets", array);
+
+            QJsonObject object;
+            object.insert("title", "Render benchmark (multiplot)");
+            object.insert("groups", QJsonArray { group });
+            return object;
+        });
+
+        Widgets::MultiPlot widget(0);
+        MeasurePaint(widget, "MultiPlot", QString("%1 datasets").arg(datasets));
+    }
+}
+
+/**
+ * Measures @c Widgets::FFTPlot with a single FFT dataset at several window
+ * sizes, the paint covers the spectrum curve (the transform itself runs on a
+ * worker thread & is measured by the pipeline benchmarks).
+ */
+static void BenchmarkFftPlot()
+{
+    const int sampleCounts[] = { 1024, 4096 };
+    for (size_t s = 0; s < sizeof(sampleCounts) / sizeof(sampleCounts[0]); ++s)
+    {
+        const int samples = sampleCounts[s];
+        FeedFrames(16, [samples](const int n) {
+            QJsonObject dataset = BuildDataset(0, qSin(n * 0.5) * 10, "");
+            dataset.insert("fft", true);
+            dataset.insert("fftSamples", QString::number(samples));
+
+            QJsonObject group;
+            group.insert("title", "Group");
+            group.insert("widget", "");
+            group.insert("datasets", QJsonArray { dataset });
+
+            QJsonObject object;
+            object.insert("title", "Render benchmark (fft)");
+            object.insert("groups", QJsonArray { group });
+            return object;
+        });
+
+        Widgets::FFTPlot widget(0);
+        MeasurePaint(widget, "FFTPlot", QString("%1 samples").arg(samples));
+    }
+}
+
+/**
+ * Measures @c Widgets::Gauge with a single gauge dataset
+ */
+static void BenchmarkGauge()
+{
+    FeedFrames(16, [](const int n) {
+        QJsonObject dataset = BuildDataset(0, 50 + qSin(n * 0.1) * 40, "gauge");
+        dataset.insert("min", 0);
+        dataset.insert("max", 100);
+
+        QJsonObject group;
+        group.insert("title", "Group");
+        group.insert("widget", "");
+        group.insert("datasets", QJsonArray { dataset });
+
+        QJsonObject object;
+        object.insert("title", "Render benchmark (gauge)");
+        object.insert("groups", QJsonArray { group });
+        return object;
+    });
+
+    Widgets::Gauge widget(0);
+    MeasurePaint(widget, "Gauge", "1 dataset");
+}
+
+/**
+ * Measures @c Widgets::DataGroup with a plain group at several dataset counts
+ */
+static void BenchmarkDataGroup()
+{
+    const int datasetCounts[] = { 4, 64 };
+    for (size_t d = 0; d < sizeof(datasetCounts) / sizeof(datasetCounts[0]); ++d)
+    {
+        const int datasets = datasetCounts[d];
+        FeedFrames(16, [datasets](const int n) {
+            QJsonArray array;
+            for (int i = 0; i < datasets; ++i)
+                array.append(BuildDataset(i, n + i * 0.25, ""));
+
+            QJsonObject group;
+            group.insert("title", "Group");
+            group.insert("widget", "");
+            group.insert("datasets", array);
+
+            QJsonObject object;
+            object.insert("title", "Render benchmark (datagroup)");
+            object.insert("groups", QJsonArray { group });
+            return object;
+        });
+
+        Widgets::DataGroup widget(0);
+        MeasurePaint(widget, "DataGroup", QString("%1 datasets").arg(datasets));
+    }
+}
+
+/**
+ * Measures @c Widgets::LEDPanel with several LED counts
+ */
+static void BenchmarkLedPanel()
+{
+    const int ledCounts[] = { 8, 32 };
+    for (size_t d = 0; d < sizeof(ledCounts) / sizeof(ledCounts[0]); ++d)
+    {
+        const int leds = ledCounts[d];
+        FeedFrames(16, [leds](const int n) {
+            QJsonArray array;
+            for (int i = 0; i < leds; ++i)
+            {
+                QJsonObject dataset = BuildDataset(i, (n + i) % 2, "");
+                dataset.insert("led", true);
+                array.append(dataset);
+            }
+
+            QJsonObject group;
+            group.insert("title", "Group");
+            group.insert("widget", "");
+            group.insert("datasets", array);
+
+            QJsonObject object;
+            object.insert("title", "Render benchmark (leds)");
+            object.insert("groups", QJsonArray { group });
+            return object;
+        });
+
+        Widgets::LEDPanel widget(0);
+        MeasurePaint(widget, "LEDPanel", QString("%1 LEDs").arg(leds));
+    }
+}
+
+/**
+ * @brief Entry-point function of the render benchmark harness
+ *
+ * The application name is changed so that the benchmarks do not clobber the
+ * settings of a regular Serial Studio installation. Run with the offscreen
+ * platform plugin (-platform offscreen) to execute on headless build machines.
+ */
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+    app.setApplicationName("Serial Studio Benchmarks");
+    app.setOrganizationName("Serial Studio Benchmarks");
+
+    auto &generator = JSON::Generator::instance();
+    generator.setOperationMode(JSON::Generator::kAutomatic);
+
+    printf("Serial Studio render benchmarks (Qt %s, %dx%d canvas)\n", qVersion(),
+           kCanvasWidth, kCanvasHeight);
+    printf("----------------------------------------------------------------\n");
+
+    BenchmarkPlot();
+    BenchmarkMultiPlot();
+    BenchmarkFftPlot();
+    BenchmarkGauge();
+    BenchmarkDataGroup();
+    BenchmarkLedPanel();
+
+    return EXIT_SUCCESS;
+}
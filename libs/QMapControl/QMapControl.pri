@@ -61,3 +61,7 @@ SOURCES += $$PWD/src/curve.cpp \
            $$PWD/src/emptymapadapter.cpp \
            $$PWD/src/bingapimapadapter.cpp \
            $$PWD/src/googleapimapadapter.cpp
+
+# Build the library as its own single compilation unit when the unity build is
+# active (debug builds stay file-by-file & incremental)
+CONFIG(unity_build): SOURCES += $$PWD/QMapControlSingleCompilationUnit.cpp
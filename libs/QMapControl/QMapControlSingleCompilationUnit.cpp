@@ -0,0 +1,63 @@
+//
+// Per-library single compilation unit for QMapControl, compiled only when the release
+// unity build is active (see Serial-Studio.pro & QMapControl.pri). Splitting the
+// third-party code out of src/SingleCompilationUnit.cpp lets the compiler work on
+// the application & on every bundled library in parallel, instead of grinding
+// through one serial mega-unit.
+//
+
+#if UNITY_BUILD
+
+// clang-format off
+
+#include "src/curve.cpp"
+#include "src/geometry.cpp"
+#include "src/imagemanager.cpp"
+#include "src/layer.cpp"
+#include "src/layermanager.cpp"
+#include "src/linestring.cpp"
+#include "src/mapadapter.cpp"
+#include "src/mapcontrol.cpp"
+#include "src/mapnetwork.cpp"
+#include "src/point.cpp"
+#include "src/tilemapadapter.cpp"
+#include "src/wmsmapadapter.cpp"
+#include "src/circlepoint.cpp"
+#include "src/imagepoint.cpp"
+#include "src/gps_position.cpp"
+#include "src/osmmapadapter.cpp"
+#include "src/maplayer.cpp"
+#include "src/geometrylayer.cpp"
+#include "src/googlemapadapter.cpp"
+#include "src/openaerialmapadapter.cpp"
+#include "src/fixedimageoverlay.cpp"
+#include "src/emptymapadapter.cpp"
+#include "src/arrowpoint.cpp"
+#include "src/invisiblepoint.cpp"
+#include "src/bingapimapadapter.cpp"
+#include "src/googleapimapadapter.cpp"
+
+// Meta object compiler code, the sources do not include it themselves
+#include "moc_curve.cpp"
+#include "moc_geometry.cpp"
+#include "moc_imagemanager.cpp"
+#include "moc_layer.cpp"
+#include "moc_layermanager.cpp"
+#include "moc_linestring.cpp"
+#include "moc_mapadapter.cpp"
+#include "moc_mapcontrol.cpp"
+#include "moc_mapnetwork.cpp"
+#include "moc_point.cpp"
+#include "moc_tilemapadapter.cpp"
+#include "moc_osmmapadapter.cpp"
+#include "moc_maplayer.cpp"
+#include "moc_geometrylayer.cpp"
+#include "moc_googlemapadapter.cpp"
+#include "moc_openaerialmapadapter.cpp"
+#include "moc_emptymapadapter.cpp"
+#include "moc_bingapimapadapter.cpp"
+#include "moc_googleapimapadapter.cpp"
+
+// clang-format on
+
+#endif
@@ -62,7 +62,8 @@ ImageManager::~ImageManager()
     net = 0;
 }
 
-QPixmap ImageManager::getImage(const QString &host, const QString &url)
+QPixmap ImageManager::getImage(const QString &host, const QString &url,
+                               QNetworkRequest::Priority priority)
 {
     // qDebug() << "ImageManager::getImage";
     QPixmap pm;
@@ -95,7 +96,7 @@ QPixmap ImageManager::getImage(const QString &host, const QString &url)
     else
     {
         // load from net, add empty image
-        net->loadImage(host, url);
+        net->loadImage(host, url, priority);
     }
     return emptyPixmap;
 }
@@ -109,7 +110,8 @@ QPixmap ImageManager::prefetchImage(const QString &host, const QString &url)
     // very slow in repainting the screen
     prefetch.append(url);
 #endif
-    return getImage(host, url);
+    // prefetched tiles are speculative, visible tiles must go first
+    return getImage(host, url, QNetworkRequest::LowPriority);
 }
 
 void ImageManager::receivedImage(const QPixmap pixmap, const QString &url)
@@ -36,6 +36,7 @@
 #include <QBuffer>
 #include <QDir>
 #include <QNetworkDiskCache>
+#include <QNetworkRequest>
 
 namespace qmapcontrol
 {
@@ -58,8 +59,11 @@ public:
      * @param path the path to the image
      * @return the pixmap of the asked image
      */
-    QPixmap getImage(const QString &host, const QString &path);
+    QPixmap getImage(const QString &host, const QString &path,
+                     QNetworkRequest::Priority priority
+                     = QNetworkRequest::NormalPriority);
 
+    //! requests an image that is not visible yet with low network priority
     QPixmap prefetchImage(const QString &host, const QString &path);
 
     void receivedImage(const QPixmap pixmap, const QString &url);
@@ -24,6 +24,9 @@
  */
 
 #include "layer.h"
+
+#include <QNetworkRequest>
+#include <algorithm>
 namespace qmapcontrol
 {
 Layer::Layer()
@@ -293,7 +296,8 @@ void Layer::_draw(QPainter *painter, const QPoint mapmiddle_px) const
         return;
     }
 
-    // grab the middle tile (under the pointer) first
+    // grab the middle tile (under the pointer) first, with high network
+    // priority so that it wins over the other visible tiles
     if (mapAdapter->isTileValid(mapmiddle_tile_x, mapmiddle_tile_y,
                                 mapAdapter->currentZoom()))
     {
@@ -301,7 +305,8 @@ void Layer::_draw(QPainter *painter, const QPoint mapmiddle_px) const
             -cross_x + size.width(), -cross_y + size.height(),
             m_ImageManager->getImage(mapAdapter->host(),
                                      mapAdapter->query(mapmiddle_tile_x, mapmiddle_tile_y,
-                                                       mapAdapter->currentZoom())));
+                                                       mapAdapter->currentZoom()),
+                                     QNetworkRequest::HighPriority));
     }
 
     for (int i = -tiles_left + mapmiddle_tile_x; i <= tiles_right + mapmiddle_tile_x; ++i)
@@ -325,50 +330,44 @@ void Layer::_draw(QPainter *painter, const QPoint mapmiddle_px) const
         }
     }
 
-    bool enabledPrefetch = false;
-    if (enabledPrefetch)
+    // Prefetch the ring of tiles around the viewport with low network
+    // priority (ready for when the user starts panning). The ring is
+    // requested from the center outwards, so the tiles most likely to become
+    // visible arrive first.
+    const int prefetch_tile_left = mapmiddle_tile_x - tiles_left - 1;
+    const int prefetch_tile_top = mapmiddle_tile_y - tiles_above - 1;
+    const int prefetch_tile_right = mapmiddle_tile_x + tiles_right + 1;
+    const int prefetch_tile_bottom = mapmiddle_tile_y + tiles_bottom + 1;
+
+    QList<QPoint> ring;
+    for (int i = prefetch_tile_left; i <= prefetch_tile_right; ++i)
     {
-        // Prefetch the next set of rows/column tiles (ready for when the user starts
-        // panning).
-        const int prefetch_tile_left = tiles_left - 1;
-        const int prefetch_tile_top = tiles_above - 1;
-        const int prefetch_tile_right = tiles_right + 1;
-        const int prefetch_tile_bottom = tiles_bottom + 1;
-
-        // Fetch the top/bottom rows
-        for (int i = prefetch_tile_left; i <= prefetch_tile_right; ++i)
-        {
-            if (mapAdapter->isTileValid(i, prefetch_tile_top, mapAdapter->currentZoom()))
-            {
-                m_ImageManager->prefetchImage(
-                    mapAdapter->host(),
-                    mapAdapter->query(i, prefetch_tile_top, mapAdapter->currentZoom()));
-            }
-            if (mapAdapter->isTileValid(i, prefetch_tile_bottom,
-                                        mapAdapter->currentZoom()))
-            {
-                m_ImageManager->prefetchImage(
-                    mapAdapter->host(),
-                    mapAdapter->query(i, prefetch_tile_bottom,
-                                      mapAdapter->currentZoom()));
-            }
-        }
+        ring.append(QPoint(i, prefetch_tile_top));
+        ring.append(QPoint(i, prefetch_tile_bottom));
+    }
+    for (int j = prefetch_tile_top + 1; j <= prefetch_tile_bottom - 1; ++j)
+    {
+        ring.append(QPoint(prefetch_tile_left, j));
+        ring.append(QPoint(prefetch_tile_right, j));
+    }
 
-        for (int i = prefetch_tile_top; i <= prefetch_tile_bottom; ++i)
+    // sort by squared tile distance from the viewport center
+    std::sort(ring.begin(), ring.end(),
+              [mapmiddle_tile_x, mapmiddle_tile_y](const QPoint &a, const QPoint &b) {
+                  const int da = (a.x() - mapmiddle_tile_x) * (a.x() - mapmiddle_tile_x)
+                                 + (a.y() - mapmiddle_tile_y) * (a.y() - mapmiddle_tile_y);
+                  const int db = (b.x() - mapmiddle_tile_x) * (b.x() - mapmiddle_tile_x)
+                                 + (b.y() - mapmiddle_tile_y) * (b.y() - mapmiddle_tile_y);
+                  return da < db;
+              });
+
+    foreach (const QPoint &tile, ring)
+    {
+        if (mapAdapter->isTileValid(tile.x(), tile.y(), mapAdapter->currentZoom()))
         {
-            if (mapAdapter->isTileValid(prefetch_tile_left, i, mapAdapter->currentZoom()))
-            {
-                m_ImageManager->prefetchImage(
-                    mapAdapter->host(),
-                    mapAdapter->query(prefetch_tile_left, i, mapAdapter->currentZoom()));
-            }
-            if (mapAdapter->isTileValid(prefetch_tile_right, i,
-                                        mapAdapter->currentZoom()))
-            {
-                m_ImageManager->prefetchImage(
-                    mapAdapter->host(),
-                    mapAdapter->query(prefetch_tile_right, i, mapAdapter->currentZoom()));
-            }
+            m_ImageManager->prefetchImage(
+                mapAdapter->host(),
+                mapAdapter->query(tile.x(), tile.y(), mapAdapter->currentZoom()));
         }
     }
 }
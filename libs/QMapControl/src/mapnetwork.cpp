@@ -35,17 +35,27 @@
 #include <QRegExp>
 #endif
 
+// number of parallel QNetworkAccessManager instances, each manager opens its
+// own set of connections to the tile server so that tile downloads are not
+// serialized behind the per-host connection limit of a single manager
+static const int kConcurrentManagers = 4;
+
 namespace qmapcontrol
 {
 MapNetwork::MapNetwork(ImageManager *parent)
     : parent(parent)
-    , http(new QNetworkAccessManager(this))
     , loaded(0)
     , networkActive(false)
     , cacheEnabled(false)
 {
-    connect(http, SIGNAL(finished(QNetworkReply *)), this,
-            SLOT(requestFinished(QNetworkReply *)));
+    for (int i = 0; i < kConcurrentManagers; ++i)
+    {
+        QNetworkAccessManager *http = new QNetworkAccessManager(this);
+        connect(http, SIGNAL(finished(QNetworkReply *)), this,
+                SLOT(requestFinished(QNetworkReply *)));
+        httpPool.append(http);
+        pendingRequests.insert(http, 0);
+    }
 }
 
 MapNetwork::~MapNetwork()
@@ -60,11 +70,15 @@ MapNetwork::~MapNetwork()
         reply = 0;
     }
 
-    http->deleteLater();
-    http = 0;
+    foreach (QNetworkAccessManager *http, httpPool)
+    {
+        http->deleteLater();
+    }
+    httpPool.clear();
 }
 
-void MapNetwork::loadImage(const QString &host, const QString &url)
+void MapNetwork::loadImage(const QString &host, const QString &url,
+                           QNetworkRequest::Priority priority)
 {
     QString hostName = host;
     QString portNumber = QString("80");
@@ -95,11 +109,31 @@ void MapNetwork::loadImage(const QString &host, const QString &url)
         "User-Agent",
         "Mozilla/5.0 (PC; U; Intel; Linux; en) AppleWebKit/420+ (KHTML, like Gecko)");
 
+    // visible tiles preempt queued prefetch requests inside each manager
+    request.setPriority(priority);
+
     QMutexLocker lock(&vectorMutex);
+    QNetworkAccessManager *http = nextFreeHttp();
+    pendingRequests[http]++;
     replyList.append(http->get(request));
     loadingMap.insert(finalUrl, url);
 }
 
+QNetworkAccessManager *MapNetwork::nextFreeHttp()
+{
+    // pick the manager with the fewest requests in flight, the caller holds
+    // the vector mutex
+    QNetworkAccessManager *best = httpPool.first();
+    for (int i = 1; i < httpPool.size(); ++i)
+    {
+        if (pendingRequests.value(httpPool.at(i)) < pendingRequests.value(best))
+        {
+            best = httpPool.at(i);
+        }
+    }
+    return best;
+}
+
 void MapNetwork::requestFinished(QNetworkReply *reply)
 {
     if (!reply)
@@ -161,6 +195,10 @@ void MapNetwork::requestFinished(QNetworkReply *reply)
 
     QMutexLocker lock(&vectorMutex);
     replyList.removeAll(reply);
+    if (reply->manager() && pendingRequests.contains(reply->manager()))
+    {
+        pendingRequests[reply->manager()]--;
+    }
 
     reply->deleteLater();
     reply = 0;
@@ -175,9 +213,27 @@ int MapNetwork::loadQueueSize() const
 void MapNetwork::setDiskCache(QNetworkDiskCache *qCache)
 {
     cacheEnabled = (qCache != 0);
-    if (http)
+
+    // a cache instance can only be owned by one manager, the remaining
+    // managers of the pool get their own instance over the same directory
+    for (int i = 0; i < httpPool.size(); ++i)
     {
-        http->setCache(qCache);
+        QNetworkAccessManager *http = httpPool.at(i);
+        if (!qCache)
+        {
+            http->setCache(0);
+        }
+        else if (i == 0)
+        {
+            http->setCache(qCache);
+        }
+        else
+        {
+            QNetworkDiskCache *cache = new QNetworkDiskCache(http);
+            cache->setCacheDirectory(qCache->cacheDirectory());
+            cache->setMaximumCacheSize(qCache->maximumCacheSize());
+            http->setCache(cache);
+        }
     }
 }
 
@@ -215,11 +271,11 @@ void MapNetwork::setProxy(const QString host, const int port, const QString user
 {
     // do not set proxy on qt/extended
 #ifndef Q_WS_QWS
-    if (http)
+    QNetworkProxy proxy = QNetworkProxy(QNetworkProxy::HttpProxy, host, port);
+    proxy.setUser(username);
+    proxy.setPassword(password);
+    foreach (QNetworkAccessManager *http, httpPool)
     {
-        QNetworkProxy proxy = QNetworkProxy(QNetworkProxy::HttpProxy, host, port);
-        proxy.setUser(username);
-        proxy.setPassword(password);
         http->setProxy(proxy);
     }
 #endif
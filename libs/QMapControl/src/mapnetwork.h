@@ -31,9 +31,11 @@
 #include <QDebug>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QNetworkRequest>
 #include <QNetworkProxy>
 #include <QAuthenticator>
 #include <QVector>
+#include <QHash>
 #include <QPixmap>
 #include <QMutex>
 #include "imagemanager.h"
@@ -52,7 +54,9 @@ public:
     MapNetwork(ImageManager *parent);
     ~MapNetwork();
 
-    void loadImage(const QString &host, const QString &url);
+    void loadImage(const QString &host, const QString &url,
+                   QNetworkRequest::Priority priority
+                   = QNetworkRequest::NormalPriority);
 
     /*!
      * checks if the given url is already loading
@@ -92,7 +96,8 @@ private:
     Q_DISABLE_COPY(MapNetwork)
 
     ImageManager *parent;
-    QNetworkAccessManager *http;
+    QVector<QNetworkAccessManager *> httpPool;
+    QHash<QNetworkAccessManager *, int> pendingRequests;
     QList<QNetworkReply *> replyList;
     QMap<QString, QString> loadingMap;
     qreal loaded;
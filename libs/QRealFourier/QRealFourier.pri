@@ -38,3 +38,7 @@ SOURCES += \
     $$PWD/sources/qfouriertransformer.cpp \
     $$PWD/sources/qfouriervariablecalculator.cpp \
     $$PWD/sources/qwindowfunction.cpp
+
+# Build the library as its own single compilation unit when the unity build is
+# active (debug builds stay file-by-file & incremental)
+CONFIG(unity_build): SOURCES += $$PWD/QRealFourierSingleCompilationUnit.cpp
@@ -0,0 +1,22 @@
+//
+// Per-library single compilation unit for QRealFourier, compiled only when the release
+// unity build is active (see Serial-Studio.pro & QRealFourier.pri). Splitting the
+// third-party code out of src/SingleCompilationUnit.cpp lets the compiler work on
+// the application & on every bundled library in parallel, instead of grinding
+// through one serial mega-unit.
+//
+
+#if UNITY_BUILD
+
+// clang-format off
+
+#include "sources/qcomplexnumber.cpp"
+#include "sources/qfouriercalculator.cpp"
+#include "sources/qfourierfixedcalculator.cpp"
+#include "sources/qfouriertransformer.cpp"
+#include "sources/qfouriervariablecalculator.cpp"
+#include "sources/qwindowfunction.cpp"
+
+// clang-format on
+
+#endif
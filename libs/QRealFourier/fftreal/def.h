@@ -41,6 +41,10 @@ const double	SQRT2	= 1.41421356237309514547462185873883;
 
 	#define	ffft_FORCEINLINE	__forceinline
 
+#elif defined (__GNUC__)
+
+	#define	ffft_FORCEINLINE	inline __attribute__ ((always_inline))
+
 #else
 
 	#define	ffft_FORCEINLINE	inline
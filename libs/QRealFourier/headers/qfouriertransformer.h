@@ -86,6 +86,7 @@ class QFourierTransformer
 	protected:
 
 		void initialize();
+		QFourierCalculator* createFixedCalculator(int key);
 		int sizeToKey(int size);
 		bool isValidSize(int value);
 
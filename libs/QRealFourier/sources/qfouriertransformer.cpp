@@ -73,6 +73,14 @@ QFourierTransformer::Initialization QFourierTransformer::setSize(int size)
 			mWindowFunction->create(mSize);
 		}
 		int key = sizeToKey(mSize);
+		if(!mFixedCalculators.contains(key))
+		{
+			QFourierCalculator *calculator = createFixedCalculator(key);
+			if(calculator != 0)
+			{
+				mFixedCalculators.insert(key, calculator);
+			}
+		}
 		if(mFixedCalculators.contains(key))
 		{
 			mCalculator = mFixedCalculators[key];
@@ -151,22 +159,31 @@ void QFourierTransformer::rescale(float input[])
 
 void QFourierTransformer::initialize()
 {
-	mFixedCalculators.insert(3, new QFourierFixedCalculator<3>());
-	mFixedCalculators.insert(4, new QFourierFixedCalculator<4>());
-	mFixedCalculators.insert(5, new QFourierFixedCalculator<5>());
-	mFixedCalculators.insert(6, new QFourierFixedCalculator<6>());
-	mFixedCalculators.insert(7, new QFourierFixedCalculator<7>());
-	mFixedCalculators.insert(8, new QFourierFixedCalculator<8>());
-	mFixedCalculators.insert(9, new QFourierFixedCalculator<9>());
-	mFixedCalculators.insert(10, new QFourierFixedCalculator<10>());
-	mFixedCalculators.insert(11, new QFourierFixedCalculator<11>());
-	mFixedCalculators.insert(12, new QFourierFixedCalculator<12>());
-	mFixedCalculators.insert(13, new QFourierFixedCalculator<13>());
-	mFixedCalculators.insert(14, new QFourierFixedCalculator<14>());
-
 	mVariableCalculator = new QFourierVariableCalculator();
 }
 
+QFourierCalculator* QFourierTransformer::createFixedCalculator(int key)
+{
+	// Fixed calculators are created on demand, creating one precomputes the
+	// twiddle & bit-reversal tables for its size
+	switch(key)
+	{
+		case 3: return new QFourierFixedCalculator<3>();
+		case 4: return new QFourierFixedCalculator<4>();
+		case 5: return new QFourierFixedCalculator<5>();
+		case 6: return new QFourierFixedCalculator<6>();
+		case 7: return new QFourierFixedCalculator<7>();
+		case 8: return new QFourierFixedCalculator<8>();
+		case 9: return new QFourierFixedCalculator<9>();
+		case 10: return new QFourierFixedCalculator<10>();
+		case 11: return new QFourierFixedCalculator<11>();
+		case 12: return new QFourierFixedCalculator<12>();
+		case 13: return new QFourierFixedCalculator<13>();
+		case 14: return new QFourierFixedCalculator<14>();
+	}
+	return 0;
+}
+
 int QFourierTransformer::sizeToKey(int size)
 {
 	float result = log(float(size)) / log(2.0);
@@ -0,0 +1,137 @@
+//
+// Per-library single compilation unit for Qwt, compiled only when the release
+// unity build is active (see Serial-Studio.pro & qwt.pri). Splitting the
+// third-party code out of src/SingleCompilationUnit.cpp lets the compiler work on
+// the application & on every bundled library in parallel, instead of grinding
+// through one serial mega-unit.
+//
+
+#if UNITY_BUILD
+
+// clang-format off
+
+#include "src/qwt.cpp"
+#include "src/qwt_abstract_scale_draw.cpp"
+#include "src/qwt_bezier.cpp"
+#include "src/qwt_clipper.cpp"
+#include "src/qwt_color_map.cpp"
+#include "src/qwt_column_symbol.cpp"
+#include "src/qwt_date.cpp"
+#include "src/qwt_date_scale_draw.cpp"
+#include "src/qwt_date_scale_engine.cpp"
+#include "src/qwt_dyngrid_layout.cpp"
+#include "src/qwt_event_pattern.cpp"
+#include "src/qwt_graphic.cpp"
+#include "src/qwt_interval.cpp"
+#include "src/qwt_interval_symbol.cpp"
+#include "src/qwt_math.cpp"
+#include "src/qwt_magnifier.cpp"
+#include "src/qwt_null_paintdevice.cpp"
+#include "src/qwt_painter.cpp"
+#include "src/qwt_painter_command.cpp"
+#include "src/qwt_panner.cpp"
+#include "src/qwt_picker.cpp"
+#include "src/qwt_picker_machine.cpp"
+#include "src/qwt_pixel_matrix.cpp"
+#include "src/qwt_point_3d.cpp"
+#include "src/qwt_point_polar.cpp"
+#include "src/qwt_round_scale_draw.cpp"
+#include "src/qwt_scale_div.cpp"
+#include "src/qwt_scale_draw.cpp"
+#include "src/qwt_scale_map.cpp"
+#include "src/qwt_scale_engine.cpp"
+#include "src/qwt_spline.cpp"
+#include "src/qwt_spline_basis.cpp"
+#include "src/qwt_spline_parametrization.cpp"
+#include "src/qwt_spline_local.cpp"
+#include "src/qwt_spline_cubic.cpp"
+#include "src/qwt_spline_pleasing.cpp"
+#include "src/qwt_spline_polynomial.cpp"
+#include "src/qwt_symbol.cpp"
+#include "src/qwt_system_clock.cpp"
+#include "src/qwt_text_engine.cpp"
+#include "src/qwt_text_label.cpp"
+#include "src/qwt_text.cpp"
+#include "src/qwt_transform.cpp"
+#include "src/qwt_widget_overlay.cpp"
+#include "src/qwt_curve_fitter.cpp"
+#include "src/qwt_spline_curve_fitter.cpp"
+#include "src/qwt_weeding_curve_fitter.cpp"
+#include "src/qwt_abstract_legend.cpp"
+#include "src/qwt_legend.cpp"
+#include "src/qwt_legend_data.cpp"
+#include "src/qwt_legend_label.cpp"
+#include "src/qwt_plot.cpp"
+#include "src/qwt_plot_renderer.cpp"
+#include "src/qwt_plot_axis.cpp"
+#include "src/qwt_plot_curve.cpp"
+#include "src/qwt_plot_dict.cpp"
+#include "src/qwt_plot_directpainter.cpp"
+#include "src/qwt_plot_graphicitem.cpp"
+#include "src/qwt_plot_grid.cpp"
+#include "src/qwt_plot_histogram.cpp"
+#include "src/qwt_plot_item.cpp"
+#include "src/qwt_plot_abstract_barchart.cpp"
+#include "src/qwt_plot_barchart.cpp"
+#include "src/qwt_plot_multi_barchart.cpp"
+#include "src/qwt_plot_intervalcurve.cpp"
+#include "src/qwt_plot_zoneitem.cpp"
+#include "src/qwt_plot_tradingcurve.cpp"
+#include "src/qwt_plot_spectrogram.cpp"
+#include "src/qwt_plot_spectrocurve.cpp"
+#include "src/qwt_plot_scaleitem.cpp"
+#include "src/qwt_plot_legenditem.cpp"
+#include "src/qwt_plot_seriesitem.cpp"
+#include "src/qwt_plot_shapeitem.cpp"
+#include "src/qwt_plot_vectorfield.cpp"
+#include "src/qwt_plot_marker.cpp"
+#include "src/qwt_plot_textlabel.cpp"
+#include "src/qwt_plot_layout.cpp"
+#include "src/qwt_plot_abstract_canvas.cpp"
+#include "src/qwt_plot_canvas.cpp"
+#include "src/qwt_plot_opengl_canvas.cpp"
+#include "src/qwt_plot_panner.cpp"
+#include "src/qwt_plot_rasteritem.cpp"
+#include "src/qwt_plot_picker.cpp"
+#include "src/qwt_plot_zoomer.cpp"
+#include "src/qwt_plot_magnifier.cpp"
+#include "src/qwt_plot_rescaler.cpp"
+#include "src/qwt_point_mapper.cpp"
+#include "src/qwt_raster_data.cpp"
+#include "src/qwt_matrix_raster_data.cpp"
+#include "src/qwt_vectorfield_symbol.cpp"
+#include "src/qwt_sampling_thread.cpp"
+#include "src/qwt_series_data.cpp"
+#include "src/qwt_point_data.cpp"
+#include "src/qwt_scale_widget.cpp"
+#include "src/qwt_polar_canvas.cpp"
+#include "src/qwt_polar_curve.cpp"
+#include "src/qwt_polar_fitter.cpp"
+#include "src/qwt_polar_grid.cpp"
+#include "src/qwt_polar_item.cpp"
+#include "src/qwt_polar_itemdict.cpp"
+#include "src/qwt_polar_layout.cpp"
+#include "src/qwt_polar_magnifier.cpp"
+#include "src/qwt_polar_marker.cpp"
+#include "src/qwt_polar_panner.cpp"
+#include "src/qwt_polar_picker.cpp"
+#include "src/qwt_polar_plot.cpp"
+#include "src/qwt_polar_renderer.cpp"
+#include "src/qwt_polar_spectrogram.cpp"
+#include "src/qwt_abstract_slider.cpp"
+#include "src/qwt_abstract_scale.cpp"
+#include "src/qwt_arrow_button.cpp"
+#include "src/qwt_analog_clock.cpp"
+#include "src/qwt_compass.cpp"
+#include "src/qwt_compass_rose.cpp"
+#include "src/qwt_counter.cpp"
+#include "src/qwt_dial.cpp"
+#include "src/qwt_dial_needle.cpp"
+#include "src/qwt_knob.cpp"
+#include "src/qwt_slider.cpp"
+#include "src/qwt_thermo.cpp"
+#include "src/qwt_wheel.cpp"
+
+// clang-format on
+
+#endif
@@ -1,8 +1,13 @@
 QWT_CONFIG += QwtPlot
 QWT_CONFIG += QwtPolar
+QWT_CONFIG += QwtOpenGL
 QWT_CONFIG += QwtWidgets
 
 DEFINES += QWT_MOC_INCLUDE=1
 
 include($$PWD/src/src.pri)
 include($$PWD/classincludes/classincludes.pri)
+
+# Build the library as its own single compilation unit when the unity build is
+# active (debug builds stay file-by-file & incremental)
+CONFIG(unity_build): SOURCES += $$PWD/QwtSingleCompilationUnit.cpp
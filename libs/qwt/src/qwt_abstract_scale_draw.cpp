@@ -47,6 +47,7 @@ class QwtAbstractScaleDraw::PrivateData
 
     double minExtent;
 
+    QFont labelCacheFont;
     QMap< double, QwtText > labelCache;
 };
 
@@ -103,6 +104,18 @@ bool QwtAbstractScaleDraw::hasComponent( ScaleComponent component ) const
  */
 void QwtAbstractScaleDraw::setScaleDiv( const QwtScaleDiv& scaleDiv )
 {
+    /*
+        Setting an unchanged scale division must not drop the cached label
+        layouts: the plot widgets re-assign the scale division on every
+        replot and recomputing the text layout and size of each tick label
+        is pure repeated work as long as the ticks are the same.
+     */
+    if ( m_data->scaleDiv == scaleDiv )
+    {
+        m_data->map.setScaleInterval( scaleDiv.lowerBound(), scaleDiv.upperBound() );
+        return;
+    }
+
     m_data->scaleDiv = scaleDiv;
     m_data->map.setScaleInterval( scaleDiv.lowerBound(), scaleDiv.upperBound() );
     m_data->labelCache.clear();
@@ -393,6 +406,16 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
 const QwtText& QwtAbstractScaleDraw::tickLabel(
     const QFont& font, double value ) const
 {
+    /*
+        The cached layouts and sizes are only valid for the font they were
+        computed with, a font change invalidates the cache.
+     */
+    if ( font != m_data->labelCacheFont )
+    {
+        m_data->labelCache.clear();
+        m_data->labelCacheFont = font;
+    }
+
     QMap< double, QwtText >::const_iterator it1 = m_data->labelCache.constFind( value );
     if ( it1 != m_data->labelCache.constEnd() )
         return *it1;
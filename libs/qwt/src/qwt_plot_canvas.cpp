@@ -10,26 +10,72 @@
 #include "qwt_plot_canvas.h"
 #include "qwt_painter.h"
 #include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_scale_map.h"
+#include "qwt_scale_div.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qevent.h>
 
+// Plot items below the default z of QwtPlotCurve belong to the static layer
+static const double qwtStaticLayerMaxZ = 20.0;
+
+static void qwtDrawPlotItems( QPainter* painter,
+    const QwtPlot* plot, const QRect& canvasRect, bool staticLayer )
+{
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+        maps[axisPos] = plot->canvasMap( axisPos );
+
+    painter->save();
+    painter->setClipRect( canvasRect, Qt::IntersectClip );
+
+    const QwtPlotItemList& itmList = plot->itemList();
+    for ( QwtPlotItemIterator it = itmList.begin();
+        it != itmList.end(); ++it )
+    {
+        QwtPlotItem* item = *it;
+        if ( item == NULL || !item->isVisible() )
+            continue;
+
+        if ( ( item->z() < qwtStaticLayerMaxZ ) != staticLayer )
+            continue;
+
+        painter->save();
+
+        painter->setRenderHint( QPainter::Antialiasing,
+            item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+        item->draw( painter,
+            maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+
+        painter->restore();
+    }
+
+    painter->restore();
+}
+
 class QwtPlotCanvas::PrivateData
 {
   public:
     PrivateData()
         : backingStore( NULL )
+        , staticStore( NULL )
     {
     }
 
     ~PrivateData()
     {
         delete backingStore;
+        delete staticStore;
     }
 
     QwtPlotCanvas::PaintAttributes paintAttributes;
     QPixmap* backingStore;
+
+    QPixmap* staticStore;
+    QwtScaleDiv staticScaleDivs[ QwtAxis::AxisPositions ];
 };
 
 /*!
@@ -103,6 +149,20 @@ void QwtPlotCanvas::setPaintAttribute( PaintAttribute attribute, bool on )
             }
             break;
         }
+        case StaticLayerStore:
+        {
+            if ( on )
+            {
+                if ( m_data->staticStore == NULL )
+                    m_data->staticStore = new QPixmap();
+            }
+            else
+            {
+                delete m_data->staticStore;
+                m_data->staticStore = NULL;
+            }
+            break;
+        }
         case Opaque:
         {
             if ( on )
@@ -142,6 +202,22 @@ void QwtPlotCanvas::invalidateBackingStore()
         *m_data->backingStore = QPixmap();
 }
 
+/*!
+   Invalidate the cached static layer
+
+   The static layer is invalidated automatically, when the size of the
+   canvas or one of the scale divisions changes. When the appearance of
+   a static item changes without affecting the scales ( f.e the pen of
+   the grid ) the cache needs to be invalidated manually.
+
+   \sa StaticLayerStore
+ */
+void QwtPlotCanvas::invalidateStaticLayerStore()
+{
+    if ( m_data->staticStore )
+        *m_data->staticStore = QPixmap();
+}
+
 /*!
    Qt event handler for QEvent::PolishRequest and QEvent::StyleChange
 
@@ -168,6 +244,13 @@ bool QwtPlotCanvas::event( QEvent* event )
         updateStyleSheetInfo();
     }
 
+    if ( event->type() == QEvent::PaletteChange ||
+        event->type() == QEvent::StyleChange )
+    {
+        // the cached static layer contains the background
+        invalidateStaticLayerStore();
+    }
+
     return QFrame::event( event );
 }
 
@@ -195,21 +278,72 @@ void QwtPlotCanvas::paintEvent( QPaintEvent* event )
             }
             else
             {
+                const QwtPlot* plot = NULL;
+                if ( borderRadius() <= 0.0 && m_data->staticStore != NULL )
+                    plot = qobject_cast< const QwtPlot* >( parent() );
+
                 QPainter p;
-                if ( borderRadius() <= 0.0 )
+                if ( plot != NULL )
                 {
-                    QwtPainter::fillPixmap( this, bs );
+                    /*
+                        The static layer ( background, frame and the items
+                        below the curves ) only depends on the geometry and
+                        the scale divisions. As long as both are unchanged
+                        the cached pixmap can be copied and the per replot
+                        work is limited to rendering the curves on top.
+                     */
+                    QPixmap& ss = *m_data->staticStore;
+
+                    bool dirty = ss.size() !=
+                        size() * QwtPainter::devicePixelRatio( &ss );
+
+                    for ( int axisPos = 0;
+                        axisPos < QwtAxis::AxisPositions; axisPos++ )
+                    {
+                        const QwtScaleDiv& scaleDiv =
+                            plot->axisScaleDiv( axisPos );
+
+                        if ( !( m_data->staticScaleDivs[axisPos] == scaleDiv ) )
+                        {
+                            m_data->staticScaleDivs[axisPos] = scaleDiv;
+                            dirty = true;
+                        }
+                    }
+
+                    if ( dirty )
+                    {
+                        ss = QwtPainter::backingStore( this, size() );
+                        QwtPainter::fillPixmap( this, ss );
+
+                        QPainter sp( &ss );
+                        qwtDrawPlotItems( &sp, plot, contentsRect(), true );
+
+                        if ( frameWidth() > 0 )
+                            drawBorder( &sp );
+                    }
+
+                    bs = ss;
+
                     p.begin( &bs );
-                    drawCanvas( &p );
+                    qwtDrawPlotItems( &p, plot, contentsRect(), false );
                 }
                 else
                 {
-                    p.begin( &bs );
-                    drawUnstyled( &p );
+                    if ( borderRadius() <= 0.0 )
+                    {
+                        QwtPainter::fillPixmap( this, bs );
+                        p.begin( &bs );
+                        drawCanvas( &p );
+                    }
+                    else
+                    {
+                        p.begin( &bs );
+                        drawUnstyled( &p );
+                    }
+
+                    if ( frameWidth() > 0 )
+                        drawBorder( &p );
                 }
-
-                if ( frameWidth() > 0 )
-                    drawBorder( &p );
             }
         }
 
@@ -96,7 +96,29 @@ class QWT_EXPORT QwtPlotCanvas : public QFrame, public QwtPlotAbstractCanvas
 
            \sa replot(), QWidget::repaint(), QWidget::update()
          */
-        ImmediatePaint = 8
+        ImmediatePaint = 8,
+
+        /*!
+           \brief Cache the static layer of the plot in an additional pixmap
+
+           When enabled the background, the frame and all plot items painted
+           below the curves ( f.e the grid ) are rendered into a second
+           pixmap, that is only invalidated when the size of the canvas or
+           one of the scale divisions changes. Rebuilding the backing store
+           is then reduced to copying the cached layer and rendering the
+           curves and the items above them on top of it.
+
+           Items are assigned to the static layer by their z value: all
+           items below the default z of QwtPlotCurve ( 20.0 ) are
+           considered static.
+
+           The attribute has an effect together with BackingStore only and
+           is ignored for canvases with styled backgrounds or rounded
+           borders.
+
+           \sa invalidateStaticLayerStore()
+         */
+        StaticLayerStore = 16
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -109,6 +131,7 @@ class QWT_EXPORT QwtPlotCanvas : public QFrame, public QwtPlotAbstractCanvas
 
     const QPixmap* backingStore() const;
     Q_INVOKABLE void invalidateBackingStore();
+    Q_INVOKABLE void invalidateStaticLayerStore();
 
     virtual bool event( QEvent* ) QWT_OVERRIDE;
 
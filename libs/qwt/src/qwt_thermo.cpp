@@ -11,9 +11,11 @@
 #include "qwt_scale_draw.h"
 #include "qwt_scale_map.h"
 #include "qwt_color_map.h"
+#include "qwt_painter.h"
 #include "qwt_math.h"
 
 #include <qpainter.h>
+#include <qpixmap.h>
 #include <qevent.h>
 #include <qdrawutil.h>
 #include <qstyle.h>
@@ -112,6 +114,14 @@ class QwtThermo::PrivateData
     QwtColorMap* colorMap;
 
     double value;
+
+    /*
+        The scale and the pipe panel only change with the geometry, the
+        scale division or the style - not with the value. They are cached
+        in a pixmap, so that value updates are reduced to drawing the
+        liquid on top of it.
+     */
+    QPixmap staticCache;
 };
 
 /*!
@@ -237,25 +247,33 @@ void QwtThermo::paintEvent( QPaintEvent* event )
     QPainter painter( this );
     painter.setClipRegion( event->region() );
 
-    QStyleOption opt;
-    opt.initFrom(this);
-    style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
-
     const QRect tRect = pipeRect();
 
-    if ( !tRect.contains( event->rect() ) )
+    QPixmap& cache = m_data->staticCache;
+    if ( cache.size() != size() * QwtPainter::devicePixelRatio( &cache ) )
     {
+        cache = QwtPainter::backingStore( this, size() );
+        cache.fill( Qt::transparent );
+
+        QPainter p( &cache );
+
+        QStyleOption opt;
+        opt.initFrom(this);
+        style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
+
         if ( m_data->scalePosition != QwtThermo::NoScale )
-            scaleDraw()->draw( &painter, palette() );
-    }
+            scaleDraw()->draw( &p, palette() );
 
-    const int bw = m_data->borderWidth;
+        const int bw = m_data->borderWidth;
 
-    const QBrush brush = palette().brush( QPalette::Base );
-    qDrawShadePanel( &painter,
-        tRect.adjusted( -bw, -bw, bw, bw ),
-        palette(), true, bw,
-        m_data->autoFillPipe ? &brush : NULL );
+        const QBrush brush = palette().brush( QPalette::Base );
+        qDrawShadePanel( &p,
+            tRect.adjusted( -bw, -bw, bw, bw ),
+            palette(), true, bw,
+            m_data->autoFillPipe ? &brush : NULL );
+    }
+
+    painter.drawPixmap( 0, 0, cache );
 
     drawLiquid( &painter, tRect );
 }
@@ -284,6 +302,13 @@ void QwtThermo::changeEvent( QEvent* event )
             layoutThermo( true );
             break;
         }
+        case QEvent::PaletteChange:
+        {
+            // the cached static layer contains the scale and the panel
+            m_data->staticCache = QPixmap();
+            update();
+            break;
+        }
         default:
             break;
     }
@@ -298,6 +323,8 @@ void QwtThermo::changeEvent( QEvent* event )
  */
 void QwtThermo::layoutThermo( bool update_geometry )
 {
+    m_data->staticCache = QPixmap();
+
     const QRect tRect = pipeRect();
     const int bw = m_data->borderWidth + m_data->spacing;
     const bool inverted = ( upperBound() < lowerBound() );
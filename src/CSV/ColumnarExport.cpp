@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ColumnarExport.h"
+
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QRunnable>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QThreadPool>
+#include <QApplication>
+#include <QJsonDocument>
+#include <limits>
+
+#include <UI/Dashboard.h>
+#include <UI/HistoryStore.h>
+#include <Misc/Utilities.h>
+
+/**
+ * Returns the header of a NumPy (*.npy) file that holds @a rows elements of
+ * the given little-endian @a descr type (e.g. "<f8" for 64-bit floats). The
+ * header is padded with spaces so that the raw data starts on a 64-byte
+ * boundary, as recommended by the NPY format specification.
+ */
+static QByteArray NpyHeader(const char *descr, const qint64 rows)
+{
+    // Build the Python dictionary that describes the array
+    QByteArray dict = "{'descr': '";
+    dict += descr;
+    dict += "', 'fortran_order': False, 'shape': (";
+    dict += QByteArray::number(rows);
+    dict += ",), }";
+
+    // Pad the dictionary so that the total header size is a multiple of 64,
+    // the final character must be a newline
+    const int total = 10 + dict.size() + 1;
+    dict.append(QByteArray((64 - (total % 64)) % 64, ' '));
+    dict.append('\n');
+
+    // Assemble magic string, format version (1.0) & dictionary length
+    QByteArray header;
+    header.append("\x93NUMPY", 6);
+    header.append(char(0x01));
+    header.append(char(0x00));
+    const quint16 length = static_cast<quint16>(dict.size());
+    header.append(char(length & 0xFF));
+    header.append(char((length >> 8) & 0xFF));
+    header.append(dict);
+    return header;
+}
+
+/**
+ * Returns the file name used for the column with the given @a index and
+ * @a title, characters that are invalid on common file systems are replaced
+ * with underscores
+ */
+static QString ColumnFileName(const int index, const QString &title)
+{
+    QString name = title;
+    const QString forbidden = "\\/:*?\"<>|";
+    for (int i = 0; i < name.length(); ++i)
+        if (forbidden.contains(name.at(i)))
+            name[i] = '_';
+
+    return QString("%1 - %2.npy").arg(index, 2, 10, QChar('0')).arg(name);
+}
+
+/**
+ * @brief The NpyWriteJob class
+ *
+ * Thread-pool job that dumps one contiguous history column into a *.npy
+ * file. Since both the in-memory column & the on-disk array use the same
+ * packed little-endian layout, the data is written with a single call.
+ */
+class NpyWriteJob : public QRunnable
+{
+public:
+    NpyWriteJob(CSV::ColumnarExport *parent, const QString &path,
+                const QVector<double> &values)
+        : m_integers(false)
+        , m_path(path)
+        , m_values(values)
+        , m_parent(parent)
+    {
+    }
+
+    NpyWriteJob(CSV::ColumnarExport *parent, const QString &path,
+                const QVector<qint64> &timestamps)
+        : m_integers(true)
+        , m_path(path)
+        , m_timestamps(timestamps)
+        , m_parent(parent)
+    {
+    }
+
+    void run() override
+    {
+        // Write header & raw column data
+        bool ok = false;
+        QFile file(m_path);
+        if (file.open(QIODevice::WriteOnly))
+        {
+            if (m_integers)
+            {
+                file.write(NpyHeader("<i8", m_timestamps.count()));
+                file.write(reinterpret_cast<const char *>(
+                               m_timestamps.constData()),
+                           qint64(m_timestamps.count())
+                               * qint64(sizeof(qint64)));
+            }
+
+            else
+            {
+                file.write(NpyHeader("<f8", m_values.count()));
+                file.write(reinterpret_cast<const char *>(m_values.constData()),
+                           qint64(m_values.count()) * qint64(sizeof(double)));
+            }
+
+            ok = (file.error() == QFile::NoError);
+            file.close();
+        }
+
+        // Report the result back to the export module (on its own thread)
+        QMetaObject::invokeMethod(m_parent, "registerJobResult",
+                                  Qt::QueuedConnection, Q_ARG(bool, ok));
+    }
+
+private:
+    bool m_integers;
+    QString m_path;
+    QVector<double> m_values;
+    QVector<qint64> m_timestamps;
+    CSV::ColumnarExport *m_parent;
+};
+
+/**
+ * Constructor function
+ */
+CSV::ColumnarExport::ColumnarExport()
+    : m_busy(false)
+    , m_pendingJobs(0)
+    , m_failedJobs(0)
+{
+}
+
+/**
+ * Returns the only instance of the class
+ */
+CSV::ColumnarExport &CSV::ColumnarExport::instance()
+{
+    static ColumnarExport singleton;
+    return singleton;
+}
+
+/**
+ * Returns @c true while an export is in progress
+ */
+bool CSV::ColumnarExport::busy() const
+{
+    return m_busy;
+}
+
+/**
+ * Exports the full session history into a folder of NumPy column files. The
+ * columns are snapshot on this thread (a cheap operation thanks to the
+ * implicitly shared vectors) & written in parallel by the global thread
+ * pool, one job per column.
+ */
+void CSV::ColumnarExport::exportHistory()
+{
+    // An export is already running, do nothing
+    if (m_busy)
+        return;
+
+    // Obtain the shared timestamp column, an empty column means that no
+    // session data was recorded yet
+    auto store = &UI::HistoryStore::instance();
+    const qint64 end = std::numeric_limits<qint64>::max();
+    const auto timestamps = store->timestamps(0, end);
+    if (timestamps.isEmpty())
+    {
+        Misc::Utilities::showMessageBox(
+            tr("No session data available"),
+            tr("Connect a device or open a CSV file first"));
+        return;
+    }
+
+    // Create the output folder & write the column manifest
+    m_exportPath = exportPath();
+    if (m_exportPath.isEmpty()
+        || !writeManifest(m_exportPath, timestamps.count()))
+    {
+        Misc::Utilities::showMessageBox(
+            tr("Export error"),
+            tr("Cannot create the output folder for the session export"));
+        return;
+    }
+
+    // Update the module state
+    m_busy = true;
+    m_failedJobs = 0;
+    m_pendingJobs = store->columnCount() + 1;
+    Q_EMIT busyChanged();
+
+    // Dispatch one write job per column (plus one for the timestamps)
+    auto pool = QThreadPool::globalInstance();
+    pool->start(new NpyWriteJob(this, m_exportPath + "/timestamps.npy",
+                                timestamps));
+    const auto titles = store->columnTitles();
+    for (int i = 0; i < store->columnCount(); ++i)
+        pool->start(new NpyWriteJob(
+            this, m_exportPath + "/" + ColumnFileName(i, titles.at(i)),
+            store->samples(i, 0, end)));
+}
+
+/**
+ * Registers the result of one write job, invoked (queued) by the thread-pool
+ * workers. When the last job finishes, the output folder is revealed in the
+ * file explorer (or an error message is shown when a column failed to write).
+ */
+void CSV::ColumnarExport::registerJobResult(const bool ok)
+{
+    if (!ok)
+        ++m_failedJobs;
+
+    if (--m_pendingJobs > 0)
+        return;
+
+    m_busy = false;
+    Q_EMIT busyChanged();
+
+    if (m_failedJobs > 0)
+        Misc::Utilities::showMessageBox(
+            tr("Export error"),
+            tr("%1 column file(s) could not be written").arg(m_failedJobs));
+    else
+        Misc::Utilities::revealFile(m_exportPath);
+}
+
+/**
+ * Creates & returns the output folder of the export, the path follows the
+ * same "Documents/Serial Studio/<format>/<project>/<date>" convention as the
+ * CSV logs
+ */
+QString CSV::ColumnarExport::exportPath() const
+{
+    // Get project title, fall back to a generic name when no project is set
+    QString project = UI::Dashboard::instance().title();
+    if (project.isEmpty())
+        project = tr("Session");
+
+    // Build the output path
+    const auto dateTime = QDateTime::currentDateTime();
+    // clang-format off
+    const QString path = QString("%1/Documents/%2/NumPy/%3/%4").arg(
+        QDir::homePath(),
+        qApp->applicationName(),
+        project,
+        dateTime.toString("yyyy/MMM/dd/HH-mm-ss"));
+    // clang-format on
+
+    // Generate the folder if required
+    QDir dir(path);
+    if (!dir.exists())
+        dir.mkpath(".");
+
+    return dir.exists() ? dir.path() : QString();
+}
+
+/**
+ * Writes the "columns.json" manifest that maps every column file of the
+ * export folder to its dataset title
+ */
+bool CSV::ColumnarExport::writeManifest(const QString &path,
+                                        const int samples) const
+{
+    // Describe every column of the export
+    QJsonArray columns;
+    const auto titles = UI::HistoryStore::instance().columnTitles();
+    for (int i = 0; i < titles.count(); ++i)
+    {
+        QJsonObject column;
+        column.insert("title", titles.at(i));
+        column.insert("file", ColumnFileName(i, titles.at(i)));
+        columns.append(column);
+    }
+
+    // Build the manifest object
+    QJsonObject manifest;
+    manifest.insert("columns", columns);
+    manifest.insert("samples", samples);
+    manifest.insert("timestamps", "timestamps.npy");
+    manifest.insert("project", UI::Dashboard::instance().title());
+
+    // Write the manifest file
+    QFile file(path + "/columns.json");
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    file.write(QJsonDocument(manifest).toJson(QJsonDocument::Indented));
+    file.close();
+    return true;
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_ColumnarExport.cpp"
+#endif
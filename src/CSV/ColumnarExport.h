@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+namespace CSV
+{
+/**
+ * @brief The ColumnarExport class
+ *
+ * Exports the full session history of the @c UI::HistoryStore into a folder
+ * of column-native NumPy (*.npy) files: one file of 64-bit floats per
+ * dataset plus a shared timestamp file of 64-bit integers, described by a
+ * small "columns.json" manifest.
+ *
+ * The columns are written in parallel by the global thread pool, each worker
+ * dumps one contiguous column with a single write call, so exporting even a
+ * multi-hour session takes seconds. The generated files load directly into
+ * NumPy/pandas (@c numpy.load / @c pandas.Series) without any parsing, which
+ * makes them both much faster to ingest & much smaller than CSV.
+ */
+class ColumnarExport : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(bool busy
+               READ busy
+               NOTIFY busyChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void busyChanged();
+
+private:
+    explicit ColumnarExport();
+    ColumnarExport(ColumnarExport &&) = delete;
+    ColumnarExport(const ColumnarExport &) = delete;
+    ColumnarExport &operator=(ColumnarExport &&) = delete;
+    ColumnarExport &operator=(const ColumnarExport &) = delete;
+
+public:
+    static ColumnarExport &instance();
+
+    bool busy() const;
+
+public Q_SLOTS:
+    void exportHistory();
+
+private Q_SLOTS:
+    void registerJobResult(const bool ok);
+
+private:
+    QString exportPath() const;
+    bool writeManifest(const QString &path, const int samples) const;
+
+private:
+    bool m_busy;
+    int m_pendingJobs;
+    int m_failedJobs;
+    QString m_exportPath;
+};
+}
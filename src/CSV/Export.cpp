@@ -22,8 +22,14 @@
 
 #include <QDir>
 #include <QUrl>
+#include <QtMath>
+#include <QtEndian>
+#include <QDateTime>
 #include <QFileInfo>
+#include <QFileDialog>
+#include <QJsonObject>
 #include <QApplication>
+#include <QJsonDocument>
 #include <QDesktopServices>
 
 #include <AppInfo.h>
@@ -31,22 +37,914 @@
 #include <CSV/Export.h>
 #include <JSON/Editor.h>
 #include <UI/Dashboard.h>
+#include <Misc/Clock.h>
 #include <Misc/Utilities.h>
-#include <Misc/TimerEvents.h>
+#include <Misc/ThreadPolicy.h>
+#include <Misc/MemoryRegistry.h>
+
+#ifdef Q_OS_WIN
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+/*
+ * Size of the row formatting buffer, rows are flushed to disk in blocks of
+ * (roughly) this size
+ */
+static const int WRITE_BUFFER_SIZE = 256 * 1024;
+
+/*
+ * Segment limits of the log rotation policies, the indexes correspond to the
+ * options returned by @c CSV::Export::rotationPolicyOptions(). A value of zero
+ * disables the corresponding limit.
+ */
+struct RotationLimits
+{
+    qint64 bytes;
+    qint64 msecs;
+    qint64 frames;
+};
+static const RotationLimits ROTATION_POLICIES[] = {
+    { 0, 0, 0 },                 // No rotation
+    { 16 * 1024 * 1024, 0, 0 },  // 16 MB segments
+    { 64 * 1024 * 1024, 0, 0 },  // 64 MB segments
+    { 256 * 1024 * 1024, 0, 0 }, // 256 MB segments
+    { 0, 10 * 60 * 1000, 0 },    // 10 minute segments
+    { 0, 60 * 60 * 1000, 0 },    // 1 hour segments
+    { 0, 0, 100000 },            // 100k frame segments
+};
+
+/*
+ * Sync thresholds of the durability policies, the indexes correspond to the
+ * options returned by @c CSV::Export::durabilityPolicyOptions(). The written
+ * data is forced down to the storage device when either threshold is reached
+ * (group commit), a value of zero disables the corresponding trigger. The
+ * first entry leaves flushing entirely to the OS write-back cache.
+ */
+struct DurabilityLimits
+{
+    qint64 bytes;
+    qint64 msecs;
+};
+static const DurabilityLimits DURABILITY_POLICIES[] = {
+    { 0, 0 },                  // OS write-back cache
+    { 4 * 1024 * 1024, 5000 }, // Sync every 5 seconds / 4 MB
+    { 1024 * 1024, 1000 },     // Sync every second / 1 MB
+    { 1, 0 },                  // Sync after every write
+};
+
+/*
+ * Powers of ten that are exactly representable as 64-bit floats, used by the
+ * row formatter & the binary record encoder to convert values without going
+ * through the (locale-aware, heap-allocating) string conversion routines.
+ */
+static const double EXPORT_POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/*
+ * Writes the given @a value into @a dst as exactly @a digits zero-padded
+ * decimal characters (most significant digit first).
+ */
+static void ExportWriteDigits(char *dst, quint64 value, const int digits)
+{
+    for (int i = digits - 1; i >= 0; --i)
+    {
+        dst[i] = '0' + static_cast<char>(value % 10);
+        value /= 10;
+    }
+}
+
+/*
+ * Writes the given @a value into @a dst without padding & returns the number of
+ * characters written.
+ */
+static int ExportWriteNumber(char *dst, const quint64 value)
+{
+    int digits = 1;
+    for (quint64 v = value; v >= 10; v /= 10)
+        ++digits;
+
+    ExportWriteDigits(dst, value, digits);
+    return digits;
+}
+
+/*
+ * Formats the given @a value into @a dst (which must hold at least 40 bytes)
+ * with 15 significant digits & returns the number of characters written. The
+ * value is split into an integer & a scaled fractional part, both generated
+ * digit-by-digit into the destination buffer, so bulk conversions never
+ * allocate nor consult the locale. Values outside the fixed-notation range
+ * (which need an exponent) are delegated back to Qt.
+ */
+static int ExportFormatDouble(char *dst, const double value)
+{
+    const double magnitude = qAbs(value);
+    if (!qIsFinite(value) || magnitude >= 1e15
+        || (magnitude > 0 && magnitude < 1e-4))
+    {
+        const QByteArray text = QByteArray::number(value, 'g', 15);
+        memcpy(dst, text.constData(), text.size());
+        return text.size();
+    }
+
+    // Write the sign
+    char *p = dst;
+    if (value < 0)
+        *p++ = '-';
+
+    // Split the value into an integer & a fractional part
+    quint64 integer = static_cast<quint64>(magnitude);
+    const double fractional = magnitude - static_cast<double>(integer);
+    int intDigits = 1;
+    for (quint64 v = integer; v >= 10; v /= 10)
+        ++intDigits;
+
+    // Scale the fractional part so the cell keeps 15 significant digits, values
+    // below one get one extra fractional digit per leading zero
+    int fracDigits = (integer > 0) ? 15 - intDigits : 15;
+    if (integer == 0)
+    {
+        for (double f = fractional; f > 0 && f < 0.1 && fracDigits < 18; f *= 10)
+            ++fracDigits;
+    }
+
+    // Round the scaled fractional part & propagate the carry
+    const double scale = EXPORT_POW10[fracDigits];
+    quint64 frac = static_cast<quint64>(fractional * scale + 0.5);
+    if (frac >= static_cast<quint64>(scale))
+    {
+        frac = 0;
+        ++integer;
+    }
+
+    // Generate the digits, trailing fractional zeros are trimmed
+    p += ExportWriteNumber(p, integer);
+    if (frac > 0)
+    {
+        while (frac % 10 == 0)
+        {
+            frac /= 10;
+            --fracDigits;
+        }
+
+        *p++ = '.';
+        ExportWriteDigits(p, frac, fracDigits);
+        p += fracDigits;
+    }
+
+    return static_cast<int>(p - dst);
+}
+
+/*
+ * Locale-free replacement for QByteArray::toDouble() that parses the field in
+ * place, so the binary record encoder does not need to copy every field into a
+ * temporary array before converting it. Mantissas of up to 19 digits combined
+ * with exactly representable powers of ten are converted directly (both factors
+ * are exact, so the result is correctly rounded), anything else is delegated
+ * back to Qt.
+ */
+static double ExportParseDouble(const char *data, const char *end, bool *ok)
+{
+    const char *begin = data;
+    *ok = false;
+
+    // Parse the sign
+    bool negative = false;
+    if (data < end && (*data == '+' || *data == '-'))
+    {
+        negative = (*data == '-');
+        ++data;
+    }
+
+    // Accumulate the mantissa, digits that do not fit into 64 bits are dropped
+    // & compensated through the exponent
+    int exponent = 0;
+    bool point = false;
+    bool digits = false;
+    quint64 mantissa = 0;
+    for (; data < end; ++data)
+    {
+        const char c = *data;
+        if (c >= '0' && c <= '9')
+        {
+            digits = true;
+            if (mantissa < Q_UINT64_C(1000000000000000000))
+            {
+                mantissa = mantissa * 10 + (c - '0');
+                if (point)
+                    --exponent;
+            }
+            else if (!point)
+                ++exponent;
+        }
+        else if (c == '.' && !point)
+            point = true;
+        else
+            break;
+    }
+
+    // Reject fields without any digits
+    if (!digits)
+        return qQNaN();
+
+    // Parse the exponent
+    if (data < end && (*data == 'e' || *data == 'E'))
+    {
+        ++data;
+        bool negExponent = false;
+        if (data < end && (*data == '+' || *data == '-'))
+        {
+            negExponent = (*data == '-');
+            ++data;
+        }
+
+        if (data >= end)
+            return qQNaN();
+
+        int e = 0;
+        for (; data < end; ++data)
+        {
+            if (*data < '0' || *data > '9')
+                return qQNaN();
+            if (e < 100000)
+                e = e * 10 + (*data - '0');
+        }
+
+        exponent += negExponent ? -e : e;
+    }
+
+    // Reject fields with trailing garbage
+    if (data != end)
+        return qQNaN();
+
+    // Delegate inputs outside the exact fast path back to Qt
+    if (mantissa > (Q_UINT64_C(1) << 53) || exponent < -22 || exponent > 22)
+        return QByteArray::fromRawData(begin, static_cast<int>(end - begin))
+            .toDouble(ok);
+
+    // Scale the mantissa with an exact power of ten
+    *ok = true;
+    double value = static_cast<double>(mantissa);
+    if (exponent > 0)
+        value *= EXPORT_POW10[exponent];
+    else if (exponent < 0)
+        value /= EXPORT_POW10[-exponent];
+
+    return negative ? -value : value;
+}
+
+/*
+ * Appends the arrival @a timestamp of a frame to the given row @a buffer in the
+ * "yyyy/MM/dd/ HH:mm:ss::zzz" format used by the CSV logs. Only the seconds &
+ * milliseconds are generated per row, the date/hour/minute prefix is rebuilt
+ * through QDateTime when the minute changes (the per-minute granularity keeps
+ * the prefix correct across DST transitions, UTC offsets change on whole
+ * minutes). This removes the per-row QDateTime & QString conversions from the
+ * writer thread, the caller provides the cache variables.
+ */
+static void ExportAppendTimestamp(QByteArray &buffer, const qint64 timestamp,
+                                  qint64 &cachedMinute, QByteArray &cachedPrefix)
+{
+    // Rebuild the date/hour/minute prefix when the minute changes
+    const qint64 minute = timestamp / 60000;
+    if (minute != cachedMinute)
+    {
+        cachedMinute = minute;
+        const auto dateTime = QDateTime::fromMSecsSinceEpoch(minute * 60000);
+        cachedPrefix = dateTime.toString("yyyy/MM/dd/ HH:mm").toUtf8();
+    }
+
+    // Generate the seconds & milliseconds arithmetically
+    char suffix[8];
+    const int msecs = static_cast<int>(timestamp % 60000);
+    suffix[0] = ':';
+    ExportWriteDigits(suffix + 1, msecs / 1000, 2);
+    suffix[3] = ':';
+    suffix[4] = ':';
+    ExportWriteDigits(suffix + 5, msecs % 1000, 3);
+    buffer.append(cachedPrefix);
+    buffer.append(suffix, 8);
+}
+
+/*
+ * Computes the CRC-32 checksum of the given data block, required to generate the
+ * trailer of each gzip member written by the CSV writer.
+ */
+static quint32 gzipCrc32(const QByteArray &data)
+{
+    // Generate the lookup table on the first call
+    static quint32 table[256];
+    static bool generated = false;
+    if (!generated)
+    {
+        for (quint32 i = 0; i < 256; ++i)
+        {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+            table[i] = c;
+        }
+
+        generated = true;
+    }
+
+    // Process the data block
+    quint32 crc = 0xffffffff;
+    for (int i = 0; i < data.size(); ++i)
+        crc = table[(crc ^ static_cast<uchar>(data.at(i))) & 0xff] ^ (crc >> 8);
+
+    return crc ^ 0xffffffff;
+}
+
+//----------------------------------------------------------------------------------------
+// CSV writer (runs on a dedicated thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, frame records are read from the given @a queue, which is owned
+ * by the export module.
+ */
+CSV::ExportWriter::ExportWriter(IO::FrameQueue *queue, QObject *parent)
+    : QObject(parent)
+    , m_fieldCount(0)
+    , m_binaryFormat(false)
+    , m_compression(false)
+    , m_compressedOutput(false)
+    , m_preallocate(false)
+    , m_rotationBytes(0)
+    , m_rotationMsecs(0)
+    , m_rotationFrames(0)
+    , m_segmentFrames(0)
+    , m_segmentStartMsecs(0)
+    , m_preallocatedBytes(0)
+    , m_syncBytes(0)
+    , m_syncMsecs(0)
+    , m_unsyncedBytes(0)
+    , m_stampMinute(-1)
+    , m_queue(queue)
+{
+}
+
+/**
+ * Writes all the pending frames & closes the current CSV file, the session
+ * manifest is finalized so the next connection starts a fresh session.
+ */
+void CSV::ExportWriter::closeFile()
+{
+    // Write any frames that are still queued
+    writeQueuedData();
+
+    // Close the current segment & end the session
+    if (m_file.isOpen())
+    {
+        closeSegment();
+        Q_EMIT openChanged(false, "");
+    }
+
+    // Reset the session manifest
+    m_manifestPath.clear();
+    m_manifest = QJsonArray();
+}
+
+/**
+ * Drains the frame queue, formats every frame into the row buffer & flushes the
+ * generated rows to disk in a single write. This function is called through a queued
+ * connection whenever the export module pushes new data, the wake-up events are
+ * coalesced by the event loop so a burst costs (at most) one slot invocation per
+ * queued batch.
+ */
+void CSV::ExportWriter::writeQueuedData()
+{
+    QByteArray record;
+    while (m_queue->dequeue(record))
+        writeFrame(record);
+
+    // Flush the formatted rows to disk in one write
+    Misc::MemoryRegistry::instance().report("CSV::Export (row buffer)",
+                                            m_buffer.size());
+    flushBuffer();
+}
+
+/**
+ * Updates the project parameters used to generate the log file. The export module
+ * sends the current configuration through a queued connection before the writer
+ * creates a new file.
+ */
+void CSV::ExportWriter::configure(const QString &separator, const QString &projectTitle,
+                                  const QStringList &fieldTitles,
+                                  const bool binaryFormat, const bool compression,
+                                  const qint64 rotationBytes, const qint64 rotationMsecs,
+                                  const qint64 rotationFrames, const bool preallocate,
+                                  const qint64 syncBytes, const qint64 syncMsecs)
+{
+    m_separator = separator.toUtf8();
+    m_syncBytes = syncBytes;
+    m_syncMsecs = syncMsecs;
+    m_fieldTitles = fieldTitles;
+    m_compression = compression;
+    m_preallocate = preallocate;
+    m_binaryFormat = binaryFormat;
+    m_projectTitle = projectTitle;
+    m_rotationBytes = rotationBytes;
+    m_rotationMsecs = rotationMsecs;
+    m_rotationFrames = rotationFrames;
+    m_fieldCount = fieldTitles.count();
+}
+
+/**
+ * Flushes the row buffer to disk in a single write, the buffer is compressed on
+ * the fly when gzip compression is enabled.
+ */
+void CSV::ExportWriter::flushBuffer()
+{
+    if (!m_file.isOpen() || m_buffer.isEmpty())
+        return;
+
+    const qint64 begin = m_file.pos();
+    if (m_compressedOutput)
+        writeGzipMember(m_buffer);
+    else
+        m_file.write(m_buffer);
+
+    m_buffer.resize(0);
+
+    // Account the written block & apply the durability policy
+    m_unsyncedBytes += m_file.pos() - begin;
+    syncIfDue();
+}
+
+/**
+ * Forces the written log data down to the storage device when a threshold of
+ * the durability policy has been reached (group commit), which bounds the
+ * amount of buffered data that a power loss can discard without paying the
+ * cost of a sync on every row. The log is always written in whole blocks that
+ * end on a record boundary, so the synced part of the file can only ever lose
+ * complete trailing rows, never a torn one.
+ */
+void CSV::ExportWriter::syncIfDue()
+{
+    if ((m_syncBytes <= 0 && m_syncMsecs <= 0) || m_unsyncedBytes <= 0)
+        return;
+
+    const bool bytesDue = m_syncBytes > 0 && m_unsyncedBytes >= m_syncBytes;
+    const bool timeDue = m_syncMsecs > 0 && m_syncClock.isValid()
+        && m_syncClock.elapsed() >= m_syncMsecs;
+    if (bytesDue || timeDue)
+        syncToDisk();
+}
+
+/**
+ * Flushes the application-side buffers of the segment file & asks the OS to
+ * commit its cached pages to the storage device, then restarts the group-commit
+ * counters. fdatasync() is used where available since the durability policy does
+ * not need the file metadata (size, timestamps) to be synced on every commit.
+ */
+void CSV::ExportWriter::syncToDisk()
+{
+    if (m_file.isOpen())
+    {
+        m_file.flush();
+#if defined(Q_OS_WIN)
+        _commit(m_file.handle());
+#elif defined(Q_OS_LINUX)
+        fdatasync(m_file.handle());
+#else
+        fsync(m_file.handle());
+#endif
+    }
+
+    m_unsyncedBytes = 0;
+    m_syncClock.restart();
+}
+
+/**
+ * Compresses the given @a block & writes it to the output file as a complete gzip
+ * member. Concatenated members form a valid gzip stream, so the generated *.csv.gz
+ * file can be read by standard tooling & stays usable even if logging is
+ * interrupted before the file is closed.
+ */
+void CSV::ExportWriter::writeGzipMember(const QByteArray &block)
+{
+    // Deflate the block, qCompress() generates a zlib stream prefixed with the
+    // expected size, strip both wrappers to obtain the raw deflate data
+    const QByteArray zlib = qCompress(block);
+    if (zlib.size() <= 10)
+        return;
+
+    // Write the gzip member header
+    const uchar header[10] = { 0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0, 0, 0xff };
+    m_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+    // Write the raw deflate data
+    m_file.write(zlib.constData() + 6, zlib.size() - 10);
+
+    // Write the CRC-32 checksum & size of the uncompressed block
+    uchar trailer[8];
+    qToLittleEndian<quint32>(gzipCrc32(block), trailer);
+    qToLittleEndian<quint32>(static_cast<quint32>(block.size()), trailer + 4);
+    m_file.write(reinterpret_cast<const char *>(trailer), sizeof(trailer));
+}
+
+/**
+ * Returns @c true when any of the segment limits of the rotation policy is set
+ */
+bool CSV::ExportWriter::rotationEnabled() const
+{
+    return m_rotationBytes > 0 || m_rotationMsecs > 0 || m_rotationFrames > 0;
+}
 
 /**
- * Connect JSON Parser & Serial Manager signals to begin registering JSON
- * dataframes into JSON list.
+ * Returns @c true when the current segment has reached a limit of the rotation
+ * policy & the frame arriving at the given @a timestamp shall start a new one.
+ */
+bool CSV::ExportWriter::rotationDue(const qint64 timestamp) const
+{
+    if (!m_file.isOpen())
+        return false;
+
+    if (m_rotationBytes > 0 && m_file.pos() + m_buffer.size() >= m_rotationBytes)
+        return true;
+    if (m_rotationMsecs > 0 && timestamp - m_segmentStartMsecs >= m_rotationMsecs)
+        return true;
+    if (m_rotationFrames > 0 && m_segmentFrames >= m_rotationFrames)
+        return true;
+
+    return false;
+}
+
+/**
+ * Initializes the per-segment counters for the segment starting at the given
+ * @a timestamp & preallocates the segment file when requested. Preallocation
+ * is only meaningful for size-based rotation: the file is grown to the full
+ * segment size up front (so the filesystem can reserve contiguous space) &
+ * truncated back to the written size when the segment is closed.
+ */
+void CSV::ExportWriter::beginSegment(const qint64 timestamp)
+{
+    m_segmentFrames = 0;
+    m_unsyncedBytes = 0;
+    m_preallocatedBytes = 0;
+    m_segmentStartMsecs = timestamp;
+    m_syncClock.restart();
+
+    if (m_preallocate && m_rotationBytes > 0)
+    {
+        if (m_file.resize(m_rotationBytes) && m_file.seek(0))
+            m_preallocatedBytes = m_rotationBytes;
+    }
+
+    // Derive the session manifest path from the first segment of the session
+    if (rotationEnabled() && m_manifestPath.isEmpty())
+    {
+        QFileInfo info(m_file.fileName());
+        m_manifestPath = info.path() + "/" + info.completeBaseName() + ".session.json";
+    }
+}
+
+/**
+ * Flushes the pending rows, truncates the preallocated space (if any) & closes
+ * the current segment file. The segment is appended to the session manifest,
+ * which is rewritten so that it stays complete even if logging is interrupted.
+ */
+void CSV::ExportWriter::closeSegment()
+{
+    if (!m_file.isOpen())
+        return;
+
+    // Flush the pending rows & release the unused preallocated space
+    flushBuffer();
+    if (m_preallocatedBytes > m_file.pos())
+        m_file.resize(m_file.pos());
+
+    // Commit the remaining data to the storage device before the file is closed
+    if ((m_syncBytes > 0 || m_syncMsecs > 0) && m_unsyncedBytes > 0)
+        syncToDisk();
+
+    // Append the segment to the session manifest
+    if (rotationEnabled())
+    {
+        QFileInfo info(m_file.fileName());
+        QJsonObject segment;
+        segment.insert("file", info.fileName());
+        segment.insert("start", m_segmentStartMsecs);
+        segment.insert("frames", m_segmentFrames);
+        segment.insert("bytes", m_file.pos());
+        m_manifest.append(segment);
+        writeManifest();
+    }
+
+    m_file.close();
+}
+
+/**
+ * Writes the session manifest, a *.session.json sidecar file listing every
+ * segment of the session with its first-frame timestamp, frame count & size.
+ * Analysis tools can use it to locate a time range without opening (or even
+ * listing) all the segment files.
+ */
+void CSV::ExportWriter::writeManifest()
+{
+    if (m_manifestPath.isEmpty())
+        return;
+
+    QJsonObject manifest;
+    manifest.insert("project", m_projectTitle);
+    manifest.insert("segments", m_manifest);
+
+    QFile file(m_manifestPath);
+    if (file.open(QIODevice::WriteOnly))
+    {
+        file.write(QJsonDocument(manifest).toJson(QJsonDocument::Indented));
+        file.close();
+    }
+}
+
+/**
+ * Generates the output file path for the current project title, the file name is
+ * derived from the arrival @a timestamp of the first frame & the given @a extension.
+ */
+QString CSV::ExportWriter::logFilePath(const qint64 timestamp, const QString &extension)
+{
+    // Get frame arrival date/time
+    const auto dateTime = QDateTime::fromMSecsSinceEpoch(timestamp);
+
+    // Get file name
+    const QString fileName = dateTime.toString("HH-mm-ss") + extension;
+
+    // Get path
+    // clang-format off
+    const QString format = dateTime.toString("yyyy/MMM/dd/");
+    const QString path = QString("%1/Documents/%2/CSV/%3/%4").arg(QDir::homePath(),
+                                                                  qApp->applicationName(),
+                                                                  m_projectTitle, format);
+    // clang-format on
+
+    // Generate file path if required
+    QDir dir(path);
+    if (!dir.exists())
+        dir.mkpath(".");
+
+    // Avoid overwriting a previous segment when rotation produces more than one
+    // file within the same second
+    QString filePath = dir.filePath(fileName);
+    for (int i = 2; QFile::exists(filePath); ++i)
+        filePath = dir.filePath(dateTime.toString("HH-mm-ss") + QString("-%1").arg(i)
+                                + extension);
+
+    return filePath;
+}
+
+/**
+ * Creates a new CSV file corresponding to the current project title & field count,
+ * the file name is derived from the arrival @a timestamp of the first frame.
+ */
+bool CSV::ExportWriter::createCsvFile(const qint64 timestamp)
+{
+    // Open file, compressed logs are written without text-mode translation
+    m_compressedOutput = m_compression;
+    m_file.setFileName(logFilePath(timestamp, m_compressedOutput ? ".csv.gz" : ".csv"));
+    const auto mode = m_compressedOutput
+        ? QIODevice::OpenMode(QIODevice::WriteOnly)
+        : QIODevice::OpenMode(QIODevice::WriteOnly | QIODevice::Text);
+    if (!m_file.open(mode))
+    {
+        Q_EMIT openFailed();
+        return false;
+    }
+
+    // Initialize the rotation counters & preallocate the segment
+    beginSegment(timestamp);
+
+    // Add UTF-8 byte order mark & cell titles
+    m_buffer.clear();
+    m_buffer.reserve(WRITE_BUFFER_SIZE);
+    m_buffer.append("\xef\xbb\xbf");
+    m_buffer.append("RX Date/Time,");
+    for (int i = 0; i < m_fieldCount; ++i)
+    {
+        m_buffer.append("Field ");
+        m_buffer.append(QByteArray::number(i + 1));
+
+        if (i < m_fieldCount - 1)
+            m_buffer.append(',');
+        else
+            m_buffer.append('\n');
+    }
+
+    // Update UI
+    Q_EMIT openChanged(true, m_file.fileName());
+    return true;
+}
+
+/**
+ * Creates a new binary log file & writes the schema header, which contains the format
+ * version, the column count & the column titles derived from the JSON project map.
+ */
+bool CSV::ExportWriter::createBinaryFile(const qint64 timestamp)
+{
+    // Open file
+    m_compressedOutput = false;
+    m_file.setFileName(logFilePath(timestamp, ".bin"));
+    if (!m_file.open(QIODevice::WriteOnly))
+    {
+        Q_EMIT openFailed();
+        return false;
+    }
+
+    // Initialize the rotation counters & preallocate the segment
+    beginSegment(timestamp);
+
+    // Write magic bytes, format version & column count
+    uchar scratch[8];
+    m_buffer.clear();
+    m_buffer.reserve(WRITE_BUFFER_SIZE);
+    m_buffer.append("SSBL", 4);
+    qToLittleEndian<quint16>(1, scratch);
+    m_buffer.append(reinterpret_cast<char *>(scratch), 2);
+    qToLittleEndian<quint16>(0, scratch);
+    m_buffer.append(reinterpret_cast<char *>(scratch), 2);
+    qToLittleEndian<quint32>(m_fieldCount, scratch);
+    m_buffer.append(reinterpret_cast<char *>(scratch), 4);
+
+    // Write column titles (16-bit length + UTF-8 bytes each)
+    for (int i = 0; i < m_fieldCount; ++i)
+    {
+        const QByteArray title = m_fieldTitles.at(i).toUtf8();
+        qToLittleEndian<quint16>(title.size(), scratch);
+        m_buffer.append(reinterpret_cast<char *>(scratch), 2);
+        m_buffer.append(title);
+    }
+
+    // Update UI
+    Q_EMIT openChanged(true, m_file.fileName());
+    return true;
+}
+
+/**
+ * Formats the given frame @a record into a CSV row & appends it to the row buffer.
+ * The separator sequence of the frame is replaced with commas, no intermediate
+ * string lists are generated.
+ */
+void CSV::ExportWriter::writeFrame(const QByteArray &record)
+{
+    // Decode the arrival timestamp of the frame
+    if (record.size() < 8)
+        return;
+    const auto timestamp = qFromLittleEndian<quint64>(
+        reinterpret_cast<const uchar *>(record.constData()));
+
+    // Segment limit reached, close it so this frame starts the next segment
+    if (rotationDue(timestamp))
+        closeSegment();
+
+    // Fixed-width binary records are generated by a separate function
+    if (m_binaryFormat)
+    {
+        writeBinaryRecord(timestamp, record);
+        return;
+    }
+
+    // File not open, create it & add cell titles
+    if (!m_file.isOpen() && !createCsvFile(timestamp))
+        return;
+
+    // Write RX date/time
+    ExportAppendTimestamp(m_buffer, timestamp, m_stampMinute, m_stampPrefix);
+    m_buffer.append(',');
+
+    // Write frame data, the separator sequence is replaced with commas
+    int fields = 1;
+    int begin = 8;
+    const QByteArray &separator = m_separator;
+    while (begin <= record.size() && !separator.isEmpty())
+    {
+        int end = record.indexOf(separator, begin);
+        if (end == -1)
+            end = record.size();
+
+        m_buffer.append(record.constData() + begin, end - begin);
+        if (end < record.size())
+        {
+            ++fields;
+            m_buffer.append(',');
+        }
+
+        begin = end + separator.size();
+    }
+
+    // Pad the row when the frame contains less fields than the CSV table
+    const int d = m_fieldCount - fields;
+    if (d > 0)
+    {
+        for (int k = 0; k < d - 1; ++k)
+            m_buffer.append(',');
+    }
+
+    // Terminate the row & flush the buffer when it grows too large
+    m_buffer.append('\n');
+    ++m_segmentFrames;
+    if (m_buffer.size() >= WRITE_BUFFER_SIZE)
+        flushBuffer();
+}
+
+/**
+ * Encodes the given frame @a record as a fixed-width binary record & appends it to
+ * the write buffer. Each record holds the arrival @a timestamp followed by one 64-bit
+ * float per column, fields that are missing or not numeric are stored as NaN.
+ */
+void CSV::ExportWriter::writeBinaryRecord(const qint64 timestamp,
+                                          const QByteArray &record)
+{
+    // File not open, create it & write the schema header
+    if (!m_file.isOpen() && !createBinaryFile(timestamp))
+        return;
+
+    // Write the arrival timestamp
+    uchar scratch[8];
+    qToLittleEndian<quint64>(timestamp, scratch);
+    m_buffer.append(reinterpret_cast<char *>(scratch), 8);
+
+    // Write one 64-bit float per column, extra fields are dropped
+    int field = 0;
+    int begin = 8;
+    const QByteArray &separator = m_separator;
+    while (field < m_fieldCount)
+    {
+        // Decode the next frame field (NaN when missing or not numeric)
+        double value = qQNaN();
+        if (begin <= record.size() && !separator.isEmpty())
+        {
+            int end = record.indexOf(separator, begin);
+            if (end == -1)
+                end = record.size();
+
+            bool ok = false;
+            const double number = ExportParseDouble(record.constData() + begin,
+                                                    record.constData() + end, &ok);
+            if (ok)
+                value = number;
+
+            begin = end + separator.size();
+        }
+
+        // Append the encoded value to the write buffer
+        quint64 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        qToLittleEndian<quint64>(bits, scratch);
+        m_buffer.append(reinterpret_cast<char *>(scratch), 8);
+        ++field;
+    }
+
+    // Flush the buffer when it grows too large
+    ++m_segmentFrames;
+    if (m_buffer.size() >= WRITE_BUFFER_SIZE)
+        flushBuffer();
+}
+
+//----------------------------------------------------------------------------------------
+// Export module (runs on the GUI thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, starts the writer thread & connects the export module to the
+ * I/O manager.
  */
 CSV::Export::Export()
-    : m_fieldCount(0)
+    : m_isOpen(false)
+    , m_binaryFormat(false)
+    , m_compression(false)
     , m_exportEnabled(true)
+    , m_segmentPreallocation(false)
+    , m_rotationPolicy(0)
+    , m_durabilityPolicy(0)
+    , m_frameQueue(8192)
+    , m_writer(Q_NULLPTR)
 {
+    // Move the CSV writer to a dedicated thread, row formatting & disk I/O must
+    // never block the user interface
+    m_writer = new ExportWriter(&m_frameQueue);
+    m_writer->moveToThread(&m_writerThread);
+    // clang-format off
+    connect(&m_writerThread, &QThread::finished, m_writer, &QObject::deleteLater);
+    connect(this, &CSV::Export::frameQueued,
+            m_writer, &CSV::ExportWriter::writeQueuedData, Qt::QueuedConnection);
+    connect(m_writer, &CSV::ExportWriter::openChanged,
+            this, &CSV::Export::onWriterOpenChanged, Qt::QueuedConnection);
+    connect(m_writer, &CSV::ExportWriter::openFailed,
+            this, &CSV::Export::onWriterOpenFailed, Qt::QueuedConnection);
+    // clang-format on
+    Misc::ThreadPolicy::instance().startThread(m_writerThread, m_writer, "export",
+                                               QThread::LowPriority);
+
+    // Configure signals/slots
     auto io = &IO::Manager::instance();
-    auto te = &Misc::TimerEvents::instance();
     connect(io, &IO::Manager::connectedChanged, this, &Export::closeFile);
     connect(io, &IO::Manager::frameReceived, this, &Export::registerFrame);
-    connect(te, &Misc::TimerEvents::timeout1Hz, this, &Export::writeValues);
+    connect(io, &IO::Manager::separatorSequenceChanged, this,
+            &Export::updateWriterConfig);
 }
 
 /**
@@ -55,6 +953,8 @@ CSV::Export::Export()
 CSV::Export::~Export()
 {
     closeFile();
+    m_writerThread.quit();
+    m_writerThread.wait();
 }
 
 /**
@@ -71,7 +971,24 @@ CSV::Export &CSV::Export::instance()
  */
 bool CSV::Export::isOpen() const
 {
-    return m_csvFile.isOpen();
+    return m_isOpen;
+}
+
+/**
+ * Returns @c true if the generated CSV files shall be compressed with gzip
+ */
+bool CSV::Export::compression() const
+{
+    return m_compression;
+}
+
+/**
+ * Returns @c true if the received frames shall be logged in the compact binary
+ * format instead of CSV
+ */
+bool CSV::Export::binaryFormat() const
+{
+    return m_binaryFormat;
 }
 
 /**
@@ -82,167 +999,343 @@ bool CSV::Export::exportEnabled() const
     return m_exportEnabled;
 }
 
+/**
+ * Returns the index of the current log rotation policy, which corresponds to
+ * the options returned by @c rotationPolicyOptions()
+ */
+int CSV::Export::rotationPolicy() const
+{
+    return m_rotationPolicy;
+}
+
+/**
+ * Returns the index of the current log durability policy, which corresponds to
+ * the options returned by @c durabilityPolicyOptions()
+ */
+int CSV::Export::durabilityPolicy() const
+{
+    return m_durabilityPolicy;
+}
+
+/**
+ * Returns @c true if segment files shall be preallocated to their full size
+ * when size-based rotation is active
+ */
+bool CSV::Export::segmentPreallocation() const
+{
+    return m_segmentPreallocation;
+}
+
+/**
+ * Returns a list with the available log rotation policies
+ */
+StringList CSV::Export::rotationPolicyOptions() const
+{
+    // clang-format off
+    return StringList { tr("No rotation"),
+                        tr("16 MB segments"),
+                        tr("64 MB segments"),
+                        tr("256 MB segments"),
+                        tr("10 minute segments"),
+                        tr("1 hour segments"),
+                        tr("100k frame segments") };
+    // clang-format on
+}
+
+/**
+ * Returns a list with the available log durability policies
+ */
+StringList CSV::Export::durabilityPolicyOptions() const
+{
+    // clang-format off
+    return StringList { tr("OS write-back cache"),
+                        tr("Sync every 5 seconds / 4 MB"),
+                        tr("Sync every second / 1 MB"),
+                        tr("Sync after every write") };
+    // clang-format on
+}
+
 /**
  * Open the current CSV file in the Explorer/Finder window
  */
 void CSV::Export::openCurrentCsv()
 {
     if (isOpen())
-        Misc::Utilities::revealFile(m_csvFile.fileName());
+        Misc::Utilities::revealFile(m_csvPath);
     else
         Misc::Utilities::showMessageBox(tr("CSV file not open"),
                                         tr("Cannot find CSV export file!"));
 }
 
 /**
- * Enables or disables data export
+ * Lets the user select a binary log file & converts it to a CSV file (generated in
+ * the same folder), so that binary logs can be analyzed with standard tooling.
  */
-void CSV::Export::setExportEnabled(const bool enabled)
+void CSV::Export::convertBinaryLog()
 {
-    m_exportEnabled = enabled;
-    Q_EMIT enabledChanged();
+    // Let the user select a binary log file
+    // clang-format off
+    auto file = QFileDialog::getOpenFileName(
+                Q_NULLPTR,
+                tr("Select binary log file"),
+                QString("%1/Documents/%2/CSV").arg(QDir::homePath(),
+                                                   qApp->applicationName()),
+                tr("Binary log files") + " (*.bin)");
+    // clang-format on
+    if (file.isEmpty())
+        return;
 
-    if (!exportEnabled() && isOpen())
+    // Open the binary log
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly))
     {
-        m_frames.clear();
-        closeFile();
+        Misc::Utilities::showMessageBox(tr("CSV File Error"),
+                                        tr("Cannot open the selected log file!"));
+        return;
     }
-}
 
-/**
- * Write all remaining JSON frames & close the CSV file
- */
-void CSV::Export::closeFile()
-{
-    if (isOpen())
+    // Validate the magic bytes & the format version
+    const QByteArray header = input.read(12);
+    const uchar *headerData = reinterpret_cast<const uchar *>(header.constData());
+    if (header.size() != 12 || !header.startsWith("SSBL")
+        || qFromLittleEndian<quint16>(headerData + 4) != 1)
     {
-        while (!m_frames.isEmpty())
-            writeValues();
+        Misc::Utilities::showMessageBox(
+            tr("CSV File Error"), tr("The selected file is not a valid binary log!"));
+        return;
+    }
 
-        m_fieldCount = 0;
-        m_csvFile.close();
-        m_textStream.setDevice(Q_NULLPTR);
+    // Read the column titles from the schema header
+    QStringList titles;
+    const int columns = qFromLittleEndian<quint32>(headerData + 8);
+    for (int i = 0; i < columns; ++i)
+    {
+        const QByteArray length = input.read(2);
+        if (length.size() != 2)
+            break;
 
-        Q_EMIT openChanged();
+        const int size
+            = qFromLittleEndian<quint16>(reinterpret_cast<const uchar *>(length.constData()));
+        titles.append(QString::fromUtf8(input.read(size)));
     }
-}
 
-/**
- * Creates a CSV file based on the JSON frames contained in the JSON list.
- * @note This function is called periodically every 1 second.
- */
-void CSV::Export::writeValues()
-{
-    // Get separator sequence
-    auto sep = IO::Manager::instance().separatorSequence();
+    // Schema header truncated, abort conversion
+    if (titles.count() != columns)
+    {
+        Misc::Utilities::showMessageBox(
+            tr("CSV File Error"), tr("The selected file is not a valid binary log!"));
+        return;
+    }
 
-    // Write each frame
-    for (auto i = 0; i < m_frames.count(); ++i)
+    // Create the output CSV file next to the binary log
+    QFileInfo info(file);
+    QFile output(info.path() + "/" + info.completeBaseName() + ".csv");
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Text))
     {
-        auto frame = m_frames.at(i);
-        auto fields = QString::fromUtf8(frame.data).split(sep);
+        Misc::Utilities::showMessageBox(tr("CSV File Error"),
+                                        tr("Cannot open CSV file for writing!"));
+        return;
+    }
 
-        // File not open, create it & add cell titles
-        if (!isOpen() && exportEnabled())
-            createCsvFile(frame);
+    // Write UTF-8 byte order mark & cell titles
+    QByteArray buffer;
+    buffer.reserve(WRITE_BUFFER_SIZE);
+    buffer.append("\xef\xbb\xbf");
+    buffer.append("RX Date/Time");
+    for (int i = 0; i < columns; ++i)
+    {
+        buffer.append(',');
+        buffer.append(titles.at(i).toUtf8());
+    }
+    buffer.append('\n');
 
+    // Decode every record & write the CSV rows in large blocks
+    QByteArray record;
+    qint64 stampMinute = -1;
+    QByteArray stampPrefix;
+    const int recordSize = 8 + 8 * columns;
+    while ((record = input.read(recordSize)).size() == recordSize)
+    {
         // Write RX date/time
-        m_textStream << frame.rxDateTime.toString("yyyy/MM/dd/ HH:mm:ss::zzz") << ",";
+        const uchar *data = reinterpret_cast<const uchar *>(record.constData());
+        const auto timestamp = static_cast<qint64>(qFromLittleEndian<quint64>(data));
+        ExportAppendTimestamp(buffer, timestamp, stampMinute, stampPrefix);
 
-        // Write frame data
-        for (auto j = 0; j < fields.count(); ++j)
+        // Write column values, NaN values are written as empty cells
+        for (int i = 0; i < columns; ++i)
         {
-            m_textStream << fields.at(j);
-            if (j < fields.count() - 1)
-                m_textStream << ",";
+            buffer.append(',');
 
-            else
-            {
-                auto d = m_fieldCount - fields.count();
-                if (d > 0)
-                {
-                    for (auto k = 0; k < d - 1; ++k)
-                        m_textStream << ",";
-                }
-
-                m_textStream << "\n";
-            }
+            double value;
+            char cell[40];
+            const quint64 bits = qFromLittleEndian<quint64>(data + 8 + 8 * i);
+            memcpy(&value, &bits, sizeof(value));
+            if (!qIsNaN(value))
+                buffer.append(cell, ExportFormatDouble(cell, value));
+        }
+
+        // Terminate the row & flush the buffer when it grows too large
+        buffer.append('\n');
+        if (buffer.size() >= WRITE_BUFFER_SIZE)
+        {
+            output.write(buffer);
+            buffer.resize(0);
         }
     }
 
-    // Clear frames
-    m_frames.clear();
+    // Flush the remaining rows & reveal the generated file
+    output.write(buffer);
+    output.close();
+    Misc::Utilities::revealFile(output.fileName());
 }
 
 /**
- * Creates a new CSV file corresponding to the current project title & field count
+ * Enables or disables binary logging, the current log file (if any) is closed so
+ * that the next received frame starts a fresh file in the selected format.
  */
-void CSV::Export::createCsvFile(const CSV::RawFrame &frame)
-{ // Get project title
-    auto projectTitle = UI::Dashboard::instance().title();
+void CSV::Export::setBinaryFormat(const bool binary)
+{
+    if (m_binaryFormat != binary)
+    {
+        m_binaryFormat = binary;
+        Q_EMIT formatChanged();
 
-    // Get file name
-    const QString fileName = frame.rxDateTime.toString("HH-mm-ss") + ".csv";
+        closeFile();
+        updateWriterConfig();
+    }
+}
 
-    // Get path
-    // clang-format off
-    const QString format = frame.rxDateTime.toString("yyyy/MMM/dd/");
-    const QString path = QString("%1/Documents/%2/CSV/%3/%4").arg(QDir::homePath(),
-                                                                  qApp->applicationName(),
-                                                                  projectTitle, format);
-    // clang-format on
+/**
+ * Enables or disables on-the-fly gzip compression of the generated CSV files, the
+ * current log file (if any) is closed so that the next received frame starts a
+ * fresh file with the selected option.
+ */
+void CSV::Export::setCompression(const bool compression)
+{
+    if (m_compression != compression)
+    {
+        m_compression = compression;
+        Q_EMIT compressionChanged();
 
-    // Generate file path if required
-    QDir dir(path);
-    if (!dir.exists())
-        dir.mkpath(".");
+        closeFile();
+        updateWriterConfig();
+    }
+}
 
-    // Open file
-    m_csvFile.setFileName(dir.filePath(fileName));
-    if (!m_csvFile.open(QIODevice::WriteOnly | QIODevice::Text))
+/**
+ * Changes the log rotation policy, the current log file (if any) is closed so
+ * that the next received frame starts a fresh session with the new policy.
+ */
+void CSV::Export::setRotationPolicy(const int policy)
+{
+    const int count = sizeof(ROTATION_POLICIES) / sizeof(ROTATION_POLICIES[0]);
+    if (m_rotationPolicy != policy && policy >= 0 && policy < count)
     {
-        Misc::Utilities::showMessageBox(tr("CSV File Error"),
-                                        tr("Cannot open CSV file for writing!"));
+        m_rotationPolicy = policy;
+        Q_EMIT rotationPolicyChanged();
+
         closeFile();
-        return;
+        updateWriterConfig();
     }
+}
 
-    // Add cell titles & force UTF-8 codec
-    m_textStream.setDevice(&m_csvFile);
-    m_textStream.setGenerateByteOrderMark(true);
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    m_textStream.setCodec("UTF-8");
-#else
-    m_textStream.setEncoding(QStringConverter::Utf8);
-#endif
-
-    // Get number of fields by counting datasets with non-duplicated indexes
-    QVector<int> fields;
-    for (int i = 0; i < JSON::Editor::instance().groupCount(); ++i)
+/**
+ * Changes the log durability policy, the current log file (if any) is closed so
+ * that the next received frame starts a fresh file with the new sync behavior.
+ */
+void CSV::Export::setDurabilityPolicy(const int policy)
+{
+    const int count = sizeof(DURABILITY_POLICIES) / sizeof(DURABILITY_POLICIES[0]);
+    if (m_durabilityPolicy != policy && policy >= 0 && policy < count)
     {
-        for (int j = 0; j < JSON::Editor::instance().datasetCount(i); ++j)
-        {
-            auto dataset = JSON::Editor::instance().getDataset(i, j);
-            if (!fields.contains(dataset.index()))
-                fields.append(dataset.index());
-        }
+        m_durabilityPolicy = policy;
+        Q_EMIT durabilityPolicyChanged();
+
+        closeFile();
+        updateWriterConfig();
     }
+}
 
-    // Add table titles
-    m_fieldCount = fields.count();
-    m_textStream << "RX Date/Time,";
-    for (auto i = 0; i < m_fieldCount; ++i)
+/**
+ * Enables or disables preallocation of the segment files, the current log file
+ * (if any) is closed so that the next received frame starts a fresh session
+ * with the selected option.
+ */
+void CSV::Export::setSegmentPreallocation(const bool preallocate)
+{
+    if (m_segmentPreallocation != preallocate)
     {
-        m_textStream << "Field " << i + 1;
+        m_segmentPreallocation = preallocate;
+        Q_EMIT preallocationChanged();
 
-        if (i < m_fieldCount - 1)
-            m_textStream << ",";
-        else
-            m_textStream << "\n";
+        closeFile();
+        updateWriterConfig();
     }
+}
 
-    // Update UI
-    Q_EMIT openChanged();
+/**
+ * Enables or disables data export
+ */
+void CSV::Export::setExportEnabled(const bool enabled)
+{
+    m_exportEnabled = enabled;
+    Q_EMIT enabledChanged();
+
+    if (!exportEnabled() && isOpen())
+    {
+        m_frameQueue.clear();
+        closeFile();
+    }
+}
+
+/**
+ * Write all remaining JSON frames & close the CSV file. The writer is invoked through
+ * a blocking queued connection, so the CSV file is guaranteed to be complete when this
+ * function returns.
+ */
+void CSV::Export::closeFile()
+{
+    QMetaObject::invokeMethod(m_writer, "closeFile", Qt::BlockingQueuedConnection);
+}
+
+/**
+ * Sends the current separator sequence, project title & field count to the writer
+ * thread, the writer uses them to generate the CSV table.
+ */
+void CSV::Export::updateWriterConfig()
+{
+    // Get column titles, the editor de-duplicates datasets by frame index
+    QStringList titles;
+    const auto datasets = JSON::Editor::instance().uniqueDatasets();
+    for (int i = 0; i < datasets.count(); ++i)
+        titles.append(datasets.at(i)->title());
+
+    // Send the configuration to the writer thread
+    // clang-format off
+    const auto &limits = ROTATION_POLICIES[m_rotationPolicy];
+    const auto &syncLimits = DURABILITY_POLICIES[m_durabilityPolicy];
+    QMetaObject::invokeMethod(m_writer, "configure", Qt::QueuedConnection,
+                              Q_ARG(QString, IO::Manager::instance().separatorSequence()),
+                              Q_ARG(QString, UI::Dashboard::instance().title()),
+                              Q_ARG(QStringList, titles),
+                              Q_ARG(bool, m_binaryFormat),
+                              Q_ARG(bool, m_compression),
+                              Q_ARG(qint64, limits.bytes),
+                              Q_ARG(qint64, limits.msecs),
+                              Q_ARG(qint64, limits.frames),
+                              Q_ARG(bool, m_segmentPreallocation),
+                              Q_ARG(qint64, syncLimits.bytes),
+                              Q_ARG(qint64, syncLimits.msecs));
+    // clang-format on
+}
+
+/**
+ * Notifies the user when the writer thread cannot open the CSV file
+ */
+void CSV::Export::onWriterOpenFailed()
+{
+    Misc::Utilities::showMessageBox(tr("CSV File Error"),
+                                    tr("Cannot open CSV file for writing!"));
 }
 
 /**
@@ -263,11 +1356,33 @@ void CSV::Export::registerFrame(const QByteArray &data)
     if (!exportEnabled())
         return;
 
-    // Register raw frame to list
-    RawFrame frame;
-    frame.data = data;
-    frame.rxDateTime = QDateTime::currentDateTime();
-    m_frames.append(frame);
+    // Send the current project configuration to the writer thread before it
+    // creates the CSV file
+    if (!isOpen())
+        updateWriterConfig();
+
+    // Serialize the arrival timestamp & queue the frame for the writer thread
+    QByteArray record;
+    record.resize(8);
+    const quint64 timestamp = Misc::Clock::instance().currentMSecsSinceEpoch();
+    qToLittleEndian<quint64>(timestamp, reinterpret_cast<uchar *>(record.data()));
+    record.append(data);
+    m_frameQueue.enqueue(record);
+    Q_EMIT frameQueued();
+}
+
+/**
+ * Synchronizes the open-state & file path reported by the writer thread with the
+ * user interface.
+ */
+void CSV::Export::onWriterOpenChanged(const bool open, const QString &fileName)
+{
+    if (m_isOpen != open)
+    {
+        m_isOpen = open;
+        m_csvPath = fileName;
+        Q_EMIT openChanged();
+    }
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
@@ -23,32 +23,135 @@
 #pragma once
 
 #include <QFile>
-#include <QVector>
 #include <QObject>
-#include <QVariant>
-#include <QDateTime>
-#include <QTextStream>
-#include <QJsonObject>
+#include <QThread>
+#include <QString>
+#include <QJsonArray>
+#include <QByteArray>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include <DataTypes.h>
+#include <IO/FrameQueue.h>
 
 namespace CSV
 {
+/**
+ * @brief The ExportWriter class
+ *
+ * Worker object that formats the queued frames into log records & writes them
+ * to disk from a dedicated writer thread. Records are formatted into a
+ * reusable preallocated buffer & flushed to the output file in large blocks,
+ * so neither formatting nor disk latency can ever stall the user interface.
+ *
+ * Each queued record consists of a 64-bit little-endian arrival timestamp
+ * (msecs since the Unix epoch) followed by the raw frame bytes.
+ *
+ * Two output formats are supported:
+ * - CSV: one text row per frame, fields separated by commas.
+ * - Binary: a compact fixed-width format, the file starts with a "SSBL"
+ *   schema header (version, column count & column titles derived from the
+ *   JSON project map), each record holds the arrival timestamp as a 64-bit
+ *   integer followed by one 64-bit float per column (NaN when a field is
+ *   missing or not numeric). All values are little-endian. Binary logs can
+ *   be converted to CSV with @c CSV::Export::convertBinaryLog().
+ *
+ * CSV output can optionally be compressed on the fly, each flushed block is
+ * written as a complete gzip member so the generated *.csv.gz file can be read
+ * by standard tooling & remains valid even if logging is interrupted.
+ *
+ * The output can be rotated into bounded segments (by size, duration or frame
+ * count), so long soak tests produce a series of manageable files instead of
+ * one huge log. When rotation by size is active, segment files can optionally
+ * be preallocated to their full size on creation & truncated on close, which
+ * keeps them contiguous on filesystems that honor the hint. A *.session.json
+ * manifest listing the segments of the session is written next to them.
+ *
+ * An optional durability policy bounds the amount of log data that a power loss
+ * can discard: the written blocks are forced down to the storage device (with
+ * fdatasync() or its platform equivalent) every N seconds or M bytes, whichever
+ * comes first (group commit). Since blocks always end on a record boundary, the
+ * synced part of the log can only ever lose complete trailing rows, never a
+ * torn one.
+ */
+class ExportWriter : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void openFailed();
+    void openChanged(const bool open, const QString &fileName);
+
+public:
+    explicit ExportWriter(IO::FrameQueue *queue, QObject *parent = Q_NULLPTR);
+
+public Q_SLOTS:
+    void closeFile();
+    void writeQueuedData();
+    void configure(const QString &separator, const QString &projectTitle,
+                   const QStringList &fieldTitles, const bool binaryFormat,
+                   const bool compression, const qint64 rotationBytes,
+                   const qint64 rotationMsecs, const qint64 rotationFrames,
+                   const bool preallocate, const qint64 syncBytes,
+                   const qint64 syncMsecs);
+
+private:
+    void syncIfDue();
+    void syncToDisk();
+    void flushBuffer();
+    void closeSegment();
+    void writeManifest();
+    bool rotationEnabled() const;
+    bool rotationDue(const qint64 timestamp) const;
+    void beginSegment(const qint64 timestamp);
+    bool createCsvFile(const qint64 timestamp);
+    bool createBinaryFile(const qint64 timestamp);
+    void writeFrame(const QByteArray &record);
+    void writeGzipMember(const QByteArray &block);
+    void writeBinaryRecord(const qint64 timestamp, const QByteArray &record);
+    QString logFilePath(const qint64 timestamp, const QString &extension);
+
+private:
+    QFile m_file;
+    int m_fieldCount;
+    bool m_binaryFormat;
+    bool m_compression;
+    bool m_compressedOutput;
+    bool m_preallocate;
+    qint64 m_rotationBytes;
+    qint64 m_rotationMsecs;
+    qint64 m_rotationFrames;
+    qint64 m_segmentFrames;
+    qint64 m_segmentStartMsecs;
+    qint64 m_preallocatedBytes;
+    qint64 m_syncBytes;
+    qint64 m_syncMsecs;
+    qint64 m_unsyncedBytes;
+    QElapsedTimer m_syncClock;
+    QString m_manifestPath;
+    QJsonArray m_manifest;
+    QByteArray m_separator;
+    QString m_projectTitle;
+    QStringList m_fieldTitles;
+    QByteArray m_buffer;
+    qint64 m_stampMinute;
+    QByteArray m_stampPrefix;
+    IO::FrameQueue *m_queue;
+};
+
 /**
  * @brief The Export class
  *
  * The CSV export class receives data from the @c IO::Manager class and
  * exports the received frames into a CSV file selected by the user.
  *
- * CSV-data is generated periodically each time the @c Misc::TimerEvents
- * low-frequency timer expires (e.g. every 1 second). The idea behind this
- * is to allow exporting data, but avoid freezing the application when serial
- * data is received continuously.
+ * Received frames are timestamped on arrival & pushed into a lock-free queue,
+ * an instance of @c CSV::ExportWriter running on a dedicated thread drains the
+ * queue, formats the CSV rows & writes them to disk. In this way, CSV logging
+ * never blocks the user interface, even during frame bursts.
  */
-typedef struct
-{
-    QByteArray data;
-    QDateTime rxDateTime;
-} RawFrame;
-
 class Export : public QObject
 {
     // clang-format off
@@ -60,11 +163,43 @@ class Export : public QObject
                READ exportEnabled
                WRITE setExportEnabled
                NOTIFY enabledChanged)
+    Q_PROPERTY(bool binaryFormat
+               READ binaryFormat
+               WRITE setBinaryFormat
+               NOTIFY formatChanged)
+    Q_PROPERTY(bool compression
+               READ compression
+               WRITE setCompression
+               NOTIFY compressionChanged)
+    Q_PROPERTY(int rotationPolicy
+               READ rotationPolicy
+               WRITE setRotationPolicy
+               NOTIFY rotationPolicyChanged)
+    Q_PROPERTY(bool segmentPreallocation
+               READ segmentPreallocation
+               WRITE setSegmentPreallocation
+               NOTIFY preallocationChanged)
+    Q_PROPERTY(StringList rotationPolicyOptions
+               READ rotationPolicyOptions
+               CONSTANT)
+    Q_PROPERTY(int durabilityPolicy
+               READ durabilityPolicy
+               WRITE setDurabilityPolicy
+               NOTIFY durabilityPolicyChanged)
+    Q_PROPERTY(StringList durabilityPolicyOptions
+               READ durabilityPolicyOptions
+               CONSTANT)
     // clang-format on
 
 Q_SIGNALS:
     void openChanged();
+    void frameQueued();
+    void formatChanged();
     void enabledChanged();
+    void compressionChanged();
+    void rotationPolicyChanged();
+    void preallocationChanged();
+    void durabilityPolicyChanged();
 
 private:
     explicit Export();
@@ -79,23 +214,43 @@ public:
     static Export &instance();
 
     bool isOpen() const;
+    bool compression() const;
+    bool binaryFormat() const;
     bool exportEnabled() const;
+    int rotationPolicy() const;
+    int durabilityPolicy() const;
+    bool segmentPreallocation() const;
+    StringList rotationPolicyOptions() const;
+    StringList durabilityPolicyOptions() const;
 
 public Q_SLOTS:
     void closeFile();
     void openCurrentCsv();
+    void convertBinaryLog();
+    void setBinaryFormat(const bool binary);
+    void setRotationPolicy(const int policy);
     void setExportEnabled(const bool enabled);
+    void setDurabilityPolicy(const int policy);
+    void setCompression(const bool compression);
+    void setSegmentPreallocation(const bool preallocate);
 
 private Q_SLOTS:
-    void writeValues();
+    void updateWriterConfig();
+    void onWriterOpenFailed();
     void registerFrame(const QByteArray &data);
-    void createCsvFile(const CSV::RawFrame &frame);
+    void onWriterOpenChanged(const bool open, const QString &fileName);
 
 private:
-    QFile m_csvFile;
-    int m_fieldCount;
+    bool m_isOpen;
+    bool m_binaryFormat;
+    bool m_compression;
     bool m_exportEnabled;
-    QTextStream m_textStream;
-    QVector<RawFrame> m_frames;
+    bool m_segmentPreallocation;
+    int m_rotationPolicy;
+    int m_durabilityPolicy;
+    QString m_csvPath;
+    IO::FrameQueue m_frameQueue;
+    QThread m_writerThread;
+    ExportWriter *m_writer;
 };
 }
@@ -20,28 +20,370 @@
  * THE SOFTWARE.
  */
 
+#include <cstring>
+#include <algorithm>
+
 #include <QtMath>
 #include <QFileDialog>
 #include <QApplication>
 
-#include <qtcsv/stringdata.h>
-#include <qtcsv/reader.h>
-
 #include <CSV/Player.h>
 #include <IO/Manager.h>
+#include <JSON/Generator.h>
 #include <Misc/Utilities.h>
+#include <Misc/MemoryRegistry.h>
+
+//----------------------------------------------------------------------------------------
+// CSV indexer (runs on a dedicated thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Number of evenly spaced rows sampled by the overview pass & number of min/max bins
+ * that they are condensed into. Sampling a fixed number of rows makes the cost of the
+ * pass independent of the file size, & ~10 samples per bin is enough for the bins to
+ * catch the shape of the data.
+ */
+static const int kOverviewRows = 2000;
+static const int kOverviewBins = 200;
+
+/**
+ * Maximum number of channels rendered by the overview timeline, files with more
+ * columns only show the first channels (a taller thumbnail would be unreadable
+ * anyway)
+ */
+static const int kOverviewMaxChannels = 8;
 
 /**
  * Constructor function
  */
+CSV::PlayerIndexer::PlayerIndexer(QObject *parent)
+    : QObject(parent)
+    , m_cancelled(0)
+{
+}
+
+/**
+ * Aborts the index pass that is currently running (if any). This function is
+ * thread-safe & can be called directly from the user interface thread.
+ */
+void CSV::PlayerIndexer::cancelIndexing()
+{
+    m_cancelled.storeRelease(1);
+}
+
+/**
+ * Decodes @a count consecutive decimal digits starting at @a data, returns -1 if any
+ * of the characters is not a digit.
+ */
+static int ReadDigits(const char *data, const int count)
+{
+    int value = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (data[i] < '0' || data[i] > '9')
+            return -1;
+
+        value = (value * 10) + (data[i] - '0');
+    }
+
+    return value;
+}
+
+/**
+ * Parses the RX timestamp at the start of the given @a row without allocating any
+ * strings. The timestamp uses the fixed-width format written by @c Export.cpp
+ * ("yyyy/MM/dd/ HH:mm:ss::zzz"), rows that do not begin with a valid timestamp (e.g.
+ * the title row) yield -1. The epoch offset of the date portion is cached between
+ * calls, because consecutive rows almost always belong to the same day.
+ */
+static qint64 ParseRowTimestamp(const char *row, const qint64 length,
+                                qint32 &cachedDate, qint64 &cachedDayMsecs)
+{
+    // Row too short to contain a timestamp
+    if (length < 25)
+        return -1;
+
+    // Verify the fixed separator positions
+    if (row[4] != '/' || row[7] != '/' || row[10] != '/' || row[11] != ' '
+        || row[14] != ':' || row[17] != ':' || row[20] != ':' || row[21] != ':')
+        return -1;
+
+    // Decode the digit groups
+    const int year = ReadDigits(row + 0, 4);
+    const int month = ReadDigits(row + 5, 2);
+    const int day = ReadDigits(row + 8, 2);
+    const int hour = ReadDigits(row + 12, 2);
+    const int minute = ReadDigits(row + 15, 2);
+    const int second = ReadDigits(row + 18, 2);
+    const int msec = ReadDigits(row + 22, 3);
+    if (year < 0 || month < 0 || day < 0 || hour < 0 || minute < 0 || second < 0
+        || msec < 0)
+        return -1;
+
+    // Re-compute the epoch offset of the date only when the day changes
+    const qint32 date = (year * 10000) + (month * 100) + day;
+    if (date != cachedDate)
+    {
+        const QDateTime midnight(QDate(year, month, day), QTime(0, 0));
+        if (!midnight.isValid())
+            return -1;
+
+        cachedDate = date;
+        cachedDayMsecs = midnight.toMSecsSinceEpoch();
+    }
+
+    return cachedDayMsecs + ((((hour * 60) + minute) * 60 + second) * 1000) + msec;
+}
+
+/**
+ * Memory-maps the file at the given @a filePath & registers the byte offset & RX
+ * timestamp of every row. The generated index is sent to the player through a queued
+ * signal when the scan finnishes. The indexer maps its own view of the file, so the
+ * player can close the file at any moment without waiting for the scan to end.
+ */
+void CSV::PlayerIndexer::buildIndex(const QString &filePath)
+{
+    // Reset the cancellation flag
+    m_cancelled.storeRelease(0);
+
+    // Map the file into memory
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const qint64 size = file.size();
+    const uchar *data = file.map(0, size);
+    if (!data || size <= 0)
+        return;
+
+    // Register the offset & RX timestamp of every row
+    QVector<qint64> rowIndex;
+    QVector<qint64> rowTimes;
+    qint64 offset = 0;
+    qint32 cachedDate = 0;
+    qint64 cachedDayMsecs = 0;
+    const char *base = reinterpret_cast<const char *>(data);
+    while (offset < size)
+    {
+        rowIndex.append(offset);
+
+        // Find the end of the current row
+        const char *eol
+            = static_cast<const char *>(memchr(base + offset, '\n', size - offset));
+        const qint64 rowEnd = eol ? (eol - base) : size;
+
+        // Parse the timestamp cell of the current row
+        rowTimes.append(ParseRowTimestamp(base + offset, rowEnd - offset, cachedDate,
+                                          cachedDayMsecs));
+
+        // Jump to the next row
+        if (!eol)
+            break;
+        offset = rowEnd + 1;
+
+        // Poll the cancellation flag every few thousand rows
+        if ((rowIndex.count() & 0xfff) == 0 && m_cancelled.loadAcquire())
+            return;
+    }
+
+    // Send the generated index to the player
+    if (!m_cancelled.loadAcquire())
+        Q_EMIT indexReady(filePath, rowIndex, rowTimes);
+}
+
+/**
+ * Samples @c kOverviewRows evenly spaced data rows of the file at the given
+ * @a filePath (located through the @a rowIndex generated by @c buildIndex()) &
+ * condenses their numeric cells into @c kOverviewBins min/max pairs per channel,
+ * normalized to the [0, 1] range of each channel. The resulting strips are sent to
+ * the player, which renders them as a thumbnail timeline above the progress bar.
+ *
+ * Cells are parsed with a plain comma split: the overview only has to convey the
+ * shape of the data, & the session logs written by @c CSV::Export never quote their
+ * numeric cells.
+ */
+void CSV::PlayerIndexer::buildOverview(const QString &filePath,
+                                       const QVector<qint64> &rowIndex)
+{
+    // Not enough data rows to draw anything useful (row 0 holds the titles)
+    if (rowIndex.count() < 3)
+        return;
+
+    // Map the file into memory
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const qint64 size = file.size();
+    const uchar *data = file.map(0, size);
+    if (!data || size <= 0)
+        return;
+    const char *base = reinterpret_cast<const char *>(data);
+
+    // Decide how many rows to sample & how many bins to produce
+    const int rows = rowIndex.count() - 1;
+    const int samples = qMin(rows, kOverviewRows);
+    const int bins = qMin(samples, kOverviewBins);
+
+    // Accumulate the min/max of every bin, channels are discovered as they appear
+    QVector<QVector<double>> minima;
+    QVector<QVector<double>> maxima;
+    for (int s = 0; s < samples; ++s)
+    {
+        // Locate the boundaries of the sampled row
+        const int row = 1 + static_cast<int>((qint64(s) * rows) / samples);
+        const qint64 begin = rowIndex.at(row);
+        const qint64 end = (row + 1 < rowIndex.count()) ? rowIndex.at(row + 1) : size;
+        const int bin = static_cast<int>((qint64(s) * bins) / samples);
+
+        // Split the row at the commas & merge each numeric cell into its bin, the
+        // first cell (the RX date/time) is skipped
+        int cell = 0;
+        qint64 cellStart = begin;
+        for (qint64 i = begin; i <= end; ++i)
+        {
+            if (i < end && base[i] != ',')
+                continue;
+
+            if (cell > 0 && cell <= kOverviewMaxChannels)
+            {
+                // Parse the cell value
+                bool ok = false;
+                const auto text = QByteArray(base + cellStart,
+                                             static_cast<int>(i - cellStart));
+                const double value = text.trimmed().toDouble(&ok);
+
+                // Register a strip for every newly discovered channel
+                const int channel = cell - 1;
+                while (ok && minima.count() <= channel)
+                {
+                    minima.append(QVector<double>(bins, qInf()));
+                    maxima.append(QVector<double>(bins, -qInf()));
+                }
+
+                // Merge the value into the bin of this sample
+                if (ok)
+                {
+                    minima[channel][bin] = qMin(minima.at(channel).at(bin), value);
+                    maxima[channel][bin] = qMax(maxima.at(channel).at(bin), value);
+                }
+            }
+
+            ++cell;
+            cellStart = i + 1;
+        }
+
+        // Poll the cancellation flag every few hundred samples
+        if ((s & 0xff) == 0 && m_cancelled.loadAcquire())
+            return;
+    }
+
+    // Fill bins that did not receive any sample (e.g. non-numeric cells) with the
+    // previous valid pair & normalize each channel to its own [0, 1] range
+    for (int c = 0; c < minima.count(); ++c)
+    {
+        auto &mins = minima[c];
+        auto &maxs = maxima[c];
+
+        // Compute the value range of the channel & patch the empty bins
+        double gmin = qInf();
+        double gmax = -qInf();
+        for (int b = 0; b < bins; ++b)
+        {
+            if (mins.at(b) > maxs.at(b))
+            {
+                mins[b] = (b > 0) ? mins.at(b - 1) : 0;
+                maxs[b] = (b > 0) ? maxs.at(b - 1) : 0;
+            }
+
+            gmin = qMin(gmin, mins.at(b));
+            gmax = qMax(gmax, maxs.at(b));
+        }
+
+        // Normalize, flat channels draw as a centered line
+        const double range = gmax - gmin;
+        for (int b = 0; b < bins; ++b)
+        {
+            if (range > 0)
+            {
+                mins[b] = (mins.at(b) - gmin) / range;
+                maxs[b] = (maxs.at(b) - gmin) / range;
+            }
+
+            else
+            {
+                mins[b] = 0.5;
+                maxs[b] = 0.5;
+            }
+        }
+    }
+
+    // Send the generated strips to the player
+    if (!m_cancelled.loadAcquire() && !minima.isEmpty())
+        Q_EMIT overviewReady(filePath, minima, maxima);
+}
+
+//----------------------------------------------------------------------------------------
+// CSV player (runs on the GUI thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, configures the indexer worker & the playback pacing timer
+ */
 CSV::Player::Player()
     : m_framePos(0)
     , m_playing(false)
+    , m_loopEnabled(false)
+    , m_regionStart(0)
+    , m_regionEnd(1)
     , m_timestamp("")
+    , m_playbackSpeed(1)
+    , m_anchorLogMsecs(0)
+    , m_anchorWallNsecs(0)
+    , m_mapSize(0)
+    , m_mapData(Q_NULLPTR)
+    , m_indexer(Q_NULLPTR)
 {
+    // Move the CSV indexer to a dedicated thread, scanning a multi-GB log must never
+    // block the user interface
+    qRegisterMetaType<QVector<qint64>>("QVector<qint64>");
+    qRegisterMetaType<QVector<QVector<double>>>("QVector<QVector<double>>");
+    m_indexer = new PlayerIndexer;
+    m_indexer->moveToThread(&m_indexerThread);
+    // clang-format off
+    connect(&m_indexerThread, &QThread::finished, m_indexer, &QObject::deleteLater);
+    connect(m_indexer, &CSV::PlayerIndexer::indexReady,
+            this, &CSV::Player::onIndexReady, Qt::QueuedConnection);
+    connect(m_indexer, &CSV::PlayerIndexer::overviewReady,
+            this, &CSV::Player::onOverviewReady, Qt::QueuedConnection);
+    // clang-format on
+
+    // Configure the playback pacing timer, dispatchFrames() performs deadline
+    // correction against the monotonic clock on every tick
+    m_paceClock.start();
+    m_paceTimer.setSingleShot(true);
+    m_paceTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_paceTimer, SIGNAL(timeout()), this, SLOT(dispatchFrames()));
+
+    // Configure signals/slots
     connect(this, SIGNAL(playerStateChanged()), this, SLOT(updateData()));
 }
 
+/**
+ * Stop the indexer thread before destroying the class
+ */
+CSV::Player::~Player()
+{
+    m_indexer->cancelIndexing();
+    if (m_indexerThread.isRunning())
+    {
+        m_indexerThread.quit();
+        m_indexerThread.wait();
+    }
+
+    // The indexer thread never ran, delete the worker directly
+    else
+        delete m_indexer;
+}
+
 /**
  * Returns the only instance of the class
  */
@@ -64,6 +406,17 @@ bool CSV::Player::isOpen() const
  */
 qreal CSV::Player::progress() const
 {
+    // Map the current frame to its position in the timeline, so that the progress
+    // bar advances at the same rate as the clock even when the log rate varies
+    if (m_rowTimes.count() == m_rowIndex.count() && frameCount() > 0)
+    {
+        const qint64 first = m_rowTimes.value(1, -1);
+        const qint64 last = m_rowTimes.value(m_rowTimes.count() - 1, -1);
+        const qint64 current = m_rowTimes.value(framePosition() + 1, -1);
+        if (first >= 0 && current >= first && last > first)
+            return ((qreal)(current - first)) / (last - first);
+    }
+
     return ((qreal)framePosition()) / frameCount();
 }
 
@@ -97,7 +450,7 @@ QString CSV::Player::filename() const
  */
 int CSV::Player::frameCount() const
 {
-    return m_csvData.count() - 1;
+    return m_rowIndex.count() - 1;
 }
 
 /**
@@ -136,6 +489,73 @@ QString CSV::Player::csvFilesPath() const
     return path;
 }
 
+/**
+ * Returns the current playback speed factor (1.0 = real-time speed)
+ */
+qreal CSV::Player::playbackSpeed() const
+{
+    return m_playbackSpeed;
+}
+
+/**
+ * Returns @c true when playback wraps back to the region start instead of pausing
+ * at the end of the file (or of the A-B region)
+ */
+bool CSV::Player::loopEnabled() const
+{
+    return m_loopEnabled;
+}
+
+/**
+ * Returns the start of the playback region as a fraction of the timeline, @c 0
+ * when no region start has been marked
+ */
+qreal CSV::Player::regionStart() const
+{
+    return m_regionStart;
+}
+
+/**
+ * Returns the end of the playback region as a fraction of the timeline, @c 1
+ * when no region end has been marked
+ */
+qreal CSV::Player::regionEnd() const
+{
+    return m_regionEnd;
+}
+
+/**
+ * Returns the number of channels of the overview timeline, @c 0 until the overview
+ * pass of the indexer thread finishes
+ */
+int CSV::Player::overviewChannelCount() const
+{
+    return m_overviewMin.count();
+}
+
+/**
+ * Returns the overview strip of the given @a channel as a flat list of interleaved
+ * min/max pairs (one pair per bin), normalized to the [0, 1] value range of the
+ * channel. The player window draws one filled band per channel from these lists.
+ */
+QVariantList CSV::Player::overviewStrip(const int channel) const
+{
+    QVariantList strip;
+    if (channel < 0 || channel >= m_overviewMin.count())
+        return strip;
+
+    const auto &mins = m_overviewMin.at(channel);
+    const auto &maxs = m_overviewMax.at(channel);
+    strip.reserve(mins.count() * 2);
+    for (int i = 0; i < mins.count(); ++i)
+    {
+        strip.append(mins.at(i));
+        strip.append(maxs.at(i));
+    }
+
+    return strip;
+}
+
 /**
  * Enables CSV playback at 'live' speed (as it happened when CSV file was
  * saved to the computer).
@@ -153,6 +573,7 @@ void CSV::Player::play()
 void CSV::Player::pause()
 {
     m_playing = false;
+    m_paceTimer.stop();
     Q_EMIT playerStateChanged();
 }
 
@@ -192,13 +613,31 @@ void CSV::Player::openFile()
  */
 void CSV::Player::closeFile()
 {
+    // Abort the index pass (if one is still running)
+    m_indexer->cancelIndexing();
+
+    // Unmap & close the file
+    if (m_mapData)
+        m_csvFile.unmap(const_cast<uchar *>(m_mapData));
+
     m_framePos = 0;
+    m_mapSize = 0;
+    m_mapData = Q_NULLPTR;
     m_csvFile.close();
-    m_csvData.clear();
+    m_rowIndex.clear();
+    m_rowTimes.clear();
+    m_rowCache.clear();
+    m_secondIndex.clear();
     m_playing = false;
     m_timestamp = "--.--";
+    m_regionStart = 0;
+    m_regionEnd = 1;
+    m_overviewMin.clear();
+    m_overviewMax.clear();
 
     Q_EMIT openChanged();
+    Q_EMIT regionChanged();
+    Q_EMIT overviewChanged();
     Q_EMIT timestampChanged();
     Q_EMIT playerStateChanged();
 }
@@ -228,9 +667,9 @@ void CSV::Player::previousFrame()
 }
 
 /**
- * Opens a CSV file and valitates it by comparing every data row with the title
- * row. If one of the data rows does not correspond to the title row, the CSV
- * is considered to be invalid.
+ * Opens a CSV file & maps it into memory, the row index is generated by the indexer
+ * thread & playback begins as soon as the index is ready. In this way, opening a
+ * file is near-instant regardless of its size.
  */
 void CSV::Player::openFile(const QString &filePath)
 {
@@ -259,30 +698,28 @@ void CSV::Player::openFile(const QString &filePath)
     m_csvFile.setFileName(filePath);
     if (m_csvFile.open(QIODevice::ReadOnly))
     {
-        // Read CSV file into string matrix
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-        QVector<QString> row;
-        auto csv = QtCSV::Reader::readToList(m_csvFile);
-        for (int i = 0; i < csv.count(); ++i)
+        // Map the file into memory, rows are materialized on demand
+        m_mapSize = m_csvFile.size();
+        m_mapData = m_csvFile.map(0, m_mapSize);
+        if (!m_mapData)
         {
-            row.clear();
-            for (int j = 0; j < csv.at(i).count(); ++j)
-                row.append(csv[i][j]);
-
-            m_csvData.append(row);
+            Misc::Utilities::showMessageBox(
+                tr("Cannot read CSV file"),
+                tr("Please check file permissions & location"));
+            closeFile();
+            return;
         }
-#else
-        m_csvData = QtCSV::Reader::readToList(m_csvFile);
-#endif
 
-        // Read first data & Q_EMIT UI signals
-        updateData();
-        Q_EMIT openChanged();
+        // Generate the row index on the indexer thread, playback starts when the
+        // index is ready (see onIndexReady()). The thread is only started once the
+        // user opens a CSV file, so that it does not add to the startup cost.
+        if (!m_indexerThread.isRunning())
+            m_indexerThread.start(QThread::LowPriority);
+        QMetaObject::invokeMethod(m_indexer, "buildIndex", Qt::QueuedConnection,
+                                  Q_ARG(QString, filePath));
 
-        // Play next frame (to force UI to generate groups, graphs & widgets)
-        // Note: nextFrame() MUST BE CALLED AFTER emiting the openChanged() signal in
-        //       order for this monstrosity to work
-        nextFrame();
+        // Update user interface
+        Q_EMIT openChanged();
     }
 
     // Open error
@@ -294,6 +731,96 @@ void CSV::Player::openFile(const QString &filePath)
     }
 }
 
+/**
+ * Registers the row index generated by the indexer thread & starts playback. Stale
+ * indexes (generated for a file that is no longer open) are ignored.
+ */
+void CSV::Player::onIndexReady(const QString &filePath,
+                               const QVector<qint64> &rowIndex,
+                               const QVector<qint64> &rowTimes)
+{
+    // Index does not correspond to the current file, ignore it
+    if (!isOpen() || filePath != m_csvFile.fileName())
+        return;
+
+    // Register the row index & timestamps
+    m_rowIndex = rowIndex;
+    m_rowTimes = rowTimes;
+
+    // Report the size of the playback index to the memory accounting surface
+    // (the mapped file itself is pageable & not counted as heap memory)
+    Misc::MemoryRegistry::instance().report(
+        "CSV::Player (row index)",
+        qint64(m_rowIndex.count() + m_rowTimes.count()) * sizeof(qint64));
+
+    // Replace invalid or non-monotonic timestamps with the previous valid value, so
+    // that the timestamp vector can be binary-searched
+    qint64 previous = -1;
+    for (int i = 1; i < m_rowTimes.count(); ++i)
+    {
+        if (m_rowTimes.at(i) < previous)
+            m_rowTimes.replace(i, previous);
+        else
+            previous = m_rowTimes.at(i);
+    }
+
+    // Pre-compute the per-second frame map used to scrub the progress bar, entry [s]
+    // holds the first frame whose timestamp is at least @c s seconds after the start
+    // of the log. Absurdly long spans (e.g. caused by a corrupt timestamp) fall back
+    // to the plain binary search.
+    m_secondIndex.clear();
+    if (frameCount() > 0)
+    {
+        const qint64 first = m_rowTimes.value(1, -1);
+        const qint64 last = m_rowTimes.value(m_rowTimes.count() - 1, -1);
+        const qint64 seconds = (first >= 0) ? ((last - first) / 1000) + 1 : 0;
+        if (seconds > 0 && seconds <= 86400 * 30)
+        {
+            m_secondIndex.reserve(static_cast<int>(seconds));
+            int frame = 0;
+            for (qint64 s = 0; s < seconds; ++s)
+            {
+                const qint64 target = first + (s * 1000);
+                while (frame < frameCount() - 1 && m_rowTimes.at(frame + 1) < target)
+                    ++frame;
+                m_secondIndex.append(frame);
+            }
+        }
+    }
+
+    // Generate the overview strips on the indexer thread, the row index is
+    // implicitly shared so passing it back costs one reference count
+    QMetaObject::invokeMethod(m_indexer, "buildOverview", Qt::QueuedConnection,
+                              Q_ARG(QString, filePath),
+                              Q_ARG(QVector<qint64>, m_rowIndex));
+
+    // Read first data & Q_EMIT UI signals
+    updateData();
+    Q_EMIT openChanged();
+
+    // Play next frame (to force UI to generate groups, graphs & widgets)
+    // Note: nextFrame() MUST BE CALLED AFTER emiting the openChanged() signal in
+    //       order for this monstrosity to work
+    nextFrame();
+}
+
+/**
+ * Registers the overview strips generated by the indexer thread. Stale overviews
+ * (generated for a file that is no longer open) are ignored.
+ */
+void CSV::Player::onOverviewReady(const QString &filePath,
+                                  const QVector<QVector<double>> &minima,
+                                  const QVector<QVector<double>> &maxima)
+{
+    // Overview does not correspond to the current file, ignore it
+    if (!isOpen() || filePath != m_csvFile.fileName())
+        return;
+
+    m_overviewMin = minima;
+    m_overviewMax = maxima;
+    Q_EMIT overviewChanged();
+}
+
 /**
  * Reads a specific row from the @a progress range (which can have a value
  * ranging from 0.0 to 1.0).
@@ -311,8 +838,9 @@ void CSV::Player::setProgress(const qreal &progress)
     if (isPlaying())
         pause();
 
-    // Calculate frame position & update data
-    m_framePos = qCeil(frameCount() * validProgress);
+    // Seek to the frame that matches the selected point of the timeline, the
+    // timestamp index resolves the target in O(log n)
+    m_framePos = frameAtProgress(validProgress);
     if (validProgress == 0)
         m_framePos = 0;
     else if (validProgress == 1)
@@ -322,6 +850,76 @@ void CSV::Player::setProgress(const qreal &progress)
     updateData();
 }
 
+/**
+ * Changes the playback @a speed factor, which is clamped to a range from 0.1x to
+ * 1000x. The pacing engine is re-anchored at the current frame, so the rate change
+ * applies from this point onwards instead of re-scaling the time played so far.
+ */
+void CSV::Player::setPlaybackSpeed(const qreal speed)
+{
+    // Clamp & register the new speed factor
+    m_playbackSpeed = qBound(0.1, speed, 1000.0);
+    Q_EMIT playbackSpeedChanged();
+
+    // Re-anchor the pacing engine & re-schedule the next batch
+    anchorPlayback();
+    if (isPlaying())
+    {
+        m_paceTimer.stop();
+        rescheduleDispatch();
+    }
+}
+
+/**
+ * Enables or disables loop playback: when enabled, reaching the end of the file
+ * (or of the A-B region) wraps back to the region start instead of pausing, so a
+ * representative capture can soak-test a dashboard for hours without a human
+ * restarting the player.
+ */
+void CSV::Player::setLoopEnabled(const bool enabled)
+{
+    m_loopEnabled = enabled;
+    Q_EMIT loopChanged();
+}
+
+/**
+ * Marks the start of the A-B playback region at the given point of the timeline,
+ * values at or past the region end are ignored.
+ */
+void CSV::Player::setRegionStart(const qreal progress)
+{
+    const qreal value = qBound(0.0, progress, 1.0);
+    if (value < m_regionEnd)
+    {
+        m_regionStart = value;
+        Q_EMIT regionChanged();
+    }
+}
+
+/**
+ * Marks the end of the A-B playback region at the given point of the timeline,
+ * values at or before the region start are ignored.
+ */
+void CSV::Player::setRegionEnd(const qreal progress)
+{
+    const qreal value = qBound(0.0, progress, 1.0);
+    if (value > m_regionStart)
+    {
+        m_regionEnd = value;
+        Q_EMIT regionChanged();
+    }
+}
+
+/**
+ * Removes the A-B region markers, playback covers the whole file again
+ */
+void CSV::Player::clearRegion()
+{
+    m_regionStart = 0;
+    m_regionEnd = 1;
+    Q_EMIT regionChanged();
+}
+
 /**
  * Generates a JSON data frame by combining the values of the current CSV
  * row & the structure of the JSON map file loaded in the @c JsonParser class.
@@ -345,15 +943,23 @@ void CSV::Player::updateData()
         Q_EMIT timestampChanged();
     }
 
-    // Construct frame from CSV and send it to the IO manager
-    IO::Manager::instance().processPayload(getFrame(framePosition() + 1));
+    // Feed the values of the current row to the application modules
+    dispatchRow(framePosition() + 1);
 
-    // If the user wants to 'play' the CSV, get time difference between this
-    // frame and the next frame & schedule an automated update
+    // If the user wants to 'play' the CSV, anchor the pacing engine at the current
+    // frame & schedule the next batch dispatch against the monotonic clock
     if (isPlaying())
     {
-        // Get first frame
-        if (framePosition() < frameCount())
+        // Timestamp index available, use the drift-free pacing engine
+        if (framePosition() + 2 < m_rowTimes.count()
+            && m_rowTimes.at(framePosition() + 2) >= 0)
+        {
+            anchorPlayback();
+            rescheduleDispatch();
+        }
+
+        // No usable timestamps (e.g. foreign CSV), fall back to per-frame timers
+        else if (framePosition() < frameCount())
         {
             bool error = true;
             auto currTime = getCellValue(framePosition() + 1, 0, error);
@@ -383,12 +989,207 @@ void CSV::Player::updateData()
             }
         }
 
+        // End of CSV reached, restart playback from the first frame when loop
+        // playback is enabled & pause otherwise. A-B regions are only honored by
+        // the pacing engine above: they require the timestamp index, which the
+        // session logs written by Serial Studio always provide.
+        else if (m_loopEnabled)
+        {
+            m_framePos = 0;
+            QTimer::singleShot(0, this, SLOT(nextFrame()));
+        }
+
         // Pause at end of CSV
         else
             pause();
     }
 }
 
+/**
+ * Registers the current frame & the monotonic clock as the reference point of the
+ * pacing engine. All playback deadlines are computed relative to this anchor, so
+ * timer jitter cannot accumulate into drift.
+ */
+void CSV::Player::anchorPlayback()
+{
+    m_anchorWallNsecs = m_paceClock.nsecsElapsed();
+    m_anchorLogMsecs = m_rowTimes.value(framePosition() + 1, -1);
+    if (m_anchorLogMsecs < 0)
+        m_anchorLogMsecs = m_rowTimes.value(1, 0);
+}
+
+/**
+ * Returns the log time that playback should have reached by now, computed from the
+ * monotonic clock, the playback anchor & the playback speed factor.
+ */
+qint64 CSV::Player::targetLogTime() const
+{
+    const qint64 elapsed = (m_paceClock.nsecsElapsed() - m_anchorWallNsecs) / 1000000;
+    return m_anchorLogMsecs + qRound64(elapsed * m_playbackSpeed);
+}
+
+/**
+ * Timer slot of the playback pacing engine. Every tick computes the target log time
+ * from the monotonic clock, dispatches every frame that is due in a single batch &
+ * re-schedules itself against the deadline of the next frame. Correcting the
+ * deadline on every tick keeps long playback sessions drift-free, even at sub-10 ms
+ * frame intervals or extreme playback speeds.
+ */
+void CSV::Player::dispatchFrames()
+{
+    // File closed or playback paused, abort
+    if (!isOpen() || !isPlaying())
+        return;
+
+    // Obtain the log time that playback should have reached by now
+    const qint64 target = targetLogTime();
+
+    // Dispatch every frame that is due, the batch is bounded so that falling behind
+    // cannot starve the event loop. Playback never advances past the end of the
+    // A-B region (if one is marked).
+    int dispatched = 0;
+    const int endFrame = regionEndFrame();
+    while (framePosition() + 2 < m_rowTimes.count() && framePosition() < endFrame
+           && dispatched < 512)
+    {
+        if (m_rowTimes.at(framePosition() + 2) > target)
+            break;
+
+        ++m_framePos;
+        ++dispatched;
+        dispatchRow(framePosition() + 1);
+    }
+
+    // Update the timestamp string once per batch
+    if (dispatched > 0)
+    {
+        bool error = true;
+        const auto timestamp = getCellValue(framePosition() + 1, 0, error);
+        if (!error)
+        {
+            m_timestamp = timestamp;
+            Q_EMIT timestampChanged();
+        }
+    }
+
+    // End of the file or of the A-B region reached, wrap to the region start when
+    // loop playback is enabled & pause otherwise
+    if (framePosition() + 2 >= m_rowTimes.count() || framePosition() >= endFrame)
+    {
+        if (m_loopEnabled)
+            wrapToRegionStart();
+        else
+            pause();
+    }
+
+    // Schedule the next batch
+    else
+        rescheduleDispatch();
+}
+
+/**
+ * Starts the pacing timer so that it fires at the deadline of the next frame. When
+ * several frames fall within a single UI refresh interval (high log rates or high
+ * playback speeds), the timer ticks at ~60 Hz instead & dispatchFrames() delivers
+ * the due frames in batches.
+ */
+void CSV::Player::rescheduleDispatch()
+{
+    // No next frame, nothing to schedule
+    if (framePosition() + 2 >= m_rowTimes.count())
+        return;
+
+    // Convert the log-time distance to the next frame into wall-clock milliseconds
+    const qint64 next = m_rowTimes.at(framePosition() + 2);
+    qint64 wait = qRound64((next - targetLogTime()) / m_playbackSpeed);
+    if (wait < 0)
+        wait = 0;
+
+    // More than one frame due within a UI refresh interval, tick at ~60 Hz & batch
+    if (wait < 16 && framePosition() + 3 < m_rowTimes.count())
+    {
+        const qint64 horizon = targetLogTime() + qRound64(16 * m_playbackSpeed);
+        if (m_rowTimes.at(framePosition() + 3) <= horizon)
+            wait = 16;
+    }
+
+    m_paceTimer.start(static_cast<int>(qMin<qint64>(wait, 1000)));
+}
+
+/**
+ * Seeks back to the first frame of the playback region & continues dispatching
+ * from there. The wraparound reuses the indexed seek path & re-anchors the pacing
+ * engine at the region start, so looping a region costs an index lookup instead
+ * of re-walking the file & long soak-test sessions stay drift-free.
+ */
+void CSV::Player::wrapToRegionStart()
+{
+    // Jump to the first frame of the region & feed it to the modules
+    m_framePos = regionStartFrame();
+    dispatchRow(framePosition() + 1);
+
+    // Update the timestamp string
+    bool error = true;
+    const auto timestamp = getCellValue(framePosition() + 1, 0, error);
+    if (!error)
+    {
+        m_timestamp = timestamp;
+        Q_EMIT timestampChanged();
+    }
+
+    // Re-anchor the pacing engine & schedule the next batch
+    anchorPlayback();
+    rescheduleDispatch();
+}
+
+/**
+ * Returns the first frame of the playback region, @c 0 when no region start has
+ * been marked
+ */
+int CSV::Player::regionStartFrame() const
+{
+    if (m_regionStart <= 0)
+        return 0;
+
+    return qMax(0, frameAtProgress(m_regionStart));
+}
+
+/**
+ * Returns the frame at which playback wraps (or pauses), @c frameCount() when no
+ * region end has been marked. The region is guaranteed to contain at least one
+ * frame past its start, so a degenerate region cannot stall the dispatch loop.
+ */
+int CSV::Player::regionEndFrame() const
+{
+    if (m_regionEnd >= 1)
+        return frameCount();
+
+    return qBound(regionStartFrame() + 1, frameAtProgress(m_regionEnd), frameCount());
+}
+
+/**
+ * Delivers the data at the given @a row to the application modules. When a JSON map
+ * file is loaded, the row cells are bound directly to the dataset slots of the frame
+ * model: the split values are handed to the generator as-is, instead of being joined
+ * into a delimited frame that the generator would immediately re-split. The
+ * serialized frame is still published to the console, MQTT & plugin modules, it just
+ * no longer goes through the frame parser. Without a map file (e.g. automatic mode),
+ * the serialized frame is sent through the regular parse path.
+ */
+void CSV::Player::dispatchRow(const int row)
+{
+    // Bind the row cells directly to the dataset slots of the frame model, the
+    // cell at index 1 (the one after the RX date/time) maps to placeholder "%1"
+    auto &generator = JSON::Generator::instance();
+    if (generator.operationMode() != JSON::Generator::kAutomatic
+        && generator.readCells(materializeRow(row), 1))
+        IO::Manager::instance().publishPayload(getFrame(row));
+
+    // No compiled JSON map available, send the frame through the parse path
+    else
+        IO::Manager::instance().processPayload(getFrame(row));
+}
+
 /**
  * Generates a frame from the data at the given @a row. The first item of each row is
  * ignored because it contains the RX date/time, which is used to regulate the interval
@@ -399,20 +1200,143 @@ QByteArray CSV::Player::getFrame(const int row)
     QByteArray frame;
     auto sep = IO::Manager::instance().separatorSequence();
 
-    if (m_csvData.count() > row)
+    const auto list = materializeRow(row);
+    for (int i = 1; i < list.count(); ++i)
+    {
+        frame.append(list.at(i).toUtf8());
+        if (i < list.count() - 1)
+            frame.append(sep.toUtf8());
+        else
+            frame.append('\n');
+    }
+
+    return frame;
+}
+
+/**
+ * Splits the row at the given index into its cell values, reading the row bytes
+ * directly from the memory-mapped file. Only the rows around the play cursor are
+ * materialized, a small cache avoids re-parsing the same row on every tick.
+ */
+QStringList CSV::Player::materializeRow(const int row)
+{
+    // Return the cached copy when available
+    const auto it = m_rowCache.constFind(row);
+    if (it != m_rowCache.constEnd())
+        return it.value();
+
+    // Validate the row index
+    QStringList fields;
+    if (row < 0 || row >= m_rowIndex.count() || !m_mapData)
+        return fields;
+
+    // Obtain the row boundaries from the index
+    qint64 begin = m_rowIndex.at(row);
+    const qint64 end
+        = (row + 1 < m_rowIndex.count()) ? m_rowIndex.at(row + 1) : m_mapSize;
+
+    // Skip the UTF-8 byte order mark
+    if (row == 0 && end - begin >= 3
+        && memcmp(m_mapData + begin, "\xef\xbb\xbf", 3) == 0)
+        begin += 3;
+
+    // Split the row into cells, double quotes are handled as in RFC 4180
+    bool quoted = false;
+    QByteArray cell;
+    for (qint64 i = begin; i < end; ++i)
     {
-        auto list = m_csvData.at(row);
-        for (int i = 1; i < list.count(); ++i)
+        const char byte = static_cast<char>(m_mapData[i]);
+        if (byte == '"')
         {
-            frame.append(list.at(i).toUtf8());
-            if (i < list.count() - 1)
-                frame.append(sep.toUtf8());
+            if (quoted && i + 1 < end && m_mapData[i + 1] == '"')
+            {
+                cell.append('"');
+                ++i;
+            }
+
             else
-                frame.append('\n');
+                quoted = !quoted;
         }
+
+        else if (byte == ',' && !quoted)
+        {
+            fields.append(QString::fromUtf8(cell));
+            cell.clear();
+        }
+
+        else if (byte != '\n' && byte != '\r')
+            cell.append(byte);
     }
+    fields.append(QString::fromUtf8(cell));
 
-    return frame;
+    // Register the row in the cache, which is bounded to keep memory usage low
+    if (m_rowCache.count() >= 64)
+        m_rowCache.clear();
+    m_rowCache.insert(row, fields);
+
+    return fields;
+}
+
+/**
+ * Returns the last frame whose timestamp is at or before the given
+ * @a msecsSinceEpoch, or -1 when the timestamp index is not available. The
+ * per-second frame map narrows the search down to the rows of a single second & a
+ * binary search resolves the exact frame, so seeking over a million-row file costs
+ * only a handful of comparisons.
+ */
+int CSV::Player::frameAtTime(const qint64 msecsSinceEpoch) const
+{
+    // Timestamp index not available, abort
+    if (m_rowTimes.count() != m_rowIndex.count() || frameCount() <= 0)
+        return -1;
+    const qint64 first = m_rowTimes.at(1);
+    if (first < 0)
+        return -1;
+
+    // Narrow the search range down with the per-second frame map
+    int begin = 1;
+    int end = m_rowTimes.count();
+    if (!m_secondIndex.isEmpty() && msecsSinceEpoch >= first)
+    {
+        const int s = qMin(static_cast<int>((msecsSinceEpoch - first) / 1000),
+                           m_secondIndex.count() - 1);
+        begin = m_secondIndex.at(s) + 1;
+        if (s + 1 < m_secondIndex.count())
+            end = qMin(end, m_secondIndex.at(s + 1) + 2);
+    }
+
+    // Binary-search the first row that is past the target time
+    const auto it = std::upper_bound(m_rowTimes.constBegin() + begin,
+                                     m_rowTimes.constBegin() + end, msecsSinceEpoch);
+    int row = static_cast<int>(it - m_rowTimes.constBegin()) - 1;
+    if (row < 1)
+        row = 1;
+
+    return row - 1;
+}
+
+/**
+ * Returns the frame that matches the given point of the timeline, resolved
+ * through the timestamp index in O(log n). Files without usable timestamps fall
+ * back to linear row arithmetic.
+ */
+int CSV::Player::frameAtProgress(const qreal progress) const
+{
+    // Map the progress fraction to a log time & binary-search the frame
+    if (m_rowTimes.count() == m_rowIndex.count() && frameCount() > 0)
+    {
+        const qint64 first = m_rowTimes.value(1, -1);
+        const qint64 last = m_rowTimes.value(m_rowTimes.count() - 1, -1);
+        if (first >= 0 && last >= first)
+        {
+            const int frame = frameAtTime(first + qRound64((last - first) * progress));
+            if (frame >= 0)
+                return frame;
+        }
+    }
+
+    // No timestamp index available, fall back to linear row arithmetic
+    return qCeil(frameCount() * progress);
 }
 
 /**
@@ -422,14 +1346,11 @@ QByteArray CSV::Player::getFrame(const int row)
  */
 QString CSV::Player::getCellValue(const int row, const int column, bool &error)
 {
-    if (m_csvData.count() > row)
+    const auto list = materializeRow(row);
+    if (list.count() > column)
     {
-        auto list = m_csvData.at(row);
-        if (list.count() > column)
-        {
-            error = false;
-            return list.at(column);
-        }
+        error = false;
+        return list.at(column);
     }
 
     error = true;
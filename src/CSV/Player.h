@@ -23,16 +23,76 @@
 #pragma once
 
 #include <QFile>
+#include <QHash>
+#include <QTimer>
 #include <QObject>
+#include <QThread>
 #include <QVector>
+#include <QVariant>
+#include <QAtomicInt>
+#include <QStringList>
+#include <QElapsedTimer>
 
 namespace CSV
 {
+/**
+ * @brief The PlayerIndexer class
+ *
+ * Worker object that scans a CSV file from a dedicated thread & registers the
+ * byte offset & RX timestamp of every row. The generated index lets the player
+ * memory-map the file, materialize only the rows around the play cursor & seek
+ * to any point of the timeline with a binary search, so opening or scrubbing a
+ * large session log is near-instant & does not require loading it into RAM.
+ *
+ * The worker also condenses the file into per-channel min/max overview strips
+ * by sampling a fixed number of evenly spaced rows, so the cost of the pass is
+ * independent of the file size (see @c buildOverview()).
+ */
+class PlayerIndexer : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void indexReady(const QString &filePath, const QVector<qint64> &rowIndex,
+                    const QVector<qint64> &rowTimes);
+    void overviewReady(const QString &filePath,
+                       const QVector<QVector<double>> &minima,
+                       const QVector<QVector<double>> &maxima);
+
+public:
+    explicit PlayerIndexer(QObject *parent = Q_NULLPTR);
+
+    void cancelIndexing();
+
+public Q_SLOTS:
+    void buildIndex(const QString &filePath);
+    void buildOverview(const QString &filePath, const QVector<qint64> &rowIndex);
+
+private:
+    QAtomicInt m_cancelled;
+};
+
 /**
  * @brief The Player class
  *
  * The CSV player class allows users to select a CSV file and "re-play" it
  * with Serial Studio.
+ *
+ * The file is memory-mapped & accessed through a row index generated by an
+ * instance of @c CSV::PlayerIndexer running on a dedicated thread, only the
+ * rows around the play cursor are materialized into strings.
+ *
+ * Once the index is ready, the indexer performs a second background pass that
+ * samples a few thousand evenly spaced rows & condenses them into per-channel
+ * min/max overview strips, which the player window renders as a thumbnail
+ * timeline above the progress bar (see @c overviewStrip()).
+ *
+ * For soak testing, playback can loop: when the cursor reaches the end of the
+ * file (or of an A-B region marked on the timeline) it wraps back to the
+ * region start. The wraparound reuses the indexed seek path, so restarting a
+ * region costs an index lookup instead of re-walking the file.
  */
 class Player : public QObject
 {
@@ -50,12 +110,33 @@ class Player : public QObject
     Q_PROPERTY(QString timestamp
                READ timestamp
                NOTIFY timestampChanged)
+    Q_PROPERTY(qreal playbackSpeed
+               READ playbackSpeed
+               WRITE setPlaybackSpeed
+               NOTIFY playbackSpeedChanged)
+    Q_PROPERTY(int overviewChannelCount
+               READ overviewChannelCount
+               NOTIFY overviewChanged)
+    Q_PROPERTY(bool loopEnabled
+               READ loopEnabled
+               WRITE setLoopEnabled
+               NOTIFY loopChanged)
+    Q_PROPERTY(qreal regionStart
+               READ regionStart
+               NOTIFY regionChanged)
+    Q_PROPERTY(qreal regionEnd
+               READ regionEnd
+               NOTIFY regionChanged)
     // clang-format on
 
 Q_SIGNALS:
     void openChanged();
+    void loopChanged();
+    void regionChanged();
+    void overviewChanged();
     void timestampChanged();
     void playerStateChanged();
+    void playbackSpeedChanged();
 
 private:
     explicit Player();
@@ -64,6 +145,8 @@ private:
     Player &operator=(Player &&) = delete;
     Player &operator=(const Player &) = delete;
 
+    ~Player();
+
 public:
     static Player &instance();
 
@@ -75,6 +158,13 @@ public:
     int framePosition() const;
     QString timestamp() const;
     QString csvFilesPath() const;
+    qreal playbackSpeed() const;
+    bool loopEnabled() const;
+    qreal regionStart() const;
+    qreal regionEnd() const;
+    int overviewChannelCount() const;
+
+    Q_INVOKABLE QVariantList overviewStrip(const int channel) const;
 
 public Q_SLOTS:
     void play();
@@ -85,20 +175,58 @@ public Q_SLOTS:
     void nextFrame();
     void previousFrame();
     void openFile(const QString &filePath);
+    void clearRegion();
     void setProgress(const qreal &progress);
+    void setPlaybackSpeed(const qreal speed);
+    void setLoopEnabled(const bool enabled);
+    void setRegionStart(const qreal progress);
+    void setRegionEnd(const qreal progress);
 
 private Q_SLOTS:
     void updateData();
+    void dispatchFrames();
+    void onIndexReady(const QString &filePath, const QVector<qint64> &rowIndex,
+                      const QVector<qint64> &rowTimes);
+    void onOverviewReady(const QString &filePath,
+                         const QVector<QVector<double>> &minima,
+                         const QVector<QVector<double>> &maxima);
 
 private:
+    void anchorPlayback();
+    void rescheduleDispatch();
+    void wrapToRegionStart();
+    int regionStartFrame() const;
+    int regionEndFrame() const;
+    int frameAtProgress(const qreal progress) const;
+    void dispatchRow(const int row);
+    qint64 targetLogTime() const;
     QByteArray getFrame(const int row);
+    QStringList materializeRow(const int row);
+    int frameAtTime(const qint64 msecsSinceEpoch) const;
     QString getCellValue(const int row, const int column, bool &error);
 
 private:
     int m_framePos;
     bool m_playing;
+    bool m_loopEnabled;
+    qreal m_regionStart;
+    qreal m_regionEnd;
     QFile m_csvFile;
     QString m_timestamp;
-    QVector<QVector<QString>> m_csvData;
+    qreal m_playbackSpeed;
+    QTimer m_paceTimer;
+    QElapsedTimer m_paceClock;
+    qint64 m_anchorLogMsecs;
+    qint64 m_anchorWallNsecs;
+    qint64 m_mapSize;
+    const uchar *m_mapData;
+    QVector<qint64> m_rowIndex;
+    QVector<qint64> m_rowTimes;
+    QVector<int> m_secondIndex;
+    QVector<QVector<double>> m_overviewMin;
+    QVector<QVector<double>> m_overviewMax;
+    QHash<int, QStringList> m_rowCache;
+    QThread m_indexerThread;
+    PlayerIndexer *m_indexer;
 };
 }
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QtEndian>
+#include <QDateTime>
+#include <QApplication>
+
+#include <IO/Capture.h>
+#include <IO/Manager.h>
+#include <Misc/Clock.h>
+
+/*
+ * Size of each capture file segment
+ */
+static const qint64 SEGMENT_SIZE = 64 * 1024 * 1024;
+
+//----------------------------------------------------------------------------------------
+// Capture writer (runs on a dedicated thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, capture records are read from the given @a queue, which is owned
+ * by the capture module.
+ */
+IO::CaptureWriter::CaptureWriter(FrameQueue *queue, QObject *parent)
+    : QObject(parent)
+    , m_offset(0)
+    , m_mappedData(Q_NULLPTR)
+    , m_segmentIndex(0)
+    , m_queue(queue)
+{
+}
+
+/**
+ * Writes all the pending capture records & closes the current capture file. The next
+ * record shall start a fresh capture (new base name & segment index).
+ */
+void IO::CaptureWriter::closeFile()
+{
+    writeQueuedData();
+    closeSegment();
+
+    m_baseName.clear();
+    m_segmentIndex = 0;
+}
+
+/**
+ * Drains the capture queue & appends every record to the current segment. This function
+ * is called through a queued connection whenever the capture module pushes new data, the
+ * wake-up events are coalesced by the event loop so a burst costs (at most) one slot
+ * invocation per queued batch.
+ */
+void IO::CaptureWriter::writeQueuedData()
+{
+    QByteArray record;
+    while (m_queue->dequeue(record))
+        writeRecord(record);
+}
+
+/**
+ * Creates & memory-maps the next capture file segment. The first segment of a capture
+ * session defines the base path & file name (derived from the current date/time).
+ */
+bool IO::CaptureWriter::openSegment()
+{
+    // First segment of the session, generate base path & file name
+    if (m_baseName.isEmpty())
+    {
+        auto dateTime = QDateTime::currentDateTime();
+        m_baseName = dateTime.toString("HH-mm-ss");
+
+        // clang-format off
+        const QString format = dateTime.toString("yyyy/MMM/dd/");
+        m_basePath = QString("%1/Documents/%2/Captures/%3").arg(QDir::homePath(),
+                                                                qApp->applicationName(),
+                                                                format);
+        // clang-format on
+
+        // Generate file path if required
+        QDir dir(m_basePath);
+        if (!dir.exists())
+            dir.mkpath(".");
+    }
+
+    // Generate segment file name (e.g. "14-32-05-000.bin")
+    // clang-format off
+    const QString fileName = QString("%1-%2.bin").arg(
+        m_baseName, QString::number(m_segmentIndex).rightJustified(3, '0'));
+    // clang-format on
+
+    // Open & pre-size the segment file
+    m_file.setFileName(QDir(m_basePath).filePath(fileName));
+    if (!m_file.open(QIODevice::ReadWrite))
+        return false;
+    if (!m_file.resize(SEGMENT_SIZE))
+    {
+        m_file.close();
+        return false;
+    }
+
+    // Map the segment into memory, appends become plain memcpy calls. If mapping
+    // fails (e.g. network filesystem), fall back to buffered writes.
+    m_offset = 0;
+    m_mappedData = m_file.map(0, SEGMENT_SIZE);
+    return true;
+}
+
+/**
+ * Truncates the current segment to its used size & closes it
+ */
+void IO::CaptureWriter::closeSegment()
+{
+    if (m_file.isOpen())
+    {
+        if (m_mappedData)
+        {
+            m_file.unmap(m_mappedData);
+            m_mappedData = Q_NULLPTR;
+        }
+
+        m_file.resize(m_offset);
+        m_file.close();
+        m_offset = 0;
+    }
+}
+
+/**
+ * Appends the given @a record to the current segment, rotating to the next segment when
+ * the current one is full.
+ */
+void IO::CaptureWriter::writeRecord(const QByteArray &record)
+{
+    // Open the first segment on demand
+    if (!m_file.isOpen() && !openSegment())
+        return;
+
+    // Segment full, rotate to the next one
+    if (m_offset + record.size() > SEGMENT_SIZE)
+    {
+        closeSegment();
+        ++m_segmentIndex;
+        if (!openSegment())
+            return;
+    }
+
+    // Append the record to the mapped segment (or fall back to buffered writes)
+    if (m_mappedData && m_offset + record.size() <= SEGMENT_SIZE)
+        memcpy(m_mappedData + m_offset, record.constData(), record.size());
+    else
+    {
+        m_file.seek(m_offset);
+        m_file.write(record);
+    }
+
+    m_offset += record.size();
+}
+
+//----------------------------------------------------------------------------------------
+// Capture module (runs on the GUI thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, starts the writer thread & connects the capture module to the
+ * I/O manager.
+ */
+IO::Capture::Capture()
+    : m_captureEnabled(false)
+    , m_captureQueue(8192)
+    , m_writer(Q_NULLPTR)
+{
+    // Move the capture writer to a dedicated thread, slow storage must never block
+    // the data path
+    m_writer = new CaptureWriter(&m_captureQueue);
+    m_writer->moveToThread(&m_writerThread);
+    connect(&m_writerThread, &QThread::finished, m_writer, &QObject::deleteLater);
+    connect(this, &IO::Capture::dataQueued, m_writer, &CaptureWriter::writeQueuedData,
+            Qt::QueuedConnection);
+    m_writerThread.start(QThread::LowPriority);
+
+    // Configure signals/slots
+    auto io = &IO::Manager::instance();
+    connect(io, &IO::Manager::dataReceived, this, &Capture::onDataReceived);
+    connect(io, &IO::Manager::connectedChanged, this, &Capture::onConnectedChanged);
+}
+
+/**
+ * Destructor function, closes the capture file & stops the writer thread
+ */
+IO::Capture::~Capture()
+{
+    closeFile();
+    m_writerThread.quit();
+    m_writerThread.wait();
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Capture &IO::Capture::instance()
+{
+    static Capture singleton;
+    return singleton;
+}
+
+/**
+ * Returns @c true if the raw byte stream shall be archived to disk
+ */
+bool IO::Capture::captureEnabled() const
+{
+    return m_captureEnabled;
+}
+
+/**
+ * Writes all pending capture records & closes the current capture file. The writer is
+ * invoked through a blocking queued connection, so the capture file is guaranteed to be
+ * complete when this function returns.
+ */
+void IO::Capture::closeFile()
+{
+    QMetaObject::invokeMethod(m_writer, "closeFile", Qt::BlockingQueuedConnection);
+}
+
+/**
+ * Enables or disables raw data capture
+ */
+void IO::Capture::setCaptureEnabled(const bool enabled)
+{
+    m_captureEnabled = enabled;
+    Q_EMIT enabledChanged();
+
+    if (!captureEnabled())
+        closeFile();
+}
+
+/**
+ * Closes the capture file when the device is disconnected, the next connection shall
+ * start a fresh capture.
+ */
+void IO::Capture::onConnectedChanged()
+{
+    if (!IO::Manager::instance().connected())
+        closeFile();
+}
+
+/**
+ * Timestamps the given @a data, serializes the capture record & pushes it into the
+ * writer queue. This function runs on the GUI thread as part of the data path, so it
+ * only performs one allocation & one copy, disk I/O happens on the writer thread.
+ */
+void IO::Capture::onDataReceived(const QByteArray &data)
+{
+    // Ignore if capture is disabled or if no device is connected
+    if (!captureEnabled() || !IO::Manager::instance().connected())
+        return;
+
+    // Serialize the record header (timestamp + payload length)
+    QByteArray record;
+    record.resize(12);
+    const quint64 timestamp = Misc::Clock::instance().currentMSecsSinceEpoch();
+    qToLittleEndian<quint64>(timestamp, reinterpret_cast<uchar *>(record.data()));
+    qToLittleEndian<quint32>(data.size(), reinterpret_cast<uchar *>(record.data()) + 8);
+
+    // Append the payload & queue the record for the writer thread
+    record.append(data);
+    m_captureQueue.enqueue(record);
+    Q_EMIT dataQueued();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Capture.cpp"
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QObject>
+#include <QThread>
+#include <QString>
+
+#include <IO/FrameQueue.h>
+
+namespace IO
+{
+/**
+ * @brief The CaptureWriter class
+ *
+ * Worker object that appends capture records to disk from a dedicated writer
+ * thread. Capture files are split into fixed-size segments, each segment is
+ * memory-mapped while it is being written so appending a record is a plain
+ * @c memcpy with no syscall on the hot path. When a segment fills up (or the
+ * capture is closed), it is truncated to its used size & the next segment is
+ * opened.
+ *
+ * Each record consists of:
+ * - A 64-bit little-endian arrival timestamp (msecs since the Unix epoch)
+ * - A 32-bit little-endian payload length
+ * - The raw payload bytes
+ */
+class CaptureWriter : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+public:
+    explicit CaptureWriter(FrameQueue *queue, QObject *parent = Q_NULLPTR);
+
+public Q_SLOTS:
+    void closeFile();
+    void writeQueuedData();
+
+private:
+    bool openSegment();
+    void closeSegment();
+    void writeRecord(const QByteArray &record);
+
+private:
+    QFile m_file;
+    qint64 m_offset;
+    uchar *m_mappedData;
+    int m_segmentIndex;
+    QString m_basePath;
+    QString m_baseName;
+    FrameQueue *m_queue;
+};
+
+/**
+ * @brief The Capture class
+ *
+ * The capture module archives the raw byte stream received from the device
+ * (plus arrival timestamps) so that parser bugs & device issues can be
+ * analyzed post-mortem. Incoming data is timestamped on arrival & pushed into
+ * a lock-free queue, an instance of @c IO::CaptureWriter running on a
+ * dedicated thread drains the queue & appends the records to a segmented
+ * capture file. In this way, slow storage never blocks the data path.
+ */
+class Capture : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(bool captureEnabled
+               READ captureEnabled
+               WRITE setCaptureEnabled
+               NOTIFY enabledChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void dataQueued();
+    void enabledChanged();
+
+private:
+    explicit Capture();
+    Capture(Capture &&) = delete;
+    Capture(const Capture &) = delete;
+    Capture &operator=(Capture &&) = delete;
+    Capture &operator=(const Capture &) = delete;
+
+    ~Capture();
+
+public:
+    static Capture &instance();
+
+    bool captureEnabled() const;
+
+public Q_SLOTS:
+    void closeFile();
+    void setCaptureEnabled(const bool enabled);
+
+private Q_SLOTS:
+    void onConnectedChanged();
+    void onDataReceived(const QByteArray &data);
+
+private:
+    bool m_captureEnabled;
+    FrameQueue m_captureQueue;
+    QThread m_writerThread;
+    CaptureWriter *m_writer;
+};
+}
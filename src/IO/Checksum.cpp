@@ -20,54 +20,172 @@
  * THE SOFTWARE.
  */
 
+#include <cstring>
+
+#include <QtEndian>
+
 #include <IO/Checksum.h>
 
-uint8_t IO::crc8(const char *data, const int length)
+//
+// Table-driven CRC kernels. The lookup tables are generated at compile time by
+// the constexpr template below, parameterized on the polynomial & bit order,
+// so adding a CRC variant costs one typedef & zero runtime table construction.
+// The initial state & final xor of each variant live in the (trivial) kernel
+// functions, the tables themselves only depend on the polynomial.
+//
+
+namespace
 {
-    uint8_t crc = 0xff;
-    for (int i = 0; i < length; i++)
+/**
+ * Compile-time generated 256-entry CRC lookup table. @a Reflected selects the
+ * bit order of the algorithm: @c false for MSB-first variants (polynomial in
+ * normal notation, e.g. CRC-16/CCITT-FALSE with 0x1021), @c true for LSB-first
+ * variants (polynomial in reflected notation, e.g. CRC-16/MODBUS with 0xA001).
+ */
+template <typename T, T Polynomial, bool Reflected>
+struct CrcTable
+{
+    T at[256];
+
+    constexpr CrcTable()
+        : at {}
     {
-        crc ^= data[i];
-        for (int j = 0; j < 8; j++)
+        const T topBit = (T)((T)1 << (sizeof(T) * 8 - 1));
+        for (int i = 0; i < 256; ++i)
         {
-            if ((crc & 0x80) != 0)
-                crc = (uint8_t)((crc << 1) ^ 0x31);
+            if (Reflected)
+            {
+                T crc = (T)i;
+                for (int j = 0; j < 8; ++j)
+                    crc = (crc & 1) ? (T)((crc >> 1) ^ Polynomial) : (T)(crc >> 1);
+
+                at[i] = crc;
+            }
+
             else
-                crc <<= 1;
+            {
+                T crc = (T)((T)i << (sizeof(T) * 8 - 8));
+                for (int j = 0; j < 8; ++j)
+                    crc = (crc & topBit) ? (T)((crc << 1) ^ Polynomial) : (T)(crc << 1);
+
+                at[i] = crc;
+            }
         }
     }
+};
+
+//
+// Slice-by-8 tables for CRC-32, eight bytes are combined per iteration of the
+// main loop instead of one. See "A Systematic Approach to Building High
+// Performance Software-Based CRC Generators" (Kounavis & Berry) for the
+// construction. Derived at compile time from the byte-at-a-time table.
+//
+struct Crc32Tables
+{
+    uint32_t at[8][256];
 
-    return crc;
+    constexpr Crc32Tables()
+        : at {}
+    {
+        const CrcTable<uint32_t, 0xEDB88320, true> base;
+        for (int i = 0; i < 256; ++i)
+            at[0][i] = base.at[i];
+
+        for (int k = 1; k < 8; ++k)
+        {
+            for (int i = 0; i < 256; ++i)
+                at[k][i] = (at[k - 1][i] >> 8) ^ at[0][at[k - 1][i] & 0xff];
+        }
+    }
+};
+}
+
+static constexpr CrcTable<uint8_t, 0x31, false> CRC8_TABLE;
+static constexpr CrcTable<uint16_t, 0x1021, false> CRC16_TABLE;
+static constexpr CrcTable<uint16_t, 0xA001, true> CRC16_MODBUS_TABLE;
+static constexpr Crc32Tables CRC32_TABLES;
+
+uint8_t IO::crc8(const char *data, const int length)
+{
+    return crc8Update(0xff, data, length);
 }
 
 uint16_t IO::crc16(const char *data, const int length)
 {
-    uint8_t x;
-    uint16_t crc = 0xFFFF;
+    return crc16Update(0xFFFF, data, length);
+}
+
+uint16_t IO::crc16Modbus(const char *data, const int length)
+{
+    return crc16ModbusUpdate(0xFFFF, data, length);
+}
 
+uint32_t IO::crc32(const char *data, const int length)
+{
+    return ~crc32Update(0xFFFFFFFF, data, length);
+}
+
+uint8_t IO::crc8Update(const uint8_t crc, const char *data, const int length)
+{
+    uint8_t state = crc;
+    for (int i = 0; i < length; i++)
+        state = CRC8_TABLE.at[state ^ (uint8_t)data[i]];
+
+    return state;
+}
+
+uint16_t IO::crc16Update(const uint16_t crc, const char *data, const int length)
+{
+    uint16_t state = crc;
     for (int i = 0; i < length; ++i)
-    {
-        x = crc >> 8 ^ data[i];
-        x ^= x >> 4;
-        crc = (crc << 8) ^ ((uint16_t)(x << 12)) ^ ((uint16_t)(x << 5)) ^ ((uint16_t)x);
-    }
+        state = (uint16_t)((state << 8) ^ CRC16_TABLE.at[(state >> 8) ^ (uint8_t)data[i]]);
 
-    return crc;
+    return state;
 }
 
-uint32_t IO::crc32(const char *data, const int length)
+uint16_t IO::crc16ModbusUpdate(const uint16_t crc, const char *data, const int length)
 {
-    uint32_t mask;
-    uint32_t crc = 0xFFFFFFFF;
+    uint16_t state = crc;
     for (int i = 0; i < length; ++i)
+        state = (uint16_t)((state >> 8)
+                           ^ CRC16_MODBUS_TABLE.at[(state ^ (uint8_t)data[i]) & 0xff]);
+
+    return state;
+}
+
+uint32_t IO::crc32Update(const uint32_t crc, const char *data, const int length)
+{
+    auto bytes = length;
+    auto cursor = data;
+    uint32_t state = crc;
+
+    // Main loop, fold eight bytes per iteration through the slice tables
+    while (bytes >= 8)
     {
-        crc = crc ^ data[i];
-        for (int j = 8; j >= 0; j--)
-        {
-            mask = -(crc & 1);
-            crc = (crc >> 1) ^ (0xEDB88320 & mask);
-        }
+        uint32_t lo, hi;
+        memcpy(&lo, cursor, sizeof(lo));
+        memcpy(&hi, cursor + 4, sizeof(hi));
+        lo = qFromLittleEndian(lo) ^ state;
+        hi = qFromLittleEndian(hi);
+
+        // clang-format off
+        state = CRC32_TABLES.at[7][(lo      ) & 0xff]
+            ^ CRC32_TABLES.at[6][(lo >>  8) & 0xff]
+            ^ CRC32_TABLES.at[5][(lo >> 16) & 0xff]
+            ^ CRC32_TABLES.at[4][(lo >> 24) & 0xff]
+            ^ CRC32_TABLES.at[3][(hi      ) & 0xff]
+            ^ CRC32_TABLES.at[2][(hi >>  8) & 0xff]
+            ^ CRC32_TABLES.at[1][(hi >> 16) & 0xff]
+            ^ CRC32_TABLES.at[0][(hi >> 24) & 0xff];
+        // clang-format on
+
+        cursor += 8;
+        bytes -= 8;
     }
 
-    return ~crc;
+    // Process the remaining bytes one at a time
+    while (bytes-- > 0)
+        state = (state >> 8) ^ CRC32_TABLES.at[0][(state ^ (uint8_t)*cursor++) & 0xff];
+
+    return state;
 }
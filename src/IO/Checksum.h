@@ -27,7 +27,25 @@
 
 namespace IO
 {
+//
+// Default variants: crc8() is poly 0x31/init 0xff, crc16() is CRC-16/CCITT-FALSE
+// (poly 0x1021, init 0xffff) & crc32() is the reflected IEEE 802.3 polynomial.
+// crc16Modbus() implements CRC-16/MODBUS (reflected poly 0xA001, init 0xffff)
+// as used by Modbus-derived firmware.
+//
 uint8_t crc8(const char *data, const int length);
 uint16_t crc16(const char *data, const int length);
+uint16_t crc16Modbus(const char *data, const int length);
 uint32_t crc32(const char *data, const int length);
+
+//
+// Streaming variants, the CRC state can be carried across several calls so that
+// checksums are computed incrementally as data arrives. Initial states are 0xff,
+// 0xffff & 0xffffffff respectively, the CRC-32 state must be inverted (~) once
+// all the data has been processed.
+//
+uint8_t crc8Update(const uint8_t crc, const char *data, const int length);
+uint16_t crc16Update(const uint16_t crc, const char *data, const int length);
+uint16_t crc16ModbusUpdate(const uint16_t crc, const char *data, const int length);
+uint32_t crc32Update(const uint32_t crc, const char *data, const int length);
 }
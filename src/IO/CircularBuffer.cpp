@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstring>
+
+#include <IO/CircularBuffer.h>
+
+/**
+ * Constructor function, allocates the backing storage for the given @a capacity
+ */
+IO::CircularBuffer::CircularBuffer(const int capacity)
+    : m_head(0)
+    , m_size(0)
+{
+    m_buffer.resize(qMax(1, capacity));
+}
+
+/**
+ * Returns the number of bytes currently stored in the buffer
+ */
+int IO::CircularBuffer::size() const
+{
+    return m_size;
+}
+
+/**
+ * Returns the maximum number of bytes that the buffer can hold
+ */
+int IO::CircularBuffer::capacity() const
+{
+    return m_buffer.size();
+}
+
+/**
+ * Discards all the data stored in the buffer (storage is kept allocated)
+ */
+void IO::CircularBuffer::clear()
+{
+    m_head = 0;
+    m_size = 0;
+}
+
+/**
+ * Consumes the given number of @a bytes by advancing the read index
+ */
+void IO::CircularBuffer::skip(const int bytes)
+{
+    auto count = qMin(bytes, m_size);
+    m_head = (m_head + count) % capacity();
+    m_size -= count;
+}
+
+/**
+ * Changes the maximum number of bytes that the buffer can hold. Any data stored in the
+ * buffer is discarded, this function is only meant to be called while disconnected.
+ */
+void IO::CircularBuffer::setCapacity(const int capacity)
+{
+    m_head = 0;
+    m_size = 0;
+    m_buffer.resize(qMax(1, capacity));
+}
+
+/**
+ * Changes the maximum number of bytes that the buffer can hold while keeping the data
+ * stored in it. If the new capacity is smaller than the current byte count, the oldest
+ * bytes are dropped. Logical positions are preserved for data that survives the resize
+ * (the caller shall shift its positions by the number of dropped bytes, exactly as it
+ * does when @c append() overflows).
+ */
+void IO::CircularBuffer::resizePreserving(const int capacity)
+{
+    auto count = qMax(1, capacity);
+    if (count == this->capacity())
+        return;
+
+    // Drop the oldest bytes if the data does not fit in the new storage
+    if (m_size > count)
+        skip(m_size - count);
+
+    // Linearize the remaining data into the new storage
+    QByteArray buffer;
+    buffer.resize(count);
+    auto firstChunk = qMin(m_size, this->capacity() - m_head);
+    memcpy(buffer.data(), m_buffer.constData() + m_head, firstChunk);
+    if (m_size > firstChunk)
+        memcpy(buffer.data() + firstChunk, m_buffer.constData(), m_size - firstChunk);
+
+    m_head = 0;
+    m_buffer = buffer;
+}
+
+/**
+ * Appends the given @a data to the buffer. If the buffer does not have enough free
+ * space, the oldest bytes are dropped to make room for the new data.
+ */
+void IO::CircularBuffer::append(const QByteArray &data)
+{
+    // Data larger than the whole buffer, only keep the tail
+    auto offset = 0;
+    auto length = data.size();
+    if (length > capacity())
+    {
+        offset = length - capacity();
+        length = capacity();
+    }
+
+    // Drop oldest bytes to make room for the incoming data
+    if (m_size + length > capacity())
+        skip(m_size + length - capacity());
+
+    // Copy the data in (at most) two linear chunks
+    auto tail = (m_head + m_size) % capacity();
+    auto firstChunk = qMin(length, capacity() - tail);
+    memcpy(m_buffer.data() + tail, data.constData() + offset, firstChunk);
+    if (length > firstChunk)
+        memcpy(m_buffer.data(), data.constData() + offset + firstChunk,
+               length - firstChunk);
+
+    // Update byte count
+    m_size += length;
+}
+
+/**
+ * Returns the byte stored at the given logical @a index
+ */
+char IO::CircularBuffer::at(const int index) const
+{
+    return m_buffer.at((m_head + index) % capacity());
+}
+
+/**
+ * Copies @a length bytes starting at logical position @a pos into a new byte array.
+ * The requested range is clamped to the data available in the buffer.
+ */
+QByteArray IO::CircularBuffer::peek(const int pos, const int length) const
+{
+    // Clamp requested range
+    auto start = qBound(0, pos, m_size);
+    auto count = qBound(0, length, m_size - start);
+
+    // Copy the data out in (at most) two linear chunks
+    QByteArray data;
+    data.resize(count);
+    auto physical = (m_head + start) % capacity();
+    auto firstChunk = qMin(count, capacity() - physical);
+    memcpy(data.data(), m_buffer.constData() + physical, firstChunk);
+    if (count > firstChunk)
+        memcpy(data.data() + firstChunk, m_buffer.constData(), count - firstChunk);
+
+    return data;
+}
+
+/**
+ * Returns a pointer to the storage that backs the byte at logical position @a pos and
+ * writes the number of contiguous bytes available from that position into @a maxLength.
+ * Callers that walk the whole buffer shall call this function (at most) twice.
+ */
+const char *IO::CircularBuffer::linearData(const int pos, int *maxLength) const
+{
+    if (pos < 0 || pos >= m_size)
+    {
+        *maxLength = 0;
+        return Q_NULLPTR;
+    }
+
+    auto physical = (m_head + pos) % capacity();
+    *maxLength = qMin(m_size - pos, capacity() - physical);
+    return m_buffer.constData() + physical;
+}
+
+/**
+ * Returns the logical position of the first occurrence of @a pattern at (or after) the
+ * given @a from position, or -1 if the pattern is not present in the buffer.
+ */
+int IO::CircularBuffer::indexOf(const QByteArray &pattern, const int from) const
+{
+    auto pLen = pattern.size();
+    if (pLen <= 0 || from < 0)
+        return -1;
+
+    for (int i = from; i + pLen <= m_size; ++i)
+    {
+        int j = 0;
+        while (j < pLen && at(i + j) == pattern.at(j))
+            ++j;
+
+        if (j == pLen)
+            return i;
+    }
+
+    return -1;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+namespace IO
+{
+/**
+ * @brief The CircularBuffer class
+ *
+ * Fixed-capacity circular byte buffer used by the frame reader to hold incoming
+ * device data. Frames are located by logical offset and consumed by advancing
+ * the read index, so scanning for delimiters never reallocates or shifts the
+ * remaining data around in memory; the only copy that ever takes place is the
+ * extraction of a finished frame payload.
+ *
+ * When the buffer is full, appending new data silently drops the oldest bytes,
+ * which replicates the "clear temp. buffer on overflow" policy of previous
+ * implementations without throwing away the most recent (and most likely still
+ * incomplete) frame.
+ */
+class CircularBuffer
+{
+public:
+    CircularBuffer(const int capacity = 1024 * 1024);
+
+    int size() const;
+    int capacity() const;
+
+    void clear();
+    void skip(const int bytes);
+    void setCapacity(const int capacity);
+    void resizePreserving(const int capacity);
+    void append(const QByteArray &data);
+
+    char at(const int index) const;
+    QByteArray peek(const int pos, const int length) const;
+    int indexOf(const QByteArray &pattern, const int from = 0) const;
+    const char *linearData(const int pos, int *maxLength) const;
+
+private:
+    int m_head;
+    int m_size;
+    QByteArray m_buffer;
+};
+}
@@ -23,55 +23,95 @@
 #include <QFile>
 #include <QPrinter>
 #include <QDateTime>
+#include <QDataStream>
 #include <QFileDialog>
 #include <QPrintDialog>
 #include <QTextDocument>
 
 #include <IO/Manager.h>
 #include <IO/Console.h>
+#include <Misc/Clock.h>
 #include <Misc/Utilities.h>
 #include <Misc/TimerEvents.h>
+#include <Misc/MemoryRegistry.h>
+#include <Misc/Watchdog.h>
+
+/*
+ * Capacity (in characters) of the console text ring, the console only keeps the
+ * most recent characters for exporting/printing & discards the oldest ones
+ */
+static const int TEXT_BUFFER_SIZE = 1024 * 1024;
 
 /**
  * Generates a hexdump of the given data
  */
-static QString HexDump(const char *data, const size_t size)
+static QString HexDump(const char *data, const int size)
 {
-    char str[4096] = "";
-    char ascii[17];
+    // Build the byte -> two hex characters lookup table on first use
+    static char lookup[256][2];
+    static bool initialized = false;
+    if (!initialized)
+    {
+        static const char digits[] = "0123456789ABCDEF";
+        for (int i = 0; i < 256; ++i)
+        {
+            lookup[i][0] = digits[(i >> 4) & 0x0F];
+            lookup[i][1] = digits[i & 0x0F];
+        }
 
-    size_t i, j;
+        initialized = true;
+    }
+
+    // Preallocate the output buffer, every (possibly partial) 16-byte row
+    // expands to at most 71 characters
+    QByteArray str;
+    str.reserve(((size + 15) / 16) * 71);
+
+    // Process the data in 16-byte rows
+    char ascii[17];
     ascii[16] = '\0';
-    for (i = 0; i < size; ++i)
+    for (int i = 0; i < size; ++i)
     {
-        sprintf(str + strlen(str), "%02X ", static_cast<quint8>(data[i]));
-
-        if (data[i] >= ' ' && data[i] <= '~')
-            ascii[i % 16] = data[i];
+        // Append the two hex characters of the byte
+        const auto byte = static_cast<quint8>(data[i]);
+        str.append(lookup[byte], 2);
+        str.append(' ');
+
+        // Register the ASCII representation of the byte
+        if (byte >= ' ' && byte <= '~')
+            ascii[i % 16] = static_cast<char>(byte);
         else
             ascii[i % 16] = '.';
 
+        // Append the ASCII column at the end of every row & pad the last
+        // (possibly incomplete) row of the hexdump
         if ((i + 1) % 8 == 0 || i + 1 == size)
         {
-            sprintf(str + strlen(str), " ");
+            str.append(' ');
             if ((i + 1) % 16 == 0)
-                sprintf(str + strlen(str), "|  %s \n", ascii);
+            {
+                str.append("|  ");
+                str.append(ascii, 16);
+                str.append(" \n");
+            }
 
             else if (i + 1 == size)
             {
                 ascii[(i + 1) % 16] = '\0';
 
                 if ((i + 1) % 16 <= 8)
-                    sprintf(str + strlen(str), " ");
-                for (j = (i + 1) % 16; j < 16; ++j)
-                    sprintf(str + strlen(str), "   ");
+                    str.append(' ');
+                for (int j = (i + 1) % 16; j < 16; ++j)
+                    str.append("   ");
 
-                sprintf(str + strlen(str), "|  %s \n", ascii);
+                str.append("|  ");
+                str.append(ascii);
+                str.append(" \n");
             }
         }
     }
 
-    return QString(str);
+    return QString::fromLatin1(str);
 }
 
 /**
@@ -81,11 +121,16 @@ IO::Console::Console()
     : m_dataMode(DataMode::DataUTF8)
     , m_lineEnding(LineEnding::NoLineEnding)
     , m_displayMode(DisplayMode::DisplayPlainText)
+    , m_textHead(0)
+    , m_textLength(0)
     , m_historyItem(0)
     , m_echo(false)
     , m_autoscroll(true)
     , m_showTimestamp(false)
     , m_isStartingLine(true)
+    , m_totalChars(0)
+    , m_busy(false)
+    , m_exporter(Q_NULLPTR)
 {
     // Clear buffer & reserve memory
     clear();
@@ -94,6 +139,38 @@ IO::Console::Console()
     auto dm = &Manager::instance();
     connect(dm, &Manager::dataSent, this, &IO::Console::onDataSent);
     connect(dm, &Manager::dataReceived, this, &IO::Console::onDataReceived);
+
+    // Announce the appended text to the user interface at most once per UI
+    // tick, a device that sends thousands of chunks per second would
+    // otherwise cross the signal/slot machinery once per chunk
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi,
+            this, &IO::Console::flushPendingText);
+
+    // Register printer pointer type so that it can cross thread boundaries
+    qRegisterMetaType<QPrinter *>("QPrinter*");
+
+    // Create export worker & move it to its own thread, slow file/print jobs
+    // are queued on the worker so that the UI thread never blocks on them
+    m_exporter = new ConsoleExporter;
+    m_exporter->moveToThread(&m_exporterThread);
+    connect(&m_exporterThread, &QThread::finished, m_exporter,
+            &QObject::deleteLater);
+    connect(m_exporter, &ConsoleExporter::finished, this,
+            &IO::Console::onExporterFinished, Qt::QueuedConnection);
+    connect(m_exporter, &ConsoleExporter::saveFailed, this,
+            &IO::Console::onSaveFailed, Qt::QueuedConnection);
+    connect(m_exporter, &ConsoleExporter::saveFinished, this,
+            &IO::Console::onSaveFinished, Qt::QueuedConnection);
+    m_exporterThread.start(QThread::LowPriority);
+}
+
+/**
+ * Destructor function, stops the export worker thread
+ */
+IO::Console::~Console()
+{
+    m_exporterThread.quit();
+    m_exporterThread.wait();
 }
 
 /**
@@ -105,6 +182,15 @@ IO::Console &IO::Console::instance()
     return singleton;
 }
 
+/**
+ * Returns @c true while the export worker is saving or printing the console
+ * output, the QML interface uses this flag to disable the export actions.
+ */
+bool IO::Console::busy() const
+{
+    return m_busy;
+}
+
 /**
  * Returns @c true if the console shall display the commands that the user has sent
  * to the serial/network device.
@@ -128,7 +214,16 @@ bool IO::Console::autoscroll() const
  */
 bool IO::Console::saveAvailable() const
 {
-    return m_textBuffer.length() > 0;
+    return m_textLength > 0;
+}
+
+/**
+ * Returns all the text that is currently retained by the console scrollback buffer,
+ * older data is discarded automatically once the buffer reaches its maximum capacity.
+ */
+QString IO::Console::text() const
+{
+    return bufferText();
 }
 
 /**
@@ -256,12 +351,16 @@ QString IO::Console::formatUserHex(const QString &text)
 }
 
 /**
- * Allows the user to export the information displayed on the console
+ * Allows the user to export the information displayed on the console.
+ *
+ * The file dialog runs on the UI thread, while the actual encoding & disk
+ * writes are queued on the export worker so that the interface stays
+ * responsive while a large scrollback buffer is written out.
  */
 void IO::Console::save()
 {
-    // No data buffer received, abort
-    if (!saveAvailable())
+    // No data buffer received or a previous export still running, abort
+    if (!saveAvailable() || busy())
         return;
 
     // Get file name
@@ -269,19 +368,14 @@ void IO::Console::save()
         = QFileDialog::getSaveFileName(Q_NULLPTR, tr("Export console data"),
                                        QDir::homePath(), tr("Text files") + " (*.txt)");
 
-    // Create file
+    // Snapshot the console text & write the file from the worker thread
     if (!path.isEmpty())
     {
-        QFile file(path);
-        if (file.open(QFile::WriteOnly))
-        {
-            file.write(m_textBuffer.toUtf8());
-            file.close();
-            Misc::Utilities::revealFile(path);
-        }
-
-        else
-            Misc::Utilities::showMessageBox(tr("File save error"), file.errorString());
+        m_busy = true;
+        Q_EMIT busyChanged();
+        QMetaObject::invokeMethod(m_exporter, "saveToFile", Qt::QueuedConnection,
+                                  Q_ARG(QString, path),
+                                  Q_ARG(QString, bufferText()));
     }
 }
 
@@ -290,9 +384,16 @@ void IO::Console::save()
  */
 void IO::Console::clear()
 {
-    m_textBuffer.clear();
-    m_textBuffer.reserve(10 * 1000);
+    // Allocate the text ring once, clearing only resets the head & length
+    if (m_textBuffer.length() != TEXT_BUFFER_SIZE)
+        m_textBuffer.resize(TEXT_BUFFER_SIZE);
+
+    m_textHead = 0;
+    m_textLength = 0;
+    m_totalChars = 0;
+    m_lineOffsets.clear();
     m_isStartingLine = true;
+    m_pendingUiText.clear();
     Q_EMIT dataReceived();
 }
 
@@ -386,32 +487,40 @@ void IO::Console::setEcho(const bool enabled)
  * Creates a text document with current console output & prints it using native
  * system libraries/toolkits.
  *
+ * The print dialog runs on the UI thread, while the document layout & the
+ * actual printing (which can take several seconds for a full scrollback
+ * buffer) are performed by the export worker. Painting on a @c QPrinter is
+ * explicitly supported outside of the GUI thread by Qt.
+ *
  * @param fontFamily the font family to use to render the text document
  */
 void IO::Console::print(const QString &fontFamily)
 {
-    // Get document font (specified by QML ui)
-    QFont font;
-    font.setPointSize(10);
-    font.setFamily(fontFamily);
-
-    // Create text document
-    QTextDocument document;
-    document.setDefaultFont(font);
-    document.setPlainText(m_textBuffer);
+    // A previous export/print job is still running, abort
+    if (busy())
+        return;
 
-    // Create printer object
-    QPrinter printer(QPrinter::PrinterResolution);
-    printer.setFullPage(true);
-    printer.setDocName(qApp->applicationName());
-    printer.setPageOrientation(QPageLayout::Portrait);
+    // Create printer object, ownership is passed to the export worker once
+    // the user accepts the print dialog
+    auto printer = new QPrinter(QPrinter::PrinterResolution);
+    printer->setFullPage(true);
+    printer->setDocName(qApp->applicationName());
+    printer->setPageOrientation(QPageLayout::Portrait);
 
     // Show print dialog
-    QPrintDialog printDialog(&printer, Q_NULLPTR);
+    QPrintDialog printDialog(printer, Q_NULLPTR);
     if (printDialog.exec() == QDialog::Accepted)
     {
-        document.print(&printer);
+        m_busy = true;
+        Q_EMIT busyChanged();
+        QMetaObject::invokeMethod(m_exporter, "printDocument",
+                                  Qt::QueuedConnection, Q_ARG(QPrinter *, printer),
+                                  Q_ARG(QString, bufferText()),
+                                  Q_ARG(QString, fontFamily));
     }
+
+    else
+        delete printer;
 }
 
 /**
@@ -466,9 +575,58 @@ void IO::Console::setDisplayMode(const IO::Console::DisplayMode &mode)
     Q_EMIT displayModeChanged();
 }
 
+/**
+ * Returns the "HH:mm:ss.zzz -> " timestamp prefix for the current time.
+ *
+ * @c QDateTime::toString() is far too expensive to run for every received
+ * line, so the hours/minutes/seconds part is only re-formatted when the
+ * second actually changes & the milliseconds are appended by hand. Lines
+ * arriving within the same millisecond reuse the previous string untouched.
+ */
+static const QString &Timestamp()
+{
+    static qint64 cachedMsec = -1;
+    static qint64 cachedSecond = -1;
+    static QString prefix;
+    static QString timestamp;
+
+    const qint64 now = Misc::Clock::instance().currentMSecsSinceEpoch();
+    if (now != cachedMsec)
+    {
+        // Re-format the seconds prefix only once per second
+        const qint64 second = now / 1000;
+        if (second != cachedSecond)
+        {
+            cachedSecond = second;
+            prefix = QDateTime::fromMSecsSinceEpoch(second * 1000)
+                         .toString(QStringLiteral("HH:mm:ss."));
+        }
+
+        // Append the zero-padded milliseconds & the arrow separator
+        const int msec = int(now % 1000);
+        timestamp = prefix;
+        if (msec < 100)
+            timestamp.append(QLatin1Char('0'));
+        if (msec < 10)
+            timestamp.append(QLatin1Char('0'));
+        timestamp.append(QString::number(msec));
+        timestamp.append(QStringLiteral(" -> "));
+        cachedMsec = now;
+    }
+
+    return timestamp;
+}
+
 /**
  * Inserts the given @a string into the list of lines of the console, if @a addTimestamp
  * is set to @c true, an timestamp is added for each line.
+ *
+ * Chunks that need no processing (no timestamps & no carriage returns to
+ * normalize) are stored & announced as-is: the incoming string is an
+ * implicitly-shared reference all the way to the text ring, so the only
+ * per-chunk copy left is the append into the ring itself. Chunks that do
+ * need processing build their owning copy in a single pass instead of the
+ * two whole-string replace() passes used previously.
  */
 void IO::Console::append(const QString &string, const bool addTimestamp)
 {
@@ -476,61 +634,81 @@ void IO::Console::append(const QString &string, const bool addTimestamp)
     if (string.isEmpty())
         return;
 
-    // Only use \n as line separator
-    auto data = string;
-    data = data.replace("\r\n", "\n");
-    data = data.replace("\r", "\n");
+    // Fast path (the usual case for line-feed based devices without
+    // timestamps): scan for carriage returns & hand the chunk through
+    // without building a processed copy when there are none
+    if (!addTimestamp)
+    {
+        bool needsNormalization = false;
+        for (int i = 0; !needsNormalization && i < string.length(); ++i)
+            needsNormalization = (string.at(i) == QLatin1Char('\r'));
+
+        if (!needsNormalization)
+        {
+            appendToBuffer(string);
+            m_pendingUiText.append(string);
+            m_isStartingLine = string.endsWith(QLatin1Char('\n'));
+            return;
+        }
+    }
 
     // Get timestamp
     QString timestamp;
     if (addTimestamp)
-    {
-        QDateTime dateTime = QDateTime::currentDateTime();
-        timestamp = dateTime.toString("HH:mm:ss.zzz -> ");
-    }
+        timestamp = Timestamp();
 
     // Initialize final string
     QString processedString;
-    processedString.reserve(data.length() + timestamp.length());
+    processedString.reserve(string.length() + timestamp.length());
 
-    // Create list with lines (keep separators)
-    StringList tokens;
-    QString currentToken;
-    for (int i = 0; i < data.length(); ++i)
+    // Scan the data once: normalize \r\n & lone \r into \n & insert a
+    // timestamp at the start of every line
+    for (int i = 0; i < string.length(); ++i)
     {
-        if (data.at(i) == '\n')
+        auto character = string.at(i);
+        if (character == QLatin1Char('\r'))
         {
-            tokens.append(currentToken);
-            tokens.append("\n");
-            currentToken.clear();
-        }
+            // Collapse \r\n into a single line feed
+            if (i + 1 < string.length()
+                && string.at(i + 1) == QLatin1Char('\n'))
+                continue;
 
-        else
-            currentToken += data.at(i);
-    }
-
-    // Add last item to list
-    if (!currentToken.isEmpty())
-        tokens.append(currentToken);
+            character = QLatin1Char('\n');
+        }
 
-    // Process lines
-    while (!tokens.isEmpty())
-    {
         if (m_isStartingLine)
             processedString.append(timestamp);
 
-        auto token = tokens.first();
-        processedString.append(token);
-        m_isStartingLine = (token == "\n");
-        tokens.removeFirst();
+        processedString.append(character);
+        m_isStartingLine = (character == QLatin1Char('\n'));
     }
 
-    // Add data to saved text buffer
-    m_textBuffer.append(processedString);
+    // Add data to saved text ring
+    appendToBuffer(processedString);
+
+    // Queue the UI notification, the accumulated text of all the chunks
+    // received during the current UI interval is announced in one signal
+    // emission by flushPendingText()
+    m_pendingUiText.append(processedString);
+}
+
+/**
+ * Emits the UI-facing signals for the text appended since the previous UI
+ * tick. The text ring & the line index are updated synchronously by
+ * @c append(), only the notification of the console views is conflated here,
+ * so the signal dispatch cost scales with the display rate instead of the
+ * chunk rate of the device.
+ */
+void IO::Console::flushPendingText()
+{
+    if (m_pendingUiText.isEmpty())
+        return;
+
+    const QString text = m_pendingUiText;
+    m_pendingUiText.clear();
 
-    // Update UI
     Q_EMIT dataReceived();
-    Q_EMIT stringReceived(processedString);
+    Q_EMIT stringReceived(text);
 }
 
 /**
@@ -549,6 +727,8 @@ void IO::Console::onDataSent(const QByteArray &data)
  */
 void IO::Console::onDataReceived(const QByteArray &data)
 {
+    // Tag this handler so that event-loop stall reports can blame it
+    Misc::WatchdogActivity activity("IO::Console text append");
     append(dataToString(data), showTimestamp());
 }
 
@@ -557,9 +737,11 @@ void IO::Console::onDataReceived(const QByteArray &data)
  */
 void IO::Console::addToHistory(const QString &command)
 {
-    // Remove old commands from history
-    while (m_historyItems.count() > 100)
-        m_historyItems.removeFirst();
+    // Remove old commands from history in a single pass
+    const int excess = m_historyItems.count() - 100;
+    if (excess > 0)
+        m_historyItems.erase(m_historyItems.begin(),
+                             m_historyItems.begin() + excess);
 
     // Register command
     m_historyItems.append(command);
@@ -567,21 +749,276 @@ void IO::Console::addToHistory(const QString &command)
     Q_EMIT historyItemChanged();
 }
 
+/**
+ * Called when the export worker finishes a save/print job, re-enables the
+ * export actions of the QML interface.
+ */
+void IO::Console::onExporterFinished()
+{
+    m_busy = false;
+    Q_EMIT busyChanged();
+}
+
+/**
+ * Notifies the user that the console output could not be written to disk.
+ */
+void IO::Console::onSaveFailed(const QString &error)
+{
+    Misc::Utilities::showMessageBox(tr("File save error"), error);
+}
+
+/**
+ * Reveals the exported console output file in the system file explorer.
+ */
+void IO::Console::onSaveFinished(const QString &path)
+{
+    Misc::Utilities::revealFile(path);
+}
+
+/**
+ * Returns the number of complete lines indexed over the console text ring.
+ * The index is built incrementally as data enters the ring, so this function
+ * (and the line-based accessors below) never scan the stored text.
+ */
+int IO::Console::lineCount() const
+{
+    return m_lineOffsets.count();
+}
+
+/**
+ * Returns the text of the given indexed @a line (without its trailing line
+ * feed). Lines are numbered from 0 (oldest retained line) to
+ * @c lineCount() - 1 (line currently being received).
+ */
+QString IO::Console::lineAt(const int line) const
+{
+    if (line < 0 || line >= m_lineOffsets.count())
+        return QString();
+
+    const quint64 start = m_lineOffsets.at(line);
+    const quint64 end = (line + 1 < m_lineOffsets.count())
+        ? m_lineOffsets.at(line + 1) - 1
+        : m_totalChars;
+
+    return textAt(start, end);
+}
+
+/**
+ * Searches the indexed console lines for the given @a query
+ * (case-insensitive) & returns the number of the first matching line, or -1
+ * when no match exists. The search starts at @a startLine & walks towards
+ * newer lines, or towards older lines when @a searchUpwards is set.
+ *
+ * The line-offset table keeps every probe a cheap ring lookup, so the search
+ * runs over the whole scrollback without assembling it into a string first.
+ */
+int IO::Console::findText(const QString &query, const int startLine,
+                          const bool searchUpwards) const
+{
+    if (query.isEmpty() || m_lineOffsets.isEmpty())
+        return -1;
+
+    const int step = searchUpwards ? -1 : 1;
+    int line = qBound(0, startLine, m_lineOffsets.count() - 1);
+    for (; line >= 0 && line < m_lineOffsets.count(); line += step)
+    {
+        if (lineAt(line).contains(query, Qt::CaseInsensitive))
+            return line;
+    }
+
+    return -1;
+}
+
+/**
+ * Writes the contents of the console text ring into the given session
+ * snapshot stream (see @c Misc::SessionSnapshot)
+ */
+void IO::Console::serializeSnapshot(QDataStream &out) const
+{
+    out << text();
+}
+
+/**
+ * Restores the console text ring from the given session snapshot stream.
+ * The text is only restored into a pristine console (nothing was received
+ * yet), so a stale snapshot can never overwrite live data.
+ */
+bool IO::Console::restoreSnapshot(QDataStream &in)
+{
+    QString text;
+    in >> text;
+    if (in.status() != QDataStream::Ok || text.isEmpty())
+        return false;
+
+    // Data already arrived, keep it
+    if (m_totalChars != 0)
+        return false;
+
+    // Rebuild the ring & the line index, the text was timestamped &
+    // line-ending-normalized when it was appended originally
+    appendToBuffer(text);
+    m_isStartingLine = text.endsWith(QLatin1Char('\n'));
+
+    Q_EMIT dataReceived();
+    return true;
+}
+
+/**
+ * Returns the contents of the console text ring in chronological order. When
+ * the ring has wrapped around, the (possibly truncated) oldest line is skipped
+ * so that the exported text always starts with a complete line.
+ */
+QString IO::Console::bufferText() const
+{
+    // Ring not full yet, the text starts at index 0
+    if (m_textLength < TEXT_BUFFER_SIZE)
+        return m_textBuffer.left(m_textLength);
+
+    // Ring wrapped around, the oldest character is stored at the head
+    QString text;
+    text.reserve(m_textLength);
+    text.append(m_textBuffer.mid(m_textHead));
+    text.append(m_textBuffer.left(m_textHead));
+
+    // Skip the first (possibly truncated) line in place, a mid() here would
+    // copy the whole ring a second time
+    const int firstLine = text.indexOf('\n');
+    if (firstLine >= 0)
+        text.remove(0, firstLine + 1);
+
+    return text;
+}
+
+/**
+ * Appends the given @a text to the console text ring. The ring has a fixed
+ * capacity, when it is full the oldest characters are overwritten, so the
+ * append cost stays constant no matter how long the console has been running.
+ */
+void IO::Console::appendToBuffer(const QString &text)
+{
+    // Only keep the last characters of strings larger than the whole ring
+    int offset = 0;
+    int length = text.length();
+    if (length > TEXT_BUFFER_SIZE)
+    {
+        offset = length - TEXT_BUFFER_SIZE;
+        length = TEXT_BUFFER_SIZE;
+    }
+
+    // Copy the string into the ring in (at most) two runs
+    QChar *buffer = m_textBuffer.data();
+    const QChar *data = text.constData() + offset;
+    const int tail = qMin(length, TEXT_BUFFER_SIZE - m_textHead);
+    memcpy(buffer + m_textHead, data, tail * sizeof(QChar));
+    if (length > tail)
+        memcpy(buffer, data + tail, (length - tail) * sizeof(QChar));
+
+    // Index the line starts contained in the new text while it is still in
+    // the CPU cache, the line-offset table is what allows search &
+    // line-based access to jump into the ring without scanning it
+    if (m_totalChars == 0 && length > 0)
+        m_lineOffsets.append(0);
+    for (int i = 0; i < length; ++i)
+    {
+        if (data[i] == QChar('\n'))
+            m_lineOffsets.append(m_totalChars + quint64(i) + 1);
+    }
+
+    // Update head & stored character count
+    m_textHead = (m_textHead + length) % TEXT_BUFFER_SIZE;
+    m_textLength = qMin(TEXT_BUFFER_SIZE, m_textLength + length);
+    m_totalChars += quint64(length);
+
+    // Drop the index entries of the lines that were just overwritten
+    const quint64 oldest = m_totalChars - quint64(m_textLength);
+    while (!m_lineOffsets.isEmpty() && m_lineOffsets.first() < oldest)
+        m_lineOffsets.removeFirst();
+
+    // Report the stored character count to the memory accounting surface
+    Misc::MemoryRegistry::instance().report("IO::Console (text ring)",
+                                            qint64(m_textLength) * sizeof(QChar));
+}
+
+/**
+ * Extracts the characters stored at the absolute stream offsets
+ * [@a start, @a end) from the text ring. The ring head advances in lockstep
+ * with the total character count, so the storage position of an offset is
+ * simply its remainder modulo the ring capacity.
+ */
+QString IO::Console::textAt(const quint64 start, const quint64 end) const
+{
+    // Reject ranges that are no longer (or not yet) inside the ring
+    if (end <= start || end > m_totalChars
+        || start < m_totalChars - quint64(m_textLength))
+        return QString();
+
+    // Extract the characters in (at most) two runs
+    const int length = int(end - start);
+    const int position = int(start % TEXT_BUFFER_SIZE);
+    const int tail = qMin(length, TEXT_BUFFER_SIZE - position);
+    QString text = m_textBuffer.mid(position, tail);
+    if (length > tail)
+        text.append(m_textBuffer.left(length - tail));
+
+    return text;
+}
+
 /**
  * Converts the given @a data in HEX format into real binary data.
  */
+/*
+ * Maps ASCII characters to their hexadecimal nibble value, entries for
+ * characters that are not hexadecimal digits hold -1
+ */
+// clang-format off
+static const qint8 HEX_NIBBLES[128] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+// clang-format on
+
 QByteArray IO::Console::hexToBytes(const QString &data)
 {
-    QString withoutSpaces = data;
-    withoutSpaces.replace(" ", "");
-
     QByteArray array;
-    for (int i = 0; i < withoutSpaces.length(); i += 2)
+    array.reserve(data.length() / 2);
+
+    int pending = 0;
+    bool havePending = false;
+    for (int i = 0; i < data.length(); ++i)
     {
-        auto chr1 = withoutSpaces.at(i);
-        auto chr2 = withoutSpaces.at(i + 1);
-        auto byte = QString("%1%2").arg(chr1, chr2).toInt(Q_NULLPTR, 16);
-        array.append(byte);
+        // Skip the spaces used to group the digits into byte pairs
+        const ushort c = data.at(i).unicode();
+        if (c == ' ')
+            continue;
+
+        // Map the character to its nibble value without string allocations
+        const int nibble = (c < 128) ? HEX_NIBBLES[c] : -1;
+
+        // Store the first half of the byte pair
+        if (!havePending)
+        {
+            pending = nibble;
+            havePending = true;
+        }
+
+        // Second half received, emit the byte. Pairs that contain a
+        // non-hexadecimal character produce a null byte, matching the
+        // behavior of the old QString::toInt() based parser.
+        else
+        {
+            if (pending >= 0 && nibble >= 0)
+                array.append(char((pending << 4) | nibble));
+            else
+                array.append('\0');
+
+            havePending = false;
+        }
     }
 
     return array;
@@ -607,17 +1044,99 @@ QString IO::Console::dataToString(const QByteArray &data)
     }
 }
 
+/**
+ * Returns @c true if the given buffer only contains 7-bit ASCII characters.
+ * The check runs over eight bytes per iteration by testing the high bit of a
+ * whole machine word at once, so the cost for the (overwhelmingly common)
+ * ASCII streams is a fraction of a character conversion.
+ */
+static bool IsAscii(const char *data, const int length)
+{
+    int i = 0;
+    quint64 word;
+    for (; i + int(sizeof(word)) <= length; i += int(sizeof(word)))
+    {
+        memcpy(&word, data + i, sizeof(word));
+        if (word & Q_UINT64_C(0x8080808080808080))
+            return false;
+    }
+
+    for (; i < length; ++i)
+    {
+        if (quint8(data[i]) & 0x80)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Returns @c true if the given buffer is a structurally valid UTF-8 byte
+ * sequence. This is a single forward pass over the data, used to decide the
+ * decoding of non-ASCII chunks without the encode/decode round trip that a
+ * conversion-and-compare check would cost.
+ */
+static bool IsValidUtf8(const char *data, const int length)
+{
+    int continuation = 0;
+    for (int i = 0; i < length; ++i)
+    {
+        const quint8 byte = quint8(data[i]);
+        if (continuation > 0)
+        {
+            if ((byte & 0xc0) != 0x80)
+                return false;
+
+            --continuation;
+        }
+
+        else if (byte < 0x80)
+            continue;
+
+        else if ((byte & 0xe0) == 0xc0)
+        {
+            // 0xc0/0xc1 would be overlong encodings of ASCII characters
+            if (byte < 0xc2)
+                return false;
+
+            continuation = 1;
+        }
+
+        else if ((byte & 0xf0) == 0xe0)
+            continuation = 2;
+
+        else if ((byte & 0xf8) == 0xf0)
+        {
+            // Code points above U+10FFFF do not exist
+            if (byte > 0xf4)
+                return false;
+
+            continuation = 3;
+        }
+
+        else
+            return false;
+    }
+
+    return continuation == 0;
+}
+
 /**
  * Converts the given @a data into an UTF-8 string
  */
 QString IO::Console::plainTextStr(const QByteArray &data)
 {
-    QString str = QString::fromUtf8(data);
+    // Pure ASCII (the usual case for serial devices), the bytes map 1:1 to
+    // UTF-16 code units & the bulk validation above costs almost nothing
+    if (IsAscii(data.constData(), data.size()))
+        return QString::fromLatin1(data);
 
-    if (str.toUtf8() != data)
-        str = QString::fromLatin1(data);
+    // Valid UTF-8, decode it as such; everything else is treated as Latin-1
+    // so that binary garbage still produces one character per byte
+    if (IsValidUtf8(data.constData(), data.size()))
+        return QString::fromUtf8(data);
 
-    return str;
+    return QString::fromLatin1(data);
 }
 
 /**
@@ -625,24 +1144,79 @@ QString IO::Console::plainTextStr(const QByteArray &data)
  */
 QString IO::Console::hexadecimalStr(const QByteArray &data)
 {
-    // Remove line breaks from data
-    QByteArray copy = data;
+    return HexDump(data.constData(), data.size());
+}
 
-    // Convert data to string with dump every ~80 chars
-    QString str;
-    const int characters = 80;
-    for (int i = 0; i < copy.length(); ++i)
+//----------------------------------------------------------------------------
+// Export worker
+//----------------------------------------------------------------------------
+
+/*
+ * Number of characters encoded & written to disk per iteration when streaming
+ * the console output to a file from the export worker thread
+ */
+static const int EXPORT_CHUNK_SIZE = 1024 * 1024;
+
+/**
+ * Writes the given console @a text to the file at @a path, called from the
+ * export worker thread. The text is encoded & streamed to disk in large
+ * chunks so that the worker never holds a full UTF-8 copy of the buffer,
+ * taking care not to split a surrogate pair at a chunk boundary.
+ */
+void IO::ConsoleExporter::saveToFile(const QString &path, const QString &text)
+{
+    QFile file(path);
+    if (file.open(QFile::WriteOnly))
     {
-        QByteArray line;
-        for (int j = 0; j < qMin(characters, copy.length() - i); ++j)
-            line.append(copy.at(i + j));
+        int i = 0;
+        while (i < text.length())
+        {
+            auto length = qMin(EXPORT_CHUNK_SIZE, text.length() - i);
+            if (text.at(i + length - 1).isHighSurrogate()
+                && i + length < text.length())
+                ++length;
+
+            // Encode straight from a view over the buffer where the view
+            // types exist, the fallback pays an owning copy of every chunk
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            file.write(QStringView(text).mid(i, length).toUtf8());
+#else
+            file.write(text.mid(i, length).toUtf8());
+#endif
+            i += length;
+        }
 
-        i += characters;
-        str.append(HexDump(line.data(), line.size()));
+        file.close();
+        Q_EMIT saveFinished(path);
     }
 
-    // Return string
-    return str;
+    else
+        Q_EMIT saveFailed(file.errorString());
+
+    Q_EMIT finished();
+}
+
+/**
+ * Lays out the given console @a text as a text document & renders it on the
+ * given @a printer, called from the export worker thread. The worker takes
+ * ownership of the printer & deletes it once the job is done.
+ */
+void IO::ConsoleExporter::printDocument(QPrinter *printer, const QString &text,
+                                        const QString &fontFamily)
+{
+    // Get document font (specified by QML ui)
+    QFont font;
+    font.setPointSize(10);
+    font.setFamily(fontFamily);
+
+    // Create text document & print it
+    QTextDocument document;
+    document.setDefaultFont(font);
+    document.setPlainText(text);
+    document.print(printer);
+
+    delete printer;
+    Q_EMIT finished();
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
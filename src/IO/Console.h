@@ -23,10 +23,41 @@
 #pragma once
 
 #include <QObject>
+#include <QThread>
 #include <DataTypes.h>
 
+class QPrinter;
+class QDataStream;
+
 namespace IO
 {
+/**
+ * @brief The ConsoleExporter class
+ *
+ * Worker object that performs the slow console output operations from a
+ * dedicated thread: streaming the console text to a file in large chunks &
+ * laying out/printing the text document. Painting on a @c QPrinter is one of
+ * the few paint operations that Qt explicitly supports outside of the GUI
+ * thread, so a large session can be saved or printed without freezing the
+ * interface or blocking data ingestion.
+ */
+class ConsoleExporter : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void finished();
+    void saveFinished(const QString &path);
+    void saveFailed(const QString &error);
+
+public Q_SLOTS:
+    void saveToFile(const QString &path, const QString &text);
+    void printDocument(QPrinter *printer, const QString &text,
+                       const QString &fontFamily);
+};
+
 /**
  * @brief The Console class
  *
@@ -71,6 +102,9 @@ class Console : public QObject
     Q_PROPERTY(QString currentHistoryString
                READ currentHistoryString
                NOTIFY historyItemChanged)
+    Q_PROPERTY(bool busy
+               READ busy
+               NOTIFY busyChanged)
     // clang-format on
 
 Q_SIGNALS:
@@ -80,6 +114,7 @@ Q_SIGNALS:
     void autoscrollChanged();
     void lineEndingChanged();
     void displayModeChanged();
+    void busyChanged();
     void historyItemChanged();
     void textDocumentChanged();
     void showTimestampChanged();
@@ -87,6 +122,7 @@ Q_SIGNALS:
 
 private:
     explicit Console();
+    ~Console();
     Console(Console &&) = delete;
     Console(const Console &) = delete;
     Console &operator=(Console &&) = delete;
@@ -118,11 +154,13 @@ public:
 
     static Console &instance();
 
+    bool busy() const;
     bool echo() const;
     bool autoscroll() const;
     bool saveAvailable() const;
     bool showTimestamp() const;
 
+    QString text() const;
     DataMode dataMode() const;
     LineEnding lineEnding() const;
     DisplayMode displayMode() const;
@@ -133,6 +171,14 @@ public:
     Q_INVOKABLE StringList displayModes() const;
     Q_INVOKABLE QString formatUserHex(const QString &text);
 
+    Q_INVOKABLE int lineCount() const;
+    Q_INVOKABLE QString lineAt(const int line) const;
+    Q_INVOKABLE int findText(const QString &query, const int startLine,
+                             const bool searchUpwards = false) const;
+
+    void serializeSnapshot(QDataStream &out) const;
+    bool restoreSnapshot(QDataStream &in);
+
 public Q_SLOTS:
     void save();
     void clear();
@@ -149,11 +195,19 @@ public Q_SLOTS:
     void append(const QString &str, const bool addTimestamp = false);
 
 private Q_SLOTS:
+    void flushPendingText();
     void onDataSent(const QByteArray &data);
     void addToHistory(const QString &command);
     void onDataReceived(const QByteArray &data);
+    void onExporterFinished();
+    void onSaveFailed(const QString &error);
+    void onSaveFinished(const QString &path);
 
 private:
+    QString bufferText() const;
+    void appendToBuffer(const QString &text);
+    QString textAt(const quint64 start, const quint64 end) const;
+
     QByteArray hexToBytes(const QString &data);
     QString dataToString(const QByteArray &data);
     QString plainTextStr(const QByteArray &data);
@@ -164,6 +218,8 @@ private:
     LineEnding m_lineEnding;
     DisplayMode m_displayMode;
 
+    int m_textHead;
+    int m_textLength;
     int m_historyItem;
 
     bool m_echo;
@@ -176,5 +232,20 @@ private:
 
     QString m_printFont;
     QString m_textBuffer;
+
+    // Text appended to the ring but not announced to the user interface yet,
+    // the UI-facing signals are emitted at most once per UI tick (see
+    // flushPendingText())
+    QString m_pendingUiText;
+
+    // Incremental line index over the text ring, each entry is the absolute
+    // stream offset of a line start & m_totalChars counts the characters
+    // that entered the ring since the console was cleared
+    quint64 m_totalChars;
+    QList<quint64> m_lineOffsets;
+
+    bool m_busy;
+    ConsoleExporter *m_exporter;
+    QThread m_exporterThread;
 };
 }
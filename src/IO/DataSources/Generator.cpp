@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <qmath.h>
+#include <cstring>
+
+#include <QRandomGenerator>
+
+#include <IO/DataSources/Generator.h>
+#include <Misc/MemoryRegistry.h>
+
+/**
+ * Upper bound for the number of frames emitted by a single timer tick, protects
+ * the GUI thread from a flood of queued signals if frame generation falls behind
+ * (e.g. after the laptop wakes up from sleep).
+ */
+static const quint64 kMaxFramesPerTick = 10000;
+
+/**
+ * Upper bound for the amount of un-read data buffered by the loopback device.
+ * If the consumer stalls for longer than this, the oldest data is dropped, which
+ * mimics the overrun behavior of a real UART/socket.
+ */
+static const int kMaxBufferedBytes = 16 * 1024 * 1024;
+
+//----------------------------------------------------------------------------------------
+// GeneratorWorker
+//----------------------------------------------------------------------------------------
+
+/**
+ * Starts producing frames, must be called (through a queued connection) after the
+ * worker has been moved to its thread so that the timer is created there.
+ */
+void IO::DataSources::GeneratorWorker::start()
+{
+    m_producedFrames = 0;
+    m_clock.start();
+
+    // Tick often enough to honor the configured rate, slow rates use long
+    // intervals & fast rates batch several frames per tick (deadline correction
+    // in onTimeout() emits every frame that became due since the last tick)
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(qBound(1, 1000 / qMax(1, m_frameRate), 250));
+    connect(&m_timer, &QTimer::timeout, this,
+            &IO::DataSources::GeneratorWorker::onTimeout, Qt::UniqueConnection);
+    m_timer.start();
+}
+
+/**
+ * Stops producing frames
+ */
+void IO::DataSources::GeneratorWorker::stop()
+{
+    m_timer.stop();
+}
+
+/**
+ * Updates the generation parameters, can be called while the worker is running
+ * (the frame counter & clock are reset so that the deadline correction does not
+ * try to "catch up" with the previous rate).
+ */
+void IO::DataSources::GeneratorWorker::configure(const int datasetCount,
+                                                 const int frameRate,
+                                                 const int paddingBytes,
+                                                 const int corruptionRate)
+{
+    m_frameRate = qMax(1, frameRate);
+    m_datasetCount = qMax(1, datasetCount);
+    m_paddingBytes = qMax(0, paddingBytes);
+    m_corruptionRate = qBound(0, corruptionRate, 100);
+
+    if (m_timer.isActive())
+    {
+        m_producedFrames = 0;
+        m_clock.restart();
+        m_timer.setInterval(qBound(1, 1000 / m_frameRate, 250));
+    }
+}
+
+/**
+ * Emits every frame that became due since the last tick as a single byte array,
+ * which keeps the number of cross-thread signals constant regardless of the
+ * configured frame rate.
+ */
+void IO::DataSources::GeneratorWorker::onTimeout()
+{
+    // Calculate the number of frames that should have been produced by now
+    const quint64 target = quint64(m_clock.nsecsElapsed() / 1e9 * m_frameRate);
+    if (target <= m_producedFrames)
+        return;
+
+    // Batch the due frames into a single buffer (capped, see kMaxFramesPerTick)
+    QByteArray batch;
+    const quint64 count = qMin(target - m_producedFrames, kMaxFramesPerTick);
+    for (quint64 i = 0; i < count; ++i)
+    {
+        batch.append(buildFrame());
+        ++m_producedFrames;
+    }
+
+    // Account for frames skipped by the cap as well, otherwise the next tick
+    // would try to produce them again
+    m_producedFrames = qMax(m_producedFrames, target);
+    Q_EMIT dataReady(batch);
+}
+
+/**
+ * Generates a single delimited frame with @c m_datasetCount comma-separated
+ * sine-wave channels (each channel with a different frequency, so plots look
+ * plausible), optional padding & optional random corruption.
+ */
+QByteArray IO::DataSources::GeneratorWorker::buildFrame()
+{
+    // Generate the channel values from the frame counter, so that the signal
+    // shapes are deterministic & independent of the wall clock
+    QByteArray frame = "/*";
+    const double t = double(m_producedFrames) / double(m_frameRate);
+    for (int i = 0; i < m_datasetCount; ++i)
+    {
+        if (i > 0)
+            frame.append(',');
+
+        const double value = qSin(2 * M_PI * t * (0.1 + 0.1 * i)) * 100;
+        frame.append(QByteArray::number(value, 'f', 2));
+    }
+
+    // Append the padding channel (simulates devices that send large text fields
+    // or base64 payloads next to the numeric channels)
+    if (m_paddingBytes > 0)
+    {
+        frame.append(',');
+        frame.append(QByteArray(m_paddingBytes, 'x'));
+    }
+
+    // Close the frame
+    frame.append("*/");
+
+    // Corrupt a random byte of the frame (including, possibly, the delimiters),
+    // used to verify that the parsing pipeline tolerates junk at line rate
+    if (m_corruptionRate > 0)
+    {
+        auto *rng = QRandomGenerator::global();
+        if (int(rng->bounded(100)) < m_corruptionRate)
+        {
+            const int index = int(rng->bounded(quint32(frame.size())));
+            frame[index] = char(rng->bounded(256));
+        }
+    }
+
+    return frame;
+}
+
+//----------------------------------------------------------------------------------------
+// GeneratorDevice
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::DataSources::GeneratorDevice::GeneratorDevice(QObject *parent)
+    : QIODevice(parent)
+{
+}
+
+/**
+ * The generator behaves like a stream (serial port/socket), not like a file
+ */
+bool IO::DataSources::GeneratorDevice::isSequential() const
+{
+    return true;
+}
+
+/**
+ * Returns the number of buffered bytes that have not been read yet
+ */
+qint64 IO::DataSources::GeneratorDevice::bytesAvailable() const
+{
+    return m_buffer.size() + QIODevice::bytesAvailable();
+}
+
+/**
+ * Opens the device & discards any data buffered by a previous session
+ */
+bool IO::DataSources::GeneratorDevice::open(QIODevice::OpenMode mode)
+{
+    m_buffer.clear();
+    return QIODevice::open(mode);
+}
+
+/**
+ * Appends the given @a data to the read buffer & announces it with
+ * @c readyRead(). Called through a queued connection, so this always executes on
+ * the thread that owns the device (the GUI thread) & no locking is needed.
+ */
+void IO::DataSources::GeneratorDevice::injectData(const QByteArray &data)
+{
+    if (!isOpen())
+        return;
+
+    // Drop the oldest data if the consumer stalled, just like a real device
+    // overruns its FIFO
+    m_buffer.append(data);
+    if (m_buffer.size() > kMaxBufferedBytes)
+        m_buffer.remove(0, m_buffer.size() - kMaxBufferedBytes);
+
+    Misc::MemoryRegistry::instance().report("IO::Generator (loopback buffer)",
+                                            m_buffer.size());
+    Q_EMIT readyRead();
+}
+
+/**
+ * Pops up to @a maxSize buffered bytes into @a data
+ */
+qint64 IO::DataSources::GeneratorDevice::readData(char *data, qint64 maxSize)
+{
+    const qint64 bytes = qMin(maxSize, qint64(m_buffer.size()));
+    if (bytes > 0)
+    {
+        memcpy(data, m_buffer.constData(), size_t(bytes));
+        m_buffer.remove(0, int(bytes));
+    }
+
+    return bytes;
+}
+
+/**
+ * Accepts & discards written data, the generator has no remote end that could
+ * consume the TX stream of the console
+ */
+qint64 IO::DataSources::GeneratorDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    return maxSize;
+}
+
+//----------------------------------------------------------------------------------------
+// Generator
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, the worker thread is *not* started here, it spins up
+ * lazily the first time the generator device is opened (see the lazy
+ * initialization contract in @c Misc::ModuleManager).
+ */
+IO::DataSources::Generator::Generator()
+    : m_frameRate(60)
+    , m_datasetCount(8)
+    , m_paddingBytes(0)
+    , m_corruptionRate(0)
+    , m_worker(new GeneratorWorker)
+{
+    // Move the worker to its thread & connect its output to the loopback device,
+    // the queued connection hands the generated batches over to the GUI thread
+    m_worker->moveToThread(&m_workerThread);
+    connect(&m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &GeneratorWorker::dataReady, &m_device,
+            &GeneratorDevice::injectData, Qt::QueuedConnection);
+}
+
+/**
+ * Destructor function
+ */
+IO::DataSources::Generator::~Generator()
+{
+    if (m_workerThread.isRunning())
+    {
+        m_workerThread.quit();
+        m_workerThread.wait();
+    }
+
+    else
+        delete m_worker;
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::DataSources::Generator &IO::DataSources::Generator::instance()
+{
+    static Generator singleton;
+    return singleton;
+}
+
+/**
+ * Returns the number of frames generated per second
+ */
+int IO::DataSources::Generator::frameRate() const
+{
+    return m_frameRate;
+}
+
+/**
+ * Returns the number of numeric channels per frame
+ */
+int IO::DataSources::Generator::datasetCount() const
+{
+    return m_datasetCount;
+}
+
+/**
+ * Returns the size (in bytes) of the extra padding channel appended to every
+ * frame, 0 disables padding
+ */
+int IO::DataSources::Generator::paddingBytes() const
+{
+    return m_paddingBytes;
+}
+
+/**
+ * Returns the percentage (0-100) of frames that get one random byte corrupted
+ */
+int IO::DataSources::Generator::corruptionRate() const
+{
+    return m_corruptionRate;
+}
+
+/**
+ * The generator has no external dependencies, so it can always be started
+ */
+bool IO::DataSources::Generator::configurationOk() const
+{
+    return true;
+}
+
+/**
+ * Starts the worker thread (if needed), configures the worker with the current
+ * parameters & returns a pointer to the loopback device. Ownership of the device
+ * stays with this class.
+ */
+QIODevice *IO::DataSources::Generator::openDevice()
+{
+    // Stop any previous session
+    disconnectDevice();
+
+    // Spin up the worker thread on first use
+    if (!m_workerThread.isRunning())
+        m_workerThread.start(QThread::HighPriority);
+
+    // Configure & start the worker on its own thread
+    configureWorker();
+    QMetaObject::invokeMethod(m_worker, "start", Qt::QueuedConnection);
+
+    // Return pointer, IO::Manager opens the device & hooks up readyRead()
+    return &m_device;
+}
+
+/**
+ * Stops the frame generator & closes the loopback device
+ */
+void IO::DataSources::Generator::disconnectDevice()
+{
+    if (m_workerThread.isRunning())
+        QMetaObject::invokeMethod(m_worker, "stop", Qt::QueuedConnection);
+
+    m_device.close();
+}
+
+/**
+ * Changes the number of frames generated per second, applied immediately if the
+ * generator is running
+ */
+void IO::DataSources::Generator::setFrameRate(const int rate)
+{
+    m_frameRate = qBound(1, rate, 100000);
+    configureWorker();
+    Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the number of numeric channels per frame, applied immediately if the
+ * generator is running
+ */
+void IO::DataSources::Generator::setDatasetCount(const int count)
+{
+    m_datasetCount = qBound(1, count, 128);
+    configureWorker();
+    Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the size of the padding channel appended to every frame, applied
+ * immediately if the generator is running
+ */
+void IO::DataSources::Generator::setPaddingBytes(const int bytes)
+{
+    m_paddingBytes = qBound(0, bytes, 65536);
+    configureWorker();
+    Q_EMIT configurationChanged();
+}
+
+/**
+ * Changes the percentage of frames that get one random byte corrupted, applied
+ * immediately if the generator is running
+ */
+void IO::DataSources::Generator::setCorruptionRate(const int rate)
+{
+    m_corruptionRate = qBound(0, rate, 100);
+    configureWorker();
+    Q_EMIT configurationChanged();
+}
+
+/**
+ * Pushes the current parameters to the worker through a queued connection (no-op
+ * if the worker thread was never started)
+ */
+void IO::DataSources::Generator::configureWorker()
+{
+    if (!m_workerThread.isRunning())
+        return;
+
+    QMetaObject::invokeMethod(m_worker, "configure", Qt::QueuedConnection,
+                              Q_ARG(int, m_datasetCount), Q_ARG(int, m_frameRate),
+                              Q_ARG(int, m_paddingBytes), Q_ARG(int, m_corruptionRate));
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Generator.cpp"
+#endif
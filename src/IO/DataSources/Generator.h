@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <DataTypes.h>
+
+#include <QTimer>
+#include <QObject>
+#include <QThread>
+#include <QIODevice>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+namespace IO
+{
+namespace DataSources
+{
+/**
+ * @brief The GeneratorWorker class
+ *
+ * Produces synthetic delimited frames at the configured frame rate. An instance
+ * of this class lives on a dedicated thread so that frame generation can sustain
+ * line-rate output without competing with the user interface. The worker performs
+ * deadline correction against a monotonic clock, so a delayed timer tick emits
+ * every frame that became due since the previous tick.
+ */
+class GeneratorWorker : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void dataReady(const QByteArray &data);
+
+public Q_SLOTS:
+    void start();
+    void stop();
+    void configure(const int datasetCount, const int frameRate, const int paddingBytes,
+                   const int corruptionRate);
+
+private Q_SLOTS:
+    void onTimeout();
+
+private:
+    QByteArray buildFrame();
+
+private:
+    int m_frameRate = 60;
+    int m_datasetCount = 8;
+    int m_paddingBytes = 0;
+    int m_corruptionRate = 0;
+
+    QTimer m_timer;
+    quint64 m_producedFrames = 0;
+    QElapsedTimer m_clock;
+};
+
+/**
+ * @brief The GeneratorDevice class
+ *
+ * Minimal sequential @c QIODevice that buffers the data produced by the worker
+ * thread & announces it with @c readyRead(), so the generator plugs into the
+ * regular @c IO::Manager device handling (readAll() & the ingestion pipeline)
+ * exactly like a serial port or a network socket.
+ */
+class GeneratorDevice : public QIODevice
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+public:
+    explicit GeneratorDevice(QObject *parent = Q_NULLPTR);
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    bool open(QIODevice::OpenMode mode) override;
+
+public Q_SLOTS:
+    void injectData(const QByteArray &data);
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    QByteArray m_buffer;
+};
+
+/**
+ * @brief The Generator class
+ *
+ * Serial Studio "driver" class that produces synthetic frames internally instead
+ * of reading them from a physical device. Used for stress & soak testing: the
+ * generated frames go through the exact same ingestion path as serial/network
+ * data (delimiter scanning, checksum validation, JSON generation & dashboard
+ * rendering), so it can be used to state how many frames per second a given
+ * project configuration sustains on a given machine.
+ */
+class Generator : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(int datasetCount
+               READ datasetCount
+               WRITE setDatasetCount
+               NOTIFY configurationChanged)
+    Q_PROPERTY(int frameRate
+               READ frameRate
+               WRITE setFrameRate
+               NOTIFY configurationChanged)
+    Q_PROPERTY(int paddingBytes
+               READ paddingBytes
+               WRITE setPaddingBytes
+               NOTIFY configurationChanged)
+    Q_PROPERTY(int corruptionRate
+               READ corruptionRate
+               WRITE setCorruptionRate
+               NOTIFY configurationChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void configurationChanged();
+
+private:
+    explicit Generator();
+    Generator(Generator &&) = delete;
+    Generator(const Generator &) = delete;
+    Generator &operator=(Generator &&) = delete;
+    Generator &operator=(const Generator &) = delete;
+
+    ~Generator();
+
+public:
+    static Generator &instance();
+
+    int frameRate() const;
+    int datasetCount() const;
+    int paddingBytes() const;
+    int corruptionRate() const;
+    bool configurationOk() const;
+
+    QIODevice *openDevice();
+
+public Q_SLOTS:
+    void disconnectDevice();
+    void setFrameRate(const int rate);
+    void setDatasetCount(const int count);
+    void setPaddingBytes(const int bytes);
+    void setCorruptionRate(const int rate);
+
+private:
+    void configureWorker();
+
+private:
+    int m_frameRate;
+    int m_datasetCount;
+    int m_paddingBytes;
+    int m_corruptionRate;
+
+    QThread m_workerThread;
+    GeneratorWorker *m_worker;
+    GeneratorDevice m_device;
+};
+}
+}
@@ -24,20 +24,80 @@
 #include <Misc/Utilities.h>
 #include <IO/DataSources/Network.h>
 
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#    include <winsock2.h>
+#    include <ws2ipdef.h>
+#else
+#    include <sys/socket.h>
+#    include <netinet/in.h>
+#endif
+
+/**
+ * Joins the given IPv4 multicast @a group on @a socket, accepting only the
+ * datagrams sent by @a source (source-specific multicast, IGMPv3). The kernel
+ * drops traffic from any other sender before it reaches the process, which is
+ * much cheaper than filtering datagrams in user space.
+ *
+ * Qt does not expose source-specific joins, so the membership is added with
+ * a @c IP_ADD_SOURCE_MEMBERSHIP socket option on the native descriptor.
+ * Returns @c false if the addresses are not IPv4 or the option is rejected.
+ */
+static bool JoinSourceSpecificGroup(QUdpSocket *socket, const QHostAddress &group,
+                                    const QHostAddress &source)
+{
+    // Both addresses must be valid IPv4 addresses
+    bool groupOk = false;
+    bool sourceOk = false;
+    const auto groupAddr = group.toIPv4Address(&groupOk);
+    const auto sourceAddr = source.toIPv4Address(&sourceOk);
+    if (!groupOk || !sourceOk)
+        return false;
+
+    // Build the source-specific membership request
+    struct ip_mreq_source mreq;
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr.s_addr = htonl(groupAddr);
+    mreq.imr_sourceaddr.s_addr = htonl(sourceAddr);
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    // Add the membership on the native socket descriptor
+#ifdef Q_OS_WIN
+    const auto fd = static_cast<SOCKET>(socket->socketDescriptor());
+#else
+    const auto fd = static_cast<int>(socket->socketDescriptor());
+#endif
+    return setsockopt(fd, IPPROTO_IP, IP_ADD_SOURCE_MEMBERSHIP,
+                      reinterpret_cast<const char *>(&mreq), sizeof(mreq))
+        == 0;
+}
+
 /**
  * Constructor function
  */
 IO::DataSources::Network::Network()
     : m_hostExists(false)
+    , m_tcpNoDelay(true)
     , m_udpMulticast(false)
     , m_lookupActive(false)
+    , m_multicastBytes(0)
+    , m_socketBufferSize(1024 * 1024)
+    , m_socketErrorCount(0)
 {
+    m_udpBuffer.resize(64 * 1024);
+
     setRemoteAddress("");
     setTcpPort(defaultTcpPort());
     setUdpLocalPort(defaultUdpLocalPort());
     setUdpRemotePort(defaultUdpRemotePort());
     setSocketType(QAbstractSocket::TcpSocket);
 
+    // Socket options can only be applied once the native descriptor exists,
+    // which (for TCP) happens after the connection is established
+    connect(&m_tcpSocket, &QTcpSocket::connected, this,
+            &IO::DataSources::Network::onTcpConnected);
+
     // clang-format off
 #if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
     connect(&m_tcpSocket, SIGNAL(error(QAbstractSocket::SocketError)), 
@@ -111,6 +171,54 @@ bool IO::DataSources::Network::udpMulticast() const
     return m_udpMulticast;
 }
 
+/**
+ * Returns the sender address that the multicast subscription is restricted
+ * to. When empty, the group is joined without source filtering & datagrams
+ * from every sender are accepted.
+ */
+QString IO::DataSources::Network::multicastSource() const
+{
+    return m_multicastSource;
+}
+
+/**
+ * Returns the number of payload bytes received through the multicast
+ * subscription since the socket was opened.
+ */
+quint64 IO::DataSources::Network::multicastBytes() const
+{
+    return m_multicastBytes;
+}
+
+/**
+ * Returns @c true if Nagle's algorithm shall be disabled (TCP_NODELAY) on TCP
+ * connections. Enabled by default, since telemetry frames are small & latency
+ * sensitive.
+ */
+bool IO::DataSources::Network::tcpNoDelay() const
+{
+    return m_tcpNoDelay;
+}
+
+/**
+ * Returns the size (in bytes) requested for the OS-level socket buffers
+ * (SO_RCVBUF/SO_SNDBUF). A value of 0 keeps the kernel defaults, which are
+ * known to drop datagrams on fast (>10 MB/s) UDP streams.
+ */
+int IO::DataSources::Network::socketBufferSize() const
+{
+    return m_socketBufferSize;
+}
+
+/**
+ * Returns the number of socket errors registered since the application was
+ * launched. Useful to spot flaky links from the QML interface.
+ */
+quint64 IO::DataSources::Network::socketErrorCount() const
+{
+    return m_socketErrorCount;
+}
+
 /**
  * Returns @c true if we are currently performing a DNS lookup
  */
@@ -201,9 +309,24 @@ QIODevice *IO::DataSources::Network::openNetworkPort()
                          QAbstractSocket::ReuseAddressHint);
         // clang-format on
 
-        // Join the multicast group (if required)
+        // Join the multicast group (if required), using a source-specific
+        // membership when a source address is configured so that the kernel
+        // drops foreign traffic before it reaches the process
         if (udpMulticast())
-            m_udpSocket.joinMulticastGroup(QHostAddress(m_address));
+        {
+            const QHostAddress group(m_address);
+            const QHostAddress source(multicastSource());
+            if (source.isNull()
+                || !JoinSourceSpecificGroup(&m_udpSocket, group, source))
+                m_udpSocket.joinMulticastGroup(group);
+        }
+
+        // Reset the multicast byte counter for the new subscription
+        m_multicastBytes = 0;
+        Q_EMIT multicastBytesChanged();
+
+        // Grow the kernel buffers, the UDP socket is bound at this point
+        applySocketOptions(&m_udpSocket);
 
         // Update socket pointer
         socket = &m_udpSocket;
@@ -213,6 +336,45 @@ QIODevice *IO::DataSources::Network::openNetworkPort()
     return socket;
 }
 
+/**
+ * Drains the UDP socket & returns the payload of all the pending datagrams as a single
+ * contiguous byte array. Datagrams are read directly into a pre-allocated arena that
+ * grows to the high-water mark of the connection and is re-used across wakeups, so a
+ * burst of datagrams costs (at most) one allocation instead of one per packet.
+ */
+QByteArray IO::DataSources::Network::readAllDatagrams()
+{
+    int bytes = 0;
+    while (m_udpSocket.hasPendingDatagrams())
+    {
+        // Consume stray datagrams without payload
+        auto size = int(m_udpSocket.pendingDatagramSize());
+        if (size <= 0)
+        {
+            m_udpSocket.readDatagram(Q_NULLPTR, 0);
+            continue;
+        }
+
+        // Grow the arena (amortized, doubling) if the datagram does not fit
+        if (m_udpBuffer.size() < bytes + size)
+            m_udpBuffer.resize(qMax(m_udpBuffer.size() * 2, bytes + size));
+
+        // Read the datagram payload straight into the arena
+        auto read = m_udpSocket.readDatagram(m_udpBuffer.data() + bytes, size);
+        if (read > 0)
+            bytes += int(read);
+    }
+
+    // Update the multicast subscription byte counter
+    if (udpMulticast() && bytes > 0)
+    {
+        m_multicastBytes += bytes;
+        Q_EMIT multicastBytesChanged();
+    }
+
+    return QByteArray(m_udpBuffer.constData(), bytes);
+}
+
 /**
  * Instructs the module to communicate via a TCP socket.
  */
@@ -308,6 +470,45 @@ void IO::DataSources::Network::setUdpMulticast(const bool enabled)
     Q_EMIT udpMulticastChanged();
 }
 
+/**
+ * Changes the source address used for source-specific multicast joins. When
+ * empty, the multicast group is joined without source filtering.
+ */
+void IO::DataSources::Network::setMulticastSource(const QString &address)
+{
+    m_multicastSource = address.simplified();
+    Q_EMIT multicastSourceChanged();
+}
+
+/**
+ * Enables/Disables Nagle's algorithm (TCP_NODELAY) on TCP connections.
+ * Re-applied immediately if the TCP socket is already connected.
+ */
+void IO::DataSources::Network::setTcpNoDelay(const bool enabled)
+{
+    m_tcpNoDelay = enabled;
+    if (m_tcpSocket.state() == QAbstractSocket::ConnectedState)
+        applySocketOptions(&m_tcpSocket);
+
+    Q_EMIT socketOptionsChanged();
+}
+
+/**
+ * Changes the size (in bytes) requested for the OS-level socket buffers.
+ * Set to 0 to keep the kernel defaults. Re-applied immediately on open
+ * sockets.
+ */
+void IO::DataSources::Network::setSocketBufferSize(const int bytes)
+{
+    m_socketBufferSize = qMax(0, bytes);
+    if (m_tcpSocket.state() == QAbstractSocket::ConnectedState)
+        applySocketOptions(&m_tcpSocket);
+    if (m_udpSocket.state() == QAbstractSocket::BoundState)
+        applySocketOptions(&m_udpSocket);
+
+    Q_EMIT socketOptionsChanged();
+}
+
 /**
  * Changes the current socket type given an index of the list returned by the
  * @c socketType() function.
@@ -340,6 +541,34 @@ void IO::DataSources::Network::setSocketType(const QAbstractSocket::SocketType t
     Q_EMIT socketTypeChanged();
 }
 
+/**
+ * Applies the configured tuning options (TCP_NODELAY and SO_RCVBUF/SO_SNDBUF
+ * sizes) on the given @a socket. Must be called after the socket is connected
+ * or bound, otherwise the options are silently ignored by the OS.
+ */
+void IO::DataSources::Network::applySocketOptions(QAbstractSocket *socket)
+{
+    if (m_socketBufferSize > 0)
+    {
+        socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,
+                                m_socketBufferSize);
+        socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption,
+                                m_socketBufferSize);
+    }
+
+    if (socket == &m_tcpSocket)
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, m_tcpNoDelay ? 1 : 0);
+}
+
+/**
+ * Applies the socket tuning options once the TCP connection is established
+ * (the native socket descriptor does not exist before this point).
+ */
+void IO::DataSources::Network::onTcpConnected()
+{
+    applySocketOptions(&m_tcpSocket);
+}
+
 /**
  * Sets the host IP address when the lookup finishes.
  * If the lookup fails, the error code/string shall be shown to the user in a messagebox.
@@ -368,6 +597,9 @@ void IO::DataSources::Network::lookupFinished(const QHostInfo &info)
 void IO::DataSources::Network::onErrorOccurred(
     const QAbstractSocket::SocketError socketError)
 {
+    ++m_socketErrorCount;
+    Q_EMIT socketErrorCountChanged();
+
     QString error;
     if (socketType() == QAbstractSocket::TcpSocket)
         error = m_tcpSocket.errorString();
@@ -90,6 +90,24 @@ class Network : public QObject
                READ udpMulticast
                WRITE setUdpMulticast
                NOTIFY udpMulticastChanged)
+    Q_PROPERTY(QString multicastSource
+               READ multicastSource
+               WRITE setMulticastSource
+               NOTIFY multicastSourceChanged)
+    Q_PROPERTY(quint64 multicastBytes
+               READ multicastBytes
+               NOTIFY multicastBytesChanged)
+    Q_PROPERTY(bool tcpNoDelay
+               READ tcpNoDelay
+               WRITE setTcpNoDelay
+               NOTIFY socketOptionsChanged)
+    Q_PROPERTY(int socketBufferSize
+               READ socketBufferSize
+               WRITE setSocketBufferSize
+               NOTIFY socketOptionsChanged)
+    Q_PROPERTY(quint64 socketErrorCount
+               READ socketErrorCount
+               NOTIFY socketErrorCountChanged)
     // clang-format on
 
 Q_SIGNALS:
@@ -98,6 +116,10 @@ Q_SIGNALS:
     void socketTypeChanged();
     void udpMulticastChanged();
     void lookupActiveChanged();
+    void multicastBytesChanged();
+    void multicastSourceChanged();
+    void socketOptionsChanged();
+    void socketErrorCountChanged();
 
 private:
     explicit Network();
@@ -118,6 +140,11 @@ public:
     quint16 udpRemotePort() const;
 
     bool udpMulticast() const;
+    QString multicastSource() const;
+    quint64 multicastBytes() const;
+    bool tcpNoDelay() const;
+    int socketBufferSize() const;
+    quint64 socketErrorCount() const;
     bool lookupActive() const;
     int socketTypeIndex() const;
     bool configurationOk() const;
@@ -133,6 +160,7 @@ public:
     static quint16 defaultUdpRemotePort() { return 53; }
 
     QIODevice *openNetworkPort();
+    QByteArray readAllDatagrams();
 
 public Q_SLOTS:
     void setTcpSocket();
@@ -142,27 +170,40 @@ public Q_SLOTS:
     void setTcpPort(const quint16 port);
     void setUdpLocalPort(const quint16 port);
     void setUdpMulticast(const bool enabled);
+    void setMulticastSource(const QString &address);
+    void setTcpNoDelay(const bool enabled);
+    void setSocketBufferSize(const int bytes);
     void setSocketTypeIndex(const int index);
     void setUdpRemotePort(const quint16 port);
     void setRemoteAddress(const QString &address);
     void setSocketType(const QAbstractSocket::SocketType type);
 
 private Q_SLOTS:
+    void onTcpConnected();
     void lookupFinished(const QHostInfo &info);
     void onErrorOccurred(const QAbstractSocket::SocketError socketError);
 
+private:
+    void applySocketOptions(QAbstractSocket *socket);
+
 private:
     QString m_address;
     quint16 m_tcpPort;
     bool m_hostExists;
+    bool m_tcpNoDelay;
     bool m_udpMulticast;
     bool m_lookupActive;
+    QString m_multicastSource;
+    quint64 m_multicastBytes;
+    int m_socketBufferSize;
+    quint64 m_socketErrorCount;
     quint16 m_udpLocalPort;
     quint16 m_udpRemotePort;
     QAbstractSocket::SocketType m_socketType;
 
     QTcpSocket m_tcpSocket;
     QUdpSocket m_udpSocket;
+    QByteArray m_udpBuffer;
 };
 }
 }
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QtEndian>
+
+#include <IO/Manager.h>
+#include <IO/Checksum.h>
+#include <Misc/Utilities.h>
+#include <IO/DataSources/Relay.h>
+
+/*
+ * Framing of the relay stream: every batch of frames is serialized as a run of
+ * length-prefixed records (relay magic, 16-bit little-endian payload length,
+ * payload, 16-bit big-endian CRC-16 of the payload — exactly the record format
+ * parsed by the "length-prefixed" framing mode of the frame reader) & shipped
+ * inside a compressed stream block (the same @c SSC1 block format that the
+ * frame reader inflates transparently). Viewers therefore re-use the stock
+ * ingestion pipeline without a single line of relay-specific parsing code.
+ */
+static const char RELAY_STREAM_MAGIC[4] = { 'S', 'S', 'C', '1' };
+
+/**
+ * Constructor function, starts listening for viewer connections when the server half is
+ * enabled & re-publishes every frame batch extracted by the I/O manager.
+ */
+IO::DataSources::Relay::Relay()
+    : m_serverEnabled(false)
+    , m_serverPort(defaultPort())
+    , m_publishedBytes(0)
+    , m_hostExists(false)
+    , m_lookupActive(false)
+{
+    setRemoteAddress("");
+    setTcpPort(defaultPort());
+
+    // Register viewer connections as they arrive
+    connect(&m_server, &QTcpServer::newConnection, this,
+            &IO::DataSources::Relay::onNewViewerConnection);
+
+    // Re-publish the validated frames extracted by the primary pipeline
+    connect(&Manager::instance(), &Manager::frameBatchReceived, this,
+            &IO::DataSources::Relay::onFrameBatchReceived);
+
+    // Report viewer socket errors through a message box (same UX as the network source)
+    // clang-format off
+#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
+    connect(&m_socket, SIGNAL(error(QAbstractSocket::SocketError)),
+            this,        SLOT(onErrorOccurred(QAbstractSocket::SocketError)));
+#else
+    connect(&m_socket, &QTcpSocket::errorOccurred,
+            this, &IO::DataSources::Relay::onErrorOccurred);
+#endif
+    // clang-format on
+}
+
+/**
+ * Destructor function, closes the relay server & the viewer connection
+ */
+IO::DataSources::Relay::~Relay()
+{
+    setServerEnabled(false);
+    disconnectDevice();
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::DataSources::Relay &IO::DataSources::Relay::instance()
+{
+    static Relay singleton;
+    return singleton;
+}
+
+/**
+ * Returns @c true if this instance re-publishes its validated frames to viewer
+ * instances.
+ */
+bool IO::DataSources::Relay::serverEnabled() const
+{
+    return m_serverEnabled;
+}
+
+/**
+ * Returns the TCP port that the relay server listens on
+ */
+quint16 IO::DataSources::Relay::serverPort() const
+{
+    return m_serverPort;
+}
+
+/**
+ * Returns the number of viewer instances currently connected to the relay server
+ */
+int IO::DataSources::Relay::viewerCount() const
+{
+    return m_viewers.count();
+}
+
+/**
+ * Returns the total number of (compressed) bytes written to viewer connections since
+ * the application was launched. Useful to judge the bandwidth cost of another seat.
+ */
+quint64 IO::DataSources::Relay::publishedBytes() const
+{
+    return m_publishedBytes;
+}
+
+/**
+ * Returns the address of the ingest node that this viewer connects to
+ */
+QString IO::DataSources::Relay::remoteAddress() const
+{
+    return m_address;
+}
+
+/**
+ * Returns the TCP port of the ingest node that this viewer connects to
+ */
+quint16 IO::DataSources::Relay::tcpPort() const
+{
+    return m_tcpPort;
+}
+
+/**
+ * Returns @c true if we are currently performing a DNS lookup
+ */
+bool IO::DataSources::Relay::lookupActive() const
+{
+    return m_lookupActive;
+}
+
+/**
+ * Returns @c true if the port is greater than 0 and the host address is valid.
+ */
+bool IO::DataSources::Relay::configurationOk() const
+{
+    return tcpPort() > 0 && m_hostExists;
+}
+
+/**
+ * Attempts to connect to the relay server of the configured ingest node. The raw
+ * socket is handed to the I/O manager, which configures the ingestion pipeline for
+ * the relay wire format (see @c IO::Manager::connectDevice()).
+ */
+QIODevice *IO::DataSources::Relay::openNetworkPort()
+{
+    disconnectDevice();
+
+    auto hostAddr = remoteAddress();
+    if (hostAddr.isEmpty())
+        hostAddr = defaultAddress();
+
+    m_socket.connectToHost(hostAddr, tcpPort());
+    return &m_socket;
+}
+
+/**
+ * Disconnects the viewer socket from the ingest node
+ */
+void IO::DataSources::Relay::disconnectDevice()
+{
+    m_socket.abort();
+    m_socket.disconnectFromHost();
+}
+
+/**
+ * Performs a DNS lookup for the given @a host name
+ */
+void IO::DataSources::Relay::lookup(const QString &host)
+{
+    m_lookupActive = true;
+    Q_EMIT lookupActiveChanged();
+    QHostInfo::lookupHost(host.simplified(), this,
+                          &IO::DataSources::Relay::lookupFinished);
+}
+
+/**
+ * Enables/disables the relay server. While enabled, every frame batch extracted by
+ * the I/O manager is re-published to the connected viewer instances.
+ */
+void IO::DataSources::Relay::setServerEnabled(const bool enabled)
+{
+    if (m_serverEnabled == enabled)
+        return;
+
+    // Start listening for viewer connections
+    if (enabled)
+    {
+        if (!m_server.listen(QHostAddress::Any, m_serverPort))
+        {
+            Misc::Utilities::showMessageBox(tr("Relay server error"),
+                                            m_server.errorString());
+            Q_EMIT serverEnabledChanged();
+            return;
+        }
+    }
+
+    // Stop the server & drop every viewer connection
+    else
+    {
+        m_server.close();
+        for (int i = 0; i < m_viewers.count(); ++i)
+        {
+            m_viewers.at(i)->abort();
+            m_viewers.at(i)->deleteLater();
+        }
+
+        m_viewers.clear();
+        Q_EMIT viewerCountChanged();
+    }
+
+    m_serverEnabled = enabled;
+    Q_EMIT serverEnabledChanged();
+}
+
+/**
+ * Changes the TCP port that the relay server listens on. The server is restarted if
+ * it is currently enabled.
+ */
+void IO::DataSources::Relay::setServerPort(const quint16 port)
+{
+    m_serverPort = port;
+    Q_EMIT serverPortChanged();
+
+    if (m_serverEnabled)
+    {
+        setServerEnabled(false);
+        setServerEnabled(true);
+    }
+}
+
+/**
+ * Changes the TCP port of the ingest node that this viewer connects to
+ */
+void IO::DataSources::Relay::setTcpPort(const quint16 port)
+{
+    m_tcpPort = port;
+    Q_EMIT portChanged();
+}
+
+/**
+ * Sets the IPv4 or IPv6 address of the ingest node
+ */
+void IO::DataSources::Relay::setRemoteAddress(const QString &address)
+{
+    // Check if host name exists
+    if (QHostAddress(address).isNull())
+    {
+        m_hostExists = false;
+        lookup(address);
+    }
+
+    // Host is an IP address, host should exist
+    else
+        m_hostExists = true;
+
+    // Change host
+    m_address = address;
+    Q_EMIT addressChanged();
+}
+
+/**
+ * Registers a new viewer connection. Nagle's algorithm is disabled on the viewer
+ * socket, telemetry batches are small & latency sensitive.
+ */
+void IO::DataSources::Relay::onNewViewerConnection()
+{
+    while (m_server.hasPendingConnections())
+    {
+        auto *socket = m_server.nextPendingConnection();
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(socket, &QTcpSocket::disconnected, this,
+                &IO::DataSources::Relay::onViewerDisconnected);
+
+        m_viewers.append(socket);
+    }
+
+    Q_EMIT viewerCountChanged();
+}
+
+/**
+ * Unregisters & deletes a viewer connection once it disconnects
+ */
+void IO::DataSources::Relay::onViewerDisconnected()
+{
+    auto *socket = qobject_cast<QTcpSocket *>(sender());
+    if (socket)
+    {
+        m_viewers.removeAll(socket);
+        socket->deleteLater();
+        Q_EMIT viewerCountChanged();
+    }
+}
+
+/**
+ * Sets the host IP address when the lookup finishes.
+ */
+void IO::DataSources::Relay::lookupFinished(const QHostInfo &info)
+{
+    m_lookupActive = false;
+    Q_EMIT lookupActiveChanged();
+
+    if (info.error() == QHostInfo::NoError)
+    {
+        auto addresses = info.addresses();
+        if (addresses.count() >= 1)
+        {
+            m_hostExists = true;
+            Q_EMIT addressChanged();
+            return;
+        }
+    }
+}
+
+/**
+ * Serializes the given batch of validated @a frames into the relay wire format & writes
+ * the resulting compressed block to every connected viewer. One block per batch keeps
+ * the syscall count independent of the number of frames a burst contains; compression
+ * keeps the bandwidth cost of an extra seat low (telemetry compresses ~10:1).
+ *
+ * Frames larger than 65535 bytes cannot be carried by the 16-bit record length & are
+ * skipped, such frames cannot be produced by any of the supported framing modes.
+ */
+void IO::DataSources::Relay::onFrameBatchReceived(const QVector<QByteArray> &frames)
+{
+    // Nobody is watching, publishing would only waste CPU time on compression
+    if (m_viewers.isEmpty() || frames.isEmpty())
+        return;
+
+    // Serialize the batch as a run of length-prefixed records
+    QByteArray records;
+    const auto magic = frameMagic().toUtf8();
+    for (int i = 0; i < frames.count(); ++i)
+    {
+        const auto &frame = frames.at(i);
+        if (frame.size() > 0xFFFF)
+            continue;
+
+        const auto crc = crc16(frame.constData(), frame.size());
+        records.append(magic);
+        records.append(static_cast<char>(frame.size() & 0xff));
+        records.append(static_cast<char>((frame.size() >> 8) & 0xff));
+        records.append(frame);
+        records.append(static_cast<char>((crc >> 8) & 0xff));
+        records.append(static_cast<char>(crc & 0xff));
+    }
+
+    // Wrap the records in a compressed stream block
+    const auto payload = qCompress(records);
+    QByteArray block(RELAY_STREAM_MAGIC, sizeof(RELAY_STREAM_MAGIC));
+    block.append(4, '\0');
+    qToBigEndian<quint32>(payload.size(),
+                          reinterpret_cast<uchar *>(block.data())
+                              + sizeof(RELAY_STREAM_MAGIC));
+    block.append(payload);
+
+    // Write the block to every connected viewer
+    for (int i = 0; i < m_viewers.count(); ++i)
+    {
+        if (m_viewers.at(i)->state() == QAbstractSocket::ConnectedState)
+        {
+            m_viewers.at(i)->write(block);
+            m_publishedBytes += block.size();
+        }
+    }
+
+    Q_EMIT publishedBytesChanged();
+}
+
+/**
+ * This function is called whenever an error occurs on the viewer socket, it disconnects
+ * the data source and displays the error in a message box.
+ */
+void IO::DataSources::Relay::onErrorOccurred(
+    const QAbstractSocket::SocketError socketError)
+{
+    Q_UNUSED(socketError)
+
+    Manager::instance().disconnectDevice();
+    Misc::Utilities::showMessageBox(tr("Relay connection error"),
+                                    m_socket.errorString());
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Relay.cpp"
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <DataTypes.h>
+
+#include <QVector>
+#include <QObject>
+#include <QHostInfo>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QByteArray>
+#include <QAbstractSocket>
+
+namespace IO
+{
+namespace DataSources
+{
+/**
+ * @brief The Relay class
+ *
+ * Streams the validated frames of one Serial Studio instance to any number of
+ * viewer instances, so a whole control room can watch the same live dashboard
+ * while only one seat owns the serial port (and without MQTT middleware or one
+ * serial tap per workstation).
+ *
+ * Publisher half: a TCP server that re-publishes every extracted frame batch.
+ * Batches are serialized as length-prefixed binary records behind a fixed
+ * magic (the same record format as the "length-prefixed" framing mode) and
+ * wrapped in compressed stream blocks, so the wire carries batched, validated
+ * & compressed telemetry only.
+ *
+ * Viewer half: a plain TCP client exposed as a data source variant of the I/O
+ * manager. Viewers run the stock ingestion pipeline: the frame reader inflates
+ * the compressed blocks transparently & extracts the CRC-checked records, so
+ * only the display half of the application does any real work. Since frames
+ * were already validated by the ingest node, a viewer never re-runs project
+ * checksums or delimiter searches over raw device data.
+ */
+class Relay : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(bool serverEnabled
+               READ serverEnabled
+               WRITE setServerEnabled
+               NOTIFY serverEnabledChanged)
+    Q_PROPERTY(quint16 serverPort
+               READ serverPort
+               WRITE setServerPort
+               NOTIFY serverPortChanged)
+    Q_PROPERTY(int viewerCount
+               READ viewerCount
+               NOTIFY viewerCountChanged)
+    Q_PROPERTY(quint64 publishedBytes
+               READ publishedBytes
+               NOTIFY publishedBytesChanged)
+    Q_PROPERTY(QString remoteAddress
+               READ remoteAddress
+               WRITE setRemoteAddress
+               NOTIFY addressChanged)
+    Q_PROPERTY(quint16 tcpPort
+               READ tcpPort
+               WRITE setTcpPort
+               NOTIFY portChanged)
+    Q_PROPERTY(bool lookupActive
+               READ lookupActive
+               NOTIFY lookupActiveChanged)
+    Q_PROPERTY(QString defaultAddress
+               READ defaultAddress
+               CONSTANT)
+    Q_PROPERTY(quint16 defaultPort
+               READ defaultPort
+               CONSTANT)
+    // clang-format on
+
+Q_SIGNALS:
+    void portChanged();
+    void addressChanged();
+    void serverPortChanged();
+    void viewerCountChanged();
+    void lookupActiveChanged();
+    void serverEnabledChanged();
+    void publishedBytesChanged();
+
+private:
+    explicit Relay();
+    Relay(Relay &&) = delete;
+    Relay(const Relay &) = delete;
+    Relay &operator=(Relay &&) = delete;
+    Relay &operator=(const Relay &) = delete;
+
+    ~Relay();
+
+public:
+    static Relay &instance();
+
+    bool serverEnabled() const;
+    quint16 serverPort() const;
+    int viewerCount() const;
+    quint64 publishedBytes() const;
+
+    QString remoteAddress() const;
+    quint16 tcpPort() const;
+    bool lookupActive() const;
+    bool configurationOk() const;
+
+    static QString defaultAddress() { return "127.0.0.1"; }
+    static quint16 defaultPort() { return 7878; }
+    static QString frameMagic() { return "@SSR"; }
+
+    QIODevice *openNetworkPort();
+
+public Q_SLOTS:
+    void disconnectDevice();
+    void lookup(const QString &host);
+    void setServerEnabled(const bool enabled);
+    void setServerPort(const quint16 port);
+    void setTcpPort(const quint16 port);
+    void setRemoteAddress(const QString &address);
+
+private Q_SLOTS:
+    void onNewViewerConnection();
+    void onViewerDisconnected();
+    void lookupFinished(const QHostInfo &info);
+    void onFrameBatchReceived(const QVector<QByteArray> &frames);
+    void onErrorOccurred(const QAbstractSocket::SocketError socketError);
+
+private:
+    bool m_serverEnabled;
+    quint16 m_serverPort;
+    quint64 m_publishedBytes;
+
+    QString m_address;
+    quint16 m_tcpPort;
+    bool m_hostExists;
+    bool m_lookupActive;
+
+    QTcpServer m_server;
+    QTcpSocket m_socket;
+    QVector<QTcpSocket *> m_viewers;
+};
+}
+}
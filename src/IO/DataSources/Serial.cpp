@@ -23,15 +23,69 @@
 #include <IO/Manager.h>
 #include <Misc/Utilities.h>
 #include <Misc/TimerEvents.h>
+#include <Misc/SettingsCache.h>
 #include <IO/DataSources/Serial.h>
 
+#include <QFileSystemWatcher>
+
+#ifdef Q_OS_LINUX
+#    include <sys/ioctl.h>
+#    include <linux/serial.h>
+#endif
+
+#ifdef Q_OS_WIN
+#    include <QCoreApplication>
+#    include <QAbstractNativeEventFilter>
+#    include <windows.h>
+#    include <dbt.h>
+
+/**
+ * Native event filter that listens for @c WM_DEVICECHANGE broadcasts, so that
+ * the serial port list is refreshed exactly when a device is plugged in or
+ * removed instead of being polled every second.
+ */
+class SerialDeviceChangeFilter : public QAbstractNativeEventFilter
+{
+public:
+#    if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    bool nativeEventFilter(const QByteArray &type, void *message,
+                           qintptr *result) override
+#    else
+    bool nativeEventFilter(const QByteArray &type, void *message,
+                           long *result) override
+#    endif
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(result);
+
+        auto *msg = static_cast<MSG *>(message);
+        if (msg->message == WM_DEVICECHANGE
+            && (msg->wParam == DBT_DEVICEARRIVAL
+                || msg->wParam == DBT_DEVICEREMOVECOMPLETE))
+            IO::DataSources::Serial::instance().refreshSerialDevices();
+
+        return false;
+    }
+};
+#endif
+
+/*
+ * Read buffer cap applied in low latency mode, small enough that the serial
+ * port layer hands data to the application as soon as it arrives instead of
+ * batching it into large chunks
+ */
+static const qint64 LOW_LATENCY_READ_BUFFER = 16 * 1024;
+
 /**
  * Constructor function
  */
 IO::DataSources::Serial::Serial()
     : m_port(Q_NULLPTR)
     , m_autoReconnect(false)
+    , m_lowLatencyMode(false)
     , m_lastSerialDeviceIndex(0)
+    , m_hotplugMonitoring(false)
+    , m_deviceWatcher(Q_NULLPTR)
     , m_portIndex(0)
 {
     // Read settings
@@ -45,10 +99,17 @@ IO::DataSources::Serial::Serial()
     setParity(parityList().indexOf(tr("None")));
     setFlowControl(flowControlList().indexOf(tr("None")));
 
-    // Build serial devices list and refresh it every second
+    // Build the initial serial devices list & refresh it when the operating
+    // system reports that a device was attached or removed
+    refreshSerialDevices();
+    setupHotplugDetection();
+
+    // Hotplug notifications are not available, fall back to polling the
+    // device list every second
     // clang-format off
-    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
-            this, &IO::DataSources::Serial::refreshSerialDevices);
+    if (!m_hotplugMonitoring)
+        connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
+                this, &IO::DataSources::Serial::refreshSerialDevices);
     // clang-format on
 }
 
@@ -100,6 +161,17 @@ bool IO::DataSources::Serial::autoReconnect() const
     return m_autoReconnect;
 }
 
+/**
+ * Returns @c true if low latency mode is enabled. In this mode the read buffer
+ * of the serial port is capped, the USB-serial adapter latency timer is
+ * reduced to its minimum (Linux only) & the frame reader thread is raised to
+ * time-critical priority, trading CPU efficiency for device-to-screen delay.
+ */
+bool IO::DataSources::Serial::lowLatencyMode() const
+{
+    return m_lowLatencyMode;
+}
+
 /**
  * Returns @c true if the user selects the appropiate controls & options to be able
  * to connect to a serial device
@@ -292,6 +364,12 @@ QSerialPort *IO::DataSources::Serial::openSerialPort()
         port()->setStopBits(stopBits());
         port()->setFlowControl(flowControl());
 
+        // Cap the read buffer so that data is handed to the application as
+        // soon as it arrives (the rest of the low latency tuning needs an
+        // open port & is applied by the I/O manager after opening)
+        if (lowLatencyMode())
+            port()->setReadBufferSize(LOW_LATENCY_READ_BUFFER);
+
         // Connect signals/slots
         connect(port(), SIGNAL(errorOccurred(QSerialPort::SerialPortError)), this,
                 SLOT(handleError(QSerialPort::SerialPortError)));
@@ -501,6 +579,55 @@ void IO::DataSources::Serial::setAutoReconnect(const bool autoreconnect)
     Q_EMIT autoReconnectChanged();
 }
 
+/**
+ * Enables or disables low latency mode, see @c lowLatencyMode() for more
+ * information. If a port is already open, the tuning is applied (or reverted)
+ * immediately; the setting is stored between application runs.
+ */
+void IO::DataSources::Serial::setLowLatencyMode(const bool enabled)
+{
+    // Update flag & save settings
+    m_lowLatencyMode = enabled;
+    writeSettings();
+
+    // Re-configure the currently open port (if any)
+    if (port())
+    {
+        port()->setReadBufferSize(enabled ? LOW_LATENCY_READ_BUFFER : 0);
+        applyLowLatencyTuning();
+    }
+
+    // Notify user interface
+    Q_EMIT lowLatencyModeChanged();
+}
+
+/**
+ * Applies the low latency tuning that requires an open port, called by the
+ * I/O manager once the connection is established.
+ *
+ * On Linux, the @c ASYNC_LOW_LATENCY flag drops the latency timer of
+ * FTDI/CH340-style USB-serial adapters to its 1 ms minimum; without it, the
+ * adapter firmware buffers received data for up to 16 ms before forwarding
+ * it to the host.
+ */
+void IO::DataSources::Serial::applyLowLatencyTuning()
+{
+    // Only valid for open ports with low latency mode enabled
+    if (!port() || !port()->isOpen() || !lowLatencyMode())
+        return;
+
+        // Ask the kernel to forward adapter data with minimum buffering
+#ifdef Q_OS_LINUX
+    struct serial_struct info;
+    const int fd = static_cast<int>(port()->handle());
+    if (ioctl(fd, TIOCGSERIAL, &info) == 0)
+    {
+        info.flags |= ASYNC_LOW_LATENCY;
+        ioctl(fd, TIOCSSERIAL, &info);
+    }
+#endif
+}
+
 /**
  * Changes the flow control option of the serial port.
  *
@@ -537,6 +664,35 @@ void IO::DataSources::Serial::setFlowControl(const quint8 flowControlIndex)
     Q_EMIT flowControlChanged();
 }
 
+/**
+ * Registers for operating system hotplug notifications, so that the serial
+ * device list is re-enumerated exactly when a device is attached or removed.
+ * Enumerating serial ports is not free (on Windows it walks the registry), so
+ * doing it once per second wastes CPU & drains batteries on field laptops.
+ *
+ * On Windows a native event filter listens for @c WM_DEVICECHANGE broadcasts;
+ * on Linux & macOS device nodes appear & disappear under @c /dev, which a
+ * @c QFileSystemWatcher can observe without extra dependencies. If neither
+ * mechanism can be set up, @c m_hotplugMonitoring stays @c false & the
+ * constructor falls back to 1 Hz polling.
+ */
+void IO::DataSources::Serial::setupHotplugDetection()
+{
+#if defined(Q_OS_WIN)
+    static SerialDeviceChangeFilter filter;
+    QCoreApplication::instance()->installNativeEventFilter(&filter);
+    m_hotplugMonitoring = true;
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    m_deviceWatcher = new QFileSystemWatcher(this);
+    if (m_deviceWatcher->addPath("/dev"))
+    {
+        connect(m_deviceWatcher, &QFileSystemWatcher::directoryChanged, this,
+                &IO::DataSources::Serial::refreshSerialDevices);
+        m_hotplugMonitoring = true;
+    }
+#endif
+}
+
 /**
  * Scans for new serial ports available & generates a StringList with current
  * serial ports.
@@ -610,6 +766,11 @@ void IO::DataSources::Serial::handleError(QSerialPort::SerialPortError error)
  */
 void IO::DataSources::Serial::readSettings()
 {
+    // Restore low latency mode preference
+    m_lowLatencyMode = Misc::SettingsCache::instance()
+                           .value("IO_DataSource_Serial__LowLatency", false)
+                           .toBool();
+
     // Register standard baud rates
     QStringList stdBaudRates
         = { "300",   "1200",   "2400",   "4800",   "9600",   "19200",   "38400",  "57600",
@@ -617,7 +778,8 @@ void IO::DataSources::Serial::readSettings()
 
     // Get value from settings
     QStringList list;
-    list = m_settings.value("IO_DataSource_Serial__BaudRates", stdBaudRates)
+    list = Misc::SettingsCache::instance()
+               .value("IO_DataSource_Serial__BaudRates", stdBaudRates)
                .toStringList();
 
     // Convert QStringList to QVector
@@ -671,7 +833,11 @@ void IO::DataSources::Serial::writeSettings()
         list.append(baudRateList().at(i));
 
     // Save list to memory
-    m_settings.setValue("IO_DataSource_Serial__BaudRates", list);
+    Misc::SettingsCache::instance().setValue("IO_DataSource_Serial__BaudRates", list);
+
+    // Save low latency mode preference
+    Misc::SettingsCache::instance().setValue("IO_DataSource_Serial__LowLatency",
+                                             m_lowLatencyMode);
 }
 
 /**
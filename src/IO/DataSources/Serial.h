@@ -26,12 +26,13 @@
 
 #include <QObject>
 #include <QString>
-#include <QSettings>
 #include <QByteArray>
 #include <QtSerialPort>
 #include <QTextCursor>
 #include <QQuickTextDocument>
 
+class QFileSystemWatcher;
+
 namespace IO
 {
 namespace DataSources
@@ -52,6 +53,10 @@ class Serial : public QObject
                READ autoReconnect
                WRITE setAutoReconnect
                NOTIFY autoReconnectChanged)
+    Q_PROPERTY(bool lowLatencyMode
+               READ lowLatencyMode
+               WRITE setLowLatencyMode
+               NOTIFY lowLatencyModeChanged)
     Q_PROPERTY(quint8 portIndex
                READ portIndex
                WRITE setPortIndex
@@ -107,6 +112,7 @@ Q_SIGNALS:
     void baudRateListChanged();
     void autoReconnectChanged();
     void baudRateIndexChanged();
+    void lowLatencyModeChanged();
     void availablePortsChanged();
     void connectionError(const QString &name);
 
@@ -125,6 +131,7 @@ public:
     QString portName() const;
     QSerialPort *port() const;
     bool autoReconnect() const;
+    bool lowLatencyMode() const;
     bool configurationOk() const;
 
     quint8 portIndex() const;
@@ -151,7 +158,10 @@ public:
 
 public Q_SLOTS:
     void disconnectDevice();
+    void refreshSerialDevices();
+    void applyLowLatencyTuning();
     void setBaudRate(const qint32 rate);
+    void setLowLatencyMode(const bool enabled);
     void setParity(const quint8 parityIndex);
     void setPortIndex(const quint8 portIndex);
     void appendBaudRate(const QString &baudRate);
@@ -163,20 +173,25 @@ public Q_SLOTS:
 private Q_SLOTS:
     void readSettings();
     void writeSettings();
-    void refreshSerialDevices();
     void handleError(QSerialPort::SerialPortError error);
 
 private:
+    void setupHotplugDetection();
     QVector<QSerialPortInfo> validPorts() const;
 
 private:
     QSerialPort *m_port;
 
     bool m_autoReconnect;
+    bool m_lowLatencyMode;
     int m_lastSerialDeviceIndex;
 
+    // Hotplug detection state, the watcher is only created on platforms that
+    // report device arrival/removal through the filesystem
+    bool m_hotplugMonitoring;
+    QFileSystemWatcher *m_deviceWatcher;
+
     qint32 m_baudRate;
-    QSettings m_settings;
     QSerialPort::Parity m_parity;
     QSerialPort::DataBits m_dataBits;
     QSerialPort::StopBits m_stopBits;
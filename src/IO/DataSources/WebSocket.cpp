@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstring>
+
+#include <IO/Manager.h>
+#include <Misc/Utilities.h>
+#include <Misc/MemoryRegistry.h>
+#include <IO/DataSources/WebSocket.h>
+
+/**
+ * Upper bound for the amount of un-read data buffered by the device. If the
+ * consumer stalls for longer than this, the oldest data is dropped, which
+ * mimics the overrun behavior of a real UART/socket.
+ */
+static const int kMaxBufferedBytes = 16 * 1024 * 1024;
+
+//----------------------------------------------------------------------------------------
+// WebSocketDevice
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, the device does not own the @a socket, it only uses
+ * it to forward written data to the remote end.
+ */
+IO::DataSources::WebSocketDevice::WebSocketDevice(QWebSocket *socket, QObject *parent)
+    : QIODevice(parent)
+    , m_socket(socket)
+{
+}
+
+/**
+ * The WebSocket source behaves like a stream (serial port/socket), not like a
+ * file
+ */
+bool IO::DataSources::WebSocketDevice::isSequential() const
+{
+    return true;
+}
+
+/**
+ * Returns the number of buffered bytes that have not been read yet
+ */
+qint64 IO::DataSources::WebSocketDevice::bytesAvailable() const
+{
+    return m_buffer.size() + QIODevice::bytesAvailable();
+}
+
+/**
+ * Opens the device & discards any data buffered by a previous session
+ */
+bool IO::DataSources::WebSocketDevice::open(QIODevice::OpenMode mode)
+{
+    m_buffer.clear();
+    return QIODevice::open(mode);
+}
+
+/**
+ * Appends the payload of an incoming WebSocket message to the read buffer &
+ * announces it with @c readyRead()
+ */
+void IO::DataSources::WebSocketDevice::injectData(const QByteArray &data)
+{
+    if (!isOpen())
+        return;
+
+    // Drop the oldest data if the consumer stalled, just like a real device
+    // overruns its FIFO
+    m_buffer.append(data);
+    if (m_buffer.size() > kMaxBufferedBytes)
+        m_buffer.remove(0, m_buffer.size() - kMaxBufferedBytes);
+
+    Misc::MemoryRegistry::instance().report("IO::WebSocket (message buffer)",
+                                            m_buffer.size());
+    Q_EMIT readyRead();
+}
+
+/**
+ * Pops up to @a maxSize buffered bytes into @a data
+ */
+qint64 IO::DataSources::WebSocketDevice::readData(char *data, qint64 maxSize)
+{
+    const qint64 bytes = qMin(maxSize, qint64(m_buffer.size()));
+    if (bytes > 0)
+    {
+        memcpy(data, m_buffer.constData(), size_t(bytes));
+        m_buffer.remove(0, int(bytes));
+    }
+
+    return bytes;
+}
+
+/**
+ * Forwards the written data to the remote end as a binary message
+ */
+qint64 IO::DataSources::WebSocketDevice::writeData(const char *data, qint64 maxSize)
+{
+    if (m_socket->state() == QAbstractSocket::ConnectedState)
+        return m_socket->sendBinaryMessage(QByteArray(data, int(maxSize)));
+
+    return maxSize;
+}
+
+//----------------------------------------------------------------------------------------
+// WebSocket
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::DataSources::WebSocket::WebSocket()
+    : m_url(defaultUrl())
+    , m_device(&m_socket)
+{
+    // Feed the payload of incoming messages into the loopback device, text
+    // messages (the common case for JSON gateways) are converted to UTF-8
+    connect(&m_socket, &QWebSocket::binaryMessageReceived, &m_device,
+            &WebSocketDevice::injectData);
+    connect(&m_socket, &QWebSocket::textMessageReceived, this,
+            &IO::DataSources::WebSocket::onTextMessage);
+
+    // Report connection state changes & errors to the user interface
+    connect(&m_socket, &QWebSocket::connected, this,
+            &IO::DataSources::WebSocket::connectedChanged);
+    connect(&m_socket, &QWebSocket::disconnected, this,
+            &IO::DataSources::WebSocket::connectedChanged);
+    connect(&m_socket, SIGNAL(error(QAbstractSocket::SocketError)), this,
+            SLOT(onError(QAbstractSocket::SocketError)));
+}
+
+/**
+ * Destructor function, closes the WebSocket connection before exiting
+ */
+IO::DataSources::WebSocket::~WebSocket()
+{
+    disconnectDevice();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+IO::DataSources::WebSocket &IO::DataSources::WebSocket::instance()
+{
+    static WebSocket singleton;
+    return singleton;
+}
+
+/**
+ * Returns the URL of the WebSocket server
+ */
+QString IO::DataSources::WebSocket::url() const
+{
+    return m_url;
+}
+
+/**
+ * Returns @c true if the WebSocket is connected to the server
+ */
+bool IO::DataSources::WebSocket::connectedToHost() const
+{
+    return m_socket.state() == QAbstractSocket::ConnectedState;
+}
+
+/**
+ * Returns @c true if the current URL is a valid ws:// or wss:// URL
+ */
+bool IO::DataSources::WebSocket::configurationOk() const
+{
+    const QUrl url(m_url);
+    return url.isValid() && !url.host().isEmpty()
+        && (url.scheme() == "ws" || url.scheme() == "wss");
+}
+
+/**
+ * Opens a WebSocket connection with the current configuration & returns a
+ * pointer to the loopback device. Ownership of the device stays with this
+ * class, the connection is established asynchronously & data starts flowing
+ * as soon as the handshake completes.
+ */
+QIODevice *IO::DataSources::WebSocket::openDevice()
+{
+    // Close any previous connection
+    disconnectDevice();
+
+    // Validate the configured URL
+    if (!configurationOk())
+        return Q_NULLPTR;
+
+    // Open the WebSocket connection. Qt does not implement the
+    // permessage-deflate extension, so bandwidth-starved gateways compress
+    // their telemetry with the block framing understood by the frame reader
+    // instead (see the compressed stream support in IO::FrameReader), which
+    // works transparently inside WebSocket messages as well.
+    m_socket.open(QUrl(m_url));
+
+    // Return pointer, IO::Manager opens the device & hooks up readyRead()
+    return &m_device;
+}
+
+/**
+ * Closes the WebSocket connection & the loopback device
+ */
+void IO::DataSources::WebSocket::disconnectDevice()
+{
+    m_socket.abort();
+    m_device.close();
+    Q_EMIT connectedChanged();
+}
+
+/**
+ * Changes the URL of the WebSocket server
+ */
+void IO::DataSources::WebSocket::setUrl(const QString &url)
+{
+    m_url = url.simplified();
+    Q_EMIT urlChanged();
+}
+
+/**
+ * Feeds the payload of an incoming text message into the loopback device
+ */
+void IO::DataSources::WebSocket::onTextMessage(const QString &message)
+{
+    m_device.injectData(message.toUtf8());
+}
+
+/**
+ * Notifies the user of connection errors & lets the I/O manager close the
+ * device
+ */
+void IO::DataSources::WebSocket::onError(QAbstractSocket::SocketError error)
+{
+    Q_UNUSED(error);
+
+    Misc::Utilities::showMessageBox(tr("WebSocket connection error"),
+                                    m_socket.errorString());
+    Manager::instance().disconnectDevice();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_WebSocket.cpp"
+#endif
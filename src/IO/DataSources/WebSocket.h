@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <DataTypes.h>
+
+#include <QUrl>
+#include <QObject>
+#include <QIODevice>
+#include <QByteArray>
+#include <QWebSocket>
+#include <QAbstractSocket>
+
+namespace IO
+{
+namespace DataSources
+{
+/**
+ * @brief The WebSocketDevice class
+ *
+ * Minimal sequential @c QIODevice that buffers the payloads of incoming
+ * WebSocket messages & announces them with @c readyRead(), so the WebSocket
+ * source plugs into the regular @c IO::Manager device handling (readAll() &
+ * the ingestion pipeline) exactly like a serial port or a network socket.
+ * Written data is forwarded to the remote end as binary messages.
+ */
+class WebSocketDevice : public QIODevice
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+public:
+    explicit WebSocketDevice(QWebSocket *socket, QObject *parent = Q_NULLPTR);
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    bool open(QIODevice::OpenMode mode) override;
+
+public Q_SLOTS:
+    void injectData(const QByteArray &data);
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    QWebSocket *m_socket;
+    QByteArray m_buffer;
+};
+
+/**
+ * @brief The WebSocket class
+ *
+ * Serial Studio "driver" class to receive telemetry from WebSocket servers
+ * (e.g. cloud gateways), without running a local WebSocket-to-TCP proxy next
+ * to every seat. Incoming text & binary messages are fed into the same frame
+ * scanner as serial/network data.
+ */
+class WebSocket : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(QString url
+               READ url
+               WRITE setUrl
+               NOTIFY urlChanged)
+    Q_PROPERTY(bool connectedToHost
+               READ connectedToHost
+               NOTIFY connectedChanged)
+    Q_PROPERTY(QString defaultUrl
+               READ defaultUrl
+               CONSTANT)
+    // clang-format on
+
+Q_SIGNALS:
+    void urlChanged();
+    void connectedChanged();
+
+private:
+    explicit WebSocket();
+    WebSocket(WebSocket &&) = delete;
+    WebSocket(const WebSocket &) = delete;
+    WebSocket &operator=(WebSocket &&) = delete;
+    WebSocket &operator=(const WebSocket &) = delete;
+
+    ~WebSocket();
+
+public:
+    static WebSocket &instance();
+
+    QString url() const;
+    bool connectedToHost() const;
+    bool configurationOk() const;
+
+    static QString defaultUrl() { return "ws://localhost:9000"; }
+
+    QIODevice *openDevice();
+
+public Q_SLOTS:
+    void disconnectDevice();
+    void setUrl(const QString &url);
+
+private Q_SLOTS:
+    void onTextMessage(const QString &message);
+    void onError(QAbstractSocket::SocketError error);
+
+private:
+    QString m_url;
+
+    QWebSocket m_socket;
+    WebSocketDevice m_device;
+};
+}
+}
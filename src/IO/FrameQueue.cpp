@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <IO/FrameQueue.h>
+
+/**
+ * Constructor function, rounds the requested @a capacity up to the next power of two
+ * & initializes the per-cell sequence counters.
+ */
+IO::FrameQueue::FrameQueue(const int capacity)
+    : m_droppedFrames(0)
+{
+    // Round capacity up to the next power of two (required by the index mask)
+    quint32 size = 2;
+    while (size < static_cast<quint32>(qMax(2, capacity)))
+        size <<= 1;
+
+    m_mask = size - 1;
+    m_cells.resize(size);
+    for (quint32 i = 0; i < size; ++i)
+        m_cells[i].sequence.storeRelease(i);
+
+    m_enqueuePos.storeRelease(0);
+    m_dequeuePos.storeRelease(0);
+}
+
+/**
+ * Returns the maximum number of frames that the queue can hold
+ */
+int IO::FrameQueue::capacity() const
+{
+    return static_cast<int>(m_mask + 1);
+}
+
+/**
+ * Returns the number of frames dropped because the consumer could not keep up
+ */
+quint64 IO::FrameQueue::droppedFrames() const
+{
+    return m_droppedFrames.loadAcquire();
+}
+
+/**
+ * Discards all queued frames. Only meant to be called while the producer thread is
+ * not enqueueing (e.g. when a device is disconnected).
+ */
+void IO::FrameQueue::clear()
+{
+    QByteArray frame;
+    while (tryDequeue(frame))
+        frame.clear();
+}
+
+/**
+ * Inserts the given @a frame into the queue. If the queue is full, the oldest queued
+ * frame is dropped (and counted) to make room, so a burst can never stall the producer
+ * thread or pile up unbounded work for the consumer.
+ */
+void IO::FrameQueue::enqueue(const QByteArray &frame)
+{
+    while (true)
+    {
+        auto pos = m_enqueuePos.loadAcquire();
+        auto &cell = m_cells[pos & m_mask];
+        auto seq = cell.sequence.loadAcquire();
+        auto dif = static_cast<qint32>(seq - pos);
+
+        // Cell is free, try to claim it
+        if (dif == 0)
+        {
+            if (m_enqueuePos.testAndSetOrdered(pos, pos + 1))
+            {
+                cell.data = frame;
+                cell.sequence.storeRelease(pos + 1);
+                return;
+            }
+        }
+
+        // Queue is full, drop the oldest frame & retry
+        else if (dif < 0)
+        {
+            QByteArray dropped;
+            if (tryDequeue(dropped))
+                m_droppedFrames.fetchAndAddOrdered(1);
+        }
+    }
+}
+
+/**
+ * Removes the oldest frame from the queue & copies it to @a frame. Returns @c false
+ * if the queue is empty.
+ */
+bool IO::FrameQueue::dequeue(QByteArray &frame)
+{
+    return tryDequeue(frame);
+}
+
+/**
+ * Removes up to @a maxFrames frames from the queue & appends them to @a frames.
+ * Returns the number of frames actually dequeued.
+ */
+int IO::FrameQueue::dequeue(QVector<QByteArray> &frames, const int maxFrames)
+{
+    int count = 0;
+    QByteArray frame;
+    while (count < maxFrames && tryDequeue(frame))
+    {
+        frames.append(frame);
+        ++count;
+    }
+
+    return count;
+}
+
+/**
+ * Implementation of the dequeue operation, see Dmitry Vyukov's bounded MPMC queue for
+ * the algorithm description.
+ */
+bool IO::FrameQueue::tryDequeue(QByteArray &frame)
+{
+    while (true)
+    {
+        auto pos = m_dequeuePos.loadAcquire();
+        auto &cell = m_cells[pos & m_mask];
+        auto seq = cell.sequence.loadAcquire();
+        auto dif = static_cast<qint32>(seq - (pos + 1));
+
+        // Cell holds data, try to claim it
+        if (dif == 0)
+        {
+            if (m_dequeuePos.testAndSetOrdered(pos, pos + 1))
+            {
+                frame = cell.data;
+                cell.data = QByteArray();
+                cell.sequence.storeRelease(pos + m_mask + 1);
+                return true;
+            }
+        }
+
+        // Queue is empty
+        else if (dif < 0)
+            return false;
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QVector>
+#include <QByteArray>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+
+namespace IO
+{
+/**
+ * @brief The FrameQueue class
+ *
+ * Bounded lock-free queue of frame buffers between the frame reader thread
+ * (producer) and the GUI thread (consumer). The implementation follows the
+ * bounded MPMC queue described by Dmitry Vyukov, each cell carries a sequence
+ * counter so that no mutex is ever taken on the hot path.
+ *
+ * When a burst fills the queue faster than the GUI thread can drain it, the
+ * producer drops the *oldest* frames to make room and counts the drops, so
+ * the event loop never backs up behind an unbounded pile of pending events.
+ * QByteArray payloads are implicitly shared, enqueueing never copies frame
+ * data.
+ */
+class FrameQueue
+{
+public:
+    FrameQueue(const int capacity = 4096);
+
+    int capacity() const;
+    quint64 droppedFrames() const;
+
+    void clear();
+    void enqueue(const QByteArray &frame);
+    bool dequeue(QByteArray &frame);
+    int dequeue(QVector<QByteArray> &frames, const int maxFrames);
+
+private:
+    struct Cell
+    {
+        QAtomicInteger<quint32> sequence;
+        QByteArray data;
+    };
+
+private:
+    bool tryDequeue(QByteArray &frame);
+
+private:
+    quint32 m_mask;
+    QVector<Cell> m_cells;
+    QAtomicInteger<quint32> m_enqueuePos;
+    QAtomicInteger<quint32> m_dequeuePos;
+    QAtomicInteger<quint64> m_droppedFrames;
+};
+}
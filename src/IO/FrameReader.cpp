@@ -0,0 +1,1036 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ * Copyright (c) 2021 JP Norair <https://github.com/jpnorair>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include <QtEndian>
+#include <QElapsedTimer>
+
+#include <IO/Checksum.h>
+#include <IO/FrameQueue.h>
+#include <IO/FrameReader.h>
+#include <Misc/MemoryRegistry.h>
+
+/*
+ * Framing of compressed data streams: every block starts with this magic,
+ * followed by a big-endian 32-bit payload length & a zlib-compressed payload
+ * (as produced by @c qCompress). A stream whose first bytes match the magic
+ * is treated as compressed, so plain streams keep working without any
+ * negotiation or configuration.
+ */
+static const char COMPRESSED_STREAM_MAGIC[4] = { 'S', 'S', 'C', '1' };
+static const int COMPRESSED_BLOCK_HEADER = sizeof(COMPRESSED_STREAM_MAGIC) + 4;
+
+/*
+ * Upper bound for the compressed payload length field, blocks that claim to
+ * be larger are treated as stream corruption & skipped
+ */
+static const quint32 MAX_COMPRESSED_BLOCK = 32 * 1024 * 1024;
+
+/*
+ * Adaptive sizing bounds of the temporary RX buffer. The buffer starts at the minimum
+ * capacity (plenty for low baud rates) & doubles whenever incoming data would not fit,
+ * up to the cap configured through @c setMaxBufferSize(). When the observed peak usage
+ * stays below a quarter of the capacity for a full observation window, the capacity is
+ * halved again so bursty sessions do not pin memory forever.
+ */
+static const int MIN_BUFFER_CAPACITY = 64 * 1024;
+static const int SHRINK_WINDOW_MSECS = 10 * 1000;
+
+/**
+ * Decodes a COBS-encoded block (without the trailing zero delimiter) into @a out.
+ * Returns @c false if the encoded data is malformed. The unstuffing loop is kept
+ * branch-light & operates on raw pointers so the compiler can keep it in registers.
+ */
+static bool COBS_DECODE(const QByteArray &in, QByteArray &out)
+{
+    out.clear();
+    out.reserve(in.size());
+
+    int i = 0;
+    const auto *data = reinterpret_cast<const quint8 *>(in.constData());
+    while (i < in.size())
+    {
+        // Read the next code byte, zeroes cannot appear inside an encoded block
+        const quint8 code = data[i++];
+        if (code == 0x00)
+            return false;
+
+        // Copy the (code - 1) literal bytes that follow
+        const int count = code - 1;
+        if (i + count > in.size())
+            return false;
+        out.append(in.constData() + i, count);
+        i += count;
+
+        // A code below 0xFF encodes an implicit zero (except at the end of the block)
+        if (code != 0xFF && i < in.size())
+            out.append('\0');
+    }
+
+    return true;
+}
+
+/**
+ * Decodes a SLIP-encoded block (without the END delimiter) into @a out. Returns
+ * @c false if the encoded data contains an invalid escape sequence.
+ */
+static bool SLIP_DECODE(const QByteArray &in, QByteArray &out)
+{
+    out.clear();
+    out.reserve(in.size());
+
+    const auto *data = reinterpret_cast<const quint8 *>(in.constData());
+    for (int i = 0; i < in.size(); ++i)
+    {
+        // Escape sequence, decode the stuffed END/ESC byte
+        if (data[i] == 0xDB)
+        {
+            if (++i >= in.size())
+                return false;
+
+            if (data[i] == 0xDC)
+                out.append(static_cast<char>(0xC0));
+            else if (data[i] == 0xDD)
+                out.append(static_cast<char>(0xDB));
+            else
+                return false;
+        }
+
+        // Literal byte
+        else
+            out.append(static_cast<char>(data[i]));
+    }
+
+    return true;
+}
+
+/**
+ * Constructor function, initializes the default frame delimiters & buffer size.
+ * Extracted frames are pushed into the given @a queue, which is owned by the
+ * I/O manager.
+ */
+IO::FrameReader::FrameReader(FrameQueue *queue, QObject *parent)
+    : QObject(parent)
+    , m_startIndex(-1)
+    , m_scanPosition(0)
+    , m_frameQueue(queue)
+    , m_frameMode(FrameMode::TextDelimiters)
+    , m_dataBuffer(MIN_BUFFER_CAPACITY)
+    , m_startMatcher("/*")
+    , m_finishMatcher("*/")
+    , m_crcStreaming(false)
+    , m_crcPosition(0)
+    , m_crc8State(0xff)
+    , m_crc16State(0xffff)
+    , m_crc32State(0xffffffff)
+    , m_crcType(ChecksumType::None)
+    , m_pendingBytes(0)
+    , m_coalesceBytes(4096)
+    , m_coalesceUsecs(1000)
+    , m_bufferCap(1024 * 1024)
+    , m_windowPeak(0)
+    , m_streamChecked(false)
+    , m_streamCompressed(false)
+    , m_frameCount(0)
+    , m_resyncCount(0)
+    , m_scanTimeUsecs(0)
+    , m_scanEventCount(0)
+    , m_checksumErrorCount(0)
+    , m_bufferHighWater(0)
+    , m_overflowBytes(0)
+{
+    // Configure the coalescing flush timer, the timer only runs while scanning is
+    // being deferred during a readyRead storm
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_flushTimer, &QTimer::timeout, this, &IO::FrameReader::scanBuffer);
+}
+
+/**
+ * Returns the total number of frames extracted since the application was started.
+ * Thread-safe, meant to be polled from the GUI thread by the statistics code.
+ */
+quint64 IO::FrameReader::frameCount() const
+{
+    return m_frameCount.loadAcquire();
+}
+
+/**
+ * Returns the number of times the scanner re-synchronized at the next start-sequence
+ * candidate after rejecting a corrupt region.
+ * Thread-safe, meant to be polled from the GUI thread by the statistics code.
+ */
+quint64 IO::FrameReader::resyncCount() const
+{
+    return m_resyncCount.loadAcquire();
+}
+
+/**
+ * Returns the total time (in microseconds) spent scanning for frames.
+ * Thread-safe, meant to be polled from the GUI thread by the statistics code.
+ */
+quint64 IO::FrameReader::scanTimeUsecs() const
+{
+    return m_scanTimeUsecs.loadAcquire();
+}
+
+/**
+ * Returns the number of data batches processed by @c processData().
+ * Thread-safe, meant to be polled from the GUI thread by the statistics code.
+ */
+quint64 IO::FrameReader::scanEventCount() const
+{
+    return m_scanEventCount.loadAcquire();
+}
+
+/**
+ * Returns the total number of frames rejected because of a checksum mismatch.
+ * Thread-safe, meant to be polled from the GUI thread by the statistics code.
+ */
+quint64 IO::FrameReader::checksumErrorCount() const
+{
+    return m_checksumErrorCount.loadAcquire();
+}
+
+/**
+ * Returns the largest number of bytes that the temporary buffer has ever held. A high
+ * water mark close to the buffer cap indicates that the cap should be raised.
+ * Thread-safe, meant to be polled from the GUI thread by the statistics code.
+ */
+quint64 IO::FrameReader::bufferHighWaterMark() const
+{
+    return m_bufferHighWater.loadAcquire();
+}
+
+/**
+ * Returns the total number of bytes discarded because the temporary buffer overflowed
+ * after growing to its cap. A non-zero count means that frame data was silently lost.
+ * Thread-safe, meant to be polled from the GUI thread by the statistics code.
+ */
+quint64 IO::FrameReader::bufferOverflowBytes() const
+{
+    return m_overflowBytes.loadAcquire();
+}
+
+/**
+ * Deletes the contents of the temporary buffer & disables CRC checking. This function is
+ * called automatically by the I/O manager when a device is disconnected.
+ */
+void IO::FrameReader::reset()
+{
+    m_startIndex = -1;
+    m_scanPosition = 0;
+    m_pendingBytes = 0;
+    m_crcStreaming = false;
+    m_crcType = ChecksumType::None;
+    m_dataBuffer.clear();
+    m_flushTimer.stop();
+
+    // Restart the adaptive-sizing observation window, grown capacity is kept so
+    // that a quick reconnect does not have to climb back up during the next burst
+    m_windowPeak = 0;
+    m_lowUseTimer.invalidate();
+
+    // Re-detect stream compression on the next connection
+    m_streamChecked = false;
+    m_streamCompressed = false;
+    m_streamBuffer.clear();
+}
+
+/**
+ * Entry point for incoming device data. The first bytes of every connection are
+ * inspected for the compressed-stream magic prefix: streams that carry it are
+ * inflated block by block before reaching the frame scanner (bandwidth-starved
+ * links compress telemetry ~10:1), anything else takes the plain path with no
+ * per-chunk overhead beyond a single boolean check.
+ *
+ * The (possibly inflated) data is appended to the temporary buffer & a frame scan
+ * is scheduled. During a readyRead storm (e.g. a serial port at multi-megabaud rates delivering a few hundred
+ * bytes per notification), scanning is deferred until either @c m_coalesceBytes bytes
+ * have accumulated or @c m_coalesceUsecs microseconds have passed, so a sustained burst
+ * is scanned in large batches instead of once per notification. When data arrives
+ * slowly, every batch is scanned immediately & no latency is added.
+ *
+ * If a burst does not fit in the temporary buffer, the buffer grows geometrically up
+ * to the configured cap; once at the cap, the circular buffer automatically drops the
+ * oldest bytes (the discarded byte count is exposed in the ingestion statistics), so
+ * no overflow check is required here.
+ */
+void IO::FrameReader::processData(const QByteArray &data)
+{
+    // Plain stream already detected, feed the scanner directly (common case)
+    if (m_streamChecked && !m_streamCompressed)
+    {
+        ingestData(data);
+        return;
+    }
+
+    // Accumulate data until the magic prefix of compressed streams can be
+    // checked, streams shorter than the magic would stall here, but no frame
+    // could ever be extracted from them anyway
+    m_streamBuffer.append(data);
+    if (!m_streamChecked)
+    {
+        if (m_streamBuffer.size() < int(sizeof(COMPRESSED_STREAM_MAGIC)))
+            return;
+
+        // Decide once per connection & release the held-back data of plain
+        // streams immediately
+        m_streamChecked = true;
+        m_streamCompressed = (memcmp(m_streamBuffer.constData(),
+                                     COMPRESSED_STREAM_MAGIC,
+                                     sizeof(COMPRESSED_STREAM_MAGIC))
+                              == 0);
+        if (!m_streamCompressed)
+        {
+            const auto plain = m_streamBuffer;
+            m_streamBuffer.clear();
+            ingestData(plain);
+            return;
+        }
+    }
+
+    // Compressed stream, inflate every complete block into the scanner
+    drainCompressedBlocks();
+}
+
+/**
+ * Decodes the complete compressed blocks accumulated in the stream buffer &
+ * hands the inflated payloads to the frame scanner. Incomplete blocks stay in
+ * the buffer until the rest of their data arrives; corrupted block headers
+ * are skipped by re-synchronizing on the next magic prefix.
+ */
+void IO::FrameReader::drainCompressedBlocks()
+{
+    while (m_streamBuffer.size() >= COMPRESSED_BLOCK_HEADER)
+    {
+        // Re-synchronize on the magic prefix after stream corruption
+        if (memcmp(m_streamBuffer.constData(), COMPRESSED_STREAM_MAGIC,
+                   sizeof(COMPRESSED_STREAM_MAGIC))
+            != 0)
+        {
+            const auto next = m_streamBuffer.indexOf(
+                QByteArray(COMPRESSED_STREAM_MAGIC,
+                           sizeof(COMPRESSED_STREAM_MAGIC)),
+                1);
+            if (next < 0)
+            {
+                m_streamBuffer.clear();
+                return;
+            }
+
+            m_streamBuffer.remove(0, next);
+            continue;
+        }
+
+        // Read & validate the payload length field
+        const auto length = qFromBigEndian<quint32>(
+            reinterpret_cast<const uchar *>(m_streamBuffer.constData())
+            + sizeof(COMPRESSED_STREAM_MAGIC));
+        if (length == 0 || length > MAX_COMPRESSED_BLOCK)
+        {
+            m_streamBuffer.remove(0, sizeof(COMPRESSED_STREAM_MAGIC));
+            continue;
+        }
+
+        // Wait for the rest of the block to arrive
+        if (m_streamBuffer.size() < COMPRESSED_BLOCK_HEADER + int(length))
+            return;
+
+        // Inflate the payload & remove the block from the stream buffer
+        const auto payload = qUncompress(
+            reinterpret_cast<const uchar *>(m_streamBuffer.constData())
+                + COMPRESSED_BLOCK_HEADER,
+            int(length));
+        m_streamBuffer.remove(0, COMPRESSED_BLOCK_HEADER + int(length));
+
+        // Feed the inflated data to the frame scanner, decompression failures
+        // yield an empty payload & the block is dropped
+        if (!payload.isEmpty())
+            ingestData(payload);
+    }
+}
+
+/**
+ * Appends the given (plain or inflated) @a data to the temporary buffer &
+ * schedules a frame scan, see @c processData() for the coalescing details.
+ */
+void IO::FrameReader::ingestData(const QByteArray &data)
+{
+    // Grow the buffer geometrically when the incoming data would not fit, up to the
+    // configured cap. Growing preserves the stored data, so logical scan positions
+    // are unaffected.
+    const auto required = m_dataBuffer.size() + data.size();
+    if (required > m_dataBuffer.capacity() && m_dataBuffer.capacity() < m_bufferCap)
+    {
+        auto capacity = m_dataBuffer.capacity();
+        while (capacity < required && capacity < m_bufferCap)
+            capacity *= 2;
+
+        m_dataBuffer.resizePreserving(qMin(capacity, m_bufferCap));
+        m_lowUseTimer.restart();
+        m_windowPeak = m_dataBuffer.size();
+    }
+
+    // Account for bytes that the circular buffer will drop on overflow, logical
+    // scan positions shift down by the number of dropped bytes
+    auto dropped = m_dataBuffer.size() + data.size() - m_dataBuffer.capacity();
+    if (dropped > 0)
+    {
+        m_overflowBytes.fetchAndAddRelaxed(dropped);
+        m_scanPosition = qMax(0, m_scanPosition - dropped);
+        m_crcPosition = qMax(0, m_crcPosition - dropped);
+        if (m_startIndex >= 0)
+        {
+            m_startIndex -= dropped;
+            if (m_startIndex < 0)
+            {
+                m_startIndex = -1;
+                m_scanPosition = 0;
+                m_crcStreaming = false;
+            }
+        }
+    }
+
+    // Append incoming data to the temporary buffer
+    m_dataBuffer.append(data);
+    m_pendingBytes += data.size();
+    Misc::MemoryRegistry::instance().report("IO::FrameReader (scan buffer)",
+                                            m_dataBuffer.size());
+
+    // Update the peak-usage figures (observation window & all-time high water mark)
+    if (m_dataBuffer.size() > m_windowPeak)
+        m_windowPeak = m_dataBuffer.size();
+    if (quint64(m_dataBuffer.size()) > m_bufferHighWater.loadAcquire())
+        m_bufferHighWater.storeRelease(m_dataBuffer.size());
+
+    // Measure the time since the previous batch arrived, slow arrival rates take the
+    // immediate (low latency) path
+    qint64 arrivalUsecs = m_coalesceUsecs;
+    if (m_lastArrival.isValid())
+        arrivalUsecs = m_lastArrival.nsecsElapsed() / 1000;
+    m_lastArrival.restart();
+
+    // Scan immediately when coalescing is disabled, when enough bytes have piled up
+    // or when the arrival rate is low enough that deferring would only add latency
+    if (m_coalesceUsecs <= 0 || m_pendingBytes >= m_coalesceBytes
+        || arrivalUsecs >= m_coalesceUsecs)
+    {
+        m_flushTimer.stop();
+        scanBuffer();
+    }
+
+    // High arrival rate, defer the scan & (re)use the flush timer as a latency bound
+    else if (!m_flushTimer.isActive())
+        m_flushTimer.start(qMax(1, m_coalesceUsecs / 1000));
+}
+
+/**
+ * Changes the read-coalescing parameters, scanning is deferred until @a bytes bytes
+ * have accumulated or @a usecs microseconds have passed (whichever comes first). Set
+ * @a usecs to 0 to disable coalescing & scan on every readyRead notification.
+ */
+void IO::FrameReader::setCoalesceSettings(const int bytes, const int usecs)
+{
+    m_coalesceBytes = qMax(1, bytes);
+    m_coalesceUsecs = qMax(0, usecs);
+    if (m_coalesceUsecs <= 0 && m_flushTimer.isActive())
+    {
+        m_flushTimer.stop();
+        scanBuffer();
+    }
+}
+
+/**
+ * Extracts all the frames contained in the temporary buffer. Extracted frames are
+ * pushed into the shared frame queue & the I/O manager is woken up with a single
+ * (payload-free) queued event per batch.
+ */
+void IO::FrameReader::scanBuffer()
+{
+    // Measure the time spent scanning this batch (for the statistics counters)
+    QElapsedTimer timer;
+    timer.start();
+
+    // Obtain frames from the data buffer
+    QVector<QByteArray> frames;
+    readFrames(frames);
+    m_pendingBytes = 0;
+
+    // Shrink the buffer after sustained low use, the capacity is halved when the peak
+    // usage of a full observation window stayed below a quarter of the capacity (the
+    // remaining data is guaranteed to fit, so logical scan positions are unaffected)
+    if (!m_lowUseTimer.isValid())
+        m_lowUseTimer.restart();
+
+    else if (m_lowUseTimer.elapsed() >= SHRINK_WINDOW_MSECS)
+    {
+        const auto capacity = m_dataBuffer.capacity();
+        if (capacity > MIN_BUFFER_CAPACITY && m_windowPeak <= capacity / 4)
+            m_dataBuffer.resizePreserving(qMax(MIN_BUFFER_CAPACITY, capacity / 2));
+
+        m_lowUseTimer.restart();
+        m_windowPeak = m_dataBuffer.size();
+    }
+
+    // Update the statistics counters (plain atomic adds, no locks on the hot path)
+    m_scanEventCount.fetchAndAddRelaxed(1);
+    m_frameCount.fetchAndAddRelaxed(frames.count());
+    m_scanTimeUsecs.fetchAndAddRelaxed(timer.nsecsElapsed() / 1000);
+
+    // Push the frames into the shared queue & notify the I/O manager. QByteArray is
+    // implicitly shared, enqueueing does not copy frame data.
+    if (!frames.isEmpty())
+    {
+        for (int i = 0; i < frames.count(); ++i)
+            m_frameQueue->enqueue(frames.at(i));
+
+        Q_EMIT framesQueued();
+    }
+}
+
+/**
+ * Changes the framing mode used to extract frames from the data stream. Check the
+ * @c IO::Manager::frameMode() function for more information.
+ */
+void IO::FrameReader::setFrameMode(const int mode)
+{
+    m_startIndex = -1;
+    m_scanPosition = 0;
+    m_crcStreaming = false;
+    m_frameMode = static_cast<FrameMode>(mode);
+}
+
+/**
+ * Changes the maximum permited size of the temporary buffer. The buffer is reset to
+ * the minimum capacity & only grows back towards the new cap under actual pressure,
+ * so low-rate sessions never pay for a generous cap.
+ */
+void IO::FrameReader::setMaxBufferSize(const int maxBufferSize)
+{
+    m_startIndex = -1;
+    m_scanPosition = 0;
+    m_windowPeak = 0;
+    m_lowUseTimer.invalidate();
+    m_bufferCap = qMax(MIN_BUFFER_CAPACITY, maxBufferSize);
+    m_dataBuffer.setCapacity(MIN_BUFFER_CAPACITY);
+}
+
+/**
+ * Changes the frame start sequence used to delimit incoming frames & re-compiles the
+ * skip table of the start sequence matcher.
+ */
+void IO::FrameReader::setStartSequence(const QString &sequence)
+{
+    m_startIndex = -1;
+    m_scanPosition = 0;
+    m_startMatcher.setPattern(sequence.toUtf8());
+}
+
+/**
+ * Changes the frame end sequence used to delimit incoming frames & re-compiles the
+ * skip table of the finish sequence matcher.
+ */
+void IO::FrameReader::setFinishSequence(const QString &sequence)
+{
+    m_startIndex = -1;
+    m_scanPosition = 0;
+    m_finishMatcher.setPattern(sequence.toUtf8());
+}
+
+/**
+ * Read frames from temporary buffer, every frame that contains the appropiate start/end
+ * sequence is removed from the buffer as soon as its read. Valid frames are appended to
+ * the given @a frames vector.
+ *
+ * Frames are located by logical offset inside the circular buffer, the only copy that
+ * takes place is the extraction of the frame payload itself. The reader remembers how
+ * far the buffer was scanned on the previous call, so bytes are never examined twice
+ * across readyRead notifications.
+ *
+ * Implemementation credits: @jpnorair and @alex-spataru
+ */
+void IO::FrameReader::readFrames(QVector<QByteArray> &frames)
+{
+    if (m_frameMode == FrameMode::BinaryLengthPrefix)
+        readLengthPrefixedFrames(frames);
+    else if (m_frameMode == FrameMode::Cobs || m_frameMode == FrameMode::Slip)
+        readEncodedFrames(frames);
+    else
+        readDelimitedFrames(frames);
+}
+
+/**
+ * Extracts COBS- or SLIP-encoded frames from the temporary buffer. Both encodings
+ * terminate each frame with a single delimiter byte (0x00 for COBS, 0xC0 for SLIP),
+ * the delimiter search runs over the linear chunks of the circular buffer with
+ * @c memchr & remembers the last scanned position. Malformed frames are dropped, the
+ * decoder re-synchronizes at the next delimiter automatically.
+ */
+void IO::FrameReader::readEncodedFrames(QVector<QByteArray> &frames)
+{
+    const char delimiter = (m_frameMode == FrameMode::Cobs) ? '\x00' : '\xc0';
+    while (true)
+    {
+        // Locate the frame delimiter, resume from the last scanned position
+        int index = -1;
+        int pos = m_scanPosition;
+        while (pos < m_dataBuffer.size() && index < 0)
+        {
+            int available = 0;
+            auto data = m_dataBuffer.linearData(pos, &available);
+            if (!data || available <= 0)
+                break;
+
+            auto match = static_cast<const char *>(memchr(data, delimiter, available));
+            if (match)
+                index = pos + static_cast<int>(match - data);
+            else
+                pos += available;
+        }
+
+        // No delimiter yet, wait for more data
+        if (index < 0)
+        {
+            m_scanPosition = m_dataBuffer.size();
+            break;
+        }
+
+        // Copy the encoded block & decode it (empty blocks separate back-to-back
+        // delimiters & are ignored)
+        if (index > 0)
+        {
+            QByteArray frame;
+            auto encoded = m_dataBuffer.peek(0, index);
+            const bool ok = (m_frameMode == FrameMode::Cobs) ? COBS_DECODE(encoded, frame)
+                                                             : SLIP_DECODE(encoded, frame);
+            if (ok && !frame.isEmpty())
+                frames.append(frame);
+        }
+
+        // Consume the encoded block & its delimiter
+        m_dataBuffer.skip(index + 1);
+        m_scanPosition = 0;
+    }
+}
+
+/**
+ * Extracts frames delimited by the start/finish sequences from the temporary buffer.
+ */
+void IO::FrameReader::readDelimitedFrames(QVector<QByteArray> &frames)
+{
+    while (true)
+    {
+        // Locate the start sequence, resume from the last scanned position (minus the
+        // pattern length, the sequence may straddle two readyRead notifications)
+        if (m_startIndex < 0)
+        {
+            auto from = qMax(0, m_scanPosition - m_startMatcher.length() + 1);
+            m_startIndex = m_startMatcher.findIn(m_dataBuffer, from);
+            if (m_startIndex < 0)
+            {
+                m_scanPosition = m_dataBuffer.size();
+                break;
+            }
+
+            // Finish sequence scanning begins right after the start sequence
+            m_scanPosition = m_startIndex + m_startMatcher.length();
+
+            // Arm the streaming checksum when the CRC type is already known
+            resetChecksumState();
+        }
+
+        // Locate the finish sequence that terminates the frame payload
+        auto frameStart = m_startIndex + m_startMatcher.length();
+        auto from = qMax(frameStart, m_scanPosition - m_finishMatcher.length() + 1);
+        auto fIndex = m_finishMatcher.findIn(m_dataBuffer, from);
+        if (fIndex < 0)
+        {
+            // Fold the bytes that cannot be part of a finish sequence into the CRC
+            // state while we wait for the rest of the frame to arrive
+            m_scanPosition = m_dataBuffer.size();
+            updateChecksumState(m_crcPosition,
+                                m_dataBuffer.size() - m_finishMatcher.length() + 1);
+            break;
+        }
+
+        // Fold the remaining payload bytes into the CRC state
+        updateChecksumState(m_crcPosition, fIndex);
+
+        // Copy the frame payload out of the circular buffer
+        auto frame = m_dataBuffer.peek(frameStart, fIndex - frameStart);
+
+        // Checksum verification & register RX frame
+        int chop = 0;
+        auto result = integrityChecks(frame, fIndex, &chop);
+        if (result == ValidationStatus::FrameOk)
+            frames.append(frame);
+
+        // Checksum mismatch, re-synchronize at the next start-sequence candidate.
+        // A corrupt finish sequence can merge two real frames into one rejected
+        // region, so the next candidate is located with the accelerated matcher
+        // instead of discarding the whole region & re-scanning what follows.
+        else if (result == ValidationStatus::ChecksumError)
+        {
+            m_checksumErrorCount.fetchAndAddRelaxed(1);
+            m_resyncCount.fetchAndAddRelaxed(1);
+
+            auto next = m_startMatcher.findIn(m_dataBuffer,
+                                              m_startIndex + m_startMatcher.length());
+            if (next >= 0 && next < fIndex + chop)
+                m_dataBuffer.skip(next);
+            else
+                m_dataBuffer.skip(fIndex + chop);
+
+            m_startIndex = -1;
+            m_scanPosition = 0;
+            m_crcStreaming = false;
+            continue;
+        }
+
+        // Checksum data incomplete, remember where we left off & try next time...
+        else if (result == ValidationStatus::ChecksumIncomplete)
+        {
+            m_scanPosition = fIndex;
+            break;
+        }
+
+        // Consume the frame (incl. finish sequence & checksum) from the buffer,
+        // logical scan positions restart at zero
+        m_dataBuffer.skip(fIndex + chop);
+        m_startIndex = -1;
+        m_scanPosition = 0;
+        m_crcStreaming = false;
+    }
+}
+
+/**
+ * Extracts length-prefixed binary frames from the temporary buffer. A binary frame is
+ * composed of:
+ *
+ * - The start sequence bytes, used as the header magic
+ * - A 16-bit little-endian payload length
+ * - The payload itself
+ * - A 16-bit big-endian CRC-16 of the payload (same polynomial as text mode)
+ *
+ * Frames are located with O(1) lookups once the magic has been found, no substring
+ * search over the payload takes place. On checksum mismatch, the reader re-synchronizes
+ * at the next occurrence of the magic.
+ */
+void IO::FrameReader::readLengthPrefixedFrames(QVector<QByteArray> &frames)
+{
+    auto magicLength = m_startMatcher.length();
+    while (true)
+    {
+        // Locate the header magic, resume from the last scanned position
+        if (m_startIndex < 0)
+        {
+            auto from = qMax(0, m_scanPosition - magicLength + 1);
+            m_startIndex = m_startMatcher.findIn(m_dataBuffer, from);
+            if (m_startIndex < 0)
+            {
+                m_scanPosition = m_dataBuffer.size();
+                break;
+            }
+
+            m_scanPosition = m_startIndex + magicLength;
+        }
+
+        // Wait until the length field is available
+        if (m_dataBuffer.size() < m_startIndex + magicLength + 2)
+            break;
+
+        // Read the 16-bit little-endian payload length
+        const quint8 a = m_dataBuffer.at(m_startIndex + magicLength);
+        const quint8 b = m_dataBuffer.at(m_startIndex + magicLength + 1);
+        const int length = (b << 8) | a;
+
+        // Frames that can never fit in the buffer cannot be extracted, treat the
+        // length field as corrupt & re-synchronize at the next magic
+        const int total = magicLength + 2 + length + 2;
+        if (total > m_dataBuffer.capacity())
+        {
+            m_dataBuffer.skip(m_startIndex + magicLength);
+            m_startIndex = -1;
+            m_scanPosition = 0;
+            continue;
+        }
+
+        // Wait until the payload & checksum are available
+        if (m_dataBuffer.size() < m_startIndex + total)
+            break;
+
+        // Copy the payload out of the circular buffer & validate the checksum
+        auto payload = m_dataBuffer.peek(m_startIndex + magicLength + 2, length);
+        const quint8 c = m_dataBuffer.at(m_startIndex + total - 2);
+        const quint8 d = m_dataBuffer.at(m_startIndex + total - 1);
+        const quint16 crc = (c << 8) | (d & 0xff);
+
+        // Consume the full frame on success, only the magic on a checksum error
+        // (the next magic may be hidden inside the corrupt payload)
+        if (crc16(payload.data(), payload.length()) == crc)
+        {
+            frames.append(payload);
+            m_dataBuffer.skip(m_startIndex + total);
+        }
+
+        else
+        {
+            m_checksumErrorCount.fetchAndAddRelaxed(1);
+            m_resyncCount.fetchAndAddRelaxed(1);
+            m_dataBuffer.skip(m_startIndex + magicLength);
+        }
+
+        m_startIndex = -1;
+        m_scanPosition = 0;
+    }
+}
+
+/**
+ * Re-arms the streaming checksum state for a new frame. Streaming is only enabled once
+ * the checksum type used by the device is known (i.e. after the first validated frame),
+ * the first frame of a session is validated with a full pass instead.
+ */
+void IO::FrameReader::resetChecksumState()
+{
+    m_crc8State = 0xff;
+    m_crc16State = 0xffff;
+    m_crc32State = 0xffffffff;
+    m_crcPosition = m_startIndex + m_startMatcher.length();
+    m_crcStreaming = (m_crcType != ChecksumType::None);
+}
+
+/**
+ * Folds the payload bytes in the logical range [@a from, @a to) into the streaming CRC
+ * state. Bytes are fed to the CRC kernel in (at most) two linear chunks, so the frame
+ * payload is only traversed once no matter how many readyRead notifications it spans.
+ */
+void IO::FrameReader::updateChecksumState(const int from, const int to)
+{
+    if (!m_crcStreaming || to <= from)
+        return;
+
+    auto pos = qMax(from, m_crcPosition);
+    while (pos < to)
+    {
+        int available = 0;
+        auto data = m_dataBuffer.linearData(pos, &available);
+        if (!data || available <= 0)
+            break;
+
+        auto count = qMin(available, to - pos);
+        switch (m_crcType)
+        {
+            case ChecksumType::Crc8:
+                m_crc8State = crc8Update(m_crc8State, data, count);
+                break;
+            case ChecksumType::Crc16:
+                m_crc16State = crc16Update(m_crc16State, data, count);
+                break;
+            case ChecksumType::Crc16Modbus:
+                m_crc16State = crc16ModbusUpdate(m_crc16State, data, count);
+                break;
+            case ChecksumType::Crc32:
+                m_crc32State = crc32Update(m_crc32State, data, count);
+                break;
+            default:
+                break;
+        }
+
+        pos += count;
+    }
+
+    m_crcPosition = qMax(m_crcPosition, to);
+}
+
+/**
+ * Checks if the data that follows the finish sequence contains a checksum corresponding
+ * to the given @a frame. If so, the function shall calculate the appropiate checksum for
+ * the @a frame and compare it with the received checksum to verify the integrity of
+ * received data.
+ *
+ * @param frame data in which we shall perform integrity checks
+ * @param finishIndex logical buffer position of the finish sequence
+ * @param bytes pointer to the number of bytes that we need to chop from the buffer
+ *              (counted from @a finishIndex)
+ */
+IO::FrameReader::ValidationStatus IO::FrameReader::integrityChecks(
+    const QByteArray &frame, const int finishIndex, int *bytes)
+{
+    // Get checksum headers that can follow the finish sequence
+    auto finish = m_finishMatcher.pattern();
+    auto crc8Header = finish + "crc8:";
+    auto crc16Header = finish + "crc16:";
+    auto crc32Header = finish + "crc32:";
+    auto crc16ModbusHeader = finish + "crc16modbus:";
+
+    // Copy the finish sequence, the (possible) checksum header & checksum bytes
+    auto headerBytes = qMax(crc32Header.length() + 4, crc16ModbusHeader.length() + 2);
+    auto header = m_dataBuffer.peek(finishIndex, headerBytes);
+
+    // Check CRC-8
+    if (header.startsWith(crc8Header))
+    {
+        // Use the streamed CRC state when available, fall back to a full pass
+        // on the first frame of the session
+        quint8 computed;
+        if (m_crcStreaming && m_crcType == ChecksumType::Crc8)
+            computed = m_crc8State;
+        else
+            computed = crc8(frame.data(), frame.length());
+
+        // Register the checksum type used by the device
+        m_crcType = ChecksumType::Crc8;
+
+        // Check if we have enough data in the buffer
+        if (header.length() >= crc8Header.length() + 1)
+        {
+            // Set the number of bytes to remove from the buffer
+            *bytes = crc8Header.length() + 1;
+
+            // Get 8-bit checksum
+            const quint8 crc = header.at(crc8Header.length());
+
+            // Compare checksums
+            if (computed == crc)
+                return ValidationStatus::FrameOk;
+            else
+                return ValidationStatus::ChecksumError;
+        }
+    }
+
+    // Check CRC-16
+    else if (header.startsWith(crc16Header))
+    {
+        // Use the streamed CRC state when available, fall back to a full pass
+        // on the first frame of the session
+        quint16 computed;
+        if (m_crcStreaming && m_crcType == ChecksumType::Crc16)
+            computed = m_crc16State;
+        else
+            computed = crc16(frame.data(), frame.length());
+
+        // Register the checksum type used by the device
+        m_crcType = ChecksumType::Crc16;
+
+        // Check if we have enough data in the buffer
+        if (header.length() >= crc16Header.length() + 2)
+        {
+            // Set the number of bytes to remove from the buffer
+            *bytes = crc16Header.length() + 2;
+
+            // Get 16-bit checksum
+            const quint8 a = header.at(crc16Header.length());
+            const quint8 b = header.at(crc16Header.length() + 1);
+            const quint16 crc = (a << 8) | (b & 0xff);
+
+            // Compare checksums
+            if (computed == crc)
+                return ValidationStatus::FrameOk;
+            else
+                return ValidationStatus::ChecksumError;
+        }
+    }
+
+    // Check CRC-16/MODBUS
+    else if (header.startsWith(crc16ModbusHeader))
+    {
+        // Use the streamed CRC state when available, fall back to a full pass
+        // on the first frame of the session
+        quint16 computed;
+        if (m_crcStreaming && m_crcType == ChecksumType::Crc16Modbus)
+            computed = m_crc16State;
+        else
+            computed = crc16Modbus(frame.data(), frame.length());
+
+        // Register the checksum type used by the device
+        m_crcType = ChecksumType::Crc16Modbus;
+
+        // Check if we have enough data in the buffer
+        if (header.length() >= crc16ModbusHeader.length() + 2)
+        {
+            // Set the number of bytes to remove from the buffer
+            *bytes = crc16ModbusHeader.length() + 2;
+
+            // Get 16-bit checksum, Modbus transmits the low byte first
+            const quint8 a = header.at(crc16ModbusHeader.length());
+            const quint8 b = header.at(crc16ModbusHeader.length() + 1);
+            const quint16 crc = (b << 8) | (a & 0xff);
+
+            // Compare checksums
+            if (computed == crc)
+                return ValidationStatus::FrameOk;
+            else
+                return ValidationStatus::ChecksumError;
+        }
+    }
+
+    // Check CRC-32
+    else if (header.startsWith(crc32Header))
+    {
+        // Use the streamed CRC state when available, fall back to a full pass
+        // on the first frame of the session
+        quint32 computed;
+        if (m_crcStreaming && m_crcType == ChecksumType::Crc32)
+            computed = ~m_crc32State;
+        else
+            computed = crc32(frame.data(), frame.length());
+
+        // Register the checksum type used by the device
+        m_crcType = ChecksumType::Crc32;
+
+        // Check if we have enough data in the buffer
+        if (header.length() >= crc32Header.length() + 4)
+        {
+            // Set the number of bytes to remove from the buffer
+            *bytes = crc32Header.length() + 4;
+
+            // Get 32-bit checksum
+            const quint8 a = header.at(crc32Header.length());
+            const quint8 b = header.at(crc32Header.length() + 1);
+            const quint8 c = header.at(crc32Header.length() + 2);
+            const quint8 d = header.at(crc32Header.length() + 3);
+            const quint32 crc = (a << 24) | (b << 16) | (c << 8) | (d & 0xff);
+
+            // Compare checksums
+            if (computed == crc)
+                return ValidationStatus::FrameOk;
+            else
+                return ValidationStatus::ChecksumError;
+        }
+    }
+
+    // Buffer does not contain CRC code
+    else if (m_crcType == ChecksumType::None)
+    {
+        *bytes = finish.length();
+        return ValidationStatus::FrameOk;
+    }
+
+    // Checksum data incomplete
+    return ValidationStatus::ChecksumIncomplete;
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_FrameReader.cpp"
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QObject>
+#include <QVector>
+#include <QByteArray>
+#include <DataTypes.h>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+
+#include <IO/CircularBuffer.h>
+#include <IO/SequenceMatcher.h>
+
+namespace IO
+{
+class FrameQueue;
+
+/**
+ * @brief The FrameReader class
+ *
+ * The frame reader owns the temporary RX buffer and performs delimiter scanning
+ * and checksum validation for the I/O manager. An instance of this class is
+ * moved to a dedicated worker thread by the @c IO::Manager so that frame
+ * extraction does not compete with QML rendering on the GUI thread, even when
+ * devices push data at multi-megabaud rates.
+ *
+ * Finished frames are pushed into the lock-free @c IO::FrameQueue owned by the
+ * manager & announced with the lightweight @c framesQueued() signal (queued
+ * across threads). Frame payloads never travel inside event arguments, so the
+ * number & size of cross-thread events stays constant no matter how many
+ * frames a burst contains.
+ */
+class FrameReader : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void framesQueued();
+
+public:
+    enum class ValidationStatus
+    {
+        FrameOk,
+        ChecksumError,
+        ChecksumIncomplete
+    };
+    Q_ENUM(ValidationStatus)
+
+    enum class ChecksumType
+    {
+        None,
+        Crc8,
+        Crc16,
+        Crc16Modbus,
+        Crc32
+    };
+    Q_ENUM(ChecksumType)
+
+    // Values must stay in sync with @c IO::Manager::FrameMode
+    enum class FrameMode
+    {
+        TextDelimiters,
+        BinaryLengthPrefix,
+        Cobs,
+        Slip
+    };
+    Q_ENUM(FrameMode)
+
+    explicit FrameReader(FrameQueue *queue, QObject *parent = Q_NULLPTR);
+
+    quint64 frameCount() const;
+    quint64 resyncCount() const;
+    quint64 scanTimeUsecs() const;
+    quint64 scanEventCount() const;
+    quint64 checksumErrorCount() const;
+    quint64 bufferHighWaterMark() const;
+    quint64 bufferOverflowBytes() const;
+
+public Q_SLOTS:
+    void reset();
+    void setFrameMode(const int mode);
+    void processData(const QByteArray &data);
+    void setMaxBufferSize(const int maxBufferSize);
+    void setStartSequence(const QString &sequence);
+    void setFinishSequence(const QString &sequence);
+    void setCoalesceSettings(const int bytes, const int usecs);
+
+private Q_SLOTS:
+    void scanBuffer();
+
+private:
+    void ingestData(const QByteArray &data);
+    void drainCompressedBlocks();
+    void readFrames(QVector<QByteArray> &frames);
+    void readEncodedFrames(QVector<QByteArray> &frames);
+    void readDelimitedFrames(QVector<QByteArray> &frames);
+    void readLengthPrefixedFrames(QVector<QByteArray> &frames);
+    void resetChecksumState();
+    void updateChecksumState(const int from, const int to);
+    ValidationStatus integrityChecks(const QByteArray &frame, const int finishIndex,
+                                     int *bytesToChop);
+
+private:
+    int m_startIndex;
+    int m_scanPosition;
+    FrameQueue *m_frameQueue;
+    FrameMode m_frameMode;
+    CircularBuffer m_dataBuffer;
+    SequenceMatcher m_startMatcher;
+    SequenceMatcher m_finishMatcher;
+
+    bool m_crcStreaming;
+    int m_crcPosition;
+    quint8 m_crc8State;
+    quint16 m_crc16State;
+    quint32 m_crc32State;
+    ChecksumType m_crcType;
+
+    int m_pendingBytes;
+    int m_coalesceBytes;
+    int m_coalesceUsecs;
+    QTimer m_flushTimer;
+    QElapsedTimer m_lastArrival;
+
+    // Adaptive buffer sizing state, the buffer starts small & grows geometrically
+    // under pressure up to @c m_bufferCap, then shrinks back after sustained low use
+    int m_bufferCap;
+    int m_windowPeak;
+    QElapsedTimer m_lowUseTimer;
+
+    // Transparent stream decompression state, the first bytes of every
+    // connection are inspected for the compressed-stream magic prefix
+    bool m_streamChecked;
+    bool m_streamCompressed;
+    QByteArray m_streamBuffer;
+
+    QAtomicInteger<quint64> m_frameCount;
+    QAtomicInteger<quint64> m_resyncCount;
+    QAtomicInteger<quint64> m_scanTimeUsecs;
+    QAtomicInteger<quint64> m_scanEventCount;
+    QAtomicInteger<quint64> m_checksumErrorCount;
+    QAtomicInteger<quint64> m_bufferHighWater;
+    QAtomicInteger<quint64> m_overflowBytes;
+};
+}
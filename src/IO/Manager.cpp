@@ -22,11 +22,17 @@
  */
 
 #include <IO/Manager.h>
-#include <IO/Checksum.h>
+#include <IO/FrameReader.h>
 #include <IO/DataSources/Serial.h>
 #include <IO/DataSources/Network.h>
+#include <IO/DataSources/Generator.h>
+#include <IO/DataSources/WebSocket.h>
+#include <IO/DataSources/Relay.h>
 
 #include <MQTT/Client.h>
+#include <Misc/TimerEvents.h>
+#include <Misc/LatencyTracer.h>
+#include <Misc/Watchdog.h>
 #include <QNetworkDatagram>
 
 /**
@@ -54,17 +60,36 @@ static QString ADD_ESCAPE_SEQUENCES(const QString &str)
  * Constructor function
  */
 IO::Manager::Manager()
-    : m_enableCrc(false)
-    , m_writeEnabled(true)
-    , m_maxBufferSize(1024 * 1024)
+    : m_writeEnabled(true)
+    , m_maxBufferSize(16 * 1024 * 1024)
+    , m_coalesceBytes(4096)
+    , m_coalesceInterval(1000)
     , m_device(Q_NULLPTR)
+    , m_frameMode(FrameMode::TextDelimiters)
     , m_dataSource(DataSource::Serial)
     , m_receivedBytes(0)
     , m_startSequence("/*")
     , m_finishSequence("*/")
     , m_separatorSequence(",")
+    , m_txFlushScheduled(false)
+    , m_pipeline("primary")
+    , m_framesPerSecond(0)
+    , m_bytesPerSecond(0)
+    , m_averageScanTime(0)
+    , m_lastFrameCount(0)
+    , m_lastByteCount(0)
+    , m_lastScanTime(0)
+    , m_lastScanEvents(0)
 {
-    setMaxBufferSize(1024 * 1024);
+    // Register the frames extracted by the primary pipeline (which owns the frame
+    // reader thread & the lock-free frame queue)
+    connect(&m_pipeline, &Pipeline::framesReceived, this,
+            &IO::Manager::onPipelineFrames);
+
+    // Set the default buffer cap, the buffer only grows towards it under pressure so
+    // a generous cap costs nothing on low baud rate sessions while multi-megabyte
+    // network bursts are ingested without discarding data
+    setMaxBufferSize(16 * 1024 * 1024);
 
     // Configure signals/slots
     auto serial = &DataSources::Serial::instance();
@@ -73,8 +98,25 @@ IO::Manager::Manager()
     connect(netwrk, SIGNAL(addressChanged()), this, SIGNAL(configurationChanged()));
     connect(this, SIGNAL(dataSourceChanged()), this, SIGNAL(configurationChanged()));
     connect(serial, SIGNAL(portIndexChanged()), this, SIGNAL(configurationChanged()));
+
+    // Refresh the ingestion statistics once per second
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+            &IO::Manager::updateStatistics);
+
+    // Re-arm the idle watchdog of the timer module on every ingest path, the
+    // first byte of a device that wakes up resumes the suspended UI timers
+    connect(this, &IO::Manager::dataSent, &Misc::TimerEvents::instance(),
+            &Misc::TimerEvents::registerActivity);
+    connect(this, &IO::Manager::dataReceived, &Misc::TimerEvents::instance(),
+            &Misc::TimerEvents::registerActivity);
 }
 
+/**
+ * Destructor function, secondary pipelines & the primary pipeline (and their worker
+ * threads) are stopped automatically by the QObject destructor.
+ */
+IO::Manager::~Manager() { }
+
 /**
  * Returns the only instance of the class
  */
@@ -129,20 +171,116 @@ bool IO::Manager::configurationOk() const
         return DataSources::Serial::instance().configurationOk();
     else if (dataSource() == DataSource::Network)
         return DataSources::Network::instance().configurationOk();
+    else if (dataSource() == DataSource::Generator)
+        return DataSources::Generator::instance().configurationOk();
+    else if (dataSource() == DataSource::WebSocket)
+        return DataSources::WebSocket::instance().configurationOk();
+    else if (dataSource() == DataSource::Relay)
+        return DataSources::Relay::instance().configurationOk();
 
     return false;
 }
 
 /**
- * Returns the maximum size of the buffer. This is useful to avoid consuming to much
- * memory when a large block of invalid data is received (for example, when the user
- * selects an invalid baud rate configuration).
+ * Returns the maximum size that the temporary RX buffer may grow to. The buffer starts
+ * small & only grows towards this cap under actual pressure, so the cap can be generous
+ * without wasting memory on low baud rate sessions. Check the
+ * @c IO::FrameReader::setMaxBufferSize() function for more information.
  */
 int IO::Manager::maxBufferSize() const
 {
     return m_maxBufferSize;
 }
 
+/**
+ * Returns the number of bytes that shall accumulate before a deferred frame scan is
+ * forced during a readyRead storm.
+ */
+int IO::Manager::coalesceBytes() const
+{
+    return m_coalesceBytes;
+}
+
+/**
+ * Returns the maximum time (in microseconds) that frame scanning may be deferred while
+ * incoming data is coalesced. A value of 0 disables coalescing, every readyRead
+ * notification is scanned immediately.
+ */
+int IO::Manager::coalesceInterval() const
+{
+    return m_coalesceInterval;
+}
+
+/**
+ * Returns the number of frames extracted during the last second
+ */
+quint64 IO::Manager::framesPerSecond() const
+{
+    return m_framesPerSecond;
+}
+
+/**
+ * Returns the number of bytes received during the last second
+ */
+quint64 IO::Manager::bytesPerSecond() const
+{
+    return m_bytesPerSecond;
+}
+
+/**
+ * Returns the average time (in microseconds) spent scanning for frames per readyRead
+ * notification during the last second
+ */
+quint64 IO::Manager::averageScanTime() const
+{
+    return m_averageScanTime;
+}
+
+/**
+ * Returns the total number of frames dropped because the user interface could not
+ * keep up with the device
+ */
+quint64 IO::Manager::droppedFrameCount() const
+{
+    return m_pipeline.droppedFrameCount();
+}
+
+/**
+ * Returns the number of times the frame scanner re-synchronized at the next
+ * start-sequence candidate after rejecting a corrupt region
+ */
+quint64 IO::Manager::resyncCount() const
+{
+    return m_pipeline.frameReader()->resyncCount();
+}
+
+/**
+ * Returns the total number of frames rejected because of a checksum mismatch
+ */
+quint64 IO::Manager::checksumErrorCount() const
+{
+    return m_pipeline.frameReader()->checksumErrorCount();
+}
+
+/**
+ * Returns the largest number of bytes that the temporary RX buffer has ever held. A
+ * figure close to @c maxBufferSize() indicates that the cap should be raised.
+ */
+quint64 IO::Manager::bufferHighWaterMark() const
+{
+    return m_pipeline.frameReader()->bufferHighWaterMark();
+}
+
+/**
+ * Returns the total number of bytes discarded because the temporary RX buffer
+ * overflowed after growing to its cap. A non-zero figure means that frame data was
+ * silently lost & the cap should be raised.
+ */
+quint64 IO::Manager::bufferOverflowBytes() const
+{
+    return m_pipeline.frameReader()->bufferOverflowBytes();
+}
+
 /**
  * Returns a pointer to the currently selected device.
  *
@@ -154,10 +292,64 @@ QIODevice *IO::Manager::device()
     return m_device;
 }
 
+/**
+ * Returns a pointer to the primary pipeline, which processes the data received from the
+ * device managed by this class.
+ */
+IO::Pipeline *IO::Manager::pipeline()
+{
+    return &m_pipeline;
+}
+
+/**
+ * Creates an additional ingestion pipeline identified by the given @a tag. Each pipeline
+ * owns its own RX buffer, delimiter scanner & worker thread, so several devices can be
+ * monitored concurrently from a single process. The caller is responsible for assigning
+ * a device to the pipeline (see @c IO::Pipeline::setDevice()).
+ *
+ * Frames extracted by secondary pipelines are published through the tagged
+ * @c pipelineFrameReceived() signal.
+ */
+IO::Pipeline *IO::Manager::createPipeline(const QString &tag)
+{
+    auto pipeline = new Pipeline(tag, this);
+    pipeline->setMaxBufferSize(maxBufferSize());
+    pipeline->setStartSequence(startSequence());
+    pipeline->setFinishSequence(finishSequence());
+    pipeline->setFrameMode(static_cast<int>(frameMode()));
+    connect(pipeline, &Pipeline::framesReceived, this, &IO::Manager::onPipelineFrames);
+
+    m_pipelines.append(pipeline);
+    return pipeline;
+}
+
+/**
+ * Stops & deletes the given secondary @a pipeline
+ */
+void IO::Manager::removePipeline(Pipeline *pipeline)
+{
+    if (pipeline && m_pipelines.removeOne(pipeline))
+    {
+        pipeline->disconnect(this);
+        pipeline->deleteLater();
+    }
+}
+
+/**
+ * Returns the currently selected framing mode, possible return values:
+ * - @c FrameMode::TextDelimiters     frames delimited by start/finish sequences
+ * - @c FrameMode::BinaryLengthPrefix binary frames with magic + length + CRC header
+ */
+IO::Manager::FrameMode IO::Manager::frameMode() const
+{
+    return m_frameMode;
+}
+
 /**
  * Returns the currently selected data source, possible return values:
- * - @c DataSource::Serial  use a serial port as a data source
- * - @c DataSource::Network use a network port as a data source
+ * - @c DataSource::Serial    use a serial port as a data source
+ * - @c DataSource::Network   use a network port as a data source
+ * - @c DataSource::Generator use the synthetic frame generator as a data source
  */
 IO::Manager::DataSource IO::Manager::dataSource() const
 {
@@ -201,56 +393,132 @@ StringList IO::Manager::dataSourcesList() const
     StringList list;
     list.append(tr("Serial port"));
     list.append(tr("Network port"));
+    list.append(tr("Frame generator"));
+    list.append(tr("WebSocket"));
+    list.append(tr("Relay viewer"));
+    return list;
+}
+
+/**
+ * Returns a list with the possible framing mode options.
+ */
+StringList IO::Manager::frameModesList() const
+{
+    StringList list;
+    list.append(tr("Start/end delimiters"));
+    list.append(tr("Length-prefixed (binary)"));
+    list.append(tr("COBS (binary)"));
+    list.append(tr("SLIP (binary)"));
     return list;
 }
 
 /**
- * Tries to write the given @a data to the current device.
+ * Queues the given @a data for transmission to the current device. The actual write
+ * happens asynchronously, adjacent writes issued during the same event-loop iteration
+ * are coalesced into a single device call so high-frequency command bursts (e.g. from
+ * the plugin system) do not stall the GUI thread on device write latency.
  *
- * @returns the number of bytes written to the target device
+ * @returns the number of bytes queued for transmission, or -1 if no device is connected
  */
 qint64 IO::Manager::writeData(const QByteArray &data)
 {
-    if (connected())
+    if (!connected())
+        return -1;
+
+    // Queue the payload & schedule a flush at the end of the current event-loop
+    // iteration (one flush handles every write queued before it runs)
+    m_txQueue.append(data);
+    if (!m_txFlushScheduled)
+    {
+        m_txFlushScheduled = true;
+        QMetaObject::invokeMethod(this, "flushTxQueue", Qt::QueuedConnection);
+    }
+
+    return data.length();
+}
+
+/**
+ * Writes the queued TX payloads to the current device. For datagram sockets, one
+ * datagram is written per queued payload (packet boundaries must be preserved); for
+ * stream devices, the queued payloads are coalesced into a single write call.
+ *
+ * The @c dataSent() signal re-emits the queued payloads themselves (implicit sharing,
+ * no copies), a copy is only made for the tail payload of a partial write.
+ */
+void IO::Manager::flushTxQueue()
+{
+    m_txFlushScheduled = false;
+
+    // Device disconnected while the flush was pending, discard queued writes
+    if (!connected() || m_txQueue.isEmpty())
     {
-        qint64 bytes = 0;
+        m_txQueue.clear();
+        return;
+    }
 
-        // Check which data source to use to write data
-        if (dataSource() == DataSource::Network)
+    // Datagram socket, write one datagram per queued payload
+    auto network = &DataSources::Network::instance();
+    if (dataSource() == DataSource::Network
+        && network->socketType() == QAbstractSocket::UdpSocket)
+    {
+        for (int i = 0; i < m_txQueue.count(); ++i)
         {
-            // Write to UDP socket
-            auto network = &DataSources::Network::instance();
-            if (network->socketType() == QAbstractSocket::UdpSocket)
-            {
-                bytes = network->udpSocket()->writeDatagram(
-                    data, QHostAddress(network->remoteAddress()),
-                    network->udpRemotePort());
-            }
-
-            // Write to TCP socket
-            else
-            {
-                bytes = network->tcpSocket()->write(data);
-            }
+            const auto &payload = m_txQueue.at(i);
+            auto bytes = network->udpSocket()->writeDatagram(
+                payload, QHostAddress(network->remoteAddress()),
+                network->udpRemotePort());
+
+            if (bytes == payload.length())
+                Q_EMIT dataSent(payload);
+            else if (bytes > 0)
+                Q_EMIT dataSent(payload.left(bytes));
         }
 
-        // Write to serial device
-        else
-            bytes = device()->write(data);
+        m_txQueue.clear();
+        return;
+    }
+
+    // Stream device, coalesce the queued payloads into a single write call (a single
+    // queued payload is passed through without copying)
+    QByteArray coalesced;
+    if (m_txQueue.count() == 1)
+        coalesced = m_txQueue.first();
+    else
+    {
+        int total = 0;
+        for (int i = 0; i < m_txQueue.count(); ++i)
+            total += m_txQueue.at(i).length();
+
+        coalesced.reserve(total);
+        for (int i = 0; i < m_txQueue.count(); ++i)
+            coalesced.append(m_txQueue.at(i));
+    }
+
+    // Write to TCP socket or serial device
+    qint64 bytes = 0;
+    if (dataSource() == DataSource::Network)
+        bytes = network->tcpSocket()->write(coalesced);
+    else if (deviceAvailable())
+        bytes = device()->write(coalesced);
 
-        // Show sent data in console
-        if (bytes > 0)
+    // Show sent data in console, re-emitting the queued payloads without copies
+    for (int i = 0; i < m_txQueue.count() && bytes > 0; ++i)
+    {
+        const auto &payload = m_txQueue.at(i);
+        if (bytes >= payload.length())
         {
-            auto writtenData = data;
-            writtenData.chop(data.length() - bytes);
-            Q_EMIT dataSent(writtenData);
+            Q_EMIT dataSent(payload);
+            bytes -= payload.length();
         }
 
-        // Return number of bytes written
-        return bytes;
+        else
+        {
+            Q_EMIT dataSent(payload.left(static_cast<int>(bytes)));
+            bytes = 0;
+        }
     }
 
-    return -1;
+    m_txQueue.clear();
 }
 
 /**
@@ -282,6 +550,28 @@ void IO::Manager::connectDevice()
     else if (dataSource() == DataSource::Network)
         setDevice(DataSources::Network::instance().openNetworkPort());
 
+    // Try to start the synthetic frame generator
+    else if (dataSource() == DataSource::Generator)
+        setDevice(DataSources::Generator::instance().openDevice());
+
+    // Try to open a WebSocket connection
+    else if (dataSource() == DataSource::WebSocket)
+        setDevice(DataSources::WebSocket::instance().openDevice());
+
+    // Try to connect to the relay server of an ingest node
+    else if (dataSource() == DataSource::Relay)
+        setDevice(DataSources::Relay::instance().openNetworkPort());
+
+    // Relay viewers parse the fixed relay wire format instead of the project framing:
+    // CRC-checked length-prefixed records behind the relay magic, already validated by
+    // the ingest node & shipped inside compressed stream blocks that the frame reader
+    // inflates transparently. The project framing is restored on disconnect.
+    if (dataSource() == DataSource::Relay)
+    {
+        m_pipeline.setFrameMode(static_cast<int>(FrameMode::BinaryLengthPrefix));
+        m_pipeline.setStartSequence(DataSources::Relay::frameMagic());
+    }
+
     // Configure current device
     if (deviceAvailable())
     {
@@ -292,8 +582,22 @@ void IO::Manager::connectDevice()
 
         // Open device
         if (device()->open(mode))
+        {
             connect(device(), &QIODevice::readyRead, this, &IO::Manager::onDataReceived);
 
+            // Apply the serial low latency tuning that requires an open port
+            // & adjust the frame reader thread priority accordingly
+            if (dataSource() == DataSource::Serial)
+            {
+                auto *serial = &DataSources::Serial::instance();
+                serial->applyLowLatencyTuning();
+                m_pipeline.setTimeCritical(serial->lowLatencyMode());
+            }
+
+            else
+                m_pipeline.setTimeCritical(false);
+        }
+
         // Error opening the device
         else
             disconnectDevice();
@@ -318,20 +622,35 @@ void IO::Manager::disconnectDevice()
             DataSources::Serial::instance().disconnectDevice();
         else if (dataSource() == DataSource::Network)
             DataSources::Network::instance().disconnectDevice();
+        else if (dataSource() == DataSource::Generator)
+            DataSources::Generator::instance().disconnectDevice();
+        else if (dataSource() == DataSource::WebSocket)
+            DataSources::WebSocket::instance().disconnectDevice();
+        else if (dataSource() == DataSource::Relay)
+        {
+            DataSources::Relay::instance().disconnectDevice();
+
+            // Restore the project framing configuration that the relay viewer
+            // session overrode
+            m_pipeline.setFrameMode(static_cast<int>(frameMode()));
+            m_pipeline.setStartSequence(startSequence());
+        }
 
         // Update device pointer
         m_device = Q_NULLPTR;
         m_receivedBytes = 0;
-        m_dataBuffer.clear();
-        m_dataBuffer.reserve(maxBufferSize());
 
         // Update UI
         Q_EMIT deviceChanged();
         Q_EMIT connectedChanged();
+        Q_EMIT receivedBytesChanged();
     }
 
-    // Disable CRC checking
-    m_enableCrc = false;
+    // Reset frame reader state (temp. buffer & CRC flag) & discard queued frames
+    m_pipeline.reset();
+
+    // Discard queued TX payloads
+    m_txQueue.clear();
 }
 
 /**
@@ -356,13 +675,130 @@ void IO::Manager::processPayload(const QByteArray &payload)
         if (m_receivedBytes >= UINT64_MAX)
             m_receivedBytes = 0;
 
-        // Notify user interface & application modules
+        // Notify user interface & application modules, the received bytes
+        // indicator is refreshed by the 1 Hz statistics tick
         Q_EMIT dataReceived(payload);
         Q_EMIT frameReceived(payload);
-        Q_EMIT receivedBytesChanged();
+        Q_EMIT frameBatchReceived(QVector<QByteArray> { payload });
     }
 }
 
+/**
+ * Reads the given batch of @a frames and emits them as if they had been received
+ * from a device. Unlike calling @c processPayload() once per frame, the batch is
+ * published to the JSON generator through a single signal, so a burst (e.g. an MQTT
+ * broker replaying the queued messages of a persistent session) is parsed & rendered
+ * in one event-loop pass instead of one pass per frame.
+ */
+void IO::Manager::processFrameBatch(const QVector<QByteArray> &frames)
+{
+    if (frames.isEmpty())
+        return;
+
+    for (int i = 0; i < frames.count(); ++i)
+    {
+        const auto &frame = frames.at(i);
+
+        // Update received bytes indicator
+        m_receivedBytes += frame.size();
+        if (m_receivedBytes >= UINT64_MAX)
+            m_receivedBytes = 0;
+
+        // Notify per-frame consumers (console, CSV export, plugins)
+        Q_EMIT dataReceived(frame);
+        Q_EMIT frameReceived(frame);
+    }
+
+    // Publish the whole batch to the JSON generator
+    Q_EMIT frameBatchReceived(frames);
+}
+
+/**
+ * Same as @c processPayload(), except that the payload is not routed to the frame
+ * parser of the JSON generator. The CSV player uses this function while it feeds the
+ * row values to the generator directly, so the console, MQTT & plugin modules still
+ * receive the serialized frame without the generator re-splitting it.
+ */
+void IO::Manager::publishPayload(const QByteArray &payload)
+{
+    if (!payload.isEmpty())
+    {
+        // Update received bytes indicator
+        m_receivedBytes += payload.size();
+        if (m_receivedBytes >= UINT64_MAX)
+            m_receivedBytes = 0;
+
+        // Notify user interface & application modules, the received bytes
+        // indicator is refreshed by the 1 Hz statistics tick
+        Q_EMIT dataReceived(payload);
+        Q_EMIT frameReceived(payload);
+    }
+}
+
+/**
+ * Batch variant of @c publishPayload(), the per-frame consumers (console, CSV
+ * export, plugins) still receive one signal per payload, but the received bytes
+ * indicator is only refreshed once at the end of the batch. Programmatic feeders
+ * that inject thousands of frames in a burst (e.g. the MQTT conflation path)
+ * use this function to avoid one UI notification fan-out per frame.
+ */
+void IO::Manager::publishPayloadBatch(const QVector<QByteArray> &payloads)
+{
+    if (payloads.isEmpty())
+        return;
+
+    for (int i = 0; i < payloads.count(); ++i)
+    {
+        const auto &payload = payloads.at(i);
+
+        // Update received bytes indicator
+        m_receivedBytes += payload.size();
+        if (m_receivedBytes >= UINT64_MAX)
+            m_receivedBytes = 0;
+
+        // Notify per-frame consumers
+        Q_EMIT dataReceived(payload);
+        Q_EMIT frameReceived(payload);
+    }
+}
+
+/**
+ * Feeds the given raw @a data to the frame scanner as if it had been received from a
+ * device. Unlike @c processPayload(), the data goes through the full ingestion pipeline
+ * (delimiter scanning & checksum validation). Used by the replay engine to reproduce
+ * recorded sessions.
+ */
+void IO::Manager::processRawData(const QByteArray &data)
+{
+    if (!data.isEmpty())
+    {
+        // Hand the data to the primary pipeline
+        m_pipeline.feedData(data);
+
+        // Update received bytes indicator
+        m_receivedBytes += data.size();
+        if (m_receivedBytes >= UINT64_MAX)
+            m_receivedBytes = 0;
+
+        // Notify the data consumers, the received bytes indicator is
+        // refreshed by the 1 Hz statistics tick
+        Q_EMIT dataReceived(data);
+    }
+}
+
+/**
+ * Changes the framing mode used to extract frames from the incoming data stream. In
+ * @c FrameMode::BinaryLengthPrefix mode, the start sequence bytes act as the header
+ * magic & the finish sequence is ignored.
+ */
+void IO::Manager::setFrameMode(const IO::Manager::FrameMode mode)
+{
+    m_frameMode = mode;
+    m_pipeline.setFrameMode(static_cast<int>(mode));
+
+    Q_EMIT frameModeChanged();
+}
+
 /**
  * Changes the maximum permited buffer size. Check the @c maxBufferSize() function for
  * more information.
@@ -372,7 +808,29 @@ void IO::Manager::setMaxBufferSize(const int maxBufferSize)
     m_maxBufferSize = maxBufferSize;
     Q_EMIT maxBufferSizeChanged();
 
-    m_dataBuffer.reserve(maxBufferSize);
+    m_pipeline.setMaxBufferSize(maxBufferSize);
+}
+
+/**
+ * Changes the number of bytes that force a deferred frame scan. Check the
+ * @c coalesceBytes() function for more information.
+ */
+void IO::Manager::setCoalesceBytes(const int bytes)
+{
+    m_coalesceBytes = qMax(1, bytes);
+    m_pipeline.setCoalesceSettings(m_coalesceBytes, m_coalesceInterval);
+    Q_EMIT coalesceSettingsChanged();
+}
+
+/**
+ * Changes the maximum frame scanning deferral time (in microseconds). Check the
+ * @c coalesceInterval() function for more information.
+ */
+void IO::Manager::setCoalesceInterval(const int usecs)
+{
+    m_coalesceInterval = qMax(0, usecs);
+    m_pipeline.setCoalesceSettings(m_coalesceBytes, m_coalesceInterval);
+    Q_EMIT coalesceSettingsChanged();
 }
 
 /**
@@ -385,6 +843,8 @@ void IO::Manager::setStartSequence(const QString &sequence)
     if (m_startSequence.isEmpty())
         m_startSequence = "/*";
 
+    m_pipeline.setStartSequence(m_startSequence);
+
     Q_EMIT startSequenceChanged();
 }
 
@@ -398,6 +858,8 @@ void IO::Manager::setFinishSequence(const QString &sequence)
     if (m_finishSequence.isEmpty())
         m_finishSequence = "*/";
 
+    m_pipeline.setFinishSequence(m_finishSequence);
+
     Q_EMIT finishSequenceChanged();
 }
 
@@ -428,68 +890,6 @@ void IO::Manager::setDataSource(const IO::Manager::DataSource &source)
     Q_EMIT dataSourceChanged();
 }
 
-/**
- * Read frames from temporary buffer, every frame that contains the appropiate start/end
- * sequence is removed from the buffer as soon as its read.
- *
- * This function also checks that the buffer size does not exceed specified size
- * limitations.
- *
- * Implemementation credits: @jpnorair and @alex-spataru
- */
-void IO::Manager::readFrames()
-{
-    // No device connected, abort
-    if (!connected())
-        return;
-
-    // Read until start/finish combinations are not found
-    auto bytes = 0;
-    auto prevBytes = 0;
-    auto cursor = m_dataBuffer;
-    auto start = startSequence().toUtf8();
-    auto finish = finishSequence().toUtf8();
-    while (cursor.contains(start) && cursor.contains(finish))
-    {
-        // Remove the part of the buffer prior to, and including, the start sequence.
-        auto sIndex = cursor.indexOf(start);
-        cursor = cursor.mid(sIndex + start.length(), -1);
-        bytes += sIndex + start.length();
-
-        // Copy a sub-buffer that goes until the finish sequence
-        auto fIndex = cursor.indexOf(finish);
-        auto frame = cursor.left(fIndex);
-
-        // Checksum verification & Q_EMIT RX frame
-        int chop = 0;
-        auto result = integrityChecks(frame, cursor, &chop);
-        if (result == ValidationStatus::FrameOk)
-            Q_EMIT frameReceived(frame);
-
-        // Checksum data incomplete, try next time...
-        else if (result == ValidationStatus::ChecksumIncomplete)
-        {
-            bytes = prevBytes;
-            break;
-        }
-
-        // Remove the data including the finish sequence from the master buffer
-        cursor = cursor.mid(fIndex + chop, -1);
-        bytes += fIndex + chop;
-
-        // Frame read successfully, save the number of bytes to chop.
-        // This is used to manage frames with incomplete checksums
-        prevBytes = bytes;
-    }
-
-    // Remove parsed data from master buffer
-    m_dataBuffer.remove(0, bytes);
-
-    // Clear temp. buffer (e.g. device sends a lot of invalid data)
-    if (m_dataBuffer.size() > maxBufferSize())
-        clearTempBuffer();
-}
-
 /**
  * Reads incoming data from the serial device, updates the serial console object,
  * registers incoming data to temporary buffer & extracts valid data frames from the
@@ -499,58 +899,107 @@ void IO::Manager::onDataReceived()
 {
     // Verify that device is still valid
     if (!device())
+    {
         disconnectDevice();
+        return;
+    }
 
-    // Initialize byte array
-    QByteArray data;
-    bool udpConnection = false;
-
-    // Check if we need to use UDP socket functions
-    if (dataSource() == DataSource::Network)
+    // UDP sockets need datagram-based reads, which cannot land in the
+    // persistent buffer
+    if (dataSource() == DataSource::Network
+        && DataSources::Network::instance().socketType() == QAbstractSocket::UdpSocket)
     {
-        if (DataSources::Network::instance().socketType() == QAbstractSocket::UdpSocket)
+        auto data = DataSources::Network::instance().readAllDatagrams();
+        if (!data.isEmpty())
         {
-            udpConnection = true;
-            auto udpSocket = DataSources::Network::instance().udpSocket();
-            while (udpSocket->hasPendingDatagrams())
-            {
-                QByteArray datagram;
-                datagram.resize(int(udpSocket->pendingDatagramSize()));
-                udpSocket->readDatagram(datagram.data(), datagram.size());
-                data.append(datagram);
-            }
+            m_pipeline.feedData(data);
+            m_receivedBytes += data.length();
+            if (m_receivedBytes >= UINT64_MAX)
+                m_receivedBytes = 0;
+
+            Q_EMIT dataReceived(data);
         }
+
+        return;
     }
 
-    // We are using the TCP socket or the serial port
-    if (!udpConnection)
-        data = device()->readAll();
+    // Drain the TCP socket or serial port into the persistent read buffer,
+    // the consumers only hold implicitly-shared references to the buffer, so
+    // once they release them the same allocation is reused for the next read
+    while (true)
+    {
+        // Size the buffer to the data waiting in the device
+        const auto available = device()->bytesAvailable();
+        if (available <= 0)
+            break;
 
-    // Read data & append it to buffer
-    auto bytes = data.length();
+        // Drop the storage if a consumer still references the previous
+        // chunk, otherwise resizing would copy the stale contents around
+        if (!m_readBuffer.isDetached())
+            m_readBuffer = QByteArray();
 
-    // Obtain frames from data buffer
-    m_dataBuffer.append(data);
-    readFrames();
+        // Read directly into the buffer, without intermediate copies
+        m_readBuffer.resize(static_cast<int>(available));
+        const auto bytes = device()->read(m_readBuffer.data(), available);
+        if (bytes <= 0)
+            break;
 
-    // Update received bytes indicator
-    m_receivedBytes += bytes;
-    if (m_receivedBytes >= UINT64_MAX)
-        m_receivedBytes = 0;
+        // Partial read, shrink the buffer to the data actually received
+        if (bytes < available)
+            m_readBuffer.resize(static_cast<int>(bytes));
+
+        // Hand the data to the primary pipeline
+        m_pipeline.feedData(m_readBuffer);
 
-    // Notify user interface
-    Q_EMIT receivedBytesChanged();
-    Q_EMIT dataReceived(data);
+        // Update received bytes indicator
+        m_receivedBytes += bytes;
+        if (m_receivedBytes >= UINT64_MAX)
+            m_receivedBytes = 0;
+
+        // Notify the data consumers, the received bytes indicator is
+        // refreshed by the 1 Hz statistics tick
+        Q_EMIT dataReceived(m_readBuffer);
+    }
 }
 
 /**
- * Deletes the contents of the temporary buffer. This function is called automatically by
- * the class when the temporary buffer size exceeds the limit imposed by the
- * @c maxBufferSize() function.
+ * Refreshes the ingestion statistics (frames/sec, bytes/sec & average scan time) from
+ * the atomic counters maintained by the frame reader thread. Called once per second by
+ * the @c Misc::TimerEvents module, so the hot path never pays for the instrumentation.
  */
-void IO::Manager::clearTempBuffer()
+void IO::Manager::updateStatistics()
 {
-    m_dataBuffer.clear();
+    // Compute frames/sec from the frame counter delta
+    const auto frames = m_pipeline.frameReader()->frameCount();
+    m_framesPerSecond = frames - m_lastFrameCount;
+    m_lastFrameCount = frames;
+
+    // Compute bytes/sec from the received bytes delta (the received bytes indicator
+    // resets to zero when a device is disconnected)
+    const bool bytesChanged = (m_receivedBytes != m_lastByteCount);
+    if (m_receivedBytes >= m_lastByteCount)
+        m_bytesPerSecond = m_receivedBytes - m_lastByteCount;
+    else
+        m_bytesPerSecond = 0;
+    m_lastByteCount = m_receivedBytes;
+
+    // Compute the average scan time per readyRead notification
+    const auto scanTime = m_pipeline.frameReader()->scanTimeUsecs();
+    const auto scanEvents = m_pipeline.frameReader()->scanEventCount();
+    if (scanEvents > m_lastScanEvents)
+        m_averageScanTime = (scanTime - m_lastScanTime) / (scanEvents - m_lastScanEvents);
+    else
+        m_averageScanTime = 0;
+    m_lastScanTime = scanTime;
+    m_lastScanEvents = scanEvents;
+
+    // Notify user interface. The received bytes counter is announced from
+    // here instead of once per chunk: at thousands of chunks per second the
+    // per-chunk signal dispatch alone costs a measurable slice of a core,
+    // while the indicator cannot usefully refresh faster than this tick.
+    Q_EMIT statisticsChanged();
+    if (bytesChanged)
+        Q_EMIT receivedBytesChanged();
 }
 
 /**
@@ -565,111 +1014,33 @@ void IO::Manager::setDevice(QIODevice *device)
 }
 
 /**
- * Checks if the @c cursor has a checksum corresponding to the given @a frame.
- * If so, the function shall calculate the appropiate checksum to for the @a frame and
- * compare it with the received checksum to verify the integrity of received data.
- *
- * @param frame data in which we shall perform integrity checks
- * @param cursor master buffer, should start with checksum type header
- * @param bytes pointer to the number of bytes that we need to chop from the master buffer
- */
-IO::Manager::ValidationStatus IO::Manager::integrityChecks(const QByteArray &frame,
-                                                           const QByteArray &cursor,
-                                                           int *bytes)
-{
-    // Get finish sequence as byte array
-    auto finish = finishSequence().toUtf8();
-    auto crc8Header = finish + "crc8:";
-    auto crc16Header = finish + "crc16:";
-    auto crc32Header = finish + "crc32:";
-
-    // Check CRC-8
-    if (cursor.contains(crc8Header))
-    {
-        // Enable the CRC flag
-        m_enableCrc = true;
-        auto offset = cursor.indexOf(crc8Header) + crc8Header.length() - 1;
-
-        // Check if we have enough data in the buffer
-        if (cursor.length() >= offset + 1)
-        {
-            // Increment the number of bytes to remove from master buffer
-            *bytes += crc8Header.length() + 1;
-
-            // Get 8-bit checksum
-            const quint8 crc = cursor.at(offset + 1);
-
-            // Compare checksums
-            if (crc8(frame.data(), frame.length()) == crc)
-                return ValidationStatus::FrameOk;
-            else
-                return ValidationStatus::ChecksumError;
-        }
-    }
-
-    // Check CRC-16
-    else if (cursor.contains(crc16Header))
-    {
-        // Enable the CRC flag
-        m_enableCrc = true;
-        auto offset = cursor.indexOf(crc16Header) + crc16Header.length() - 1;
-
-        // Check if we have enough data in the buffer
-        if (cursor.length() >= offset + 2)
-        {
-            // Increment the number of bytes to remove from master buffer
-            *bytes += crc16Header.length() + 2;
-
-            // Get 16-bit checksum
-            const quint8 a = cursor.at(offset + 1);
-            const quint8 b = cursor.at(offset + 2);
-            const quint16 crc = (a << 8) | (b & 0xff);
-
-            // Compare checksums
-            if (crc16(frame.data(), frame.length()) == crc)
-                return ValidationStatus::FrameOk;
-            else
-                return ValidationStatus::ChecksumError;
-        }
-    }
+ * Reports a batch of frames extracted by one of the pipelines to the rest of the
+ * application modules. Frames from the primary pipeline keep feeding the un-tagged
+ * frameReceived() signal (CSV export, MQTT, etc.) one at a time, while the whole batch
+ * is also published through frameBatchReceived() so that the JSON generator can
+ * distribute the parse work of large bursts across several cores. Frames from every
+ * pipeline are also published with their pipeline tag for device-aware consumers.
+ */
+void IO::Manager::onPipelineFrames(const QVector<QByteArray> &frames)
+{
+    auto pipeline = qobject_cast<Pipeline *>(sender());
+    if (!pipeline)
+        return;
 
-    // Check CRC-32
-    else if (cursor.contains(crc32Header))
+    if (pipeline == &m_pipeline)
     {
-        // Enable the CRC flag
-        m_enableCrc = true;
-        auto offset = cursor.indexOf(crc32Header) + crc32Header.length() - 1;
-
-        // Check if we have enough data in the buffer
-        if (cursor.length() >= offset + 4)
+        Misc::WatchdogActivity activity("IO::Manager frame dispatch");
+        for (int i = 0; i < frames.count(); ++i)
         {
-            // Increment the number of bytes to remove from master buffer
-            *bytes += crc32Header.length() + 4;
-
-            // Get 32-bit checksum
-            const quint8 a = cursor.at(offset + 1);
-            const quint8 b = cursor.at(offset + 2);
-            const quint8 c = cursor.at(offset + 3);
-            const quint8 d = cursor.at(offset + 4);
-            const quint32 crc = (a << 24) | (b << 16) | (c << 8) | (d & 0xff);
-
-            // Compare checksums
-            if (crc32(frame.data(), frame.length()) == crc)
-                return ValidationStatus::FrameOk;
-            else
-                return ValidationStatus::ChecksumError;
+            Misc::LatencyTracer::instance().frameIngested();
+            Q_EMIT frameReceived(frames.at(i));
         }
-    }
 
-    // Buffer does not contain CRC code
-    else if (!m_enableCrc)
-    {
-        *bytes += finish.length();
-        return ValidationStatus::FrameOk;
+        Q_EMIT frameBatchReceived(frames);
     }
 
-    // Checksum data incomplete
-    return ValidationStatus::ChecksumIncomplete;
+    for (int i = 0; i < frames.count(); ++i)
+        Q_EMIT pipelineFrameReceived(pipeline->tag(), frames.at(i));
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
@@ -23,9 +23,12 @@
 #pragma once
 
 #include <QObject>
+#include <QThread>
 #include <QIODevice>
 #include <DataTypes.h>
 
+#include <IO/Pipeline.h>
+
 namespace IO
 {
 /**
@@ -75,6 +78,10 @@ class Manager : public QObject
                READ dataSource
                WRITE setDataSource
                NOTIFY dataSourceChanged)
+    Q_PROPERTY(IO::Manager::FrameMode frameMode
+               READ frameMode
+               WRITE setFrameMode
+               NOTIFY frameModeChanged)
     Q_PROPERTY(QString startSequence
                READ startSequence
                WRITE setStartSequence
@@ -90,10 +97,43 @@ class Manager : public QObject
     Q_PROPERTY(bool configurationOk
                READ configurationOk
                NOTIFY configurationChanged)
+    Q_PROPERTY(quint64 framesPerSecond
+               READ framesPerSecond
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 bytesPerSecond
+               READ bytesPerSecond
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 checksumErrorCount
+               READ checksumErrorCount
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 droppedFrameCount
+               READ droppedFrameCount
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 resyncCount
+               READ resyncCount
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 averageScanTime
+               READ averageScanTime
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 bufferHighWaterMark
+               READ bufferHighWaterMark
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(quint64 bufferOverflowBytes
+               READ bufferOverflowBytes
+               NOTIFY statisticsChanged)
+    Q_PROPERTY(int coalesceBytes
+               READ coalesceBytes
+               WRITE setCoalesceBytes
+               NOTIFY coalesceSettingsChanged)
+    Q_PROPERTY(int coalesceInterval
+               READ coalesceInterval
+               WRITE setCoalesceInterval
+               NOTIFY coalesceSettingsChanged)
     // clang-format on
 
 Q_SIGNALS:
     void deviceChanged();
+    void frameModeChanged();
     void connectedChanged();
     void dataSourceChanged();
     void writeEnabledChanged();
@@ -103,13 +143,18 @@ Q_SIGNALS:
     void startSequenceChanged();
     void finishSequenceChanged();
     void separatorSequenceChanged();
+    void statisticsChanged();
+    void coalesceSettingsChanged();
     void frameValidationRegexChanged();
     void dataSent(const QByteArray &data);
     void dataReceived(const QByteArray &data);
     void frameReceived(const QByteArray &frame);
+    void frameBatchReceived(const QVector<QByteArray> &frames);
+    void pipelineFrameReceived(const QString &tag, const QByteArray &frame);
 
 private:
     explicit Manager();
+    ~Manager();
     Manager(Manager &&) = delete;
     Manager(const Manager &) = delete;
     Manager &operator=(Manager &&) = delete;
@@ -119,17 +164,22 @@ public:
     enum class DataSource
     {
         Serial,
-        Network
+        Network,
+        Generator,
+        WebSocket,
+        Relay
     };
     Q_ENUM(DataSource)
 
-    enum class ValidationStatus
+    // Values must stay in sync with @c IO::FrameReader::FrameMode
+    enum class FrameMode
     {
-        FrameOk,
-        ChecksumError,
-        ChecksumIncomplete
+        TextDelimiters,
+        BinaryLengthPrefix,
+        Cobs,
+        Slip
     };
-    Q_ENUM(ValidationStatus)
+    Q_ENUM(FrameMode)
 
     static Manager &instance();
 
@@ -140,8 +190,23 @@ public:
     bool configurationOk() const;
 
     int maxBufferSize() const;
+    int coalesceBytes() const;
+    int coalesceInterval() const;
+
+    quint64 framesPerSecond() const;
+    quint64 bytesPerSecond() const;
+    quint64 averageScanTime() const;
+    quint64 resyncCount() const;
+    quint64 droppedFrameCount() const;
+    quint64 checksumErrorCount() const;
+    quint64 bufferHighWaterMark() const;
+    quint64 bufferOverflowBytes() const;
 
     QIODevice *device();
+    Pipeline *pipeline();
+    Pipeline *createPipeline(const QString &tag);
+    void removePipeline(Pipeline *pipeline);
+    FrameMode frameMode() const;
     DataSource dataSource() const;
 
     QString startSequence() const;
@@ -149,6 +214,7 @@ public:
     QString separatorSequence() const;
 
     Q_INVOKABLE StringList dataSourcesList() const;
+    Q_INVOKABLE StringList frameModesList() const;
     Q_INVOKABLE qint64 writeData(const QByteArray &data);
 
 public Q_SLOTS:
@@ -157,32 +223,55 @@ public Q_SLOTS:
     void disconnectDevice();
     void setWriteEnabled(const bool enabled);
     void processPayload(const QByteArray &payload);
+    void publishPayload(const QByteArray &payload);
+    void publishPayloadBatch(const QVector<QByteArray> &payloads);
+    void processFrameBatch(const QVector<QByteArray> &frames);
+    void processRawData(const QByteArray &data);
+    void setFrameMode(const IO::Manager::FrameMode mode);
     void setMaxBufferSize(const int maxBufferSize);
+    void setCoalesceBytes(const int bytes);
+    void setCoalesceInterval(const int usecs);
     void setStartSequence(const QString &sequence);
     void setFinishSequence(const QString &sequence);
     void setSeparatorSequence(const QString &sequence);
     void setDataSource(const IO::Manager::DataSource &source);
 
 private Q_SLOTS:
-    void readFrames();
     void onDataReceived();
-    void clearTempBuffer();
+    void flushTxQueue();
+    void updateStatistics();
     void setDevice(QIODevice *device);
+    void onPipelineFrames(const QVector<QByteArray> &frames);
 
 private:
-    ValidationStatus integrityChecks(const QByteArray &frame,
-                                     const QByteArray &masterBuffer, int *bytesToChop);
-
-private:
-    bool m_enableCrc;
     bool m_writeEnabled;
     int m_maxBufferSize;
+    int m_coalesceBytes;
+    int m_coalesceInterval;
     QIODevice *m_device;
+    FrameMode m_frameMode;
     DataSource m_dataSource;
-    QByteArray m_dataBuffer;
     quint64 m_receivedBytes;
     QString m_startSequence;
     QString m_finishSequence;
     QString m_separatorSequence;
+
+    bool m_txFlushScheduled;
+    QVector<QByteArray> m_txQueue;
+
+    // Persistent RX buffer, device reads land directly into it so that the
+    // per-readyRead hot path does not allocate a fresh byte array
+    QByteArray m_readBuffer;
+
+    Pipeline m_pipeline;
+    QVector<Pipeline *> m_pipelines;
+
+    quint64 m_framesPerSecond;
+    quint64 m_bytesPerSecond;
+    quint64 m_averageScanTime;
+    quint64 m_lastFrameCount;
+    quint64 m_lastByteCount;
+    quint64 m_lastScanTime;
+    quint64 m_lastScanEvents;
 };
 }
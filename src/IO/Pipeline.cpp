@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <IO/Pipeline.h>
+#include <IO/FrameReader.h>
+#include <Misc/ThreadPolicy.h>
+
+/**
+ * Constructor function, starts the worker thread & connects the frame reader to the
+ * frame queue.
+ */
+IO::Pipeline::Pipeline(const QString &tag, QObject *parent)
+    : QObject(parent)
+    , m_tag(tag)
+    , m_device(Q_NULLPTR)
+    , m_frameReader(Q_NULLPTR)
+{
+    // Move the frame reader to a dedicated worker thread, delimiter scanning and
+    // checksum validation must not starve QML rendering at high baud rates
+    m_frameReader = new FrameReader(&m_frameQueue);
+    m_frameReader->moveToThread(&m_workerThread);
+    connect(&m_workerThread, &QThread::finished, m_frameReader, &QObject::deleteLater);
+    connect(m_frameReader, &FrameReader::framesQueued, this, &Pipeline::onFramesQueued,
+            Qt::QueuedConnection);
+    Misc::ThreadPolicy::instance().startThread(m_workerThread, m_frameReader, "ingest",
+                                               QThread::HighPriority);
+}
+
+/**
+ * Destructor function, stops the worker thread
+ */
+IO::Pipeline::~Pipeline()
+{
+    m_workerThread.quit();
+    m_workerThread.wait();
+}
+
+/**
+ * Returns the tag that identifies this pipeline (e.g. the device name)
+ */
+QString IO::Pipeline::tag() const
+{
+    return m_tag;
+}
+
+/**
+ * Returns a pointer to the device assigned to this pipeline.
+ *
+ * @warning you need to check this pointer before using it, it can have a @c Q_NULLPTR
+ *          value during normal operations.
+ */
+QIODevice *IO::Pipeline::device()
+{
+    return m_device;
+}
+
+/**
+ * Returns a pointer to the frame reader of this pipeline, used by the statistics code
+ * to poll the atomic ingestion counters.
+ */
+IO::FrameReader *IO::Pipeline::frameReader() const
+{
+    return m_frameReader;
+}
+
+/**
+ * Returns the number of frames dropped because the GUI thread could not keep up
+ */
+quint64 IO::Pipeline::droppedFrameCount() const
+{
+    return m_frameQueue.droppedFrames();
+}
+
+/**
+ * Resets the frame reader state (temp. buffer & CRC flag) & discards queued frames
+ */
+void IO::Pipeline::reset()
+{
+    QMetaObject::invokeMethod(m_frameReader, "reset", Qt::QueuedConnection);
+    m_frameQueue.clear();
+}
+
+/**
+ * Raises the worker thread to time-critical priority (or restores the default high
+ * priority). Used by the low latency mode of the serial data source to minimize the
+ * scheduling delay between a device read & the frame scan.
+ */
+void IO::Pipeline::setTimeCritical(const bool enabled)
+{
+    m_workerThread.setPriority(enabled ? QThread::TimeCriticalPriority
+                                       : QThread::HighPriority);
+}
+
+/**
+ * Assigns a device to this pipeline, incoming data shall be read & scanned for frames
+ * automatically. The device is not owned by the pipeline, deletion should be handled by
+ * the interface implementation. Pass @c Q_NULLPTR to detach the current device.
+ */
+void IO::Pipeline::setDevice(QIODevice *device)
+{
+    // Detach previous device
+    if (m_device)
+        m_device->disconnect(this, SLOT(onReadyRead()));
+
+    // Reset pipeline state & register new device
+    reset();
+    m_device = device;
+    if (m_device)
+        connect(m_device, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+
+    Q_EMIT deviceChanged();
+}
+
+/**
+ * Hands the given @a data to the frame reader thread. Used directly by the I/O manager
+ * for devices that need special read handling (e.g. UDP datagram batching).
+ */
+void IO::Pipeline::feedData(const QByteArray &data)
+{
+    if (!data.isEmpty())
+        QMetaObject::invokeMethod(m_frameReader, "processData", Qt::QueuedConnection,
+                                  Q_ARG(QByteArray, data));
+}
+
+/**
+ * Changes the framing mode used to extract frames from the data stream
+ */
+void IO::Pipeline::setFrameMode(const int mode)
+{
+    QMetaObject::invokeMethod(m_frameReader, "setFrameMode", Qt::QueuedConnection,
+                              Q_ARG(int, mode));
+}
+
+/**
+ * Changes the maximum permited size of the RX buffer
+ */
+void IO::Pipeline::setMaxBufferSize(const int maxBufferSize)
+{
+    QMetaObject::invokeMethod(m_frameReader, "setMaxBufferSize", Qt::QueuedConnection,
+                              Q_ARG(int, maxBufferSize));
+}
+
+/**
+ * Changes the frame start sequence used to delimit incoming frames
+ */
+void IO::Pipeline::setStartSequence(const QString &sequence)
+{
+    QMetaObject::invokeMethod(m_frameReader, "setStartSequence", Qt::QueuedConnection,
+                              Q_ARG(QString, sequence));
+}
+
+/**
+ * Changes the frame end sequence used to delimit incoming frames
+ */
+void IO::Pipeline::setFinishSequence(const QString &sequence)
+{
+    QMetaObject::invokeMethod(m_frameReader, "setFinishSequence", Qt::QueuedConnection,
+                              Q_ARG(QString, sequence));
+}
+
+/**
+ * Changes the read-coalescing parameters of the frame reader, see
+ * @c IO::FrameReader::setCoalesceSettings() for more information.
+ */
+void IO::Pipeline::setCoalesceSettings(const int bytes, const int usecs)
+{
+    QMetaObject::invokeMethod(m_frameReader, "setCoalesceSettings", Qt::QueuedConnection,
+                              Q_ARG(int, bytes), Q_ARG(int, usecs));
+}
+
+/**
+ * Reads all the available data from the device & hands it to the frame reader thread.
+ * The reads land directly in a persistent buffer; once the frame reader releases its
+ * implicitly-shared reference, the same allocation is reused for the next read, so the
+ * per-readyRead hot path does not allocate.
+ */
+void IO::Pipeline::onReadyRead()
+{
+    while (m_device)
+    {
+        // Size the buffer to the data waiting in the device
+        const auto available = m_device->bytesAvailable();
+        if (available <= 0)
+            break;
+
+        // Drop the storage if a consumer still references the previous
+        // chunk, otherwise resizing would copy the stale contents around
+        if (!m_readBuffer.isDetached())
+            m_readBuffer = QByteArray();
+
+        // Read directly into the buffer, without intermediate copies
+        m_readBuffer.resize(static_cast<int>(available));
+        const auto bytes = m_device->read(m_readBuffer.data(), available);
+        if (bytes <= 0)
+            break;
+
+        // Partial read, shrink the buffer to the data actually received
+        if (bytes < available)
+            m_readBuffer.resize(static_cast<int>(bytes));
+
+        // Hand the data to the frame reader thread & notify consumers
+        feedData(m_readBuffer);
+        Q_EMIT dataReceived(m_readBuffer);
+    }
+}
+
+/**
+ * Drains the frame queue & reports the extracted frames as a single batch. This function
+ * is called through a queued connection whenever the frame reader thread pushes a batch
+ * of frames, so it always runs on the GUI thread.
+ *
+ * Publishing the whole batch at once (instead of one signal per frame) lets the
+ * consumers amortize their per-frame work when a TCP burst or a fast-forwarded replay
+ * delivers hundreds of frames in a single pass, e.g. the JSON generator parses large
+ * batches on a worker pool.
+ */
+void IO::Pipeline::onFramesQueued()
+{
+    QByteArray frame;
+    QVector<QByteArray> frames;
+    while (m_frameQueue.dequeue(frame))
+        frames.append(frame);
+
+    if (!frames.isEmpty())
+        Q_EMIT framesReceived(frames);
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Pipeline.cpp"
+#endif
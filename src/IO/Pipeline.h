@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+#include <QVector>
+#include <QIODevice>
+#include <QByteArray>
+
+#include <IO/FrameQueue.h>
+
+namespace IO
+{
+class FrameReader;
+
+/**
+ * @brief The Pipeline class
+ *
+ * A pipeline bundles everything needed to turn the byte stream of one device
+ * into frames: a frame reader (with its own circular buffer & delimiter
+ * scanners) running on a dedicated worker thread, and a lock-free frame queue
+ * that carries the extracted frames back to the GUI thread.
+ *
+ * The I/O manager owns one pipeline for the primary device & can create
+ * additional pipelines (each identified by a tag) to ingest several devices
+ * concurrently from a single process. Each pipeline costs one thread & one
+ * RX buffer, which is much lighter than running one application instance per
+ * device.
+ */
+class Pipeline : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void deviceChanged();
+    void dataReceived(const QByteArray &data);
+    void framesReceived(const QVector<QByteArray> &frames);
+
+public:
+    explicit Pipeline(const QString &tag, QObject *parent = Q_NULLPTR);
+    ~Pipeline();
+
+    QString tag() const;
+    QIODevice *device();
+    FrameReader *frameReader() const;
+    quint64 droppedFrameCount() const;
+
+public Q_SLOTS:
+    void reset();
+    void setDevice(QIODevice *device);
+    void setTimeCritical(const bool enabled);
+    void feedData(const QByteArray &data);
+    void setFrameMode(const int mode);
+    void setMaxBufferSize(const int maxBufferSize);
+    void setStartSequence(const QString &sequence);
+    void setFinishSequence(const QString &sequence);
+    void setCoalesceSettings(const int bytes, const int usecs);
+
+private Q_SLOTS:
+    void onReadyRead();
+    void onFramesQueued();
+
+private:
+    QString m_tag;
+    QIODevice *m_device;
+    FrameQueue m_frameQueue;
+    QThread m_workerThread;
+    FrameReader *m_frameReader;
+
+    // Persistent RX buffer, device reads land directly into it so that the
+    // per-readyRead hot path does not allocate a fresh byte array
+    QByteArray m_readBuffer;
+};
+}
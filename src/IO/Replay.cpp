@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QtEndian>
+#include <QFileDialog>
+#include <QApplication>
+#include <QRegularExpression>
+
+#include <IO/Replay.h>
+#include <IO/Manager.h>
+
+/*
+ * Sanity limit for the payload length field of a capture record, larger values
+ * indicate a corrupt or truncated capture file.
+ */
+static const quint32 MAX_RECORD_SIZE = 64 * 1024 * 1024;
+
+//----------------------------------------------------------------------------------------
+// Replay worker (runs on a dedicated thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function
+ */
+IO::ReplayWorker::ReplayWorker(QObject *parent)
+    : QObject(parent)
+    , m_stop(0)
+    , m_speed(1)
+{
+}
+
+/**
+ * Aborts the current playback. Thread-safe, meant to be called directly from the GUI
+ * thread (the worker spends most of its time inside the pacing loop, a queued slot
+ * invocation would only be processed when playback ends).
+ */
+void IO::ReplayWorker::requestStop()
+{
+    m_stop.storeRelease(1);
+}
+
+/**
+ * Changes the playback speed (1x to 1000x). Thread-safe, the pacing loop picks up the
+ * new value on the next record.
+ */
+void IO::ReplayWorker::setSpeed(const int speed)
+{
+    m_speed.storeRelease(qBound(1, speed, 1000));
+}
+
+/**
+ * Plays back the capture session that starts with the given @a filePath. Segments of the
+ * session are played back-to-back until the last one ends or the user stops playback.
+ */
+void IO::ReplayWorker::replay(const QString &filePath)
+{
+    m_stop.storeRelease(0);
+
+    QElapsedTimer wall;
+    wall.start();
+
+    qint64 virtualUsecs = 0;
+    quint64 lastTimestamp = 0;
+
+    auto path = filePath;
+    while (!m_stop.loadAcquire() && !path.isEmpty() && QFile::exists(path))
+    {
+        if (!replaySegment(path, wall, virtualUsecs, lastTimestamp))
+            break;
+
+        path = nextSegment(path);
+    }
+
+    Q_EMIT finished();
+}
+
+/**
+ * Plays back a single capture file segment. Records are paced with a tight loop that
+ * compares the wall clock against a virtual clock advanced by the recorded inter-arrival
+ * times (scaled by the playback speed), so no per-record timer events are needed & the
+ * pacing error stays in the sub-millisecond range even at 1000x.
+ */
+bool IO::ReplayWorker::replaySegment(const QString &filePath, QElapsedTimer &wall,
+                                     qint64 &virtualUsecs, quint64 &lastTimestamp)
+{
+    // Open the segment file
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Read & play every record of the segment
+    int lastPercent = -1;
+    const auto total = qMax(qint64(1), file.size());
+    while (!m_stop.loadAcquire())
+    {
+        // Read the record header (timestamp + payload length)
+        uchar header[12];
+        if (file.read(reinterpret_cast<char *>(header), 12) != 12)
+            break;
+
+        // Parse the record header, an all-zero header marks the pre-sized tail of a
+        // segment that was not truncated (e.g. after a crash)
+        const quint64 timestamp = qFromLittleEndian<quint64>(header);
+        const quint32 length = qFromLittleEndian<quint32>(header + 8);
+        if (timestamp == 0 && length == 0)
+            break;
+
+        // Sanity-check the payload length & read the payload
+        if (length > MAX_RECORD_SIZE)
+            return false;
+        auto payload = file.read(length);
+        if (payload.size() != static_cast<int>(length))
+            break;
+
+        // Advance the virtual clock by the recorded inter-arrival time divided by the
+        // playback speed. The first record of the session plays immediately.
+        if (lastTimestamp > 0 && timestamp > lastTimestamp)
+        {
+            const auto speed = qBound(1, m_speed.loadAcquire(), 1000);
+            virtualUsecs += static_cast<qint64>(timestamp - lastTimestamp) * 1000 / speed;
+        }
+        lastTimestamp = timestamp;
+
+        // Tight pacing loop, sleep in small steps while the deadline is far away &
+        // spin for the final stretch
+        while (!m_stop.loadAcquire())
+        {
+            const auto elapsed = wall.nsecsElapsed() / 1000;
+            if (elapsed >= virtualUsecs)
+                break;
+            if (virtualUsecs - elapsed > 1000)
+                QThread::usleep(500);
+        }
+
+        // Feed the payload to the I/O manager
+        Q_EMIT payloadReady(payload);
+
+        // Report playback progress (only when the percentage changes)
+        const int percent = static_cast<int>(file.pos() * 100 / total);
+        if (percent != lastPercent)
+        {
+            lastPercent = percent;
+            Q_EMIT progressChanged(qreal(percent) / 100.0);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Returns the path of the segment that follows the given @a filePath in the capture
+ * session (e.g. "14-32-05-001.bin" for "14-32-05-000.bin"), or an empty string if the
+ * file name does not follow the segment naming scheme.
+ */
+QString IO::ReplayWorker::nextSegment(const QString &filePath)
+{
+    QRegularExpression regex("^(.*-)(\\d{3})(\\.bin)$");
+    auto match = regex.match(filePath);
+    if (!match.hasMatch())
+        return QString();
+
+    const int index = match.captured(2).toInt() + 1;
+    return match.captured(1) + QString::number(index).rightJustified(3, '0')
+        + match.captured(3);
+}
+
+//----------------------------------------------------------------------------------------
+// Replay module (runs on the GUI thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, starts the playback thread & connects the replay module to the
+ * I/O manager.
+ */
+IO::Replay::Replay()
+    : m_playing(false)
+    , m_progress(0)
+    , m_playbackSpeed(1)
+    , m_worker(Q_NULLPTR)
+{
+    // Move the replay worker to a dedicated thread, the pacing loop must not block
+    // the user interface
+    m_worker = new ReplayWorker();
+    m_worker->moveToThread(&m_workerThread);
+    connect(&m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &ReplayWorker::finished, this, &Replay::onWorkerFinished);
+    connect(m_worker, &ReplayWorker::progressChanged, this, &Replay::onProgressChanged);
+    connect(m_worker, &ReplayWorker::payloadReady, &IO::Manager::instance(),
+            &IO::Manager::processRawData);
+    m_workerThread.start();
+}
+
+/**
+ * Destructor function, aborts playback & stops the worker thread
+ */
+IO::Replay::~Replay()
+{
+    m_worker->requestStop();
+    m_workerThread.quit();
+    m_workerThread.wait();
+}
+
+/**
+ * Returns the only instance of this class
+ */
+IO::Replay &IO::Replay::instance()
+{
+    static Replay singleton;
+    return singleton;
+}
+
+/**
+ * Returns @c true if a capture file is currently being played back
+ */
+bool IO::Replay::isPlaying() const
+{
+    return m_playing;
+}
+
+/**
+ * Returns the playback progress of the current segment (range: 0.0 to 1.0)
+ */
+qreal IO::Replay::progress() const
+{
+    return m_progress;
+}
+
+/**
+ * Returns the current playback speed factor (1x to 1000x)
+ */
+int IO::Replay::playbackSpeed() const
+{
+    return m_playbackSpeed;
+}
+
+/**
+ * Returns the directory in which the capture module stores its recordings
+ */
+QString IO::Replay::captureFilesPath() const
+{
+    // clang-format off
+    const QString path = QString("%1/Documents/%2/Captures").arg(QDir::homePath(),
+                                                                 qApp->applicationName());
+    // clang-format on
+
+    QDir dir(path);
+    if (!dir.exists())
+        dir.mkpath(".");
+
+    return path;
+}
+
+/**
+ * Asks the user to select a capture file & starts playing it
+ */
+void IO::Replay::openFile()
+{
+    // clang-format off
+
+    // Get file name
+    auto file = QFileDialog::getOpenFileName(
+                Q_NULLPTR,
+                tr("Select capture file"),
+                captureFilesPath(),
+                tr("Capture files") + " (*.bin)");
+
+    // Open capture file
+    if (!file.isEmpty())
+        openFile(file);
+
+    // clang-format on
+}
+
+/**
+ * Aborts the current playback (if any)
+ */
+void IO::Replay::stopReplay()
+{
+    if (isPlaying())
+        m_worker->requestStop();
+}
+
+/**
+ * Starts playing the capture session that begins with the given @a filePath. Any device
+ * connection & any previous playback are stopped first.
+ */
+void IO::Replay::openFile(const QString &filePath)
+{
+    // Sanity check
+    if (filePath.isEmpty())
+        return;
+
+    // Stop previous playback & disconnect the device (replayed data must not be mixed
+    // with live data)
+    stopReplay();
+    if (IO::Manager::instance().connected())
+        IO::Manager::instance().disconnectDevice();
+
+    // Update player state
+    m_playing = true;
+    m_progress = 0;
+    Q_EMIT progressChanged();
+    Q_EMIT playerStateChanged();
+
+    // Start playback on the worker thread
+    m_worker->setSpeed(m_playbackSpeed);
+    QMetaObject::invokeMethod(m_worker, "replay", Qt::QueuedConnection,
+                              Q_ARG(QString, filePath));
+}
+
+/**
+ * Changes the playback speed factor (clamped to the 1x to 1000x range). The new speed
+ * takes effect immediately, even while a replay is running.
+ */
+void IO::Replay::setPlaybackSpeed(const int speed)
+{
+    m_playbackSpeed = qBound(1, speed, 1000);
+    m_worker->setSpeed(m_playbackSpeed);
+    Q_EMIT speedChanged();
+}
+
+/**
+ * Updates the player state when the worker finishes (or aborts) a playback
+ */
+void IO::Replay::onWorkerFinished()
+{
+    m_playing = false;
+    Q_EMIT playerStateChanged();
+}
+
+/**
+ * Updates the progress indicator shown to the user
+ */
+void IO::Replay::onProgressChanged(const qreal progress)
+{
+    m_progress = progress;
+    Q_EMIT progressChanged();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Replay.cpp"
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+namespace IO
+{
+/**
+ * @brief The ReplayWorker class
+ *
+ * Worker object that reads a capture file recorded by @c IO::Capture &
+ * re-plays the raw byte stream at the requested speed. Playback runs in a
+ * tight pacing loop on a dedicated thread, pacing is derived from the
+ * recorded arrival timestamps (scaled by the playback speed), so a 1000x
+ * replay pushes data at line rate without per-record timer events.
+ *
+ * Capture file segments are played back-to-back, the worker automatically
+ * continues with the next segment of the session when the current one ends.
+ */
+class ReplayWorker : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void finished();
+    void progressChanged(const qreal progress);
+    void payloadReady(const QByteArray &payload);
+
+public:
+    explicit ReplayWorker(QObject *parent = Q_NULLPTR);
+
+    void requestStop();
+    void setSpeed(const int speed);
+
+public Q_SLOTS:
+    void replay(const QString &filePath);
+
+private:
+    bool replaySegment(const QString &filePath, QElapsedTimer &wall,
+                       qint64 &virtualUsecs, quint64 &lastTimestamp);
+    QString nextSegment(const QString &filePath);
+
+private:
+    QAtomicInt m_stop;
+    QAtomicInt m_speed;
+};
+
+/**
+ * @brief The Replay class
+ *
+ * The replay module allows users to select a raw capture file (recorded by
+ * the @c IO::Capture module) & feed it back through the full ingestion
+ * pipeline (frame scanner, checksum validation, dashboard) at 1x to 1000x
+ * the original speed. Faster-than-realtime playback is useful to reproduce
+ * parser bugs & to benchmark the pipeline with recorded data.
+ */
+class Replay : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(bool isPlaying
+               READ isPlaying
+               NOTIFY playerStateChanged)
+    Q_PROPERTY(qreal progress
+               READ progress
+               NOTIFY progressChanged)
+    Q_PROPERTY(int playbackSpeed
+               READ playbackSpeed
+               WRITE setPlaybackSpeed
+               NOTIFY speedChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void speedChanged();
+    void progressChanged();
+    void playerStateChanged();
+
+private:
+    explicit Replay();
+    Replay(Replay &&) = delete;
+    Replay(const Replay &) = delete;
+    Replay &operator=(Replay &&) = delete;
+    Replay &operator=(const Replay &) = delete;
+
+    ~Replay();
+
+public:
+    static Replay &instance();
+
+    bool isPlaying() const;
+    qreal progress() const;
+    int playbackSpeed() const;
+    QString captureFilesPath() const;
+
+public Q_SLOTS:
+    void openFile();
+    void stopReplay();
+    void openFile(const QString &filePath);
+    void setPlaybackSpeed(const int speed);
+
+private Q_SLOTS:
+    void onWorkerFinished();
+    void onProgressChanged(const qreal progress);
+
+private:
+    bool m_playing;
+    qreal m_progress;
+    int m_playbackSpeed;
+    QThread m_workerThread;
+    ReplayWorker *m_worker;
+};
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstring>
+
+#include <IO/SequenceMatcher.h>
+
+/**
+ * Constructor function, compiles the skip table for the given @a pattern
+ */
+IO::SequenceMatcher::SequenceMatcher(const QByteArray &pattern)
+{
+    setPattern(pattern);
+}
+
+/**
+ * Returns the length of the search pattern in bytes
+ */
+int IO::SequenceMatcher::length() const
+{
+    return m_pattern.length();
+}
+
+/**
+ * Returns the search pattern used by the matcher
+ */
+const QByteArray &IO::SequenceMatcher::pattern() const
+{
+    return m_pattern;
+}
+
+/**
+ * Changes the search pattern & re-compiles the Boyer-Moore-Horspool bad-character
+ * skip table. This function is only called when the user changes the start/finish
+ * sequences, never in the data path.
+ */
+void IO::SequenceMatcher::setPattern(const QByteArray &pattern)
+{
+    m_pattern = pattern;
+
+    auto pLen = m_pattern.length();
+    memset(m_skipTable, qMax(1, pLen), sizeof(m_skipTable));
+    for (int i = 0; i < pLen - 1; ++i)
+        m_skipTable[static_cast<quint8>(m_pattern.at(i))] = pLen - 1 - i;
+}
+
+/**
+ * Returns the logical position of the first occurrence of the pattern at (or after) the
+ * given @a from position of the circular @a buffer, or -1 if the pattern is not present.
+ */
+int IO::SequenceMatcher::findIn(const CircularBuffer &buffer, const int from) const
+{
+    // Validate arguments
+    auto pLen = m_pattern.length();
+    if (pLen <= 0 || from < 0)
+        return -1;
+
+    // Single-byte pattern, use a plain scan (no skip table needed)
+    if (pLen == 1)
+    {
+        auto byte = m_pattern.at(0);
+        for (int i = from; i < buffer.size(); ++i)
+        {
+            if (buffer.at(i) == byte)
+                return i;
+        }
+
+        return -1;
+    }
+
+    // Multi-byte pattern, scan with bad-character skipping
+    auto i = from;
+    while (i + pLen <= buffer.size())
+    {
+        // Compare the pattern backwards, starting with the last byte
+        auto last = buffer.at(i + pLen - 1);
+        if (last == m_pattern.at(pLen - 1))
+        {
+            int j = pLen - 2;
+            while (j >= 0 && buffer.at(i + j) == m_pattern.at(j))
+                --j;
+
+            if (j < 0)
+                return i;
+        }
+
+        // Skip ahead based on the last examined byte
+        i += m_skipTable[static_cast<quint8>(last)];
+    }
+
+    return -1;
+}
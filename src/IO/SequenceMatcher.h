@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <IO/CircularBuffer.h>
+
+namespace IO
+{
+/**
+ * @brief The SequenceMatcher class
+ *
+ * Precompiled delimiter matcher used by the frame reader to locate the frame
+ * start/finish sequences inside the circular RX buffer. The matcher builds a
+ * Boyer-Moore-Horspool bad-character skip table once per pattern change, so
+ * searching for the typical two-byte delimiters examines only a fraction of
+ * the bytes that a naive scan would touch.
+ */
+class SequenceMatcher
+{
+public:
+    SequenceMatcher(const QByteArray &pattern = QByteArray());
+
+    int length() const;
+    const QByteArray &pattern() const;
+
+    void setPattern(const QByteArray &pattern);
+    int findIn(const CircularBuffer &buffer, const int from = 0) const;
+
+private:
+    QByteArray m_pattern;
+    quint8 m_skipTable[256];
+};
+}
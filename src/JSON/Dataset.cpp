@@ -20,14 +20,19 @@
  * THE SOFTWARE.
  */
 
+#include <QJsonArray>
+
 #include <JSON/Dataset.h>
 #include <JSON/Generator.h>
+#include <JSON/StringPool.h>
 
 JSON::Dataset::Dataset()
     : m_fft(false)
     , m_led(false)
+    , m_ledBitmask(false)
     , m_log(false)
     , m_graph(false)
+    , m_spectrogram(false)
     , m_title("")
     , m_value("")
     , m_units("")
@@ -36,7 +41,13 @@ JSON::Dataset::Dataset()
     , m_max(0)
     , m_min(0)
     , m_alarm(0)
+    , m_alarmLow(0)
+    , m_alarmRate(0)
     , m_fftSamples(1024)
+    , m_plotPoints(0)
+    , m_numericValid(false)
+    , m_numericValue(0)
+    , m_changed(true)
 {
 }
 
@@ -48,6 +59,16 @@ bool JSON::Dataset::fft() const
     return m_fft;
 }
 
+/**
+ * @return @c true if the UI should generate a spectrogram (waterfall) of this
+ *         dataset, the spectra are computed over a sample window of
+ *         @c fftSamples() values just like the FFT plot
+ */
+bool JSON::Dataset::spectrogram() const
+{
+    return m_spectrogram;
+}
+
 /**
  * @return @c true if the UI should generate a LED of this dataset
  */
@@ -56,6 +77,25 @@ bool JSON::Dataset::led() const
     return m_led;
 }
 
+/**
+ * @return @c true if the dataset value is a status bitmask, the LED panel
+ *         expands the integer value into one LED per entry of @c ledLabels()
+ *         instead of rendering a single LED for the whole dataset
+ */
+bool JSON::Dataset::ledBitmask() const
+{
+    return m_ledBitmask;
+}
+
+/**
+ * @return the LED titles of a bitmask dataset, the label at index @a i
+ *         describes bit @a i (LSB first) of the integer dataset value
+ */
+StringList JSON::Dataset::ledLabels() const
+{
+    return m_ledLabels;
+}
+
 /**
  * @return @c true if the UI should generate a logarithmic plot of this dataset
  */
@@ -104,6 +144,35 @@ double JSON::Dataset::alarm() const
     return m_alarm;
 }
 
+/**
+ * @return The low alarm level of the dataset, an alarm is raised when the
+ *         value falls below this level (@c 0 disables the rule)
+ */
+double JSON::Dataset::alarmLow() const
+{
+    return m_alarmLow;
+}
+
+/**
+ * @return The maximum allowed rate of change of the dataset in units per
+ *         second, an alarm is raised when the value changes faster
+ *         (@c 0 disables the rule)
+ */
+double JSON::Dataset::alarmRate() const
+{
+    return m_alarmRate;
+}
+
+/**
+ * @return The math expression that computes the value of this dataset from
+ *         the values of the other datasets of the frame, empty for regular
+ *         datasets whose value is read directly from the device
+ */
+QString JSON::Dataset::expression() const
+{
+    return m_expression;
+}
+
 /**
  * @return The title/description of this dataset
  */
@@ -120,6 +189,34 @@ QString JSON::Dataset::value() const
     return m_value;
 }
 
+/**
+ * @return The value of this dataset as a @c double, converted from the value
+ *         string on first access & cached until the value changes. Widgets &
+ *         plots shall use this function instead of converting @c value()
+ *         themselves, so that the numeric hot path does not re-run the text
+ *         conversion for every single access.
+ */
+double JSON::Dataset::numericValue() const
+{
+    if (!m_numericValid)
+    {
+        m_numericValue = m_value.toDouble();
+        m_numericValid = true;
+    }
+
+    return m_numericValue;
+}
+
+/**
+ * @return @c true if the value of this dataset differs from the value that it
+ *         had in the previous frame. Widgets use this flag to skip the rows
+ *         whose appearance did not change since the last update.
+ */
+bool JSON::Dataset::changed() const
+{
+    return m_changed;
+}
+
 /**
  * @return The units of this dataset
  */
@@ -144,6 +241,15 @@ int JSON::Dataset::fftSamples() const
     return qMax(1, m_fftSamples);
 }
 
+/**
+ * Returns the number of points stored & displayed by the plot of this dataset,
+ * or @c 0 when the dataset uses the global point count of the dashboard
+ */
+int JSON::Dataset::plotPoints() const
+{
+    return qMax(0, m_plotPoints);
+}
+
 /**
  * Returns the JSON data that represents this widget
  */
@@ -164,17 +270,31 @@ bool JSON::Dataset::read(const QJsonObject &object)
     {
         m_fft = object.value("fft").toBool();
         m_led = object.value("led").toBool();
+        m_ledBitmask = object.value("ledBitmask").toBool();
         m_log = object.value("log").toBool();
         m_min = object.value("min").toDouble();
         m_max = object.value("max").toDouble();
         m_index = object.value("index").toInt();
         m_alarm = object.value("alarm").toDouble();
+        m_alarmLow = object.value("alarmLow").toDouble();
+        m_alarmRate = object.value("alarmRate").toDouble();
         m_graph = object.value("graph").toBool();
-        m_title = object.value("title").toString();
+        m_title = StringPool::intern(object.value("title").toString());
         m_value = object.value("value").toString();
-        m_units = object.value("units").toString();
-        m_widget = object.value("widget").toString();
+        m_numericValid = false;
+        m_changed = true;
+        m_units = StringPool::intern(object.value("units").toString());
+        m_widget = StringPool::intern(object.value("widget").toString());
+        m_expression = StringPool::intern(object.value("expression").toString());
         m_fftSamples = object.value("fftSamples").toInt();
+        m_plotPoints = object.value("plotPoints").toInt();
+        m_spectrogram = object.value("spectrogram").toBool();
+
+        // Read the per-bit LED titles of bitmask datasets, label i names bit i
+        m_ledLabels.clear();
+        const auto ledLabels = object.value("ledLabels").toArray();
+        for (int i = 0; i < ledLabels.count(); ++i)
+            m_ledLabels.append(StringPool::intern(ledLabels.at(i).toString()));
 
         if (m_value.isEmpty())
             m_value = "--.--";
@@ -25,6 +25,7 @@
 #include <QObject>
 #include <QVariant>
 #include <QJsonObject>
+#include <DataTypes.h>
 
 namespace JSON
 {
@@ -68,18 +69,27 @@ public:
     Dataset();
 
     bool fft() const;
+    bool spectrogram() const;
     bool led() const;
+    bool ledBitmask() const;
+    StringList ledLabels() const;
     bool log() const;
     int index() const;
     bool graph() const;
     double min() const;
     double max() const;
     double alarm() const;
+    double alarmLow() const;
+    double alarmRate() const;
+    QString expression() const;
     QString title() const;
     QString value() const;
+    double numericValue() const;
+    bool changed() const;
     QString units() const;
     QString widget() const;
     int fftSamples() const;
+    int plotPoints() const;
     QJsonObject jsonData() const;
 
     bool read(const QJsonObject &object);
@@ -87,21 +97,40 @@ public:
 private:
     bool m_fft;
     bool m_led;
+    bool m_ledBitmask;
     bool m_log;
     bool m_graph;
+    bool m_spectrogram;
+    StringList m_ledLabels;
 
     QString m_title;
     QString m_value;
     QString m_units;
     QString m_widget;
+    QString m_expression;
     QJsonObject m_jsonData;
 
+    // Cached numeric representation of the value, computed lazily so that
+    // the widgets & plots do not re-run the string conversion per access
+    mutable bool m_numericValid;
+    mutable double m_numericValue;
+
+    // Set when the value differs from the one of the previous frame, used by
+    // the widgets to skip rows that do not need to be re-rendered
+    bool m_changed;
+
     // Editor-related variables
     int m_index;
     double m_max;
     double m_min;
     double m_alarm;
+    double m_alarmLow;
+    double m_alarmRate;
     int m_fftSamples;
+    int m_plotPoints;
     friend class Editor;
+    friend class Generator;
+    friend class FrameParser;
+    friend class Expressions;
 };
 }
@@ -20,7 +20,9 @@
  * THE SOFTWARE.
  */
 
+#include <QSet>
 #include <QFile>
+#include <QTimer>
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QFileDialog>
@@ -33,6 +35,44 @@
 #include <JSON/Generator.h>
 #include <Misc/Utilities.h>
 
+//----------------------------------------------------------------------------------------
+// Project loader (runs on a dedicated thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Number of groups appended to the editor model per event-loop iteration while a
+ * project file is being loaded. Small enough to keep the UI responsive, large
+ * enough that a project with hundreds of groups still populates within a few
+ * frames.
+ */
+static const int kGroupPopulateBatch = 8;
+
+/**
+ * Constructor function
+ */
+JSON::EditorLoader::EditorLoader(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * Reads & parses the JSON project file at the given @a path. The parsed document
+ * is sent to the editor through the @c documentLoaded() signal, read or parse
+ * failures yield an empty object.
+ */
+void JSON::EditorLoader::loadDocument(const QString &path)
+{
+    QFile file(path);
+    QJsonDocument document;
+    if (file.open(QFile::ReadOnly))
+    {
+        document = QJsonDocument::fromJson(file.readAll());
+        file.close();
+    }
+
+    Q_EMIT documentLoaded(path, document.object());
+}
+
 //----------------------------------------------------------------------------------------
 // Constructor/deconstructor & singleton
 //----------------------------------------------------------------------------------------
@@ -49,8 +89,21 @@ JSON::Editor::Editor()
     , m_frameEndSequence("")
     , m_frameStartSequence("")
     , m_modified(false)
+    , m_fp32Storage(false)
     , m_filePath("")
-{
+    , m_pendingIndex(0)
+    , m_loader(Q_NULLPTR)
+    , m_indexDirty(true)
+{
+    // Move the project loader to a dedicated thread, reading & parsing a large
+    // project file must never block the user interface
+    qRegisterMetaType<QJsonObject>("QJsonObject");
+    m_loader = new EditorLoader;
+    m_loader->moveToThread(&m_loaderThread);
+    connect(&m_loaderThread, &QThread::finished, m_loader, &QObject::deleteLater);
+    connect(m_loader, &JSON::EditorLoader::documentLoaded, this,
+            &JSON::Editor::onDocumentLoaded, Qt::QueuedConnection);
+
     // clang-format off
 
     // Connect signals/slots
@@ -62,6 +115,8 @@ JSON::Editor::Editor()
             this, &JSON::Editor::onDatasetChanged);
     connect(this, &JSON::Editor::separatorChanged,
             this, &JSON::Editor::onModelChanged);
+    connect(this, &JSON::Editor::fp32StorageChanged,
+            this, &JSON::Editor::onModelChanged);
     connect(this, &JSON::Editor::groupCountChanged,
             this, &JSON::Editor::onModelChanged);
     connect(this, &JSON::Editor::groupOrderChanged,
@@ -78,6 +133,22 @@ JSON::Editor::Editor()
     // clang-format on
 }
 
+/**
+ * Stop the loader thread before destroying the class
+ */
+JSON::Editor::~Editor()
+{
+    if (m_loaderThread.isRunning())
+    {
+        m_loaderThread.quit();
+        m_loaderThread.wait();
+    }
+
+    // The loader thread never ran, delete the worker directly
+    else
+        delete m_loader;
+}
+
 /**
  * Returns a pointer to the only instance of the editor class.
  */
@@ -136,6 +207,15 @@ QString JSON::Editor::title() const
     return m_title;
 }
 
+/**
+ * Returns @c true if the current project stores plot & history samples as 32-bit
+ * floats instead of doubles.
+ */
+bool JSON::Editor::fp32Storage() const
+{
+    return m_fp32Storage;
+}
+
 /**
  * Returns the data separator sequence for the current project.
  */
@@ -238,42 +318,35 @@ bool JSON::Editor::saveJsonFile()
         return false;
     }
 
-    // Validate group titles
+    // Validate the group & dataset configuration in a single pass over the model,
+    // duplicate frame indexes are detected with a hash set instead of a quadratic
+    // list scan
+    QSet<int> indexes;
     for (int i = 0; i < groupCount(); ++i)
     {
-        if (groupTitle(i).isEmpty())
+        // Validate group title
+        const auto &group = getGroup(i);
+        if (group.title().isEmpty())
         {
             Misc::Utilities::showMessageBox(tr("Project error - Group %1").arg(i + 1),
                                             tr("Group title cannot be empty!"));
             return false;
         }
-    }
 
-    // Validate dataset titles
-    for (int i = 0; i < groupCount(); ++i)
-    {
-        for (int j = 0; j < datasetCount(i); ++j)
+        for (int j = 0; j < group.m_datasets.count(); ++j)
         {
-            if (datasetTitle(i, j).isEmpty())
+            // Validate dataset title
+            const auto &set = group.m_datasets.at(j);
+            if (set.title().isEmpty())
             {
                 Misc::Utilities::showMessageBox(
                     tr("Project error - Group %1, Dataset %2").arg(i + 1).arg(j + 1),
                     tr("Dataset title cannot be empty!"));
                 return false;
             }
-        }
-    }
-
-    // Validate dataset indexes
-    QVector<int> indexes;
-    for (int i = 0; i < groupCount(); ++i)
-    {
-        for (int j = 0; j < datasetCount(i); ++j)
-        {
-            if (!indexes.contains(datasetIndex(i, j)))
-                indexes.append(datasetIndex(i, j));
 
-            else
+            // Validate dataset index
+            if (indexes.contains(set.m_index))
             {
                 auto ret = Misc::Utilities::showMessageBox(
                     tr("Warning - Group %1, Dataset %2").arg(i + 1).arg(j + 1),
@@ -283,6 +356,9 @@ bool JSON::Editor::saveJsonFile()
                 if (ret == QMessageBox::No)
                     return false;
             }
+
+            else
+                indexes.insert(set.m_index);
         }
     }
 
@@ -308,45 +384,24 @@ bool JSON::Editor::saveJsonFile()
     // Create JSON document & add properties
     QJsonObject json;
     json.insert("title", title());
+    json.insert("fp32", fp32Storage());
     json.insert("separator", separator());
     json.insert("frameEnd", frameEndSequence());
     json.insert("frameStart", frameStartSequence());
 
-    // Create group array
+    // Serialize the groups, re-using the cached JSON of the groups that have not
+    // been edited since the last save. Editing sessions involve dozens of saves
+    // that each touch one or two groups, so most of the serialization work is
+    // skipped.
+    if (m_groupJsonCache.count() != groupCount())
+        m_groupJsonCache = QVector<QJsonObject>(groupCount());
     QJsonArray groups;
     for (int i = 0; i < groupCount(); ++i)
     {
-        // Create group
-        QJsonObject group;
-        group.insert("title", groupTitle(i));
-        group.insert("widget", groupWidget(i));
-
-        // Create dataset array
-        QJsonArray datasets;
-        for (int j = 0; j < datasetCount(i); ++j)
-        {
-            // Create dataset
-            QJsonObject dataset;
-            dataset.insert("led", datasetLED(i, j));
-            dataset.insert("fft", datasetFftPlot(i, j));
-            dataset.insert("log", datasetLogPlot(i, j));
-            dataset.insert("title", datasetTitle(i, j));
-            dataset.insert("units", datasetUnits(i, j));
-            dataset.insert("graph", datasetGraph(i, j));
-            dataset.insert("widget", datasetWidget(i, j));
-            dataset.insert("min", datasetWidgetMin(i, j).toDouble());
-            dataset.insert("max", datasetWidgetMax(i, j).toDouble());
-            dataset.insert("alarm", datasetWidgetAlarm(i, j).toDouble());
-            dataset.insert("fftSamples", datasetFFTSamples(i, j).toInt());
-            dataset.insert("value", "%" + QString::number(datasetIndex(i, j)));
-
-            // Add dataset to array
-            datasets.append(dataset);
-        }
+        if (m_groupJsonCache.at(i).isEmpty())
+            m_groupJsonCache[i] = writeProjectGroup(getGroup(i));
 
-        // Add datasets to group
-        group.insert("datasets", datasets);
-        groups.append(group);
+        groups.append(m_groupJsonCache.at(i));
     }
 
     // Add groups array to JSON
@@ -356,8 +411,15 @@ bool JSON::Editor::saveJsonFile()
     file.write(QJsonDocument(json).toJson(QJsonDocument::Indented));
     file.close();
 
-    // Load JSON file to Serial Studio
-    openJsonFile(file.fileName());
+    // Apply the project settings to the IO manager
+    IO::Manager::instance().setSeparatorSequence(separator());
+    IO::Manager::instance().setFinishSequence(frameEndSequence());
+    IO::Manager::instance().setStartSequence(frameStartSequence());
+
+    // Register the saved state & let the generator reload the project file, the
+    // editor model already matches the saved document so it is not re-populated
+    Q_EMIT jsonFileChanged();
+    setModified(false);
     Generator::instance().loadJsonMap(file.fileName());
     return true;
 }
@@ -387,6 +449,47 @@ const JSON::Dataset &JSON::Editor::getDataset(const int group, const int index)
     return getGroup(group).getDataset(index);
 }
 
+/**
+ * Returns a pointer to the dataset with the given frame @a frameIndex, or
+ * @c Q_NULLPTR when no dataset of the project uses that index. When several
+ * datasets share an index, the first one in model order is returned. The
+ * lookup is O(1), the underlying hash index is rebuilt lazily after the
+ * project model changes.
+ */
+const JSON::Dataset *JSON::Editor::findDataset(const int frameIndex) const
+{
+    if (m_indexDirty)
+        rebuildDatasetIndex();
+
+    const auto it = m_datasetIndex.constFind(frameIndex);
+    if (it == m_datasetIndex.constEnd())
+        return Q_NULLPTR;
+
+    return &getDataset(it.value().first, it.value().second);
+}
+
+/**
+ * Returns the datasets of the project with duplicate frame indexes removed,
+ * in model order (first occurrence wins). The CSV export & other consumers
+ * use this list to build their column tables without a quadratic
+ * "have I seen this index before" scan.
+ */
+QVector<const JSON::Dataset *> JSON::Editor::uniqueDatasets() const
+{
+    if (m_indexDirty)
+        rebuildDatasetIndex();
+
+    QVector<const Dataset *> datasets;
+    datasets.reserve(m_indexOrder.count());
+    for (int i = 0; i < m_indexOrder.count(); ++i)
+    {
+        const auto position = m_datasetIndex.value(m_indexOrder.at(i));
+        datasets.append(&getDataset(position.first, position.second));
+    }
+
+    return datasets;
+}
+
 /**
  * Returns the title of the given @a group.
  */
@@ -452,6 +555,30 @@ bool JSON::Editor::datasetLED(const int group, const int dataset) const
     return getDataset(group, dataset).led();
 }
 
+/**
+ * Returns @c true if the given @a dataset is a status bitmask, in which case the LED
+ * panel renders one LED per bit label instead of a single LED for the dataset.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+bool JSON::Editor::datasetLedBitmask(const int group, const int dataset) const
+{
+    return getDataset(group, dataset).ledBitmask();
+}
+
+/**
+ * Returns the per-bit LED titles of the given bitmask @a dataset as a comma-separated
+ * string (bit 0 first), ready to be displayed by a text field of the project editor.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+QString JSON::Editor::datasetLedLabels(const int group, const int dataset) const
+{
+    return getDataset(group, dataset).ledLabels().join(", ");
+}
+
 /**
  * Returns @c true if Serial Studio should graph the data of the given
  * @a dataset (which is contained by the specified @a group).
@@ -476,6 +603,19 @@ bool JSON::Editor::datasetFftPlot(const int group, const int dataset) const
     return getDataset(group, dataset).fft();
 }
 
+/**
+ * Returns @c true if Serial Studio should display a spectrogram (waterfall) of
+ * the data of the given @a dataset (which is contained by the specified
+ * @a group).
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+bool JSON::Editor::datasetSpectrogram(const int group, const int dataset) const
+{
+    return getDataset(group, dataset).spectrogram();
+}
+
 /**
  * Returns @c true if Serial Studio should graph the data of the given
  * @a dataset (which is contained by the specified @a group) with a
@@ -579,6 +719,18 @@ QString JSON::Editor::datasetFFTSamples(const int group, const int dataset) cons
     return QString::number(getDataset(group, dataset).fftSamples());
 }
 
+/**
+ * Returns the number of points plotted for the specified dataset, @c 0 means
+ * that the dataset follows the global point count of the dashboard.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+QString JSON::Editor::datasetPlotPoints(const int group, const int dataset) const
+{
+    return QString::number(getDataset(group, dataset).plotPoints());
+}
+
 /**
  * Returns the widget alarm value of the specified dataset.
  * This option is used by the bar & gauge widgets.
@@ -596,6 +748,36 @@ QString JSON::Editor::datasetWidgetAlarm(const int group, const int dataset) con
     return QString::number(set.alarm());
 }
 
+/**
+ * Returns the low alarm level of the given @a dataset (as a string for the
+ * text fields of the JSON editor), an alarm is raised when the dataset value
+ * falls below this level & @c 0 disables the rule
+ */
+QString JSON::Editor::datasetAlarmLow(const int group, const int dataset) const
+{
+    return QString::number(getDataset(group, dataset).alarmLow());
+}
+
+/**
+ * Returns the maximum allowed rate of change of the given @a dataset in
+ * units per second (as a string for the text fields of the JSON editor),
+ * @c 0 disables the rule
+ */
+QString JSON::Editor::datasetAlarmRate(const int group, const int dataset) const
+{
+    return QString::number(getDataset(group, dataset).alarmRate());
+}
+
+/**
+ * Returns the math expression that computes the value of the given @a dataset
+ * from the values of the other datasets of the frame, empty for regular
+ * datasets whose value is read directly from the device
+ */
+QString JSON::Editor::datasetExpression(const int group, const int dataset) const
+{
+    return getDataset(group, dataset).expression();
+}
+
 //----------------------------------------------------------------------------------------
 // Public slots
 //----------------------------------------------------------------------------------------
@@ -605,12 +787,17 @@ QString JSON::Editor::datasetWidgetAlarm(const int group, const int dataset) con
  */
 void JSON::Editor::newJsonFile()
 {
+    // Cancel a progressive project load that may still be in flight
+    m_pendingIndex = 0;
+    m_pendingGroups = QJsonArray();
+
     // Clear groups list
     m_groups.clear();
 
     // Reset project properties
     setTitle("");
     setSeparator("");
+    setFp32Storage(false);
     setFrameEndSequence("");
     setFrameStartSequence("");
 
@@ -646,27 +833,36 @@ void JSON::Editor::openJsonFile()
 
 /**
  * Opens the JSON document at the given @a path & generates the appropiate C++
- * model that represents the JSON document.
+ * model that represents the JSON document. The file is read & parsed on the
+ * loader thread, the model is populated progressively once the document
+ * arrives (see @c onDocumentLoaded()).
  */
 void JSON::Editor::openJsonFile(const QString &path)
 {
-    // Open file
-    QFile file(path);
-    QJsonDocument document;
-    if (file.open(QFile::ReadOnly))
-    {
-        document = QJsonDocument::fromJson(file.readAll());
-        file.close();
-    }
+    // File name empty, abort
+    if (path.isEmpty())
+        return;
 
-    // Validate JSON document
+    // Parse the document on the loader thread. The thread is only started once
+    // the user opens a project, so that it does not add to the startup cost.
+    if (!m_loaderThread.isRunning())
+        m_loaderThread.start(QThread::LowPriority);
+    QMetaObject::invokeMethod(m_loader, "loadDocument", Qt::QueuedConnection,
+                              Q_ARG(QString, path));
+}
+
+/**
+ * Registers the JSON document parsed by the loader thread: the project
+ * properties are applied immediately & the group/dataset model is populated
+ * progressively by @c populatePendingGroups(), so the editor window opens
+ * without waiting for hundreds of datasets to be registered.
+ */
+void JSON::Editor::onDocumentLoaded(const QString &path, const QJsonObject &document)
+{
+    // Document empty or invalid, abort
     if (document.isEmpty())
         return;
 
-    // Let the generator use the given JSON file
-    if (Generator::instance().jsonMapFilepath() != path)
-        Generator::instance().loadJsonMap(path);
-
     // Reset C++ model
     newJsonFile();
 
@@ -674,12 +870,16 @@ void JSON::Editor::openJsonFile(const QString &path)
     m_filePath = path;
     Q_EMIT jsonFileChanged();
 
+    // Let the generator use the given JSON file
+    if (Generator::instance().jsonMapFilepath() != path)
+        Generator::instance().loadJsonMap(path);
+
     // Read data from JSON document
-    auto json = document.object();
-    setTitle(json.value("title").toString());
-    setSeparator(json.value("separator").toString());
-    setFrameEndSequence(json.value("frameEnd").toString());
-    setFrameStartSequence(json.value("frameStart").toString());
+    setTitle(document.value("title").toString());
+    setFp32Storage(document.value("fp32").toBool());
+    setSeparator(document.value("separator").toString());
+    setFrameEndSequence(document.value("frameEnd").toString());
+    setFrameStartSequence(document.value("frameStart").toString());
 
     // Modify IO manager settings
     IO::Manager::instance().setSeparatorSequence(separator());
@@ -689,55 +889,47 @@ void JSON::Editor::openJsonFile(const QString &path)
     // Set JSON::Generator operation mode to manual
     JSON::Generator::instance().setOperationMode(JSON::Generator::kManual);
 
-    // Read groups from JSON document
-    auto groups = json.value("groups").toArray();
-    for (int g = 0; g < groups.count(); ++g)
-    {
-        // Get JSON group data
-        auto group = groups.at(g).toObject();
+    // Populate the group/dataset model in batches
+    m_pendingIndex = 0;
+    m_pendingGroups = document.value("groups").toArray();
+    populatePendingGroups();
+}
 
-        // Register group with C++ model
-        addGroup();
-        setGroupTitle(g, group.value("title").toString());
-        setGroupWidgetData(g, group.value("widget").toString());
+/**
+ * Appends the next batch of groups of the project file that is being loaded to
+ * the C++ model & re-schedules itself until every group has been registered.
+ * The group objects are built directly from their JSON representation instead
+ * of going through the per-property editor slots, which used to copy the whole
+ * group & emit a change signal for every single field.
+ */
+void JSON::Editor::populatePendingGroups()
+{
+    // Project closed or replaced while the load was in flight, abort
+    if (m_pendingGroups.isEmpty())
+        return;
 
-        // Get JSON group datasets
-        auto datasets = group.value("datasets").toArray();
-        for (int d = 0; d < datasets.count(); ++d)
-        {
-            // Get dataset JSON data
-            auto dataset = datasets.at(d).toObject();
-
-            // Register dataset with C++ model
-            addDataset(g);
-            setDatasetLED(g, d, dataset.value("led").toBool());
-            setDatasetFftPlot(g, d, dataset.value("fft").toBool());
-            setDatasetLogPlot(g, d, dataset.value("log").toBool());
-            setDatasetGraph(g, d, dataset.value("graph").toBool());
-            setDatasetTitle(g, d, dataset.value("title").toString());
-            setDatasetUnits(g, d, dataset.value("units").toString());
-            setDatasetWidgetData(g, d, dataset.value("widget").toString());
-
-            // Get max/min texts
-            auto min = dataset.value("min").toDouble();
-            auto max = dataset.value("max").toDouble();
-            auto alarm = dataset.value("alarm").toDouble();
-            auto fftSamples = dataset.value("fftSamples").toInt();
-            setDatasetWidgetMin(g, d, QString::number(min));
-            setDatasetWidgetMax(g, d, QString::number(max));
-            setDatasetWidgetAlarm(g, d, QString::number(alarm));
-            setDatasetFFTSamples(g, d, QString::number(fftSamples));
-
-            // Calculate dataset index
-            auto index = dataset.value("value").toString();
-            index.replace("%", "");
-            setDatasetIndex(g, d, index.toInt());
-        }
+    // Append the next batch of groups to the model
+    const int end = qMin(m_pendingGroups.count(), m_pendingIndex + kGroupPopulateBatch);
+    while (m_pendingIndex < end)
+    {
+        m_groups.append(readProjectGroup(m_pendingGroups.at(m_pendingIndex).toObject()));
+        ++m_pendingIndex;
     }
 
-    // Update UI
+    // Update the UI after every batch so that the group list grows progressively
     Q_EMIT groupCountChanged();
-    setModified(false);
+
+    // Schedule the next batch through the event loop
+    if (m_pendingIndex < m_pendingGroups.count())
+        QTimer::singleShot(0, this, SLOT(populatePendingGroups()));
+
+    // Every group registered, finish the load
+    else
+    {
+        m_pendingIndex = 0;
+        m_pendingGroups = QJsonArray();
+        setModified(false);
+    }
 }
 
 /**
@@ -764,6 +956,20 @@ void JSON::Editor::setSeparator(const QString &separator)
     }
 }
 
+/**
+ * Enables/disables 32-bit float storage for the plot & history buffers of the JSON
+ * project file. Halves the memory footprint of large dashboards, adequate for any
+ * sensor with fewer than ~24 bits of real resolution.
+ */
+void JSON::Editor::setFp32Storage(const bool enabled)
+{
+    if (enabled != m_fp32Storage)
+    {
+        m_fp32Storage = enabled;
+        Q_EMIT fp32StorageChanged();
+    }
+}
+
 /**
  * Changes the frame end sequence of the JSON project file.
  */
@@ -1147,6 +1353,61 @@ void JSON::Editor::setDatasetLED(const int group, const int dataset,
     Q_EMIT datasetChanged(group, dataset);
 }
 
+/**
+ * Updates the @a bitmask flag of the given @a dataset, bitmask datasets hold a status
+ * integer whose bits are expanded into individual LEDs by the LED panel.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+void JSON::Editor::setDatasetLedBitmask(const int group, const int dataset,
+                                        const bool bitmask)
+{
+    // Get dataset & group
+    auto grp = getGroup(group);
+    auto set = getDataset(group, dataset);
+
+    // Update dataset & group
+    set.m_ledBitmask = bitmask;
+    grp.m_datasets.replace(dataset, set);
+    m_groups.replace(group, grp);
+
+    // Update UI
+    Q_EMIT datasetChanged(group, dataset);
+}
+
+/**
+ * Updates the per-bit LED titles of the given bitmask @a dataset, the @a labels string
+ * holds one title per bit (bit 0 first) separated by commas.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+void JSON::Editor::setDatasetLedLabels(const int group, const int dataset,
+                                       const QString &labels)
+{
+    // Get dataset & group
+    auto grp = getGroup(group);
+    auto set = getDataset(group, dataset);
+
+    // Split the comma-separated label list & trim the individual titles
+    StringList titles;
+    Q_FOREACH (auto label, labels.split(','))
+    {
+        auto title = label.trimmed();
+        if (!title.isEmpty())
+            titles.append(title);
+    }
+
+    // Update dataset & group
+    set.m_ledLabels = titles;
+    grp.m_datasets.replace(dataset, set);
+    m_groups.replace(group, grp);
+
+    // Update UI
+    Q_EMIT datasetChanged(group, dataset);
+}
+
 /**
  * Updates the @a generateGraph flag of the given @a dataset.
  *
@@ -1191,6 +1452,28 @@ void JSON::Editor::setDatasetFftPlot(const int group, const int dataset,
     Q_EMIT datasetChanged(group, dataset);
 }
 
+/**
+ * Updates the @a generateSpectrogram flag of the given @a dataset.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+void JSON::Editor::setDatasetSpectrogram(const int group, const int dataset,
+                                         const bool generateSpectrogram)
+{
+    // Get dataset & group
+    auto grp = getGroup(group);
+    auto set = getDataset(group, dataset);
+
+    // Update dataset & group
+    set.m_spectrogram = generateSpectrogram;
+    grp.m_datasets.replace(dataset, set);
+    m_groups.replace(group, grp);
+
+    // Update UI
+    Q_EMIT datasetChanged(group, dataset);
+}
+
 /**
  * Updates the @a generateLog flag of the given @a dataset.
  *
@@ -1343,6 +1626,78 @@ void JSON::Editor::setDatasetWidgetAlarm(const int group, const int dataset,
     Q_EMIT datasetChanged(group, dataset);
 }
 
+/**
+ * Updates the low @a alarm level of the given @a dataset, an alarm is raised
+ * when the dataset value falls below this level (@c 0 disables the rule).
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+void JSON::Editor::setDatasetAlarmLow(const int group, const int dataset,
+                                      const QString &alarm)
+{
+    // Get dataset & group
+    auto grp = getGroup(group);
+    auto set = getDataset(group, dataset);
+
+    // Update dataset & group
+    set.m_alarmLow = alarm.toDouble();
+    grp.m_datasets.replace(dataset, set);
+    m_groups.replace(group, grp);
+
+    // Update UI
+    Q_EMIT datasetChanged(group, dataset);
+}
+
+/**
+ * Updates the maximum allowed @a rate of change of the given @a dataset in
+ * units per second, an alarm is raised when the value changes faster
+ * (@c 0 disables the rule).
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+void JSON::Editor::setDatasetAlarmRate(const int group, const int dataset,
+                                       const QString &rate)
+{
+    // Get dataset & group
+    auto grp = getGroup(group);
+    auto set = getDataset(group, dataset);
+
+    // Update dataset & group
+    set.m_alarmRate = rate.toDouble();
+    grp.m_datasets.replace(dataset, set);
+    m_groups.replace(group, grp);
+
+    // Update UI
+    Q_EMIT datasetChanged(group, dataset);
+}
+
+/**
+ * Updates the math @a expression that computes the value of the given
+ * @a dataset from the values of the other datasets of the frame, an empty
+ * expression turns the dataset back into a regular one whose value is read
+ * directly from the device.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+void JSON::Editor::setDatasetExpression(const int group, const int dataset,
+                                        const QString &expression)
+{
+    // Get dataset & group
+    auto grp = getGroup(group);
+    auto set = getDataset(group, dataset);
+
+    // Update dataset & group
+    set.m_expression = expression;
+    grp.m_datasets.replace(dataset, set);
+    m_groups.replace(group, grp);
+
+    // Update UI
+    Q_EMIT datasetChanged(group, dataset);
+}
+
 /**
  * Updates the @a samples used for FFT plotting.
  *
@@ -1370,6 +1725,34 @@ void JSON::Editor::setDatasetFFTSamples(const int group, const int dataset,
     Q_EMIT datasetChanged(group, dataset);
 }
 
+/**
+ * Updates the number of @a points plotted for the given dataset, @c 0 keeps
+ * the dataset on the global point count of the dashboard.
+ *
+ * @param group   index of the group in which the dataset belongs
+ * @param dataset index of the dataset
+ */
+void JSON::Editor::setDatasetPlotPoints(const int group, const int dataset,
+                                        const QString &points)
+{
+    // Get dataset & group
+    auto grp = getGroup(group);
+    auto set = getDataset(group, dataset);
+
+    // Validate point count, 0 selects the global dashboard setting
+    auto count = points.toInt();
+    if (count < 0)
+        count = 0;
+
+    // Update dataset & group
+    set.m_plotPoints = count;
+    grp.m_datasets.replace(dataset, set);
+    m_groups.replace(group, grp);
+
+    // Update UI
+    Q_EMIT datasetChanged(group, dataset);
+}
+
 /**
  * Updates the @a modified flag of the current JSON project.
  * This flag is used to know if we should ask the user to save
@@ -1377,6 +1760,10 @@ void JSON::Editor::setDatasetFFTSamples(const int group, const int dataset,
  */
 void JSON::Editor::setModified(const bool modified)
 {
+    // Every model edit & file load passes through here, invalidate the hash
+    // index so the next lookup regenerates it
+    m_indexDirty = true;
+
     m_modified = modified;
     Q_EMIT modifiedChanged();
 }
@@ -1393,34 +1780,45 @@ void JSON::Editor::onJsonLoaded()
 
 /**
  * Sets the modified flag to @c true when the user adds/removes/moves
- * one of the groups contained in the JSON project.
+ * one of the groups contained in the JSON project. Structural changes
+ * shift the group positions, so the whole serialization cache is dropped.
  */
 void JSON::Editor::onModelChanged()
 {
+    m_groupJsonCache.clear();
     setModified(true);
 }
 
 /**
  * Sets the modified flag to @c true when the user changes the title
  * or the widget of one of the groups contained in the JSON project.
+ * The cached JSON of the edited group is invalidated, so the next save
+ * only re-serializes this group.
  */
 void JSON::Editor::onGroupChanged(const int group)
 {
-    (void)group;
+    if (group >= 0 && group < m_groupJsonCache.count())
+        m_groupJsonCache[group] = QJsonObject();
+
     setModified(true);
 }
 
 /**
  * Sets the modified flag to @c true when the user modifies the
  * properties of one of the datasets contained in the JSON project.
+ * The cached JSON of the parent group is invalidated, so the next save
+ * only re-serializes that group.
  *
  * @param group   index of the group in which the dataset belongs
  * @param dataset index of the dataset
  */
 void JSON::Editor::onDatasetChanged(const int group, const int dataset)
 {
-    (void)group;
     (void)dataset;
+
+    if (group >= 0 && group < m_groupJsonCache.count())
+        m_groupJsonCache[group] = QJsonObject();
+
     setModified(true);
 }
 
@@ -1433,18 +1831,160 @@ void JSON::Editor::onDatasetChanged(const int group, const int dataset)
  */
 int JSON::Editor::nextDatasetIndex()
 {
+    if (m_indexDirty)
+        rebuildDatasetIndex();
+
     int maxIndex = 1;
-    for (int i = 0; i < groupCount(); ++i)
+    for (auto it = m_datasetIndex.constBegin(); it != m_datasetIndex.constEnd(); ++it)
     {
-        for (int j = 0; j < datasetCount(i); ++j)
+        if (it.key() >= maxIndex)
+            maxIndex = it.key() + 1;
+    }
+
+    return maxIndex;
+}
+
+/**
+ * Regenerates the hash index over the project model. Called lazily by the
+ * lookup functions after a modification, every model edit only pays for a
+ * flag write.
+ */
+void JSON::Editor::rebuildDatasetIndex() const
+{
+    m_indexOrder.clear();
+    m_datasetIndex.clear();
+
+    for (int i = 0; i < m_groups.count(); ++i)
+    {
+        const auto &datasets = m_groups.at(i).m_datasets;
+        for (int j = 0; j < datasets.count(); ++j)
         {
-            auto dataset = getDataset(i, j);
-            if (dataset.m_index >= maxIndex)
-                maxIndex = dataset.m_index + 1;
+            const auto index = datasets.at(j).m_index;
+            if (!m_datasetIndex.contains(index))
+            {
+                m_indexOrder.append(index);
+                m_datasetIndex.insert(index, qMakePair(i, j));
+            }
         }
     }
 
-    return maxIndex;
+    m_indexDirty = false;
+}
+
+/**
+ * Builds a group object directly from its project-file JSON representation,
+ * the datasets are registered through @c readProjectDataset().
+ */
+JSON::Group JSON::Editor::readProjectGroup(const QJsonObject &object) const
+{
+    Group group;
+    group.m_title = object.value("title").toString();
+    group.m_widget = object.value("widget").toString();
+
+    const auto datasets = object.value("datasets").toArray();
+    for (int i = 0; i < datasets.count(); ++i)
+        group.m_datasets.append(readProjectDataset(datasets.at(i).toObject()));
+
+    return group;
+}
+
+/**
+ * Builds a dataset object directly from its project-file JSON representation.
+ * Writing the members in one go instead of going through the per-property
+ * editor slots avoids copying the whole group & emitting a change signal for
+ * every field, which is what made opening a large project stall the UI.
+ */
+JSON::Dataset JSON::Editor::readProjectDataset(const QJsonObject &object) const
+{
+    Dataset set;
+    set.m_led = object.value("led").toBool();
+    set.m_ledBitmask = object.value("ledBitmask").toBool();
+    set.m_fft = object.value("fft").toBool();
+    set.m_log = object.value("log").toBool();
+    set.m_spectrogram = object.value("spectrogram").toBool();
+    set.m_graph = object.value("graph").toBool();
+    set.m_title = object.value("title").toString();
+    set.m_units = object.value("units").toString();
+    set.m_widget = object.value("widget").toString();
+    set.m_min = object.value("min").toDouble();
+    set.m_max = object.value("max").toDouble();
+    set.m_alarm = object.value("alarm").toDouble();
+    set.m_alarmLow = object.value("alarmLow").toDouble();
+    set.m_alarmRate = object.value("alarmRate").toDouble();
+    set.m_expression = object.value("expression").toString();
+    set.m_fftSamples = qMax(128, object.value("fftSamples").toInt());
+    set.m_plotPoints = qMax(0, object.value("plotPoints").toInt());
+
+    // Read the per-bit LED titles of bitmask datasets, label i names bit i
+    const auto labels = object.value("ledLabels").toArray();
+    for (int i = 0; i < labels.count(); ++i)
+    {
+        const auto title = labels.at(i).toString().trimmed();
+        if (!title.isEmpty())
+            set.m_ledLabels.append(title);
+    }
+
+    // The frame position is stored as the "%index" placeholder string
+    auto index = object.value("value").toString();
+    index.replace("%", "");
+    set.m_index = index.toInt();
+
+    return set;
+}
+
+/**
+ * Serializes the given @a group into its project-file JSON representation,
+ * the datasets are serialized through @c writeProjectDataset().
+ */
+QJsonObject JSON::Editor::writeProjectGroup(const Group &group) const
+{
+    QJsonObject json;
+    json.insert("title", group.title());
+    json.insert("widget", group.widget());
+
+    QJsonArray datasets;
+    for (int i = 0; i < group.m_datasets.count(); ++i)
+        datasets.append(writeProjectDataset(group.m_datasets.at(i)));
+    json.insert("datasets", datasets);
+
+    return json;
+}
+
+/**
+ * Serializes the given @a dataset into its project-file JSON representation,
+ * reading the model members directly instead of round-tripping every value
+ * through the string-based accessors of the editor.
+ */
+QJsonObject JSON::Editor::writeProjectDataset(const Dataset &dataset) const
+{
+    // An alarm level at or below the minimum means "no alarm", it is stored as
+    // the maximum so that re-opening the project yields the same behavior
+    double alarm = dataset.alarm();
+    if (alarm <= dataset.min())
+        alarm = dataset.max();
+
+    QJsonObject json;
+    json.insert("led", dataset.led());
+    json.insert("ledBitmask", dataset.ledBitmask());
+    json.insert("fft", dataset.fft());
+    json.insert("log", dataset.log());
+    json.insert("title", dataset.title());
+    json.insert("units", dataset.units());
+    json.insert("graph", dataset.graph());
+    json.insert("widget", dataset.widget());
+    json.insert("min", dataset.min());
+    json.insert("max", dataset.max());
+    json.insert("alarm", alarm);
+    json.insert("alarmLow", dataset.alarmLow());
+    json.insert("alarmRate", dataset.alarmRate());
+    json.insert("expression", dataset.expression());
+    json.insert("fftSamples", dataset.fftSamples());
+    json.insert("plotPoints", dataset.plotPoints());
+    json.insert("spectrogram", dataset.spectrogram());
+    json.insert("value", "%" + QString::number(dataset.m_index));
+    json.insert("ledLabels", QJsonArray::fromStringList(dataset.ledLabels()));
+
+    return json;
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
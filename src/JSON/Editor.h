@@ -23,12 +23,40 @@
 #pragma once
 
 #include <QObject>
+#include <QThread>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <DataTypes.h>
 #include <JSON/Group.h>
 #include <JSON/Dataset.h>
 
 namespace JSON
 {
+/**
+ * @brief The EditorLoader class
+ *
+ * Worker object that reads & parses a JSON project file from a dedicated
+ * thread, so that opening a large project does not block the user interface
+ * while the document is read from disk & validated. The parsed document is
+ * sent back to the editor through a queued signal (an empty object signals a
+ * read or parse failure).
+ */
+class EditorLoader : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void documentLoaded(const QString &path, const QJsonObject &document);
+
+public:
+    explicit EditorLoader(QObject *parent = Q_NULLPTR);
+
+public Q_SLOTS:
+    void loadDocument(const QString &path);
+};
+
 /**
  * @brief The Editor class
  *
@@ -37,6 +65,12 @@ namespace JSON
  *
  * Additionaly, the class facilitates the modificiation of a project
  * file or the creation of new JSON project files.
+ *
+ * Project files are parsed on a worker thread (see @c EditorLoader) & the
+ * group/dataset model is populated progressively in small batches, so opening
+ * a project with hundreds of datasets never stalls the UI. Saves serialize
+ * the model directly & re-use the cached JSON of the groups that have not
+ * been edited since the last save.
  */
 class Editor : public QObject
 {
@@ -64,6 +98,10 @@ class Editor : public QObject
                READ frameStartSequence
                WRITE setFrameStartSequence
                NOTIFY frameStartSequenceChanged)
+    Q_PROPERTY(bool fp32Storage
+               READ fp32Storage
+               WRITE setFp32Storage
+               NOTIFY fp32StorageChanged)
     Q_PROPERTY(QString jsonFilePath
                READ jsonFilePath
                NOTIFY jsonFileChanged)
@@ -79,6 +117,7 @@ Q_SIGNALS:
     void separatorChanged();
     void groupCountChanged();
     void groupOrderChanged();
+    void fp32StorageChanged();
     void frameEndSequenceChanged();
     void frameStartSequenceChanged();
     void groupChanged(const int group);
@@ -91,6 +130,8 @@ private:
     Editor &operator=(Editor &&) = delete;
     Editor &operator=(const Editor &) = delete;
 
+    ~Editor();
+
 public:
     static Editor &instance();
 
@@ -105,6 +146,7 @@ public:
     QString frameStartSequence() const;
 
     bool modified() const;
+    bool fp32Storage() const;
     int groupCount() const;
     QString jsonFilePath() const;
     QString jsonFileName() const;
@@ -116,14 +158,20 @@ public:
     Q_INVOKABLE const Group &getGroup(const int index) const;
     Q_INVOKABLE const JSON::Dataset &getDataset(const int group, const int index) const;
 
+    const Dataset *findDataset(const int frameIndex) const;
+    QVector<const Dataset *> uniqueDatasets() const;
+
     Q_INVOKABLE QString groupTitle(const int group) const;
     Q_INVOKABLE QString groupWidget(const int group) const;
     Q_INVOKABLE int groupWidgetIndex(const int group) const;
     Q_INVOKABLE int datasetIndex(const int group, const int dataset) const;
     Q_INVOKABLE bool datasetLED(const int group, const int dataset) const;
+    Q_INVOKABLE bool datasetLedBitmask(const int group, const int dataset) const;
+    Q_INVOKABLE QString datasetLedLabels(const int group, const int dataset) const;
     Q_INVOKABLE bool datasetGraph(const int group, const int dataset) const;
     Q_INVOKABLE bool datasetFftPlot(const int group, const int dataset) const;
     Q_INVOKABLE bool datasetLogPlot(const int group, const int dataset) const;
+    Q_INVOKABLE bool datasetSpectrogram(const int group, const int dataset) const;
     Q_INVOKABLE QString datasetTitle(const int group, const int dataset) const;
     Q_INVOKABLE QString datasetUnits(const int group, const int dataset) const;
     Q_INVOKABLE QString datasetWidget(const int group, const int dataset) const;
@@ -131,7 +179,11 @@ public:
     Q_INVOKABLE QString datasetWidgetMin(const int group, const int dataset) const;
     Q_INVOKABLE QString datasetWidgetMax(const int group, const int dataset) const;
     Q_INVOKABLE QString datasetFFTSamples(const int group, const int dataset) const;
+    Q_INVOKABLE QString datasetPlotPoints(const int group, const int dataset) const;
     Q_INVOKABLE QString datasetWidgetAlarm(const int group, const int dataset) const;
+    Q_INVOKABLE QString datasetAlarmLow(const int group, const int dataset) const;
+    Q_INVOKABLE QString datasetAlarmRate(const int group, const int dataset) const;
+    Q_INVOKABLE QString datasetExpression(const int group, const int dataset) const;
 
     Q_INVOKABLE bool setGroupWidget(const int group, const int widgetId);
 
@@ -142,6 +194,7 @@ public Q_SLOTS:
 
     void setTitle(const QString &title);
     void setSeparator(const QString &separator);
+    void setFp32Storage(const bool enabled);
     void setFrameEndSequence(const QString &sequence);
     void setFrameStartSequence(const QString &sequence);
 
@@ -159,24 +212,40 @@ public Q_SLOTS:
     void setDatasetUnits(const int group, const int dataset, const QString &units);
     void setDatasetIndex(const int group, const int dataset, const int frameIndex);
     void setDatasetLED(const int group, const int dataset, const bool generateLED);
+    void setDatasetLedBitmask(const int group, const int dataset, const bool bitmask);
+    void setDatasetLedLabels(const int group, const int dataset, const QString &labels);
     void setDatasetGraph(const int group, const int dataset, const bool generateGraph);
     void setDatasetFftPlot(const int group, const int dataset, const bool generateFft);
     void setDatasetLogPlot(const int group, const int dataset, const bool generateLog);
+    void setDatasetSpectrogram(const int group, const int dataset,
+                               const bool generateSpectrogram);
     void setDatasetWidgetMin(const int group, const int dataset, const QString &minimum);
     void setDatasetWidgetMax(const int group, const int dataset, const QString &maximum);
     void setDatasetWidgetData(const int group, const int dataset, const QString &widget);
     void setDatasetWidgetAlarm(const int group, const int dataset, const QString &alarm);
+    void setDatasetAlarmLow(const int group, const int dataset, const QString &alarm);
+    void setDatasetAlarmRate(const int group, const int dataset, const QString &rate);
+    void setDatasetExpression(const int group, const int dataset,
+                              const QString &expression);
     void setDatasetFFTSamples(const int group, const int dataset, const QString &samples);
+    void setDatasetPlotPoints(const int group, const int dataset, const QString &points);
 
 private Q_SLOTS:
     void onJsonLoaded();
     void onModelChanged();
+    void populatePendingGroups();
     void onGroupChanged(const int group);
     void setModified(const bool modified);
     void onDatasetChanged(const int group, const int dataset);
+    void onDocumentLoaded(const QString &path, const QJsonObject &document);
 
 private:
     int nextDatasetIndex();
+    void rebuildDatasetIndex() const;
+    Group readProjectGroup(const QJsonObject &object) const;
+    Dataset readProjectDataset(const QJsonObject &object) const;
+    QJsonObject writeProjectGroup(const Group &group) const;
+    QJsonObject writeProjectDataset(const Dataset &dataset) const;
 
 private:
     QString m_title;
@@ -185,8 +254,28 @@ private:
     QString m_frameStartSequence;
 
     bool m_modified;
+    bool m_fp32Storage;
     QString m_filePath;
 
     QVector<Group> m_groups;
+
+    // Groups of a project load that have not been appended to the model yet,
+    // populatePendingGroups() drains this array in small batches
+    int m_pendingIndex;
+    QJsonArray m_pendingGroups;
+
+    // Serialized JSON of every group, entries are invalidated when the group
+    // is edited so that a save only re-serializes what actually changed
+    QVector<QJsonObject> m_groupJsonCache;
+
+    QThread m_loaderThread;
+    EditorLoader *m_loader;
+
+    // Hash index over the project model (frame index -> dataset position),
+    // rebuilt lazily after the model changes so that lookups by frame index
+    // do not scan every group & dataset
+    mutable bool m_indexDirty;
+    mutable QVector<int> m_indexOrder;
+    mutable QHash<int, QPair<int, int>> m_datasetIndex;
 };
 }
@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Expressions.h"
+
+#include <QtMath>
+
+#include <JSON/Group.h>
+#include <JSON/Dataset.h>
+
+/**
+ * Maximum depth of the evaluation stack, programs that would exceed it are
+ * rejected at compile time
+ */
+static const int kMaxStackDepth = 32;
+
+/**
+ * Instruction opcodes of the compiled programs
+ */
+enum Opcode
+{
+    OpPushConstant,
+    OpPushChannel,
+    OpAdd,
+    OpSubtract,
+    OpMultiply,
+    OpDivide,
+    OpPower,
+    OpNegate,
+    OpAbs,
+    OpSqrt,
+    OpSin,
+    OpCos,
+    OpTan,
+    OpLog,
+    OpExp,
+    OpFloor,
+    OpCeil,
+    OpRound
+};
+
+/**
+ * Returns the opcode of the single-argument function with the given @a name,
+ * or @c -1 when the name is unknown
+ */
+static int FunctionOpcode(const QString &name)
+{
+    if (name == "abs")
+        return OpAbs;
+    if (name == "sqrt")
+        return OpSqrt;
+    if (name == "sin")
+        return OpSin;
+    if (name == "cos")
+        return OpCos;
+    if (name == "tan")
+        return OpTan;
+    if (name == "log")
+        return OpLog;
+    if (name == "exp")
+        return OpExp;
+    if (name == "floor")
+        return OpFloor;
+    if (name == "ceil")
+        return OpCeil;
+    if (name == "round")
+        return OpRound;
+
+    return -1;
+}
+
+/**
+ * Returns the precedence of the given binary/unary @a opcode, higher values
+ * bind tighter
+ */
+static int Precedence(const int opcode)
+{
+    switch (opcode)
+    {
+        case OpPower:
+            return 4;
+        case OpNegate:
+            return 3;
+        case OpMultiply:
+        case OpDivide:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * Returns @c true if the given @a opcode is right-associative
+ */
+static bool RightAssociative(const int opcode)
+{
+    return opcode == OpPower || opcode == OpNegate;
+}
+
+/**
+ * Constructor function
+ */
+JSON::Expressions::Expressions()
+{
+}
+
+/**
+ * Returns the only instance of the class
+ */
+JSON::Expressions &JSON::Expressions::instance()
+{
+    static Expressions singleton;
+    return singleton;
+}
+
+/**
+ * Computes the value of every derived dataset of the given @a frame. Called
+ * by the frame generator before the changed-dataset flags are computed, so
+ * that derived channels participate in the change detection & downstream
+ * consumers (widgets, plots, history, alarms, CSV export) treat them exactly
+ * like regular channels.
+ */
+void JSON::Expressions::apply(Frame &frame)
+{
+    // Check if the frame contains derived datasets & obtain the largest
+    // frame index, most projects have none & shall only pay for this scan
+    int maxIndex = 0;
+    bool hasExpressions = false;
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.m_groups.at(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const auto &dataset = group.m_datasets.at(d);
+            maxIndex = qMax(maxIndex, dataset.m_index);
+            hasExpressions |= !dataset.m_expression.isEmpty();
+        }
+    }
+
+    // Stop if every dataset reads its value directly from the device
+    if (!hasExpressions)
+        return;
+
+    // Build the channel table indexed by frame index, the buffer is a member
+    // so that its allocation is amortized across frames
+    m_channelValues.resize(maxIndex + 1);
+    m_channelValues.fill(0);
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.m_groups.at(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const auto &dataset = group.m_datasets.at(d);
+            if (dataset.m_index >= 1)
+                m_channelValues[dataset.m_index] = dataset.numericValue();
+        }
+    }
+
+    // Evaluate the derived datasets in frame order & register the results in
+    // the channel table, so that expressions can build on earlier derived
+    // channels
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        auto &group = frame.m_groups[g];
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            auto &dataset = group.m_datasets[d];
+            if (dataset.m_expression.isEmpty())
+                continue;
+
+            const auto &program = programFor(dataset.m_expression);
+            if (!program.valid)
+                continue;
+
+            const double value = evaluate(program);
+            dataset.m_value = QString::number(value);
+            dataset.m_numericValue = value;
+            dataset.m_numericValid = true;
+            if (dataset.m_index >= 1)
+                m_channelValues[dataset.m_index] = value;
+        }
+    }
+}
+
+/**
+ * Returns the compiled program of the given @a expression, compiling it on
+ * first sight & reusing the cached program afterwards
+ */
+const JSON::Expressions::Program &
+JSON::Expressions::programFor(const QString &expression)
+{
+    auto it = m_programs.find(expression);
+    if (it != m_programs.end())
+        return it.value();
+
+    // Compile the expression into postfix form with the shunting-yard
+    // algorithm, operators wait on a stack until an operator with lower
+    // precedence (or the end of the expression) flushes them
+    Program program;
+    program.valid = true;
+    QVector<int> operators;
+    bool expectOperand = true;
+    const QString source = expression.trimmed();
+    int pos = 0;
+    while (pos < source.length() && program.valid)
+    {
+        const QChar c = source.at(pos);
+
+        // Skip whitespace
+        if (c.isSpace())
+        {
+            ++pos;
+            continue;
+        }
+
+        // Numeric literal
+        if (c.isDigit() || c == '.')
+        {
+            int end = pos;
+            while (end < source.length()
+                   && (source.at(end).isDigit() || source.at(end) == '.'))
+                ++end;
+
+            bool ok = false;
+            const double value = source.mid(pos, end - pos).toDouble(&ok);
+            program.valid = ok && expectOperand;
+            program.code.append({OpPushConstant, value, 0});
+            expectOperand = false;
+            pos = end;
+        }
+
+        // Channel reference or function name
+        else if (c.isLetter())
+        {
+            int end = pos;
+            while (end < source.length() && source.at(end).isLetterOrNumber())
+                ++end;
+
+            const QString name = source.mid(pos, end - pos);
+            pos = end;
+
+            // Channel reference ("v" followed by the frame index)
+            bool isChannel = false;
+            if (name.length() > 1 && name.at(0) == 'v')
+            {
+                const int channel = name.mid(1).toInt(&isChannel);
+                if (isChannel)
+                {
+                    program.valid = expectOperand && channel >= 1;
+                    program.code.append({OpPushChannel, 0, channel});
+                    expectOperand = false;
+                }
+            }
+
+            // Function name, the opening parenthesis handles the grouping
+            if (!isChannel)
+            {
+                const int opcode = FunctionOpcode(name);
+                program.valid = expectOperand && opcode >= 0
+                                && pos < source.length()
+                                && source.at(pos) == '(';
+                operators.append(opcode);
+            }
+        }
+
+        // Parentheses
+        else if (c == '(')
+        {
+            program.valid = expectOperand;
+            operators.append(-1);
+            ++pos;
+        }
+
+        else if (c == ')')
+        {
+            program.valid = !expectOperand;
+            while (!operators.isEmpty() && operators.last() != -1)
+                program.code.append({operators.takeLast(), 0, 0});
+            if (operators.isEmpty())
+                program.valid = false;
+            else
+            {
+                // Pop the "(" sentinel & the function that owns it (if any),
+                // the argument of the function is complete at this point
+                operators.removeLast();
+                if (!operators.isEmpty() && operators.last() >= OpAbs)
+                    program.code.append({operators.takeLast(), 0, 0});
+            }
+            ++pos;
+        }
+
+        // Binary operators & unary minus
+        else
+        {
+            int opcode = -1;
+            if (c == '+')
+                opcode = OpAdd;
+            else if (c == '-')
+                opcode = expectOperand ? OpNegate : OpSubtract;
+            else if (c == '*')
+                opcode = OpMultiply;
+            else if (c == '/')
+                opcode = OpDivide;
+            else if (c == '^')
+                opcode = OpPower;
+            else
+                program.valid = false;
+
+            if (program.valid)
+            {
+                program.valid = expectOperand == (opcode == OpNegate);
+                while (!operators.isEmpty() && operators.last() != -1
+                       && (Precedence(operators.last()) > Precedence(opcode)
+                           || (Precedence(operators.last()) == Precedence(opcode)
+                               && !RightAssociative(opcode))))
+                    program.code.append({operators.takeLast(), 0, 0});
+
+                operators.append(opcode);
+                expectOperand = true;
+            }
+
+            ++pos;
+        }
+    }
+
+    // Flush the pending operators, unbalanced parentheses are rejected
+    program.valid &= !expectOperand;
+    while (program.valid && !operators.isEmpty())
+    {
+        if (operators.last() == -1)
+            program.valid = false;
+        else
+            program.code.append({operators.takeLast(), 0, 0});
+    }
+
+    // Simulate the evaluation to verify that the program leaves exactly one
+    // value on a stack that never overflows
+    int depth = 0;
+    for (int i = 0; program.valid && i < program.code.count(); ++i)
+    {
+        const int opcode = program.code.at(i).opcode;
+        if (opcode == OpPushConstant || opcode == OpPushChannel)
+            ++depth;
+        else if (opcode >= OpAdd && opcode <= OpPower)
+            --depth;
+
+        program.valid = depth >= 1 && depth <= kMaxStackDepth;
+    }
+    program.valid &= depth == 1;
+
+    // Invalid programs are cached too, so that a typo in the project file
+    // does not re-run the compiler on every frame
+    if (!program.valid)
+        program.code.clear();
+
+    return m_programs.insert(expression, program).value();
+}
+
+/**
+ * Runs the given compiled @a program over the current channel table &
+ * returns the value that it leaves on the stack
+ */
+double JSON::Expressions::evaluate(const Program &program) const
+{
+    int depth = 0;
+    double stack[kMaxStackDepth];
+    for (int i = 0; i < program.code.count(); ++i)
+    {
+        const auto &instruction = program.code.at(i);
+        switch (instruction.opcode)
+        {
+            case OpPushConstant:
+                stack[depth++] = instruction.value;
+                break;
+            case OpPushChannel:
+                stack[depth++] = instruction.channel < m_channelValues.count()
+                                     ? m_channelValues.at(instruction.channel)
+                                     : 0;
+                break;
+            case OpAdd:
+                --depth;
+                stack[depth - 1] += stack[depth];
+                break;
+            case OpSubtract:
+                --depth;
+                stack[depth - 1] -= stack[depth];
+                break;
+            case OpMultiply:
+                --depth;
+                stack[depth - 1] *= stack[depth];
+                break;
+            case OpDivide:
+                --depth;
+                stack[depth - 1] /= stack[depth];
+                break;
+            case OpPower:
+                --depth;
+                stack[depth - 1] = qPow(stack[depth - 1], stack[depth]);
+                break;
+            case OpNegate:
+                stack[depth - 1] = -stack[depth - 1];
+                break;
+            case OpAbs:
+                stack[depth - 1] = qFabs(stack[depth - 1]);
+                break;
+            case OpSqrt:
+                stack[depth - 1] = qSqrt(stack[depth - 1]);
+                break;
+            case OpSin:
+                stack[depth - 1] = qSin(stack[depth - 1]);
+                break;
+            case OpCos:
+                stack[depth - 1] = qCos(stack[depth - 1]);
+                break;
+            case OpTan:
+                stack[depth - 1] = qTan(stack[depth - 1]);
+                break;
+            case OpLog:
+                stack[depth - 1] = qLn(stack[depth - 1]);
+                break;
+            case OpExp:
+                stack[depth - 1] = qExp(stack[depth - 1]);
+                break;
+            case OpFloor:
+                stack[depth - 1] = qFloor(stack[depth - 1]);
+                break;
+            case OpCeil:
+                stack[depth - 1] = qCeil(stack[depth - 1]);
+                break;
+            case OpRound:
+                stack[depth - 1] = qRound(stack[depth - 1]);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return stack[0];
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <JSON/Frame.h>
+
+namespace JSON
+{
+/**
+ * @brief The Expressions class
+ *
+ * Compiled expression engine for derived datasets. Datasets with a non-empty
+ * "expression" attribute in the project file do not read their value from the
+ * device, instead it is computed per frame from the values of the other
+ * datasets, e.g. @c "v1 * v2" for electrical power from voltage & current.
+ *
+ * Expression syntax:
+ * - @c vN refers to the numeric value of the dataset with frame index @c N.
+ * - Operators @c + @c - @c * @c / @c ^ with the usual precedence, unary minus
+ *   & parentheses.
+ * - Single-argument functions @c abs, @c sqrt, @c sin, @c cos, @c tan,
+ *   @c log (natural), @c exp, @c floor, @c ceil & @c round.
+ *
+ * Expressions are compiled once into a postfix instruction vector (a
+ * QJSEngine evaluation per frame would cost more than the whole parse
+ * pipeline) & cached by source text, so the per-frame cost of a derived
+ * channel is a short interpreter loop over a handful of instructions.
+ * Invalid expressions compile into an empty program & leave the dataset
+ * value untouched.
+ *
+ * Derived datasets are evaluated in frame order & may reference earlier
+ * derived channels, e.g. an energy estimate built on top of the computed
+ * power channel.
+ */
+class Expressions
+{
+public:
+    static Expressions &instance();
+
+    void apply(Frame &frame);
+
+private:
+    explicit Expressions();
+    Expressions(Expressions &&) = delete;
+    Expressions(const Expressions &) = delete;
+    Expressions &operator=(Expressions &&) = delete;
+    Expressions &operator=(const Expressions &) = delete;
+
+private:
+    /**
+     * One postfix instruction of a compiled expression, @c value holds the
+     * literal of @c PushConstant instructions & @c channel holds the frame
+     * index of @c PushChannel instructions.
+     */
+    struct Instruction
+    {
+        int opcode;
+        double value;
+        int channel;
+    };
+
+    /**
+     * Compiled form of one expression, @c valid is @c false when the source
+     * text could not be parsed & the program shall not be evaluated.
+     */
+    struct Program
+    {
+        bool valid;
+        QVector<Instruction> code;
+    };
+
+private:
+    const Program &programFor(const QString &expression);
+    double evaluate(const Program &program) const;
+
+private:
+    QVector<double> m_channelValues;
+    QHash<QString, Program> m_programs;
+};
+}
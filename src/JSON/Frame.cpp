@@ -21,6 +21,15 @@
  */
 
 #include <JSON/Frame.h>
+#include <JSON/StringPool.h>
+
+/**
+ * Constructor function, projects store plot samples as 64-bit doubles by default.
+ */
+JSON::Frame::Frame()
+    : m_fp32Storage(false)
+{
+}
 
 /**
  * Destructor function, free memory used by the @c Group objects before destroying an
@@ -38,6 +47,7 @@ JSON::Frame::~Frame()
 void JSON::Frame::clear()
 {
     m_title = "";
+    m_fp32Storage = false;
     m_groups.clear();
 }
 
@@ -49,6 +59,16 @@ QString JSON::Frame::title() const
     return m_title;
 }
 
+/**
+ * Returns @c true if the project asks for its plot & history buffers to store samples
+ * as 32-bit floats instead of doubles. Halves the memory footprint & bandwidth of
+ * large dashboards at the cost of ~7 significant digits of precision.
+ */
+bool JSON::Frame::fp32Storage() const
+{
+    return m_fp32Storage;
+}
+
 /**
  * Returns the number of groups contained in the frame.
  */
@@ -83,8 +103,9 @@ bool JSON::Frame::read(const QJsonObject &object)
     // We need to have a project title and at least one group
     if (!title.isEmpty() && !groups.isEmpty())
     {
-        // Update title
-        m_title = title;
+        // Update title & storage precision flag
+        m_title = StringPool::intern(title);
+        m_fp32Storage = object.value("fp32").toBool();
 
         // Generate groups & datasets from data frame
         for (auto i = 0; i < groups.count(); ++i)
@@ -54,10 +54,12 @@ namespace JSON
 class Frame
 {
 public:
+    Frame();
     ~Frame();
 
     void clear();
     QString title() const;
+    bool fp32Storage() const;
     int groupCount() const;
     QVector<Group> &groups();
     bool read(const QJsonObject &object);
@@ -67,6 +69,11 @@ public:
 
 private:
     QString m_title;
+    bool m_fp32Storage;
     QVector<Group> m_groups;
+
+    friend class Generator;
+    friend class FrameParser;
+    friend class Expressions;
 };
 }
@@ -0,0 +1,938 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <JSON/FrameParser.h>
+#include <JSON/StringPool.h>
+
+/**
+ * Constructor function
+ */
+JSON::FrameParser::FrameParser()
+{
+    unlockSchema();
+}
+
+/**
+ * Parses the JSON document contained in @a data directly into the given
+ * @a frame, re-using the group & dataset slots of previous parses. The frame
+ * is cleared when the document is malformed or does not describe a valid
+ * frame (i.e. a non-empty title & at least one group).
+ *
+ * When the schema of the document is locked & the target frame is known to
+ * hold the static fields of that schema, the value-only fast path is tried
+ * first; a full (recording) parse only runs when the document layout changed.
+ *
+ * @return @c true on success, @c false on failure
+ */
+bool JSON::FrameParser::parse(const QByteArray &data, Frame &frame)
+{
+    // Schema-locked fast path
+    if (m_schemaValid && (&frame == m_syncedFrames[0] || &frame == m_syncedFrames[1]))
+    {
+        if (parseLocked(data, frame))
+            return frame.isValid();
+    }
+
+    // Reset the skeleton recording state
+    m_lastValueEnd = 0;
+    m_recordGroup = -1;
+    m_recordDataset = -1;
+    m_recordBroken = false;
+    m_recordSlots.clear();
+    m_docStart = data.constData();
+
+    // Full document parse
+    m_pos = m_docStart;
+    m_end = m_pos + data.size();
+    skipWhitespace();
+    if (!parseFrame(frame))
+    {
+        frame.clear();
+        unlockSchema();
+        return false;
+    }
+
+    // Reject documents with trailing garbage, like QJsonDocument does
+    skipWhitespace();
+    if (m_pos != m_end)
+    {
+        frame.clear();
+        unlockSchema();
+        return false;
+    }
+
+    // Lock onto the document schema. When the recorded skeleton matches the
+    // already-locked schema the frame is simply registered as synced, so the
+    // fast path engages once both frames of the generator pool have seen the
+    // same layout. Documents with rejected groups/datasets are not locked,
+    // their slot indices would not match the generated frame.
+    if (!m_recordBroken && frame.isValid())
+    {
+        if (m_schemaValid && sameSchema(data))
+        {
+            if (m_syncedFrames[0] != &frame && m_syncedFrames[1] != &frame)
+                m_syncedFrames[1] = &frame;
+        }
+
+        else
+        {
+            m_schemaValid = true;
+            m_schemaDoc = data;
+            m_schemaSlots = m_recordSlots;
+            m_schemaTailStart = m_lastValueEnd;
+            m_syncedFrames[0] = &frame;
+            m_syncedFrames[1] = Q_NULLPTR;
+        }
+    }
+
+    else
+        unlockSchema();
+
+    return frame.isValid();
+}
+
+/**
+ * Forgets the locked document schema, shall be called whenever the frames fed
+ * to @c parse() may no longer hold the static fields recorded by previous
+ * parses (e.g. when the operation mode changes or the frame pool is reset).
+ */
+void JSON::FrameParser::unlockSchema()
+{
+    m_schemaValid = false;
+    m_schemaTailStart = 0;
+    m_schemaDoc.clear();
+    m_schemaSlots.clear();
+    m_syncedFrames[0] = Q_NULLPTR;
+    m_syncedFrames[1] = Q_NULLPTR;
+}
+
+/**
+ * Value-only parser for schema-locked documents. Verifies that the static
+ * byte spans of the document are identical to the locked schema & extracts
+ * the value tokens directly into the slot fields of the given @a frame.
+ *
+ * @return @c false when the document does not match the locked schema, the
+ *         caller shall fall back to a full parse in that case
+ */
+bool JSON::FrameParser::parseLocked(const QByteArray &data, Frame &frame)
+{
+    const char *doc = data.constData();
+    const char *schema = m_schemaDoc.constData();
+    const int size = data.size();
+
+    int pos = 0;
+    for (int i = 0; i < m_schemaSlots.count(); ++i)
+    {
+        const auto &slot = m_schemaSlots.at(i);
+
+        // Verify the static span that precedes the value token
+        if (pos + slot.staticLength > size)
+            return false;
+        if (memcmp(doc + pos, schema + slot.staticStart, slot.staticLength) != 0)
+            return false;
+        pos += slot.staticLength;
+
+        // Validate the slot target
+        if (slot.group >= frame.m_groups.count())
+            return false;
+        auto *group = (slot.group >= 0) ? &frame.m_groups[slot.group] : Q_NULLPTR;
+        if (group && slot.dataset >= group->m_datasets.count())
+            return false;
+        auto *dataset
+            = (group && slot.dataset >= 0) ? &group->m_datasets[slot.dataset] : Q_NULLPTR;
+
+        // Tokenize the value, the type may differ from the one recorded by
+        // the full parse (e.g. a number where a string used to be), coercion
+        // below handles that exactly like the full parse would
+        m_pos = doc + pos;
+        m_end = doc + size;
+        if (m_pos >= m_end)
+            return false;
+
+        QString string;
+        double number = 0;
+        bool boolean = false;
+        bool isString = false;
+        bool isNumber = false;
+        bool isBoolean = false;
+        if (*m_pos == '"')
+        {
+            isString = true;
+            if (!parseString(string))
+                return false;
+        }
+        else if (*m_pos == 't' || *m_pos == 'f')
+        {
+            isBoolean = true;
+            boolean = (*m_pos == 't');
+            if (!parseLiteral(boolean ? "true" : "false"))
+                return false;
+        }
+        else if (*m_pos == 'n')
+        {
+            if (!parseLiteral("null"))
+                return false;
+        }
+        else
+        {
+            isNumber = true;
+            if (!parseNumber(number))
+                return false;
+        }
+
+        pos = int(m_pos - doc);
+
+        // Write the value into the slot field
+        switch (slot.field)
+        {
+            case FrameTitle:
+                frame.m_title = isString ? StringPool::intern(string) : QString();
+                break;
+            case GroupTitle:
+                group->m_title = isString ? StringPool::intern(string) : QString();
+                break;
+            case GroupWidget:
+                group->m_widget = isString ? StringPool::intern(string) : QString();
+                break;
+            case DatasetTitle:
+                dataset->m_title = isString ? StringPool::intern(string) : QString();
+                break;
+            case DatasetValue:
+                dataset->m_value = isString ? string : QString();
+                if (dataset->m_value.isEmpty())
+                    dataset->m_value = "--.--";
+                dataset->m_numericValid = false;
+                break;
+            case DatasetUnits:
+                dataset->m_units = isString ? StringPool::intern(string) : QString();
+                break;
+            case DatasetWidget:
+                dataset->m_widget = isString ? StringPool::intern(string) : QString();
+                break;
+            case DatasetFft:
+                dataset->m_fft = isBoolean && boolean;
+                break;
+            case DatasetLed:
+                dataset->m_led = isBoolean && boolean;
+                break;
+            case DatasetLog:
+                dataset->m_log = isBoolean && boolean;
+                break;
+            case DatasetGraph:
+                dataset->m_graph = isBoolean && boolean;
+                break;
+            case DatasetMin:
+                dataset->m_min = isNumber ? number : 0;
+                break;
+            case DatasetMax:
+                dataset->m_max = isNumber ? number : 0;
+                break;
+            case DatasetAlarm:
+                dataset->m_alarm = isNumber ? number : 0;
+                break;
+            case DatasetIndex:
+                dataset->m_index = isNumber ? int(number) : 0;
+                break;
+            case DatasetFftSamples:
+                dataset->m_fftSamples = isNumber ? int(number) : 0;
+                break;
+            case DatasetPlotPoints:
+                dataset->m_plotPoints = isNumber ? int(number) : 0;
+                break;
+            case DatasetSpectrogram:
+                dataset->m_spectrogram = isBoolean && boolean;
+                break;
+            case DatasetAlarmLow:
+                dataset->m_alarmLow = isNumber ? number : 0;
+                break;
+            case DatasetAlarmRate:
+                dataset->m_alarmRate = isNumber ? number : 0;
+                break;
+            case DatasetExpression:
+                dataset->m_expression = isString ? StringPool::intern(string) : QString();
+                break;
+            default:
+                break;
+        }
+
+        // An empty frame title would break the schema-locked validity
+        if (slot.field == FrameTitle && frame.m_title.isEmpty())
+            return false;
+    }
+
+    // Verify the static tail of the document
+    const int tailLength = m_schemaDoc.size() - m_schemaTailStart;
+    if (pos + tailLength != size)
+        return false;
+
+    return memcmp(doc + pos, schema + m_schemaTailStart, tailLength) == 0;
+}
+
+/**
+ * Returns @c true if the skeleton recorded by the current full parse of
+ * @a data is identical to the locked schema.
+ */
+bool JSON::FrameParser::sameSchema(const QByteArray &data) const
+{
+    if (m_recordSlots.count() != m_schemaSlots.count())
+        return false;
+
+    const char *doc = data.constData();
+    const char *schema = m_schemaDoc.constData();
+    for (int i = 0; i < m_recordSlots.count(); ++i)
+    {
+        const auto &a = m_recordSlots.at(i);
+        const auto &b = m_schemaSlots.at(i);
+        if (a.group != b.group || a.dataset != b.dataset || a.field != b.field
+            || a.staticLength != b.staticLength)
+            return false;
+        if (memcmp(doc + a.staticStart, schema + b.staticStart, a.staticLength) != 0)
+            return false;
+    }
+
+    // Compare the static tails
+    const int tailLength = data.size() - m_lastValueEnd;
+    if (tailLength != m_schemaDoc.size() - m_schemaTailStart)
+        return false;
+
+    return memcmp(doc + m_lastValueEnd, schema + m_schemaTailStart, tailLength) == 0;
+}
+
+/**
+ * Records a value token of the current full parse into the skeleton. The
+ * static span of the slot covers everything between the end of the previous
+ * value token & the given @a tokenStart, shall be called right after the
+ * token has been consumed.
+ */
+void JSON::FrameParser::recordValue(const int field, const char *tokenStart)
+{
+    SchemaSlot slot;
+    slot.group = m_recordGroup;
+    slot.dataset = m_recordDataset;
+    slot.field = field;
+    slot.staticStart = m_lastValueEnd;
+    slot.staticLength = int(tokenStart - m_docStart) - m_lastValueEnd;
+    m_recordSlots.append(slot);
+    m_lastValueEnd = int(m_pos - m_docStart);
+}
+
+/**
+ * Parses the root object of the document into the given @a frame. Invalid
+ * groups are skipped without aborting the parse, mirroring the behavior of
+ * @c Frame::read().
+ */
+bool JSON::FrameParser::parseFrame(Frame &frame)
+{
+    frame.m_title.clear();
+    int groupCount = 0;
+
+    if (!match('{'))
+        return false;
+
+    skipWhitespace();
+    if (!match('}'))
+    {
+        do
+        {
+            // Read the member key
+            QString key;
+            skipWhitespace();
+            if (!parseString(key))
+                return false;
+
+            // Key/value separator
+            skipWhitespace();
+            if (!match(':'))
+                return false;
+
+            // Frame title
+            skipWhitespace();
+            if (key == "title" && *m_pos == '"')
+            {
+                const char *tokenStart = m_pos;
+                if (!parseString(frame.m_title))
+                    return false;
+
+                frame.m_title = StringPool::intern(frame.m_title);
+                recordValue(FrameTitle, tokenStart);
+            }
+
+            // Group array, re-use the slots of the previous parse
+            else if (key == "groups" && *m_pos == '[')
+            {
+                ++m_pos;
+                skipWhitespace();
+                if (!match(']'))
+                {
+                    do
+                    {
+                        skipWhitespace();
+                        if (groupCount >= frame.m_groups.count())
+                            frame.m_groups.append(Group());
+                        m_recordGroup = groupCount;
+                        if (!parseGroup(frame.m_groups[groupCount]))
+                            return false;
+                        if (frame.m_groups[groupCount].datasetCount() > 0
+                            && !frame.m_groups[groupCount].title().isEmpty())
+                            ++groupCount;
+                        else
+                            m_recordBroken = true;
+
+                        skipWhitespace();
+                    } while (match(','));
+                    if (!match(']'))
+                        return false;
+                }
+
+                m_recordGroup = -1;
+            }
+
+            // Unknown key, skip its value
+            else if (!skipValue())
+                return false;
+
+            skipWhitespace();
+        } while (match(','));
+
+        if (!match('}'))
+            return false;
+    }
+
+    // Trim the slots that this parse did not use
+    frame.m_groups.resize(groupCount);
+    return true;
+}
+
+/**
+ * Parses a group object into the given @a group, re-using the dataset slots
+ * of the previous parse. Invalid datasets are skipped, mirroring the behavior
+ * of @c Group::read().
+ */
+bool JSON::FrameParser::parseGroup(Group &group)
+{
+    group.m_title.clear();
+    group.m_widget.clear();
+    int datasetCount = 0;
+
+    if (!match('{'))
+        return false;
+
+    skipWhitespace();
+    if (!match('}'))
+    {
+        do
+        {
+            // Read the member key
+            QString key;
+            skipWhitespace();
+            if (!parseString(key))
+                return false;
+
+            // Key/value separator
+            skipWhitespace();
+            if (!match(':'))
+                return false;
+
+            // String members
+            skipWhitespace();
+            if (key == "title" && *m_pos == '"')
+            {
+                const char *tokenStart = m_pos;
+                if (!parseString(group.m_title))
+                    return false;
+
+                group.m_title = StringPool::intern(group.m_title);
+                recordValue(GroupTitle, tokenStart);
+            }
+
+            else if (key == "widget" && *m_pos == '"')
+            {
+                const char *tokenStart = m_pos;
+                if (!parseString(group.m_widget))
+                    return false;
+
+                group.m_widget = StringPool::intern(group.m_widget);
+                recordValue(GroupWidget, tokenStart);
+            }
+
+            // Dataset array, re-use the slots of the previous parse
+            else if (key == "datasets" && *m_pos == '[')
+            {
+                ++m_pos;
+                skipWhitespace();
+                if (!match(']'))
+                {
+                    do
+                    {
+                        bool valid = false;
+                        skipWhitespace();
+                        if (datasetCount >= group.m_datasets.count())
+                            group.m_datasets.append(Dataset());
+                        m_recordDataset = datasetCount;
+                        if (!parseDataset(group.m_datasets[datasetCount], valid))
+                            return false;
+                        if (valid)
+                            ++datasetCount;
+                        else
+                            m_recordBroken = true;
+
+                        skipWhitespace();
+                    } while (match(','));
+                    if (!match(']'))
+                        return false;
+                }
+
+                m_recordDataset = -1;
+            }
+
+            // Unknown key, skip its value
+            else if (!skipValue())
+                return false;
+
+            skipWhitespace();
+        } while (match(','));
+
+        if (!match('}'))
+            return false;
+    }
+
+    // Trim the slots that this parse did not use
+    group.m_datasets.resize(datasetCount);
+    return true;
+}
+
+/**
+ * Parses a dataset object into the given @a dataset. The @a valid flag is set
+ * when the object contains at least one member, matching the acceptance rule
+ * of @c Dataset::read(). Member coercion follows @c QJsonValue semantics, so
+ * e.g. a numeric "title" yields an empty string & a string "min" yields 0.
+ */
+bool JSON::FrameParser::parseDataset(Dataset &dataset, bool &valid)
+{
+    // Reset the slot to the same defaults produced by Dataset::read()
+    dataset.m_fft = false;
+    dataset.m_led = false;
+    dataset.m_log = false;
+    dataset.m_min = 0;
+    dataset.m_max = 0;
+    dataset.m_index = 0;
+    dataset.m_alarm = 0;
+    dataset.m_alarmLow = 0;
+    dataset.m_alarmRate = 0;
+    dataset.m_graph = false;
+    dataset.m_fftSamples = 0;
+    dataset.m_plotPoints = 0;
+    dataset.m_spectrogram = false;
+    dataset.m_title.clear();
+    dataset.m_value.clear();
+    dataset.m_units.clear();
+    dataset.m_widget.clear();
+    dataset.m_expression.clear();
+    dataset.m_numericValid = false;
+
+    valid = false;
+    if (!match('{'))
+        return false;
+
+    skipWhitespace();
+    if (!match('}'))
+    {
+        do
+        {
+            // Read the member key
+            QString key;
+            skipWhitespace();
+            if (!parseString(key))
+                return false;
+
+            // Key/value separator
+            skipWhitespace();
+            if (!match(':'))
+                return false;
+
+            // Object is non-empty, dataset shall be accepted
+            valid = true;
+
+            // String members
+            skipWhitespace();
+            if (*m_pos == '"')
+            {
+                const char *tokenStart = m_pos;
+                QString string;
+                if (!parseString(string))
+                    return false;
+
+                int field = IgnoredValue;
+                if (key == "title")
+                {
+                    field = DatasetTitle;
+                    dataset.m_title = StringPool::intern(string);
+                }
+                else if (key == "value")
+                {
+                    field = DatasetValue;
+                    dataset.m_value = string;
+                }
+                else if (key == "units")
+                {
+                    field = DatasetUnits;
+                    dataset.m_units = StringPool::intern(string);
+                }
+                else if (key == "widget")
+                {
+                    field = DatasetWidget;
+                    dataset.m_widget = StringPool::intern(string);
+                }
+                else if (key == "expression")
+                {
+                    field = DatasetExpression;
+                    dataset.m_expression = StringPool::intern(string);
+                }
+
+                recordValue(field, tokenStart);
+            }
+
+            // Boolean members
+            else if (*m_pos == 't' || *m_pos == 'f')
+            {
+                const char *tokenStart = m_pos;
+                const bool value = (*m_pos == 't');
+                if (!parseLiteral(value ? "true" : "false"))
+                    return false;
+
+                int field = IgnoredValue;
+                if (key == "fft")
+                {
+                    field = DatasetFft;
+                    dataset.m_fft = value;
+                }
+                else if (key == "led")
+                {
+                    field = DatasetLed;
+                    dataset.m_led = value;
+                }
+                else if (key == "log")
+                {
+                    field = DatasetLog;
+                    dataset.m_log = value;
+                }
+                else if (key == "graph")
+                {
+                    field = DatasetGraph;
+                    dataset.m_graph = value;
+                }
+                else if (key == "spectrogram")
+                {
+                    field = DatasetSpectrogram;
+                    dataset.m_spectrogram = value;
+                }
+
+                recordValue(field, tokenStart);
+            }
+
+            // Numeric members
+            else if (*m_pos == '-' || (*m_pos >= '0' && *m_pos <= '9'))
+            {
+                const char *tokenStart = m_pos;
+                double number;
+                if (!parseNumber(number))
+                    return false;
+
+                int field = IgnoredValue;
+                if (key == "min")
+                {
+                    field = DatasetMin;
+                    dataset.m_min = number;
+                }
+                else if (key == "max")
+                {
+                    field = DatasetMax;
+                    dataset.m_max = number;
+                }
+                else if (key == "alarm")
+                {
+                    field = DatasetAlarm;
+                    dataset.m_alarm = number;
+                }
+                else if (key == "alarmLow")
+                {
+                    field = DatasetAlarmLow;
+                    dataset.m_alarmLow = number;
+                }
+                else if (key == "alarmRate")
+                {
+                    field = DatasetAlarmRate;
+                    dataset.m_alarmRate = number;
+                }
+                else if (key == "index")
+                {
+                    field = DatasetIndex;
+                    dataset.m_index = int(number);
+                }
+                else if (key == "fftSamples")
+                {
+                    field = DatasetFftSamples;
+                    dataset.m_fftSamples = int(number);
+                }
+                else if (key == "plotPoints")
+                {
+                    field = DatasetPlotPoints;
+                    dataset.m_plotPoints = int(number);
+                }
+
+                recordValue(field, tokenStart);
+            }
+
+            // Unknown value type, skip it
+            else if (!skipValue())
+                return false;
+
+            skipWhitespace();
+        } while (match(','));
+
+        if (!match('}'))
+            return false;
+    }
+
+    // Placeholder value for datasets without a reading
+    if (dataset.m_value.isEmpty())
+        dataset.m_value = "--.--";
+
+    return true;
+}
+
+/**
+ * Parses a JSON string into @a out. Strings without escape sequences (the
+ * overwhelmingly common case for telemetry frames) are converted with a
+ * single @c QString::fromUtf8() call over the raw byte span.
+ */
+bool JSON::FrameParser::parseString(QString &out)
+{
+    if (!match('"'))
+        return false;
+
+    // Fast path, scan for the closing quote & check for escapes
+    const char *start = m_pos;
+    while (m_pos < m_end && *m_pos != '"' && *m_pos != '\\')
+        ++m_pos;
+    if (m_pos >= m_end)
+        return false;
+    if (*m_pos == '"')
+    {
+        out = QString::fromUtf8(start, int(m_pos - start));
+        ++m_pos;
+        return true;
+    }
+
+    // Slow path, decode the escape sequences
+    out = QString::fromUtf8(start, int(m_pos - start));
+    while (m_pos < m_end && *m_pos != '"')
+    {
+        if (*m_pos == '\\')
+        {
+            if (++m_pos >= m_end)
+                return false;
+
+            switch (*m_pos)
+            {
+                case '"':
+                    out.append('"');
+                    break;
+                case '\\':
+                    out.append('\\');
+                    break;
+                case '/':
+                    out.append('/');
+                    break;
+                case 'b':
+                    out.append('\b');
+                    break;
+                case 'f':
+                    out.append('\f');
+                    break;
+                case 'n':
+                    out.append('\n');
+                    break;
+                case 'r':
+                    out.append('\r');
+                    break;
+                case 't':
+                    out.append('\t');
+                    break;
+                case 'u':
+                {
+                    if (m_pos + 4 >= m_end)
+                        return false;
+
+                    ushort code = 0;
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        const char c = *(++m_pos);
+                        code <<= 4;
+                        if (c >= '0' && c <= '9')
+                            code |= c - '0';
+                        else if (c >= 'a' && c <= 'f')
+                            code |= c - 'a' + 10;
+                        else if (c >= 'A' && c <= 'F')
+                            code |= c - 'A' + 10;
+                        else
+                            return false;
+                    }
+
+                    // Surrogate pairs fall out naturally, QString is UTF-16
+                    out.append(QChar(code));
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            ++m_pos;
+        }
+
+        // Copy the raw byte span until the next escape or closing quote
+        else
+        {
+            const char *spanStart = m_pos;
+            while (m_pos < m_end && *m_pos != '"' && *m_pos != '\\')
+                ++m_pos;
+            out.append(QString::fromUtf8(spanStart, int(m_pos - spanStart)));
+        }
+    }
+
+    return match('"');
+}
+
+/**
+ * Parses a JSON number into @a out.
+ */
+bool JSON::FrameParser::parseNumber(double &out)
+{
+    // The document byte array is null-terminated, strtod() stops at the first
+    // character that cannot be part of a number
+    char *end = Q_NULLPTR;
+    out = strtod(m_pos, &end);
+    if (end == m_pos || end > m_end)
+        return false;
+
+    m_pos = end;
+    return true;
+}
+
+/**
+ * Consumes the given @a literal (e.g. "true", "false" or "null").
+ */
+bool JSON::FrameParser::parseLiteral(const char *literal)
+{
+    while (*literal != '\0')
+    {
+        if (m_pos >= m_end || *m_pos != *literal)
+            return false;
+
+        ++m_pos;
+        ++literal;
+    }
+
+    return true;
+}
+
+/**
+ * Skips a JSON value of any type, used for keys that are not part of the
+ * frame schema.
+ */
+bool JSON::FrameParser::skipValue()
+{
+    if (m_pos >= m_end)
+        return false;
+
+    // Strings
+    if (*m_pos == '"')
+    {
+        QString ignored;
+        return parseString(ignored);
+    }
+
+    // Objects & arrays, track nesting depth & skip over contained strings
+    if (*m_pos == '{' || *m_pos == '[')
+    {
+        int depth = 0;
+        do
+        {
+            if (*m_pos == '{' || *m_pos == '[')
+                ++depth;
+            else if (*m_pos == '}' || *m_pos == ']')
+                --depth;
+            else if (*m_pos == '"')
+            {
+                QString ignored;
+                if (!parseString(ignored))
+                    return false;
+
+                continue;
+            }
+
+            ++m_pos;
+        } while (m_pos < m_end && depth > 0);
+
+        return depth == 0;
+    }
+
+    // Literals
+    if (*m_pos == 't')
+        return parseLiteral("true");
+    if (*m_pos == 'f')
+        return parseLiteral("false");
+    if (*m_pos == 'n')
+        return parseLiteral("null");
+
+    // Numbers
+    double ignored;
+    return parseNumber(ignored);
+}
+
+/**
+ * Consumes the given character, returns @c false if the next character in the
+ * document does not match.
+ */
+bool JSON::FrameParser::match(const char c)
+{
+    if (m_pos < m_end && *m_pos == c)
+    {
+        ++m_pos;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Skips insignificant whitespace between tokens.
+ */
+void JSON::FrameParser::skipWhitespace()
+{
+    while (m_pos < m_end
+           && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r'))
+        ++m_pos;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+
+#include <JSON/Frame.h>
+
+namespace JSON
+{
+/**
+ * @brief The FrameParser class
+ *
+ * Streaming JSON parser that tokenizes frame bytes directly into a @c Frame
+ * object, without building an intermediate @c QJsonDocument DOM. The parser
+ * only understands the fixed frame schema used by Serial Studio (title,
+ * groups & datasets) and skips over any unknown keys, which is all the
+ * automatic operation mode needs.
+ *
+ * The target @c Frame is re-used between calls: group & dataset slots are
+ * overwritten in place and the heap blocks backing their vectors and strings
+ * are recycled, so steady-state parsing performs almost no allocations. This
+ * matters at kHz frame rates, where the per-frame DOM allocation of
+ * @c QJsonDocument::fromJson() dominates the profile.
+ *
+ * Key coercion rules intentionally match those of @c QJsonValue (e.g. a
+ * numeric "value" field yields an empty string, exactly like
+ * @c QJsonValue::toString() would), so both parse paths produce identical
+ * frames for identical input.
+ *
+ * Since telemetry frames keep an identical key structure for hours at a time,
+ * the parser also locks onto the document schema: every full parse records a
+ * skeleton of the document (the static byte spans between value tokens plus
+ * the frame field that each value feeds). Once two consecutive frames share
+ * the same skeleton, subsequent documents are handled by a value-only parser
+ * that verifies the static spans with @c memcmp() and extracts just the
+ * values, skipping key hashing & structure discovery entirely. Any mismatch
+ * transparently falls back to a full parse, which re-locks the schema.
+ */
+class FrameParser
+{
+public:
+    FrameParser();
+
+    bool parse(const QByteArray &data, Frame &frame);
+    void unlockSchema();
+
+private:
+    enum SchemaField
+    {
+        IgnoredValue,
+        FrameTitle,
+        GroupTitle,
+        GroupWidget,
+        DatasetTitle,
+        DatasetValue,
+        DatasetUnits,
+        DatasetWidget,
+        DatasetFft,
+        DatasetLed,
+        DatasetLog,
+        DatasetGraph,
+        DatasetMin,
+        DatasetMax,
+        DatasetAlarm,
+        DatasetIndex,
+        DatasetFftSamples,
+        DatasetPlotPoints,
+        DatasetSpectrogram,
+        DatasetAlarmLow,
+        DatasetAlarmRate,
+        DatasetExpression
+    };
+
+    /**
+     * Describes one value token of the locked document schema: the static
+     * byte span that precedes the token & the frame field that shall receive
+     * the token value.
+     */
+    struct SchemaSlot
+    {
+        int group;        // group index, -1 for frame-level fields
+        int dataset;      // dataset index, -1 for group-level fields
+        int field;        // target field, see @c SchemaField
+        int staticStart;  // offset of the preceding static span
+        int staticLength; // length of the preceding static span
+    };
+
+    bool parseLocked(const QByteArray &data, Frame &frame);
+    bool sameSchema(const QByteArray &data) const;
+    void recordValue(const int field, const char *tokenStart);
+
+    bool parseFrame(Frame &frame);
+    bool parseGroup(Group &group);
+    bool parseDataset(Dataset &dataset, bool &valid);
+
+    bool parseString(QString &out);
+    bool parseNumber(double &out);
+    bool parseLiteral(const char *literal);
+    bool skipValue();
+    bool match(const char c);
+    void skipWhitespace();
+
+private:
+    const char *m_pos;
+    const char *m_end;
+
+    // Skeleton recording state of the current full parse
+    const char *m_docStart;
+    int m_lastValueEnd;
+    int m_recordGroup;
+    int m_recordDataset;
+    bool m_recordBroken;
+    QVector<SchemaSlot> m_recordSlots;
+
+    // Locked schema, re-validated by memcmp() on every fast parse
+    bool m_schemaValid;
+    int m_schemaTailStart;
+    QByteArray m_schemaDoc;
+    QVector<SchemaSlot> m_schemaSlots;
+    const Frame *m_syncedFrames[2];
+};
+}
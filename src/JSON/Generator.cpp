@@ -20,31 +20,403 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
+#include <QThread>
 #include <QFileInfo>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QFileDialog>
 #include <QRegularExpression>
 
 #include <JSON/Editor.h>
 #include <JSON/Generator.h>
+#include <JSON/Expressions.h>
 
 #include <CSV/Player.h>
 #include <IO/Manager.h>
 #include <MQTT/Client.h>
 #include <Misc/Utilities.h>
+#include <Misc/LatencyTracer.h>
+#include <Misc/SettingsCache.h>
+#include <Misc/Watchdog.h>
+
+/*
+ * Minimum number of frames that a batch must contain before the parse work is
+ * distributed across the global thread pool, smaller batches are parsed
+ * directly on the GUI thread (the synchronization overhead of the pool would
+ * dominate otherwise)
+ */
+static const int kParallelParseThreshold = 16;
+
+/*
+ * Minimum number of frames assigned to each worker of a parallel parse, used
+ * to avoid spawning more chunks than the batch can keep busy
+ */
+static const int kMinFramesPerChunk = 8;
+
+/**
+ * Parses a contiguous chunk of the frame payloads of a batch on a thread-pool
+ * worker. Each task owns a throw-away @c FrameParser (the parser is stateful,
+ * it locks onto the document schema after two identical frames) & writes its
+ * results into distinct slots of the shared output vectors, so no locking is
+ * needed. The caller blocks on the semaphore until every chunk is done &
+ * merges the results in arrival order.
+ */
+class ParseChunkTask : public QRunnable
+{
+public:
+    ParseChunkTask(const QVector<QByteArray> &frames, QVector<JSON::Frame> &results,
+                   QVector<bool> &valid, QVector<QJsonObject> &documents,
+                   const bool wantJson, const int begin, const int end,
+                   QSemaphore &done)
+        : m_frames(frames)
+        , m_results(results)
+        , m_valid(valid)
+        , m_documents(documents)
+        , m_wantJson(wantJson)
+        , m_begin(begin)
+        , m_end(end)
+        , m_done(done)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        JSON::FrameParser parser;
+        for (int i = m_begin; i < m_end; ++i)
+        {
+            const auto &data = m_frames.at(i);
+            m_valid[i] = parser.parse(data, m_results[i]);
+
+            // Generate the DOM for jsonChanged() consumers while we are on a
+            // worker thread anyway
+            if (m_wantJson && m_valid.at(i))
+            {
+                QJsonParseError error;
+                const auto json = QJsonDocument::fromJson(data, &error).object();
+                if (error.error == QJsonParseError::NoError)
+                    m_documents[i] = json;
+            }
+        }
+
+        m_done.release();
+    }
+
+private:
+    const QVector<QByteArray> &m_frames;
+    QVector<JSON::Frame> &m_results;
+    QVector<bool> &m_valid;
+    QVector<QJsonObject> &m_documents;
+    const bool m_wantJson;
+    const int m_begin;
+    const int m_end;
+    QSemaphore &m_done;
+};
+
+/**
+ * Reads a big-endian unsigned integer of @c N bytes & advances the read
+ * position, returns @c false if the buffer does not contain enough bytes.
+ */
+template<typename T>
+static bool MSGPACK_READ(const quint8 *&p, const quint8 *end, T &value)
+{
+    if (p + sizeof(T) > end)
+        return false;
+
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+        value = T(value << 8) | T(*p++);
+
+    return true;
+}
+
+/**
+ * Decodes a MessagePack array of scalar values (integers, floats, booleans,
+ * nil & strings) into a list of value strings. Only the subset of the format
+ * needed to transport telemetry readings is implemented, nested containers
+ * are rejected. Fixed-width binary values decode roughly an order of
+ * magnitude faster than text JSON & keep the wire format compact.
+ *
+ * @return @c true on success, @c false if @a data is not a valid array
+ */
+static bool MSGPACK_DECODE(const QByteArray &data, QStringList &values)
+{
+    auto *p = reinterpret_cast<const quint8 *>(data.constData());
+    auto *end = p + data.size();
+
+    // Read the array header
+    quint32 count;
+    if (p >= end)
+        return false;
+    quint8 tag = *p++;
+    if ((tag & 0xf0) == 0x90)
+        count = tag & 0x0f;
+    else if (tag == 0xdc)
+    {
+        quint16 c;
+        if (!MSGPACK_READ(p, end, c))
+            return false;
+        count = c;
+    }
+    else if (tag == 0xdd)
+    {
+        if (!MSGPACK_READ(p, end, count))
+            return false;
+    }
+    else
+        return false;
+
+    // Decode the array elements
+    values.clear();
+    values.reserve(int(count));
+    for (quint32 i = 0; i < count; ++i)
+    {
+        if (p >= end)
+            return false;
+
+        tag = *p++;
+
+        // Positive & negative fixint
+        if (tag <= 0x7f)
+            values.append(QString::number(tag));
+        else if (tag >= 0xe0)
+            values.append(QString::number(qint8(tag)));
+
+        // Fixstr
+        else if ((tag & 0xe0) == 0xa0)
+        {
+            const int length = tag & 0x1f;
+            if (p + length > end)
+                return false;
+
+            values.append(
+                QString::fromUtf8(reinterpret_cast<const char *>(p), length));
+            p += length;
+        }
+
+        // Nil & booleans
+        else if (tag == 0xc0)
+            values.append(QString());
+        else if (tag == 0xc2)
+            values.append("0");
+        else if (tag == 0xc3)
+            values.append("1");
+
+        // Floating point numbers
+        else if (tag == 0xca)
+        {
+            quint32 bits;
+            if (!MSGPACK_READ(p, end, bits))
+                return false;
+
+            float number;
+            memcpy(&number, &bits, sizeof(number));
+            values.append(QString::number(double(number), 'g', 9));
+        }
+        else if (tag == 0xcb)
+        {
+            quint64 bits;
+            if (!MSGPACK_READ(p, end, bits))
+                return false;
+
+            double number;
+            memcpy(&number, &bits, sizeof(number));
+            values.append(QString::number(number, 'g', 15));
+        }
+
+        // Unsigned integers
+        else if (tag >= 0xcc && tag <= 0xcf)
+        {
+            quint64 number;
+            bool ok = false;
+            if (tag == 0xcc)
+            {
+                quint8 v;
+                ok = MSGPACK_READ(p, end, v);
+                number = v;
+            }
+            else if (tag == 0xcd)
+            {
+                quint16 v;
+                ok = MSGPACK_READ(p, end, v);
+                number = v;
+            }
+            else if (tag == 0xce)
+            {
+                quint32 v;
+                ok = MSGPACK_READ(p, end, v);
+                number = v;
+            }
+            else
+                ok = MSGPACK_READ(p, end, number);
+
+            if (!ok)
+                return false;
+
+            values.append(QString::number(number));
+        }
+
+        // Signed integers
+        else if (tag >= 0xd0 && tag <= 0xd3)
+        {
+            qint64 number;
+            bool ok = false;
+            if (tag == 0xd0)
+            {
+                quint8 v;
+                ok = MSGPACK_READ(p, end, v);
+                number = qint8(v);
+            }
+            else if (tag == 0xd1)
+            {
+                quint16 v;
+                ok = MSGPACK_READ(p, end, v);
+                number = qint16(v);
+            }
+            else if (tag == 0xd2)
+            {
+                quint32 v;
+                ok = MSGPACK_READ(p, end, v);
+                number = qint32(v);
+            }
+            else
+            {
+                quint64 v;
+                ok = MSGPACK_READ(p, end, v);
+                number = qint64(v);
+            }
+
+            if (!ok)
+                return false;
+
+            values.append(QString::number(number));
+        }
+
+        // Str8, str16 & str32
+        else if (tag >= 0xd9 && tag <= 0xdb)
+        {
+            quint32 length;
+            bool ok = false;
+            if (tag == 0xd9)
+            {
+                quint8 v;
+                ok = MSGPACK_READ(p, end, v);
+                length = v;
+            }
+            else if (tag == 0xda)
+            {
+                quint16 v;
+                ok = MSGPACK_READ(p, end, v);
+                length = v;
+            }
+            else
+                ok = MSGPACK_READ(p, end, length);
+
+            if (!ok || p + length > end)
+                return false;
+
+            values.append(
+                QString::fromUtf8(reinterpret_cast<const char *>(p), int(length)));
+            p += length;
+        }
+
+        // Nested containers & extension types are not supported
+        else
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Reads & parses the JSON map file in the given @a path, the function performs no
+ * GUI work so that it can also run on a worker thread (see @c readSettings()).
+ * Sets @a fileOpen to @c false if the file cannot be read & stores validation
+ * problems in @a parseError.
+ */
+static void ReadJsonMap(const QString &path, QJsonDocument &document, bool &fileOpen,
+                        QString &parseError)
+{
+    QFile file(path);
+    fileOpen = file.open(QFile::ReadOnly);
+    if (fileOpen)
+    {
+        QJsonParseError error;
+        document = QJsonDocument::fromJson(file.readAll(), &error);
+        if (error.error != QJsonParseError::NoError)
+            parseError = error.errorString();
+
+        file.close();
+    }
+}
+
+/**
+ * Returns a compact signature of the widget structure described by the given project
+ * @a root object: the group count, the widget type of every group & the attributes of
+ * every dataset that decide which dashboard widgets exist (dataset widget type & the
+ * graph/fft/led flags) & the sample storage precision ("fp32") flag, since changing the
+ * precision requires rebuilding every plot & history buffer. Two documents with equal
+ * signatures generate the same dashboard layout, so an edit that only touches titles,
+ * units, scales or alarm levels can be applied without tearing the dashboard down.
+ */
+static QByteArray StructuralSignature(const QJsonObject &root)
+{
+    QByteArray signature;
+    const auto groups = root.value("groups").toArray();
+    signature.append(root.value("fp32").toBool() ? 'f' : 'd');
+    signature.append(QByteArray::number(groups.count()));
+    for (int g = 0; g < groups.count(); ++g)
+    {
+        const auto group = groups.at(g).toObject();
+        const auto datasets = group.value("datasets").toArray();
+        signature.append('|');
+        signature.append(group.value("widget").toString().toUtf8());
+        signature.append(':');
+        signature.append(QByteArray::number(datasets.count()));
+        for (int d = 0; d < datasets.count(); ++d)
+        {
+            const auto dataset = datasets.at(d).toObject();
+            signature.append(',');
+            signature.append(dataset.value("widget").toString().toUtf8());
+            signature.append(dataset.value("graph").toBool() ? '1' : '0');
+            signature.append(dataset.value("fft").toBool() ? '1' : '0');
+            signature.append(dataset.value("led").toBool() ? '1' : '0');
+
+            // Bit labels of bitmask datasets are structural, the LED panel
+            // generates its LED rows from them at construction time
+            if (dataset.value("ledBitmask").toBool())
+            {
+                const auto labels = dataset.value("ledLabels").toArray();
+                for (int b = 0; b < labels.count(); ++b)
+                {
+                    signature.append(';');
+                    signature.append(labels.at(b).toString().toUtf8());
+                }
+            }
+        }
+    }
+
+    return signature;
+}
 
 /**
  * Initializes the JSON Parser class and connects appropiate SIGNALS/SLOTS
  */
 JSON::Generator::Generator()
     : m_opMode(kAutomatic)
+    , m_frameFromTemplate(false)
+    , m_frameIndex(0)
 {
     // clang-format off
     connect(&CSV::Player::instance(), &CSV::Player::openChanged,
             this, &JSON::Generator::reset);
     connect(&IO::Manager::instance(), &IO::Manager::deviceChanged,
             this, &JSON::Generator::reset);
-    connect(&IO::Manager::instance(), &IO::Manager::frameReceived,
-            this, &JSON::Generator::readData);
+    connect(&IO::Manager::instance(), &IO::Manager::frameBatchReceived,
+            this, &JSON::Generator::readFrames);
     // clang-format on
 
     readSettings();
@@ -128,27 +500,46 @@ void JSON::Generator::loadJsonMap(const QString &path)
     if (path.isEmpty())
         return;
 
+    // Read & parse the file, then register the document
+    bool fileOpen = false;
+    QString parseError;
+    QJsonDocument document;
+    ReadJsonMap(path, document, fileOpen, parseError);
+    applyJsonMap(path, document, fileOpen, parseError);
+}
+
+/**
+ * Registers the parsed JSON map @a document (obtained from the file in the given
+ * @a path) as the active map file & notifies the user interface. The function
+ * reports read errors when @a fileOpen is @c false & validation errors when
+ * @a parseError is not empty.
+ */
+void JSON::Generator::applyJsonMap(const QString &path, const QJsonDocument &document,
+                                   const bool fileOpen, const QString &parseError)
+{
+    // Keep the previous document & path around, re-saving the active project with an
+    // unchanged widget layout is detected below & applied without a dashboard rebuild
+    const QString previousPath = m_jsonMap.fileName();
+    const QString previousData = m_jsonMapData;
+
     // Close previous file (if open)
     if (m_jsonMap.isOpen())
     {
         m_jsonMap.close();
         m_jsonMapData = "";
-        Q_EMIT jsonFileMapChanged();
     }
 
-    // Try to open the file (read only mode)
+    // Re-open the file so that jsonMapFilename() & jsonMapFilepath() work
+    bool mapLoaded = false;
     m_jsonMap.setFileName(path);
-    if (m_jsonMap.open(QFile::ReadOnly))
+    if (fileOpen && m_jsonMap.open(QFile::ReadOnly))
     {
-        // Read data & validate JSON from file
-        QJsonParseError error;
-        auto data = m_jsonMap.readAll();
-        auto document = QJsonDocument::fromJson(data, &error);
-        if (error.error != QJsonParseError::NoError)
+        // Report JSON validation errors
+        if (!parseError.isEmpty())
         {
             m_jsonMap.close();
             writeSettings("");
-            Misc::Utilities::showMessageBox(tr("JSON parse error"), error.errorString());
+            Misc::Utilities::showMessageBox(tr("JSON parse error"), parseError);
         }
 
         // JSON contains no errors, load compacted JSON document & save settings
@@ -156,10 +547,9 @@ void JSON::Generator::loadJsonMap(const QString &path)
         {
             writeSettings(path);
             m_jsonMapData = QString::fromUtf8(document.toJson(QJsonDocument::Compact));
+            compileJsonMap(document.object());
+            mapLoaded = true;
         }
-
-        // Get rid of warnings
-        Q_UNUSED(document);
     }
 
     // Open error
@@ -172,12 +562,26 @@ void JSON::Generator::loadJsonMap(const QString &path)
         m_jsonMap.close();
     }
 
+    // The same project was re-loaded with an identical widget structure, only dataset
+    // attributes (titles, units, scales, alarms...) changed: notify with the lighter
+    // attribute signal so that the dashboard updates the affected widgets in place &
+    // keeps the plot buffers, history & statistics
+    if (mapLoaded && path == previousPath && !previousData.isEmpty())
+    {
+        const auto previous = QJsonDocument::fromJson(previousData.toUtf8()).object();
+        if (StructuralSignature(previous) == StructuralSignature(document.object()))
+        {
+            Q_EMIT jsonMapAttributesChanged();
+            return;
+        }
+    }
+
     // Update UI
     Q_EMIT jsonFileMapChanged();
 }
 
 /**
- * Changes the operation mode of the JSON parser. There are two possible op.
+ * Changes the operation mode of the JSON parser. There are three possible op.
  * modes:
  *
  * @c kManual serial data only contains the comma-separated values, and we need
@@ -188,21 +592,46 @@ void JSON::Generator::loadJsonMap(const QString &path)
  *
  * @c kAutomatic serial data contains the JSON data frame, good for simple
  *               applications or for prototyping.
+ *
+ * @c kBinary serial data contains a MessagePack array with the values, which
+ *            are mapped through the same JSON map file used by the manual
+ *            mode. Binary values keep the wire format compact & decode much
+ *            faster than text.
  */
 void JSON::Generator::setOperationMode(const JSON::Generator::OperationMode &mode)
 {
     m_opMode = mode;
+    m_frameParser.unlockSchema();
     Q_EMIT operationModeChanged();
 }
 
 /**
- * Loads the last saved JSON map file (if any)
+ * Loads the last saved JSON map file (if any). The file is read & parsed on a
+ * short-lived worker thread so that a large map does not delay the first paint
+ * of the user interface, the parsed document is registered from the GUI thread
+ * once it is ready (see @c applyJsonMap()).
  */
 void JSON::Generator::readSettings()
 {
-    auto path = m_settings.value("json_map_location", "").toString();
-    if (!path.isEmpty())
-        loadJsonMap(path);
+    auto path
+        = Misc::SettingsCache::instance().value("json_map_location", "").toString();
+    if (path.isEmpty())
+        return;
+
+    // clang-format off
+    auto worker = QThread::create([this, path]() {
+        bool fileOpen = false;
+        QString parseError;
+        QJsonDocument document;
+        ReadJsonMap(path, document, fileOpen, parseError);
+        QMetaObject::invokeMethod(this, [this, path, document, fileOpen, parseError]() {
+            applyJsonMap(path, document, fileOpen, parseError);
+        }, Qt::QueuedConnection);
+    });
+    // clang-format on
+
+    connect(worker, &QThread::finished, worker, &QObject::deleteLater);
+    worker->start(QThread::LowPriority);
 }
 
 /**
@@ -210,7 +639,7 @@ void JSON::Generator::readSettings()
  */
 void JSON::Generator::writeSettings(const QString &path)
 {
-    m_settings.setValue("json_map_location", path);
+    Misc::SettingsCache::instance().setValue("json_map_location", path);
 }
 
 /**
@@ -218,8 +647,136 @@ void JSON::Generator::writeSettings(const QString &path)
  */
 void JSON::Generator::reset()
 {
+    m_frameIndex = 0;
+    m_frames[0].clear();
+    m_frames[1].clear();
     m_json = QJsonObject();
+    m_frameFromTemplate = false;
+    m_frameParser.unlockSchema();
     Q_EMIT jsonChanged(m_json);
+    Q_EMIT frameChanged(m_frames[0]);
+}
+
+/**
+ * Compiles the JSON map in the given @a object into a template frame and a
+ * list of value slots. The template holds everything that is static across
+ * frames (titles, widgets, ranges, etc.), while each slot records the string
+ * field that contains a "%1","%2",… placeholder. Thanks to this, the
+ * per-frame work of the manual operation mode is reduced to splitting the
+ * comma-separated values & writing them into the slot fields, instead of
+ * doing a QString::replace() over the whole map and re-parsing the result as
+ * JSON for every single frame.
+ */
+void JSON::Generator::compileJsonMap(const QJsonObject &object)
+{
+    // Reset previous compilation results
+    m_mapSlots.clear();
+    m_mapTemplate.clear();
+    m_frameFromTemplate = false;
+
+    // Read the map into the template frame, placeholders are ordinary strings
+    if (!m_mapTemplate.read(object))
+        return;
+
+    // Register a slot for every string field that only contains a placeholder
+    QRegularExpression placeholder("^%(\\d+)$");
+    for (int g = -1; g < m_mapTemplate.groupCount(); ++g)
+    {
+        const int fields = (g < 0) ? 1 : 2;
+        for (int f = 0; f < fields; ++f)
+        {
+            MapValueSlot slot = { g, -1, f, 0 };
+            auto match = placeholder.match(*mapSlotField(m_mapTemplate, slot));
+            if (match.hasMatch())
+            {
+                slot.index = match.captured(1).toInt();
+                m_mapSlots.append(slot);
+            }
+        }
+
+        if (g < 0)
+            continue;
+
+        for (int d = 0; d < m_mapTemplate.m_groups[g].datasetCount(); ++d)
+        {
+            for (int f = 0; f < 4; ++f)
+            {
+                MapValueSlot slot = { g, d, f, 0 };
+                auto match = placeholder.match(*mapSlotField(m_mapTemplate, slot));
+                if (match.hasMatch())
+                {
+                    slot.index = match.captured(1).toInt();
+                    m_mapSlots.append(slot);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Returns a pointer to the string field of the given @a frame that is
+ * addressed by the given @a slot. Field 0 is the title of the frame, group or
+ * dataset; fields 1-3 address the widget of a group & the value, units &
+ * widget of a dataset.
+ */
+QString *JSON::Generator::mapSlotField(Frame &frame, const MapValueSlot &slot)
+{
+    if (slot.group < 0)
+        return &frame.m_title;
+
+    auto &group = frame.m_groups[slot.group];
+    if (slot.dataset < 0)
+        return (slot.field == 0) ? &group.m_title : &group.m_widget;
+
+    auto &dataset = group.m_datasets[slot.dataset];
+    switch (slot.field)
+    {
+        case 1:
+            return &dataset.m_value;
+        case 2:
+            return &dataset.m_units;
+        case 3:
+            return &dataset.m_widget;
+        default:
+            return &dataset.m_title;
+    }
+}
+
+/**
+ * Compares the datasets of the given @a frame against the ones of the
+ * @a previous frame & flags the datasets whose value changed. The widgets use
+ * these flags to skip the rows that do not need to be re-rendered, which
+ * avoids most of the UI work on projects with a large number of datasets
+ * where only a few values change per frame.
+ */
+void JSON::Generator::markChangedDatasets(Frame &frame, const Frame &previous)
+{
+    const bool sameFrame = (frame.groupCount() == previous.groupCount());
+    for (int i = 0; i < frame.groupCount(); ++i)
+    {
+        auto &group = frame.m_groups[i];
+
+        // Check if the group layout matches the one of the previous frame,
+        // otherwise every dataset of the group needs to be re-rendered
+        const bool sameGroup
+            = sameFrame
+              && (group.datasetCount() == previous.m_groups.at(i).datasetCount());
+        if (!sameGroup)
+        {
+            for (int j = 0; j < group.datasetCount(); ++j)
+                group.m_datasets[j].m_changed = true;
+
+            continue;
+        }
+
+        // Compare the value of each dataset with the previous frame
+        const auto &pGroup = previous.m_groups.at(i);
+        for (int j = 0; j < group.datasetCount(); ++j)
+        {
+            auto &dataset = group.m_datasets[j];
+            dataset.m_changed = (dataset.m_value != pGroup.m_datasets.at(j).m_value);
+        }
+    }
 }
 
 /**
@@ -241,31 +798,238 @@ void JSON::Generator::readData(const QByteArray &data)
     if (data.isEmpty())
         return;
 
-    // Serial device sends JSON (auto mode)
+    // Tag this handler so that event-loop stall reports can blame it
+    Misc::WatchdogActivity activity("JSON::Generator frame parsing");
+
+    // Serial device sends JSON (auto mode), tokenize the frame bytes directly
+    // into the re-usable frame object without building a QJsonDocument DOM.
+    // The DOM is only generated when a consumer of the jsonChanged() signal
+    // (e.g. the plugin server) actually needs it.
     if (operationMode() == JSON::Generator::kAutomatic)
-        m_json = QJsonDocument::fromJson(data, &m_error).object();
+    {
+        auto &frame = m_frames[m_frameIndex];
+        if (!m_frameParser.parse(data, frame))
+            return;
+
+        // Compute the derived datasets & flag the datasets whose value
+        // changed since the previous frame
+        Expressions::instance().apply(frame);
+        markChangedDatasets(frame, m_frames[(m_frameIndex + 1) & 1]);
+
+        m_frameIndex = (m_frameIndex + 1) & 1;
+        Misc::LatencyTracer::instance().frameParsed();
+        Q_EMIT frameChanged(frame);
 
-    // We need to use a map file, check if its loaded & replace values into map
+        if (receivers(SIGNAL(jsonChanged(QJsonObject))) > 0)
+        {
+            m_json = QJsonDocument::fromJson(data, &m_error).object();
+            if (m_error.error == QJsonParseError::NoError)
+                Q_EMIT jsonChanged(m_json);
+        }
+
+        return;
+    }
+
+    // We need to use a map file, check if its compiled & write values into the
+    // placeholder slots of the template frame
     else
     {
-        // Empty JSON map data
-        if (jsonMapData().isEmpty())
+        // Empty or invalid JSON map data
+        if (jsonMapData().isEmpty() || !m_mapTemplate.isValid())
+            return;
+
+        // Obtain the value list: manual mode splits the comma-separated
+        // values, binary mode decodes a MessagePack array
+        QStringList list;
+        if (operationMode() == JSON::Generator::kManual)
+        {
+            const auto sepr = IO::Manager::instance().separatorSequence();
+            list = QString::fromUtf8(data).split(sepr);
+        }
+
+        else if (!MSGPACK_DECODE(data, list))
             return;
 
-        // Separate incoming data & add it to the JSON map
+        // Write the values into the placeholder slots & notify the UI
+        readCells(list, 0);
+    }
+}
+
+/**
+ * Writes the given row of @a cells into the placeholder slots of the template frame &
+ * notifies the UI, the cell at index @a offset corresponds to the "%1" placeholder.
+ * Returns @c false when no compiled JSON map is available.
+ *
+ * The CSV player uses this entry point to bind the columns of the played file
+ * directly to the dataset slots of the frame model: the row values it already holds
+ * in split form are written straight into the frame, instead of being serialized
+ * into a delimited string that this class would immediately re-split.
+ */
+bool JSON::Generator::readCells(const QStringList &cells, const int offset)
+{
+    // Empty or invalid JSON map data
+    if (jsonMapData().isEmpty() || !m_mapTemplate.isValid())
+        return false;
+
+    // Initialize the working frames from the compiled template
+    if (!m_frameFromTemplate)
+    {
+        m_frames[0] = m_mapTemplate;
+        m_frames[1] = m_mapTemplate;
+        m_frameFromTemplate = true;
+    }
+
+    // Alternate between both frames of the double-buffer pool
+    auto &frame = m_frames[m_frameIndex];
+    m_frameIndex = (m_frameIndex + 1) & 1;
+
+    // Write each value into its slot. Values without a matching
+    // placeholder are ignored & placeholders without a matching value
+    // keep their "%1","%2",… text, exactly like the QString::replace()
+    // implementation that this path replaces.
+    for (int i = 0; i < m_mapSlots.count(); ++i)
+    {
+        const auto &slot = m_mapSlots.at(i);
+        auto *field = mapSlotField(frame, slot);
+        if (slot.index >= 1 && offset + slot.index <= cells.count())
+            *field = cells.at(offset + slot.index - 1);
+        else
+            *field = QString("%%1").arg(slot.index);
+
+        // Placeholder value for datasets without a reading & numeric
+        // cache invalidation, the slot field was just overwritten
+        if (slot.dataset >= 0 && slot.field == 1)
+        {
+            if (field->isEmpty())
+                *field = "--.--";
+
+            auto &dataset = frame.m_groups[slot.group].m_datasets[slot.dataset];
+            dataset.m_numericValid = false;
+        }
+    }
+
+    // Compute the derived datasets & flag the datasets whose value
+    // changed since the previous frame, which now sits on the other
+    // buffer of the pool
+    Expressions::instance().apply(frame);
+    markChangedDatasets(frame, m_frames[m_frameIndex]);
+
+    // Update UI
+    Misc::LatencyTracer::instance().frameParsed();
+    Q_EMIT frameChanged(frame);
+
+    // Generate the JSON document for jsonChanged() consumers (e.g. the
+    // plugin server), only paying for the DOM when somebody listens
+    if (receivers(SIGNAL(jsonChanged(QJsonObject))) > 0)
+    {
         auto json = jsonMapData();
-        auto sepr = IO::Manager::instance().separatorSequence();
-        auto list = QString::fromUtf8(data).split(sepr);
-        for (int i = 0; i < list.count(); ++i)
-            json.replace(QString("\"%%1\"").arg(i + 1), "\"" + list.at(i) + "\"");
+        for (int i = offset; i < cells.count(); ++i)
+            json.replace(QString("\"%%1\"").arg(i - offset + 1),
+                         "\"" + cells.at(i) + "\"");
 
-        // Create JSON document
         m_json = QJsonDocument::fromJson(json.toUtf8(), &m_error).object();
+        if (m_error.error == QJsonParseError::NoError)
+            Q_EMIT jsonChanged(m_json);
     }
 
-    // No parse error, update UI & reset error counter
-    if (m_error.error == QJsonParseError::NoError)
-        Q_EMIT jsonChanged(m_json);
+    return true;
+}
+
+/**
+ * Parses the given batch of frame payloads, which the I/O manager publishes in a
+ * single signal whenever the frame reader drains its queue.
+ *
+ * Most of the time a batch holds a single frame & the payloads are simply handed
+ * to @c readData() one after the other. When a TCP burst or a fast-forwarded
+ * replay delivers a large batch in automatic mode, the parse stage (which
+ * dominates the per-frame cost of that mode) is distributed across the global
+ * thread pool instead: the batch is split into contiguous chunks, each chunk is
+ * tokenized by a worker with its own parser & the results are merged back in
+ * arrival order on the GUI thread. The merge runs change detection against the
+ * previous frame & emits @c frameChanged() for every parsed frame, so plots
+ * still receive every data point; since the whole merge happens in one
+ * event-loop pass, the widget repaints it schedules are coalesced into a single
+ * render per batch.
+ */
+void JSON::Generator::readFrames(const QVector<QByteArray> &frames)
+{
+    // Small batches & map-file modes are parsed directly on the GUI thread,
+    // the per-frame work of the manual/binary modes is a value split that is
+    // too cheap to offload
+    const int count = frames.count();
+    if (count < kParallelParseThreshold
+        || operationMode() != JSON::Generator::kAutomatic)
+    {
+        for (int i = 0; i < count; ++i)
+            readData(frames.at(i));
+
+        return;
+    }
+
+    // Tag this handler so that event-loop stall reports can blame it
+    Misc::WatchdogActivity activity("JSON::Generator burst parsing");
+
+    // Allocate one result slot per payload, workers write into distinct slots
+    const bool wantJson = receivers(SIGNAL(jsonChanged(QJsonObject))) > 0;
+    QVector<Frame> results(count);
+    QVector<bool> valid(count, false);
+    QVector<QJsonObject> documents(wantJson ? count : 0);
+
+    // Split the batch into contiguous chunks, one per worker. Chunks are kept
+    // large enough for each throw-away parser to lock onto the document schema
+    // after its first two frames & amortize the setup cost
+    const int chunks
+        = qBound(1, count / kMinFramesPerChunk, QThread::idealThreadCount());
+    const int chunkSize = (count + chunks - 1) / chunks;
+
+    // Parse every chunk on the global thread pool & wait for completion
+    QSemaphore done;
+    int started = 0;
+    for (int begin = 0; begin < count; begin += chunkSize)
+    {
+        const int end = qMin(begin + chunkSize, count);
+        QThreadPool::globalInstance()->start(new ParseChunkTask(
+            frames, results, valid, documents, wantJson, begin, end, done));
+        ++started;
+    }
+
+    done.acquire(started);
+
+    // Merge the results in arrival order: run change detection against the
+    // previously emitted frame & notify the UI for every parsed frame
+    bool parsedAny = false;
+    const Frame *previous = &m_frames[(m_frameIndex + 1) & 1];
+    for (int i = 0; i < count; ++i)
+    {
+        if (!valid.at(i))
+            continue;
+
+        auto &frame = results[i];
+        Expressions::instance().apply(frame);
+        markChangedDatasets(frame, *previous);
+        Misc::LatencyTracer::instance().frameParsed();
+        Q_EMIT frameChanged(frame);
+
+        if (wantJson && !documents.at(i).isEmpty())
+        {
+            m_json = documents.at(i);
+            Q_EMIT jsonChanged(m_json);
+        }
+
+        previous = &frame;
+        parsedAny = true;
+    }
+
+    // Register the last parsed frame in the double-buffer pool so that the
+    // next single-frame parse compares against it. The pool frames no longer
+    // hold the static fields recorded by the generator parser, so the locked
+    // schema must be dropped (see FrameParser::unlockSchema())
+    if (parsedAny)
+    {
+        m_frames[m_frameIndex] = *previous;
+        m_frameIndex = (m_frameIndex + 1) & 1;
+        m_frameParser.unlockSchema();
+    }
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
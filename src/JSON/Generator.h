@@ -24,13 +24,14 @@
 
 #include <QFile>
 #include <QObject>
-#include <QSettings>
 #include <QJsonArray>
+#include <QStringList>
 #include <QJsonValue>
 #include <QJsonObject>
 #include <QJsonDocument>
 
 #include <JSON/Frame.h>
+#include <JSON/FrameParser.h>
 
 namespace JSON
 {
@@ -74,8 +75,10 @@ class Generator : public QObject
 
 Q_SIGNALS:
     void jsonFileMapChanged();
+    void jsonMapAttributesChanged();
     void operationModeChanged();
     void jsonChanged(const QJsonObject &json);
+    void frameChanged(const JSON::Frame &frame);
 
 private:
     explicit Generator();
@@ -89,6 +92,7 @@ public:
     {
         kManual = 0x00,
         kAutomatic = 0x01,
+        kBinary = 0x02,
     };
     Q_ENUM(OperationMode)
 
@@ -99,6 +103,8 @@ public:
     QString jsonMapFilepath() const;
     OperationMode operationMode() const;
 
+    bool readCells(const QStringList &cells, const int offset = 0);
+
 public Q_SLOTS:
     void loadJsonMap();
     void loadJsonMap(const QString &path);
@@ -111,13 +117,47 @@ public Q_SLOTS:
 private Q_SLOTS:
     void reset();
     void readData(const QByteArray &data);
+    void readFrames(const QVector<QByteArray> &frames);
+
+private:
+    /**
+     * Represents a "%1","%2",… placeholder found while compiling the JSON map
+     * file, pointing to the string field of the frame model that shall
+     * receive the corresponding comma-separated value of each incoming frame.
+     */
+    struct MapValueSlot
+    {
+        int group;   // group index, -1 for the frame title
+        int dataset; // dataset index, -1 for group-level fields
+        int field;   // string field of the target (see mapSlotField())
+        int index;   // placeholder number, "%1" -> 1
+    };
+
+    void compileJsonMap(const QJsonObject &object);
+    void applyJsonMap(const QString &path, const QJsonDocument &document,
+                      const bool fileOpen, const QString &parseError);
+    QString *mapSlotField(Frame &frame, const MapValueSlot &slot);
+    void markChangedDatasets(Frame &frame, const Frame &previous);
 
 private:
     QFile m_jsonMap;
     QJsonObject m_json;
-    QSettings m_settings;
     QString m_jsonMapData;
     OperationMode m_opMode;
     QJsonParseError m_error;
+    FrameParser m_frameParser;
+
+    Frame m_mapTemplate;
+    bool m_frameFromTemplate;
+    QVector<MapValueSlot> m_mapSlots;
+
+    // Double-buffered frame pool. The generator alternates the parse target
+    // between both frames: while the dashboard still shares the heap blocks
+    // of the frame emitted last, the generator re-uses the (by then
+    // unreferenced) blocks of the frame before it. This keeps the implicitly
+    // shared group/dataset vectors from detaching & re-allocating on every
+    // single frame.
+    int m_frameIndex;
+    Frame m_frames[2];
 };
 }
@@ -22,6 +22,7 @@
 
 #include <QJsonArray>
 #include <JSON/Group.h>
+#include <JSON/StringPool.h>
 
 /**
  * Destructor function
@@ -87,8 +88,8 @@ bool JSON::Group::read(const QJsonObject &object)
 
         if (!title.isEmpty() && !array.isEmpty())
         {
-            m_title = title;
-            m_widget = widget;
+            m_title = StringPool::intern(title);
+            m_widget = StringPool::intern(widget);
             m_datasets.clear();
 
             for (auto i = 0; i < array.count(); ++i)
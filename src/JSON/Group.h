@@ -71,6 +71,9 @@ private:
     QVector<Dataset> m_datasets;
 
     friend class Editor;
+    friend class Generator;
+    friend class FrameParser;
+    friend class Expressions;
     friend class UI::Dashboard;
 };
 }
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QMutexLocker>
+
+#include <JSON/StringPool.h>
+#include <Misc/MemoryRegistry.h>
+
+/**
+ * Constructor function
+ */
+JSON::StringPool::StringPool()
+    : m_bytes(0)
+{
+}
+
+/**
+ * Returns the only instance of the class
+ */
+JSON::StringPool &JSON::StringPool::pool()
+{
+    static StringPool singleton;
+    return singleton;
+}
+
+/**
+ * Returns the canonical copy of the given @a string. The first caller to
+ * intern a given text pays for one insertion, every subsequent call returns a
+ * reference-counted copy of the stored instance & the argument is discarded.
+ * The pool only ever holds the distinct structural strings of the current
+ * project, so it stays bounded by the project file, not by the data rate.
+ */
+QString JSON::StringPool::intern(const QString &string)
+{
+    if (string.isEmpty())
+        return string;
+
+    auto &p = pool();
+    QMutexLocker locker(&p.m_lock);
+
+    const auto it = p.m_strings.constFind(string);
+    if (it != p.m_strings.constEnd())
+        return it.value();
+
+    p.m_strings.insert(string, string);
+    p.m_bytes += sizeof(QChar) * string.size();
+    Misc::MemoryRegistry::instance().report("JSON::StringPool", p.m_bytes);
+
+    return string;
+}
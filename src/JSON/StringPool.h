@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+namespace JSON
+{
+/**
+ * @brief The StringPool class
+ *
+ * Interning pool for the structural strings of a frame (titles, units, widget
+ * identifiers & expressions). Every frame rebuild parses the same handful of
+ * distinct strings over & over, and each parse used to produce a fresh heap
+ * buffer that was then copied into the dashboard title lists. @c intern()
+ * returns the canonical copy of a string instead, so all the frames, groups,
+ * datasets & dashboard lists that hold the same text share a single buffer
+ * through the implicit sharing of @c QString, and copying a dataset costs a
+ * pointer-sized reference per field.
+ *
+ * Thread-safe, the frame parser calls @c intern() both from the GUI thread &
+ * from the thread-pool workers of the burst parsing path. Dataset values are
+ * never interned, they change with every frame.
+ */
+class StringPool
+{
+public:
+    static QString intern(const QString &string);
+
+private:
+    StringPool();
+    static StringPool &pool();
+
+    qint64 m_bytes;
+    QMutex m_lock;
+    QHash<QString, QString> m_strings;
+};
+}
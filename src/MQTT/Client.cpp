@@ -21,39 +21,77 @@
  */
 
 #include <QFile>
+#include <QDateTime>
 #include <QFileDialog>
+#include <QRandomGenerator>
 
 #include <IO/Manager.h>
 #include <MQTT/Client.h>
 #include <Misc/Utilities.h>
-#include <Misc/TimerEvents.h>
+#include <Misc/SettingsCache.h>
+#include <Misc/MemoryRegistry.h>
+
+/*
+ * Time-to-live of cached DNS lookup results, broker addresses rarely change
+ * mid-session & skipping the lookup shaves a round trip off every reconnect.
+ */
+static const qint64 DNS_CACHE_TTL = 60 * 1000;
+
+/*
+ * Minimum number of frames in a drained subscriber batch before conflation kicks
+ * in. Smaller batches are parsed in full, a reconnect replay of queued/retained
+ * messages easily exceeds this and only needs its newest frame on screen.
+ */
+static const int CONFLATION_THRESHOLD = 32;
 
 /**
  * Constructor function
  */
 MQTT::Client::Client()
     : m_topic("")
+    , m_subscriberConflation(true)
     , m_lookupActive(false)
+    , m_dnsCacheExpiry(0)
     , m_sentMessages(0)
     , m_clientMode(MQTTClientMode::ClientPublisher)
     , m_client(Q_NULLPTR)
 {
-    // Configure new client
+    // Allow the TLS stack to persist & share session tickets between connections,
+    // so that reconnecting to the same broker can use an abbreviated handshake
+    // instead of repeating the full certificate exchange on every drop
+    m_sslConfiguration.setSslOption(QSsl::SslOptionDisableSessionSharing, false);
+    m_sslConfiguration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+
+    // Configure new client, the network thread that hosts it is only started when
+    // the user connects to a broker for the first time (see connectToHost())
     regenerateClient();
 
-    // Send data periodically & reset statistics when disconnected/connected to a device
+    // Drain the subscriber frame queue from the GUI thread whenever the network
+    // thread pushes a batch of frames
+    connect(this, &MQTT::Client::framesQueued, this, &MQTT::Client::onFramesQueued,
+            Qt::QueuedConnection);
+
+    // Aggregate received frames into a single payload & publish them in batches,
+    // the flush timer is armed when the first frame of a batch arrives
+    m_payloadBuffer.reserve(4096);
+    m_publishTimer.setInterval(100);
+    m_publishTimer.setSingleShot(true);
+    m_publishTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_publishTimer, &QTimer::timeout, this, &MQTT::Client::sendData);
+
+    // Register received frames & reset statistics when disconnected/connected to a device
     auto io = &IO::Manager::instance();
-    auto te = &Misc::TimerEvents::instance();
-    connect(te, &Misc::TimerEvents::timeout1Hz, this, &MQTT::Client::sendData);
     connect(io, &IO::Manager::frameReceived, this, &MQTT::Client::onFrameReceived);
     connect(io, &IO::Manager::connectedChanged, this, &MQTT::Client::resetStatistics);
 }
 
 /**
- * Destructor function
+ * Destructor function, stops the network thread before destroying the MQTT client
  */
 MQTT::Client::~Client()
 {
+    m_networkThread.quit();
+    m_networkThread.wait();
     delete m_client;
 }
 
@@ -197,6 +235,25 @@ bool MQTT::Client::lookupActive() const
     return m_lookupActive;
 }
 
+/**
+ * Returns the interval (in milliseconds) at which buffered frames are aggregated &
+ * published to the MQTT broker/server.
+ */
+int MQTT::Client::publishInterval() const
+{
+    return m_publishTimer.interval();
+}
+
+/**
+ * Returns @c true if subscriber mode conflates catch-up bursts, parsing only the
+ * newest frame of a large drained batch for the dashboard while the full stream
+ * still reaches the console, the CSV export module & the plugins subsystem.
+ */
+bool MQTT::Client::subscriberConflation() const
+{
+    return m_subscriberConflation;
+}
+
 /**
  * Returns @c true if the MQTT module is connected to the broker, the topic is not empty
  * and the client is configured to act as an MQTT subscriber.
@@ -286,12 +343,25 @@ void MQTT::Client::loadCaFile()
 }
 
 /**
- * Tries to establish a TCP connection with the MQTT broker/server.
+ * Tries to establish a TCP connection with the MQTT broker/server. The connection is
+ * established from the network thread, which owns the client & its socket.
  */
 void MQTT::Client::connectToHost()
 {
     Q_ASSERT(m_client);
-    m_client->connectToHost();
+
+    // Start the network thread on first use, socket I/O & MQTT packet decoding must
+    // not run on the GUI thread
+    if (!m_networkThread.isRunning())
+        m_networkThread.start(QThread::HighPriority);
+
+    // Hand the client (and its socket) over to the network thread, the client idles
+    // on the GUI thread until the first connection is requested
+    if (m_client->thread() != &m_networkThread)
+        m_client->moveToThread(&m_networkThread);
+
+    QMetaObject::invokeMethod(
+        m_client, [this]() { m_client->connectToHost(); }, Qt::QueuedConnection);
 }
 
 /**
@@ -312,7 +382,8 @@ void MQTT::Client::toggleConnection()
 void MQTT::Client::disconnectFromHost()
 {
     Q_ASSERT(m_client);
-    m_client->disconnectFromHost();
+    QMetaObject::invokeMethod(
+        m_client, [this]() { m_client->disconnectFromHost(); }, Qt::QueuedConnection);
 }
 
 /**
@@ -326,13 +397,24 @@ void MQTT::Client::setQos(const quint8 qos)
 }
 
 /**
- * Performs a DNS lookup for the given @a host name
+ * Performs a DNS lookup for the given @a host name. Lookup results are cached for
+ * @c DNS_CACHE_TTL milliseconds, repeated lookups of the same host (e.g. while
+ * reconnecting over a flaky link) are served locally without a network round trip.
  */
 void MQTT::Client::lookup(const QString &host)
 {
+    // Serve the lookup from the cache while its TTL has not expired
+    const auto name = host.simplified();
+    if (name == m_dnsCachedHost && !m_dnsCachedAddress.isEmpty()
+        && QDateTime::currentMSecsSinceEpoch() < m_dnsCacheExpiry)
+    {
+        setHost(m_dnsCachedAddress);
+        return;
+    }
+
     m_lookupActive = true;
     Q_EMIT lookupActiveChanged();
-    QHostInfo::lookupHost(host.simplified(), this, &MQTT::Client::lookupFinished);
+    QHostInfo::lookupHost(name, this, &MQTT::Client::lookupFinished);
 }
 
 /**
@@ -546,52 +628,104 @@ void MQTT::Client::setMqttVersion(const int versionIndex)
 }
 
 /**
- * Publishes all the received data to the MQTT broker
+ * Changes the @a interval (in milliseconds) at which buffered frames are aggregated &
+ * published to the MQTT broker/server. The interval is clamped to a range from 10 ms
+ * to 5 seconds.
+ */
+void MQTT::Client::setPublishInterval(const int interval)
+{
+    m_publishTimer.setInterval(qBound(10, interval, 5000));
+    Q_EMIT publishIntervalChanged();
+}
+
+/**
+ * Enables/disables conflation of subscriber catch-up bursts, see
+ * @c subscriberConflation() for details on what conflation actually skips.
+ */
+void MQTT::Client::setSubscriberConflation(const bool enabled)
+{
+    m_subscriberConflation = enabled;
+    Q_EMIT subscriberConflationChanged();
+}
+
+/**
+ * Publishes all the received data to the MQTT broker. Frames accumulated since the
+ * last flush are sent as a single aggregated message, the message object is re-used
+ * & the payload buffer is handed over without copying the frame data again.
  */
 void MQTT::Client::sendData()
 {
     Q_ASSERT(m_client);
 
-    // Create data byte array
-    QByteArray data;
-    for (int i = 0; i < m_frames.count(); ++i)
-    {
-        data.append(m_frames.at(i));
-        data.append("\n");
-    }
-
-    // Create & send MQTT message
-    if (!data.isEmpty())
-    {
-        QMQTT::Message message(m_sentMessages, topic(), data);
-        m_client->publish(message);
-        ++m_sentMessages;
-    }
+    // Nothing to publish
+    if (m_payloadBuffer.isEmpty())
+        return;
 
-    // Clear frame list
-    m_frames.clear();
+    // Re-use the message object & hand the aggregated payload over to the client,
+    // the publish itself runs on the network thread (the message is implicitly
+    // shared, so the copy captured by the functor is cheap)
+    m_message.setId(m_sentMessages);
+    m_message.setTopic(topic());
+    m_message.setPayload(m_payloadBuffer);
+    const auto message = m_message;
+    QMetaObject::invokeMethod(
+        m_client, [this, message]() { m_client->publish(message); },
+        Qt::QueuedConnection);
+    ++m_sentMessages;
+
+    // Start the next batch with a block sized to the high-water mark, the block that
+    // was handed to the message stays alive until the next publish
+    const int capacity = qMax(m_payloadBuffer.capacity(), 4096);
+    m_payloadBuffer = QByteArray();
+    m_payloadBuffer.reserve(capacity);
 }
 
 /**
- * Clears the JSON frames & sets the sent messages to 0
+ * Clears the aggregated payload & sets the sent messages to 0
  */
 void MQTT::Client::resetStatistics()
 {
     m_sentMessages = 0;
-    m_frames.clear();
+    m_payloadBuffer.clear();
+    m_publishTimer.stop();
 }
 
 /**
  * Subscribe/unsubscripe to the set MQTT topic when the connection state is changed.
+ * The subscription request runs on the network thread, which also registers the
+ * active topic so that @c onMessageReceived() can filter messages without touching
+ * GUI-thread state.
  */
 void MQTT::Client::onConnectedChanged()
 {
     Q_ASSERT(m_client);
 
+    const auto currentTopic = topic();
     if (isConnectedToHost())
-        m_client->subscribe(topic());
+    {
+        QMetaObject::invokeMethod(
+            m_client,
+            [this, currentTopic]() {
+                m_activeTopic = currentTopic;
+                m_client->subscribe(currentTopic);
+            },
+            Qt::QueuedConnection);
+    }
+
     else
-        m_client->unsubscribe(topic());
+    {
+        QMetaObject::invokeMethod(
+            m_client,
+            [this, currentTopic]() {
+                m_activeTopic.clear();
+                m_client->unsubscribe(currentTopic);
+            },
+            Qt::QueuedConnection);
+
+        // Warm the DNS cache while the link is down, the reconnect is then not
+        // delayed by a resolver round trip
+        prefetchDns();
+    }
 }
 
 /**
@@ -608,7 +742,12 @@ void MQTT::Client::lookupFinished(const QHostInfo &info)
         auto addresses = info.addresses();
         if (addresses.count() >= 1)
         {
-            setHost(addresses.first().toString());
+            // Register the result in the DNS cache
+            m_dnsCachedHost = info.hostName();
+            m_dnsCachedAddress = addresses.first().toString();
+            m_dnsCacheExpiry = QDateTime::currentMSecsSinceEpoch() + DNS_CACHE_TTL;
+
+            setHost(m_dnsCachedAddress);
             return;
         }
     }
@@ -616,6 +755,34 @@ void MQTT::Client::lookupFinished(const QHostInfo &info)
     Misc::Utilities::showMessageBox(tr("IP address lookup error"), info.errorString());
 }
 
+/**
+ * Resolves the configured broker host in the background, so that the lookup
+ * performed by the socket on the next connection attempt is served from the
+ * resolver cache instead of costing a round trip. Called when the connection to
+ * the broker drops (which is exactly when a reconnect is most likely) & once
+ * shortly after startup by @c Misc::ModuleManager as a deferred warmup task.
+ */
+void MQTT::Client::prefetchDns()
+{
+    const auto name = host().simplified();
+    if (!name.isEmpty() && QHostAddress(name).isNull())
+        QHostInfo::lookupHost(name, this, &MQTT::Client::prefetchFinished);
+}
+
+/**
+ * Registers the result of a background DNS prefetch in the cache, lookup errors
+ * are ignored silently (the connection attempt will report them if they persist).
+ */
+void MQTT::Client::prefetchFinished(const QHostInfo &info)
+{
+    if (info.error() == QHostInfo::NoError && info.addresses().count() >= 1)
+    {
+        m_dnsCachedHost = info.hostName();
+        m_dnsCachedAddress = info.addresses().first().toString();
+        m_dnsCacheExpiry = QDateTime::currentMSecsSinceEpoch() + DNS_CACHE_TTL;
+    }
+}
+
 /**
  * Displays any MQTT-related error with a GUI message-box
  */
@@ -725,8 +892,8 @@ void MQTT::Client::onError(const QMQTT::ClientError error)
 }
 
 /**
- * Registers the given @a frame data to the list of frames that shall be published
- * to the MQTT broker/server
+ * Appends the given @a frame data to the aggregated payload that shall be published
+ * to the MQTT broker/server on the next flush.
  */
 void MQTT::Client::onFrameReceived(const QByteArray &frame)
 {
@@ -738,9 +905,21 @@ void MQTT::Client::onFrameReceived(const QByteArray &frame)
     else if (clientMode() != ClientPublisher)
         return;
 
-    // Validate frame & append it to frame list
+    // Validate frame & append it to the aggregated payload of the current batch
     if (!frame.isEmpty())
-        m_frames.append(frame);
+    {
+        m_payloadBuffer.append(frame);
+        m_payloadBuffer.append('\n');
+        Misc::MemoryRegistry::instance().report("MQTT::Client (publish batch)",
+                                                m_payloadBuffer.size());
+
+        // Flush right away when the batch grows too large, otherwise schedule a
+        // flush at the configured publish interval
+        if (m_payloadBuffer.size() >= 128 * 1024)
+            sendData();
+        else if (!m_publishTimer.isActive())
+            m_publishTimer.start();
+    }
 }
 
 /**
@@ -768,29 +947,86 @@ void MQTT::Client::onSslErrors(const QList<QSslError> &errors)
 }
 
 /**
- * Reads the given MQTT @a message and instructs the @c IO::Manager module to process
- * received data directly.
+ * Reads the given MQTT @a message & queues its frames for the GUI thread. This
+ * function runs directly on the network thread: the payload is filtered & split into
+ * frames there, so broker bursts (e.g. retained messages on reconnect) never block
+ * the interface. The lock-free queue is bounded, at worst a burst drops the oldest
+ * frames instead of freezing the application.
  */
 void MQTT::Client::onMessageReceived(const QMQTT::Message &message)
 {
     // Ignore if client mode is not set to suscriber
-    if (clientMode() != ClientSubscriber)
+    if (m_clientMode != ClientSubscriber)
         return;
 
-    // Get message data
-    auto mtopic = message.topic();
-    auto mpayld = message.payload();
+    // Ignore if topic is not equal to the subscribed topic
+    if (message.topic() != m_activeTopic)
+        return;
+
+    // Split the aggregated payload into frames & queue them for the GUI thread.
+    // The trailing newline is kept in the sliced frame, so the GUI thread can
+    // dispatch it without re-allocating to append the terminator back.
+    const auto payload = message.payload();
+    int begin = 0;
+    while (begin < payload.size())
+    {
+        int end = payload.indexOf('\n', begin);
+        if (end == -1)
+            end = payload.size();
 
-    // Ignore if topic is not equal to current topic
-    if (topic() != mtopic)
+        if (end > begin)
+            m_frameQueue.enqueue(
+                payload.mid(begin, qMin(end + 1, payload.size()) - begin));
+
+        begin = end + 1;
+    }
+
+    // Wake the GUI thread up so that it drains the queue
+    Q_EMIT framesQueued();
+}
+
+/**
+ * Drains the subscriber frame queue & hands the frames to the @c IO::Manager module
+ * as a single batch. This function is called through a queued connection whenever
+ * the network thread pushes a batch of frames, so it always runs on the GUI thread.
+ * Delivering the drained frames in one call lets the JSON generator parse a broker
+ * burst in a single event-loop pass (spread over the thread pool when large),
+ * instead of scheduling one full parse-render round per message.
+ */
+void MQTT::Client::onFramesQueued()
+{
+    // Drain the queue into one batch, the network thread enqueues the frames with
+    // their trailing newline so most of them need no further copies here
+    QByteArray frame;
+    QVector<QByteArray> batch;
+    while (m_frameQueue.dequeue(frame))
+    {
+        if (!frame.endsWith('\n'))
+            frame.append('\n');
+
+        batch.append(frame);
+    }
+
+    // Nothing queued, a previous drain already consumed the frames
+    if (batch.isEmpty())
         return;
 
-    // Add EOL character
-    if (!mpayld.endsWith('\n'))
-        mpayld.append('\n');
+    // Conflate catch-up bursts: after a broker outage the replay of queued and/or
+    // retained messages arrives in one large batch, but the dashboard only needs
+    // the newest frame of it. Forward the older frames without parsing them (the
+    // console, CSV export & plugins still receive every single one) and run the
+    // full parse-render round only for the last frame of the batch. The older
+    // frames travel as one batch so the UI is only notified once for them.
+    auto &manager = IO::Manager::instance();
+    if (m_subscriberConflation && batch.count() > CONFLATION_THRESHOLD)
+    {
+        manager.publishPayloadBatch(batch.mid(0, batch.count() - 1));
+        manager.processPayload(batch.constLast());
+    }
 
-    // Let IO manager process incoming data
-    IO::Manager::instance().processPayload(mpayld);
+    // Normal operation, publish the whole batch through the I/O manager
+    else
+        manager.processFrameBatch(batch);
 }
 
 /**
@@ -827,8 +1063,17 @@ void MQTT::Client::regenerateClient()
         disconnect(m_client, &QMQTT::Client::sslErrors, Q_NULLPTR, 0);
         disconnect(m_client, &QMQTT::Client::disconnected, Q_NULLPTR, 0);
 
-        m_client->disconnectFromHost();
-        delete m_client;
+        // If the old client was handed over to the network thread, tear it down from
+        // there. Otherwise it never connected & can be deleted from the GUI thread.
+        auto oldClient = m_client.data();
+        if (oldClient->thread() == &m_networkThread && m_networkThread.isRunning())
+        {
+            QMetaObject::invokeMethod(
+                oldClient, [oldClient]() { oldClient->disconnectFromHost(); },
+                Qt::QueuedConnection);
+        }
+
+        oldClient->deleteLater();
     }
 
     // Configure MQTT client depending on SSL/TLS configuration
@@ -837,8 +1082,27 @@ void MQTT::Client::regenerateClient()
     else
         m_client = new QMQTT::Client(QHostAddress(host), port);
 
-    // Set client ID
-    m_client->setClientId(qApp->applicationName());
+    // Use a stable per-installation client ID. Brokers identify persistent
+    // sessions by client ID, so it must survive restarts, yet not collide with
+    // other installations that talk to the same broker (the MQTT 3.1 limit of
+    // 23 characters leaves room for 8 random hex digits)
+    auto &settings = Misc::SettingsCache::instance();
+    auto clientId = settings.value("mqtt_client_id").toString();
+    if (clientId.isEmpty())
+    {
+        const quint32 suffix = QRandomGenerator::global()->generate();
+        clientId = QString("%1-%2").arg(qApp->applicationName(),
+                                        QString::number(suffix, 16));
+        settings.setValue("mqtt_client_id", clientId);
+    }
+    m_client->setClientId(clientId);
+
+    // Ask the broker to keep the session across reconnects: with a persistent
+    // session the broker restores the subscription & starts delivering queued
+    // QoS 1/2 messages right after CONNACK, so a reconnect restores the stream
+    // in a single round trip. The re-subscription sent by onConnectedChanged()
+    // is idempotent & does not delay the resumed stream.
+    m_client->setCleanSession(false);
 
     // Set MQTT client options
     m_client->setWillQos(qos);
@@ -849,14 +1113,15 @@ void MQTT::Client::regenerateClient()
     m_client->setKeepAlive(keepAlive);
     m_client->setPassword(password.toUtf8());
 
-    // Connect signals/slots
+    // Connect signals/slots, received messages are handled with a direct connection
+    // so that the payload filtering & frame splitting runs on the network thread
     // clang-format off
     connect(m_client, &QMQTT::Client::error,
             this, &MQTT::Client::onError);
     connect(m_client, &QMQTT::Client::sslErrors,
             this, &MQTT::Client::onSslErrors);
     connect(m_client, &QMQTT::Client::received,
-            this, &MQTT::Client::onMessageReceived);
+            this, &MQTT::Client::onMessageReceived, Qt::DirectConnection);
     connect(m_client, &QMQTT::Client::connected,
             this, &MQTT::Client::connectedChanged);
     connect(m_client, &QMQTT::Client::connected,
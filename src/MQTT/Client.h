@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <QTimer>
 #include <QObject>
+#include <QThread>
 #include <QHostInfo>
 #include <QByteArray>
 #include <QHostAddress>
@@ -31,6 +33,8 @@
 #include <qmqtt.h>
 #include <DataTypes.h>
 
+#include <IO/FrameQueue.h>
+
 namespace MQTT
 {
 /**
@@ -85,6 +89,10 @@ class Client : public QObject
                READ topic
                WRITE setTopic
                NOTIFY topicChanged)
+    Q_PROPERTY(int publishInterval
+               READ publishInterval
+               WRITE setPublishInterval
+               NOTIFY publishIntervalChanged)
     Q_PROPERTY(int mqttVersion
                READ mqttVersion
                WRITE setMqttVersion
@@ -109,6 +117,10 @@ class Client : public QObject
                READ sslProtocol
                WRITE setSslProtocol
                NOTIFY sslProtocolChanged)
+    Q_PROPERTY(bool subscriberConflation
+               READ subscriberConflation
+               WRITE setSubscriberConflation
+               NOTIFY subscriberConflationChanged)
     Q_PROPERTY(bool isConnectedToHost
                READ isConnectedToHost
                NOTIFY connectedChanged)
@@ -154,6 +166,9 @@ Q_SIGNALS:
     void sslProtocolChanged();
     void mqttVersionChanged();
     void lookupActiveChanged();
+    void publishIntervalChanged();
+    void subscriberConflationChanged();
+    void framesQueued();
 
 private:
     explicit Client();
@@ -180,6 +195,8 @@ public:
     QString password() const;
     quint16 keepAlive() const;
     bool lookupActive() const;
+    int publishInterval() const;
+    bool subscriberConflation() const;
     bool isSubscribed() const;
     bool isConnectedToHost() const;
 
@@ -211,12 +228,17 @@ public Q_SLOTS:
     void setPassword(const QString &password);
     void setKeepAlive(const quint16 keepAlive);
     void setMqttVersion(const int versionIndex);
+    void setPublishInterval(const int interval);
+    void setSubscriberConflation(const bool enabled);
+    void prefetchDns();
 
 private Q_SLOTS:
     void sendData();
+    void onFramesQueued();
     void resetStatistics();
     void onConnectedChanged();
     void lookupFinished(const QHostInfo &info);
+    void prefetchFinished(const QHostInfo &info);
     void onError(const QMQTT::ClientError error);
     void onFrameReceived(const QByteArray &frame);
     void onSslErrors(const QList<QSslError> &errors);
@@ -228,12 +250,21 @@ private:
 private:
     QString m_topic;
     bool m_sslEnabled;
+    bool m_subscriberConflation;
     int m_sslProtocol;
     bool m_lookupActive;
     QString m_caFilePath;
+    QString m_dnsCachedHost;
+    QString m_dnsCachedAddress;
+    qint64 m_dnsCacheExpiry;
     quint16 m_sentMessages;
     MQTTClientMode m_clientMode;
-    QVector<QByteArray> m_frames;
+    QTimer m_publishTimer;
+    QMQTT::Message m_message;
+    QByteArray m_payloadBuffer;
+    QThread m_networkThread;
+    QString m_activeTopic;
+    IO::FrameQueue m_frameQueue;
     QPointer<QMQTT::Client> m_client;
     QSslConfiguration m_sslConfiguration;
 };
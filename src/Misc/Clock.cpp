@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDateTime>
+
+#include <Misc/Clock.h>
+#include <Misc/TimerEvents.h>
+
+/**
+ * Constructor function, starts the monotonic timer, takes the initial
+ * wall-clock correlation & refreshes it at 1 Hz. A refresh only nudges the
+ * correlation offset, so a system clock adjustment is absorbed gradually
+ * instead of appearing as a jump in the middle of a log file.
+ */
+Misc::Clock::Clock()
+{
+    m_monotonic.start();
+    updateCorrelation();
+
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+            &Misc::Clock::updateCorrelation);
+}
+
+/**
+ * Returns the only instance of this class
+ */
+Misc::Clock &Misc::Clock::instance()
+{
+    static Clock singleton;
+    return singleton;
+}
+
+/**
+ * Returns the number of nanoseconds elapsed since the clock was created.
+ * Monotonic, never affected by system clock adjustments. Thread-safe, may be
+ * called from any thread.
+ */
+qint64 Misc::Clock::monotonicNsecs() const
+{
+    return m_monotonic.nsecsElapsed();
+}
+
+/**
+ * Returns the current time as milliseconds since the Unix epoch, derived from
+ * the monotonic timer & the cached wall-clock correlation. Thread-safe, may be
+ * called from any thread.
+ */
+qint64 Misc::Clock::currentMSecsSinceEpoch() const
+{
+    return m_monotonic.nsecsElapsed() / 1000000 + m_epochOffset.loadAcquire();
+}
+
+/**
+ * Re-reads the wall clock & stores the offset between it and the monotonic
+ * timer. Called at 1 Hz so that the derived timestamps track NTP adjustments
+ * without paying for a wall-clock read on every event.
+ */
+void Misc::Clock::updateCorrelation()
+{
+    const qint64 wall = QDateTime::currentMSecsSinceEpoch();
+    const qint64 mono = m_monotonic.nsecsElapsed() / 1000000;
+    m_epochOffset.storeRelease(wall - mono);
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Clock.cpp"
+#endif
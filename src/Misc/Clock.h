@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+
+namespace Misc
+{
+/**
+ * @brief The Clock class
+ *
+ * Shared timestamp source for the per-event hot paths (frame registration,
+ * console lines, capture records, plugin rate limits). The modules used to
+ * call @c QDateTime::currentMSecsSinceEpoch() on every event, which reads the
+ * wall clock: besides the per-call cost, wall-clock readings jump when the
+ * system clock is adjusted (NTP sync, manual change), producing out-of-order
+ * or duplicated timestamps in the CSV files & capture logs.
+ *
+ * The clock derives its timestamps from a monotonic timer instead, anchored
+ * to the wall clock through a correlation offset that is refreshed at 1 Hz.
+ * A timestamp therefore costs one monotonic timer read plus one atomic load,
+ * and consecutive timestamps never go backwards between refreshes. The
+ * epoch-milliseconds representation is kept so that the existing formatting
+ * & serialization code does not need to change.
+ */
+class Clock : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private:
+    explicit Clock();
+    Clock(Clock &&) = delete;
+    Clock(const Clock &) = delete;
+    Clock &operator=(Clock &&) = delete;
+    Clock &operator=(const Clock &) = delete;
+
+public:
+    static Clock &instance();
+
+    qint64 monotonicNsecs() const;
+    qint64 currentMSecsSinceEpoch() const;
+
+private Q_SLOTS:
+    void updateCorrelation();
+
+private:
+    QElapsedTimer m_monotonic;
+    QAtomicInteger<qint64> m_epochOffset;
+};
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include <Misc/TimerEvents.h>
+#include <Misc/LatencyTracer.h>
+
+/**
+ * Upper bound (in milliseconds) of every histogram bucket, the last bucket
+ * collects everything above the previous bound.
+ */
+static const int kBucketBoundsMs[] = { 1, 2, 5, 10, 20, 50, 100, 250 };
+static const int kBucketCount = sizeof(kBucketBoundsMs) / sizeof(kBucketBoundsMs[0]) + 1;
+
+/**
+ * Display names of the measured stages. The duration stored for each stamp
+ * point is the time elapsed since the previous stamp point, except for the
+ * ingest slot, which is re-used to accumulate the total arrival→display
+ * latency (the ingest stamp itself has no predecessor).
+ */
+static const char *StageName(const int stage)
+{
+    switch (stage)
+    {
+        case Misc::LatencyTracer::kParse:
+            return "ingest - parse";
+        case Misc::LatencyTracer::kDashboard:
+            return "parse - dashboard";
+        case Misc::LatencyTracer::kPaint:
+            return "dashboard - paint";
+        case Misc::LatencyTracer::kIngest:
+            return "total (e2e)";
+        default:
+            return "";
+    }
+}
+
+/**
+ * Constructor function, the tracer is disabled by default & the statistics rows
+ * are refreshed at 1 Hz (same cadence as the ingestion statistics of the I/O
+ * manager) to avoid re-generating the strings for every frame.
+ */
+Misc::LatencyTracer::LatencyTracer()
+    : m_enabled(false)
+    , m_statisticsChanged(false)
+    , m_stage(-1)
+{
+    m_clock.start();
+    resetStatistics();
+
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+            &Misc::LatencyTracer::updateStatistics);
+}
+
+/**
+ * Returns the only instance of this class
+ */
+Misc::LatencyTracer &Misc::LatencyTracer::instance()
+{
+    static LatencyTracer singleton;
+    return singleton;
+}
+
+/**
+ * Returns @c true if latency tracing is enabled
+ */
+bool Misc::LatencyTracer::enabled() const
+{
+    return m_enabled;
+}
+
+/**
+ * Returns the accumulated per-stage statistics as display-ready rows (two rows
+ * per stage: a summary with sample count, average & maximum, and the histogram
+ * bucket counts).
+ */
+StringList Misc::LatencyTracer::statistics() const
+{
+    StringList rows;
+    const int order[] = { kParse, kDashboard, kPaint, kIngest };
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); ++i)
+    {
+        const auto &histogram = m_histograms[order[i]];
+        if (histogram.count == 0)
+        {
+            rows.append(QString("%1: no samples").arg(StageName(order[i])));
+            continue;
+        }
+
+        // Summary row
+        const double avg = histogram.sumNsecs / 1e6 / histogram.count;
+        const double max = histogram.maxNsecs / 1e6;
+        rows.append(QString("%1: n=%2, avg %3 ms, max %4 ms")
+                        .arg(StageName(order[i]))
+                        .arg(histogram.count)
+                        .arg(avg, 0, 'f', 2)
+                        .arg(max, 0, 'f', 1));
+
+        // Histogram row
+        QString buckets;
+        for (int b = 0; b < kBucketCount; ++b)
+        {
+            if (b < kBucketCount - 1)
+                buckets += QString("<%1ms:%2 ")
+                               .arg(kBucketBoundsMs[b])
+                               .arg(histogram.buckets[b]);
+            else
+                buckets += QString(">=%1ms:%2")
+                               .arg(kBucketBoundsMs[b - 1])
+                               .arg(histogram.buckets[b]);
+        }
+
+        rows.append("   " + buckets);
+    }
+
+    return rows;
+}
+
+/**
+ * Returns the accumulated per-stage histograms as a compact JSON document, used
+ * by the plugin server to answer diagnostics queries from external tools.
+ */
+QString Misc::LatencyTracer::latencyJson() const
+{
+    // Histogram bucket upper bounds (shared by every stage)
+    QJsonArray bounds;
+    for (int b = 0; b < kBucketCount - 1; ++b)
+        bounds.append(kBucketBoundsMs[b]);
+
+    // One object per stage with summary figures & bucket counts
+    QJsonArray stages;
+    const int order[] = { kParse, kDashboard, kPaint, kIngest };
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); ++i)
+    {
+        const auto &histogram = m_histograms[order[i]];
+
+        QJsonObject stage;
+        stage.insert("stage", StageName(order[i]));
+        stage.insert("samples", qint64(histogram.count));
+        if (histogram.count > 0)
+        {
+            stage.insert("avg_ms", histogram.sumNsecs / 1e6 / histogram.count);
+            stage.insert("max_ms", histogram.maxNsecs / 1e6);
+        }
+
+        QJsonArray buckets;
+        for (int b = 0; b < kBucketCount; ++b)
+            buckets.append(qint64(histogram.buckets[b]));
+        stage.insert("histogram", buckets);
+
+        stages.append(stage);
+    }
+
+    QJsonObject document;
+    document.insert("enabled", m_enabled);
+    document.insert("bucket_bounds_ms", bounds);
+    document.insert("stages", stages);
+    return QString::fromUtf8(QJsonDocument(document).toJson(QJsonDocument::Compact));
+}
+
+/**
+ * Stamps the arrival of a frame on the GUI thread, called by @c IO::Manager
+ * just before the frame is handed to the JSON generator.
+ */
+void Misc::LatencyTracer::frameIngested()
+{
+    if (!m_enabled)
+        return;
+
+    m_stage = kIngest;
+    m_stamps[kIngest] = m_clock.nsecsElapsed();
+}
+
+/**
+ * Stamps the end of JSON parsing, called by @c JSON::Generator::readData()
+ * once the frame object has been (re)built.
+ */
+void Misc::LatencyTracer::frameParsed()
+{
+    if (!m_enabled)
+        return;
+
+    recordStage(kParse);
+}
+
+/**
+ * Stamps the end of the dashboard model rebuild, called by
+ * @c UI::Dashboard::processLatestFrame().
+ */
+void Misc::LatencyTracer::frameProcessed()
+{
+    if (!m_enabled)
+        return;
+
+    recordStage(kDashboard);
+}
+
+/**
+ * Stamps the first widget repaint after a dashboard update. Subsequent paints
+ * of the same frame (one per visible widget) are ignored, the state machine
+ * only advances once per traced frame.
+ */
+void Misc::LatencyTracer::framePainted()
+{
+    if (!m_enabled || m_stage != kDashboard)
+        return;
+
+    recordStage(kPaint);
+
+    // Also accumulate the total arrival→display latency, stored in the
+    // (otherwise unused) histogram slot of the ingest stamp
+    const qint64 nsecs = m_stamps[kPaint] - m_stamps[kIngest];
+    auto &histogram = m_histograms[kIngest];
+    ++histogram.count;
+    histogram.sumNsecs += nsecs;
+    histogram.maxNsecs = qMax(histogram.maxNsecs, nsecs);
+    for (int b = 0; b < kBucketCount; ++b)
+    {
+        if (b == kBucketCount - 1 || nsecs < kBucketBoundsMs[b] * qint64(1000000))
+        {
+            ++histogram.buckets[b];
+            break;
+        }
+    }
+
+    m_stage = -1;
+    m_statisticsChanged = true;
+}
+
+/**
+ * Enables/disables latency tracing, the accumulated statistics are kept when
+ * tracing is paused so that the operator can inspect them afterwards.
+ */
+void Misc::LatencyTracer::setEnabled(const bool enabled)
+{
+    m_enabled = enabled;
+    m_stage = -1;
+    Q_EMIT enabledChanged();
+}
+
+/**
+ * Discards the accumulated statistics
+ */
+void Misc::LatencyTracer::resetStatistics()
+{
+    for (int i = 0; i < kStageCount; ++i)
+    {
+        m_stamps[i] = 0;
+        m_histograms[i].count = 0;
+        m_histograms[i].sumNsecs = 0;
+        m_histograms[i].maxNsecs = 0;
+        m_histograms[i].buckets = QVector<quint64>(kBucketCount, 0);
+    }
+
+    m_stage = -1;
+    Q_EMIT statisticsChanged();
+}
+
+/**
+ * Notifies the QML interface once per second while new samples arrive, which
+ * keeps the cost of regenerating the statistics rows constant regardless of
+ * the frame rate.
+ */
+void Misc::LatencyTracer::updateStatistics()
+{
+    if (m_statisticsChanged)
+    {
+        m_statisticsChanged = false;
+        Q_EMIT statisticsChanged();
+    }
+}
+
+/**
+ * Accumulates the time elapsed since the previous stamp point into the
+ * histogram of the given @a stage. Out-of-order stamps (e.g. a CSV replay
+ * frame parsed without a matching ingestion stamp) are ignored.
+ */
+void Misc::LatencyTracer::recordStage(const int stage)
+{
+    if (m_stage != stage - 1)
+        return;
+
+    const qint64 now = m_clock.nsecsElapsed();
+    const qint64 nsecs = now - m_stamps[stage - 1];
+    m_stage = stage;
+    m_stamps[stage] = now;
+
+    auto &histogram = m_histograms[stage];
+    ++histogram.count;
+    histogram.sumNsecs += nsecs;
+    histogram.maxNsecs = qMax(histogram.maxNsecs, nsecs);
+    for (int b = 0; b < kBucketCount; ++b)
+    {
+        if (b == kBucketCount - 1 || nsecs < kBucketBoundsMs[b] * qint64(1000000))
+        {
+            ++histogram.buckets[b];
+            break;
+        }
+    }
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_LatencyTracer.cpp"
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+
+#include <DataTypes.h>
+
+namespace Misc
+{
+/**
+ * @brief The LatencyTracer class
+ *
+ * Opt-in instrumentation that measures the arrival→display latency of frames.
+ * When tracing is enabled, each frame is stamped at four points of the
+ * pipeline:
+ *
+ * - when @c IO::Manager delivers the frame to the GUI thread,
+ * - after @c JSON::Generator::readData() finishes parsing it,
+ * - after @c UI::Dashboard::processLatestFrame() rebuilds the widget models,
+ * - when the first dashboard widget paints the new data.
+ *
+ * The stage durations are accumulated into per-stage histograms, which can be
+ * inspected from the diagnostics pane to find out which stage (parse,
+ * dashboard rebuild or paint) is responsible for "laggy" dashboards under
+ * load. While tracing is disabled the instrumentation calls are reduced to a
+ * boolean check, so shipping them in release builds is free.
+ */
+class LatencyTracer : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(bool enabled
+               READ enabled
+               WRITE setEnabled
+               NOTIFY enabledChanged)
+    Q_PROPERTY(StringList statistics
+               READ statistics
+               NOTIFY statisticsChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void enabledChanged();
+    void statisticsChanged();
+
+private:
+    explicit LatencyTracer();
+    LatencyTracer(LatencyTracer &&) = delete;
+    LatencyTracer(const LatencyTracer &) = delete;
+    LatencyTracer &operator=(LatencyTracer &&) = delete;
+    LatencyTracer &operator=(const LatencyTracer &) = delete;
+
+public:
+    enum Stage
+    {
+        kIngest,
+        kParse,
+        kDashboard,
+        kPaint,
+        kStageCount
+    };
+    Q_ENUM(Stage)
+
+    static LatencyTracer &instance();
+
+    bool enabled() const;
+    StringList statistics() const;
+    Q_INVOKABLE QString latencyJson() const;
+
+    void frameIngested();
+    void frameParsed();
+    void frameProcessed();
+    void framePainted();
+
+public Q_SLOTS:
+    void setEnabled(const bool enabled);
+    void resetStatistics();
+
+private Q_SLOTS:
+    void updateStatistics();
+
+private:
+    void recordStage(const int stage);
+
+private:
+    struct Histogram
+    {
+        quint64 count;
+        qint64 sumNsecs;
+        qint64 maxNsecs;
+        QVector<quint64> buckets;
+    };
+
+    bool m_enabled;
+    bool m_statisticsChanged;
+
+    int m_stage;
+    QElapsedTimer m_clock;
+    qint64 m_stamps[kStageCount];
+    Histogram m_histograms[kStageCount];
+};
+}
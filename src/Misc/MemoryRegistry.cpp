@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include <Misc/TimerEvents.h>
+#include <Misc/MemoryRegistry.h>
+
+/**
+ * Formats the given byte count with a binary unit suffix
+ */
+static QString FormatBytes(const qint64 bytes)
+{
+    if (bytes >= 1024 * 1024)
+        return QString("%1 MB").arg(bytes / 1024.0 / 1024.0, 0, 'f', 1);
+    else if (bytes >= 1024)
+        return QString("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+
+    return QString("%1 B").arg(bytes);
+}
+
+/**
+ * Constructor function, the statistics rows are refreshed at 1 Hz (same cadence
+ * as the ingestion statistics of the I/O manager) to avoid regenerating the
+ * strings for every report.
+ */
+Misc::MemoryRegistry::MemoryRegistry()
+    : m_statisticsChanged(false)
+{
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+            &Misc::MemoryRegistry::updateStatistics);
+}
+
+/**
+ * Returns the only instance of this class
+ */
+Misc::MemoryRegistry &Misc::MemoryRegistry::instance()
+{
+    static MemoryRegistry singleton;
+    return singleton;
+}
+
+/**
+ * Updates the current size of the given @a buffer & tracks its peak value.
+ * Thread-safe, may be called from any thread.
+ */
+void Misc::MemoryRegistry::report(const QString &buffer, const qint64 bytes)
+{
+    QMutexLocker locker(&m_lock);
+    auto &entry = m_entries[buffer];
+    entry.current = bytes;
+    entry.peak = qMax(entry.peak, bytes);
+    m_statisticsChanged = true;
+}
+
+/**
+ * Returns the accounting figures as display-ready rows (one row per buffer with
+ * its current & peak size), sorted by buffer name.
+ */
+StringList Misc::MemoryRegistry::statistics() const
+{
+    QMutexLocker locker(&m_lock);
+
+    StringList rows;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+        rows.append(QString("%1: %2 (peak %3)")
+                        .arg(it.key())
+                        .arg(FormatBytes(it.value().current))
+                        .arg(FormatBytes(it.value().peak)));
+
+    return rows;
+}
+
+/**
+ * Returns the accounting figures as a compact JSON document, used by the plugin
+ * server to answer memory queries from external tools.
+ */
+QString Misc::MemoryRegistry::memoryJson() const
+{
+    QMutexLocker locker(&m_lock);
+
+    QJsonArray buffers;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+    {
+        QJsonObject buffer;
+        buffer.insert("name", it.key());
+        buffer.insert("current", it.value().current);
+        buffer.insert("peak", it.value().peak);
+        buffers.append(buffer);
+    }
+
+    QJsonObject document;
+    document.insert("buffers", buffers);
+    return QString::fromUtf8(QJsonDocument(document).toJson(QJsonDocument::Compact));
+}
+
+/**
+ * Resets the peak value of every buffer to its current size, useful to restart
+ * the accounting at the beginning of a soak test.
+ */
+void Misc::MemoryRegistry::resetPeaks()
+{
+    QMutexLocker locker(&m_lock);
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        it.value().peak = it.value().current;
+
+    m_statisticsChanged = true;
+}
+
+/**
+ * Notifies the QML interface once per second while new reports arrive, which
+ * keeps the cost of regenerating the statistics rows constant regardless of
+ * the report rate.
+ */
+void Misc::MemoryRegistry::updateStatistics()
+{
+    bool changed;
+    {
+        QMutexLocker locker(&m_lock);
+        changed = m_statisticsChanged;
+        m_statisticsChanged = false;
+    }
+
+    if (changed)
+        Q_EMIT statisticsChanged();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_MemoryRegistry.cpp"
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+
+#include <DataTypes.h>
+
+namespace Misc
+{
+/**
+ * @brief The MemoryRegistry class
+ *
+ * Lightweight accounting surface for the buffers of the data pipeline. Each
+ * subsystem reports the current size (in bytes) of its buffers through
+ * @c report(), the registry keeps the current & peak value of every buffer.
+ *
+ * The accumulated figures are shown in the diagnostics pane & can be queried
+ * by plugins through @c Plugins::Server, so that after a long soak test it is
+ * possible to tell which buffer grew instead of guessing from the process
+ * RSS. Reporting is thread-safe, buffers owned by worker threads (frame
+ * reader, CSV writer, MQTT client) report directly from their own thread.
+ */
+class MemoryRegistry : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(StringList statistics
+               READ statistics
+               NOTIFY statisticsChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void statisticsChanged();
+
+private:
+    explicit MemoryRegistry();
+    MemoryRegistry(MemoryRegistry &&) = delete;
+    MemoryRegistry(const MemoryRegistry &) = delete;
+    MemoryRegistry &operator=(MemoryRegistry &&) = delete;
+    MemoryRegistry &operator=(const MemoryRegistry &) = delete;
+
+public:
+    static MemoryRegistry &instance();
+
+    void report(const QString &buffer, const qint64 bytes);
+
+    StringList statistics() const;
+    Q_INVOKABLE QString memoryJson() const;
+
+public Q_SLOTS:
+    void resetPeaks();
+
+private Q_SLOTS:
+    void updateStatistics();
+
+private:
+    struct Entry
+    {
+        qint64 current;
+        qint64 peak;
+    };
+
+    bool m_statisticsChanged;
+    QMap<QString, Entry> m_entries;
+    mutable QMutex m_lock;
+};
+}
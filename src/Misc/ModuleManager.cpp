@@ -22,6 +22,7 @@
 
 #include <AppInfo.h>
 
+#include <CSV/ColumnarExport.h>
 #include <CSV/Export.h>
 #include <CSV/Player.h>
 
@@ -32,11 +33,20 @@
 #include <JSON/Generator.h>
 
 #include <IO/Manager.h>
+#include <IO/Capture.h>
 #include <IO/Console.h>
+#include <IO/Replay.h>
 #include <IO/DataSources/Serial.h>
 #include <IO/DataSources/Network.h>
+#include <IO/DataSources/Generator.h>
+#include <IO/DataSources/WebSocket.h>
+#include <IO/DataSources/Relay.h>
 
 #include <Misc/MacExtras.h>
+#include <Misc/LatencyTracer.h>
+#include <Misc/MemoryRegistry.h>
+#include <Misc/SessionSnapshot.h>
+#include <Misc/Watchdog.h>
 #include <Misc/Utilities.h>
 #include <Misc/Translator.h>
 #include <Misc/TimerEvents.h>
@@ -46,20 +56,51 @@
 #include <MQTT/Client.h>
 #include <Plugins/Server.h>
 
+#include <UI/Alarms.h>
 #include <UI/Dashboard.h>
+#include <UI/Statistics.h>
+#include <UI/HistoryStore.h>
+#include <UI/PaintProfiler.h>
 #include <UI/DashboardWidget.h>
+#include <UI/QuickPlot.h>
 #include <UI/Widgets/Terminal.h>
 
+#include <QDebug>
+#include <QTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
 #include <QQuickWindow>
 #include <QSimpleUpdater.h>
 
+/*
+ * Delay (in milliseconds) between the first paint of the main window & the deferred
+ * startup tasks. The heavy panes keep loading asynchronously after the window is
+ * shown, the delay keeps update checks & DNS warmup off the event loop until the
+ * interface has settled (see runDeferredStartupTasks()).
+ */
+static const int kDeferredTasksDelay = 2500;
+
 /**
  * Configures the application font, creates a splash screen and configures
  * application signals/slots to destroy singleton classes before the application
- * quits.
+ * quits. When @a headless is set, the splash screen & font setup are skipped
+ * entirely (see @c initializeHeadless()).
  */
-Misc::ModuleManager::ModuleManager()
+Misc::ModuleManager::ModuleManager(const bool headless)
+    : m_headless(headless)
 {
+    // Reference clock for the startup phase log (see registerStartupPhase())
+    m_startupTimer.start();
+
+    // Headless loggers have no user interface to dress up, only make sure that
+    // the modules are torn down in order before the application quits
+    if (m_headless)
+    {
+        connect(qApp, SIGNAL(aboutToQuit()), this, SLOT(onQuit()));
+        return;
+    }
+
     // Init translator (so that splash screen displays text in user's language)
     (void)Misc::Translator::instance();
 
@@ -103,6 +144,64 @@ Misc::ModuleManager::ModuleManager()
 
     // Stop modules when application is about to quit
     connect(engine(), SIGNAL(quit()), this, SLOT(onQuit()));
+
+    // Register time required to show the splash screen
+    registerStartupPhase("splash screen shown");
+}
+
+/**
+ * Records the monotonic time elapsed since application launch for the given startup
+ * @a phase & prints it to the console. The recorded phases can be displayed in the
+ * about dialog (see @c startupPhases()) or dumped as a JSON document (see
+ * @c startupTimingsJson()), which makes startup latency regressions visible when
+ * comparing releases.
+ */
+void Misc::ModuleManager::registerStartupPhase(const QString &phase)
+{
+    const qint64 msecs = m_startupTimer.elapsed();
+    m_startupPhaseNames.append(phase);
+    m_startupPhaseTimes.append(msecs);
+    Q_EMIT startupPhasesChanged();
+
+    qInfo().noquote() << QString("Startup: %1 ms -> %2").arg(msecs).arg(phase);
+}
+
+/**
+ * Returns a human-readable list with the recorded startup phases & the time (in
+ * milliseconds since application launch) at which each phase completed. Used by the
+ * about dialog to display a startup timing table.
+ */
+StringList Misc::ModuleManager::startupPhases() const
+{
+    StringList list;
+    for (int i = 0; i < m_startupPhaseNames.count(); ++i)
+        list.append(QString("%1 ms · %2")
+                        .arg(m_startupPhaseTimes.at(i), 5)
+                        .arg(m_startupPhaseNames.at(i)));
+
+    return list;
+}
+
+/**
+ * Returns a compact JSON document with the recorded startup phases, suitable for
+ * archiving the startup performance of a given build & diffing it across releases.
+ */
+QString Misc::ModuleManager::startupTimingsJson() const
+{
+    QJsonArray phases;
+    for (int i = 0; i < m_startupPhaseNames.count(); ++i)
+    {
+        QJsonObject phase;
+        phase.insert("phase", m_startupPhaseNames.at(i));
+        phase.insert("msecs", m_startupPhaseTimes.at(i));
+        phases.append(phase);
+    }
+
+    QJsonObject document;
+    document.insert("phases", phases);
+    document.insert("version", qApp->applicationVersion());
+    return QString::fromUtf8(
+        QJsonDocument(document).toJson(QJsonDocument::Compact));
 }
 
 /**
@@ -139,6 +238,13 @@ void Misc::ModuleManager::registerQmlTypes()
 {
     qmlRegisterType<Widgets::Terminal>("SerialStudio", 1, 0, "Terminal");
     qmlRegisterType<UI::DashboardWidget>("SerialStudio", 1, 0, "DashboardWidget");
+    qmlRegisterType<UI::QuickPlot>("SerialStudio", 1, 0, "QuickPlot");
+
+    // Expose the WidgetType enum to QML, the dashboard itself is accessed
+    // through the Cpp_UI_Dashboard context property
+    qmlRegisterUncreatableType<UI::Dashboard>("SerialStudio", 1, 0, "Dashboard",
+                                              "Use the Cpp_UI_Dashboard context "
+                                              "property instead");
 }
 
 /**
@@ -157,20 +263,71 @@ bool Misc::ModuleManager::autoUpdaterEnabled()
 #endif
 }
 
+/**
+ * Initializes only the data pipeline modules for logging-only deployments: I/O
+ * manager & data sources, JSON generator, CSV export, MQTT client & the plugin
+ * bridge. No QML scene is ever loaded and none of the dashboard/widget classes
+ * are instantiated, which keeps both the memory footprint & the idle CPU usage
+ * of a headless logger at a small fraction of the full application.
+ *
+ * The TCP plugin bridge is force-enabled since the socket is the only way to
+ * monitor & control a headless instance (the enable flag is not persisted, so
+ * this does not change the behavior of later interactive sessions).
+ */
+void Misc::ModuleManager::initializeHeadless()
+{
+    // Construct the pipeline modules, the console & dashboard models are left
+    // out on purpose: nothing subscribes to them in a headless session, so the
+    // frames skip their processing entirely
+    (void)CSV::Export::instance();
+    (void)CSV::Player::instance();
+    (void)CSV::ColumnarExport::instance();
+    (void)IO::Manager::instance();
+    (void)IO::Capture::instance();
+    (void)IO::Replay::instance();
+    (void)JSON::Generator::instance();
+    (void)MQTT::Client::instance();
+    (void)IO::DataSources::Serial::instance();
+    (void)IO::DataSources::Network::instance();
+    (void)IO::DataSources::Generator::instance();
+    (void)IO::DataSources::WebSocket::instance();
+    (void)IO::DataSources::Relay::instance();
+
+    // Register time required to construct the C++ modules
+    registerStartupPhase("headless pipeline initialized");
+
+    // Start common event timers
+    Misc::TimerEvents::instance().startTimers();
+
+    // Listen for plugin/bridge connections, the socket is the control channel
+    // of a headless instance
+    Plugins::Server::instance().setEnabled(true);
+}
+
 /**
  * Initializes all the application modules, registers them with the QML engine and loads
  * the "main.qml" file as the root QML file.
  */
 void Misc::ModuleManager::initializeQmlInterface()
 {
-    // Initialize modules
+    // Initialize modules, all the instances need to exist before loading main.qml
+    // because they are registered as QML context properties. Constructors must stay
+    // cheap: modules that own worker threads, sockets or disk state initialize them
+    // lazily on first use so that they do not delay the first paint of the UI.
     auto csvExport = &CSV::Export::instance();
     auto csvPlayer = &CSV::Player::instance();
+    auto csvColumnarExport = &CSV::ColumnarExport::instance();
     auto ioManager = &IO::Manager::instance();
+    auto ioCapture = &IO::Capture::instance();
+    auto ioReplay = &IO::Replay::instance();
     auto ioConsole = &IO::Console::instance();
     auto jsonEditor = &JSON::Editor::instance();
     auto mqttClient = &MQTT::Client::instance();
+    auto uiAlarms = &UI::Alarms::instance();
     auto uiDashboard = &UI::Dashboard::instance();
+    auto uiHistoryStore = &UI::HistoryStore::instance();
+    auto uiStatistics = &UI::Statistics::instance();
+    auto uiPaintProfiler = &UI::PaintProfiler::instance();
     auto jsonGenerator = &JSON::Generator::instance();
     auto pluginsBridge = &Plugins::Server::instance();
     auto miscUtilities = &Misc::Utilities::instance();
@@ -180,6 +337,13 @@ void Misc::ModuleManager::initializeQmlInterface()
     auto miscTimerEvents = &Misc::TimerEvents::instance();
     auto ioNetwork = &IO::DataSources::Network::instance();
     auto miscThemeManager = &Misc::ThemeManager::instance();
+    auto miscLatencyTracer = &Misc::LatencyTracer::instance();
+    auto miscMemoryRegistry = &Misc::MemoryRegistry::instance();
+    auto miscWatchdog = &Misc::Watchdog::instance();
+    auto miscSessionSnapshot = &Misc::SessionSnapshot::instance();
+    auto ioGenerator = &IO::DataSources::Generator::instance();
+    auto ioWebSocket = &IO::DataSources::WebSocket::instance();
+    auto ioRelay = &IO::DataSources::Relay::instance();
 
     // Initialize third-party modules
     auto updater = QSimpleUpdater::getInstance();
@@ -203,6 +367,14 @@ void Misc::ModuleManager::initializeQmlInterface()
     const bool qt6 = true;
 #endif
 
+    // Register time required to construct the C++ modules
+    registerStartupPhase("singletons constructed");
+
+    // Restore the plot buffers, history tail & console ring of the previous
+    // session before live data can arrive
+    miscSessionSnapshot->restore();
+    registerStartupPhase("session snapshot restored");
+
     // Start common event timers
     miscTimerEvents->startTimers();
 
@@ -219,12 +391,22 @@ void Misc::ModuleManager::initializeQmlInterface()
     c->setContextProperty("Cpp_IO_Serial", ioSerial);
     c->setContextProperty("Cpp_CSV_Export", csvExport);
     c->setContextProperty("Cpp_CSV_Player", csvPlayer);
+    c->setContextProperty("Cpp_CSV_ColumnarExport", csvColumnarExport);
     c->setContextProperty("Cpp_IO_Console", ioConsole);
+    c->setContextProperty("Cpp_IO_Capture", ioCapture);
     c->setContextProperty("Cpp_IO_Manager", ioManager);
+    c->setContextProperty("Cpp_IO_Replay", ioReplay);
     c->setContextProperty("Cpp_IO_Network", ioNetwork);
+    c->setContextProperty("Cpp_IO_Generator", ioGenerator);
+    c->setContextProperty("Cpp_IO_WebSocket", ioWebSocket);
+    c->setContextProperty("Cpp_IO_Relay", ioRelay);
     c->setContextProperty("Cpp_JSON_Editor", jsonEditor);
     c->setContextProperty("Cpp_MQTT_Client", mqttClient);
+    c->setContextProperty("Cpp_UI_Alarms", uiAlarms);
     c->setContextProperty("Cpp_UI_Dashboard", uiDashboard);
+    c->setContextProperty("Cpp_UI_HistoryStore", uiHistoryStore);
+    c->setContextProperty("Cpp_UI_Statistics", uiStatistics);
+    c->setContextProperty("Cpp_UI_PaintProfiler", uiPaintProfiler);
     c->setContextProperty("Cpp_JSON_Generator", jsonGenerator);
     c->setContextProperty("Cpp_Plugins_Bridge", pluginsBridge);
     c->setContextProperty("Cpp_Misc_MacExtras", miscMacExtras);
@@ -232,6 +414,9 @@ void Misc::ModuleManager::initializeQmlInterface()
     c->setContextProperty("Cpp_ThemeManager", miscThemeManager);
     c->setContextProperty("Cpp_Misc_Translator", miscTranslator);
     c->setContextProperty("Cpp_Misc_TimerEvents", miscTimerEvents);
+    c->setContextProperty("Cpp_Misc_LatencyTracer", miscLatencyTracer);
+    c->setContextProperty("Cpp_Misc_MemoryRegistry", miscMemoryRegistry);
+    c->setContextProperty("Cpp_Misc_Watchdog", miscWatchdog);
     c->setContextProperty("Cpp_UpdaterEnabled", autoUpdaterEnabled());
     c->setContextProperty("Cpp_ModuleManager", this);
 
@@ -245,6 +430,14 @@ void Misc::ModuleManager::initializeQmlInterface()
     // Load main.qml
     engine()->load(QUrl(QStringLiteral("qrc:/qml/main.qml")));
     qApp->processEvents();
+
+    // Register time required to load the QML interface, the heavy panes keep
+    // loading asynchronously after this point (see MainWindow.qml)
+    registerStartupPhase("QML engine loaded");
+
+    // Start the event-loop stall detector once the interface is up, stalls
+    // during startup are expected & would only pollute the statistics
+    Misc::Watchdog::instance().setEnabled(true);
 }
 
 /**
@@ -255,6 +448,36 @@ void Misc::ModuleManager::hideSplashscreen()
     m_splash.hide();
     m_splash.close();
     qApp->processEvents();
+
+    // The main window is responsible for hiding the splash screen once it has been
+    // created, so this is the closest approximation to "first frame painted"
+    registerStartupPhase("main window shown");
+
+    // Schedule the non-essential network tasks once the event loop has gone quiet,
+    // startup must finish even when the network is unreachable
+    QTimer::singleShot(kDeferredTasksDelay, this,
+                       &Misc::ModuleManager::runDeferredStartupTasks);
+}
+
+/**
+ * Runs the startup tasks that need network access & are not required to get the
+ * interface on screen: configuring the auto-updater (the update check itself is
+ * triggered from QML through @c deferredStartupTasksRequested()) and warming the
+ * DNS cache of the MQTT module. The tasks run @c kDeferredTasksDelay milliseconds
+ * after the first paint of the main window, so an offline or slow network can
+ * never stall the startup path.
+ */
+void Misc::ModuleManager::runDeferredStartupTasks()
+{
+    // Configure the auto-updater & let the QML side run the update check
+    configureUpdater();
+    Q_EMIT deferredStartupTasksRequested();
+
+    // Resolve the configured MQTT broker hostname ahead of time
+    MQTT::Client::instance().prefetchDns();
+
+    // Register time at which the deferred tasks ran
+    registerStartupPhase("deferred startup tasks");
 }
 
 /**
@@ -262,8 +485,15 @@ void Misc::ModuleManager::hideSplashscreen()
  */
 void Misc::ModuleManager::onQuit()
 {
+    // Preserve the session state for the next startup, headless sessions do
+    // not construct the console/dashboard models the snapshot serializes
+    if (!m_headless)
+        Misc::SessionSnapshot::instance().writeFinalSnapshot();
+
     CSV::Export::instance().closeFile();
     CSV::Player::instance().closeFile();
+    IO::Capture::instance().closeFile();
+    IO::Replay::instance().stopReplay();
     IO::Manager::instance().disconnectDevice();
     Misc::TimerEvents::instance().stopTimers();
     Plugins::Server::instance().removeConnection();
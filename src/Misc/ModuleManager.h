@@ -24,6 +24,7 @@
 
 #include <QObject>
 #include <QSplashScreen>
+#include <QElapsedTimer>
 #include <QQmlApplicationEngine>
 
 #include <DataTypes.h>
@@ -41,22 +42,45 @@ namespace Misc
  */
 class ModuleManager : public QObject
 {
+    // clang-format off
     Q_OBJECT
+    Q_PROPERTY(StringList startupPhases
+               READ startupPhases
+               NOTIFY startupPhasesChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void startupPhasesChanged();
+    void deferredStartupTasksRequested();
 
 public:
-    ModuleManager();
+    ModuleManager(const bool headless = false);
     void configureUpdater();
     void registerQmlTypes();
     bool autoUpdaterEnabled();
+    void initializeHeadless();
     void initializeQmlInterface();
     QQmlApplicationEngine *engine();
 
+    StringList startupPhases() const;
+    Q_INVOKABLE QString startupTimingsJson() const;
+
 public Q_SLOTS:
     void onQuit();
     void hideSplashscreen();
 
+private Q_SLOTS:
+    void runDeferredStartupTasks();
+
+private:
+    void registerStartupPhase(const QString &phase);
+
 private:
+    bool m_headless;
     QSplashScreen m_splash;
+    QElapsedTimer m_startupTimer;
     QQmlApplicationEngine m_engine;
+    StringList m_startupPhaseNames;
+    QVector<qint64> m_startupPhaseTimes;
 };
 }
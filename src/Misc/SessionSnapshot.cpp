@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QStandardPaths>
+
+#include <IO/Console.h>
+#include <IO/Manager.h>
+#include <UI/Dashboard.h>
+#include <UI/HistoryStore.h>
+#include <Misc/TimerEvents.h>
+#include <Misc/SessionSnapshot.h>
+
+/**
+ * Magic number & format version at the start of every snapshot file, a
+ * snapshot written by a different version of the format is silently ignored
+ * at startup
+ */
+static const quint32 kSnapshotMagic = 0x53534e50; // "SSNP"
+static const quint16 kSnapshotVersion = 1;
+
+/**
+ * Interval (in seconds) between two snapshot writes while a device is
+ * connected
+ */
+static const int kSnapshotIntervalSecs = 5;
+
+/**
+ * Maximum number of history rows per dataset stored in the snapshot, the
+ * cap bounds both the serialization cost per write & the snapshot file size
+ * (the full history keeps going to the history store & its spill segments)
+ */
+static const int kSnapshotHistoryRows = 20000;
+
+//----------------------------------------------------------------------------------------
+// Background snapshot writer
+//----------------------------------------------------------------------------------------
+
+/**
+ * Writes the given snapshot @a blob to a temporary file next to @a path &
+ * atomically renames it over the previous snapshot, so that the snapshot on
+ * disk is always a complete one.
+ */
+void Misc::SnapshotWriter::writeSnapshot(const QString &path,
+                                         const QByteArray &blob)
+{
+    // Create the snapshot directory
+    const QString directory = QFileInfo(path).absolutePath();
+    if (!QDir().mkpath(directory))
+        return;
+
+    // Write the blob into a temporary file
+    QFile file(path + ".tmp");
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    if (file.write(blob) != blob.size())
+    {
+        file.close();
+        file.remove();
+        return;
+    }
+
+    // Replace the previous snapshot in one step
+    file.close();
+    QFile::remove(path);
+    file.rename(path);
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor/deconstructor & singleton access functions
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, computes the snapshot path & subscribes to the
+ * 1 Hz timer that drives the periodic writes. The writer thread is started
+ * lazily on the first capture so that the constructor stays cheap.
+ */
+Misc::SessionSnapshot::SessionSnapshot()
+    : m_secondsSinceWrite(0)
+    , m_writer(Q_NULLPTR)
+{
+    m_path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+             + "/session.snapshot";
+
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
+            this, &Misc::SessionSnapshot::onTimeout1Hz);
+}
+
+/**
+ * Destructor function, stops the writer thread
+ */
+Misc::SessionSnapshot::~SessionSnapshot()
+{
+    if (m_writer)
+    {
+        m_writerThread.quit();
+        m_writerThread.wait();
+    }
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::SessionSnapshot &Misc::SessionSnapshot::instance()
+{
+    static SessionSnapshot singleton;
+    return singleton;
+}
+
+/**
+ * Returns the path of the snapshot file
+ */
+QString Misc::SessionSnapshot::snapshotPath() const
+{
+    return m_path;
+}
+
+//----------------------------------------------------------------------------------------
+// Snapshot restore & capture
+//----------------------------------------------------------------------------------------
+
+/**
+ * Restores the state of the previous session from the snapshot file, called
+ * once at startup before any live data arrives. The file is memory-mapped &
+ * each module deserializes its own section directly from the mapping, so the
+ * restore only costs page-ins for the data actually read.
+ *
+ * A missing, truncated or incompatible snapshot is silently ignored, the
+ * application then starts cold exactly as before.
+ */
+void Misc::SessionSnapshot::restore()
+{
+    // Map the snapshot file
+    QFile file(m_path);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly))
+        return;
+    const uchar *data = file.map(0, file.size());
+    if (!data)
+        return;
+
+    // Wrap the mapping without copying it
+    const QByteArray blob = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(data), int(file.size()));
+    QDataStream in(blob);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    // Validate the header
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (in.status() == QDataStream::Ok && magic == kSnapshotMagic
+        && version == kSnapshotVersion)
+    {
+        // Deserialize the module sections in write order, each section
+        // validates its own data & leaves the module untouched on mismatch
+        IO::Console::instance().restoreSnapshot(in);
+        UI::HistoryStore::instance().restoreSnapshot(in);
+        UI::Dashboard::instance().restoreSnapshot(in);
+    }
+
+    // Release the mapping
+    file.unmap(const_cast<uchar *>(data));
+    file.close();
+}
+
+/**
+ * Captures a final snapshot synchronously, called when the application quits
+ * so that a clean shutdown preserves the session as well as a crash would.
+ * Nothing is written when the session holds no data, so quitting an idle
+ * instance cannot overwrite the snapshot of an earlier session.
+ */
+void Misc::SessionSnapshot::writeFinalSnapshot()
+{
+    if (!IO::Console::instance().saveAvailable()
+        && UI::HistoryStore::instance().sampleCount() == 0)
+        return;
+
+    SnapshotWriter writer;
+    writer.writeSnapshot(m_path, captureSnapshot());
+}
+
+/**
+ * Periodic capture tick, serializes the session state & queues the disk
+ * write on the background thread once every @c kSnapshotIntervalSecs seconds
+ * while a device is connected.
+ */
+void Misc::SessionSnapshot::onTimeout1Hz()
+{
+    if (!IO::Manager::instance().connected())
+        return;
+
+    if (++m_secondsSinceWrite < kSnapshotIntervalSecs)
+        return;
+
+    m_secondsSinceWrite = 0;
+    startWriterThread();
+    Q_EMIT writeRequested(m_path, captureSnapshot());
+}
+
+/**
+ * Serializes the snapshot sections into a single blob: format header,
+ * console text ring, history store tail & dashboard plot buffers
+ */
+QByteArray Misc::SessionSnapshot::captureSnapshot() const
+{
+    QByteArray blob;
+    QDataStream out(&blob, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_9);
+
+    out << kSnapshotMagic;
+    out << kSnapshotVersion;
+    IO::Console::instance().serializeSnapshot(out);
+    UI::HistoryStore::instance().serializeSnapshot(out, kSnapshotHistoryRows);
+    UI::Dashboard::instance().serializeSnapshot(out);
+
+    return blob;
+}
+
+/**
+ * Creates the snapshot writer & moves it to its own thread on the first
+ * capture, disk latency must never stall the UI thread
+ */
+void Misc::SessionSnapshot::startWriterThread()
+{
+    if (m_writer)
+        return;
+
+    m_writer = new SnapshotWriter;
+    m_writer->moveToThread(&m_writerThread);
+    // clang-format off
+    connect(&m_writerThread, &QThread::finished, m_writer, &QObject::deleteLater);
+    connect(this, &Misc::SessionSnapshot::writeRequested,
+            m_writer, &Misc::SnapshotWriter::writeSnapshot, Qt::QueuedConnection);
+    // clang-format on
+    m_writerThread.start(QThread::LowPriority);
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_SessionSnapshot.cpp"
+#endif
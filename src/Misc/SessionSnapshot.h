@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QThread>
+
+namespace Misc
+{
+/**
+ * @brief The SnapshotWriter class
+ *
+ * Worker object that writes session snapshot blobs to disk from a dedicated
+ * thread. The blob is written to a temporary file first & atomically renamed
+ * over the previous snapshot, so a crash in the middle of a write can never
+ * corrupt the last good snapshot.
+ */
+class SnapshotWriter : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+public Q_SLOTS:
+    void writeSnapshot(const QString &path, const QByteArray &blob);
+};
+
+/**
+ * @brief The SessionSnapshot class
+ *
+ * Periodic binary dump of the volatile session state, so that a crash or a
+ * restart in the middle of a measurement campaign does not cost minutes of
+ * live data to re-accumulate: the dashboard plot buffers, the tail of the
+ * history store & the console text ring are restored at the next startup.
+ *
+ * While a device is connected, the state is serialized once every few
+ * seconds on the UI thread (a bounded copy, the history tail is capped) &
+ * handed to @c Misc::SnapshotWriter, which performs the disk write on a
+ * background thread. On startup the snapshot file is memory-mapped & each
+ * module deserializes its own section, so the dashboard shows the pre-restart
+ * history as soon as the first live frame defines the widget layout.
+ *
+ * Device & connection settings are not part of the snapshot, they already
+ * persist through @c QSettings in the data source modules.
+ */
+class SessionSnapshot : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void writeRequested(const QString &path, const QByteArray &blob);
+
+private:
+    explicit SessionSnapshot();
+    ~SessionSnapshot();
+    SessionSnapshot(SessionSnapshot &&) = delete;
+    SessionSnapshot(const SessionSnapshot &) = delete;
+    SessionSnapshot &operator=(SessionSnapshot &&) = delete;
+    SessionSnapshot &operator=(const SessionSnapshot &) = delete;
+
+public:
+    static SessionSnapshot &instance();
+
+    QString snapshotPath() const;
+
+public Q_SLOTS:
+    void restore();
+    void writeFinalSnapshot();
+
+private Q_SLOTS:
+    void onTimeout1Hz();
+
+private:
+    QByteArray captureSnapshot() const;
+    void startWriterThread();
+
+private:
+    int m_secondsSinceWrite;
+
+    QString m_path;
+    SnapshotWriter *m_writer;
+    QThread m_writerThread;
+};
+}
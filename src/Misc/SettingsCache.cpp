@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QCoreApplication>
+
+#include <Misc/SettingsCache.h>
+
+/**
+ * Quiet period (in milliseconds) after the last @c setValue() call before the
+ * accumulated changes are written to the platform settings backend.
+ */
+static const int FLUSH_QUIET_PERIOD = 1000;
+
+/**
+ * Constructor function, configures the quiet-period timer & registers the
+ * exit flush so that no change is ever lost when the user closes the app
+ * before the timer expires.
+ */
+Misc::SettingsCache::SettingsCache()
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(FLUSH_QUIET_PERIOD);
+    connect(&m_flushTimer, &QTimer::timeout, this, &Misc::SettingsCache::flush);
+
+    connect(qApp, &QCoreApplication::aboutToQuit, this,
+            &Misc::SettingsCache::flush);
+}
+
+/**
+ * Destructor function, writes any changes that are still pending
+ */
+Misc::SettingsCache::~SettingsCache()
+{
+    flush();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+Misc::SettingsCache &Misc::SettingsCache::instance()
+{
+    static SettingsCache singleton;
+    return singleton;
+}
+
+/**
+ * Returns the current value of the given @a key, or @a defaultValue when the
+ * key has never been written. Pending (not yet flushed) changes are visible
+ * immediately, so readers always observe the latest written value.
+ */
+QVariant Misc::SettingsCache::value(const QString &key,
+                                    const QVariant &defaultValue)
+{
+    const auto it = m_pending.constFind(key);
+    if (it != m_pending.constEnd())
+        return it.value();
+
+    return m_settings.value(key, defaultValue);
+}
+
+/**
+ * Writes the accumulated changes to the platform settings backend in a single
+ * batch. Called automatically after the quiet period & when the app exits.
+ */
+void Misc::SettingsCache::flush()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    for (auto it = m_pending.constBegin(); it != m_pending.constEnd(); ++it)
+        m_settings.setValue(it.key(), it.value());
+
+    m_pending.clear();
+    m_settings.sync();
+}
+
+/**
+ * Registers a change to the given @a key. The change is only stored in memory
+ * & the quiet-period timer is re-armed, the platform backend is not touched
+ * until the user stops changing settings for a moment.
+ */
+void Misc::SettingsCache::setValue(const QString &key, const QVariant &value)
+{
+    m_pending.insert(key, value);
+    m_flushTimer.start();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_SettingsCache.cpp"
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QTimer>
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QSettings>
+
+namespace Misc
+{
+/**
+ * @brief The SettingsCache class
+ *
+ * Write-behind cache over @c QSettings, shared by all the application modules.
+ * Writing a setting through @c QSettings hits the platform backend (registry,
+ * plist or INI flush) synchronously, which is visible as a UI micro-stall on
+ * systems where the backend is instrumented (e.g. antivirus-hooked registries).
+ * Some setters fire on every UI interaction, so those stalls pile up.
+ *
+ * @c setValue() only updates an in-memory map & (re)arms a quiet-period timer,
+ * the accumulated changes are written to the backend in one batch once the
+ * user stops changing things, and unconditionally when the application exits.
+ * @c value() consults the pending map first so that readers always observe the
+ * latest written value.
+ */
+class SettingsCache : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private:
+    explicit SettingsCache();
+    SettingsCache(SettingsCache &&) = delete;
+    SettingsCache(const SettingsCache &) = delete;
+    SettingsCache &operator=(SettingsCache &&) = delete;
+    SettingsCache &operator=(const SettingsCache &) = delete;
+
+    ~SettingsCache();
+
+public:
+    static SettingsCache &instance();
+
+    QVariant value(const QString &key, const QVariant &defaultValue = QVariant());
+
+public Q_SLOTS:
+    void flush();
+    void setValue(const QString &key, const QVariant &value);
+
+private:
+    QTimer m_flushTimer;
+    QSettings m_settings;
+    QHash<QString, QVariant> m_pending;
+};
+}
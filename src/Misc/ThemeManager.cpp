@@ -22,30 +22,43 @@
 
 #include <QDir>
 #include <QFile>
+#include <QTimer>
 #include <QPalette>
 #include <QProcess>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QDataStream>
 #include <QApplication>
 #include <QJsonDocument>
 
 #include <AppInfo.h>
-#include <Misc/Utilities.h>
 #include <Misc/ThemeManager.h>
+#include <Misc/SettingsCache.h>
 
 /**
- * Constructor function, searches for available themes & loads
- * the theme variant selected by the user.
+ * Constructor function, loads the theme variant selected by the user.
+ *
+ * Only the path list is generated here, the selected theme must be parsed &
+ * applied before the first QML bindings are evaluated. Reading the display name
+ * of every bundled theme is only required by the theme selector combobox, so the
+ * full scan is deferred until the event loop is running (see @c populateThemes()).
  */
 Misc::ThemeManager::ThemeManager()
 {
-    populateThemes();
-    loadTheme(m_settings.value("themeId", 0).toInt());
+    m_themeId = -1;
+    auto themeList = QDir(":/themes").entryList();
+    for (int i = 0; i < themeList.count(); ++i)
+        m_availableThemesPaths.append(QString(":/themes/%1").arg(themeList.at(i)));
+
+    loadTheme(Misc::SettingsCache::instance().value("themeId", 0).toInt());
+    QTimer::singleShot(0, this, &Misc::ThemeManager::populateThemes);
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
-    setCustomWindowDecorations(m_settings.value("customWindows", false).toBool());
+    setCustomWindowDecorations(
+        Misc::SettingsCache::instance().value("customWindows", false).toBool());
 #else
-    setCustomWindowDecorations(m_settings.value("customWindows", true).toBool());
+    setCustomWindowDecorations(
+        Misc::SettingsCache::instance().value("customWindows", true).toBool());
 #endif
 }
 
@@ -77,36 +90,20 @@ bool Misc::ThemeManager::customWindowDecorations() const
 }
 
 /**
- * Updates the theme ID to be used & saves the changes to the
- * application settings.
- *
- * Finally, this function prompts the user to restart the application
- * in order to apply changes.
- *
- * Unfortunately, an app restart is required because the application
- * palette must be set before the GUI is initialized.
+ * Updates the theme ID to be used, saves the changes to the application settings &
+ * applies the new theme in place. The color properties notify through
+ * @c themeChanged(), so the QML bindings re-evaluate and only the items whose
+ * resolved color actually changed between the two themes schedule a repaint.
  */
 void Misc::ThemeManager::setTheme(const int id)
 {
-    // Validate theme ID
-    if (id >= m_availableThemesPaths.count())
+    // Validate theme ID & ignore no-op requests
+    if (id == m_themeId || id >= m_availableThemesPaths.count())
         return;
 
-    // Save settings for next run
-    m_themeId = id;
-    m_settings.setValue("themeId", m_themeId);
-
-    // Ask user to quit application
-    // clang-format off
-    auto ans = Utilities::showMessageBox(
-                tr("The theme change will take effect after restart"),
-                tr("Do you want to restart %1 now?").arg(APP_NAME), APP_NAME,
-                QMessageBox::Yes | QMessageBox::No);
-    // clang-format on
-
-    // Restart application
-    if (ans == QMessageBox::Yes)
-        Utilities::rebootApplication();
+    // Save settings for next run & apply the theme in place
+    Misc::SettingsCache::instance().setValue("themeId", id);
+    loadTheme(id);
 }
 
 /**
@@ -116,14 +113,18 @@ void Misc::ThemeManager::setTheme(const int id)
 void Misc::ThemeManager::setCustomWindowDecorations(const bool enabled)
 {
     m_customWindowDecorations = enabled;
-    m_settings.setValue("customWindows", enabled);
+    Misc::SettingsCache::instance().setValue("customWindows", enabled);
     Q_EMIT customWindowDecorationsChanged();
 }
 
 /**
- * Parses the JSON theme definition file for the given theme ID.
- * The colors are then "extracted" from the JSON file & loaded into the
- * class, which is later used to set the colors of the QML user interface.
+ * Loads the color definitions for the given theme ID into the class, which is later
+ * used to set the colors of the QML user interface.
+ *
+ * Themes are bundled resources, so the parsed representation is cached inside the
+ * application settings as a binary blob keyed by application version & theme path.
+ * Startup normally deserializes that compact blob, the JSON definition is only
+ * parsed when the cache is cold or the application was updated.
  */
 void Misc::ThemeManager::loadTheme(const int id)
 {
@@ -131,24 +132,68 @@ void Misc::ThemeManager::loadTheme(const int id)
     if (id >= m_availableThemesPaths.count())
         return;
 
-    // Open theme
-    QFile file(m_availableThemesPaths.at(id));
-    if (!file.open(QFile::ReadOnly))
-        return;
+    // Serve the colors from the compiled theme cache or parse the JSON definition
+    const auto key = QString("%1|%2").arg(APP_VERSION, m_availableThemesPaths.at(id));
+    if (!loadCachedTheme(key))
+    {
+        // Open theme
+        QFile file(m_availableThemesPaths.at(id));
+        if (!file.open(QFile::ReadOnly))
+            return;
+
+        // Read theme data into JSON
+        auto document = QJsonDocument::fromJson(file.readAll());
+        if (document.isEmpty())
+            return;
+
+        // Get colors object
+        auto colors = document.object().value("colors").toObject();
+        if (colors.isEmpty())
+            return;
+
+        // Read colors from JSON file
+        parseThemeJson(document.object(), colors);
+
+        // Store the compiled representation for the next run
+        cacheTheme(key);
+    }
 
-    // Read theme data into JSON
-    auto document = QJsonDocument::fromJson(file.readAll());
-    if (document.isEmpty())
-        return;
+    // Update application palette, skipping the global repolish when the palette of
+    // the new theme is identical to the active one
+    QPalette palette;
+    palette.setColor(QPalette::Base, base());
+    palette.setColor(QPalette::Link, link());
+    palette.setColor(QPalette::Text, text());
+    palette.setColor(QPalette::Button, button());
+    palette.setColor(QPalette::Window, window());
+    palette.setColor(QPalette::Midlight, midlight());
+    palette.setColor(QPalette::Highlight, highlight());
+    palette.setColor(QPalette::BrightText, brightText());
+    palette.setColor(QPalette::ButtonText, buttonText());
+    palette.setColor(QPalette::WindowText, windowText());
+    palette.setColor(QPalette::ToolTipBase, tooltipBase());
+    palette.setColor(QPalette::ToolTipText, tooltipText());
+    palette.setColor(QPalette::HighlightedText, highlightedText());
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    palette.setColor(QPalette::PlaceholderText, placeholderText());
+#endif
+    if (palette != qApp->palette())
+        qApp->setPalette(palette);
 
-    // Get colors object
-    auto colors = document.object().value("colors").toObject();
-    if (colors.isEmpty())
-        return;
+    // Update user interface
+    m_themeId = id;
+    Q_EMIT themeChanged();
+}
 
-    // Read colors from JSON file
+/**
+ * Extracts the color definitions from the given theme @a object & @a colors JSON
+ * objects into the class members.
+ */
+void Misc::ThemeManager::parseThemeJson(const QJsonObject &object,
+                                        const QJsonObject &colors)
+{
     // clang-format off
-    m_titlebarSeparator = document.object().value("titlebarSeparator").toBool();
+    m_titlebarSeparator = object.value("titlebarSeparator").toBool();
     m_base = QColor(colors.value("base").toString());
     m_link = QColor(colors.value("link").toString());
     m_button = QColor(colors.value("button").toString());
@@ -203,30 +248,79 @@ void Misc::ThemeManager::loadTheme(const int id)
     auto list = colors.value("widgetColors").toArray();
     for (int i = 0; i < list.count(); ++i)
         m_widgetColors.append(list.at(i).toString());
+}
 
-    // Update application palette
-    QPalette palette;
-    palette.setColor(QPalette::Base, base());
-    palette.setColor(QPalette::Link, link());
-    palette.setColor(QPalette::Text, text());
-    palette.setColor(QPalette::Button, button());
-    palette.setColor(QPalette::Window, window());
-    palette.setColor(QPalette::Midlight, midlight());
-    palette.setColor(QPalette::Highlight, highlight());
-    palette.setColor(QPalette::BrightText, brightText());
-    palette.setColor(QPalette::ButtonText, buttonText());
-    palette.setColor(QPalette::WindowText, windowText());
-    palette.setColor(QPalette::ToolTipBase, tooltipBase());
-    palette.setColor(QPalette::ToolTipText, tooltipText());
-    palette.setColor(QPalette::HighlightedText, highlightedText());
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    palette.setColor(QPalette::PlaceholderText, placeholderText());
-#endif
-    qApp->setPalette(palette);
+/**
+ * Returns pointers to every color member in a fixed order, used by the compiled
+ * theme cache so that serialization & deserialization always agree on the layout.
+ */
+QVector<QColor *> Misc::ThemeManager::colorSlots()
+{
+    // clang-format off
+    return QVector<QColor *> {
+        &m_base, &m_link, &m_button, &m_window, &m_text, &m_border, &m_midlight,
+        &m_highlight, &m_brightText, &m_buttonText, &m_windowText, &m_tooltipText,
+        &m_tooltipBase, &m_highlightedText, &m_highlightedTextAlternative,
+        &m_placeholderText, &m_toolbarGradient1, &m_toolbarGradient2,
+        &m_consoleText, &m_consoleBase, &m_consoleButton, &m_consoleWindow,
+        &m_consoleHighlight, &m_consoleHighlightedText, &m_consolePlaceholderText,
+        &m_windowBackground, &m_windowGradient1, &m_windowGradient2,
+        &m_menubarText, &m_dialogBackground, &m_alternativeHighlight,
+        &m_setupPanelBackground, &m_widgetTextPrimary, &m_widgetTextSecondary,
+        &m_widgetWindowBackground, &m_widgetWindowBorder, &m_paneWindowBackground,
+        &m_ledEnabled, &m_ledDisabled, &m_csvCheckbox, &m_widgetForegroundPrimary,
+        &m_widgetForegroundSecondary, &m_widgetIndicator,
+        &m_widgetControlBackground, &m_connectButtonChecked,
+        &m_connectButtonUnchecked, &m_mqttButton
+    };
+    // clang-format on
+}
 
-    // Update user interface
-    m_themeId = id;
-    Q_EMIT themeChanged();
+/**
+ * Serializes the currently loaded colors into a binary blob stored inside the
+ * application settings, tagged with the given cache @a key.
+ */
+void Misc::ThemeManager::cacheTheme(const QString &key)
+{
+    QByteArray blob;
+    QDataStream stream(&blob, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    stream << key << m_titlebarSeparator;
+    Q_FOREACH (const auto *color, colorSlots())
+        stream << *color;
+    stream << m_widgetColors;
+
+    Misc::SettingsCache::instance().setValue("themeCache", blob);
+}
+
+/**
+ * Restores the colors from the compiled theme cache. Returns @c false when the
+ * cache is empty, was written by another application version/theme (the @a key
+ * does not match) or is truncated, in which case the caller falls back to parsing
+ * the JSON theme definition.
+ */
+bool Misc::ThemeManager::loadCachedTheme(const QString &key)
+{
+    const auto blob
+        = Misc::SettingsCache::instance().value("themeCache").toByteArray();
+    if (blob.isEmpty())
+        return false;
+
+    QDataStream stream(blob);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    QString cachedKey;
+    stream >> cachedKey;
+    if (cachedKey != key)
+        return false;
+
+    stream >> m_titlebarSeparator;
+    Q_FOREACH (auto *color, colorSlots())
+        stream >> *color;
+    stream >> m_widgetColors;
+
+    return stream.status() == QDataStream::Ok;
 }
 
 /**
@@ -24,7 +24,8 @@
 
 #include <QColor>
 #include <QObject>
-#include <QSettings>
+#include <QVector>
+#include <QJsonObject>
 #include <DataTypes.h>
 
 namespace Misc
@@ -48,151 +49,151 @@ class ThemeManager : public QObject
                NOTIFY themeChanged)
     Q_PROPERTY(bool titlebarSeparator
                READ titlebarSeparator
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor base
                READ base
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor link
                READ link
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor button
                READ button
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor window
                READ window
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor text
                READ text
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor border
                READ border
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor midlight
                READ midlight
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor highlight
                READ highlight
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor brightText
                READ brightText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor buttonText
                READ buttonText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor windowText
                READ windowText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor tooltipText
                READ tooltipText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor tooltipBase
                READ tooltipBase
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor highlightedText
                READ highlightedText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor highlightedTextAlternative
                READ highlightedTextAlternative
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor placeholderText
                READ placeholderText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor toolbarGradient1
                READ toolbarGradient1
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor toolbarGradient2
                READ toolbarGradient2
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor consoleText
                READ consoleText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor consoleBase
                READ consoleBase
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor consoleButton
                READ consoleButton
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor consoleWindow
                READ consoleWindow
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor consoleHighlight
                READ consoleHighlight
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor consoleHighlightedText
                READ consoleHighlightedText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor consolePlaceholderText
                READ consolePlaceholderText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor windowBackground
                READ windowBackground
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor windowGradient1
                READ windowGradient1
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor windowGradient2
                READ windowGradient2
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor menubarText
                READ menubarText
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor dialogBackground
                READ dialogBackground
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor alternativeHighlight
                READ alternativeHighlight
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor setupPanelBackground
                READ setupPanelBackground
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetTextPrimary
                READ widgetTextPrimary
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetTextSecondary
                READ widgetTextSecondary
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetWindowBackground
                READ widgetWindowBackground
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetWindowBorder
                READ widgetWindowBorder
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor paneWindowBackground
                READ paneWindowBackground
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor ledEnabled
                READ ledEnabled
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor ledDisabled
                READ ledDisabled
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor csvCheckbox
                READ csvCheckbox
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetForegroundPrimary
                READ widgetForegroundPrimary
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetForegroundSecondary
                READ widgetForegroundSecondary
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetIndicator
                READ widgetIndicator
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor widgetControlBackground
                READ widgetControlBackground
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor connectButtonChecked
                READ connectButtonChecked
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor connectButtonUnchecked
                READ connectButtonUnchecked
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(QColor mqttButton
                READ mqttButton
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(StringList widgetColors
                READ widgetColors
-               CONSTANT)
+               NOTIFY themeChanged)
     Q_PROPERTY(StringList availableThemes
                READ availableThemes
                NOTIFY availableThemesChanged)
@@ -280,11 +281,16 @@ private Q_SLOTS:
     void populateThemes();
     void loadTheme(const int id);
 
+private:
+    QVector<QColor *> colorSlots();
+    void cacheTheme(const QString &key);
+    bool loadCachedTheme(const QString &key);
+    void parseThemeJson(const QJsonObject &object, const QJsonObject &colors);
+
 private:
     int m_themeId;
     bool m_customWindowDecorations;
 
-    QSettings m_settings;
     bool m_titlebarSeparator;
     StringList m_availableThemes;
     StringList m_availableThemesPaths;
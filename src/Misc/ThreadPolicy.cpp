@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QTimer>
+#include <QDebug>
+
+#include <Misc/ThreadPolicy.h>
+#include <Misc/SettingsCache.h>
+
+#ifdef Q_OS_WIN
+#    include <windows.h>
+#elif defined(Q_OS_LINUX)
+#    include <sched.h>
+#endif
+
+/*
+ * Pins the calling thread to the given zero-based CPU core, only supported on
+ * Linux & Windows, a no-op on other platforms.
+ */
+static void PinCurrentThread(const int core)
+{
+#ifdef Q_OS_WIN
+    SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core);
+#elif defined(Q_OS_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    Q_UNUSED(core)
+#endif
+}
+
+/*
+ * Maps a priority name of the threading-policy spec to the corresponding
+ * QThread priority, returns @c false when the name is not recognized.
+ */
+static bool ParseThreadPriority(const QString &name, QThread::Priority &priority)
+{
+    // clang-format off
+    static const struct { const char *name; QThread::Priority priority; } names[] = {
+        { "idle",         QThread::IdlePriority },
+        { "lowest",       QThread::LowestPriority },
+        { "low",          QThread::LowPriority },
+        { "normal",       QThread::NormalPriority },
+        { "high",         QThread::HighPriority },
+        { "highest",      QThread::HighestPriority },
+        { "timecritical", QThread::TimeCriticalPriority },
+    };
+    // clang-format on
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+        if (name == names[i].name)
+        {
+            priority = names[i].priority;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Constructor function, loads the threading policy from the application
+ * settings. The command line argument (if any) is applied on top of it by
+ * @c main() before any module starts its worker threads.
+ */
+Misc::ThreadPolicy::ThreadPolicy()
+{
+    const auto spec
+        = Misc::SettingsCache::instance().value("threadPolicy", "").toString();
+    if (!spec.isEmpty())
+        parseSpec(spec);
+}
+
+/**
+ * Returns a pointer to the only instance of this class
+ */
+Misc::ThreadPolicy &Misc::ThreadPolicy::instance()
+{
+    static ThreadPolicy singleton;
+    return singleton;
+}
+
+/**
+ * Applies the threading policy given on the command line, the entries override
+ * the ones loaded from the application settings for this run.
+ */
+void Misc::ThreadPolicy::setCommandLineSpec(const QString &spec)
+{
+    parseSpec(spec);
+}
+
+/**
+ * Starts the given worker @a thread with the priority configured for the
+ * @a role (or the given @a fallback when the role is not configured) & pins it
+ * to the configured CPU core (if any). Pinning must happen from the thread
+ * itself, so it is performed by a zero-interval single-shot timer scheduled on
+ * the event loop of the given @a worker object.
+ */
+void Misc::ThreadPolicy::startThread(QThread &thread, QObject *worker,
+                                     const QString &role,
+                                     const QThread::Priority fallback)
+{
+    Policy policy { -1, false, QThread::InheritPriority };
+    if (m_policies.contains(role))
+        policy = m_policies.value(role);
+
+    thread.start(policy.hasPriority ? policy.priority : fallback);
+
+    if (policy.core >= 0 && worker)
+    {
+        const int core = policy.core;
+        QTimer::singleShot(0, worker, [core]() { PinCurrentThread(core); });
+    }
+}
+
+/**
+ * Parses a comma-separated list of "role=priority[@core]" entries & registers
+ * the scheduling parameters of each role, invalid entries are reported on the
+ * console & skipped.
+ */
+void Misc::ThreadPolicy::parseSpec(const QString &spec)
+{
+    const auto entries = spec.split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < entries.count(); ++i)
+    {
+        // Split the entry into role & scheduling parameters
+        const auto &entry = entries.at(i);
+        const int assign = entry.indexOf('=');
+        if (assign <= 0)
+        {
+            qWarning() << "Invalid threading-policy entry" << entry;
+            continue;
+        }
+
+        // Split the parameters into priority name & optional core index
+        const auto role = entry.left(assign).trimmed();
+        auto params = entry.mid(assign + 1).trimmed();
+        Policy policy { -1, false, QThread::InheritPriority };
+        const int at = params.indexOf('@');
+        if (at >= 0)
+        {
+            bool ok = false;
+            policy.core = params.mid(at + 1).toInt(&ok);
+            if (!ok || policy.core < 0)
+            {
+                qWarning() << "Invalid core index in threading-policy entry" << entry;
+                continue;
+            }
+
+            params = params.left(at).trimmed();
+        }
+
+        // Decode the priority name (empty keeps the built-in default)
+        if (!params.isEmpty())
+        {
+            if (!ParseThreadPriority(params, policy.priority))
+            {
+                qWarning() << "Invalid priority in threading-policy entry" << entry;
+                continue;
+            }
+
+            policy.hasPriority = true;
+        }
+
+        m_policies.insert(role, policy);
+    }
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_ThreadPolicy.cpp"
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QMap>
+#include <QObject>
+#include <QThread>
+#include <QString>
+
+namespace Misc
+{
+/**
+ * @brief The ThreadPolicy class
+ *
+ * Deployment-level scheduling configuration for the pipeline worker threads.
+ * On small rigs (e.g. a 4-core SBC driving a dashboard) the default scheduling
+ * can drop frames whenever the compositor wakes up, pinning the ingestion
+ * thread away from the render cores & raising its priority above the QML
+ * thread fixes that without code changes.
+ *
+ * The policy is a comma-separated list of "role=priority[@core]" entries,
+ * where the role names a pipeline stage ("ingest", "export" or "fft"), the
+ * priority is one of idle, lowest, low, normal, high, highest or timecritical
+ * (empty to keep the built-in default) & the optional "@core" suffix pins the
+ * thread to the given zero-based CPU core. For example:
+ *
+ *     --threads=ingest=timecritical@3,export=low,fft=normal@2
+ *
+ * The spec is read from the "threadPolicy" application setting & can be
+ * overridden for one run with the --threads= command line argument. Modules
+ * apply it by starting their worker threads through @c startThread(), roles
+ * without a configured entry fall back to the priority hard-coded at the call
+ * site. The parse stage runs on the global @c QThreadPool & is not covered,
+ * its tasks inherit normal priority from the GUI thread.
+ *
+ * Core pinning is supported on Linux & Windows, on other platforms the
+ * "@core" suffix is ignored.
+ */
+class ThreadPolicy : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+private:
+    explicit ThreadPolicy();
+    ThreadPolicy(ThreadPolicy &&) = delete;
+    ThreadPolicy(const ThreadPolicy &) = delete;
+    ThreadPolicy &operator=(ThreadPolicy &&) = delete;
+    ThreadPolicy &operator=(const ThreadPolicy &) = delete;
+
+public:
+    static ThreadPolicy &instance();
+
+    void setCommandLineSpec(const QString &spec);
+    void startThread(QThread &thread, QObject *worker, const QString &role,
+                     const QThread::Priority fallback);
+
+private:
+    /*
+     * Scheduling parameters of one pipeline role, a core of -1 leaves the
+     * thread free to migrate between cores
+     */
+    struct Policy
+    {
+        int core;
+        bool hasPriority;
+        QThread::Priority priority;
+    };
+
+    void parseSpec(const QString &spec);
+
+private:
+    QMap<QString, Policy> m_policies;
+};
+}
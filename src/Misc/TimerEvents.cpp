@@ -23,6 +23,17 @@
 #include <QTimerEvent>
 #include <Misc/TimerEvents.h>
 
+/*
+ * Number of widget update slices per UI interval
+ */
+static const int kUiSliceCount = 4;
+
+/*
+ * Time without received data after which the fast timers are suspended, long
+ * enough that a slow sensor (e.g. one reading per second) never trips it
+ */
+static const qint64 kIdleThresholdMsecs = 5000;
+
 /**
  * Returns a pointer to the only instance of the class
  */
@@ -32,14 +43,27 @@ Misc::TimerEvents &Misc::TimerEvents::instance()
     return singleton;
 }
 
+/**
+ * Returns the framerate that the adaptive UI timer aims for when the event
+ * loop is not overloaded
+ */
+int Misc::TimerEvents::targetFramerate() const
+{
+    return m_targetFramerate;
+}
+
 /**
  * Stops all the timers of this module
  */
 void Misc::TimerEvents::stopTimers()
 {
+    m_idle = false;
+    m_uiTimer.stop();
     m_timer1Hz.stop();
     m_timer10Hz.stop();
     m_timer20Hz.stop();
+    m_uiSliceTimer.stop();
+    m_activity.invalidate();
 }
 
 /**
@@ -48,13 +72,69 @@ void Misc::TimerEvents::stopTimers()
 void Misc::TimerEvents::timerEvent(QTimerEvent *event)
 {
     if (event->timerId() == m_timer1Hz.timerId())
+    {
         Q_EMIT timeout1Hz();
 
+        // No data received for a while, suspend the fast timers so that an
+        // idle session (disconnected, or a device that went silent) does not
+        // keep the CPU busy repainting unchanged widgets. The 1 Hz tick keeps
+        // running to drive the clocks & this check, registerActivity() resumes
+        // the fast timers on the next received byte.
+        if (!m_idle && m_activity.isValid()
+            && m_activity.elapsed() >= kIdleThresholdMsecs)
+        {
+            m_idle = true;
+            m_uiTimer.stop();
+            m_timer10Hz.stop();
+            m_timer20Hz.stop();
+            m_uiSliceTimer.stop();
+        }
+    }
+
     else if (event->timerId() == m_timer10Hz.timerId())
         Q_EMIT timeout10Hz();
 
     else if (event->timerId() == m_timer20Hz.timerId())
         Q_EMIT timeout20Hz();
+
+    else if (event->timerId() == m_uiTimer.timerId())
+    {
+        // Measure the actual time between UI ticks. When the event loop is
+        // overloaded the timer events arrive late, in that case the refresh
+        // interval is doubled (down to 5 Hz) so that the ingestion path gets
+        // the CPU time. The rate climbs back towards the target framerate
+        // when the ticks arrive on time again.
+        const int target = 1000 / targetFramerate();
+        const int elapsed = static_cast<int>(m_uiElapsed.restart());
+        int interval = m_uiInterval;
+        if (elapsed > interval + interval / 2)
+            interval = qMin(200, interval * 2);
+        else
+            interval = qMax(target, interval - qMax(1, target / 4));
+
+        // Re-schedule the timer when the interval changes
+        if (interval != m_uiInterval)
+        {
+            m_uiInterval = interval;
+            m_uiTimer.start(m_uiInterval, this);
+        }
+
+        // Update the user interface & emit the first widget update slice, the
+        // remaining slices are spread over the rest of the refresh interval
+        Q_EMIT timeoutUi();
+        m_uiSlice = 1;
+        Q_EMIT timeoutUiSlice(0);
+        m_uiSliceTimer.start(qMax(1, m_uiInterval / kUiSliceCount), this);
+    }
+
+    else if (event->timerId() == m_uiSliceTimer.timerId())
+    {
+        // Emit the next widget update slice of the current UI interval, the
+        // timer stops after the last slice & is re-armed on the next UI tick
+        Q_EMIT timeoutUiSlice(m_uiSlice);
+        if (++m_uiSlice >= kUiSliceCount)
+            m_uiSliceTimer.stop();
+    }
 }
 
 /**
@@ -62,11 +142,59 @@ void Misc::TimerEvents::timerEvent(QTimerEvent *event)
  */
 void Misc::TimerEvents::startTimers()
 {
+    m_idle = false;
+    m_activity.start();
+    m_uiElapsed.start();
+    m_uiTimer.start(m_uiInterval, this);
     m_timer20Hz.start(50, this);
     m_timer10Hz.start(100, this);
     m_timer1Hz.start(1000, this);
 }
 
+/**
+ * Registers that data has just been received. The idle watchdog is re-armed &
+ * the fast timers are restarted immediately if they had been suspended, so the
+ * first frame of a device that wakes up is rendered without any extra latency.
+ * Called by @c IO::Manager on every ingest path (devices, MQTT & CSV playback).
+ */
+void Misc::TimerEvents::registerActivity()
+{
+    // Timers stopped altogether (e.g. application shutdown), ignore
+    if (!m_activity.isValid())
+        return;
+
+    // Re-arm the idle watchdog
+    m_activity.restart();
+
+    // Resume the fast timers suspended by the idle watchdog
+    if (m_idle)
+    {
+        m_idle = false;
+        m_uiElapsed.start();
+        m_uiTimer.start(m_uiInterval, this);
+        m_timer20Hz.start(50, this);
+        m_timer10Hz.start(100, this);
+    }
+}
+
+/**
+ * Changes the framerate that the adaptive UI timer shall aim for, valid
+ * values range from 5 to 60 Hz
+ */
+void Misc::TimerEvents::setTargetFramerate(const int fps)
+{
+    const int framerate = qBound(5, fps, 60);
+    if (m_targetFramerate != framerate)
+    {
+        m_targetFramerate = framerate;
+        m_uiInterval = 1000 / framerate;
+        if (m_uiTimer.isActive())
+            m_uiTimer.start(m_uiInterval, this);
+
+        Q_EMIT targetFramerateChanged();
+    }
+}
+
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
 #    include "moc_TimerEvents.cpp"
 #endif
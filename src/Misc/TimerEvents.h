@@ -24,6 +24,7 @@
 
 #include <QObject>
 #include <QBasicTimer>
+#include <QElapsedTimer>
 
 namespace Misc
 {
@@ -32,20 +33,49 @@ namespace Misc
  *
  * The @c TimerEvents class implements periodic timers that are used to update
  * the user interface elements at a specific frequency.
+ *
+ * Besides the fixed 1/10/20 Hz ticks, the class implements an adaptive UI
+ * timer that drives the dashboard repaints. The timer aims for the
+ * user-selectable target framerate, but when the event loop cannot sustain it
+ * the interval is increased (down to 5 Hz) so that the data ingestion path
+ * gets the CPU time instead of the renderer.
+ *
+ * Each UI interval is additionally divided into four slices, reported through
+ * the @c timeoutUiSlice() signal. The dashboard spreads the widget update
+ * work over the slices so that the event loop is never blocked by a full
+ * dashboard repaint in a single burst.
+ *
+ * To keep the idle CPU usage near zero (important on battery-powered field
+ * laptops), the fast timers are suspended when no data has arrived for a few
+ * seconds: the 10/20 Hz ticks & the UI refresh timer stop, only the 1 Hz tick
+ * keeps running to drive the clocks & the idle check itself. The first byte
+ * received afterwards resumes the timers instantly (see @c registerActivity(),
+ * which @c IO::Manager calls on every ingest path).
  */
 class TimerEvents : public QObject
 {
     // clang-format off
     Q_OBJECT
+    Q_PROPERTY(int targetFramerate
+               READ targetFramerate
+               WRITE setTargetFramerate
+               NOTIFY targetFramerateChanged)
     // clang-format on
 
 Q_SIGNALS:
     void timeout1Hz();
     void timeout10Hz();
     void timeout20Hz();
+    void timeoutUi();
+    void timeoutUiSlice(const int slice);
+    void targetFramerateChanged();
 
 private:
-    TimerEvents() {};
+    TimerEvents()
+        : m_idle(false)
+        , m_uiSlice(0)
+        , m_uiInterval(50)
+        , m_targetFramerate(20) {};
     TimerEvents(TimerEvents &&) = delete;
     TimerEvents(const TimerEvents &) = delete;
     TimerEvents &operator=(TimerEvents &&) = delete;
@@ -54,16 +84,28 @@ private:
 public:
     static TimerEvents &instance();
 
+    int targetFramerate() const;
+
 protected:
     void timerEvent(QTimerEvent *event) override;
 
 public Q_SLOTS:
     void stopTimers();
     void startTimers();
+    void registerActivity();
+    void setTargetFramerate(const int fps);
 
 private:
+    bool m_idle;
+    int m_uiSlice;
+    int m_uiInterval;
+    int m_targetFramerate;
+    QBasicTimer m_uiTimer;
     QBasicTimer m_timer1Hz;
     QBasicTimer m_timer10Hz;
     QBasicTimer m_timer20Hz;
+    QBasicTimer m_uiSliceTimer;
+    QElapsedTimer m_uiElapsed;
+    QElapsedTimer m_activity;
 };
 }
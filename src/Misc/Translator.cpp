@@ -21,13 +21,24 @@
  */
 
 #include <Misc/Translator.h>
+#include <Misc/SettingsCache.h>
 
 /**
  * Constructor function
  */
 Misc::Translator::Translator()
+    : m_installedTranslator(Q_NULLPTR)
 {
-    setLanguage(m_settings.value("language", systemLanguage()).toInt());
+    // Fast path for default-language sessions: the source strings already are in
+    // English, so there is no *.qm file to parse & no translator to install and
+    // startup skips the whole translation machinery. Every other language goes
+    // through the normal setLanguage() path.
+    const int language
+        = Misc::SettingsCache::instance().value("language", systemLanguage()).toInt();
+    if (language == 0)
+        m_language = 0;
+    else
+        setLanguage(language);
 }
 
 /**
@@ -81,10 +92,16 @@ int Misc::Translator::systemLanguage() const
 }
 
 /**
- * Returns the welcome text displayed on the console
+ * Returns the welcome text displayed on the console. The text is read from the
+ * resources on first use & memoized per language.
  */
 QString Misc::Translator::welcomeConsoleText() const
 {
+    // Serve the text from the memoization cache when possible
+    const auto it = m_welcomeText.constFind(language());
+    if (it != m_welcomeText.constEnd())
+        return it.value();
+
     QString lang;
     switch (language())
     {
@@ -116,23 +133,26 @@ QString Misc::Translator::welcomeConsoleText() const
         file.close();
     }
 
+    m_welcomeText.insert(language(), text);
     return text;
 }
 
 /**
- * Returns the acknowledgements text.
+ * Returns the acknowledgements text, the file is only read on first use.
  */
 QString Misc::Translator::acknowledgementsText() const
 {
-    QString text = "";
+    if (!m_acknowledgementsText.isEmpty())
+        return m_acknowledgementsText;
+
     QFile file(":/messages/Acknowledgements.txt");
     if (file.open(QFile::ReadOnly))
     {
-        text = QString::fromUtf8(file.readAll());
+        m_acknowledgementsText = QString::fromUtf8(file.readAll());
         file.close();
     }
 
-    return text;
+    return m_acknowledgementsText;
 }
 
 /**
@@ -183,7 +203,7 @@ void Misc::Translator::setLanguage(const int language)
     }
 
     m_language = language;
-    m_settings.setValue("language", m_language);
+    Misc::SettingsCache::instance().setValue("language", m_language);
 
     setLanguage(locale, langName);
 }
@@ -198,12 +218,41 @@ void Misc::Translator::setLanguage(const int language)
  */
 void Misc::Translator::setLanguage(const QLocale &locale, const QString &language)
 {
-    qApp->removeTranslator(&m_translator);
-    if (m_translator.load(locale, ":/translations/" + language + ".qm"))
+    // Remove the previously installed translator (if any)
+    if (m_installedTranslator)
+    {
+        qApp->removeTranslator(m_installedTranslator);
+        m_installedTranslator = Q_NULLPTR;
+    }
+
+    // English needs no translator at all, the source strings are used directly
+    if (language == "en")
     {
-        qApp->installTranslator(&m_translator);
         Q_EMIT languageChanged();
+        return;
+    }
+
+    // Load the *.qm file on first use & keep it around, QTranslator reads the
+    // message catalog in place from the mapped resource data and switching back
+    // to a previously used language re-installs the cached translator without
+    // parsing the catalog again
+    auto *translator = m_translators.value(language, Q_NULLPTR);
+    if (!translator)
+    {
+        translator = new QTranslator(this);
+        if (!translator->load(locale, ":/translations/" + language + ".qm"))
+        {
+            delete translator;
+            return;
+        }
+
+        m_translators.insert(language, translator);
     }
+
+    // Install the translator & ask the user interface to re-translate itself
+    qApp->installTranslator(translator);
+    m_installedTranslator = translator;
+    Q_EMIT languageChanged();
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QLocale>
 #include <QObject>
 #include <QTranslator>
@@ -78,7 +79,12 @@ public Q_SLOTS:
 
 private:
     int m_language;
-    QSettings m_settings;
-    QTranslator m_translator;
+    QTranslator *m_installedTranslator;
+    QHash<QString, QTranslator *> m_translators;
+
+    // Memoized message texts, the files backing them only need to be read once
+    // per session (& per language in the case of the welcome text)
+    mutable QString m_acknowledgementsText;
+    mutable QHash<int, QString> m_welcomeText;
 };
 }
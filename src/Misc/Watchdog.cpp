@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QDebug>
+
+#include <Misc/Watchdog.h>
+
+/**
+ * Interval (in milliseconds) of the GUI-thread heartbeat timer
+ */
+static const int kHeartbeatMsecs = 25;
+
+/**
+ * Dispatch delays above this threshold (in milliseconds) are recorded as
+ * stalls. The value is noticeably larger than the heartbeat interval, so
+ * normal timer jitter never counts as a stall.
+ */
+static const qint64 kStallThresholdMsecs = 100;
+
+/**
+ * Sampling interval (in milliseconds) of the watchdog thread
+ */
+static const unsigned long kMonitorSleepMsecs = 25;
+
+/**
+ * Constructor function. The heartbeat timer & the watchdog thread are not
+ * started here, monitoring begins when @c setEnabled() is called by the
+ * module manager once the user interface is up (see the lazy initialization
+ * contract in @c Misc::ModuleManager).
+ */
+Misc::Watchdog::Watchdog()
+    : m_enabled(false)
+    , m_monitorThread(Q_NULLPTR)
+    , m_lastBeatNsecs(0)
+    , m_monitorActive(0)
+    , m_activity(Q_NULLPTR)
+    , m_stallCount(0)
+    , m_maxStallMsecs(0)
+    , m_totalStallMsecs(0)
+    , m_lastStallMsecs(0)
+{
+    m_clock.start();
+    m_heartbeatTimer.setTimerType(Qt::PreciseTimer);
+    m_heartbeatTimer.setInterval(kHeartbeatMsecs);
+    connect(&m_heartbeatTimer, &QTimer::timeout, this, &Misc::Watchdog::onHeartbeat);
+}
+
+/**
+ * Destructor function, stops the watchdog thread
+ */
+Misc::Watchdog::~Watchdog()
+{
+    m_monitorActive.storeRelease(0);
+    if (m_monitorThread)
+    {
+        m_monitorThread->requestInterruption();
+        m_monitorThread->wait();
+        delete m_monitorThread;
+    }
+}
+
+/**
+ * Returns the only instance of this class
+ */
+Misc::Watchdog &Misc::Watchdog::instance()
+{
+    static Watchdog singleton;
+    return singleton;
+}
+
+/**
+ * Returns @c true if the stall detector is running
+ */
+bool Misc::Watchdog::enabled() const
+{
+    return m_enabled;
+}
+
+/**
+ * Returns the accumulated stall figures as display-ready rows
+ */
+StringList Misc::Watchdog::statistics() const
+{
+    StringList rows;
+    if (m_stallCount == 0)
+    {
+        rows.append(QString("no stalls > %1 ms detected").arg(kStallThresholdMsecs));
+        return rows;
+    }
+
+    rows.append(QString("stalls > %1 ms: %2, total %3 ms, max %4 ms")
+                    .arg(kStallThresholdMsecs)
+                    .arg(m_stallCount)
+                    .arg(m_totalStallMsecs)
+                    .arg(m_maxStallMsecs));
+    rows.append(QString("last stall: %1 ms (%2)")
+                    .arg(m_lastStallMsecs)
+                    .arg(m_lastStallActivity));
+    return rows;
+}
+
+/**
+ * Registers the currently-running GUI thread @a activity & returns the
+ * previous tag so that nested handlers can restore it. The string must be a
+ * literal, the watchdog thread reads the pointer without copying.
+ */
+const char *Misc::Watchdog::setActivity(const char *activity)
+{
+    return m_activity.fetchAndStoreOrdered(activity);
+}
+
+/**
+ * Starts/stops the stall detector, the accumulated statistics survive a
+ * stop/start cycle so that monitoring can be paused during known-expensive
+ * operations (e.g. project editing).
+ */
+void Misc::Watchdog::setEnabled(const bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+
+    m_enabled = enabled;
+
+    if (enabled)
+    {
+        // Begin beating before the monitor starts checking
+        m_lastBeatNsecs.storeRelease(m_clock.nsecsElapsed());
+        m_heartbeatTimer.start();
+
+        // Spin up the watchdog thread on first use
+        if (!m_monitorThread)
+        {
+            m_monitorActive.storeRelease(1);
+            m_monitorThread = QThread::create([this]() { monitorLoop(); });
+            m_monitorThread->start(QThread::LowPriority);
+        }
+
+        else
+            m_monitorActive.storeRelease(1);
+    }
+
+    else
+    {
+        m_heartbeatTimer.stop();
+        m_monitorActive.storeRelease(0);
+    }
+
+    Q_EMIT enabledChanged();
+}
+
+/**
+ * Discards the accumulated stall statistics
+ */
+void Misc::Watchdog::resetStatistics()
+{
+    m_stallCount = 0;
+    m_maxStallMsecs = 0;
+    m_totalStallMsecs = 0;
+    m_lastStallMsecs = 0;
+    m_lastStallActivity.clear();
+    Q_EMIT statisticsChanged();
+}
+
+/**
+ * Refreshes the heartbeat timestamp read by the watchdog thread. Executed on
+ * every dispatch of the GUI event loop, the handler only performs an atomic
+ * store so its own cost is negligible.
+ */
+void Misc::Watchdog::onHeartbeat()
+{
+    m_lastBeatNsecs.storeRelease(m_clock.nsecsElapsed());
+}
+
+/**
+ * Registers a stall reported by the watchdog thread, executed on the GUI
+ * thread (through a queued connection) once the event loop is responsive
+ * again.
+ */
+void Misc::Watchdog::onStallDetected(const qint64 msecs, const QString &activity)
+{
+    ++m_stallCount;
+    m_lastStallMsecs = msecs;
+    m_totalStallMsecs += msecs;
+    m_maxStallMsecs = qMax(m_maxStallMsecs, msecs);
+    m_lastStallActivity = activity.isEmpty() ? tr("unknown") : activity;
+
+    qWarning().noquote() << QString("GUI thread stalled for %1 ms (%2)")
+                                .arg(msecs)
+                                .arg(m_lastStallActivity);
+
+    Q_EMIT statisticsChanged();
+}
+
+/**
+ * Body of the watchdog thread. Samples the heartbeat timestamp, when the GUI
+ * thread stops beating for longer than the stall threshold the activity tag
+ * is captured *while* the stall is in progress & the final duration is
+ * reported once the heartbeat resumes.
+ */
+void Misc::Watchdog::monitorLoop()
+{
+    QString activity;
+    qint64 stallStartBeat = -1;
+
+    while (!QThread::currentThread()->isInterruptionRequested())
+    {
+        QThread::msleep(kMonitorSleepMsecs);
+
+        // Paused, forget any stall in progress
+        if (!m_monitorActive.loadAcquire())
+        {
+            stallStartBeat = -1;
+            continue;
+        }
+
+        // Measure the time since the last dispatch of the GUI event loop
+        const qint64 beat = m_lastBeatNsecs.loadAcquire();
+        const qint64 delayMsecs = (m_clock.nsecsElapsed() - beat) / 1000000;
+
+        // Stall in progress, capture the activity tag of the GUI thread now,
+        // it may already be cleared by the time the event loop recovers
+        if (stallStartBeat < 0 && delayMsecs > kStallThresholdMsecs)
+        {
+            stallStartBeat = beat;
+            const char *tag = m_activity.loadAcquire();
+            activity = tag ? QString::fromLatin1(tag) : QString();
+        }
+
+        // Heartbeat resumed, report the stall duration to the GUI thread. The
+        // duration is the gap between the beat that preceded the stall & the
+        // beat that ended it, minus the nominal heartbeat interval.
+        else if (stallStartBeat >= 0 && beat != stallStartBeat)
+        {
+            const qint64 msecs
+                = qMax(qint64(0), (beat - stallStartBeat) / 1000000 - kHeartbeatMsecs);
+            stallStartBeat = -1;
+
+            QMetaObject::invokeMethod(this, "onStallDetected", Qt::QueuedConnection,
+                                      Q_ARG(qint64, msecs), Q_ARG(QString, activity));
+        }
+    }
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Watchdog.cpp"
+#endif
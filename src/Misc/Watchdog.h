@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QObject>
+#include <QThread>
+#include <QAtomicPointer>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+
+#include <DataTypes.h>
+
+namespace Misc
+{
+/**
+ * @brief The Watchdog class
+ *
+ * Event-loop stall detector for the GUI thread. A heartbeat timer updates a
+ * monotonic timestamp on every dispatch & a watchdog thread checks that the
+ * timestamp keeps advancing. When the GUI thread stops dispatching events for
+ * longer than the stall threshold, the watchdog records a stall (count,
+ * duration & the activity tag that the GUI thread registered last), which
+ * turns "the gauges felt laggy" field reports into hard numbers that can be
+ * correlated with data rates & project sizes.
+ *
+ * Handlers that are known to hog the GUI thread register themselves with a
+ * @c WatchdogActivity guard, so that the stall log can tell *what* was
+ * running when the event loop stopped responding.
+ */
+class Watchdog : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(bool enabled
+               READ enabled
+               WRITE setEnabled
+               NOTIFY enabledChanged)
+    Q_PROPERTY(StringList statistics
+               READ statistics
+               NOTIFY statisticsChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void enabledChanged();
+    void statisticsChanged();
+
+private:
+    explicit Watchdog();
+    Watchdog(Watchdog &&) = delete;
+    Watchdog(const Watchdog &) = delete;
+    Watchdog &operator=(Watchdog &&) = delete;
+    Watchdog &operator=(const Watchdog &) = delete;
+
+    ~Watchdog();
+
+public:
+    static Watchdog &instance();
+
+    bool enabled() const;
+    StringList statistics() const;
+
+    const char *setActivity(const char *activity);
+
+public Q_SLOTS:
+    void setEnabled(const bool enabled);
+    void resetStatistics();
+
+private Q_SLOTS:
+    void onHeartbeat();
+    void onStallDetected(const qint64 msecs, const QString &activity);
+
+private:
+    void monitorLoop();
+
+private:
+    bool m_enabled;
+
+    QTimer m_heartbeatTimer;
+    QElapsedTimer m_clock;
+    QThread *m_monitorThread;
+    QAtomicInteger<qint64> m_lastBeatNsecs;
+    QAtomicInteger<int> m_monitorActive;
+    QAtomicPointer<const char> m_activity;
+
+    quint64 m_stallCount;
+    qint64 m_maxStallMsecs;
+    qint64 m_totalStallMsecs;
+    qint64 m_lastStallMsecs;
+    QString m_lastStallActivity;
+};
+
+/**
+ * @brief The WatchdogActivity class
+ *
+ * Scope guard that registers the currently-running handler with the watchdog,
+ * so that stall reports can name the handler that blocked the event loop.
+ * The activity string must be a literal (the watchdog stores the pointer, not
+ * a copy).
+ */
+class WatchdogActivity
+{
+public:
+    explicit WatchdogActivity(const char *activity)
+    {
+        m_previous = Watchdog::instance().setActivity(activity);
+    }
+
+    ~WatchdogActivity() { Watchdog::instance().setActivity(m_previous); }
+
+private:
+    const char *m_previous;
+};
+}
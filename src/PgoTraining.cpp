@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "PgoTraining.h"
+
+//
+// Headless training workload for the profile-guided optimization build (see the
+// recipe in Serial-Studio.pro). The workload replays representative synthetic
+// captures through the real ingestion pipeline (delimiter scanning, JSON
+// tokenizing in automatic & manual mode, dashboard updates & the console hex
+// formatter), so the profile covers the same branchy hot paths that dominate a
+// live session. The instrumented & the optimized builds share the same object
+// set, the workload therefore lives in the application itself instead of in a
+// separate harness binary.
+//
+
+#include <cstdio>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QTemporaryFile>
+
+#include <CSV/Export.h>
+#include <IO/Console.h>
+#include <IO/Manager.h>
+#include <JSON/Generator.h>
+#include <Misc/TimerEvents.h>
+#include <UI/Dashboard.h>
+
+/**
+ * Each training phase feeds data for roughly this long. The workload does not
+ * need to be long, it needs to be representative: a few seconds per phase is
+ * enough for the profile counters to reflect the steady-state branch behavior.
+ */
+static const qint64 kPhaseMsecs = 5000;
+
+/**
+ * Generates a JSON frame with 3 groups of 8 datasets each, the dataset values
+ * change with the @a pass number so that the numeric tokenizer sees a realistic
+ * mix of digit counts instead of one constant string.
+ */
+static QByteArray BuildJsonFrame(const int pass)
+{
+    QJsonArray groups;
+    for (int g = 0; g < 3; ++g)
+    {
+        QJsonArray datasets;
+        for (int d = 0; d < 8; ++d)
+        {
+            QJsonObject dataset;
+            dataset.insert("title", QString("Channel %1").arg(d));
+            dataset.insert("value",
+                           QString::number((g * 8 + d + 1) * (pass % 997) * 0.37, 'f',
+                                           2 + (pass % 3)));
+            dataset.insert("units", "V");
+            dataset.insert("graph", true);
+            datasets.append(dataset);
+        }
+
+        QJsonObject group;
+        group.insert("title", QString("Group %1").arg(g));
+        group.insert("widget", "");
+        group.insert("datasets", datasets);
+        groups.append(group);
+    }
+
+    QJsonObject object;
+    object.insert("title", "PGO Training");
+    object.insert("groups", groups);
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * Feeds delimited JSON frames through the full ingestion pipeline in automatic
+ * mode, which trains the delimiter scanner, the JSON tokenizer & the dashboard
+ * update path at once.
+ */
+static void TrainAutomaticPipeline()
+{
+    printf("pgo-train: automatic pipeline\n");
+    fflush(stdout);
+
+    auto &manager = IO::Manager::instance();
+    JSON::Generator::instance().setOperationMode(JSON::Generator::kAutomatic);
+
+    int pass = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kPhaseMsecs)
+    {
+        // Build a chunk with several frames so the scanner sees frame boundaries
+        // in the middle of a chunk, not only at its edges
+        QByteArray chunk;
+        for (int i = 0; i < 10; ++i)
+            chunk.append("/*" + BuildJsonFrame(++pass) + "*/");
+
+        // Feed the chunk & deliver the queued pipeline/dashboard signals
+        manager.processRawData(chunk);
+        QApplication::processEvents();
+    }
+}
+
+/**
+ * Feeds comma-separated value frames through the compiled manual-mode template,
+ * which trains the CSV-style tokenizer & the template substitution path.
+ */
+static void TrainManualPipeline()
+{
+    printf("pgo-train: manual pipeline\n");
+    fflush(stdout);
+
+    // Build a JSON map with one group & 16 datasets mapped to "%1".."%16"
+    QJsonArray datasets;
+    for (int d = 0; d < 16; ++d)
+    {
+        QJsonObject dataset;
+        dataset.insert("title", QString("Channel %1").arg(d + 1));
+        dataset.insert("value", QString("%%1").arg(d + 1));
+        dataset.insert("graph", true);
+        datasets.append(dataset);
+    }
+
+    QJsonObject group;
+    group.insert("title", "Group");
+    group.insert("widget", "");
+    group.insert("datasets", datasets);
+
+    QJsonObject object;
+    object.insert("title", "PGO Training");
+    object.insert("groups", QJsonArray { group });
+
+    // Write the map to a temporary file & load it
+    QTemporaryFile mapFile;
+    if (!mapFile.open())
+    {
+        printf("pgo-train: manual pipeline skipped (cannot create map file)\n");
+        return;
+    }
+
+    mapFile.write(QJsonDocument(object).toJson(QJsonDocument::Indented));
+    mapFile.flush();
+
+    auto &generator = JSON::Generator::instance();
+    generator.loadJsonMap(mapFile.fileName());
+    generator.setOperationMode(JSON::Generator::kManual);
+
+    // Feed delimited comma-separated frames with varying value widths
+    int pass = 0;
+    auto &manager = IO::Manager::instance();
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kPhaseMsecs)
+    {
+        QByteArray chunk;
+        for (int i = 0; i < 10; ++i)
+        {
+            ++pass;
+            chunk.append("/*");
+            for (int d = 0; d < 16; ++d)
+            {
+                if (d > 0)
+                    chunk.append(',');
+                chunk.append(QByteArray::number((d + 1) * (pass % 991) * 0.53, 'f',
+                                                2 + (pass % 3)));
+            }
+            chunk.append("*/");
+        }
+
+        manager.processRawData(chunk);
+        QApplication::processEvents();
+    }
+
+    generator.setOperationMode(JSON::Generator::kAutomatic);
+}
+
+/**
+ * Feeds binary chunks through the console hex-dump formatter, which is the
+ * hottest display path when the console is set to hexadecimal mode.
+ */
+static void TrainConsoleFormatter()
+{
+    printf("pgo-train: console formatter\n");
+    fflush(stdout);
+
+    auto &console = IO::Console::instance();
+    console.setEcho(false);
+    console.setDisplayMode(IO::Console::DisplayMode::DisplayHexadecimal);
+
+    QByteArray chunk(4096, '\0');
+    for (int i = 0; i < chunk.size(); ++i)
+        chunk[i] = static_cast<char>(i * 17);
+
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < kPhaseMsecs)
+    {
+        QMetaObject::invokeMethod(&console, "onDataReceived", Qt::DirectConnection,
+                                  Q_ARG(QByteArray, chunk));
+        QApplication::processEvents();
+    }
+
+    console.setDisplayMode(IO::Console::DisplayMode::DisplayPlainText);
+}
+
+/**
+ * Runs the headless PGO training workload & returns the application exit code.
+ *
+ * The application & organization names are changed so that the training run does
+ * not clobber the settings of a regular installation, and CSV export is disabled
+ * so that the run leaves no files behind.
+ */
+int runPgoTrainingWorkload()
+{
+    // Isolate the training run from the regular application settings
+    qApp->setApplicationName("Serial Studio PGO Training");
+    qApp->setOrganizationName("Serial Studio PGO Training");
+
+    // Do not write CSV files while the workload runs
+    CSV::Export::instance().setExportEnabled(false);
+
+    // Instantiate the dashboard & start the UI timers so that the frames are
+    // consumed the same way as during a live session
+    (void)UI::Dashboard::instance();
+    Misc::TimerEvents::instance().startTimers();
+
+    // Run the training phases
+    TrainAutomaticPipeline();
+    TrainManualPipeline();
+    TrainConsoleFormatter();
+
+    // Flush any pending queued signals & stop the timers
+    QApplication::processEvents();
+    Misc::TimerEvents::instance().stopTimers();
+
+    printf("pgo-train: done\n");
+    return EXIT_SUCCESS;
+}
@@ -20,27 +20,106 @@
  * THE SOFTWARE.
  */
 
+#include <cstring>
+
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QDataStream>
 #include <QJsonDocument>
 
 #include <IO/Manager.h>
 #include <JSON/Generator.h>
+#include <Misc/Clock.h>
 #include <Misc/Utilities.h>
 #include <Plugins/Server.h>
 #include <Misc/TimerEvents.h>
+#include <Misc/LatencyTracer.h>
+#include <Misc/MemoryRegistry.h>
+#include <UI/Alarms.h>
+#include <UI/Statistics.h>
+
+/**
+ * Maximum number of bytes a plugin client may have pending (send queue + socket
+ * buffer) before the server starts dropping the oldest queued messages.
+ */
+static const qint64 kMaxQueuedBytes = 1024 * 1024;
+
+/**
+ * Soft limit for the amount of data buffered inside a client socket, the send queue
+ * stops feeding the socket until the kernel drains it below this mark.
+ */
+static const qint64 kMaxSocketBuffer = 256 * 1024;
+
+/*
+ * Message type identifiers of the binary bridge protocol. Clients opt into the
+ * binary mode with the "binary" flag of their subscribe control message, from then
+ * on every message they receive is framed as a network-order quint32 length
+ * followed by a one-byte type & the payload:
+ *
+ * - RawFrame: the unmodified frame bytes, replaces the Base64-in-JSON wrapper
+ * - ProcessedData: compact typed encoding of the dataset values, replaces the
+ *   processed-frames JSON document (see @c encodeProcessedFrames())
+ * - JsonEvent: a compact JSON document, used for alarm events & query replies so
+ *   that binary clients only ever deal with a single framing
+ */
+static const quint8 kBinaryRawFrame = 0;
+static const quint8 kBinaryProcessedData = 1;
+static const quint8 kBinaryJsonEvent = 2;
+
+/**
+ * @brief The ShmHeader struct
+ *
+ * Header of the shared memory ring used to hand frames to local plugin consumers
+ * without serializing them or crossing the loopback stack. Frames are stored as
+ * [quint32 length][payload] records that wrap around at @c capacity.
+ *
+ * The @c sequence counter implements a seqlock: it is odd while the producer writes
+ * a record & even when the ring is consistent. Readers map the segment read-only,
+ * remember the last even sequence they saw & re-read whenever the counter changed
+ * mid-copy. @c writeOffset marks where the next record will start, @c frameCount
+ * lets readers detect how many records they missed.
+ */
+struct ShmHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 capacity;
+    quint32 frameCount;
+    quint64 sequence;
+    quint64 writeOffset;
+};
+
+static const quint32 kShmMagic = 0x53535052; // "SSPR"
+static const quint32 kShmVersion = 1;
+static const quint32 kShmCapacity = 1024 * 1024;
+
+/**
+ * Copies @a length bytes of @a data into the ring at the given @a offset, wrapping
+ * around at @a capacity.
+ */
+static void WriteRing(uchar *ring, const quint32 capacity, const quint32 offset,
+                      const void *data, const quint32 length)
+{
+    const auto *bytes = static_cast<const uchar *>(data);
+    const quint32 first = qMin(length, capacity - offset);
+    memcpy(ring + offset, bytes, first);
+    if (length > first)
+        memcpy(ring, bytes + first, length - first);
+}
 
 /**
  * Constructor function
  */
 Plugins::Server::Server()
     : m_enabled(false)
+    , m_shmEnabled(false)
+    , m_droppedMessages(0)
 {
     // clang-format off
 
-    // Send processed data at 1 Hz
-    connect(&JSON::Generator::instance(), &JSON::Generator::jsonChanged,
-            this, &Plugins::Server::registerFrame);
+    // Send processed data at 1 Hz, the generator connection is only active
+    // while the subsystem is enabled so that the generator can skip building
+    // JSON documents that nobody consumes
     connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
             this, &Plugins::Server::sendProcessedData);
 
@@ -52,15 +131,16 @@ Plugins::Server::Server()
     connect(&m_server, &QTcpServer::newConnection,
             this, &Plugins::Server::acceptConnection);
 
+    // Broadcast alarm raise/clear events to the connected clients
+    connect(&UI::Alarms::instance(), &UI::Alarms::alarmRaised,
+            this, &Plugins::Server::onAlarmRaised);
+    connect(&UI::Alarms::instance(), &UI::Alarms::alarmCleared,
+            this, &Plugins::Server::onAlarmCleared);
+
     // clang-format on
 
-    // Begin listening on TCP port
-    if (!m_server.listen(QHostAddress::Any, PLUGINS_TCP_PORT))
-    {
-        Misc::Utilities::showMessageBox(tr("Unable to start plugin TCP server"),
-                                        m_server.errorString());
-        m_server.close();
-    }
+    // The TCP server only begins listening when the plugin system is enabled by
+    // the user (see setEnabled()), so that the subsystem adds no startup cost
 }
 
 /**
@@ -88,6 +168,23 @@ bool Plugins::Server::enabled() const
     return m_enabled;
 }
 
+/**
+ * Returns @c true if frames are also published through the shared memory ring
+ */
+bool Plugins::Server::shmEnabled() const
+{
+    return m_shmEnabled;
+}
+
+/**
+ * Returns the number of messages dropped because a plugin client could not keep up
+ * with the broadcast rate.
+ */
+quint64 Plugins::Server::droppedMessageCount() const
+{
+    return m_droppedMessages;
+}
+
 /**
  * Disconnects the socket used for communicating with plugins.
  */
@@ -108,6 +205,10 @@ void Plugins::Server::removeConnection()
             }
         }
 
+        // Discard the send queue & subscription of the socket
+        m_sendQueues.remove(socket);
+        m_subscriptions.remove(socket);
+
         // Delete socket handler
         socket->deleteLater();
     }
@@ -122,9 +223,30 @@ void Plugins::Server::setEnabled(const bool enabled)
     m_enabled = enabled;
     Q_EMIT enabledChanged();
 
-    // If not enabled, remove all connections
+    // Only listen to the JSON generator while enabled, the generator checks
+    // the receiver count of this signal to decide if it needs to build a DOM
+    if (enabled)
+        connect(&JSON::Generator::instance(), &JSON::Generator::jsonChanged,
+                this, &Plugins::Server::registerFrame, Qt::UniqueConnection);
+
+    // Begin listening on the TCP port, the port stays closed while the plugin
+    // system is disabled
+    if (enabled && !m_server.isListening())
+    {
+        if (!m_server.listen(QHostAddress::Any, PLUGINS_TCP_PORT))
+        {
+            Misc::Utilities::showMessageBox(tr("Unable to start plugin TCP server"),
+                                            m_server.errorString());
+            m_server.close();
+        }
+    }
+
+    // If not enabled, remove all connections & close the TCP port
     if (!enabled)
     {
+        m_server.close();
+        disconnect(&JSON::Generator::instance(), &JSON::Generator::jsonChanged,
+                   this, &Plugins::Server::registerFrame);
         for (int i = 0; i < m_sockets.count(); ++i)
         {
             auto socket = m_sockets.at(i);
@@ -137,6 +259,8 @@ void Plugins::Server::setEnabled(const bool enabled)
         }
 
         m_sockets.clear();
+        m_sendQueues.clear();
+        m_subscriptions.clear();
     }
 
     // Clear frames array to avoid memory leaks
@@ -144,16 +268,164 @@ void Plugins::Server::setEnabled(const bool enabled)
 }
 
 /**
- * Process incoming data and writes it directly to the connected I/O device
+ * Enables/disables the shared memory transport. When enabled, every extracted frame
+ * is also written into a shared memory ring (see @c ShmHeader), local plugin
+ * consumers map the segment read-only & receive the frames without the JSON
+ * serialization or loopback overhead of the TCP transport. The TCP server stays
+ * available as a fallback for remote or legacy consumers.
+ */
+void Plugins::Server::setShmEnabled(const bool enabled)
+{
+    // Nothing to do
+    if (enabled == m_shmEnabled)
+        return;
+
+    // Create & initialize the shared memory segment
+    if (enabled)
+    {
+        m_shm.setKey(PLUGINS_SHM_KEY);
+        if (!m_shm.create(static_cast<int>(sizeof(ShmHeader) + kShmCapacity)))
+        {
+            // A previous instance crashed without detaching, recover the segment
+            if (m_shm.error() == QSharedMemory::AlreadyExists)
+                m_shm.attach();
+
+            if (!m_shm.isAttached())
+            {
+                Misc::Utilities::showMessageBox(tr("Plugin server"),
+                                                m_shm.errorString());
+                return;
+            }
+        }
+
+        // Initialize the ring header
+        m_shm.lock();
+        auto *header = static_cast<ShmHeader *>(m_shm.data());
+        header->magic = kShmMagic;
+        header->version = kShmVersion;
+        header->capacity = kShmCapacity;
+        header->frameCount = 0;
+        header->sequence = 0;
+        header->writeOffset = 0;
+        m_shm.unlock();
+
+        // Mirror every extracted frame into the ring
+        connect(&IO::Manager::instance(), &IO::Manager::frameReceived, this,
+                &Plugins::Server::writeShmFrame, Qt::UniqueConnection);
+    }
+
+    // Stop publishing frames & release the segment
+    else
+    {
+        disconnect(&IO::Manager::instance(), &IO::Manager::frameReceived, this,
+                   &Plugins::Server::writeShmFrame);
+        m_shm.detach();
+    }
+
+    // Update status & notify user interface
+    m_shmEnabled = enabled && m_shm.isAttached();
+    Q_EMIT shmEnabledChanged();
+}
+
+/**
+ * Process incoming data and writes it directly to the connected I/O device.
+ * Control messages (newline-terminated JSON objects that begin with
+ * @c {"subscribe", @c {"inject", @c {"memory", @c {"statistics" or
+ * @c {"diagnostics" & are sent in their own write) are consumed by the server
+ * instead of being forwarded to the device: subscription messages update the
+ * broadcast filter of the client, inject messages feed the attached frame array
+ * into the pipeline as one batch, memory queries are answered with the figures of
+ * the buffer accounting registry, statistics queries with the running per-dataset
+ * statistics & diagnostics queries with a bundle of pipeline health figures (see
+ * @c diagnosticsJson()).
  */
 void Plugins::Server::onDataReceived()
 {
     // Get caller socket
     auto socket = static_cast<QTcpSocket *>(QObject::sender());
+    if (!enabled() || !socket)
+        return;
+
+    // Update the subscription filter of the client
+    const auto data = socket->readAll();
+    if (data.startsWith("{\"subscribe\""))
+    {
+        updateSubscription(socket, data);
+        return;
+    }
+
+    // Memory accounting query, answer with the buffer registry figures
+    if (data.startsWith("{\"memory\""))
+    {
+        const auto json = Misc::MemoryRegistry::instance().memoryJson().toUtf8();
+        if (m_subscriptions.value(socket).binary)
+            socket->write(encodeBinaryMessage(kBinaryJsonEvent, json));
+        else
+        {
+            socket->write(json);
+            socket->write("\n");
+        }
+
+        return;
+    }
+
+    // Statistics query, answer with the running per-dataset statistics
+    if (data.startsWith("{\"statistics\""))
+    {
+        const auto json = UI::Statistics::instance().statisticsJson().toUtf8();
+        if (m_subscriptions.value(socket).binary)
+            socket->write(encodeBinaryMessage(kBinaryJsonEvent, json));
+        else
+        {
+            socket->write(json);
+            socket->write("\n");
+        }
+
+        return;
+    }
+
+    // Frame injection, feed the attached frames into the pipeline in one pass.
+    // The batch API emits a single UI notification for the whole burst, so
+    // plugin-side feeders can inject thousands of frames without paying one
+    // signal fan-out per frame.
+    if (data.startsWith("{\"inject\""))
+    {
+        const auto frames = QJsonDocument::fromJson(data).object().value("inject")
+                                .toArray();
+
+        QVector<QByteArray> batch;
+        batch.reserve(frames.count());
+        for (int i = 0; i < frames.count(); ++i)
+        {
+            const auto frame = frames.at(i).toString().toUtf8();
+            if (!frame.isEmpty())
+                batch.append(frame);
+        }
+
+        if (!batch.isEmpty())
+            IO::Manager::instance().processFrameBatch(batch);
+
+        return;
+    }
+
+    // Diagnostics query, answer with the pipeline health figures (ingestion
+    // statistics, memory telemetry, latency histograms & latched alarms)
+    if (data.startsWith("{\"diagnostics\""))
+    {
+        const auto json = diagnosticsJson();
+        if (m_subscriptions.value(socket).binary)
+            socket->write(encodeBinaryMessage(kBinaryJsonEvent, json));
+        else
+        {
+            socket->write(json);
+            socket->write("\n");
+        }
+
+        return;
+    }
 
     // Write incoming data to manager
-    if (enabled() && socket)
-        IO::Manager::instance().writeData(socket->readAll());
+    IO::Manager::instance().writeData(data);
 }
 
 /**
@@ -184,6 +456,7 @@ void Plugins::Server::acceptConnection()
 
     // Connect socket signals/slots
     connect(socket, &QTcpSocket::readyRead, this, &Plugins::Server::onDataReceived);
+    connect(socket, &QTcpSocket::bytesWritten, this, &Plugins::Server::onBytesWritten);
     connect(socket, &QTcpSocket::disconnected, this, &Plugins::Server::removeConnection);
 
     // React to socket errors
@@ -197,8 +470,11 @@ void Plugins::Server::acceptConnection()
 #endif
     // clang-format on
 
-    // Add socket to sockets list
+    // Add socket to sockets list & create its send queue + default subscription
+    // (all groups & datasets, raw data enabled, no rate limit)
     m_sockets.append(socket);
+    m_sendQueues.insert(socket, SendQueue());
+    m_subscriptions.insert(socket, Subscription());
 }
 
 /**
@@ -234,20 +510,52 @@ void Plugins::Server::sendProcessedData()
     // Create JSON document with frame arrays
     if (array.count() > 0)
     {
-        // Construct QByteArray with data
+        // Serialize the full frame list once, unfiltered clients all share the same
+        // refcounted buffer. The binary encoding is only built when the first
+        // binary-mode client is reached, so JSON-only deployments pay nothing for it
         QJsonObject object;
         object.insert("frames", array);
         const QJsonDocument document(object);
-        auto json = document.toJson(QJsonDocument::Compact) + "\n";
+        const auto fullJson = document.toJson(QJsonDocument::Compact) + "\n";
+        QByteArray fullBinary;
 
-        // Send data to each plugin
+        // Send data to each plugin, honoring its subscription filter & rate limit
+        const auto now = Misc::Clock::instance().currentMSecsSinceEpoch();
         Q_FOREACH (auto socket, m_sockets)
         {
-            if (!socket)
+            if (!socket || !socket->isWritable())
                 continue;
 
-            if (socket->isWritable())
-                socket->write(json);
+            // Apply the per-subscription rate limit
+            auto &sub = m_subscriptions[socket];
+            if (sub.maxRate > 0 && now - sub.lastProcessedMsecs < 1000 / sub.maxRate)
+                continue;
+            sub.lastProcessedMsecs = now;
+
+            // Unfiltered clients share the full serialized document, filtered ones
+            // get a document with only their groups/datasets
+            if (sub.binary)
+            {
+                if (sub.groups.isEmpty() && sub.datasets.isEmpty())
+                {
+                    if (fullBinary.isEmpty())
+                        fullBinary = encodeBinaryMessage(
+                            kBinaryProcessedData, encodeProcessedFrames(array, sub));
+
+                    enqueueMessage(socket, fullBinary);
+                }
+
+                else
+                    enqueueMessage(socket,
+                                   encodeBinaryMessage(
+                                       kBinaryProcessedData,
+                                       encodeProcessedFrames(array, sub)));
+            }
+
+            else if (sub.groups.isEmpty() && sub.datasets.isEmpty())
+                enqueueMessage(socket, fullJson);
+            else
+                enqueueMessage(socket, filterFrames(array, sub));
         }
     }
 
@@ -273,21 +581,201 @@ void Plugins::Server::sendRawData(const QByteArray &data)
     QJsonObject object;
     object.insert("data", QString::fromUtf8(data.toBase64()));
 
-    // Get JSON string in compact format & send it over the TCP socket
+    // Get JSON string in compact format & broadcast it, the message is serialized
+    // once & every send queue shares the same refcounted buffer. Binary-mode
+    // clients receive the frame bytes as-is (see broadcast())
     QJsonDocument document(object);
-    auto json = document.toJson(QJsonDocument::Compact) + "\n";
+    broadcast(document.toJson(QJsonDocument::Compact) + "\n", data);
+}
+
+/**
+ * Notifies every connected plugin client that the alarm rule described by
+ * @a reason was triggered for the dataset with the given @a title. Alarm events
+ * are rare & important, so they bypass the subscription filters & rate limits.
+ */
+void Plugins::Server::onAlarmRaised(const QString &title, const QString &reason,
+                                    const double value)
+{
+    // Stop if system is not enabled
+    if (!enabled())
+        return;
 
-    // Send data to each plugin
+    // Stop if no sockets are available
+    if (m_sockets.count() < 1)
+        return;
+
+    // Create JSON structure with the alarm event & serialize it once
+    QJsonObject alarm;
+    alarm.insert("title", title);
+    alarm.insert("reason", reason);
+    alarm.insert("value", value);
+    alarm.insert("state", QStringLiteral("raised"));
+    QJsonObject object;
+    object.insert("alarm", alarm);
+    const QJsonDocument document(object);
+    const auto json = document.toJson(QJsonDocument::Compact);
+    const auto jsonLine = json + "\n";
+
+    // Send the event to every connected client, binary-mode clients receive the
+    // same JSON document inside a length-prefixed record
+    QByteArray binary;
     Q_FOREACH (auto socket, m_sockets)
     {
-        if (!socket)
+        if (!socket || !socket->isWritable())
             continue;
 
-        if (socket->isWritable())
-            socket->write(json);
+        if (m_subscriptions.value(socket).binary)
+        {
+            if (binary.isEmpty())
+                binary = encodeBinaryMessage(kBinaryJsonEvent, json);
+
+            enqueueMessage(socket, binary);
+        }
+
+        else
+            enqueueMessage(socket, jsonLine);
+    }
+}
+
+/**
+ * Notifies every connected plugin client that the value of the dataset with the
+ * given @a title returned to its normal range.
+ */
+void Plugins::Server::onAlarmCleared(const QString &title)
+{
+    // Stop if system is not enabled
+    if (!enabled())
+        return;
+
+    // Stop if no sockets are available
+    if (m_sockets.count() < 1)
+        return;
+
+    // Create JSON structure with the alarm event & serialize it once
+    QJsonObject alarm;
+    alarm.insert("title", title);
+    alarm.insert("state", QStringLiteral("cleared"));
+    QJsonObject object;
+    object.insert("alarm", alarm);
+    const QJsonDocument document(object);
+    const auto json = document.toJson(QJsonDocument::Compact);
+    const auto jsonLine = json + "\n";
+
+    // Send the event to every connected client, binary-mode clients receive the
+    // same JSON document inside a length-prefixed record
+    QByteArray binary;
+    Q_FOREACH (auto socket, m_sockets)
+    {
+        if (!socket || !socket->isWritable())
+            continue;
+
+        if (m_subscriptions.value(socket).binary)
+        {
+            if (binary.isEmpty())
+                binary = encodeBinaryMessage(kBinaryJsonEvent, json);
+
+            enqueueMessage(socket, binary);
+        }
+
+        else
+            enqueueMessage(socket, jsonLine);
+    }
+}
+
+/**
+ * Appends the raw-data broadcast to the bounded send queue of every plugin client
+ * that subscribes to the raw stream, honoring the per-subscription rate limit.
+ * JSON clients receive the pre-serialized @a json document, binary-mode clients
+ * receive the @a rawFrame bytes wrapped in a length-prefixed record. Each variant
+ * is built at most once & shared by every queue through the implicit sharing of
+ * the byte arrays.
+ */
+void Plugins::Server::broadcast(const QByteArray &json, const QByteArray &rawFrame)
+{
+    QByteArray binary;
+    const auto now = Misc::Clock::instance().currentMSecsSinceEpoch();
+    Q_FOREACH (auto socket, m_sockets)
+    {
+        if (!socket || !socket->isWritable())
+            continue;
+
+        // Honor the subscription filter & rate limit of the client
+        auto &sub = m_subscriptions[socket];
+        if (!sub.rawData)
+            continue;
+        if (sub.maxRate > 0 && now - sub.lastRawMsecs < 1000 / sub.maxRate)
+            continue;
+        sub.lastRawMsecs = now;
+
+        // Encode the binary variant when the first binary-mode client is reached
+        if (sub.binary)
+        {
+            if (binary.isEmpty())
+                binary = encodeBinaryMessage(kBinaryRawFrame, rawFrame);
+
+            enqueueMessage(socket, binary);
+        }
+
+        else
+            enqueueMessage(socket, json);
+    }
+}
+
+/**
+ * Appends the given @a message to the bounded send queue of the @a socket & flushes
+ * as much of the queue as the socket accepts. The message buffer is implicitly
+ * shared, so fanning the same document out to several clients costs no deep copies.
+ * Clients that cannot keep up lose their oldest queued messages (counted by
+ * @c droppedMessageCount()) instead of growing the queue without limit.
+ */
+void Plugins::Server::enqueueMessage(QTcpSocket *socket, const QByteArray &message)
+{
+    // Append the message to the send queue of the socket
+    auto &queue = m_sendQueues[socket];
+    queue.messages.append(message);
+    queue.bytes += message.size();
+
+    // Drop the oldest messages when the client cannot keep up
+    while (queue.bytes + socket->bytesToWrite() > kMaxQueuedBytes
+           && queue.messages.count() > 1)
+    {
+        queue.bytes -= queue.messages.first().size();
+        queue.messages.removeFirst();
+        ++m_droppedMessages;
+    }
+
+    // Hand as much of the queue as possible to the socket
+    flushSocket(socket);
+}
+
+/**
+ * Writes queued messages to the given @a socket until its internal buffer reaches the
+ * soft limit. The rest of the queue is flushed from @c onBytesWritten() as the kernel
+ * drains the socket, so one slow plugin client cannot make the server buffer grow
+ * without bounds.
+ */
+void Plugins::Server::flushSocket(QTcpSocket *socket)
+{
+    auto &queue = m_sendQueues[socket];
+    while (!queue.messages.isEmpty() && socket->bytesToWrite() < kMaxSocketBuffer)
+    {
+        const auto message = queue.messages.takeFirst();
+        queue.bytes -= message.size();
+        socket->write(message);
     }
 }
 
+/**
+ * Continues flushing the send queue of the caller socket when the kernel drains its
+ * buffer below the soft limit.
+ */
+void Plugins::Server::onBytesWritten()
+{
+    auto socket = static_cast<QTcpSocket *>(QObject::sender());
+    if (socket && m_sendQueues.contains(socket))
+        flushSocket(socket);
+}
+
 /**
  * Obtains the latest JSON dataframe & appends it to the JSON list, which is later read
  * and sent by the @c sendProcessedData() function.
@@ -298,6 +786,273 @@ void Plugins::Server::registerFrame(const QJsonObject &json)
         m_frames.append(json);
 }
 
+/**
+ * Parses the subscription @a data sent by a plugin client & updates its filter. The
+ * control message is a newline-terminated JSON object sent in its own write:
+ *
+ *   {"subscribe":{"groups":[0,2],"datasets":[1],"maxRate":1,"rawData":false}}
+ *
+ * - groups/datasets: indices to include in processed documents, omitted = all
+ * - maxRate: maximum number of messages per second (per stream), 0 = unlimited
+ * - rawData: set to @c false to opt out of the raw-data broadcasts
+ * - binary: set to @c true to switch the connection to the length-prefixed binary
+ *   protocol (normally done right after connecting, see the message type constants
+ *   at the top of this file for the wire format)
+ */
+void Plugins::Server::updateSubscription(QTcpSocket *socket, const QByteArray &data)
+{
+    // Parse & validate the control message
+    const auto object
+        = QJsonDocument::fromJson(data).object().value("subscribe").toObject();
+    if (object.isEmpty())
+        return;
+
+    // Update the subscription of the client
+    auto &sub = m_subscriptions[socket];
+    sub.maxRate = qMax(0, object.value("maxRate").toInt());
+    sub.rawData = object.value("rawData").toBool(true);
+    sub.binary = object.value("binary").toBool(false);
+
+    // Register the subscribed group indices
+    sub.groups.clear();
+    const auto groups = object.value("groups").toArray();
+    for (int i = 0; i < groups.count(); ++i)
+        sub.groups.append(groups.at(i).toInt());
+
+    // Register the subscribed dataset indices
+    sub.datasets.clear();
+    const auto datasets = object.value("datasets").toArray();
+    for (int i = 0; i < datasets.count(); ++i)
+        sub.datasets.append(datasets.at(i).toInt());
+}
+
+/**
+ * Generates a serialized document that contains only the groups & datasets selected
+ * by the given @a subscription. The filter works on the already-built JSON array, so
+ * the frame list is converted from the generator representation exactly once per
+ * broadcast no matter how many filtered clients are connected.
+ */
+QByteArray Plugins::Server::filterFrames(const QJsonArray &frames,
+                                         const Subscription &subscription) const
+{
+    QJsonArray filtered;
+    for (int i = 0; i < frames.count(); ++i)
+    {
+        auto entry = frames.at(i).toObject();
+        auto frame = entry.value("data").toObject();
+        const auto groups = frame.value("groups").toArray();
+
+        // Select the subscribed groups (& the subscribed datasets inside them)
+        QJsonArray selectedGroups;
+        for (int g = 0; g < groups.count(); ++g)
+        {
+            if (!subscription.groups.isEmpty() && !subscription.groups.contains(g))
+                continue;
+
+            auto group = groups.at(g).toObject();
+            if (!subscription.datasets.isEmpty())
+            {
+                const auto datasets = group.value("datasets").toArray();
+                QJsonArray selectedDatasets;
+                for (int d = 0; d < datasets.count(); ++d)
+                {
+                    if (subscription.datasets.contains(d))
+                        selectedDatasets.append(datasets.at(d));
+                }
+
+                group.insert("datasets", selectedDatasets);
+            }
+
+            selectedGroups.append(group);
+        }
+
+        frame.insert("groups", selectedGroups);
+        entry.insert("data", frame);
+        filtered.append(entry);
+    }
+
+    QJsonObject object;
+    object.insert("frames", filtered);
+    return QJsonDocument(object).toJson(QJsonDocument::Compact) + "\n";
+}
+
+/**
+ * Wraps the given @a payload in a binary protocol record: a network-order quint32
+ * with the length of the rest of the message, followed by the @a type byte & the
+ * payload itself. The length prefix lets clients split the stream into messages
+ * without scanning for delimiters, which is what makes the binary mode cheap to
+ * parse on the receiving end.
+ */
+QByteArray Plugins::Server::encodeBinaryMessage(const quint8 type,
+                                                const QByteArray &payload) const
+{
+    QByteArray message;
+    message.reserve(payload.size() + sizeof(quint32) + sizeof(quint8));
+
+    QDataStream stream(&message, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << static_cast<quint32>(payload.size() + sizeof(quint8));
+    stream << type;
+
+    message.append(payload);
+    return message;
+}
+
+/**
+ * Encodes the dataset values of the given @a frames in the compact typed format of
+ * the binary protocol, honoring the group/dataset selection of the @a subscription.
+ * Layout (QDataStream defaults, big-endian):
+ *
+ *   quint16 frameCount
+ *   per frame:   quint16 groupCount
+ *   per group:   quint16 groupIndex, quint16 datasetCount
+ *   per dataset: quint16 datasetIndex, quint8 valueType,
+ *                double (type 0, numeric) or UTF-8 QByteArray (type 1, text)
+ *
+ * Indices refer to the positions inside the project file, so clients resolve the
+ * titles & units once instead of receiving them with every single message.
+ */
+QByteArray Plugins::Server::encodeProcessedFrames(const QJsonArray &frames,
+                                                  const Subscription &subscription) const
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << static_cast<quint16>(frames.count());
+
+    for (int i = 0; i < frames.count(); ++i)
+    {
+        const auto frame = frames.at(i).toObject().value("data").toObject();
+        const auto groups = frame.value("groups").toArray();
+
+        // Select the subscribed groups
+        QVector<int> selectedGroups;
+        for (int g = 0; g < groups.count(); ++g)
+        {
+            if (subscription.groups.isEmpty() || subscription.groups.contains(g))
+                selectedGroups.append(g);
+        }
+
+        // Encode the datasets of every selected group
+        stream << static_cast<quint16>(selectedGroups.count());
+        Q_FOREACH (const int g, selectedGroups)
+        {
+            const auto group = groups.at(g).toObject();
+            const auto datasets = group.value("datasets").toArray();
+
+            // Select the subscribed datasets
+            QVector<int> selectedDatasets;
+            for (int d = 0; d < datasets.count(); ++d)
+            {
+                if (subscription.datasets.isEmpty()
+                    || subscription.datasets.contains(d))
+                    selectedDatasets.append(d);
+            }
+
+            // Encode the dataset values, numeric values travel as doubles &
+            // everything else as an UTF-8 string
+            stream << static_cast<quint16>(g);
+            stream << static_cast<quint16>(selectedDatasets.count());
+            Q_FOREACH (const int d, selectedDatasets)
+            {
+                const auto value = datasets.at(d).toObject().value("value");
+
+                bool numeric = value.isDouble();
+                double number = value.toDouble();
+                if (!numeric)
+                    number = value.toString().toDouble(&numeric);
+
+                stream << static_cast<quint16>(d);
+                if (numeric)
+                    stream << static_cast<quint8>(0) << number;
+                else
+                    stream << static_cast<quint8>(1) << value.toString().toUtf8();
+            }
+        }
+    }
+
+    return payload;
+}
+
+/**
+ * Builds the reply of a @c {"diagnostics"} query: a compact JSON document with the
+ * ingestion statistics of the I/O manager, the buffer accounting figures, the
+ * per-stage latency histograms & the latched alarm states. The figures are read
+ * from counters that the modules maintain anyway, so fleet monitors can poll the
+ * query every few seconds without influencing the measured pipeline.
+ */
+QByteArray Plugins::Server::diagnosticsJson() const
+{
+    // Ingestion statistics of the I/O manager
+    auto &manager = IO::Manager::instance();
+    QJsonObject ingestion;
+    ingestion.insert("connected", manager.connected());
+    ingestion.insert("frames_per_second", qint64(manager.framesPerSecond()));
+    ingestion.insert("bytes_per_second", qint64(manager.bytesPerSecond()));
+    ingestion.insert("avg_scan_time_us", qint64(manager.averageScanTime()));
+    ingestion.insert("checksum_errors", qint64(manager.checksumErrorCount()));
+    ingestion.insert("dropped_frames", qint64(manager.droppedFrameCount()));
+    ingestion.insert("resyncs", qint64(manager.resyncCount()));
+    ingestion.insert("buffer_high_water", qint64(manager.bufferHighWaterMark()));
+    ingestion.insert("buffer_overflow_bytes", qint64(manager.bufferOverflowBytes()));
+
+    // Latched alarm states
+    auto &alarmEngine = UI::Alarms::instance();
+    QJsonObject alarms;
+    alarms.insert("count", alarmEngine.count());
+    alarms.insert("active", QJsonArray::fromStringList(alarmEngine.alarms()));
+
+    // Bundle everything with the memory & latency documents of the diagnostics
+    // modules (both already serialize themselves for external tools)
+    QJsonObject document;
+    document.insert("ingestion", ingestion);
+    document.insert("alarms", alarms);
+    document.insert(
+        "memory",
+        QJsonDocument::fromJson(Misc::MemoryRegistry::instance().memoryJson().toUtf8())
+            .object());
+    document.insert(
+        "latency",
+        QJsonDocument::fromJson(Misc::LatencyTracer::instance().latencyJson().toUtf8())
+            .object());
+
+    return QJsonDocument(document).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * Writes the given @a frame into the shared memory ring as a length-prefixed record.
+ * The frame bytes are copied exactly once (from the frame into the mapped segment),
+ * readers consume them in place. The sequence counter is odd for the duration of the
+ * write so that lock-free readers can detect & retry torn reads.
+ */
+void Plugins::Server::writeShmFrame(const QByteArray &frame)
+{
+    // Segment not available or frame cannot fit inside the ring
+    const quint32 length = frame.size();
+    const quint32 need = sizeof(quint32) + length;
+    if (!m_shm.isAttached() || length == 0 || need > kShmCapacity)
+        return;
+
+    // Mark the ring as busy (odd sequence)
+    m_shm.lock();
+    auto *header = static_cast<ShmHeader *>(m_shm.data());
+    auto *ring = static_cast<uchar *>(m_shm.data()) + sizeof(ShmHeader);
+    header->sequence += 1;
+
+    // Write the length prefix & the frame payload, wrapping at the ring capacity
+    quint32 offset = static_cast<quint32>(header->writeOffset) % header->capacity;
+    WriteRing(ring, header->capacity, offset, &length, sizeof(quint32));
+    offset = (offset + sizeof(quint32)) % header->capacity;
+    WriteRing(ring, header->capacity, offset, frame.constData(), length);
+    offset = (offset + length) % header->capacity;
+
+    // Publish the record (even sequence)
+    header->writeOffset = offset;
+    header->frameCount += 1;
+    header->sequence += 1;
+    m_shm.unlock();
+}
+
 /**
  * This function is called whenever a socket error occurs, it disconnects the socket
  * from the host and displays the error in a message box.
@@ -22,11 +22,15 @@
 
 #pragma once
 
+#include <QHash>
+#include <QList>
 #include <QObject>
+#include <QJsonArray>
 #include <QTcpSocket>
 #include <QTcpServer>
 #include <QByteArray>
 #include <QHostAddress>
+#include <QSharedMemory>
 
 #include <JSON/Frame.h>
 #include <JSON/Dataset.h>
@@ -37,6 +41,11 @@
  */
 #define PLUGINS_TCP_PORT 7777
 
+/**
+ * Key of the shared memory segment that carries frames to local plugin consumers
+ */
+#define PLUGINS_SHM_KEY "SerialStudio_PluginRing"
+
 namespace Plugins
 {
 /**
@@ -56,11 +65,18 @@ namespace Plugins
  */
 class Server : public QObject
 {
+    // clang-format off
     Q_OBJECT
     Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(bool shmEnabled
+               READ shmEnabled
+               WRITE setShmEnabled
+               NOTIFY shmEnabledChanged)
+    // clang-format on
 
 Q_SIGNALS:
     void enabledChanged();
+    void shmEnabledChanged();
 
 private:
     explicit Server();
@@ -74,23 +90,74 @@ private:
 public:
     static Server &instance();
     bool enabled() const;
+    bool shmEnabled() const;
+    quint64 droppedMessageCount() const;
 
 public Q_SLOTS:
     void removeConnection();
     void setEnabled(const bool enabled);
+    void setShmEnabled(const bool enabled);
 
 private Q_SLOTS:
     void onDataReceived();
     void acceptConnection();
     void sendProcessedData();
     void sendRawData(const QByteArray &data);
+    void onBytesWritten();
+    void onAlarmCleared(const QString &title);
+    void onAlarmRaised(const QString &title, const QString &reason,
+                       const double value);
     void registerFrame(const QJsonObject &json);
+    void writeShmFrame(const QByteArray &frame);
     void onErrorOccurred(const QAbstractSocket::SocketError socketError);
 
+private:
+    /**
+     * Bounded per-socket send queue, pending messages share the refcounted
+     * buffer generated by the broadcast functions.
+     */
+    struct SendQueue
+    {
+        qint64 bytes = 0;
+        QList<QByteArray> messages;
+    };
+
+    /**
+     * Per-socket subscription filter, updated when the client sends a
+     * "subscribe" control message (see @c updateSubscription()).
+     */
+    struct Subscription
+    {
+        bool rawData = true;          // forward raw-data broadcasts
+        bool binary = false;          // length-prefixed binary framing, not JSON lines
+        int maxRate = 0;              // max messages/sec per stream, 0 = unlimited
+        qint64 lastRawMsecs = 0;      // timestamp of the last raw message
+        qint64 lastProcessedMsecs = 0; // timestamp of the last processed document
+        QVector<int> groups;          // subscribed group indices, empty = all
+        QVector<int> datasets;        // subscribed dataset indices, empty = all
+    };
+
+private:
+    void broadcast(const QByteArray &json, const QByteArray &rawFrame);
+    void flushSocket(QTcpSocket *socket);
+    void enqueueMessage(QTcpSocket *socket, const QByteArray &message);
+    void updateSubscription(QTcpSocket *socket, const QByteArray &data);
+    QByteArray filterFrames(const QJsonArray &frames,
+                            const Subscription &subscription) const;
+    QByteArray encodeBinaryMessage(const quint8 type, const QByteArray &payload) const;
+    QByteArray encodeProcessedFrames(const QJsonArray &frames,
+                                     const Subscription &subscription) const;
+    QByteArray diagnosticsJson() const;
+
 private:
     bool m_enabled;
+    bool m_shmEnabled;
     QTcpServer m_server;
+    QSharedMemory m_shm;
+    quint64 m_droppedMessages;
     QVector<QJsonObject> m_frames;
     QVector<QTcpSocket *> m_sockets;
+    QHash<QTcpSocket *, SendQueue> m_sendQueues;
+    QHash<QTcpSocket *, Subscription> m_subscriptions;
 };
 }
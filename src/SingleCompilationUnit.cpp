@@ -103,6 +103,7 @@
 #include "qwt/src/qwt_plot_vectorfield.h"
 #include "qwt/src/qwt_plot_abstract_canvas.h"
 #include "qwt/src/qwt_plot_canvas.h"
+#include "qwt/src/qwt_plot_opengl_canvas.h"
 #include "qwt/src/qwt_plot_panner.h"
 #include "qwt/src/qwt_plot_picker.h"
 #include "qwt/src/qwt_plot_zoomer.h"
@@ -237,37 +238,66 @@
 
 #include "AppInfo.h"
 #include "DataTypes.h"
+#include "CSV/ColumnarExport.h"
 #include "CSV/Export.h"
 #include "CSV/Player.h"
+#include "IO/Capture.h"
 #include "IO/Checksum.h"
+#include "IO/CircularBuffer.h"
 #include "IO/Console.h"
+#include "IO/DataSources/Generator.h"
 #include "IO/DataSources/Network.h"
 #include "IO/DataSources/Serial.h"
+#include "IO/DataSources/WebSocket.h"
+#include "IO/DataSources/Relay.h"
+#include "IO/FrameQueue.h"
+#include "IO/FrameReader.h"
 #include "IO/Manager.h"
+#include "IO/Pipeline.h"
+#include "IO/Replay.h"
+#include "IO/SequenceMatcher.h"
 #include "JSON/Dataset.h"
 #include "JSON/Editor.h"
+#include "JSON/Expressions.h"
 #include "JSON/Frame.h"
+#include "JSON/FrameParser.h"
 #include "JSON/Generator.h"
 #include "JSON/Group.h"
+#include "JSON/StringPool.h"
 #include "MQTT/Client.h"
+#include "Misc/Clock.h"
+#include "Misc/LatencyTracer.h"
 #include "Misc/MacExtras.h"
+#include "Misc/MemoryRegistry.h"
 #include "Misc/ModuleManager.h"
+#include "Misc/SessionSnapshot.h"
+#include "Misc/SettingsCache.h"
 #include "Misc/ThemeManager.h"
+#include "Misc/ThreadPolicy.h"
+#include "Misc/Watchdog.h"
 #include "Misc/TimerEvents.h"
 #include "Misc/Translator.h"
 #include "Misc/Utilities.h"
 #include "Plugins/Server.h"
+#include "UI/Alarms.h"
 #include "UI/Dashboard.h"
 #include "UI/DashboardWidget.h"
 #include "UI/DeclarativeWidget.h"
+#include "UI/HistoryStore.h"
+#include "UI/PlotBuffer.h"
+#include "UI/QuickPlot.h"
+#include "UI/Statistics.h"
 #include "UI/Widgets/Terminal.h"
 #include "UI/Widgets/Accelerometer.h"
 #include "UI/Widgets/Bar.h"
 #include "UI/Widgets/Common/AnalogGauge.h"
 #include "UI/Widgets/Common/AttitudeIndicator.h"
 #include "UI/Widgets/Common/BaseWidget.h"
+#include "UI/Widgets/Common/ConsoleView.h"
 #include "UI/Widgets/Common/ElidedLabel.h"
+#include "UI/Widgets/Common/FFTPlanCache.h"
 #include "UI/Widgets/Common/KLed.h"
+#include "UI/Widgets/Common/PlotSeriesData.h"
 #include "UI/Widgets/Compass.h"
 #include "UI/Widgets/DataGroup.h"
 #include "UI/Widgets/FFTPlot.h"
@@ -277,135 +307,17 @@
 #include "UI/Widgets/LEDPanel.h"
 #include "UI/Widgets/MultiPlot.h"
 #include "UI/Widgets/Plot.h"
+#include "UI/Widgets/Spectrogram.h"
 
 //----------------------------------------------------------------------------------------
-// Third-party source files (Qwt)
-//----------------------------------------------------------------------------------------
-
-#include "qwt/src/qwt.cpp"
-#include "qwt/src/qwt_abstract_scale_draw.cpp"
-#include "qwt/src/qwt_bezier.cpp"
-#include "qwt/src/qwt_clipper.cpp"
-#include "qwt/src/qwt_color_map.cpp"
-#include "qwt/src/qwt_column_symbol.cpp"
-#include "qwt/src/qwt_date.cpp"
-#include "qwt/src/qwt_date_scale_draw.cpp"
-#include "qwt/src/qwt_date_scale_engine.cpp"
-#include "qwt/src/qwt_dyngrid_layout.cpp"
-#include "qwt/src/qwt_event_pattern.cpp"
-#include "qwt/src/qwt_graphic.cpp"
-#include "qwt/src/qwt_interval.cpp"
-#include "qwt/src/qwt_interval_symbol.cpp"
-#include "qwt/src/qwt_math.cpp"
-#include "qwt/src/qwt_magnifier.cpp"
-#include "qwt/src/qwt_null_paintdevice.cpp"
-#include "qwt/src/qwt_painter.cpp"
-#include "qwt/src/qwt_painter_command.cpp"
-#include "qwt/src/qwt_panner.cpp"
-#include "qwt/src/qwt_picker.cpp"
-#include "qwt/src/qwt_picker_machine.cpp"
-#include "qwt/src/qwt_pixel_matrix.cpp"
-#include "qwt/src/qwt_point_3d.cpp"
-#include "qwt/src/qwt_point_polar.cpp"
-#include "qwt/src/qwt_round_scale_draw.cpp"
-#include "qwt/src/qwt_scale_div.cpp"
-#include "qwt/src/qwt_scale_draw.cpp"
-#include "qwt/src/qwt_scale_map.cpp"
-#include "qwt/src/qwt_scale_engine.cpp"
-#include "qwt/src/qwt_spline.cpp"
-#include "qwt/src/qwt_spline_basis.cpp"
-#include "qwt/src/qwt_spline_parametrization.cpp"
-#include "qwt/src/qwt_spline_local.cpp"
-#include "qwt/src/qwt_spline_cubic.cpp"
-#include "qwt/src/qwt_spline_pleasing.cpp"
-#include "qwt/src/qwt_spline_polynomial.cpp"
-#include "qwt/src/qwt_symbol.cpp"
-#include "qwt/src/qwt_system_clock.cpp"
-#include "qwt/src/qwt_text_engine.cpp"
-#include "qwt/src/qwt_text_label.cpp"
-#include "qwt/src/qwt_text.cpp"
-#include "qwt/src/qwt_transform.cpp"
-#include "qwt/src/qwt_widget_overlay.cpp"
-#include "qwt/src/qwt_curve_fitter.cpp"
-#include "qwt/src/qwt_spline_curve_fitter.cpp"
-#include "qwt/src/qwt_weeding_curve_fitter.cpp"
-#include "qwt/src/qwt_abstract_legend.cpp"
-#include "qwt/src/qwt_legend.cpp"
-#include "qwt/src/qwt_legend_data.cpp"
-#include "qwt/src/qwt_legend_label.cpp"
-#include "qwt/src/qwt_plot.cpp"
-#include "qwt/src/qwt_plot_renderer.cpp"
-#include "qwt/src/qwt_plot_axis.cpp"
-#include "qwt/src/qwt_plot_curve.cpp"
-#include "qwt/src/qwt_plot_dict.cpp"
-#include "qwt/src/qwt_plot_directpainter.cpp"
-#include "qwt/src/qwt_plot_graphicitem.cpp"
-#include "qwt/src/qwt_plot_grid.cpp"
-#include "qwt/src/qwt_plot_histogram.cpp"
-#include "qwt/src/qwt_plot_item.cpp"
-#include "qwt/src/qwt_plot_abstract_barchart.cpp"
-#include "qwt/src/qwt_plot_barchart.cpp"
-#include "qwt/src/qwt_plot_multi_barchart.cpp"
-#include "qwt/src/qwt_plot_intervalcurve.cpp"
-#include "qwt/src/qwt_plot_zoneitem.cpp"
-#include "qwt/src/qwt_plot_tradingcurve.cpp"
-#include "qwt/src/qwt_plot_spectrogram.cpp"
-#include "qwt/src/qwt_plot_spectrocurve.cpp"
-#include "qwt/src/qwt_plot_scaleitem.cpp"
-#include "qwt/src/qwt_plot_legenditem.cpp"
-#include "qwt/src/qwt_plot_seriesitem.cpp"
-#include "qwt/src/qwt_plot_shapeitem.cpp"
-#include "qwt/src/qwt_plot_vectorfield.cpp"
-#include "qwt/src/qwt_plot_marker.cpp"
-#include "qwt/src/qwt_plot_textlabel.cpp"
-#include "qwt/src/qwt_plot_layout.cpp"
-#include "qwt/src/qwt_plot_abstract_canvas.cpp"
-#include "qwt/src/qwt_plot_canvas.cpp"
-#include "qwt/src/qwt_plot_panner.cpp"
-#include "qwt/src/qwt_plot_rasteritem.cpp"
-#include "qwt/src/qwt_plot_picker.cpp"
-#include "qwt/src/qwt_plot_zoomer.cpp"
-#include "qwt/src/qwt_plot_magnifier.cpp"
-#include "qwt/src/qwt_plot_rescaler.cpp"
-#include "qwt/src/qwt_point_mapper.cpp"
-#include "qwt/src/qwt_raster_data.cpp"
-#include "qwt/src/qwt_matrix_raster_data.cpp"
-#include "qwt/src/qwt_vectorfield_symbol.cpp"
-#include "qwt/src/qwt_sampling_thread.cpp"
-#include "qwt/src/qwt_series_data.cpp"
-#include "qwt/src/qwt_point_data.cpp"
-#include "qwt/src/qwt_scale_widget.cpp"
-#include "qwt/src/qwt_polar_canvas.cpp"
-#include "qwt/src/qwt_polar_curve.cpp"
-#include "qwt/src/qwt_polar_fitter.cpp"
-#include "qwt/src/qwt_polar_grid.cpp"
-#include "qwt/src/qwt_polar_item.cpp"
-#include "qwt/src/qwt_polar_itemdict.cpp"
-#include "qwt/src/qwt_polar_layout.cpp"
-#include "qwt/src/qwt_polar_magnifier.cpp"
-#include "qwt/src/qwt_polar_marker.cpp"
-#include "qwt/src/qwt_polar_panner.cpp"
-#include "qwt/src/qwt_polar_picker.cpp"
-#include "qwt/src/qwt_polar_plot.cpp"
-#include "qwt/src/qwt_polar_renderer.cpp"
-#include "qwt/src/qwt_polar_spectrogram.cpp"
-#include "qwt/src/qwt_abstract_slider.cpp"
-#include "qwt/src/qwt_abstract_scale.cpp"
-#include "qwt/src/qwt_arrow_button.cpp"
-#include "qwt/src/qwt_analog_clock.cpp"
-#include "qwt/src/qwt_compass.cpp"
-#include "qwt/src/qwt_compass_rose.cpp"
-#include "qwt/src/qwt_counter.cpp"
-#include "qwt/src/qwt_dial.cpp"
-#include "qwt/src/qwt_dial_needle.cpp"
-#include "qwt/src/qwt_knob.cpp"
-#include "qwt/src/qwt_slider.cpp"
-#include "qwt/src/qwt_thermo.cpp"
-#include "qwt/src/qwt_wheel.cpp"
-
-//----------------------------------------------------------------------------------------
-// Third-party source files (non-Qwt)
+// Third-party source files
 //----------------------------------------------------------------------------------------
+//
+// The bundled libraries (Qwt, QMapControl & QRealFourier) build as their own
+// single compilation units (see libs/*/**SingleCompilationUnit.cpp), so that the
+// compiler can work on them & on the application code in parallel. Only the
+// submodule-based libraries remain in this unit.
+//
 
 #include "qtcsv/sources/writer.cpp"
 #include "qtcsv/sources/variantdata.cpp"
@@ -422,77 +334,76 @@
 #include "qmqtt/src/mqtt/qmqtt_socket.cpp"
 #include "qmqtt/src/mqtt/qmqtt_timer.cpp"
 #include "qmqtt/src/mqtt/qmqtt_ssl_socket.cpp"
-#include "QRealFourier/sources/qcomplexnumber.cpp"
-#include "QRealFourier/sources/qfouriercalculator.cpp"
-#include "QRealFourier/sources/qfourierfixedcalculator.cpp"
-#include "QRealFourier/sources/qfouriertransformer.cpp"
-#include "QRealFourier/sources/qfouriervariablecalculator.cpp"
-#include "QRealFourier/sources/qwindowfunction.cpp"
 #include "QSimpleUpdater/src/Updater.cpp"
 #include "QSimpleUpdater/src/Downloader.cpp"
 #include "QSimpleUpdater/src/QSimpleUpdater.cpp"
-#include "QMapControl/src/curve.cpp"
-#include "QMapControl/src/geometry.cpp"
-#include "QMapControl/src/imagemanager.cpp"
-#include "QMapControl/src/layer.cpp"
-#include "QMapControl/src/layermanager.cpp"
-#include "QMapControl/src/linestring.cpp"
-#include "QMapControl/src/mapadapter.cpp"
-#include "QMapControl/src/mapcontrol.cpp"
-#include "QMapControl/src/mapnetwork.cpp"
-#include "QMapControl/src/point.cpp"
-#include "QMapControl/src/tilemapadapter.cpp"
-#include "QMapControl/src/wmsmapadapter.cpp"
-#include "QMapControl/src/circlepoint.cpp"
-#include "QMapControl/src/imagepoint.cpp"
-#include "QMapControl/src/gps_position.cpp"
-#include "QMapControl/src/osmmapadapter.cpp"
-#include "QMapControl/src/maplayer.cpp"
-#include "QMapControl/src/geometrylayer.cpp"
-#include "QMapControl/src/googlemapadapter.cpp"
-#include "QMapControl/src/openaerialmapadapter.cpp"
-#include "QMapControl/src/fixedimageoverlay.cpp"
-#include "QMapControl/src/emptymapadapter.cpp"
-#include "QMapControl/src/arrowpoint.cpp"
-#include "QMapControl/src/invisiblepoint.cpp"
-#include "QMapControl/src/bingapimapadapter.cpp"
-#include "QMapControl/src/googleapimapadapter.cpp"
 
 //----------------------------------------------------------------------------------------
 // App source files
 //----------------------------------------------------------------------------------------
 
+#include "CSV/ColumnarExport.cpp"
 #include "CSV/Export.cpp"
 #include "CSV/Player.cpp"
+#include "IO/Capture.cpp"
 #include "IO/Checksum.cpp"
+#include "IO/CircularBuffer.cpp"
 #include "IO/Console.cpp"
+#include "IO/DataSources/Generator.cpp"
 #include "IO/DataSources/Network.cpp"
 #include "IO/DataSources/Serial.cpp"
+#include "IO/DataSources/WebSocket.cpp"
+#include "IO/DataSources/Relay.cpp"
+#include "IO/FrameQueue.cpp"
+#include "IO/FrameReader.cpp"
 #include "IO/Manager.cpp"
+#include "IO/Pipeline.cpp"
+#include "IO/Replay.cpp"
+#include "IO/SequenceMatcher.cpp"
 #include "JSON/Dataset.cpp"
 #include "JSON/Editor.cpp"
+#include "JSON/Expressions.cpp"
 #include "JSON/Frame.cpp"
+#include "JSON/FrameParser.cpp"
 #include "JSON/Generator.cpp"
 #include "JSON/Group.cpp"
+#include "JSON/StringPool.cpp"
 #include "MQTT/Client.cpp"
+#include "Misc/Clock.cpp"
+#include "Misc/LatencyTracer.cpp"
 #include "Misc/MacExtras.cpp"
+#include "Misc/MemoryRegistry.cpp"
 #include "Misc/ModuleManager.cpp"
+#include "Misc/SessionSnapshot.cpp"
+#include "Misc/SettingsCache.cpp"
 #include "Misc/ThemeManager.cpp"
+#include "Misc/ThreadPolicy.cpp"
+#include "Misc/Watchdog.cpp"
 #include "Misc/TimerEvents.cpp"
 #include "Misc/Translator.cpp"
 #include "Misc/Utilities.cpp"
+#include "PgoTraining.cpp"
 #include "Plugins/Server.cpp"
+#include "UI/Alarms.cpp"
 #include "UI/Dashboard.cpp"
 #include "UI/DashboardWidget.cpp"
 #include "UI/DeclarativeWidget.cpp"
+#include "UI/HistoryStore.cpp"
+#include "UI/PaintProfiler.cpp"
+#include "UI/PlotBuffer.cpp"
+#include "UI/QuickPlot.cpp"
+#include "UI/Statistics.cpp"
 #include "UI/Widgets/Terminal.cpp"
 #include "UI/Widgets/Accelerometer.cpp"
 #include "UI/Widgets/Bar.cpp"
 #include "UI/Widgets/Common/AnalogGauge.cpp"
 #include "UI/Widgets/Common/AttitudeIndicator.cpp"
 #include "UI/Widgets/Common/BaseWidget.cpp"
+#include "UI/Widgets/Common/ConsoleView.cpp"
 #include "UI/Widgets/Common/ElidedLabel.cpp"
+#include "UI/Widgets/Common/FFTPlanCache.cpp"
 #include "UI/Widgets/Common/KLed.cpp"
+#include "UI/Widgets/Common/PlotSeriesData.cpp"
 #include "UI/Widgets/Compass.cpp"
 #include "UI/Widgets/DataGroup.cpp"
 #include "UI/Widgets/FFTPlot.cpp"
@@ -502,6 +413,7 @@
 #include "UI/Widgets/LEDPanel.cpp"
 #include "UI/Widgets/MultiPlot.cpp"
 #include "UI/Widgets/Plot.cpp"
+#include "UI/Widgets/Spectrogram.cpp"
 #include "main.cpp"
 
 //----------------------------------------------------------------------------------------
@@ -512,26 +424,6 @@
 #include "moc_qmqtt_socketinterface.cpp"
 #include "moc_qmqtt_timerinterface.cpp"
 
-#include "moc_curve.cpp"
-#include "moc_geometry.cpp"
-#include "moc_imagemanager.cpp"
-#include "moc_layer.cpp"
-#include "moc_layermanager.cpp"
-#include "moc_linestring.cpp"
-#include "moc_mapadapter.cpp"
-#include "moc_mapcontrol.cpp"
-#include "moc_mapnetwork.cpp"
-#include "moc_point.cpp"
-#include "moc_tilemapadapter.cpp"
-#include "moc_osmmapadapter.cpp"
-#include "moc_maplayer.cpp"
-#include "moc_geometrylayer.cpp"
-#include "moc_googlemapadapter.cpp"
-#include "moc_openaerialmapadapter.cpp"
-#include "moc_emptymapadapter.cpp"
-#include "moc_bingapimapadapter.cpp"
-#include "moc_googleapimapadapter.cpp"
-
 #ifdef Q_OS_MAC
 #include "moc_kdmactouchbar.cpp"
 #endif
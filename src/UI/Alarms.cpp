@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Alarms.h"
+
+#include <Misc/Clock.h>
+
+#include <JSON/Group.h>
+#include <JSON/Dataset.h>
+
+/**
+ * Constructor function
+ */
+UI::Alarms::Alarms()
+{
+}
+
+/**
+ * Returns the only instance of the class
+ */
+UI::Alarms &UI::Alarms::instance()
+{
+    static Alarms singleton;
+    return singleton;
+}
+
+/**
+ * Returns the number of latched alarm messages
+ */
+int UI::Alarms::count() const
+{
+    return m_alarmList.count();
+}
+
+/**
+ * Returns the latched alarm messages, newest last
+ */
+StringList UI::Alarms::alarms() const
+{
+    return m_alarmList;
+}
+
+/**
+ * Evaluates the alarm rules of every dataset of the given @a frame. The hot
+ * path is a handful of compares per dataset, messages & signals are only
+ * generated on rule state transitions.
+ *
+ * The latch states are rebuilt when the dataset layout of the frames
+ * changes, e.g. when another project file is loaded.
+ */
+void UI::Alarms::append(const JSON::Frame &frame)
+{
+    // Count the datasets of the frame & rebuild the latch states when the
+    // dataset layout differs from the one they were built for
+    int datasets = 0;
+    for (int g = 0; g < frame.groupCount(); ++g)
+        datasets += frame.getGroup(g).datasetCount();
+    if (datasets != m_channels.count())
+    {
+        m_channels.resize(datasets);
+        for (int i = 0; i < datasets; ++i)
+        {
+            m_channels[i].activeLow = false;
+            m_channels[i].activeHigh = false;
+            m_channels[i].activeRate = false;
+            m_channels[i].lastMsecs = 0;
+        }
+    }
+
+    // Evaluate the rules of every dataset
+    int column = 0;
+    const qint64 now = Misc::Clock::instance().currentMSecsSinceEpoch();
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.getGroup(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const auto &dataset = group.getDataset(d);
+            const double value = dataset.numericValue();
+            auto &channel = m_channels[column++];
+
+            // High level rule
+            if (dataset.alarm() != 0)
+            {
+                const bool violated = value > dataset.alarm();
+                if (violated && !channel.activeHigh)
+                    raise(group.title() + " / " + dataset.title(),
+                          tr("value above %1").arg(dataset.alarm()), value);
+                else if (!violated && channel.activeHigh)
+                    Q_EMIT alarmCleared(group.title() + " / "
+                                        + dataset.title());
+                channel.activeHigh = violated;
+            }
+
+            // Low level rule
+            if (dataset.alarmLow() != 0)
+            {
+                const bool violated = value < dataset.alarmLow();
+                if (violated && !channel.activeLow)
+                    raise(group.title() + " / " + dataset.title(),
+                          tr("value below %1").arg(dataset.alarmLow()), value);
+                else if (!violated && channel.activeLow)
+                    Q_EMIT alarmCleared(group.title() + " / "
+                                        + dataset.title());
+                channel.activeLow = violated;
+            }
+
+            // Rate-of-change rule, needs the value & arrival time of the
+            // previous frame
+            if (dataset.alarmRate() != 0 && channel.lastMsecs > 0
+                && now > channel.lastMsecs)
+            {
+                const double dt = (now - channel.lastMsecs) / 1000.0;
+                const double rate = qAbs(value - channel.lastValue) / dt;
+                const bool violated = rate > dataset.alarmRate();
+                if (violated && !channel.activeRate)
+                    raise(group.title() + " / " + dataset.title(),
+                          tr("rate of change above %1/s")
+                              .arg(dataset.alarmRate()),
+                          rate);
+                else if (!violated && channel.activeRate)
+                    Q_EMIT alarmCleared(group.title() + " / "
+                                        + dataset.title());
+                channel.activeRate = violated;
+            }
+
+            // Register value & arrival time for the rate rule
+            channel.lastValue = value;
+            channel.lastMsecs = now;
+        }
+    }
+}
+
+/**
+ * Discards the alarm list & the latch states, called by the dashboard
+ * whenever its own data model is reset (e.g. on device disconnection)
+ */
+void UI::Alarms::clear()
+{
+    m_channels.clear();
+    m_alarmList.clear();
+    Q_EMIT alarmsChanged();
+}
+
+/**
+ * Acknowledges the latched alarm messages & removes the badge from the
+ * dashboard title bar. Rules that are still violated raise a new message on
+ * their next inactive-to-active transition.
+ */
+void UI::Alarms::acknowledge()
+{
+    m_alarmList.clear();
+    Q_EMIT alarmsChanged();
+}
+
+/**
+ * Latches a new alarm message & notifies the UI and the plugin server
+ */
+void UI::Alarms::raise(const QString &title, const QString &reason,
+                       const double value)
+{
+    m_alarmList.append(
+        QString("%1: %2 (%3)").arg(title, reason, QString::number(value)));
+    Q_EMIT alarmRaised(title, reason, value);
+    Q_EMIT alarmsChanged();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Alarms.cpp"
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <DataTypes.h>
+#include <JSON/Frame.h>
+
+namespace UI
+{
+/**
+ * @brief The Alarms class
+ *
+ * Threshold alarm engine, evaluates the alarm rules of every dataset in the
+ * dashboard frame path. Three rules are supported per dataset, all defined
+ * in the JSON project editor & disabled when set to @c 0:
+ *
+ * - High level: the "alarm" attribute, raised when the value exceeds it.
+ * - Low level: the "alarmLow" attribute, raised when the value falls below.
+ * - Rate limit: the "alarmRate" attribute in units per second, raised when
+ *   the value changes faster than allowed.
+ *
+ * Each rule is a pair of compares & a latch per sample, orders of magnitude
+ * cheaper than streaming frames to an external limit-checking plugin.
+ * Triggered alarms are latched: the message stays in the alarm list (shown
+ * as a badge in the dashboard title bar) until the user acknowledges it,
+ * even if the value returns to its normal range. Raise/clear events are
+ * also broadcast to plugins by @c Plugins::Server.
+ */
+class Alarms : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(int count
+               READ count
+               NOTIFY alarmsChanged)
+    Q_PROPERTY(StringList alarms
+               READ alarms
+               NOTIFY alarmsChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void alarmsChanged();
+    void alarmCleared(const QString &title);
+    void alarmRaised(const QString &title, const QString &reason,
+                     const double value);
+
+private:
+    explicit Alarms();
+    Alarms(Alarms &&) = delete;
+    Alarms(const Alarms &) = delete;
+    Alarms &operator=(Alarms &&) = delete;
+    Alarms &operator=(const Alarms &) = delete;
+
+public:
+    static Alarms &instance();
+
+    int count() const;
+    StringList alarms() const;
+
+    void append(const JSON::Frame &frame);
+
+public Q_SLOTS:
+    void clear();
+    void acknowledge();
+
+private:
+    /**
+     * Latch state of the alarm rules of one dataset
+     */
+    struct Channel
+    {
+        bool activeLow;
+        bool activeHigh;
+        bool activeRate;
+        double lastValue;
+        qint64 lastMsecs;
+    };
+
+private:
+    void raise(const QString &title, const QString &reason,
+               const double value);
+
+private:
+    StringList m_alarmList;
+    QVector<Channel> m_channels;
+};
+}
@@ -20,12 +20,82 @@
  * THE SOFTWARE.
  */
 
+#include <cmath>
+#include <cstring>
+
+#include <QtMath>
+#include <QMetaMethod>
+#include <QDataStream>
+
 #include <IO/Manager.h>
 #include <IO/Console.h>
 #include <CSV/Player.h>
+#include <UI/Alarms.h>
 #include <UI/Dashboard.h>
+#include <UI/Statistics.h>
+#include <UI/HistoryStore.h>
 #include <JSON/Generator.h>
 #include <Misc/TimerEvents.h>
+#include <Misc/LatencyTracer.h>
+#include <Misc/Watchdog.h>
+
+/**
+ * Returns the number of samples stored for the plot of the given @a dataset,
+ * the per-dataset override of the project file takes precedence over the
+ * global point count of the dashboard
+ */
+static int PlotDepth(const JSON::Dataset &dataset)
+{
+    if (dataset.plotPoints() > 0)
+        return dataset.plotPoints();
+
+    return UI::Dashboard::instance().points();
+}
+
+/**
+ * Returns a compact fingerprint of the widget structure of the given @a frame: the
+ * group count, the widget type of every group & the dataset attributes that decide
+ * which dashboard widgets exist. Used to detect that a reconnected device streams
+ * the same frame structure as the previous session, in which case the existing
+ * widgets & plot buffers are reused instead of rebuilt (see @c onConnectedChanged()).
+ */
+static QByteArray FrameFingerprint(const JSON::Frame &frame)
+{
+    QByteArray fingerprint;
+    fingerprint.append(frame.fp32Storage() ? 'f' : 'd');
+    fingerprint.append(QByteArray::number(frame.groupCount()));
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto group = frame.groups().at(g);
+        fingerprint.append('|');
+        fingerprint.append(group.widget().toUtf8());
+        fingerprint.append(':');
+        fingerprint.append(QByteArray::number(group.datasetCount()));
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const auto dataset = group.getDataset(d);
+            fingerprint.append(',');
+            fingerprint.append(dataset.widget().toUtf8());
+            fingerprint.append(dataset.graph() ? '1' : '0');
+            fingerprint.append(dataset.fft() ? '1' : '0');
+            fingerprint.append(dataset.led() ? '1' : '0');
+
+            // Bit labels of bitmask datasets are structural, the LED panel
+            // generates its LED rows from them at construction time
+            if (dataset.ledBitmask())
+            {
+                const auto labels = dataset.ledLabels();
+                for (int b = 0; b < labels.count(); ++b)
+                {
+                    fingerprint.append(';');
+                    fingerprint.append(labels.at(b).toUtf8());
+                }
+            }
+        }
+    }
+
+    return fingerprint;
+}
 
 //----------------------------------------------------------------------------------------
 // Constructor/deconstructor & singleton
@@ -37,16 +107,44 @@
 UI::Dashboard::Dashboard()
     : m_points(100)
     , m_precision(2)
+    , m_groupUpdateRate(5)
+    , m_hardwareAcceleration(false)
+    , m_fftDecibels(false)
+    , m_framePending(false)
+    , m_stagedFrames(0)
+    , m_stagedFftStride(0)
+    , m_stagedLinearStride(0)
+    , m_stagedSpectrogramStride(0)
+    , m_widgetUpdateCycle(false)
+    , m_attributeRefreshPending(false)
+    , m_sessionValidationPending(false)
+    , m_triggerEnabled(false)
+    , m_triggerFrozen(false)
+    , m_triggerShown(false)
+    , m_triggerRisingEdge(true)
+    , m_triggerDataset(0)
+    , m_triggerCountdown(-1)
+    , m_triggerLevel(0)
+    , m_triggerPrevSample(0)
 {
+    // Start the timer that enforces the group widget update rate cap
+    m_groupElapsed.start();
+
     // clang-format off
     connect(&CSV::Player::instance(), &CSV::Player::openChanged,
             this, &UI::Dashboard::resetData);
     connect(&IO::Manager::instance(), &IO::Manager::connectedChanged,
-            this, &UI::Dashboard::resetData);
-    connect(&JSON::Generator::instance(), &JSON::Generator::jsonChanged,
-            this, &UI::Dashboard::processLatestJSON);
+            this, &UI::Dashboard::onConnectedChanged);
+    connect(&JSON::Generator::instance(), &JSON::Generator::frameChanged,
+            this, &UI::Dashboard::processLatestFrame);
     connect(&JSON::Generator::instance(), &JSON::Generator::jsonFileMapChanged,
             this, &UI::Dashboard::resetData);
+    connect(&JSON::Generator::instance(), &JSON::Generator::jsonMapAttributesChanged,
+            this, &UI::Dashboard::scheduleAttributeRefresh);
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi,
+            this, &UI::Dashboard::consumePendingFrame);
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUiSlice,
+            this, &UI::Dashboard::updateWidgetSlice);
     // clang-format on
 }
 
@@ -79,9 +177,51 @@ const JSON::Dataset &UI::Dashboard::getGauge(const int index) const       { retu
 const JSON::Group &UI::Dashboard::getGyroscope(const int index) const     { return m_gyroscopeWidgets.at(index);     }
 const JSON::Dataset &UI::Dashboard::getCompass(const int index) const     { return m_compassWidgets.at(index);       }
 const JSON::Group &UI::Dashboard::getMultiplot(const int index) const     { return m_multiPlotWidgets.at(index);     }
+const JSON::Dataset &UI::Dashboard::getSpectrogram(const int index) const { return m_spectrogramWidgets.at(index);   }
 const JSON::Group &UI::Dashboard::getAccelerometer(const int index) const { return m_accelerometerWidgets.at(index); }
 // clang-format on
 
+/**
+ * Returns the heading of the given compass widget in degrees, normalized to the
+ * [0, 360) range. Computed once per consumed frame by @c updateDerivedValues().
+ */
+double UI::Dashboard::compassHeading(const int index) const
+{
+    if (index < 0 || index >= m_compassHeadings.count())
+        return 0;
+
+    return m_compassHeadings.at(index);
+}
+
+/**
+ * Returns the attitude (pitch, roll & yaw) of the given gyroscope group.
+ * Computed once per consumed frame by @c updateDerivedValues(), so every widget
+ * fed by the group renders the same values.
+ */
+const UI::Dashboard::AttitudeValues &
+UI::Dashboard::gyroscopeValues(const int index) const
+{
+    static const AttitudeValues kEmptyAttitude;
+    if (index < 0 || index >= m_gyroscopeValues.count())
+        return kEmptyAttitude;
+
+    return m_gyroscopeValues.at(index);
+}
+
+/**
+ * Returns the acceleration vector & G-force magnitude of the given accelerometer
+ * group. Computed once per consumed frame by @c updateDerivedValues().
+ */
+const UI::Dashboard::AccelerationValues &
+UI::Dashboard::accelerometerValues(const int index) const
+{
+    static const AccelerationValues kEmptyAcceleration;
+    if (index < 0 || index >= m_accelerometerValues.count())
+        return kEmptyAcceleration;
+
+    return m_accelerometerValues.at(index);
+}
+
 //----------------------------------------------------------------------------------------
 // Misc member access functions
 //----------------------------------------------------------------------------------------
@@ -118,6 +258,97 @@ int UI::Dashboard::precision() const
     return m_precision;
 }
 
+/**
+ * Returns the maximum update rate (in Hz) of the text-heavy group, LED panel
+ * & bar widgets. These widgets display discrete values that nobody can read
+ * at the full UI framerate, so their repaints are capped to a much lower rate
+ * by skipping update ticks.
+ */
+int UI::Dashboard::groupUpdateRate() const
+{
+    return m_groupUpdateRate;
+}
+
+/**
+ * Returns @c true if the plot widgets shall render through an OpenGL canvas
+ * instead of the software-rasterized default canvas
+ */
+bool UI::Dashboard::hardwareAcceleration() const
+{
+    return m_hardwareAcceleration;
+}
+
+/**
+ * Returns @c true if the FFT plot widgets display the spectrum in decibels
+ * instead of raw averaged bin magnitudes
+ */
+bool UI::Dashboard::fftDecibels() const
+{
+    return m_fftDecibels;
+}
+
+/**
+ * Returns @c true if the plot widgets operate in triggered acquisition mode
+ * instead of the free-running scroll. In trigger mode the plots only redraw
+ * when the trigger condition fired & the capture window is complete.
+ */
+bool UI::Dashboard::triggerEnabled() const
+{
+    return m_triggerEnabled;
+}
+
+/**
+ * Returns the index of the plotted dataset that the trigger condition is
+ * evaluated on, the indexes follow the order of @c plotTitles()
+ */
+int UI::Dashboard::triggerDataset() const
+{
+    return m_triggerDataset;
+}
+
+/**
+ * Returns the level that the trigger source must cross to fire the trigger
+ */
+double UI::Dashboard::triggerLevel() const
+{
+    return m_triggerLevel;
+}
+
+/**
+ * Returns @c true if the trigger fires on a rising edge of the source signal,
+ * @c false if it fires on a falling edge
+ */
+bool UI::Dashboard::triggerRisingEdge() const
+{
+    return m_triggerRisingEdge;
+}
+
+/**
+ * Formats the given @a value with the number of decimal digits configured by the user.
+ *
+ * The generated strings are cached & keyed on the raw bit pattern of the value, so
+ * that repeated readings (or several widgets that display the same dataset) do not
+ * re-run the double to string conversion on every received frame.
+ */
+QString UI::Dashboard::formattedValue(const double value) const
+{
+    // Return the string generated the last time this value was formatted
+    quint64 key;
+    memcpy(&key, &value, sizeof(key));
+    const auto it = m_formattedValues.constFind(key);
+    if (it != m_formattedValues.constEnd())
+        return it.value();
+
+    // Avoid unbounded cache growth when the received data never repeats
+    if (m_formattedValues.count() >= 1000)
+        m_formattedValues.clear();
+
+    // Format the value & register it in the cache
+    const auto text = QString::number(value, 'f', precision());
+    m_formattedValues.insert(key, text);
+    return text;
+}
+
 /**
  * Returns @c true if the current JSON frame is valid and ready-to-use by the QML
  * interface.
@@ -155,6 +386,7 @@ int UI::Dashboard::totalWidgetCount() const
             compassCount() +
             multiPlotCount() +
             gyroscopeCount() +
+            spectrogramCount() +
             accelerometerCount();
     // clang-format on
 
@@ -172,6 +404,7 @@ int UI::Dashboard::groupCount() const         { return m_groupWidgets.count();
 int UI::Dashboard::compassCount() const       { return m_compassWidgets.count();       }
 int UI::Dashboard::gyroscopeCount() const     { return m_gyroscopeWidgets.count();     }
 int UI::Dashboard::multiPlotCount() const     { return m_multiPlotWidgets.count();     }
+int UI::Dashboard::spectrogramCount() const   { return m_spectrogramWidgets.count();   }
 int UI::Dashboard::accelerometerCount() const { return m_accelerometerWidgets.count(); }
 // clang-format on
 
@@ -188,21 +421,7 @@ int UI::Dashboard::accelerometerCount() const { return m_accelerometerWidgets.co
  */
 StringList UI::Dashboard::widgetTitles()
 {
-    // Warning: maintain same order as the view option repeaters in ViewOptions.qml!
-
-    // clang-format off
-    return groupTitles() +
-            multiPlotTitles() +
-            ledTitles() +
-            fftTitles() +
-            plotTitles() +
-            barTitles() +
-            gaugeTitles() +
-            compassTitles() +
-            gyroscopeTitles() +
-            accelerometerTitles() +
-            gpsTitles();
-    // clang-format on
+    return m_widgetTitles;
 }
 
 /**
@@ -225,68 +444,12 @@ StringList UI::Dashboard::widgetTitles()
  */
 int UI::Dashboard::relativeIndex(const int globalIndex) const
 {
-    //
-    // Warning: relative widget index should be calculated using the same order as defined
-    // by the UI::Dashboard::widgetTitles() function.
-    //
-
-    // Check if we should return group widget
-    int index = globalIndex;
-    if (index < groupCount())
-        return index;
-
-    // Check if we should return multi-plot widget
-    index -= groupCount();
-    if (index < multiPlotCount())
-        return index;
-
-    // Check if we should return LED widget
-    index -= multiPlotCount();
-    if (index < ledCount())
-        return index;
-
-    // Check if we should return FFT widget
-    index -= ledCount();
-    if (index < fftCount())
-        return index;
-
-    // Check if we should return plot widget
-    index -= fftCount();
-    if (index < plotCount())
-        return index;
-
-    // Check if we should return bar widget
-    index -= plotCount();
-    if (index < barCount())
-        return index;
-
-    // Check if we should return gauge widget
-    index -= barCount();
-    if (index < gaugeCount())
-        return index;
-
-    // Check if we should return compass widget
-    index -= gaugeCount();
-    if (index < compassCount())
-        return index;
-
-    // Check if we should return gyro widget
-    index -= compassCount();
-    if (index < gyroscopeCount())
-        return index;
+    // The lookup table is regenerated by updateWidgetLookupTables() whenever the
+    // widget layout of the frame changes
+    if (globalIndex < 0 || globalIndex >= m_relativeIndexes.count())
+        return -1;
 
-    // Check if we should return accelerometer widget
-    index -= gyroscopeCount();
-    if (index < accelerometerCount())
-        return index;
-
-    // Check if we should return map widget
-    index -= accelerometerCount();
-    if (index < gpsCount())
-        return index;
-
-    // Return unknown widget
-    return -1;
+    return m_relativeIndexes.at(globalIndex);
 }
 
 /**
@@ -322,6 +485,9 @@ bool UI::Dashboard::widgetVisible(const int globalIndex) const
         case WidgetType::FFT:
             visible = fftVisible(index);
             break;
+        case WidgetType::Spectrogram:
+            visible = spectrogramVisible(index);
+            break;
         case WidgetType::Plot:
             visible = plotVisible(index);
             break;
@@ -383,6 +549,9 @@ QString UI::Dashboard::widgetIcon(const int globalIndex) const
         case WidgetType::FFT:
             return "qrc:/icons/fft.svg";
             break;
+        case WidgetType::Spectrogram:
+            return "qrc:/icons/fft.svg";
+            break;
         case WidgetType::Plot:
             return "qrc:/icons/plot.svg";
             break;
@@ -421,6 +590,7 @@ QString UI::Dashboard::widgetIcon(const int globalIndex) const
  * - @c WidgetType::Group
  * - @c WidgetType::MultiPlot
  * - @c WidgetType::FFT
+ * - @c WidgetType::Spectrogram
  * - @c WidgetType::Plot
  * - @c WidgetType::Bar
  * - @c WidgetType::Gauge
@@ -445,72 +615,33 @@ QString UI::Dashboard::widgetIcon(const int globalIndex) const
  */
 UI::Dashboard::WidgetType UI::Dashboard::widgetType(const int globalIndex) const
 {
-    //
-    // Warning: relative widget index should be calculated using the same order as defined
-    // by the UI::Dashboard::widgetTitles() function.
-    //
-
-    // Unitialized widget loader class
-    if (globalIndex < 0)
+    // The lookup table is regenerated by updateWidgetLookupTables() whenever the
+    // widget layout of the frame changes
+    if (globalIndex < 0 || globalIndex >= m_widgetTypes.count())
         return WidgetType::Unknown;
 
-    // Check if we should return group widget
-    int index = globalIndex;
-    if (index < groupCount())
-        return WidgetType::Group;
-
-    // Check if we should return multi-plot widget
-    index -= groupCount();
-    if (index < multiPlotCount())
-        return WidgetType::MultiPlot;
-
-    // Check if we should return LED widget
-    index -= multiPlotCount();
-    if (index < ledCount())
-        return WidgetType::LED;
-
-    // Check if we should return FFT widget
-    index -= ledCount();
-    if (index < fftCount())
-        return WidgetType::FFT;
-
-    // Check if we should return plot widget
-    index -= fftCount();
-    if (index < plotCount())
-        return WidgetType::Plot;
-
-    // Check if we should return bar widget
-    index -= plotCount();
-    if (index < barCount())
-        return WidgetType::Bar;
-
-    // Check if we should return gauge widget
-    index -= barCount();
-    if (index < gaugeCount())
-        return WidgetType::Gauge;
-
-    // Check if we should return compass widget
-    index -= gaugeCount();
-    if (index < compassCount())
-        return WidgetType::Compass;
-
-    // Check if we should return gyro widget
-    index -= compassCount();
-    if (index < gyroscopeCount())
-        return WidgetType::Gyroscope;
-
-    // Check if we should return accelerometer widget
-    index -= gyroscopeCount();
-    if (index < accelerometerCount())
-        return WidgetType::Accelerometer;
-
-    // Check if we should return map widget
-    index -= accelerometerCount();
-    if (index < gpsCount())
-        return WidgetType::GPS;
-
-    // Return unknown widget
-    return WidgetType::Unknown;
+    return m_widgetTypes.at(globalIndex);
+}
+
+/**
+ * Returns @c true when the widget with the given @a globalIndex should be
+ * rendered through the scene graph plot item (see @c UI::QuickPlot) instead
+ * of the Qwt widget bridge. This is the case for plain plot widgets, whose
+ * curve can be uploaded to the render thread as line-strip vertex data
+ * without rasterizing the Qwt canvas into a pixmap first. Plots with a
+ * logarithmic scale & every other widget type keep the Qwt implementation,
+ * which also provides the pan/zoom navigation & the image export.
+ */
+bool UI::Dashboard::useQuickPlot(const int globalIndex) const
+{
+    if (widgetType(globalIndex) != WidgetType::Plot)
+        return false;
+
+    const int index = relativeIndex(globalIndex);
+    if (index < 0 || index >= plotCount())
+        return false;
+
+    return !getPlot(index).log();
 }
 
 //----------------------------------------------------------------------------------------
@@ -528,6 +659,7 @@ bool UI::Dashboard::gaugeVisible(const int index) const         { return getVisi
 bool UI::Dashboard::compassVisible(const int index) const       { return getVisibility(m_compassVisibility, index);       }
 bool UI::Dashboard::gyroscopeVisible(const int index) const     { return getVisibility(m_gyroscopeVisibility, index);     }
 bool UI::Dashboard::multiPlotVisible(const int index) const     { return getVisibility(m_multiPlotVisibility, index);     }
+bool UI::Dashboard::spectrogramVisible(const int index) const   { return getVisibility(m_spectrogramVisibility, index);   }
 bool UI::Dashboard::accelerometerVisible(const int index) const { return getVisibility(m_accelerometerVisibility, index); }
 // clang-format on
 
@@ -536,17 +668,18 @@ bool UI::Dashboard::accelerometerVisible(const int index) const { return getVisi
 //----------------------------------------------------------------------------------------
 
 // clang-format off
-StringList UI::Dashboard::gpsTitles()           { return groupTitles(m_gpsWidgets);           }
-StringList UI::Dashboard::ledTitles()           { return groupTitles(m_ledWidgets);           }
-StringList UI::Dashboard::groupTitles()         { return groupTitles(m_groupWidgets);         }
-StringList UI::Dashboard::barTitles()           { return datasetTitles(m_barWidgets);         }
-StringList UI::Dashboard::fftTitles()           { return datasetTitles(m_fftWidgets);         }
-StringList UI::Dashboard::plotTitles()          { return datasetTitles(m_plotWidgets);        }
-StringList UI::Dashboard::gaugeTitles()         { return datasetTitles(m_gaugeWidgets);       }
-StringList UI::Dashboard::compassTitles()       { return datasetTitles(m_compassWidgets);     }
-StringList UI::Dashboard::gyroscopeTitles()     { return groupTitles(m_gyroscopeWidgets);     }
-StringList UI::Dashboard::multiPlotTitles()     { return groupTitles(m_multiPlotWidgets);     }
-StringList UI::Dashboard::accelerometerTitles() { return groupTitles(m_accelerometerWidgets); }
+StringList UI::Dashboard::gpsTitles()           { return m_gpsTitleList;           }
+StringList UI::Dashboard::ledTitles()           { return m_ledTitleList;           }
+StringList UI::Dashboard::groupTitles()         { return m_groupTitleList;         }
+StringList UI::Dashboard::barTitles()           { return m_barTitleList;           }
+StringList UI::Dashboard::fftTitles()           { return m_fftTitleList;           }
+StringList UI::Dashboard::plotTitles()          { return m_plotTitleList;          }
+StringList UI::Dashboard::gaugeTitles()         { return m_gaugeTitleList;         }
+StringList UI::Dashboard::compassTitles()       { return m_compassTitleList;       }
+StringList UI::Dashboard::gyroscopeTitles()     { return m_gyroscopeTitleList;     }
+StringList UI::Dashboard::multiPlotTitles()     { return m_multiPlotTitleList;     }
+StringList UI::Dashboard::spectrogramTitles()   { return m_spectrogramTitleList;   }
+StringList UI::Dashboard::accelerometerTitles() { return m_accelerometerTitleList; }
 // clang-format on
 
 //----------------------------------------------------------------------------------------
@@ -560,9 +693,19 @@ void UI::Dashboard::setPoints(const int points)
         // Update number of points
         m_points = points;
 
-        // Clear values
-        m_fftPlotValues.clear();
-        m_linearPlotValues.clear();
+        // Resize the linear plot buffers in place, the most recent samples are
+        // kept so that tuning the window mid-investigation does not discard the
+        // transient the operator is looking at. Datasets with a per-dataset
+        // depth override do not follow the global point count & are skipped,
+        // the FFT & spectrogram buffers are sized by fftSamples() and are not
+        // affected by this setting at all.
+        for (int i = 0; i < m_linearPlotValues.count(); ++i)
+        {
+            if (i < m_plotWidgets.count() && m_plotWidgets.at(i).plotPoints() > 0)
+                continue;
+
+            m_linearPlotValues[i].resizePreserving(points);
+        }
 
         // Regenerate x-axis values
         m_xData.resize(points);
@@ -579,10 +722,91 @@ void UI::Dashboard::setPrecision(const int precision)
     if (m_precision != precision)
     {
         m_precision = precision;
+        m_formattedValues.clear();
         Q_EMIT precisionChanged();
     }
 }
 
+void UI::Dashboard::setGroupUpdateRate(const int rate)
+{
+    const int hz = qBound(1, rate, 60);
+    if (m_groupUpdateRate != hz)
+    {
+        m_groupUpdateRate = hz;
+        Q_EMIT groupUpdateRateChanged();
+    }
+}
+
+void UI::Dashboard::setTriggerEnabled(const bool enabled)
+{
+    if (m_triggerEnabled != enabled)
+    {
+        // Complete the pre-trigger history before the trigger state machine
+        // takes over the per-frame plot buffer appends
+        flushStagedPlotValues();
+
+        m_triggerEnabled = enabled;
+        m_triggerFrozen = false;
+        m_triggerShown = false;
+        m_triggerCountdown = -1;
+        Q_EMIT triggerChanged();
+    }
+}
+
+void UI::Dashboard::setTriggerDataset(const int dataset)
+{
+    if (m_triggerDataset != dataset)
+    {
+        m_triggerDataset = dataset;
+        m_triggerFrozen = false;
+        m_triggerShown = false;
+        m_triggerCountdown = -1;
+        Q_EMIT triggerChanged();
+    }
+}
+
+void UI::Dashboard::setTriggerLevel(const double level)
+{
+    if (m_triggerLevel != level)
+    {
+        m_triggerLevel = level;
+        m_triggerFrozen = false;
+        m_triggerShown = false;
+        m_triggerCountdown = -1;
+        Q_EMIT triggerChanged();
+    }
+}
+
+void UI::Dashboard::setTriggerRisingEdge(const bool rising)
+{
+    if (m_triggerRisingEdge != rising)
+    {
+        m_triggerRisingEdge = rising;
+        m_triggerFrozen = false;
+        m_triggerShown = false;
+        m_triggerCountdown = -1;
+        Q_EMIT triggerChanged();
+    }
+}
+
+void UI::Dashboard::setFftDecibels(const bool enabled)
+{
+    if (m_fftDecibels != enabled)
+    {
+        m_fftDecibels = enabled;
+        Q_EMIT fftDecibelsChanged();
+    }
+}
+
+void UI::Dashboard::setHardwareAcceleration(const bool enabled)
+{
+    if (m_hardwareAcceleration != enabled)
+    {
+        m_hardwareAcceleration = enabled;
+        Q_EMIT hardwareAccelerationChanged();
+    }
+}
+
 //----------------------------------------------------------------------------------------
 // Visibility-related slots
 //----------------------------------------------------------------------------------------
@@ -598,6 +822,7 @@ void UI::Dashboard::setGaugeVisible(const int i, const bool v)         { setVisi
 void UI::Dashboard::setCompassVisible(const int i, const bool v)       { setVisibility(m_compassVisibility, i, v);       }
 void UI::Dashboard::setGyroscopeVisible(const int i, const bool v)     { setVisibility(m_gyroscopeVisibility, i, v);     }
 void UI::Dashboard::setMultiplotVisible(const int i, const bool v)     { setVisibility(m_multiPlotVisibility, i, v);     }
+void UI::Dashboard::setSpectrogramVisible(const int i, const bool v)   { setVisibility(m_spectrogramVisibility, i, v);   }
 void UI::Dashboard::setAccelerometerVisible(const int i, const bool v) { setVisibility(m_accelerometerVisibility, i, v); }
 // clang-format on
 
@@ -611,12 +836,35 @@ void UI::Dashboard::setAccelerometerVisible(const int i, const bool v) { setVisi
  */
 void UI::Dashboard::resetData()
 {
-    // Make latest frame invalid
+    // Make latest frame invalid & discard any conflated frame that was not
+    // consumed yet, together with its staged plot values
+    m_framePending = false;
+    m_widgetUpdateCycle = false;
+    m_attributeRefreshPending = false;
+    clearStagedPlotValues();
+
+    // Forget the previous session, a reset invalidates the resume fingerprint
+    m_sessionFingerprint.clear();
+    m_sessionValidationPending = false;
     m_currentFrame.read(QJsonObject {});
+    m_pendingFrame.read(QJsonObject {});
+
+    // Re-arm the plot trigger, the configuration itself is kept
+    m_triggerFrozen = false;
+    m_triggerShown = false;
+    m_triggerCountdown = -1;
 
-    // Clear plot data
+    // Clear plot data & long-term dataset history, including any samples that
+    // a session snapshot restored but that were not applied yet
     m_fftPlotValues.clear();
     m_linearPlotValues.clear();
+    m_spectrogramPlotValues.clear();
+    m_restoredFftValues.clear();
+    m_restoredLinearValues.clear();
+    m_restoredSpectrogramValues.clear();
+    HistoryStore::instance().clear();
+    Statistics::instance().clear();
+    Alarms::instance().clear();
 
     // Clear widget data
     m_barWidgets.clear();
@@ -629,8 +877,14 @@ void UI::Dashboard::resetData()
     m_compassWidgets.clear();
     m_gyroscopeWidgets.clear();
     m_multiPlotWidgets.clear();
+    m_spectrogramWidgets.clear();
     m_accelerometerWidgets.clear();
 
+    // Clear derived sensor values
+    m_compassHeadings.clear();
+    m_gyroscopeValues.clear();
+    m_accelerometerValues.clear();
+
     // Clear widget visibility data
     m_barVisibility.clear();
     m_fftVisibility.clear();
@@ -642,30 +896,164 @@ void UI::Dashboard::resetData()
     m_compassVisibility.clear();
     m_gyroscopeVisibility.clear();
     m_multiPlotVisibility.clear();
+    m_spectrogramVisibility.clear();
     m_accelerometerVisibility.clear();
 
-    // Update UI
+    // Clear memoized title lists & lookup tables
+    updateWidgetLookupTables();
+
+    // Update UI, a reset clears every widget family so all the family
+    // notification signals are emitted
     Q_EMIT updated();
     Q_EMIT dataReset();
     Q_EMIT titleChanged();
+    Q_EMIT gpsWidgetsChanged();
+    Q_EMIT ledWidgetsChanged();
+    Q_EMIT barWidgetsChanged();
+    Q_EMIT fftWidgetsChanged();
+    Q_EMIT plotWidgetsChanged();
+    Q_EMIT groupWidgetsChanged();
+    Q_EMIT gaugeWidgetsChanged();
+    Q_EMIT compassWidgetsChanged();
+    Q_EMIT gyroscopeWidgetsChanged();
+    Q_EMIT multiPlotWidgetsChanged();
+    Q_EMIT spectrogramWidgetsChanged();
+    Q_EMIT accelerometerWidgetsChanged();
     Q_EMIT widgetCountChanged();
     Q_EMIT widgetVisibilityChanged();
 }
 
 /**
- * Regenerates the data displayed on the dashboard plots
+ * Registers an attribute-only edit of the active project file (reported by
+ * @c JSON::Generator::jsonMapAttributesChanged()). The widget layout did not
+ * change, so instead of resetting the dashboard we flag the edit & let the
+ * next @c consumePendingFrame() cycle refresh the memoized title lists & ask
+ * the live widgets to re-apply their configuration in place. Plot buffers,
+ * dataset history & statistics are deliberately preserved.
+ */
+void UI::Dashboard::scheduleAttributeRefresh()
+{
+    m_attributeRefreshPending = true;
+}
+
+/**
+ * Reacts to device connections & disconnections. A disconnect used to reset the
+ * dashboard right away, which made short device resets (e.g. flashing cycles)
+ * rebuild every widget from scratch a couple of seconds later. Instead, the
+ * dashboard is now kept on screen & the structure of the session is remembered:
+ * when the first frame of the next session matches the fingerprint, the existing
+ * widgets & plot buffers are reused and the dashboard resumes instantly (see
+ * @c processLatestFrame()). Sessions with a different frame structure, or
+ * disconnects without any data on screen, still trigger the full reset.
+ */
+void UI::Dashboard::onConnectedChanged()
+{
+    // Device disconnected with data on screen, remember the frame structure &
+    // defer the reset decision to the first frame of the next session
+    if (!IO::Manager::instance().connected() && m_currentFrame.isValid())
+    {
+        m_sessionFingerprint = FrameFingerprint(m_currentFrame);
+        m_sessionValidationPending = true;
+        return;
+    }
+
+    // Device re-connected while a resume decision is pending, keep waiting for
+    // the first frame of the new session
+    if (IO::Manager::instance().connected() && m_sessionValidationPending)
+        return;
+
+    // Nothing to resume, regular full reset
+    resetData();
+}
+
+/**
+ * Writes the display state of the dashboard into the given session snapshot
+ * stream: the fingerprint of the current frame structure & the contents of
+ * every plot buffer (see @c Misc::SessionSnapshot)
+ */
+void UI::Dashboard::serializeSnapshot(QDataStream &out) const
+{
+    // Fingerprint of the frame structure the buffers belong to
+    QByteArray fingerprint;
+    if (m_currentFrame.isValid())
+        fingerprint = FrameFingerprint(m_currentFrame);
+    out << fingerprint;
+
+    // Linearized contents of every plot buffer family
+    QVector<PlotData> fft;
+    QVector<PlotData> linear;
+    QVector<PlotData> spectrogram;
+    fft.resize(m_fftPlotValues.count());
+    linear.resize(m_linearPlotValues.count());
+    spectrogram.resize(m_spectrogramPlotValues.count());
+    for (int i = 0; i < m_fftPlotValues.count(); ++i)
+        m_fftPlotValues.at(i).linearize(fft[i]);
+    for (int i = 0; i < m_linearPlotValues.count(); ++i)
+        m_linearPlotValues.at(i).linearize(linear[i]);
+    for (int i = 0; i < m_spectrogramPlotValues.count(); ++i)
+        m_spectrogramPlotValues.at(i).linearize(spectrogram[i]);
+
+    out << fft;
+    out << linear;
+    out << spectrogram;
+}
+
+/**
+ * Restores the display state of the previous session from the given snapshot
+ * stream, called once at startup before any live data arrives.
+ *
+ * The plot samples cannot be applied immediately: the buffer layout is only
+ * known once the first live frame arrives, so the samples are parked in the
+ * restored-value stash & the session-resume fingerprint is armed. When the
+ * first frame of the new session matches the structure of the snapshot, the
+ * stashed samples are moved into the freshly built buffers (see
+ * @c applyRestoredPlotValues()); a different frame structure triggers the
+ * regular full reset, which also discards the stash.
+ */
+void UI::Dashboard::restoreSnapshot(QDataStream &in)
+{
+    QByteArray fingerprint;
+    in >> fingerprint;
+    in >> m_restoredFftValues;
+    in >> m_restoredLinearValues;
+    in >> m_restoredSpectrogramValues;
+
+    // Incomplete snapshot or no frame structure to validate against
+    if (in.status() != QDataStream::Ok || fingerprint.isEmpty())
+    {
+        m_restoredFftValues.clear();
+        m_restoredLinearValues.clear();
+        m_restoredSpectrogramValues.clear();
+        return;
+    }
+
+    // Let the first frame of the new session decide between resuming with the
+    // restored state & the regular cold start
+    m_sessionFingerprint = fingerprint;
+    m_sessionValidationPending = true;
+}
+
+/**
+ * Appends the plotted dataset values of the given @a frame to the plot buffers.
+ *
+ * This is the immediate per-frame path, only used while the trigger mode is
+ * active (the trigger state machine must evaluate every sample as it
+ * arrives). With the trigger off the values go through the staging area
+ * instead (see @c stagePlotValues()), which batches the buffer appends to the
+ * UI tick rate without losing any intermediate sample.
  */
-void UI::Dashboard::updatePlots()
+void UI::Dashboard::updatePlots(const JSON::Frame &frame)
 {
     // Initialize arrays that contain pointers to the
     // datasets that need to be plotted.
     QVector<JSON::Dataset> fftDatasets;
     QVector<JSON::Dataset> linearDatasets;
+    QVector<JSON::Dataset> spectrogramDatasets;
 
     // Create list with datasets that need to be graphed
-    for (int i = 0; i < m_currentFrame.groupCount(); ++i)
+    for (int i = 0; i < frame.groupCount(); ++i)
     {
-        auto group = m_currentFrame.groups().at(i);
+        auto group = frame.groups().at(i);
         for (int j = 0; j < group.datasetCount(); ++j)
         {
             auto dataset = group.getDataset(j);
@@ -673,69 +1061,408 @@ void UI::Dashboard::updatePlots()
                 fftDatasets.append(dataset);
             if (dataset.graph())
                 linearDatasets.append(dataset);
+            if (dataset.spectrogram())
+                spectrogramDatasets.append(dataset);
         }
     }
 
-    // Check if we need to update dataset points
-    if (m_linearPlotValues.count() != linearDatasets.count())
+    // Re-sync the plot buffers with the dataset layout of the frame
+    syncPlotBuffers(fftDatasets, linearDatasets, spectrogramDatasets,
+                    frame.fp32Storage());
+
+    // Append latest values to linear plot data, this is a constant-time
+    // operation because the plot buffers are circular. In trigger mode the
+    // appends go through the trigger state machine instead.
+    if (!m_triggerEnabled)
+    {
+        for (int i = 0; i < linearDatasets.count(); ++i)
+            m_linearPlotValues[i].append(linearDatasets[i].numericValue());
+    }
+
+    else
+        updateTriggeredPlots(linearDatasets);
+
+    // Append latest values to FFT plot data
+    for (int i = 0; i < fftDatasets.count(); ++i)
+        m_fftPlotValues[i].append(fftDatasets[i].numericValue());
+
+    // Append latest values to spectrogram plot data
+    for (int i = 0; i < spectrogramDatasets.count(); ++i)
+        m_spectrogramPlotValues[i].append(spectrogramDatasets[i].numericValue());
+}
+
+/**
+ * Resizes & re-allocates the plot buffers when the given dataset lists do not
+ * match the current buffer layout anymore: a plotted dataset appeared or
+ * disappeared, the history depth of a dataset changed or the storage
+ * precision (@a fp32) of the project changed.
+ */
+void UI::Dashboard::syncPlotBuffers(const QVector<JSON::Dataset> &fftDatasets,
+                                    const QVector<JSON::Dataset> &linearDatasets,
+                                    const QVector<JSON::Dataset> &spectrogramDatasets,
+                                    const bool fp32)
+{
+    // Check if we need to update dataset points, either because the number of
+    // plotted datasets changed, because the history depth of a dataset does
+    // not match the buffer anymore or because the storage precision of the
+    // project changed
+    bool rebuildBuffers = (m_linearPlotValues.count() != linearDatasets.count());
+    for (int i = 0; !rebuildBuffers && i < linearDatasets.count(); ++i)
+        rebuildBuffers = (m_linearPlotValues.at(i).count() != PlotDepth(linearDatasets.at(i)))
+            || (m_linearPlotValues.at(i).floatStorage() != fp32);
+
+    if (rebuildBuffers)
     {
         m_linearPlotValues.clear();
 
         for (int i = 0; i < linearDatasets.count(); ++i)
         {
-            m_linearPlotValues.append(PlotData());
-            m_linearPlotValues.last().resize(points());
-
-            // clang-format off
-            std::fill(m_linearPlotValues.last().begin(),
-                      m_linearPlotValues.last().end(),
-                      0.0001);
-            // clang-format on
+            m_linearPlotValues.append(PlotBuffer());
+            m_linearPlotValues.last().setFloatStorage(fp32);
+            m_linearPlotValues.last().resize(PlotDepth(linearDatasets.at(i)));
+            m_linearPlotValues.last().fill(0.0001);
         }
     }
 
     // Check if we need to update FFT dataset points
-    if (m_fftPlotValues.count() != fftDatasets.count())
+    if (m_fftPlotValues.count() != fftDatasets.count()
+        || (!m_fftPlotValues.isEmpty() && m_fftPlotValues.at(0).floatStorage() != fp32))
     {
         m_fftPlotValues.clear();
 
         for (int i = 0; i < fftDatasets.count(); ++i)
         {
-            m_fftPlotValues.append(PlotData());
+            m_fftPlotValues.append(PlotBuffer());
+            m_fftPlotValues.last().setFloatStorage(fp32);
             m_fftPlotValues.last().resize(fftDatasets[i].fftSamples());
+            m_fftPlotValues.last().fill(0);
+        }
+    }
+
+    // Check if we need to update spectrogram dataset points, the spectrogram
+    // widgets transform the same fixed-size sample windows as the FFT plots
+    if (m_spectrogramPlotValues.count() != spectrogramDatasets.count()
+        || (!m_spectrogramPlotValues.isEmpty()
+            && m_spectrogramPlotValues.at(0).floatStorage() != fp32))
+    {
+        m_spectrogramPlotValues.clear();
 
-            // clang-format off
-            std::fill(m_fftPlotValues.last().begin(),
-                      m_fftPlotValues.last().end(),
-                      0);
-            // clang-format on
+        for (int i = 0; i < spectrogramDatasets.count(); ++i)
+        {
+            m_spectrogramPlotValues.append(PlotBuffer());
+            m_spectrogramPlotValues.last().setFloatStorage(fp32);
+            m_spectrogramPlotValues.last().resize(spectrogramDatasets[i].fftSamples());
+            m_spectrogramPlotValues.last().fill(0);
         }
     }
 
-    // Append latest values to linear plot data
-    for (int i = 0; i < linearDatasets.count(); ++i)
+    // Move the plot samples of a restored session snapshot into the buffers
+    // now that the live frame defined their layout
+    applyRestoredPlotValues();
+}
+
+/**
+ * Moves the plot samples restored from a session snapshot into the plot
+ * buffers, called once the first live frame defined the buffer layout. The
+ * stash is dropped when the buffer counts do not match the snapshot (the
+ * project layout changed since it was written) & is cleared afterwards either
+ * way, so the copy happens at most once per session.
+ */
+void UI::Dashboard::applyRestoredPlotValues()
+{
+    // Fast path, nothing was restored (or it was already applied)
+    if (m_restoredFftValues.isEmpty() && m_restoredLinearValues.isEmpty()
+        && m_restoredSpectrogramValues.isEmpty())
+        return;
+
+    // Refill the buffers in chronological order, the circular buffers keep
+    // the newest samples when a depth setting shrank since the snapshot
+    if (m_restoredFftValues.count() == m_fftPlotValues.count()
+        && m_restoredLinearValues.count() == m_linearPlotValues.count()
+        && m_restoredSpectrogramValues.count() == m_spectrogramPlotValues.count())
     {
-        auto data = m_linearPlotValues[i].data();
-        auto count = m_linearPlotValues[i].count();
-        memmove(data, data + 1, count * sizeof(double));
-        m_linearPlotValues[i][count - 1] = linearDatasets[i].value().toDouble();
+        for (int i = 0; i < m_restoredFftValues.count(); ++i)
+            for (int s = 0; s < m_restoredFftValues.at(i).count(); ++s)
+                m_fftPlotValues[i].append(m_restoredFftValues.at(i).at(s));
+        for (int i = 0; i < m_restoredLinearValues.count(); ++i)
+            for (int s = 0; s < m_restoredLinearValues.at(i).count(); ++s)
+                m_linearPlotValues[i].append(m_restoredLinearValues.at(i).at(s));
+        for (int i = 0; i < m_restoredSpectrogramValues.count(); ++i)
+            for (int s = 0; s < m_restoredSpectrogramValues.at(i).count(); ++s)
+                m_spectrogramPlotValues[i].append(
+                    m_restoredSpectrogramValues.at(i).at(s));
     }
 
-    // Append latest values to FFT plot data
-    for (int i = 0; i < fftDatasets.count(); ++i)
+    m_restoredFftValues.clear();
+    m_restoredLinearValues.clear();
+    m_restoredSpectrogramValues.clear();
+}
+
+/**
+ * Registers the plotted dataset values of the given @a frame in the staging
+ * area, from where the next UI tick appends them to the plot buffers in one
+ * batched pass (see @c flushStagedPlotValues()).
+ *
+ * This is the per-frame cost of the display path when the trigger mode is
+ * off: a flag scan over the datasets & one double per plotted value, with no
+ * dataset copies & no buffer layout checks. A layout change between two ticks
+ * drops the staged batch, the buffers are rebuilt on the flush anyway.
+ */
+void UI::Dashboard::stagePlotValues(const JSON::Frame &frame)
+{
+    // Count the plotted datasets of the frame
+    int fftC = 0;
+    int linearC = 0;
+    int spectrogramC = 0;
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.getGroup(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const auto &dataset = group.getDataset(d);
+            if (dataset.fft())
+                ++fftC;
+            if (dataset.graph())
+                ++linearC;
+            if (dataset.spectrogram())
+                ++spectrogramC;
+        }
+    }
+
+    // The dataset layout changed mid-batch, drop the staged values
+    if (m_stagedFrames > 0
+        && (fftC != m_stagedFftStride || linearC != m_stagedLinearStride
+            || spectrogramC != m_stagedSpectrogramStride))
+        clearStagedPlotValues();
+
+    // First frame of the batch, register the value strides
+    if (m_stagedFrames == 0)
     {
-        auto data = m_fftPlotValues[i].data();
-        auto count = m_fftPlotValues[i].count();
-        memmove(data, data + 1, count * sizeof(double));
-        m_fftPlotValues[i][count - 1] = fftDatasets[i].value().toDouble();
+        m_stagedFftStride = fftC;
+        m_stagedLinearStride = linearC;
+        m_stagedSpectrogramStride = spectrogramC;
     }
+
+    // Append the plotted values of the frame to the flattened staging vectors
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.getGroup(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const auto &dataset = group.getDataset(d);
+            if (dataset.fft() || dataset.graph() || dataset.spectrogram())
+            {
+                const double value = dataset.numericValue();
+                if (dataset.fft())
+                    m_stagedFftValues.append(value);
+                if (dataset.graph())
+                    m_stagedLinearValues.append(value);
+                if (dataset.spectrogram())
+                    m_stagedSpectrogramValues.append(value);
+            }
+        }
+    }
+
+    ++m_stagedFrames;
 }
 
 /**
- * Regenerates the data displayed on the dashboard widgets
+ * Appends the staged plot values of every frame received since the previous
+ * UI tick to the plot buffers, in frame order. No intermediate sample is
+ * lost: the plots still see every value, but the buffer layout checks & the
+ * dataset list construction run once per tick instead of once per frame, so
+ * the display-path CPU cost scales with the UI refresh rate instead of the
+ * device frame rate.
  */
-void UI::Dashboard::processLatestJSON(const QJsonObject &json)
+void UI::Dashboard::flushStagedPlotValues()
 {
+    // Nothing staged since the previous flush
+    if (m_stagedFrames <= 0)
+        return;
+
+    // Build the dataset lists of the newest frame & re-sync the plot buffers
+    QVector<JSON::Dataset> fftDatasets;
+    QVector<JSON::Dataset> linearDatasets;
+    QVector<JSON::Dataset> spectrogramDatasets;
+    for (int i = 0; i < m_pendingFrame.groupCount(); ++i)
+    {
+        auto group = m_pendingFrame.groups().at(i);
+        for (int j = 0; j < group.datasetCount(); ++j)
+        {
+            auto dataset = group.getDataset(j);
+            if (dataset.fft())
+                fftDatasets.append(dataset);
+            if (dataset.graph())
+                linearDatasets.append(dataset);
+            if (dataset.spectrogram())
+                spectrogramDatasets.append(dataset);
+        }
+    }
+
+    syncPlotBuffers(fftDatasets, linearDatasets, spectrogramDatasets,
+                    m_pendingFrame.fp32Storage());
+
+    // The staged batch must match the layout of the current buffers
+    if (fftDatasets.count() != m_stagedFftStride
+        || linearDatasets.count() != m_stagedLinearStride
+        || spectrogramDatasets.count() != m_stagedSpectrogramStride)
+    {
+        clearStagedPlotValues();
+        return;
+    }
+
+    // Batched append of the intermediate values, constant-time per value
+    // because the plot buffers are circular
+    for (int f = 0; f < m_stagedFrames; ++f)
+    {
+        const int fftBase = f * m_stagedFftStride;
+        const int linearBase = f * m_stagedLinearStride;
+        const int spectrogramBase = f * m_stagedSpectrogramStride;
+
+        for (int i = 0; i < m_stagedLinearStride; ++i)
+            m_linearPlotValues[i].append(m_stagedLinearValues.at(linearBase + i));
+        for (int i = 0; i < m_stagedFftStride; ++i)
+            m_fftPlotValues[i].append(m_stagedFftValues.at(fftBase + i));
+        for (int i = 0; i < m_stagedSpectrogramStride; ++i)
+            m_spectrogramPlotValues[i].append(
+                m_stagedSpectrogramValues.at(spectrogramBase + i));
+    }
+
+    clearStagedPlotValues();
+}
+
+/**
+ * Drops the staged plot values & resets the staging strides
+ */
+void UI::Dashboard::clearStagedPlotValues()
+{
+    m_stagedFrames = 0;
+    m_stagedFftStride = 0;
+    m_stagedLinearStride = 0;
+    m_stagedSpectrogramStride = 0;
+    m_stagedFftValues.resize(0);
+    m_stagedLinearValues.resize(0);
+    m_stagedSpectrogramValues.resize(0);
+}
+
+/**
+ * Trigger-mode variant of the plot buffer append loop, runs on the ingestion
+ * side for every received frame.
+ *
+ * While the trigger is armed the buffers fill normally, so the circular
+ * history doubles as the pre-trigger window. When the source dataset crosses
+ * the trigger level on the configured slope, half a buffer of post-trigger
+ * samples is captured & the waveform is frozen until the plots displayed it;
+ * new samples are dropped during that time so that the capture cannot be
+ * overwritten before it is rendered. The display side re-arms the trigger on
+ * the UI tick after the capture was shown.
+ */
+void UI::Dashboard::updateTriggeredPlots(const QVector<JSON::Dataset> &datasets)
+{
+    // Waveform captured & not displayed yet, ignore the new samples
+    if (m_triggerFrozen)
+        return;
+
+    // Invalid trigger source, keep the buffers free-running
+    const bool validSource = (m_triggerDataset >= 0 && m_triggerDataset < datasets.count());
+
+    // Register the new samples, the circular history is the pre-trigger
+    // window of the next capture
+    for (int i = 0; i < datasets.count(); ++i)
+        m_linearPlotValues[i].append(datasets[i].numericValue());
+    if (!validSource)
+        return;
+
+    // Armed, check if the source signal crossed the trigger level
+    const double sample = datasets.at(m_triggerDataset).numericValue();
+    if (m_triggerCountdown < 0)
+    {
+        bool fired;
+        if (m_triggerRisingEdge)
+            fired = (m_triggerPrevSample < m_triggerLevel && sample >= m_triggerLevel);
+        else
+            fired = (m_triggerPrevSample > m_triggerLevel && sample <= m_triggerLevel);
+
+        if (fired)
+            m_triggerCountdown = qMax(1, m_linearPlotValues.at(m_triggerDataset).count() / 2);
+    }
+
+    // Triggered, count down the post-trigger half of the capture window
+    else if (--m_triggerCountdown <= 0)
+    {
+        m_triggerFrozen = true;
+        m_triggerCountdown = -1;
+        Q_EMIT triggered();
+    }
+
+    // Remember the sample for the next slope evaluation
+    m_triggerPrevSample = sample;
+}
+
+/**
+ * Stores the given @a frame in the latest-frame slot & appends its dataset
+ * values to the plot buffers.
+ *
+ * This slot runs for every received frame, so it is kept as cheap as possible:
+ * the frame copy only increases the reference count of the implicitly shared
+ * group & dataset vectors. The expensive widget rebuild runs at most once per
+ * UI tick in @c consumePendingFrame(), intermediate frames are conflated and
+ * only contribute their dataset values to the plots.
+ */
+void UI::Dashboard::processLatestFrame(const JSON::Frame &frame)
+{
+    // Ignore invalid frames
+    if (!frame.isValid())
+        return;
+
+    // First frame after a device reset: when the structure matches the previous
+    // session the widgets, plot buffers & history are reused as-is, otherwise
+    // fall back to the full dashboard rebuild
+    if (m_sessionValidationPending)
+    {
+        m_sessionValidationPending = false;
+        if (FrameFingerprint(frame) != m_sessionFingerprint)
+            resetData();
+    }
+
+    // Register the dataset values of the frame on the display path: staged
+    // for the batched plot append of the next UI tick, or fed through the
+    // trigger state machine immediately (the trigger must evaluate every
+    // sample as it arrives). The history, statistics & alarm paths below see
+    // every frame regardless of the display refresh rate.
+    if (m_triggerEnabled)
+        updatePlots(frame);
+    else
+        stagePlotValues(frame);
+    HistoryStore::instance().append(frame);
+    Statistics::instance().append(frame);
+    Alarms::instance().append(frame);
+
+    // Store the frame in the latest-frame slot, the next UI tick consumes
+    // only the newest frame
+    m_pendingFrame = frame;
+    m_framePending = true;
+}
+
+/**
+ * Regenerates the data displayed on the dashboard widgets from the newest
+ * frame received since the previous UI tick. Invoked by the adaptive UI timer
+ * of @c Misc::TimerEvents, which also drives the widget repaints.
+ */
+void UI::Dashboard::consumePendingFrame()
+{
+    // No frame received since the previous tick, nothing to do
+    if (!m_framePending)
+        return;
+    m_framePending = false;
+
+    // Tag this handler so that event-loop stall reports can blame it
+    Misc::WatchdogActivity activity("UI::Dashboard frame processing");
+
+    // Move the plotted values of the conflated frames into the plot buffers,
+    // the widgets read them during the update slices of this UI interval
+    flushStagedPlotValues();
+
     // Save widget count
     const int barC = barCount();
     const int fftC = fftCount();
@@ -747,56 +1474,94 @@ void UI::Dashboard::processLatestJSON(const QJsonObject &json)
     const int compassC = compassCount();
     const int gyroscopeC = gyroscopeCount();
     const int multiPlotC = multiPlotCount();
+    const int spectrogramC = spectrogramCount();
     const int accelerometerC = accelerometerCount();
 
     // Save previous title
     auto pTitle = title();
 
-    // Try to read latest frame for widget updating
-    if (!m_currentFrame.read(json))
-        return;
+    // Copy the frame model, this is cheap because the group & dataset
+    // vectors are implicitly shared
+    m_currentFrame = m_pendingFrame;
 
-    // Regenerate plot data
-    updatePlots();
-
-    // Update widget vectors
-    m_fftWidgets = getFFTWidgets();
-    m_ledWidgets = getLEDWidgets();
-    m_plotWidgets = getPlotWidgets();
-    m_groupWidgets = getWidgetGroups("");
-    m_gpsWidgets = getWidgetGroups("map");
-    m_barWidgets = getWidgetDatasets("bar");
-    m_gaugeWidgets = getWidgetDatasets("gauge");
-    m_gyroscopeWidgets = getWidgetGroups("gyro");
-    m_compassWidgets = getWidgetDatasets("compass");
-    m_multiPlotWidgets = getWidgetGroups("multiplot");
-    m_accelerometerWidgets = getWidgetGroups("accelerometer");
-
-    // Add accelerometer widgets to multiplot
-    for (int i = 0; i < m_accelerometerWidgets.count(); ++i)
-        m_multiPlotWidgets.append(m_accelerometerWidgets.at(i));
+    // Update the widget vectors in place while the widget layout of the
+    // frame does not change, only re-build (and re-allocate) the vectors when
+    // a widget slot appears or disappears
+    if (!refreshWidgetVectors())
+    {
+        m_fftWidgets = getFFTWidgets();
+        m_ledWidgets = getLEDWidgets();
+        m_plotWidgets = getPlotWidgets();
+        m_groupWidgets = getWidgetGroups("");
+        m_gpsWidgets = getWidgetGroups("map");
+        m_barWidgets = getWidgetDatasets("bar");
+        m_gaugeWidgets = getWidgetDatasets("gauge");
+        m_gyroscopeWidgets = getWidgetGroups("gyro");
+        m_compassWidgets = getWidgetDatasets("compass");
+        m_multiPlotWidgets = getWidgetGroups("multiplot");
+        m_spectrogramWidgets = getSpectrogramWidgets();
+        m_accelerometerWidgets = getWidgetGroups("accelerometer");
+
+        // Add accelerometer widgets to multiplot
+        for (int i = 0; i < m_accelerometerWidgets.count(); ++i)
+            m_multiPlotWidgets.append(m_accelerometerWidgets.at(i));
+
+        // Add gyroscope widgets to multiplot
+        for (int i = 0; i < m_gyroscopeWidgets.count(); ++i)
+            m_multiPlotWidgets.append(m_gyroscopeWidgets.at(i));
+
+        // Regenerate the memoized title lists & lookup tables
+        updateWidgetLookupTables();
+    }
 
-    // Add gyroscope widgets to multiplot
-    for (int i = 0; i < m_gyroscopeWidgets.count(); ++i)
-        m_multiPlotWidgets.append(m_gyroscopeWidgets.at(i));
+    // Evaluate the derived sensor values (attitude, G-force, heading) shared by
+    // the widgets once, instead of once per widget instance
+    updateDerivedValues();
+
+    // Apply a pending attribute-only project edit: the widget layout is unchanged,
+    // so we only need to regenerate the memoized title lists & ask the live widgets
+    // to re-apply their configuration in place (see @c scheduleAttributeRefresh())
+    if (m_attributeRefreshPending)
+    {
+        m_attributeRefreshPending = false;
+        updateWidgetLookupTables();
+        Q_EMIT projectAttributesChanged();
+    }
 
     // Check if we need to update title
     if (pTitle != title())
         Q_EMIT titleChanged();
 
+    // Check which widget families changed, every family has its own
+    // notification signal so that QML only re-evaluates the count & title
+    // bindings of the families that actually changed
+    const bool barChanged = (barC != barCount());
+    const bool fftChanged = (fftC != fftCount());
+    const bool gpsChanged = (gpsC != gpsCount());
+    const bool ledChanged = (ledC != ledCount());
+    const bool plotChanged = (plotC != plotCount());
+    const bool gaugeChanged = (gaugeC != gaugeCount());
+    const bool groupChanged = (groupC != groupCount());
+    const bool compassChanged = (compassC != compassCount());
+    const bool gyroscopeChanged = (gyroscopeC != gyroscopeCount());
+    const bool multiPlotChanged = (multiPlotC != multiPlotCount());
+    const bool spectrogramChanged = (spectrogramC != spectrogramCount());
+    const bool accelerometerChanged = (accelerometerC != accelerometerCount());
+
     // Check if we need to regenerate widgets
     bool regenerateWidgets = false;
-    regenerateWidgets |= (barC != barCount());
-    regenerateWidgets |= (fftC != fftCount());
-    regenerateWidgets |= (gpsC != gpsCount());
-    regenerateWidgets |= (ledC != ledCount());
-    regenerateWidgets |= (plotC != plotCount());
-    regenerateWidgets |= (gaugeC != gaugeCount());
-    regenerateWidgets |= (groupC != groupCount());
-    regenerateWidgets |= (compassC != compassCount());
-    regenerateWidgets |= (gyroscopeC != gyroscopeCount());
-    regenerateWidgets |= (multiPlotC != multiPlotCount());
-    regenerateWidgets |= (accelerometerC != accelerometerCount());
+    regenerateWidgets |= barChanged;
+    regenerateWidgets |= fftChanged;
+    regenerateWidgets |= gpsChanged;
+    regenerateWidgets |= ledChanged;
+    regenerateWidgets |= plotChanged;
+    regenerateWidgets |= gaugeChanged;
+    regenerateWidgets |= groupChanged;
+    regenerateWidgets |= compassChanged;
+    regenerateWidgets |= gyroscopeChanged;
+    regenerateWidgets |= multiPlotChanged;
+    regenerateWidgets |= spectrogramChanged;
+    regenerateWidgets |= accelerometerChanged;
 
     // Regenerate widget visiblity models
     if (regenerateWidgets)
@@ -811,6 +1576,7 @@ void UI::Dashboard::processLatestJSON(const QJsonObject &json)
         m_compassVisibility.resize(compassCount());
         m_gyroscopeVisibility.resize(gyroscopeCount());
         m_multiPlotVisibility.resize(multiPlotCount());
+        m_spectrogramVisibility.resize(spectrogramCount());
         m_accelerometerVisibility.resize(accelerometerCount());
         std::fill(m_barVisibility.begin(), m_barVisibility.end(), 1);
         std::fill(m_fftVisibility.begin(), m_fftVisibility.end(), 1);
@@ -822,20 +1588,310 @@ void UI::Dashboard::processLatestJSON(const QJsonObject &json)
         std::fill(m_compassVisibility.begin(), m_compassVisibility.end(), 1);
         std::fill(m_gyroscopeVisibility.begin(), m_gyroscopeVisibility.end(), 1);
         std::fill(m_multiPlotVisibility.begin(), m_multiPlotVisibility.end(), 1);
+        std::fill(m_spectrogramVisibility.begin(), m_spectrogramVisibility.end(), 1);
         std::fill(m_accelerometerVisibility.begin(), m_accelerometerVisibility.end(), 1);
 
+        // Notify only the widget families that changed
+        if (barChanged)
+            Q_EMIT barWidgetsChanged();
+        if (fftChanged)
+            Q_EMIT fftWidgetsChanged();
+        if (gpsChanged)
+            Q_EMIT gpsWidgetsChanged();
+        if (ledChanged)
+            Q_EMIT ledWidgetsChanged();
+        if (plotChanged)
+            Q_EMIT plotWidgetsChanged();
+        if (gaugeChanged)
+            Q_EMIT gaugeWidgetsChanged();
+        if (groupChanged)
+            Q_EMIT groupWidgetsChanged();
+        if (compassChanged)
+            Q_EMIT compassWidgetsChanged();
+        if (gyroscopeChanged)
+            Q_EMIT gyroscopeWidgetsChanged();
+        if (multiPlotChanged)
+            Q_EMIT multiPlotWidgetsChanged();
+        if (spectrogramChanged)
+            Q_EMIT spectrogramWidgetsChanged();
+        if (accelerometerChanged)
+            Q_EMIT accelerometerWidgetsChanged();
+
+        // The aggregate signal now only drives the total widget count & the
+        // dashboard availability flag
         Q_EMIT widgetCountChanged();
         Q_EMIT widgetVisibilityChanged();
     }
 
-    // Update UI;
+    // Report the position of every dataset that changed with this frame, the
+    // frame walk is skipped entirely while no consumer is connected to the
+    // signal
+    static const auto signal = QMetaMethod::fromSignal(&UI::Dashboard::datasetUpdated);
+    if (isSignalConnected(signal))
+    {
+        for (int i = 0; i < m_currentFrame.groupCount(); ++i)
+        {
+            const auto &group = m_currentFrame.groups().at(i);
+            for (int j = 0; j < group.datasetCount(); ++j)
+            {
+                if (group.getDataset(j).changed())
+                    Q_EMIT datasetUpdated(i, j);
+            }
+        }
+    }
+
+    // Update UI, the widgets consume the new data through the sliced update
+    // signals emitted by updateWidgetSlice() over the rest of the UI interval
+    m_widgetUpdateCycle = true;
+    Misc::LatencyTracer::instance().frameProcessed();
     Q_EMIT updated();
 }
 
+/**
+ * Emits the widget update signal that corresponds to the given UI @a slice.
+ *
+ * Instead of updating every widget at once when a new frame is consumed, the
+ * widget classes are distributed over the four slices of the UI interval so
+ * that a full dashboard repaint never occupies the event loop in a single
+ * burst:
+ *
+ * - Slice 0: data plots
+ * - Slice 1: multiplots
+ * - Slice 2: groups, LED panels & bar widgets
+ * - Slice 3: gauges, compasses, gyroscopes, accelerometers & GPS maps
+ *
+ * The update cycle only starts when @c consumePendingFrame() accepted a frame
+ * on slice zero, slices of an idle interval are ignored. Slice 2 is further
+ * rate-limited by the user-selectable @c groupUpdateRate cap.
+ */
+void UI::Dashboard::updateWidgetSlice(const int slice)
+{
+    // No frame was consumed on this cycle, do not update the widgets
+    if (!m_widgetUpdateCycle)
+        return;
+
+    // Emit the update signal of the widget classes assigned to the slice
+    switch (slice)
+    {
+        case 0:
+            // In trigger mode the plots only redraw when a capture is ready,
+            // the trigger re-arms on the tick after the capture was shown (by
+            // then the queued widget updates are guaranteed to have run)
+            if (m_triggerEnabled)
+            {
+                if (m_triggerShown)
+                {
+                    m_triggerShown = false;
+                    m_triggerFrozen = false;
+                }
+
+                else if (m_triggerFrozen)
+                {
+                    m_triggerShown = true;
+                    Q_EMIT updatedSlice0();
+                }
+            }
+
+            else
+                Q_EMIT updatedSlice0();
+            break;
+        case 1:
+            if (!m_triggerEnabled || m_triggerShown)
+                Q_EMIT updatedSlice1();
+            break;
+        case 2:
+            // The text-heavy widgets of this slice are additionally capped to
+            // the user-selected group update rate, the skipped ticks are what
+            // makes a dashboard with dozens of group widgets cheap to refresh
+            if (m_groupElapsed.elapsed() >= 1000 / m_groupUpdateRate)
+            {
+                m_groupElapsed.restart();
+                Q_EMIT updatedSlice2();
+            }
+            break;
+        case 3:
+            Q_EMIT updatedSlice3();
+            m_widgetUpdateCycle = false;
+            break;
+        default:
+            break;
+    }
+}
+
 //----------------------------------------------------------------------------------------
 // Widget utility functions
 //----------------------------------------------------------------------------------------
 
+/**
+ * Updates the widget vectors in place by walking the current frame once &
+ * re-assigning every widget slot, which is cheap because the group & dataset
+ * objects are implicitly shared. Returns @c false if the widget layout of the
+ * frame does not match the layout of the vectors anymore (e.g. the user
+ * modified the project), in which case the caller shall re-build the widget
+ * vectors from scratch.
+ */
+bool UI::Dashboard::refreshWidgetVectors()
+{
+    // Obtain the number of "real" multiplot groups, the accelerometer &
+    // gyroscope groups are appended to the multiplot vector after them
+    const int multiC = m_multiPlotWidgets.count() - m_accelerometerWidgets.count()
+        - m_gyroscopeWidgets.count();
+
+    // Number of led datasets registered on the (only) status panel group
+    const int ledC = m_ledWidgets.isEmpty() ? 0 : m_ledWidgets.first().datasetCount();
+
+    // Initialize widget slot counters for each category
+    int bars = 0;
+    int ffts = 0;
+    int leds = 0;
+    int maps = 0;
+    int plots = 0;
+    int groups = 0;
+    int gauges = 0;
+    int compasses = 0;
+    int gyroscopes = 0;
+    int multiPlots = 0;
+    int spectrograms = 0;
+    int accelerometers = 0;
+
+    // Walk the frame & re-assign every widget slot in place
+    for (int i = 0; i < m_currentFrame.groupCount(); ++i)
+    {
+        const auto &group = m_currentFrame.groups().at(i);
+
+        // Update group-level widget slots
+        const auto handle = group.widget();
+        if (handle.isEmpty())
+        {
+            if (groups >= m_groupWidgets.count())
+                return false;
+
+            m_groupWidgets[groups++] = group;
+        }
+
+        else if (handle == "map")
+        {
+            if (maps >= m_gpsWidgets.count())
+                return false;
+
+            m_gpsWidgets[maps++] = group;
+        }
+
+        else if (handle == "gyro")
+        {
+            if (gyroscopes >= m_gyroscopeWidgets.count())
+                return false;
+
+            m_gyroscopeWidgets[gyroscopes] = group;
+            m_multiPlotWidgets[multiC + m_accelerometerWidgets.count() + gyroscopes]
+                = group;
+            ++gyroscopes;
+        }
+
+        else if (handle == "multiplot")
+        {
+            if (multiPlots >= multiC)
+                return false;
+
+            m_multiPlotWidgets[multiPlots++] = group;
+        }
+
+        else if (handle == "accelerometer")
+        {
+            if (accelerometers >= m_accelerometerWidgets.count())
+                return false;
+
+            m_accelerometerWidgets[accelerometers] = group;
+            m_multiPlotWidgets[multiC + accelerometers] = group;
+            ++accelerometers;
+        }
+
+        // Update dataset-level widget slots
+        for (int j = 0; j < group.datasetCount(); ++j)
+        {
+            const auto &set = group.datasets().at(j);
+
+            // Update FFT plot slots
+            if (set.fft())
+            {
+                if (ffts >= m_fftWidgets.count())
+                    return false;
+
+                m_fftWidgets[ffts++] = set;
+            }
+
+            // Update spectrogram slots
+            if (set.spectrogram())
+            {
+                if (spectrograms >= m_spectrogramWidgets.count())
+                    return false;
+
+                m_spectrogramWidgets[spectrograms++] = set;
+            }
+
+            // Update LED panel slots
+            if (set.led())
+            {
+                if (leds >= ledC)
+                    return false;
+
+                m_ledWidgets.first().m_datasets[leds++] = set;
+            }
+
+            // Update linear plot slots
+            if (set.graph())
+            {
+                if (plots >= m_plotWidgets.count())
+                    return false;
+
+                m_plotWidgets[plots++] = set;
+            }
+
+            // Update dataset-level widget slots
+            const auto widget = set.widget();
+            if (widget == "bar")
+            {
+                if (bars >= m_barWidgets.count())
+                    return false;
+
+                m_barWidgets[bars++] = set;
+            }
+
+            else if (widget == "gauge")
+            {
+                if (gauges >= m_gaugeWidgets.count())
+                    return false;
+
+                m_gaugeWidgets[gauges++] = set;
+            }
+
+            else if (widget == "compass")
+            {
+                if (compasses >= m_compassWidgets.count())
+                    return false;
+
+                m_compassWidgets[compasses++] = set;
+            }
+        }
+    }
+
+    // Verify that every widget slot of every vector was re-assigned
+    // clang-format off
+    return (leds == ledC
+            && multiPlots == multiC
+            && bars == m_barWidgets.count()
+            && ffts == m_fftWidgets.count()
+            && maps == m_gpsWidgets.count()
+            && plots == m_plotWidgets.count()
+            && groups == m_groupWidgets.count()
+            && gauges == m_gaugeWidgets.count()
+            && compasses == m_compassWidgets.count()
+            && gyroscopes == m_gyroscopeWidgets.count()
+            && spectrograms == m_spectrogramWidgets.count()
+            && accelerometers == m_accelerometerWidgets.count());
+    // clang-format on
+}
+
 /**
  * Returns a group with all the datasets that need to be shown in the LED status panel.
  *
@@ -884,6 +1940,25 @@ QVector<JSON::Dataset> UI::Dashboard::getFFTWidgets()
     return widgets;
 }
 
+/**
+ * Returns a vector with all the datasets that need to be shown in the spectrogram
+ * widgets.
+ */
+QVector<JSON::Dataset> UI::Dashboard::getSpectrogramWidgets()
+{
+    QVector<JSON::Dataset> widgets;
+    Q_FOREACH (auto group, m_currentFrame.groups())
+    {
+        Q_FOREACH (auto dataset, group.datasets())
+        {
+            if (dataset.spectrogram())
+                widgets.append(dataset);
+        }
+    }
+
+    return widgets;
+}
+
 /**
  * Returns a vector with all the datasets that need to be plotted.
  */
@@ -937,6 +2012,144 @@ QVector<JSON::Dataset> UI::Dashboard::getWidgetDatasets(const QString &handle)
     return widgets;
 }
 
+/**
+ * Evaluates the derived sensor values shared by the dashboard widgets once per
+ * consumed frame: the attitude of the gyroscope groups, the acceleration vector
+ * & G-force magnitude of the accelerometer groups and the normalized heading of
+ * the compass datasets.
+ *
+ * The widgets previously recomputed these values independently inside their
+ * updateData() paths, which duplicated the work when the same group feeds
+ * several views & let the views disagree when their updates interleaved.
+ */
+void UI::Dashboard::updateDerivedValues()
+{
+    // Attitude of every gyroscope group
+    m_gyroscopeValues.resize(m_gyroscopeWidgets.count());
+    for (int i = 0; i < m_gyroscopeWidgets.count(); ++i)
+    {
+        AttitudeValues attitude;
+        const auto &group = m_gyroscopeWidgets.at(i);
+        for (int j = 0; j < group.datasetCount(); ++j)
+        {
+            auto dataset = group.getDataset(j);
+            if (dataset.widget() == "pitch")
+                attitude.pitch = dataset.numericValue();
+            else if (dataset.widget() == "roll")
+                attitude.roll = dataset.numericValue();
+            else if (dataset.widget() == "yaw")
+                attitude.yaw = dataset.numericValue();
+        }
+
+        m_gyroscopeValues[i] = attitude;
+    }
+
+    // Acceleration vector & G-force magnitude of every accelerometer group,
+    // the axis readings are converted to G before computing the magnitude
+    m_accelerometerValues.resize(m_accelerometerWidgets.count());
+    for (int i = 0; i < m_accelerometerWidgets.count(); ++i)
+    {
+        AccelerationValues acceleration;
+        const auto &group = m_accelerometerWidgets.at(i);
+        for (int j = 0; j < group.datasetCount(); ++j)
+        {
+            auto dataset = group.getDataset(j);
+            if (dataset.widget() == "x")
+                acceleration.x = dataset.numericValue() / 9.18;
+            else if (dataset.widget() == "y")
+                acceleration.y = dataset.numericValue() / 9.18;
+            else if (dataset.widget() == "z")
+                acceleration.z = dataset.numericValue() / 9.18;
+        }
+
+        acceleration.g = qSqrt(qPow(acceleration.x, 2) + qPow(acceleration.y, 2)
+                               + qPow(acceleration.z, 2));
+        m_accelerometerValues[i] = acceleration;
+    }
+
+    // Compass headings normalized to the [0, 360) range
+    m_compassHeadings.resize(m_compassWidgets.count());
+    for (int i = 0; i < m_compassWidgets.count(); ++i)
+    {
+        double heading = std::fmod(m_compassWidgets.at(i).numericValue(), 360.0);
+        if (heading < 0)
+            heading += 360.0;
+
+        m_compassHeadings[i] = heading;
+    }
+}
+
+/**
+ * Regenerates the memoized title lists & the global-index lookup tables used by the
+ * @c relativeIndex() and @c widgetType() functions.
+ *
+ * These tables are only rebuilt when the widget layout of the frame changes, which
+ * lets the QML user interface read the title & index properties of every widget
+ * delegate without iterating over the widget vectors on each access.
+ */
+void UI::Dashboard::updateWidgetLookupTables()
+{
+    // Regenerate the title list of each widget category
+    m_gpsTitleList = groupTitles(m_gpsWidgets);
+    m_ledTitleList = groupTitles(m_ledWidgets);
+    m_barTitleList = datasetTitles(m_barWidgets);
+    m_fftTitleList = datasetTitles(m_fftWidgets);
+    m_groupTitleList = groupTitles(m_groupWidgets);
+    m_plotTitleList = datasetTitles(m_plotWidgets);
+    m_gaugeTitleList = datasetTitles(m_gaugeWidgets);
+    m_compassTitleList = datasetTitles(m_compassWidgets);
+    m_gyroscopeTitleList = groupTitles(m_gyroscopeWidgets);
+    m_multiPlotTitleList = groupTitles(m_multiPlotWidgets);
+    m_spectrogramTitleList = datasetTitles(m_spectrogramWidgets);
+    m_accelerometerTitleList = groupTitles(m_accelerometerWidgets);
+
+    // Regenerate the global widget title list
+    // Warning: maintain same order as the view option repeaters in ViewOptions.qml!
+    // clang-format off
+    m_widgetTitles = m_groupTitleList +
+            m_multiPlotTitleList +
+            m_ledTitleList +
+            m_fftTitleList +
+            m_spectrogramTitleList +
+            m_plotTitleList +
+            m_barTitleList +
+            m_gaugeTitleList +
+            m_compassTitleList +
+            m_gyroscopeTitleList +
+            m_accelerometerTitleList +
+            m_gpsTitleList;
+    // clang-format on
+
+    // Regenerate the global-index to relative-index/widget-type lookup tables
+    m_widgetTypes.clear();
+    m_relativeIndexes.clear();
+    m_widgetTypes.reserve(m_widgetTitles.count());
+    m_relativeIndexes.reserve(m_widgetTitles.count());
+    const auto registerCategory = [this](const WidgetType type, const int count) {
+        for (int i = 0; i < count; ++i)
+        {
+            m_widgetTypes.append(type);
+            m_relativeIndexes.append(i);
+        }
+    };
+
+    // Warning: maintain same order as the global widget title list!
+    // clang-format off
+    registerCategory(WidgetType::Group,         groupCount());
+    registerCategory(WidgetType::MultiPlot,     multiPlotCount());
+    registerCategory(WidgetType::LED,           ledCount());
+    registerCategory(WidgetType::FFT,           fftCount());
+    registerCategory(WidgetType::Spectrogram,   spectrogramCount());
+    registerCategory(WidgetType::Plot,          plotCount());
+    registerCategory(WidgetType::Bar,           barCount());
+    registerCategory(WidgetType::Gauge,         gaugeCount());
+    registerCategory(WidgetType::Compass,       compassCount());
+    registerCategory(WidgetType::Gyroscope,     gyroscopeCount());
+    registerCategory(WidgetType::Accelerometer, accelerometerCount());
+    registerCategory(WidgetType::GPS,           gpsCount());
+    // clang-format on
+}
+
 /**
  * Returns the titles of the datasets contained in the specified @a vector.
  */
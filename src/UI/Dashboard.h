@@ -23,9 +23,14 @@
 #pragma once
 
 #include <QFont>
+#include <QHash>
 #include <QObject>
+#include <QElapsedTimer>
 #include <DataTypes.h>
 #include <JSON/Frame.h>
+#include <UI/PlotBuffer.h>
+
+class QDataStream;
 
 namespace UI
 {
@@ -50,7 +55,8 @@ namespace UI
  * - @c Dashboard::getWidgetGroups()
  * - @c Dashboard::getDatasetWidget()
  * - @c Dashboard::getWidgetDatasets()
- * - @c Dashboard::processLatestJSON()
+ * - @c Dashboard::processLatestFrame()
+ * - @c Dashboard::consumePendingFrame()
  *
  * The rest of the functions of this class rely on the procedures above in order to
  * implement common functionality features for each widget type.
@@ -73,85 +79,142 @@ class Dashboard : public QObject
                READ precision
                WRITE setPrecision
                NOTIFY precisionChanged)
+    Q_PROPERTY(bool hardwareAcceleration
+               READ hardwareAcceleration
+               WRITE setHardwareAcceleration
+               NOTIFY hardwareAccelerationChanged)
+    Q_PROPERTY(bool fftDecibels
+               READ fftDecibels
+               WRITE setFftDecibels
+               NOTIFY fftDecibelsChanged)
+    Q_PROPERTY(int groupUpdateRate
+               READ groupUpdateRate
+               WRITE setGroupUpdateRate
+               NOTIFY groupUpdateRateChanged)
+    Q_PROPERTY(bool triggerEnabled
+               READ triggerEnabled
+               WRITE setTriggerEnabled
+               NOTIFY triggerChanged)
+    Q_PROPERTY(int triggerDataset
+               READ triggerDataset
+               WRITE setTriggerDataset
+               NOTIFY triggerChanged)
+    Q_PROPERTY(double triggerLevel
+               READ triggerLevel
+               WRITE setTriggerLevel
+               NOTIFY triggerChanged)
+    Q_PROPERTY(bool triggerRisingEdge
+               READ triggerRisingEdge
+               WRITE setTriggerRisingEdge
+               NOTIFY triggerChanged)
     Q_PROPERTY(int totalWidgetCount
                READ totalWidgetCount
                NOTIFY widgetCountChanged)
     Q_PROPERTY(int gpsCount
                READ gpsCount
-               NOTIFY widgetCountChanged)
+               NOTIFY gpsWidgetsChanged)
     Q_PROPERTY(int ledCount
                READ ledCount
-               NOTIFY widgetCountChanged)
+               NOTIFY ledWidgetsChanged)
     Q_PROPERTY(int barCount
                READ barCount
-               NOTIFY widgetCountChanged)
+               NOTIFY barWidgetsChanged)
     Q_PROPERTY(int fftCount
                READ fftCount
-               NOTIFY widgetCountChanged)
+               NOTIFY fftWidgetsChanged)
     Q_PROPERTY(int plotCount
                READ plotCount
-               NOTIFY widgetCountChanged)
+               NOTIFY plotWidgetsChanged)
+    Q_PROPERTY(int spectrogramCount
+               READ spectrogramCount
+               NOTIFY spectrogramWidgetsChanged)
     Q_PROPERTY(int groupCount
                READ groupCount
-               NOTIFY widgetCountChanged)
+               NOTIFY groupWidgetsChanged)
     Q_PROPERTY(int gaugeCount
                READ gaugeCount
-               NOTIFY widgetCountChanged)
+               NOTIFY gaugeWidgetsChanged)
     Q_PROPERTY(int compassCount
                READ compassCount
-               NOTIFY widgetCountChanged)
+               NOTIFY compassWidgetsChanged)
     Q_PROPERTY(int gyroscopeCount
                READ gyroscopeCount
-               NOTIFY widgetCountChanged)
+               NOTIFY gyroscopeWidgetsChanged)
     Q_PROPERTY(int multiPlotCount
                READ multiPlotCount
-               NOTIFY widgetCountChanged)
+               NOTIFY multiPlotWidgetsChanged)
     Q_PROPERTY(int accelerometerCount
                READ accelerometerCount
-               NOTIFY widgetCountChanged)
+               NOTIFY accelerometerWidgetsChanged)
     Q_PROPERTY(StringList gpsTitles
                READ gpsTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY gpsWidgetsChanged)
     Q_PROPERTY(StringList ledTitles
                READ ledTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY ledWidgetsChanged)
     Q_PROPERTY(StringList barTitles
                READ barTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY barWidgetsChanged)
     Q_PROPERTY(StringList fftTitles
                READ fftTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY fftWidgetsChanged)
     Q_PROPERTY(StringList plotTitles
                READ plotTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY plotWidgetsChanged)
+    Q_PROPERTY(StringList spectrogramTitles
+               READ spectrogramTitles
+               NOTIFY spectrogramWidgetsChanged)
     Q_PROPERTY(StringList groupTitles
                READ groupTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY groupWidgetsChanged)
     Q_PROPERTY(StringList gaugeTitles
                READ gaugeTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY gaugeWidgetsChanged)
     Q_PROPERTY(StringList compassTitles
                READ compassTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY compassWidgetsChanged)
     Q_PROPERTY(StringList gyroscopeTitles
                READ gyroscopeTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY gyroscopeWidgetsChanged)
     Q_PROPERTY(StringList multiPlotTitles
                READ multiPlotTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY multiPlotWidgetsChanged)
     Q_PROPERTY(StringList accelerometerTitles
                READ accelerometerTitles
-               NOTIFY widgetCountChanged)
+               NOTIFY accelerometerWidgetsChanged)
     // clang-format on
 
 Q_SIGNALS:
     void updated();
+    void updatedSlice0();
+    void updatedSlice1();
+    void updatedSlice2();
+    void updatedSlice3();
     void dataReset();
     void titleChanged();
+    void projectAttributesChanged();
     void pointsChanged();
     void precisionChanged();
     void widgetCountChanged();
+    void gpsWidgetsChanged();
+    void ledWidgetsChanged();
+    void barWidgetsChanged();
+    void fftWidgetsChanged();
+    void plotWidgetsChanged();
+    void groupWidgetsChanged();
+    void spectrogramWidgetsChanged();
+    void gaugeWidgetsChanged();
+    void compassWidgetsChanged();
+    void gyroscopeWidgetsChanged();
+    void multiPlotWidgetsChanged();
+    void accelerometerWidgetsChanged();
     void widgetVisibilityChanged();
+    void groupUpdateRateChanged();
+    void fftDecibelsChanged();
+    void hardwareAccelerationChanged();
+    void triggered();
+    void triggerChanged();
+    void datasetUpdated(const int groupIndex, const int datasetIndex);
 
 private:
     explicit Dashboard();
@@ -166,6 +229,7 @@ public:
         Group,
         MultiPlot,
         FFT,
+        Spectrogram,
         Plot,
         Bar,
         Gauge,
@@ -180,11 +244,36 @@ public:
 
     static Dashboard &instance();
 
+    /**
+     * Attitude of a gyroscope group, computed once per consumed frame so that
+     * every widget fed by the group renders the same values (see
+     * @c updateDerivedValues()).
+     */
+    struct AttitudeValues
+    {
+        double pitch = 0;
+        double roll = 0;
+        double yaw = 0;
+    };
+
+    /**
+     * Acceleration vector & G-force magnitude of an accelerometer group,
+     * computed once per consumed frame (see @c updateDerivedValues()).
+     */
+    struct AccelerationValues
+    {
+        double x = 0;
+        double y = 0;
+        double z = 0;
+        double g = 0;
+    };
+
     QFont monoFont() const;
     const JSON::Group &getLED(const int index) const;
     const JSON::Group &getGPS(const int index) const;
     const JSON::Dataset &getFFT(const int index) const;
     const JSON::Dataset &getBar(const int index) const;
+    const JSON::Dataset &getSpectrogram(const int index) const;
     const JSON::Group &getGroups(const int index) const;
     const JSON::Dataset &getPlot(const int index) const;
     const JSON::Dataset &getGauge(const int index) const;
@@ -193,10 +282,23 @@ public:
     const JSON::Group &getMultiplot(const int index) const;
     const JSON::Group &getAccelerometer(const int index) const;
 
+    double compassHeading(const int index) const;
+    const AttitudeValues &gyroscopeValues(const int index) const;
+    const AccelerationValues &accelerometerValues(const int index) const;
+
     QString title();
     bool available();
     int points() const;
     int precision() const;
+    int groupUpdateRate() const;
+    bool fftDecibels() const;
+    bool hardwareAcceleration() const;
+
+    bool triggerEnabled() const;
+    int triggerDataset() const;
+    double triggerLevel() const;
+    bool triggerRisingEdge() const;
+    QString formattedValue(const double value) const;
 
     int totalWidgetCount() const;
     int gpsCount() const;
@@ -208,6 +310,7 @@ public:
     int gaugeCount() const;
     int compassCount() const;
     int gyroscopeCount() const;
+    int spectrogramCount() const;
     int multiPlotCount() const;
     int accelerometerCount() const;
 
@@ -217,6 +320,7 @@ public:
     Q_INVOKABLE bool widgetVisible(const int globalIndex) const;
     Q_INVOKABLE QString widgetIcon(const int globalIndex) const;
     Q_INVOKABLE UI::Dashboard::WidgetType widgetType(const int globalIndex) const;
+    Q_INVOKABLE bool useQuickPlot(const int globalIndex) const;
 
     Q_INVOKABLE bool barVisible(const int index) const;
     Q_INVOKABLE bool fftVisible(const int index) const;
@@ -228,6 +332,7 @@ public:
     Q_INVOKABLE bool compassVisible(const int index) const;
     Q_INVOKABLE bool gyroscopeVisible(const int index) const;
     Q_INVOKABLE bool multiPlotVisible(const int index) const;
+    Q_INVOKABLE bool spectrogramVisible(const int index) const;
     Q_INVOKABLE bool accelerometerVisible(const int index) const;
 
     StringList barTitles();
@@ -240,16 +345,28 @@ public:
     StringList compassTitles();
     StringList gyroscopeTitles();
     StringList multiPlotTitles();
+    StringList spectrogramTitles();
     StringList accelerometerTitles();
 
+    void serializeSnapshot(QDataStream &out) const;
+    void restoreSnapshot(QDataStream &in);
+
     const PlotData &xPlotValues() { return m_xData; }
     const JSON::Frame &currentFrame() { return m_currentFrame; }
-    const QVector<PlotData> &fftPlotValues() { return m_fftPlotValues; }
-    const QVector<PlotData> &linearPlotValues() { return m_linearPlotValues; }
+    const QVector<PlotBuffer> &fftPlotValues() { return m_fftPlotValues; }
+    const QVector<PlotBuffer> &linearPlotValues() { return m_linearPlotValues; }
+    const QVector<PlotBuffer> &spectrogramPlotValues() { return m_spectrogramPlotValues; }
 
 public Q_SLOTS:
     void setPoints(const int points);
     void setPrecision(const int precision);
+    void setGroupUpdateRate(const int rate);
+    void setFftDecibels(const bool enabled);
+    void setTriggerEnabled(const bool enabled);
+    void setTriggerDataset(const int dataset);
+    void setTriggerLevel(const double level);
+    void setTriggerRisingEdge(const bool rising);
+    void setHardwareAcceleration(const bool enabled);
     void setBarVisible(const int index, const bool visible);
     void setFFTVisible(const int index, const bool visible);
     void setGpsVisible(const int index, const bool visible);
@@ -260,20 +377,38 @@ public Q_SLOTS:
     void setCompassVisible(const int index, const bool visible);
     void setGyroscopeVisible(const int index, const bool visible);
     void setMultiplotVisible(const int index, const bool visible);
+    void setSpectrogramVisible(const int index, const bool visible);
     void setAccelerometerVisible(const int index, const bool visible);
 
 private Q_SLOTS:
     void resetData();
-    void updatePlots();
-    void processLatestJSON(const QJsonObject &json);
+    void onConnectedChanged();
+    void consumePendingFrame();
+    void scheduleAttributeRefresh();
+    void updateWidgetSlice(const int slice);
+    void updatePlots(const JSON::Frame &frame);
+    void processLatestFrame(const JSON::Frame &frame);
 
 private:
+    bool refreshWidgetVectors();
+    void updateTriggeredPlots(const QVector<JSON::Dataset> &datasets);
+    void stagePlotValues(const JSON::Frame &frame);
+    void flushStagedPlotValues();
+    void clearStagedPlotValues();
+    void syncPlotBuffers(const QVector<JSON::Dataset> &fftDatasets,
+                         const QVector<JSON::Dataset> &linearDatasets,
+                         const QVector<JSON::Dataset> &spectrogramDatasets,
+                         const bool fp32);
+    void applyRestoredPlotValues();
     QVector<JSON::Group> getLEDWidgets();
     QVector<JSON::Dataset> getFFTWidgets();
     QVector<JSON::Dataset> getPlotWidgets();
+    QVector<JSON::Dataset> getSpectrogramWidgets();
     QVector<JSON::Group> getWidgetGroups(const QString &handle);
     QVector<JSON::Dataset> getWidgetDatasets(const QString &handle);
 
+    void updateDerivedValues();
+    void updateWidgetLookupTables();
     StringList groupTitles(const QVector<JSON::Group> &vector);
     StringList datasetTitles(const QVector<JSON::Dataset> &vector);
 
@@ -283,10 +418,35 @@ private:
 private:
     int m_points;
     int m_precision;
+    int m_groupUpdateRate;
+    bool m_hardwareAcceleration;
+    bool m_fftDecibels;
+    mutable QHash<quint64, QString> m_formattedValues;
     PlotData m_xData;
-    QVector<PlotData> m_fftPlotValues;
-    QVector<PlotData> m_linearPlotValues;
-    QVector<QVector<PlotData>> m_multiplotValues;
+    QVector<PlotBuffer> m_fftPlotValues;
+    QVector<PlotBuffer> m_linearPlotValues;
+    QVector<PlotBuffer> m_spectrogramPlotValues;
+
+    // Display-path staging area: the plotted values of the frames received
+    // between two UI ticks, flattened in [frame][dataset] order. The values
+    // are appended to the plot buffers in one batched pass per tick (see
+    // flushStagedPlotValues()), so the per-frame display cost is reduced to
+    // extracting a few doubles while the logging/alarm paths keep consuming
+    // every frame
+    int m_stagedFrames;
+    int m_stagedFftStride;
+    int m_stagedLinearStride;
+    int m_stagedSpectrogramStride;
+    PlotData m_stagedFftValues;
+    PlotData m_stagedLinearValues;
+    PlotData m_stagedSpectrogramValues;
+
+    // Plot samples restored from a session snapshot, held until the first
+    // live frame defines the buffer layout & applied when it matches (see
+    // applyRestoredPlotValues())
+    QVector<PlotData> m_restoredFftValues;
+    QVector<PlotData> m_restoredLinearValues;
+    QVector<PlotData> m_restoredSpectrogramValues;
 
     QVector<bool> m_barVisibility;
     QVector<bool> m_fftVisibility;
@@ -298,6 +458,7 @@ private:
     QVector<bool> m_compassVisibility;
     QVector<bool> m_gyroscopeVisibility;
     QVector<bool> m_multiPlotVisibility;
+    QVector<bool> m_spectrogramVisibility;
     QVector<bool> m_accelerometerVisibility;
 
     QVector<JSON::Dataset> m_barWidgets;
@@ -305,6 +466,7 @@ private:
     QVector<JSON::Dataset> m_plotWidgets;
     QVector<JSON::Dataset> m_gaugeWidgets;
     QVector<JSON::Dataset> m_compassWidgets;
+    QVector<JSON::Dataset> m_spectrogramWidgets;
 
     QVector<JSON::Group> m_ledWidgets;
     QVector<JSON::Group> m_gpsWidgets;
@@ -313,6 +475,55 @@ private:
     QVector<JSON::Group> m_gyroscopeWidgets;
     QVector<JSON::Group> m_accelerometerWidgets;
 
+    // Memoized title lists & global-index lookup tables, only regenerated when
+    // the widget layout of the frame changes
+    StringList m_barTitleList;
+    StringList m_fftTitleList;
+    StringList m_gpsTitleList;
+    StringList m_ledTitleList;
+    StringList m_plotTitleList;
+    StringList m_groupTitleList;
+    StringList m_gaugeTitleList;
+    StringList m_compassTitleList;
+    StringList m_gyroscopeTitleList;
+    StringList m_multiPlotTitleList;
+    StringList m_spectrogramTitleList;
+    StringList m_accelerometerTitleList;
+
+    StringList m_widgetTitles;
+    QVector<int> m_relativeIndexes;
+    QVector<WidgetType> m_widgetTypes;
+
+    // Derived sensor values shared by the widgets, computed once per consumed
+    // frame instead of independently by every widget instance
+    QVector<double> m_compassHeadings;
+    QVector<AttitudeValues> m_gyroscopeValues;
+    QVector<AccelerationValues> m_accelerometerValues;
+
+    // Latest-frame conflation slot, written at input rate & consumed once per
+    // UI tick by @c consumePendingFrame()
+    bool m_framePending;
+    bool m_widgetUpdateCycle;
+    bool m_attributeRefreshPending;
+
+    // Fingerprint of the frame structure of the previous session, lets an identical
+    // reconnect resume the dashboard instead of rebuilding it
+    bool m_sessionValidationPending;
+    QByteArray m_sessionFingerprint;
+    JSON::Frame m_pendingFrame;
+    QElapsedTimer m_groupElapsed;
+
+    // Oscilloscope-style trigger state, evaluated on the ingestion side as
+    // samples enter the plot buffers
+    bool m_triggerEnabled;
+    bool m_triggerFrozen;
+    bool m_triggerShown;
+    bool m_triggerRisingEdge;
+    int m_triggerDataset;
+    int m_triggerCountdown;
+    double m_triggerLevel;
+    double m_triggerPrevSample;
+
     JSON::Frame m_currentFrame;
 };
 }
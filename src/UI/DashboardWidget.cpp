@@ -20,6 +20,15 @@
  * THE SOFTWARE.
  */
 
+#include <QRunnable>
+#include <QFileDialog>
+#include <QThreadPool>
+#include <QStandardPaths>
+
+#include <QwtPlot>
+#include <QwtPlotCurve>
+#include <QwtPlotRenderer>
+
 #include <Misc/ThemeManager.h>
 #include <UI/DashboardWidget.h>
 
@@ -33,8 +42,144 @@
 #include <UI/Widgets/DataGroup.h>
 #include <UI/Widgets/Gyroscope.h>
 #include <UI/Widgets/MultiPlot.h>
+#include <UI/Widgets/Spectrogram.h>
 #include <UI/Widgets/Accelerometer.h>
 
+/*
+ * Maximum number of recycled widget instances kept per widget type, projects with more
+ * widgets than this still construct the surplus instances from scratch
+ */
+static const int kMaxPooledWidgetsPerType = 32;
+
+/*
+ * Recycled widget instances keyed by widget type, see AcquireWidget() & ReleaseWidget()
+ */
+static QHash<int, QVector<Widgets::DashboardWidgetBase *>> WIDGET_POOL;
+
+/**
+ * Returns the given @a widget of the given @a type to the widget pool so that a future
+ * dashboard rebuild can recycle it. Widgets that do not support re-binding (and widgets
+ * beyond the pool capacity) are deleted right away, exactly like before the pool
+ * existed.
+ */
+static void ReleaseWidget(const UI::Dashboard::WidgetType type,
+                          Widgets::DashboardWidgetBase *widget)
+{
+    auto &pool = WIDGET_POOL[static_cast<int>(type)];
+    if (!widget->supportsRebind() || pool.count() >= kMaxPooledWidgetsPerType)
+    {
+        delete widget;
+        return;
+    }
+
+    // Detach the widget from its previous host: drop the repaint connection &
+    // stop processing dashboard updates until the widget is re-bound
+    QObject::disconnect(widget, &Widgets::DashboardWidgetBase::updated, Q_NULLPTR,
+                        Q_NULLPTR);
+    widget->setEnabled(false);
+    widget->hide();
+    pool.append(widget);
+}
+
+/**
+ * Returns a recycled widget of the given @a type re-bound to the given relative
+ * @a index, or @c Q_NULLPTR when the pool holds no instance of that type.
+ */
+static Widgets::DashboardWidgetBase *AcquireWidget(const UI::Dashboard::WidgetType type,
+                                                   const int index)
+{
+    auto &pool = WIDGET_POOL[static_cast<int>(type)];
+    if (pool.isEmpty())
+        return Q_NULLPTR;
+
+    auto widget = pool.takeLast();
+    widget->rebind(index);
+    widget->setEnabled(true);
+    widget->show();
+    return widget;
+}
+
+/**
+ * Builds a detached copy of the given @a source plot for off-thread rendering: the
+ * clone copies the palette, canvas background, axis titles & visible scale ranges,
+ * and re-creates every visible curve with a copy of its current samples. The clone
+ * has no parent & is never shown, the export worker paints it with QwtPlotRenderer
+ * and schedules its deletion afterwards.
+ */
+static QwtPlot *ClonePlotForExport(QwtPlot *source)
+{
+    auto *snapshot = new QwtPlot();
+    snapshot->setPalette(source->palette());
+    snapshot->setCanvasBackground(source->canvasBackground());
+
+    // Copy axis titles & visible scale ranges
+    const int axes[] = { QwtPlot::yLeft, QwtPlot::yRight, QwtPlot::xBottom,
+                         QwtPlot::xTop };
+    for (size_t i = 0; i < sizeof(axes) / sizeof(axes[0]); ++i)
+    {
+        const int axis = axes[i];
+        snapshot->enableAxis(axis, source->axisEnabled(axis));
+        snapshot->setAxisTitle(axis, source->axisTitle(axis));
+        const auto div = source->axisScaleDiv(axis);
+        snapshot->setAxisScale(axis, div.lowerBound(), div.upperBound());
+    }
+
+    // Re-create the visible curves with copies of their current sample vectors,
+    // the copies detach the snapshot from the live data so that ingestion can
+    // keep updating the widget while the worker renders the image
+    const auto items = source->itemList(QwtPlotItem::Rtti_PlotCurve);
+    Q_FOREACH (auto item, items)
+    {
+        auto curve = static_cast<QwtPlotCurve *>(item);
+        if (!curve->isVisible())
+            continue;
+
+        QVector<QPointF> samples;
+        samples.reserve(static_cast<int>(curve->dataSize()));
+        for (size_t i = 0; i < curve->dataSize(); ++i)
+            samples.append(curve->sample(static_cast<int>(i)));
+
+        auto *copy = new QwtPlotCurve(curve->title());
+        copy->setPen(curve->pen());
+        copy->setStyle(curve->style());
+        copy->setSamples(samples);
+        copy->attach(snapshot);
+    }
+
+    return snapshot;
+}
+
+/**
+ * Renders a snapshot plot into the given file from a thread-pool thread, so that
+ * exporting a high-DPI image of a dense curve does not stall live ingestion or the
+ * user interface. The output format (PNG/SVG/PDF) is selected by the file suffix.
+ */
+class PlotExportRunnable : public QRunnable
+{
+public:
+    PlotExportRunnable(QwtPlot *snapshot, const QString &path)
+        : m_path(path)
+        , m_snapshot(snapshot)
+    {
+    }
+
+    void run() override
+    {
+        // Paint the detached snapshot, no other thread touches it so reading
+        // its state from the pool thread is safe
+        QwtPlotRenderer renderer;
+        renderer.setDiscardFlag(QwtPlotRenderer::DiscardBackground, false);
+        renderer.renderDocument(m_snapshot, m_path, QSizeF(300, 200), 150);
+
+        // Widgets must be destroyed on the GUI thread
+        m_snapshot->deleteLater();
+    }
+
+private:
+    QString m_path;
+    QwtPlot *m_snapshot;
+};
+
 /**
  * Constructor function
  */
@@ -43,20 +188,26 @@ UI::DashboardWidget::DashboardWidget(QQuickItem *parent)
     , m_index(-1)
     , m_widgetVisible(false)
     , m_isExternalWindow(false)
+    , m_dbWidgetType(UI::Dashboard::WidgetType::Unknown)
 {
     // clang-format off
     connect(&UI::Dashboard::instance(), &UI::Dashboard::widgetVisibilityChanged,
             this, &UI::DashboardWidget::updateWidgetVisible);
+    connect(&UI::Dashboard::instance(), &UI::Dashboard::projectAttributesChanged,
+            this, &UI::DashboardWidget::onProjectAttributesChanged);
     // clang-format on
 }
 
 /**
- * Delete widget on class destruction
+ * Return the widget to the pool (or delete it) on class destruction
  */
 UI::DashboardWidget::~DashboardWidget()
 {
     if (m_dbWidget)
-        delete m_dbWidget;
+    {
+        takeWidget();
+        ReleaseWidget(m_dbWidgetType, m_dbWidget);
+    }
 }
 
 /**
@@ -150,48 +301,65 @@ void UI::DashboardWidget::setWidgetIndex(const int index)
         // Update widget index
         m_index = index;
 
-        // Delete previous widget
+        // Return the previous widget to the pool (or delete it), detaching it
+        // from the paint item first so that setWidget() does not delete it
         if (m_dbWidget)
-            delete m_dbWidget;
+        {
+            takeWidget();
+            ReleaseWidget(m_dbWidgetType, m_dbWidget);
+            m_dbWidget = Q_NULLPTR;
+        }
+
+        // Recycle a pooled instance of the same widget type when possible,
+        // re-binding an existing widget skips the expensive Qwt construction
+        // work (palette setup, scale engines, curve attach, etc.)
+        m_dbWidgetType = widgetType();
+        m_dbWidget = AcquireWidget(m_dbWidgetType, relativeIndex());
 
-        // Construct new widget
-        switch (widgetType())
+        // No pooled instance available, construct a new widget
+        if (!m_dbWidget)
         {
-            case UI::Dashboard::WidgetType::Group:
-                m_dbWidget = new Widgets::DataGroup(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::MultiPlot:
-                m_dbWidget = new Widgets::MultiPlot(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::FFT:
-                m_dbWidget = new Widgets::FFTPlot(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::Plot:
-                m_dbWidget = new Widgets::Plot(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::Bar:
-                m_dbWidget = new Widgets::Bar(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::Gauge:
-                m_dbWidget = new Widgets::Gauge(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::Compass:
-                m_dbWidget = new Widgets::Compass(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::Gyroscope:
-                m_dbWidget = new Widgets::Gyroscope(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::Accelerometer:
-                m_dbWidget = new Widgets::Accelerometer(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::GPS:
-                m_dbWidget = new Widgets::GPS(relativeIndex());
-                break;
-            case UI::Dashboard::WidgetType::LED:
-                m_dbWidget = new Widgets::LEDPanel(relativeIndex());
-                break;
-            default:
-                break;
+            switch (widgetType())
+            {
+                case UI::Dashboard::WidgetType::Group:
+                    m_dbWidget = new Widgets::DataGroup(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::MultiPlot:
+                    m_dbWidget = new Widgets::MultiPlot(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::FFT:
+                    m_dbWidget = new Widgets::FFTPlot(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::Spectrogram:
+                    m_dbWidget = new Widgets::Spectrogram(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::Plot:
+                    m_dbWidget = new Widgets::Plot(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::Bar:
+                    m_dbWidget = new Widgets::Bar(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::Gauge:
+                    m_dbWidget = new Widgets::Gauge(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::Compass:
+                    m_dbWidget = new Widgets::Compass(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::Gyroscope:
+                    m_dbWidget = new Widgets::Gyroscope(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::Accelerometer:
+                    m_dbWidget = new Widgets::Accelerometer(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::GPS:
+                    m_dbWidget = new Widgets::GPS(relativeIndex());
+                    break;
+                case UI::Dashboard::WidgetType::LED:
+                    m_dbWidget = new Widgets::LEDPanel(relativeIndex());
+                    break;
+                default:
+                    break;
+            }
         }
 
         // Configure widget
@@ -222,6 +390,38 @@ void UI::DashboardWidget::setIsExternalWindow(const bool isWindow)
     Q_EMIT isExternalWindowChanged();
 }
 
+/**
+ * Attributes the render cost measured by the paint profiler to the
+ * user-visible widget title instead of the class name of the widget.
+ */
+QString UI::DashboardWidget::profilerTitle() const
+{
+    return widgetTitle();
+}
+
+/**
+ * Stops processing new data while the item is not effectively visible in the
+ * scene (e.g. scrolled off-screen or inside a hidden window) & catches up from
+ * the plot/frame history when the item is shown again.
+ */
+void UI::DashboardWidget::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == QQuickItem::ItemVisibleHasChanged && m_dbWidget)
+    {
+        m_dbWidget->setEnabled(value.boolValue);
+        if (value.boolValue)
+        {
+            // clang-format off
+            QMetaObject::invokeMethod(m_dbWidget, "updateData",
+                                      Qt::QueuedConnection);
+            // clang-format on
+            update();
+        }
+    }
+
+    DeclarativeWidget::itemChange(change, value);
+}
+
 /**
  * Updates the visibility status of the current widget (this function is called
  * automatically by the UI::Dashboard class via signals/slots).
@@ -244,6 +444,68 @@ void UI::DashboardWidget::updateWidgetVisible()
     }
 }
 
+/**
+ * Returns @c true when the underlying widget is plot-based & its current state can
+ * be exported as an image with @c exportPlotImage().
+ */
+bool UI::DashboardWidget::supportsImageExport() const
+{
+    return m_dbWidget && m_dbWidget->qwtPlot();
+}
+
+/**
+ * Asks the user for a file name & exports the current state of the underlying plot
+ * as a PNG, SVG or PDF image (selected by the file suffix). The curves are cloned
+ * into a detached snapshot on the GUI thread, the expensive rendering then runs on
+ * a thread-pool thread so that live ingestion & the UI are never stalled.
+ */
+void UI::DashboardWidget::exportPlotImage()
+{
+    // Widget is not plot-based
+    if (!supportsImageExport())
+        return;
+
+    // Ask the user where to save the image
+    // clang-format off
+    auto path = QFileDialog::getSaveFileName(
+        Q_NULLPTR, tr("Export plot image"),
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+            + "/" + widgetTitle() + ".png",
+        tr("Images") + " (*.png *.svg *.pdf)");
+    // clang-format on
+    if (path.isEmpty())
+        return;
+
+    // Default to PNG when the user did not type a known suffix
+    if (!path.endsWith(".png", Qt::CaseInsensitive)
+        && !path.endsWith(".svg", Qt::CaseInsensitive)
+        && !path.endsWith(".pdf", Qt::CaseInsensitive))
+        path += ".png";
+
+    // Clone the plot & render the copy on a worker thread
+    QThreadPool::globalInstance()->start(
+        new PlotExportRunnable(ClonePlotForExport(m_dbWidget->qwtPlot()), path));
+}
+
+/**
+ * Re-applies the configuration of the underlying widget after an attribute-only edit
+ * of the active project file. The widget instance is kept alive (along with its plot
+ * data), widgets that support re-binding re-read their scales, colors & history
+ * columns in place, and the title/icon bindings of the QML window are refreshed.
+ */
+void UI::DashboardWidget::onProjectAttributesChanged()
+{
+    if (m_dbWidget)
+    {
+        if (m_dbWidget->supportsRebind())
+            m_dbWidget->rebind(relativeIndex());
+
+        update();
+    }
+
+    Q_EMIT widgetIndexChanged();
+}
+
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
 #    include "moc_DashboardWidget.cpp"
 #endif
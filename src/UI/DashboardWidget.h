@@ -22,10 +22,14 @@
 
 #pragma once
 
+#include <climits>
+
 #include <UI/Dashboard.h>
 #include <Misc/TimerEvents.h>
 #include <UI/DeclarativeWidget.h>
 
+class QwtPlot;
+
 namespace Widgets
 {
 /**
@@ -37,7 +41,8 @@ namespace Widgets
  *
  * The widget also contains a @c requestUpdate() function, which is called by the widgets
  * that inherit this class when they finish updating the displayed data. This function
- * is used to schedule a re-paint at a controlled frequency, which is limited at 20 Hz.
+ * is used to schedule a re-paint at a controlled frequency, which is limited by the
+ * adaptive UI timer of the @c Misc::TimerEvents class.
  */
 class DashboardWidgetBase : public QWidget
 {
@@ -48,10 +53,15 @@ Q_SIGNALS:
 
 public:
     DashboardWidgetBase()
+        : m_repaint(false)
+        , m_forceRepaint(false)
+        , m_lastPaintedPixel(INT_MIN)
     {
         // clang-format off
-        connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout20Hz,
+        connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeoutUi,
                 this, &Widgets::DashboardWidgetBase::repaint);
+        connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
+                this, &Widgets::DashboardWidgetBase::forceRepaint);
         // clang-format on
     }
 
@@ -60,14 +70,75 @@ public:
         if (m_repaint)
         {
             m_repaint = false;
+            m_forceRepaint = false;
             Q_EMIT updated();
         }
     }
 
     void requestRepaint() { m_repaint = true; }
 
+    /**
+     * Registers a repaint request for a widget whose on-screen indicator maps
+     * the given @a value linearly onto @a pixelSpan pixels over the
+     * [@a min, @a max] range. The request is dropped while the quantized
+     * indicator position stays on the same device pixel as the last repaint,
+     * so noisy sensors that jitter below one pixel do not keep the render
+     * thread busy with visually identical frames. The 1 Hz timer forces a
+     * refresh through periodically, which keeps the value label of the widget
+     * from lagging behind for long.
+     */
+    void requestRepaint(const double value, const double min, const double max,
+                        const double pixelSpan)
+    {
+        // Unknown scale or geometry, do not gate the repaint
+        if (max <= min || pixelSpan <= 0)
+        {
+            m_repaint = true;
+            return;
+        }
+
+        // Quantize the indicator position to device pixels
+        const double ratio = (value - min) / (max - min);
+        const int pixel = qRound(ratio * pixelSpan * devicePixelRatioF());
+
+        // Skip visually identical frames until the next forced refresh
+        if (pixel != m_lastPaintedPixel || m_forceRepaint)
+        {
+            m_repaint = true;
+            m_lastPaintedPixel = pixel;
+        }
+    }
+
+    /**
+     * Returns @c true when the widget can be re-configured for another
+     * dataset/group through @c rebind(), which allows the dashboard to recycle
+     * the instance across project reloads & reconnects instead of destroying
+     * and re-creating it.
+     */
+    virtual bool supportsRebind() const { return false; }
+
+    /**
+     * Re-configures the widget to display the dataset/group with the given
+     * relative @a index. Only called on widgets that return @c true from
+     * @c supportsRebind().
+     */
+    virtual void rebind(const int index) { Q_UNUSED(index); }
+
+    /**
+     * Returns the Qwt plot rendered by the widget, or @c Q_NULLPTR when the
+     * widget is not plot-based. Used by the snapshot image export of
+     * @c UI::DashboardWidget, which clones the curves of the returned plot &
+     * renders the copy on a worker thread.
+     */
+    virtual QwtPlot *qwtPlot() { return Q_NULLPTR; }
+
+private:
+    void forceRepaint() { m_forceRepaint = true; }
+
 private:
     bool m_repaint;
+    bool m_forceRepaint;
+    int m_lastPaintedPixel;
 };
 }
 
@@ -138,18 +209,27 @@ public:
     bool isExternalWindow() const;
     UI::Dashboard::WidgetType widgetType() const;
 
+    Q_INVOKABLE bool supportsImageExport() const;
+
 public Q_SLOTS:
     void setVisible(const bool visible);
     void setWidgetIndex(const int index);
     void setIsExternalWindow(const bool isWindow);
+    void exportPlotImage();
+
+protected:
+    QString profilerTitle() const override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
 
 private Q_SLOTS:
     void updateWidgetVisible();
+    void onProjectAttributesChanged();
 
 private:
     int m_index;
     bool m_widgetVisible;
     bool m_isExternalWindow;
+    UI::Dashboard::WidgetType m_dbWidgetType;
     QPointer<Widgets::DashboardWidgetBase> m_dbWidget;
 };
 }
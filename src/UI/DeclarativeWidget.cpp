@@ -20,7 +20,11 @@
  * THE SOFTWARE.
  */
 
+#include <QElapsedTimer>
+
 #include <Misc/ThemeManager.h>
+#include <Misc/LatencyTracer.h>
+#include <UI/PaintProfiler.h>
 #include <UI/DeclarativeWidget.h>
 
 /**
@@ -46,7 +50,6 @@
 UI::DeclarativeWidget::DeclarativeWidget(QQuickItem *parent)
     : QQuickPaintedItem(parent)
 {
-    setMipmap(true);
     setAntialiasing(true);
     setOpaquePainting(true);
     setAcceptTouchEvents(true);
@@ -74,16 +77,75 @@ QWidget *UI::DeclarativeWidget::widget()
 }
 
 /**
- * Grabs an image/pixmap of the contained widget. The pixmap is later
- * used to render the widget in the QML interface without causing signal/slot
- * interferences with the scenegraph render thread.
+ * Detaches the current widget from this item without deleting it & returns a pointer to
+ * the detached widget. Used by the dashboard widget pool to recycle widget instances
+ * across dashboard rebuilds, @c setWidget() deletes the previous widget otherwise.
+ */
+QWidget *UI::DeclarativeWidget::takeWidget()
+{
+    auto widget = m_widget.data();
+    m_widget = Q_NULLPTR;
+    return widget;
+}
+
+/**
+ * Returns the name under which the paint profiler attributes the render cost
+ * of this item. The base implementation reports the class name of the
+ * contained widget, @c UI::DashboardWidget overrides this with the
+ * user-visible widget title.
+ */
+QString UI::DeclarativeWidget::profilerTitle() const
+{
+    if (!m_widget.isNull())
+        return m_widget->metaObject()->className();
+
+    return QString();
+}
+
+/**
+ * Renders the dirty @a rect of the contained widget into a persistent pixmap &
+ * schedules a partial update of the scenegraph texture. When no rectangle is
+ * given, the whole widget is re-rendered. The pixmap is later used to render
+ * the widget in the QML interface without causing signal/slot interferences
+ * with the scenegraph render thread.
+ *
+ * Unchanged widget areas are neither re-rasterized nor re-uploaded to the
+ * scenegraph, which makes partial updates (e.g. a single changed row of a
+ * data group) much cheaper than a full widget repaint.
  */
 void UI::DeclarativeWidget::update(const QRect &rect)
 {
     if (widget())
     {
-        m_pixmap = m_widget->grab();
-        QQuickPaintedItem::update(rect);
+        // Re-allocate the pixmap when the widget size changes, a resize
+        // invalidates the previous contents so the whole widget is rendered
+        QRect region = rect;
+        const qreal ratio = m_widget->devicePixelRatioF();
+        if (m_pixmap.size() != m_widget->size() * ratio)
+        {
+            m_pixmap = QPixmap(m_widget->size() * ratio);
+            m_pixmap.setDevicePixelRatio(ratio);
+            region = QRect();
+        }
+
+        // Re-rasterize only the dirty region of the widget, when the paint
+        // profiler is enabled the rasterization is timed & attributed to the
+        // widget title so the diagnostics pane can rank the widgets by cost
+        if (!region.isValid())
+            region = m_widget->rect();
+        auto &profiler = UI::PaintProfiler::instance();
+        if (profiler.enabled())
+        {
+            QElapsedTimer timer;
+            timer.start();
+            m_widget->render(&m_pixmap, region.topLeft(), region);
+            profiler.recordRender(profilerTitle(), timer.nsecsElapsed());
+        }
+        else
+            m_widget->render(&m_pixmap, region.topLeft(), region);
+
+        // Upload only the dirty region to the scenegraph texture
+        QQuickPaintedItem::update(region);
     }
 }
 
@@ -94,7 +156,14 @@ void UI::DeclarativeWidget::update(const QRect &rect)
 void UI::DeclarativeWidget::paint(QPainter *painter)
 {
     if (painter)
+    {
         painter->drawPixmap(0, 0, m_pixmap);
+
+        // Latency tracing stamp, the scenegraph calls paint() while the GUI
+        // thread is blocked during the sync phase, so this does not race with
+        // the other stamp points
+        Misc::LatencyTracer::instance().framePainted();
+    }
 }
 
 /**
@@ -41,6 +41,7 @@ public:
     DeclarativeWidget(QQuickItem *parent = 0);
 
     QWidget *widget();
+    QWidget *takeWidget();
     void update(const QRect &rect = QRect());
 
     virtual void paint(QPainter *painter) override;
@@ -64,6 +65,9 @@ public Q_SLOTS:
     void resizeWidget();
     void setWidget(QWidget *widget);
 
+protected:
+    virtual QString profilerTitle() const;
+
 private:
     void execEvent(void *function, void *event);
 
@@ -0,0 +1,1027 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "HistoryStore.h"
+
+#include <QDir>
+#include <QDateTime>
+#include <QDataStream>
+#include <QStandardPaths>
+#include <algorithm>
+
+#include <JSON/Group.h>
+#include <JSON/Dataset.h>
+#include <Misc/Clock.h>
+#include <Misc/MemoryRegistry.h>
+
+/**
+ * Default history cap, roughly 27 minutes of data at 60 frames per second
+ */
+static const int kDefaultMaxSamples = 100 * 1000;
+
+/**
+ * Smallest history cap that we accept, a lower cap would make the store less
+ * useful than the plot buffers it is supposed to outlive
+ */
+static const int kMinimumSamples = 1024;
+
+/**
+ * Maximum number of segment files kept memory-mapped at the same time, older
+ * mappings are released in LRU order
+ */
+static const int kMaxMappedSegments = 8;
+
+/**
+ * Magic number ("SSHS") & version written at the start of every segment file
+ */
+static const quint32 kSegmentMagic = 0x53534853;
+static const quint32 kSegmentVersion = 1;
+
+/**
+ * Size in bytes of the segment file header: magic, version, column count &
+ * row count, all 32-bit
+ */
+static const int kSegmentHeaderSize = 16;
+
+/**
+ * Number of levels of the min/max decimation pyramid, level @c i covers
+ * 2^(i+1) samples per bucket so 24 levels are enough for 2^25 samples
+ */
+static const int kPyramidLevels = 24;
+
+//----------------------------------------------------------------------------------------
+// Background segment writer
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, stores the directory that shall hold the segment
+ * files of this session
+ */
+UI::SegmentWriter::SegmentWriter(const QString &spillPath, QObject *parent)
+    : QObject(parent)
+    , m_spillPath(spillPath)
+{
+}
+
+/**
+ * Deletes the spill directory of this session with every segment file in it
+ */
+void UI::SegmentWriter::removeSpillFiles()
+{
+    QDir(m_spillPath).removeRecursively();
+}
+
+/**
+ * Writes the given block of history samples into a columnar segment file &
+ * notifies the store once the segment is sealed. The on-disk layout mirrors
+ * the in-memory store (timestamp column first, then one contiguous column of
+ * doubles per dataset), so the store can memory-map the file & run the same
+ * binary-search/scan code on it.
+ */
+void UI::SegmentWriter::writeSegment(const int epoch, const int id,
+                                     const QVector<qint64> &timestamps,
+                                     const QVector<QVector<double>> &columns)
+{
+    // Sanity checks
+    if (timestamps.isEmpty() || columns.isEmpty())
+        return;
+
+    // Create the spill directory & the segment file
+    if (!QDir().mkpath(m_spillPath))
+        return;
+    QFile file(m_spillPath + "/segment-" + QString::number(id) + ".dat");
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    // Write the header
+    const quint32 cols = static_cast<quint32>(columns.count());
+    const quint32 rows = static_cast<quint32>(timestamps.count());
+    file.write(reinterpret_cast<const char *>(&kSegmentMagic), sizeof(quint32));
+    file.write(reinterpret_cast<const char *>(&kSegmentVersion),
+               sizeof(quint32));
+    file.write(reinterpret_cast<const char *>(&cols), sizeof(quint32));
+    file.write(reinterpret_cast<const char *>(&rows), sizeof(quint32));
+
+    // Write the timestamp column followed by every value column
+    file.write(reinterpret_cast<const char *>(timestamps.constData()),
+               qint64(rows) * qint64(sizeof(qint64)));
+    for (int i = 0; i < columns.count(); ++i)
+        file.write(reinterpret_cast<const char *>(columns.at(i).constData()),
+                   qint64(rows) * qint64(sizeof(double)));
+
+    // Seal the segment & let the store index it
+    file.close();
+    Q_EMIT segmentSealed(epoch, id, file.fileName(), timestamps.first(),
+                         timestamps.last(), timestamps.count());
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor/deconstructor & singleton access functions
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, initializes the history caps & starts the background
+ * segment writer thread
+ */
+UI::HistoryStore::HistoryStore()
+    : m_maxSamples(kDefaultMaxSamples)
+    , m_maxMegabytes(0)
+    , m_float32(false)
+    , m_baseIndex(0)
+    , m_sealedRows(0)
+    , m_spillEpoch(0)
+    , m_nextSegmentId(0)
+    , m_writer(Q_NULLPTR)
+{
+    // Register the vector types passed between the store & the writer thread
+    qRegisterMetaType<QVector<qint64>>("QVector<qint64>");
+    qRegisterMetaType<QVector<QVector<double>>>("QVector<QVector<double>>");
+
+    // Use a per-session spill directory so that concurrent instances & stale
+    // files from crashed sessions cannot interfere with each other
+    m_spillPath
+        = QStandardPaths::writableLocation(QStandardPaths::TempLocation)
+          + "/Serial Studio/History/"
+          + QString::number(QDateTime::currentMSecsSinceEpoch());
+
+    // Move the segment writer to a dedicated thread, disk I/O must never
+    // block the frame-processing path
+    m_writer = new SegmentWriter(m_spillPath);
+    m_writer->moveToThread(&m_writerThread);
+    // clang-format off
+    connect(&m_writerThread, &QThread::finished, m_writer, &QObject::deleteLater);
+    connect(this, &UI::HistoryStore::spillRequested,
+            m_writer, &UI::SegmentWriter::writeSegment, Qt::QueuedConnection);
+    connect(m_writer, &UI::SegmentWriter::segmentSealed,
+            this, &UI::HistoryStore::registerSealedSegment, Qt::QueuedConnection);
+    // clang-format on
+    m_writerThread.start(QThread::LowPriority);
+}
+
+/**
+ * Destructor function, stops the writer thread & deletes the spill files of
+ * this session
+ */
+UI::HistoryStore::~HistoryStore()
+{
+    for (int i = 0; i < m_mappedSegments.count(); ++i)
+    {
+        auto &mapped = m_mappedSegments[i];
+        mapped.file->unmap(const_cast<uchar *>(mapped.data));
+        mapped.file->close();
+        delete mapped.file;
+    }
+
+    m_writerThread.quit();
+    m_writerThread.wait();
+    QDir(m_spillPath).removeRecursively();
+}
+
+/**
+ * Returns the only instance of the class
+ */
+UI::HistoryStore &UI::HistoryStore::instance()
+{
+    static HistoryStore singleton;
+    return singleton;
+}
+
+//----------------------------------------------------------------------------------------
+// Getter functions
+//----------------------------------------------------------------------------------------
+
+/**
+ * Returns the maximum number of samples kept in RAM per dataset
+ */
+int UI::HistoryStore::maxSamples() const
+{
+    return m_maxSamples;
+}
+
+/**
+ * Returns the RAM budget of the store in megabytes, or @c 0 when the store
+ * is only capped by the sample count
+ */
+int UI::HistoryStore::maxMegabytes() const
+{
+    return m_maxMegabytes;
+}
+
+/**
+ * Returns the number of samples currently held in RAM per dataset
+ */
+int UI::HistoryStore::sampleCount() const
+{
+    return m_timestamps.count();
+}
+
+/**
+ * Returns the number of dataset columns held by the store
+ */
+int UI::HistoryStore::columnCount() const
+{
+    return m_float32 ? m_floatColumns.count() : m_columns.count();
+}
+
+/**
+ * Returns @c true if the in-RAM columns store their samples as 32-bit floats
+ * instead of doubles (decided by the "fp32" flag of the current project)
+ */
+bool UI::HistoryStore::float32Storage() const
+{
+    return m_float32;
+}
+
+/**
+ * Returns the number of samples per dataset that were sealed into on-disk
+ * segments
+ */
+int UI::HistoryStore::spilledSampleCount() const
+{
+    int rows = 0;
+    for (int i = 0; i < m_segments.count(); ++i)
+        rows += m_segments.at(i).rows;
+
+    return rows;
+}
+
+/**
+ * Returns the total number of samples appended per dataset since the last
+ * history reset, including the samples that were sealed to disk. Together
+ * with @c decimate() this defines the global sample-index space used by the
+ * pan/zoom navigation of the plot widgets.
+ */
+qint64 UI::HistoryStore::totalSampleCount() const
+{
+    return m_baseIndex + m_timestamps.count();
+}
+
+/**
+ * Returns the "group / dataset" title of each column of the store
+ */
+StringList UI::HistoryStore::columnTitles() const
+{
+    return m_columnTitles;
+}
+
+/**
+ * Returns a reference to the in-RAM value column of the dataset at the given
+ * @a column index. Only available for double-precision projects, use the
+ * range overload of @c samples() to read float32 histories (it widens the
+ * samples while copying).
+ */
+const QVector<double> &UI::HistoryStore::samples(const int column) const
+{
+    Q_ASSERT(!m_float32);
+    Q_ASSERT(column >= 0 && column < m_columns.count());
+    return m_columns.at(column);
+}
+
+//----------------------------------------------------------------------------------------
+// Time-range queries
+//----------------------------------------------------------------------------------------
+
+/**
+ * Obtains the half-open index range [@a begin, @a end) of the in-RAM samples
+ * whose timestamps fall inside [@a from, @a to] (in milliseconds since the
+ * Unix epoch). The timestamp column is sorted by construction, so both bounds
+ * are found with a binary search.
+ *
+ * Samples that were already sealed to disk are not covered by this function,
+ * use the range overloads of @c timestamps() and @c samples() to query the
+ * full session history.
+ */
+void UI::HistoryStore::timeRange(const qint64 from, const qint64 to, int &begin,
+                                 int &end) const
+{
+    const auto first = m_timestamps.constBegin();
+    const auto last = m_timestamps.constEnd();
+    begin = static_cast<int>(std::lower_bound(first, last, from) - first);
+    end = static_cast<int>(std::upper_bound(first, last, to) - first);
+}
+
+/**
+ * Returns a copy of the timestamps that fall inside [@a from, @a to],
+ * stitched together from the sealed on-disk segments & the in-RAM column.
+ * Segments are memory-mapped on demand, so only the pages that hold the
+ * requested range are actually read from disk.
+ */
+QVector<qint64> UI::HistoryStore::timestamps(const qint64 from,
+                                             const qint64 to) const
+{
+    QVector<qint64> result;
+
+    // Collect the matching rows of every sealed segment that overlaps the
+    // requested range
+    for (int i = 0; i < m_segments.count(); ++i)
+    {
+        const auto &segment = m_segments.at(i);
+        if (segment.lastTimestamp < from || segment.firstTimestamp > to)
+            continue;
+
+        const uchar *data = mapSegment(segment);
+        if (!data)
+            continue;
+
+        int begin, end;
+        segmentRange(data, segment.rows, from, to, begin, end);
+        const qint64 *column
+            = reinterpret_cast<const qint64 *>(data + kSegmentHeaderSize);
+        for (int row = begin; row < end; ++row)
+            result.append(column[row]);
+    }
+
+    // Append the matching in-RAM rows
+    int begin, end;
+    timeRange(from, to, begin, end);
+    if (begin < end)
+        result += m_timestamps.mid(begin, end - begin);
+
+    return result;
+}
+
+/**
+ * Returns a copy of the samples of the given @a column whose timestamps fall
+ * inside [@a from, @a to], stitched together from the sealed on-disk segments
+ * & the in-RAM column. Since every column is contiguous both in RAM & inside
+ * the segment files, each contribution is a single sequential read.
+ */
+QVector<double> UI::HistoryStore::samples(const int column, const qint64 from,
+                                          const qint64 to) const
+{
+    QVector<double> result;
+    if (column < 0 || column >= columnCount())
+        return result;
+
+    // Collect the matching rows of every sealed segment that overlaps the
+    // requested range
+    for (int i = 0; i < m_segments.count(); ++i)
+    {
+        const auto &segment = m_segments.at(i);
+        if (segment.lastTimestamp < from || segment.firstTimestamp > to)
+            continue;
+
+        const uchar *data = mapSegment(segment);
+        if (!data)
+            continue;
+
+        int begin, end;
+        segmentRange(data, segment.rows, from, to, begin, end);
+        const double *values = reinterpret_cast<const double *>(
+            data + kSegmentHeaderSize
+            + qint64(segment.rows) * qint64(sizeof(qint64))
+            + qint64(column) * qint64(segment.rows) * qint64(sizeof(double)));
+        for (int row = begin; row < end; ++row)
+            result.append(values[row]);
+    }
+
+    // Append the matching in-RAM rows (widening them when the columns store
+    // 32-bit floats)
+    int begin, end;
+    timeRange(from, to, begin, end);
+    if (begin < end)
+    {
+        if (m_float32)
+        {
+            const auto &samples = m_floatColumns.at(column);
+            result.reserve(result.count() + end - begin);
+            for (int row = begin; row < end; ++row)
+                result.append(static_cast<double>(samples.at(row)));
+        }
+
+        else
+            result += m_columns.at(column).mid(begin, end - begin);
+    }
+
+    return result;
+}
+
+/**
+ * Fills @a xData / @a yData with a min/max-decimated view of the samples of
+ * the given @a column inside the global sample-index range
+ * [@a firstSample, @a lastSample), limited to roughly @a maxPoints output
+ * points. The x values are global sample indices.
+ *
+ * The function picks the coarsest pyramid level that still yields about two
+ * output points per requested point, so the amount of data touched is
+ * proportional to @a maxPoints & independent of the size of the range. When
+ * the range itself is small enough, the raw samples are returned instead
+ * (read from RAM or from the mapped segment files).
+ */
+void UI::HistoryStore::decimate(const int column, const qint64 firstSample,
+                                const qint64 lastSample, const int maxPoints,
+                                PlotData &xData, PlotData &yData) const
+{
+    xData.clear();
+    yData.clear();
+
+    // Validate & clamp the requested range
+    if (column < 0 || column >= columnCount() || maxPoints < 4)
+        return;
+    const qint64 first = qMax<qint64>(firstSample, 0);
+    const qint64 last = qMin<qint64>(lastSample, totalSampleCount());
+    if (first >= last)
+        return;
+
+    // Range is small enough, return the raw samples
+    const qint64 range = last - first;
+    if (range <= maxPoints)
+    {
+        rawSamples(column, first, last, xData, yData);
+        return;
+    }
+
+    // Pick the coarsest level that still produces about two points per
+    // requested output point (each bucket contributes a min & a max)
+    int level = 0;
+    qint64 bucket = 2;
+    while (level + 1 < kPyramidLevels && range / bucket > maxPoints / 2)
+    {
+        ++level;
+        bucket <<= 1;
+    }
+
+    // Emit the min/max pair of every (globally aligned) bucket of the range
+    const auto &pyramid = m_pyramids.at(column).at(level);
+    const qint64 firstBucket = first / bucket;
+    const qint64 lastBucket
+        = qMin<qint64>((last + bucket - 1) / bucket, pyramid.count() / 2);
+    for (qint64 j = firstBucket; j < lastBucket; ++j)
+    {
+        const double x = static_cast<double>(j * bucket);
+        xData.append(x);
+        yData.append(pyramid.at(static_cast<int>(j * 2)));
+        xData.append(x + bucket / 2);
+        yData.append(pyramid.at(static_cast<int>(j * 2 + 1)));
+    }
+}
+
+//----------------------------------------------------------------------------------------
+// Data-path functions
+//----------------------------------------------------------------------------------------
+
+/**
+ * Appends the dataset values of the given @a frame to the store. The store
+ * keeps one contiguous column per dataset, so an append is one write at the
+ * end of each column plus one shared timestamp.
+ *
+ * The columns are rebuilt (and the history discarded) when the dataset layout
+ * of the frames changes, e.g. when another project file is loaded.
+ */
+void UI::HistoryStore::append(const JSON::Frame &frame)
+{
+    // Count the datasets of the frame & refresh the column titles when the
+    // dataset layout or the storage precision differs from the one the
+    // columns were built for
+    int datasets = 0;
+    StringList titles;
+    for (int g = 0; g < frame.groupCount(); ++g)
+        datasets += frame.getGroup(g).datasetCount();
+    if (datasets != columnCount() || frame.fp32Storage() != m_float32)
+    {
+        titles.reserve(datasets);
+        for (int g = 0; g < frame.groupCount(); ++g)
+        {
+            const auto &group = frame.getGroup(g);
+            for (int d = 0; d < group.datasetCount(); ++d)
+                titles.append(group.title() + " / "
+                              + group.getDataset(d).title());
+        }
+
+        m_timestamps.clear();
+        m_columnTitles = titles;
+        m_float32 = frame.fp32Storage();
+        m_columns.clear();
+        m_floatColumns.clear();
+        if (m_float32)
+            m_floatColumns.resize(datasets);
+        else
+            m_columns.resize(datasets);
+
+        // Rebuild the (empty) decimation pyramid of every column
+        m_pyramids.clear();
+        m_pyramidAccumulators.clear();
+        m_pyramids.resize(datasets);
+        m_pyramidAccumulators.resize(datasets);
+        for (int i = 0; i < datasets; ++i)
+        {
+            m_pyramids[i].resize(kPyramidLevels);
+            m_pyramidAccumulators[i].resize(kPyramidLevels);
+            for (int level = 0; level < kPyramidLevels; ++level)
+                m_pyramidAccumulators[i][level].count = 0;
+        }
+
+        dropSpilledSegments();
+        Q_EMIT historyReset();
+    }
+
+    // When the RAM cap is reached, seal the oldest quarter of every column
+    // into an on-disk segment (written by the background thread) & drop it
+    // from RAM in one block, so that the trim cost is amortized over
+    // thousands of appends
+    const int cap = capacity();
+    if (m_timestamps.count() >= cap)
+    {
+        const int drop = qMax(1, cap / 4);
+
+        // Segment files always store doubles regardless of the in-RAM
+        // precision, so float32 columns are widened while the block is built
+        QVector<QVector<double>> block;
+        block.reserve(columnCount());
+        if (m_float32)
+        {
+            for (int i = 0; i < m_floatColumns.count(); ++i)
+            {
+                QVector<double> sealed(drop);
+                for (int row = 0; row < drop; ++row)
+                    sealed[row]
+                        = static_cast<double>(m_floatColumns.at(i).at(row));
+                block.append(sealed);
+            }
+        }
+
+        else
+        {
+            for (int i = 0; i < m_columns.count(); ++i)
+                block.append(m_columns.at(i).mid(0, drop));
+        }
+
+        Q_EMIT spillRequested(m_spillEpoch, m_nextSegmentId++,
+                              m_timestamps.mid(0, drop), block);
+
+        m_baseIndex += drop;
+        m_timestamps.remove(0, drop);
+        for (int i = 0; i < m_columns.count(); ++i)
+            m_columns[i].remove(0, drop);
+        for (int i = 0; i < m_floatColumns.count(); ++i)
+            m_floatColumns[i].remove(0, drop);
+    }
+
+    // Append the shared timestamp & one value per dataset column, and feed
+    // the value into the decimation pyramid of its column
+    int column = 0;
+    m_timestamps.append(Misc::Clock::instance().currentMSecsSinceEpoch());
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.getGroup(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const double value = group.getDataset(d).numericValue();
+            if (m_float32)
+                m_floatColumns[column].append(static_cast<float>(value));
+            else
+                m_columns[column].append(value);
+            appendToPyramid(column, value);
+            ++column;
+        }
+    }
+
+    // Let the memory registry know how large the history is
+    reportMemoryUsage();
+}
+
+/**
+ * Writes the tail of the in-RAM history into the given session snapshot
+ * stream (see @c Misc::SessionSnapshot). At most @a maxRows of the newest
+ * samples per dataset are stored, which bounds the serialization cost of a
+ * snapshot write regardless of the history caps; values are always written
+ * as doubles so the snapshot format is independent of the storage precision.
+ */
+void UI::HistoryStore::serializeSnapshot(QDataStream &out,
+                                         const int maxRows) const
+{
+    const int rows = qMin(maxRows, m_timestamps.count());
+    const int first = m_timestamps.count() - rows;
+
+    out << m_columnTitles;
+    out << m_float32;
+    out << m_timestamps.mid(first);
+
+    for (int i = 0; i < columnCount(); ++i)
+    {
+        if (m_float32)
+        {
+            QVector<double> values(rows);
+            for (int row = 0; row < rows; ++row)
+                values[row]
+                    = static_cast<double>(m_floatColumns.at(i).at(first + row));
+            out << values;
+        }
+
+        else
+            out << m_columns.at(i).mid(first);
+    }
+}
+
+/**
+ * Restores the in-RAM history columns & decimation pyramids from the given
+ * session snapshot stream. The history is only restored into an empty store,
+ * a stale snapshot can never overwrite live data; when the restored column
+ * layout does not match the project of the next session, the first appended
+ * frame resets the store exactly like any other layout change.
+ */
+bool UI::HistoryStore::restoreSnapshot(QDataStream &in)
+{
+    // Read the column layout & the shared timestamp column
+    bool fp32 = false;
+    StringList titles;
+    QVector<qint64> timestamps;
+    in >> titles;
+    in >> fp32;
+    in >> timestamps;
+    if (in.status() != QDataStream::Ok || titles.isEmpty())
+        return false;
+
+    // Data already arrived, keep it
+    if (!m_timestamps.isEmpty() || columnCount() > 0)
+        return false;
+
+    // Rebuild the columns & the (empty) decimation pyramids
+    const int datasets = titles.count();
+    m_float32 = fp32;
+    m_columnTitles = titles;
+    m_columns.clear();
+    m_floatColumns.clear();
+    if (m_float32)
+        m_floatColumns.resize(datasets);
+    else
+        m_columns.resize(datasets);
+
+    m_pyramids.clear();
+    m_pyramidAccumulators.clear();
+    m_pyramids.resize(datasets);
+    m_pyramidAccumulators.resize(datasets);
+    for (int i = 0; i < datasets; ++i)
+    {
+        m_pyramids[i].resize(kPyramidLevels);
+        m_pyramidAccumulators[i].resize(kPyramidLevels);
+        for (int level = 0; level < kPyramidLevels; ++level)
+            m_pyramidAccumulators[i][level].count = 0;
+    }
+
+    // Read every value column & feed the decimation pyramids
+    const int rows = timestamps.count();
+    m_timestamps = timestamps;
+    for (int i = 0; i < datasets; ++i)
+    {
+        QVector<double> values;
+        in >> values;
+        if (in.status() != QDataStream::Ok || values.count() != rows)
+        {
+            clear();
+            return false;
+        }
+
+        if (m_float32)
+        {
+            m_floatColumns[i].resize(rows);
+            for (int row = 0; row < rows; ++row)
+                m_floatColumns[i][row] = static_cast<float>(values.at(row));
+        }
+
+        else
+            m_columns[i] = values;
+
+        for (int row = 0; row < rows; ++row)
+            appendToPyramid(i, values.at(row));
+    }
+
+    reportMemoryUsage();
+    Q_EMIT historyReset();
+    return true;
+}
+
+/**
+ * Discards the stored history (RAM columns & on-disk segments), called by the
+ * dashboard whenever its own data model is reset (e.g. on device
+ * disconnection)
+ */
+void UI::HistoryStore::clear()
+{
+    m_columns.clear();
+    m_pyramids.clear();
+    m_timestamps.clear();
+    m_floatColumns.clear();
+    m_columnTitles.clear();
+    m_pyramidAccumulators.clear();
+    dropSpilledSegments();
+    reportMemoryUsage();
+    Q_EMIT historyReset();
+}
+
+/**
+ * Changes the maximum number of @a samples kept in RAM per dataset
+ */
+void UI::HistoryStore::setMaxSamples(const int samples)
+{
+    m_maxSamples = qMax(samples, kMinimumSamples);
+    Q_EMIT capacityChanged();
+}
+
+/**
+ * Changes the RAM budget of the store, set @a megabytes to @c 0 to cap the
+ * store by sample count only
+ */
+void UI::HistoryStore::setMaxMegabytes(const int megabytes)
+{
+    m_maxMegabytes = qMax(megabytes, 0);
+    Q_EMIT capacityChanged();
+}
+
+//----------------------------------------------------------------------------------------
+// Segment management
+//----------------------------------------------------------------------------------------
+
+/**
+ * Adds a freshly sealed segment to the segment index. Seal notifications are
+ * delivered in spill order, so the index stays sorted by time. Notifications
+ * that belong to a previous spill epoch (i.e. segments that were requested
+ * before the history was reset) are ignored.
+ */
+void UI::HistoryStore::registerSealedSegment(const int epoch, const int id,
+                                             const QString &path,
+                                             const qint64 firstTimestamp,
+                                             const qint64 lastTimestamp,
+                                             const int rows)
+{
+    if (epoch != m_spillEpoch)
+        return;
+
+    Segment segment;
+    segment.id = id;
+    segment.rows = rows;
+    segment.path = path;
+    segment.firstIndex = m_sealedRows;
+    segment.firstTimestamp = firstTimestamp;
+    segment.lastTimestamp = lastTimestamp;
+    m_segments.append(segment);
+    m_sealedRows += rows;
+}
+
+/**
+ * Returns the effective RAM sample cap, which is the configured sample count
+ * further reduced by the memory budget (when one is set). The budget is
+ * translated into samples with the byte cost of one row: one double per
+ * column plus the shared timestamp.
+ */
+int UI::HistoryStore::capacity() const
+{
+    qint64 cap = m_maxSamples;
+    if (m_maxMegabytes > 0 && columnCount() > 0)
+    {
+        const qint64 sampleBytes
+            = m_float32 ? qint64(sizeof(float)) : qint64(sizeof(double));
+        const qint64 bytes = qint64(m_maxMegabytes) * 1024 * 1024;
+        const qint64 rowBytes
+            = columnCount() * sampleBytes + qint64(sizeof(qint64));
+        cap = qMin(cap, bytes / rowBytes);
+    }
+
+    return static_cast<int>(qMax<qint64>(cap, kMinimumSamples));
+}
+
+/**
+ * Releases every mapped segment, clears the segment index, bumps the spill
+ * epoch (so that in-flight seal notifications are ignored) & asks the writer
+ * thread to delete the segment files of this session
+ */
+void UI::HistoryStore::dropSpilledSegments()
+{
+    for (int i = 0; i < m_mappedSegments.count(); ++i)
+    {
+        auto &mapped = m_mappedSegments[i];
+        mapped.file->unmap(const_cast<uchar *>(mapped.data));
+        mapped.file->close();
+        delete mapped.file;
+    }
+
+    ++m_spillEpoch;
+    m_baseIndex = 0;
+    m_sealedRows = 0;
+    m_segments.clear();
+    m_mappedSegments.clear();
+    QMetaObject::invokeMethod(m_writer, "removeSpillFiles",
+                              Qt::QueuedConnection);
+}
+
+/**
+ * Returns a pointer to the memory-mapped contents of the given @a segment,
+ * mapping the file on first access. At most @c kMaxMappedSegments files are
+ * kept mapped at the same time, the least recently used mapping is released
+ * when the limit is exceeded.
+ */
+const uchar *UI::HistoryStore::mapSegment(const Segment &segment) const
+{
+    // Already mapped, move the entry to the front of the LRU list
+    for (int i = 0; i < m_mappedSegments.count(); ++i)
+    {
+        if (m_mappedSegments.at(i).id == segment.id)
+        {
+            if (i > 0)
+                m_mappedSegments.move(i, 0);
+            return m_mappedSegments.first().data;
+        }
+    }
+
+    // Map the segment file
+    QFile *file = new QFile(segment.path);
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        delete file;
+        return Q_NULLPTR;
+    }
+    const uchar *data = file->map(0, file->size());
+    if (!data)
+    {
+        file->close();
+        delete file;
+        return Q_NULLPTR;
+    }
+
+    // Validate the header before trusting the file
+    const quint32 *header = reinterpret_cast<const quint32 *>(data);
+    if (header[0] != kSegmentMagic || header[1] != kSegmentVersion)
+    {
+        file->unmap(const_cast<uchar *>(data));
+        file->close();
+        delete file;
+        return Q_NULLPTR;
+    }
+
+    // Register the mapping & release the least recently used one when the
+    // limit is exceeded
+    MappedSegment mapped;
+    mapped.id = segment.id;
+    mapped.file = file;
+    mapped.data = data;
+    m_mappedSegments.prepend(mapped);
+    while (m_mappedSegments.count() > kMaxMappedSegments)
+    {
+        auto &oldest = m_mappedSegments.last();
+        oldest.file->unmap(const_cast<uchar *>(oldest.data));
+        oldest.file->close();
+        delete oldest.file;
+        m_mappedSegments.removeLast();
+    }
+
+    return data;
+}
+
+/**
+ * Obtains the half-open row range [@a begin, @a end) of the samples of a
+ * mapped segment whose timestamps fall inside [@a from, @a to], using the
+ * same binary search as the in-RAM timestamp column
+ */
+void UI::HistoryStore::segmentRange(const uchar *data, const int rows,
+                                    const qint64 from, const qint64 to,
+                                    int &begin, int &end) const
+{
+    const qint64 *first
+        = reinterpret_cast<const qint64 *>(data + kSegmentHeaderSize);
+    const qint64 *last = first + rows;
+    begin = static_cast<int>(std::lower_bound(first, last, from) - first);
+    end = static_cast<int>(std::upper_bound(first, last, to) - first);
+}
+
+/**
+ * Feeds a freshly appended @a value into the decimation pyramid of the given
+ * @a column. Each level accumulates pairs of entries of the level below it,
+ * so a completed bucket is flushed to its level & propagated upwards; on
+ * average an append touches only two accumulators, which keeps the
+ * incremental build cost constant.
+ *
+ * The pyramid stores float min/max pairs: half the precision of the raw
+ * columns is plenty for picking pixel extents & halves the footprint.
+ */
+void UI::HistoryStore::appendToPyramid(const int column, const double value)
+{
+    float min = static_cast<float>(value);
+    float max = min;
+
+    auto &levels = m_pyramids[column];
+    auto &accumulators = m_pyramidAccumulators[column];
+    for (int level = 0; level < kPyramidLevels; ++level)
+    {
+        // Merge the incoming pair into the bucket of this level
+        auto &acc = accumulators[level];
+        if (acc.count == 0)
+        {
+            acc.min = min;
+            acc.max = max;
+        }
+
+        else
+        {
+            acc.min = qMin(acc.min, min);
+            acc.max = qMax(acc.max, max);
+        }
+
+        // Bucket incomplete, nothing to propagate upwards
+        if (++acc.count < 2)
+            break;
+
+        // Flush the completed bucket to its level & feed it to the next one
+        levels[level].append(acc.min);
+        levels[level].append(acc.max);
+        min = acc.min;
+        max = acc.max;
+        acc.count = 0;
+    }
+}
+
+/**
+ * Fills @a xData / @a yData with the raw samples of the given @a column
+ * inside the global sample-index range [@a firstSample, @a lastSample), with
+ * the global sample index as x value. Samples still in RAM are read from the
+ * columns, older samples are read from the memory-mapped segment files.
+ *
+ * Rows that are currently in flight to the segment writer (trimmed from RAM
+ * but not sealed yet) are skipped, the gap closes as soon as the writer
+ * thread seals the segment.
+ */
+void UI::HistoryStore::rawSamples(const int column, const qint64 firstSample,
+                                  const qint64 lastSample, PlotData &xData,
+                                  PlotData &yData) const
+{
+    // Collect the overlapping rows of every sealed segment
+    for (int i = 0; i < m_segments.count(); ++i)
+    {
+        const auto &segment = m_segments.at(i);
+        const qint64 begin = qMax(firstSample, segment.firstIndex);
+        const qint64 end = qMin(lastSample, segment.firstIndex + segment.rows);
+        if (begin >= end)
+            continue;
+
+        const uchar *data = mapSegment(segment);
+        if (!data)
+            continue;
+
+        const double *values = reinterpret_cast<const double *>(
+            data + kSegmentHeaderSize
+            + qint64(segment.rows) * qint64(sizeof(qint64))
+            + qint64(column) * qint64(segment.rows) * qint64(sizeof(double)));
+        for (qint64 row = begin; row < end; ++row)
+        {
+            xData.append(static_cast<double>(row));
+            yData.append(values[row - segment.firstIndex]);
+        }
+    }
+
+    // Collect the overlapping in-RAM rows (widening them when the columns
+    // store 32-bit floats)
+    const qint64 begin = qMax(firstSample, m_baseIndex);
+    const qint64 end = qMin(lastSample, m_baseIndex + sampleCount());
+    for (qint64 row = begin; row < end; ++row)
+    {
+        const int index = static_cast<int>(row - m_baseIndex);
+        xData.append(static_cast<double>(row));
+        if (m_float32)
+            yData.append(static_cast<double>(m_floatColumns.at(column).at(index)));
+        else
+            yData.append(m_columns.at(column).at(index));
+    }
+}
+
+/**
+ * Reports the memory allocated by the RAM columns to the memory registry.
+ * Mapped segments are intentionally excluded, their pages are file-backed &
+ * reclaimable by the operating system.
+ */
+void UI::HistoryStore::reportMemoryUsage() const
+{
+    qint64 bytes = qint64(m_timestamps.capacity()) * qint64(sizeof(qint64));
+    for (int i = 0; i < m_columns.count(); ++i)
+        bytes += qint64(m_columns.at(i).capacity()) * qint64(sizeof(double));
+    for (int i = 0; i < m_floatColumns.count(); ++i)
+        bytes += qint64(m_floatColumns.at(i).capacity()) * qint64(sizeof(float));
+    for (int i = 0; i < m_pyramids.count(); ++i)
+        for (int level = 0; level < m_pyramids.at(i).count(); ++level)
+            bytes += qint64(m_pyramids.at(i).at(level).capacity())
+                     * qint64(sizeof(float));
+
+    Misc::MemoryRegistry::instance().report("UI::HistoryStore (dataset history)",
+                                            bytes);
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_HistoryStore.cpp"
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QList>
+#include <QObject>
+#include <QThread>
+#include <QVector>
+#include <DataTypes.h>
+#include <JSON/Frame.h>
+
+class QDataStream;
+
+namespace UI
+{
+/**
+ * @brief The SegmentWriter class
+ *
+ * Worker object that seals blocks of history samples trimmed from the in-RAM
+ * store into columnar segment files from a dedicated thread, so that disk
+ * latency can never stall the frame-processing path.
+ *
+ * Each segment file starts with a small header (magic, version, column &
+ * row count), followed by the timestamp column and one contiguous column of
+ * doubles per dataset. The layout matches the in-memory store, which allows
+ * @c UI::HistoryStore to memory-map sealed segments & binary-search/scan them
+ * exactly like its own RAM columns.
+ */
+class SegmentWriter : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void segmentSealed(const int epoch, const int id, const QString &path,
+                       const qint64 firstTimestamp, const qint64 lastTimestamp,
+                       const int rows);
+
+public:
+    explicit SegmentWriter(const QString &spillPath,
+                           QObject *parent = Q_NULLPTR);
+
+public Q_SLOTS:
+    void removeSpillFiles();
+    void writeSegment(const int epoch, const int id,
+                      const QVector<qint64> &timestamps,
+                      const QVector<QVector<double>> &columns);
+
+private:
+    QString m_spillPath;
+};
+
+/**
+ * @brief The HistoryStore class
+ *
+ * Columnar in-memory store with the full value history of every dataset of
+ * the current project, so that samples remain inspectable after they scroll
+ * out of the plot windows.
+ *
+ * The store keeps one contiguous column of doubles per dataset plus a shared
+ * millisecond timestamp column. Appending a frame writes one value at the end
+ * of each column, and range queries binary-search the timestamp column &
+ * then scan the value columns sequentially, which keeps both operations
+ * cache-friendly regardless of the number of datasets.
+ *
+ * The history is capped by a sample count and (optionally) by a memory
+ * budget; when the cap is reached the oldest quarter of every column is
+ * sealed into an on-disk segment by @c UI::SegmentWriter on a background
+ * thread & dropped from RAM in one block. Sealed segments remain reachable
+ * through the same time-range query API: they are memory-mapped on demand
+ * (with a small LRU of mapped segments), so reads only cost page-ins for the
+ * ranges actually viewed & full-session scrollback fits in bounded RAM.
+ *
+ * Projects that enable the "fp32" storage flag keep their in-RAM columns as
+ * 32-bit floats instead of doubles, halving the footprint of the history (and
+ * therefore doubling the reach of a given memory budget). Samples are rounded
+ * once at ingest; sealed segment files always store doubles, so the on-disk
+ * format & the export pipeline are unaffected by the flag.
+ *
+ * For interactive pan/zoom the store also maintains a min/max decimation
+ * pyramid per column: level @c i holds the minimum & maximum of every
+ * aligned block of 2^(i+1) samples & is updated incrementally as samples
+ * arrive. @c decimate() picks the coarsest level that still yields about two
+ * points per requested output point, so rendering any zoom range touches a
+ * bounded number of values regardless of how many samples it spans.
+ */
+class HistoryStore : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(int maxSamples
+               READ maxSamples
+               WRITE setMaxSamples
+               NOTIFY capacityChanged)
+    Q_PROPERTY(int maxMegabytes
+               READ maxMegabytes
+               WRITE setMaxMegabytes
+               NOTIFY capacityChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void historyReset();
+    void capacityChanged();
+    void spillRequested(const int epoch, const int id,
+                        const QVector<qint64> &timestamps,
+                        const QVector<QVector<double>> &columns);
+
+private:
+    explicit HistoryStore();
+    ~HistoryStore();
+    HistoryStore(HistoryStore &&) = delete;
+    HistoryStore(const HistoryStore &) = delete;
+    HistoryStore &operator=(HistoryStore &&) = delete;
+    HistoryStore &operator=(const HistoryStore &) = delete;
+
+public:
+    static HistoryStore &instance();
+
+    int maxSamples() const;
+    int maxMegabytes() const;
+
+    int sampleCount() const;
+    int columnCount() const;
+    bool float32Storage() const;
+    int spilledSampleCount() const;
+    qint64 totalSampleCount() const;
+    StringList columnTitles() const;
+
+    const QVector<qint64> &timestamps() const { return m_timestamps; }
+    const QVector<double> &samples(const int column) const;
+
+    void timeRange(const qint64 from, const qint64 to, int &begin, int &end) const;
+    QVector<qint64> timestamps(const qint64 from, const qint64 to) const;
+    QVector<double> samples(const int column, const qint64 from, const qint64 to) const;
+
+    void decimate(const int column, const qint64 firstSample,
+                  const qint64 lastSample, const int maxPoints, PlotData &xData,
+                  PlotData &yData) const;
+
+    void append(const JSON::Frame &frame);
+
+    void serializeSnapshot(QDataStream &out, const int maxRows) const;
+    bool restoreSnapshot(QDataStream &in);
+
+public Q_SLOTS:
+    void clear();
+    void setMaxSamples(const int samples);
+    void setMaxMegabytes(const int megabytes);
+
+private Q_SLOTS:
+    void registerSealedSegment(const int epoch, const int id,
+                               const QString &path,
+                               const qint64 firstTimestamp,
+                               const qint64 lastTimestamp, const int rows);
+
+private:
+    /**
+     * Index entry of a sealed on-disk segment
+     */
+    struct Segment
+    {
+        int id;
+        int rows;
+        QString path;
+        qint64 firstIndex;
+        qint64 firstTimestamp;
+        qint64 lastTimestamp;
+    };
+
+    /**
+     * A currently memory-mapped segment file, kept in a small LRU list
+     */
+    struct MappedSegment
+    {
+        int id;
+        QFile *file;
+        const uchar *data;
+    };
+
+    /**
+     * Partially filled pyramid bucket of one level of one column
+     */
+    struct PyramidAccumulator
+    {
+        int count;
+        float min;
+        float max;
+    };
+
+private:
+    int capacity() const;
+    void dropSpilledSegments();
+    void reportMemoryUsage() const;
+    void appendToPyramid(const int column, const double value);
+    void rawSamples(const int column, const qint64 firstSample,
+                    const qint64 lastSample, PlotData &xData,
+                    PlotData &yData) const;
+    const uchar *mapSegment(const Segment &segment) const;
+    void segmentRange(const uchar *data, const int rows, const qint64 from,
+                      const qint64 to, int &begin, int &end) const;
+
+private:
+    int m_maxSamples;
+    int m_maxMegabytes;
+
+    StringList m_columnTitles;
+    QVector<qint64> m_timestamps;
+
+    // Exactly one of these column sets is in use at any time, decided by the
+    // storage precision of the current project (the inactive one stays empty)
+    bool m_float32;
+    QVector<QVector<double>> m_columns;
+    QVector<QVector<float>> m_floatColumns;
+
+    qint64 m_baseIndex;
+    qint64 m_sealedRows;
+    QVector<QVector<QVector<float>>> m_pyramids;
+    QVector<QVector<PyramidAccumulator>> m_pyramidAccumulators;
+
+    int m_spillEpoch;
+    int m_nextSegmentId;
+    QString m_spillPath;
+    QVector<Segment> m_segments;
+    mutable QList<MappedSegment> m_mappedSegments;
+
+    SegmentWriter *m_writer;
+    QThread m_writerThread;
+};
+}
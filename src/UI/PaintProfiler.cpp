@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include <UI/PaintProfiler.h>
+#include <Misc/TimerEvents.h>
+
+/**
+ * Constructor function, the profiler is disabled by default & the statistics
+ * rows are refreshed at 1 Hz (same cadence as the latency tracer) to avoid
+ * re-generating the strings & badge colors for every painted frame.
+ */
+UI::PaintProfiler::PaintProfiler()
+    : m_enabled(false)
+    , m_statisticsChanged(false)
+{
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz, this,
+            &UI::PaintProfiler::updateStatistics);
+}
+
+/**
+ * Returns the only instance of this class
+ */
+UI::PaintProfiler &UI::PaintProfiler::instance()
+{
+    static PaintProfiler singleton;
+    return singleton;
+}
+
+/**
+ * Returns @c true if per-widget paint profiling is enabled
+ */
+bool UI::PaintProfiler::enabled() const
+{
+    return m_enabled;
+}
+
+/**
+ * Returns the accumulated per-widget statistics as display-ready rows, ranked
+ * by average render cost so that the most expensive widget is listed first.
+ */
+StringList UI::PaintProfiler::statistics() const
+{
+    // Collect the widget titles & sort them by average render cost
+    auto titles = m_samples.keys();
+    std::sort(titles.begin(), titles.end(),
+              [this](const QString &a, const QString &b) {
+                  const auto &sa = m_samples[a];
+                  const auto &sb = m_samples[b];
+                  return sa.sumNsecs * qint64(sb.count) > sb.sumNsecs * qint64(sa.count);
+              });
+
+    // Generate one row per widget
+    StringList rows;
+    for (int i = 0; i < titles.count(); ++i)
+    {
+        const auto &sample = m_samples[titles.at(i)];
+        const double avg = sample.sumNsecs / 1e6 / sample.count;
+        const double max = sample.maxNsecs / 1e6;
+        rows.append(QString("%1. %2: n=%3, avg %4 ms, max %5 ms")
+                        .arg(i + 1)
+                        .arg(titles.at(i))
+                        .arg(sample.count)
+                        .arg(avg, 0, 'f', 2)
+                        .arg(max, 0, 'f', 1));
+    }
+
+    // No samples yet
+    if (rows.isEmpty())
+        rows.append(tr("No paint samples yet"));
+
+    return rows;
+}
+
+/**
+ * Returns the render cost of the widget with the given @a title relative to
+ * the most expensive widget as a number in the [0, 1] range. Used by the QML
+ * interface to color the heat badge of each dashboard widget.
+ */
+qreal UI::PaintProfiler::heat(const QString &title) const
+{
+    // Obtain the average cost of the given widget
+    const auto it = m_samples.constFind(title);
+    if (it == m_samples.constEnd() || it->count == 0)
+        return 0;
+    const double avg = double(it->sumNsecs) / it->count;
+
+    // Obtain the average cost of the most expensive widget
+    double worst = 0;
+    for (auto i = m_samples.constBegin(); i != m_samples.constEnd(); ++i)
+    {
+        if (i->count > 0)
+            worst = qMax(worst, double(i->sumNsecs) / i->count);
+    }
+
+    if (worst <= 0)
+        return 0;
+
+    return qBound(0.0, avg / worst, 1.0);
+}
+
+/**
+ * Returns the display text of the heat badge for the widget with the given
+ * @a title (the average render cost in milliseconds).
+ */
+QString UI::PaintProfiler::badgeText(const QString &title) const
+{
+    const auto it = m_samples.constFind(title);
+    if (it == m_samples.constEnd() || it->count == 0)
+        return QString();
+
+    const double avg = it->sumNsecs / 1e6 / it->count;
+    return QString("%1 ms").arg(avg, 0, 'f', 2);
+}
+
+/**
+ * Registers a render of the widget with the given @a title that took @a nsecs
+ * nanoseconds. Called by @c UI::DeclarativeWidget while profiling is enabled,
+ * always from the GUI thread (widget rasterization happens on the GUI thread).
+ */
+void UI::PaintProfiler::recordRender(const QString &title, const qint64 nsecs)
+{
+    if (!m_enabled || title.isEmpty())
+        return;
+
+    auto &sample = m_samples[title];
+    sample.count++;
+    sample.sumNsecs += nsecs;
+    sample.maxNsecs = qMax(sample.maxNsecs, nsecs);
+    m_statisticsChanged = true;
+}
+
+/**
+ * Enables or disables per-widget paint profiling, the accumulated samples are
+ * cleared on every transition so that a new session starts from a clean slate.
+ */
+void UI::PaintProfiler::setEnabled(const bool enabled)
+{
+    if (m_enabled != enabled)
+    {
+        m_enabled = enabled;
+        resetStatistics();
+        Q_EMIT enabledChanged();
+    }
+}
+
+/**
+ * Clears the accumulated per-widget samples
+ */
+void UI::PaintProfiler::resetStatistics()
+{
+    m_samples.clear();
+    m_statisticsChanged = false;
+    Q_EMIT statisticsChanged();
+}
+
+/**
+ * Notifies the user interface at 1 Hz when new samples were registered since
+ * the last notification, which keeps the statistics rows & badge colors fresh
+ * without re-generating them for every painted frame.
+ */
+void UI::PaintProfiler::updateStatistics()
+{
+    if (m_statisticsChanged)
+    {
+        m_statisticsChanged = false;
+        Q_EMIT statisticsChanged();
+    }
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_PaintProfiler.cpp"
+#endif
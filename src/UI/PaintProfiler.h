@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+
+#include <DataTypes.h>
+
+namespace UI
+{
+/**
+ * @brief The PaintProfiler class
+ *
+ * Opt-in instrumentation that measures the per-widget cost of the dashboard
+ * render path. When profiling is enabled, @c UI::DeclarativeWidget times the
+ * rasterization of the contained widget (which includes the data-dependent
+ * paint work of the Qwt-based widgets) & attributes the sample to the widget
+ * title.
+ *
+ * The accumulated samples drive two displays: a small heat badge on top of
+ * every dashboard widget (colored by its cost relative to the most expensive
+ * widget) & a ranked list in the diagnostics pane. Together they point at the
+ * widget that is responsible for a slow dashboard without having to bisect
+ * the project file. While profiling is disabled the instrumentation is
+ * reduced to a boolean check, so shipping it in release builds is free.
+ */
+class PaintProfiler : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(bool enabled
+               READ enabled
+               WRITE setEnabled
+               NOTIFY enabledChanged)
+    Q_PROPERTY(StringList statistics
+               READ statistics
+               NOTIFY statisticsChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void enabledChanged();
+    void statisticsChanged();
+
+private:
+    explicit PaintProfiler();
+    PaintProfiler(PaintProfiler &&) = delete;
+    PaintProfiler(const PaintProfiler &) = delete;
+    PaintProfiler &operator=(PaintProfiler &&) = delete;
+    PaintProfiler &operator=(const PaintProfiler &) = delete;
+
+public:
+    static PaintProfiler &instance();
+
+    bool enabled() const;
+    StringList statistics() const;
+
+    Q_INVOKABLE qreal heat(const QString &title) const;
+    Q_INVOKABLE QString badgeText(const QString &title) const;
+
+    void recordRender(const QString &title, const qint64 nsecs);
+
+public Q_SLOTS:
+    void setEnabled(const bool enabled);
+    void resetStatistics();
+
+private Q_SLOTS:
+    void updateStatistics();
+
+private:
+    struct Sample
+    {
+        quint64 count = 0;
+        qint64 sumNsecs = 0;
+        qint64 maxNsecs = 0;
+    };
+
+    bool m_enabled;
+    bool m_statisticsChanged;
+    QHash<QString, Sample> m_samples;
+};
+}
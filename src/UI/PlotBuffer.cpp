@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include <UI/PlotBuffer.h>
+
+UI::PlotBuffer::PlotBuffer()
+    : m_head(0)
+    , m_float32(false)
+{
+}
+
+/**
+ * Returns the number of samples that the buffer can hold
+ */
+int UI::PlotBuffer::count() const
+{
+    return m_float32 ? m_floatSamples.count() : m_samples.count();
+}
+
+/**
+ * Returns @c true if the buffer stores its samples as 32-bit floats
+ */
+bool UI::PlotBuffer::floatStorage() const
+{
+    return m_float32;
+}
+
+/**
+ * Returns the sample stored at the given @a index, where index 0 corresponds
+ * to the oldest sample of the buffer & index @c count() - 1 corresponds to
+ * the most recent one.
+ */
+double UI::PlotBuffer::sampleAt(const int index) const
+{
+    int pos = m_head + index;
+    if (pos >= count())
+        pos -= count();
+
+    return m_float32 ? static_cast<double>(m_floatSamples.at(pos)) : m_samples.at(pos);
+}
+
+/**
+ * Enables/disables 32-bit float storage for the samples of the buffer. Existing
+ * samples are converted in place, enabling float storage rounds every sample to
+ * ~7 significant digits.
+ */
+void UI::PlotBuffer::setFloatStorage(const bool enabled)
+{
+    if (enabled == m_float32)
+        return;
+
+    // Convert the stored samples, logical positions are unaffected
+    if (enabled)
+    {
+        m_floatSamples.resize(m_samples.count());
+        for (int i = 0; i < m_samples.count(); ++i)
+            m_floatSamples[i] = static_cast<float>(m_samples.at(i));
+
+        m_samples.clear();
+    }
+
+    else
+    {
+        m_samples.resize(m_floatSamples.count());
+        for (int i = 0; i < m_floatSamples.count(); ++i)
+            m_samples[i] = static_cast<double>(m_floatSamples.at(i));
+
+        m_floatSamples.clear();
+    }
+
+    m_float32 = enabled;
+}
+
+/**
+ * Changes the number of samples that the buffer can hold & resets the head
+ * index of the buffer.
+ */
+void UI::PlotBuffer::resize(const int count)
+{
+    m_head = 0;
+    if (m_float32)
+        m_floatSamples.resize(count);
+    else
+        m_samples.resize(count);
+}
+
+/**
+ * Changes the number of samples that the buffer can hold while keeping the
+ * most recent @c min(old,new) samples. Used when the operator tunes the
+ * number of displayed points mid-session, a plain @c resize() would discard
+ * exactly the transient that is being inspected.
+ *
+ * When the buffer grows, the new (older) positions are back-filled with the
+ * oldest kept sample so that the plot does not display an artificial step
+ * towards zero.
+ */
+void UI::PlotBuffer::resizePreserving(const int count)
+{
+    // Nothing to do
+    const int previous = this->count();
+    if (count == previous)
+        return;
+
+    // Empty buffer or full truncation, fall back to a plain resize
+    if (previous <= 0 || count <= 0)
+    {
+        resize(count);
+        return;
+    }
+
+    // Copy the samples in chronological order & keep the most recent ones
+    PlotData ordered;
+    linearize(ordered);
+
+    const int kept = qMin(previous, count);
+
+    // Rebuild the sample vector of the active storage mode; grown buffers are
+    // back-filled with the oldest kept sample so that the plot does not show
+    // an artificial step towards zero. Index 0 is now the oldest sample.
+    m_head = 0;
+    if (m_float32)
+    {
+        QVector<float> samples(count);
+        for (int i = 0; i < count; ++i)
+            samples[i] = static_cast<float>(
+                ordered.at(qMax(previous - count + i, previous - kept)));
+
+        m_floatSamples = samples;
+    }
+
+    else
+    {
+        PlotData samples(count);
+        memcpy(samples.data() + (count - kept), ordered.constData() + (previous - kept),
+               kept * sizeof(double));
+        for (int i = 0; i < count - kept; ++i)
+            samples[i] = ordered.at(previous - kept);
+
+        m_samples = samples;
+    }
+}
+
+/**
+ * Sets every sample of the buffer to the given @a value
+ */
+void UI::PlotBuffer::fill(const double value)
+{
+    m_head = 0;
+    if (m_float32)
+        m_floatSamples.fill(static_cast<float>(value));
+    else
+        m_samples.fill(value);
+}
+
+/**
+ * Registers the given @a value as the most recent sample of the buffer,
+ * overwriting the oldest one. This only writes one sample & advances the
+ * head index, so the cost does not depend on the size of the buffer.
+ */
+void UI::PlotBuffer::append(const double value)
+{
+    const int size = count();
+    if (size <= 0)
+        return;
+
+    if (m_float32)
+        m_floatSamples[m_head] = static_cast<float>(value);
+    else
+        m_samples[m_head] = value;
+
+    if (++m_head >= size)
+        m_head = 0;
+}
+
+/**
+ * Copies the samples of the buffer in chronological order into the given
+ * @a vector, which is re-used across calls by the plot widgets to avoid
+ * allocating a new vector per frame.
+ */
+void UI::PlotBuffer::linearize(PlotData &vector) const
+{
+    const int count = this->count();
+    vector.resize(count);
+    if (count <= 0)
+        return;
+
+    const int tail = count - m_head;
+
+    // Float storage, widen the samples while copying
+    if (m_float32)
+    {
+        for (int i = 0; i < tail; ++i)
+            vector[i] = static_cast<double>(m_floatSamples.at(m_head + i));
+        for (int i = 0; i < m_head; ++i)
+            vector[tail + i] = static_cast<double>(m_floatSamples.at(i));
+    }
+
+    // Double storage, copy the two contiguous chunks directly
+    else
+    {
+        memcpy(vector.data(), m_samples.constData() + m_head, tail * sizeof(double));
+        memcpy(vector.data() + tail, m_samples.constData(), m_head * sizeof(double));
+    }
+}
+
+/**
+ * Reduces the samples of the buffer to at most @a maxPoints points using
+ * min/max binning & writes the result into the given @a xData & @a yData
+ * vectors (which are re-used across calls by the plot widgets).
+ *
+ * Each bin covers a fixed range of source samples & produces the minimum and
+ * maximum value of that range (in order of occurrence), so peaks and valleys
+ * survive the decimation. The x-axis values correspond to the chronological
+ * sample indices, which lets the plots keep their original horizontal scale.
+ *
+ * If the buffer holds less samples than @a maxPoints, the samples are copied
+ * without any decimation.
+ */
+void UI::PlotBuffer::decimate(PlotData &xData, PlotData &yData,
+                              const int maxPoints) const
+{
+    // Buffer is small enough, copy the samples directly
+    const int count = this->count();
+    if (maxPoints < 4 || count <= maxPoints)
+    {
+        linearize(yData);
+        xData.resize(count);
+        for (int i = 0; i < count; ++i)
+            xData[i] = i;
+
+        return;
+    }
+
+    // Each bin produces two points (minimum & maximum)
+    const int bins = maxPoints / 2;
+    const double step = static_cast<double>(count) / bins;
+    xData.resize(bins * 2);
+    yData.resize(bins * 2);
+
+    // Scan every bin & register its minimum/maximum sample
+    int sample = 0;
+    for (int i = 0; i < bins; ++i)
+    {
+        const int end = (i == bins - 1) ? count : static_cast<int>((i + 1) * step);
+
+        int minIndex = sample;
+        int maxIndex = sample;
+        double vmin = sampleAt(sample);
+        double vmax = vmin;
+        for (; sample < end; ++sample)
+        {
+            const double v = sampleAt(sample);
+            if (v < vmin)
+            {
+                vmin = v;
+                minIndex = sample;
+            }
+
+            if (v > vmax)
+            {
+                vmax = v;
+                maxIndex = sample;
+            }
+        }
+
+        // Register both points in order of occurrence
+        const int first = (minIndex <= maxIndex) ? minIndex : maxIndex;
+        const int second = (minIndex <= maxIndex) ? maxIndex : minIndex;
+        xData[i * 2 + 0] = first;
+        xData[i * 2 + 1] = second;
+        yData[i * 2 + 0] = sampleAt(first);
+        yData[i * 2 + 1] = sampleAt(second);
+    }
+}
+
+/**
+ * Reduces the samples of the buffer to at most @a maxPoints points using
+ * min/max binning & writes only the y values into @a yData.
+ *
+ * Unlike the two-vector @c decimate() overload, the points are aligned to the
+ * fixed bin grid produced by @c binAxis(), so several buffers with the same
+ * sample count can reference one shared x-axis vector. The extremes of a bin
+ * are registered at the bin borders instead of their exact sample index,
+ * which moves a peak by less than one bin (about half a pixel on screen).
+ */
+void UI::PlotBuffer::decimate(PlotData &yData, const int maxPoints) const
+{
+    // Buffer is small enough, copy the samples directly
+    const int count = this->count();
+    if (maxPoints < 4 || count <= maxPoints)
+    {
+        linearize(yData);
+        return;
+    }
+
+    // Each bin produces two points (minimum & maximum)
+    const int bins = maxPoints / 2;
+    const double step = static_cast<double>(count) / bins;
+    yData.resize(bins * 2);
+
+    // Scan every bin & register its minimum/maximum sample
+    int sample = 0;
+    for (int i = 0; i < bins; ++i)
+    {
+        const int end = (i == bins - 1) ? count : static_cast<int>((i + 1) * step);
+
+        int minIndex = sample;
+        int maxIndex = sample;
+        double vmin = sampleAt(sample);
+        double vmax = vmin;
+        for (; sample < end; ++sample)
+        {
+            const double v = sampleAt(sample);
+            if (v < vmin)
+            {
+                vmin = v;
+                minIndex = sample;
+            }
+
+            if (v > vmax)
+            {
+                vmax = v;
+                maxIndex = sample;
+            }
+        }
+
+        // Register both extremes in order of occurrence
+        yData[i * 2 + 0] = (minIndex <= maxIndex) ? vmin : vmax;
+        yData[i * 2 + 1] = (minIndex <= maxIndex) ? vmax : vmin;
+    }
+}
+
+/**
+ * Fills @a xData with the x-axis positions of the bin grid used by the y-only
+ * @c decimate() overload for buffers with @a count samples: the first & last
+ * chronological sample index of every bin. The vector only depends on the
+ * sample count & @a maxPoints, so plots with several equally-sized buffers
+ * compute it once & share it across all of their curves.
+ */
+void UI::PlotBuffer::binAxis(PlotData &xData, const int count, const int maxPoints)
+{
+    // Buffers below the point budget are not decimated
+    if (maxPoints < 4 || count <= maxPoints)
+    {
+        xData.resize(count);
+        for (int i = 0; i < count; ++i)
+            xData[i] = i;
+
+        return;
+    }
+
+    // Register the borders of every bin
+    const int bins = maxPoints / 2;
+    const double step = static_cast<double>(count) / bins;
+    xData.resize(bins * 2);
+
+    int sample = 0;
+    for (int i = 0; i < bins; ++i)
+    {
+        const int end = (i == bins - 1) ? count : static_cast<int>((i + 1) * step);
+        xData[i * 2 + 0] = sample;
+        xData[i * 2 + 1] = (end > sample) ? (end - 1) : sample;
+        sample = end;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <DataTypes.h>
+
+namespace UI
+{
+/**
+ * @brief The PlotBuffer class
+ *
+ * Fixed-size circular buffer that holds the samples displayed by a dashboard
+ * plot. Appending a sample only overwrites the oldest one & advances a head
+ * index, so registering new data is a constant-time operation regardless of
+ * the number of points displayed by the plot (the previous implementation
+ * shifted the whole sample vector with a memmove() on every frame).
+ *
+ * Samples can be accessed in chronological order with @c sampleAt(), or
+ * copied into a linear vector with @c linearize() when a consumer (e.g. the
+ * Qwt curves) requires contiguous data.
+ *
+ * Projects that enable the "fp32" storage flag store the samples as 32-bit
+ * floats instead of doubles, halving the memory footprint & bandwidth of
+ * large dashboards (see @c setFloatStorage()). Values are converted at the
+ * buffer boundary, every accessor keeps returning doubles.
+ */
+class PlotBuffer
+{
+public:
+    PlotBuffer();
+
+    int count() const;
+    bool floatStorage() const;
+    double sampleAt(const int index) const;
+
+    void setFloatStorage(const bool enabled);
+
+    void resize(const int count);
+    void resizePreserving(const int count);
+    void fill(const double value);
+    void append(const double value);
+    void linearize(PlotData &vector) const;
+    void decimate(PlotData &xData, PlotData &yData, const int maxPoints) const;
+    void decimate(PlotData &yData, const int maxPoints) const;
+
+    static void binAxis(PlotData &xData, const int count, const int maxPoints);
+
+private:
+    int m_head;
+    bool m_float32;
+
+    // Exactly one of these vectors is in use at any time, decided by the
+    // storage mode (the inactive one stays empty)
+    PlotData m_samples;
+    QVector<float> m_floatSamples;
+};
+}
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <climits>
+#include <QSGGeometryNode>
+#include <QSGFlatColorMaterial>
+
+#include <UI/Dashboard.h>
+#include <UI/QuickPlot.h>
+#include <Misc/ThemeManager.h>
+
+/**
+ * Fraction of the vertical axis span that the data must fall below before the
+ * scale shrinks back down, same hysteresis band as the Qwt plot widget so
+ * that both implementations settle on comparable scales.
+ */
+static const double kQuickShrinkThreshold = 0.4;
+
+/**
+ * Computes the padded axis scale for data in the range [@a min, @a max],
+ * centering the curve vertically & handling the equal/zero corner cases.
+ * Mirrors the scale selection of the Qwt plot widget, so switching a dataset
+ * between the two implementations does not change the displayed range.
+ */
+static void QuickPaddedScale(double min, double max, double *outMin,
+                             double *outMax)
+{
+    // Get central value
+    double median = qMax<double>(1, (max + min)) / 2;
+    if (max == min)
+        median = max;
+
+    // Center graph vertically
+    double mostDiff = qMax<double>(qAbs<double>(min), qAbs<double>(max));
+    double newMin = median * (1 - 0.5) - qAbs<double>(median - mostDiff);
+    double newMax = median * (1 + 0.5) + qAbs<double>(median - mostDiff);
+    if (min < 0)
+        newMin = newMax * -1;
+
+    // Fix issues when min & max are equal
+    if (newMin == newMax)
+    {
+        newMax = qAbs<double>(newMax);
+        newMin = newMax * -1;
+    }
+
+    // Fix issues on min = max = (0,0)
+    if (newMin == 0 && newMax == 0)
+    {
+        newMax = 1;
+        newMin = -1;
+    }
+
+    *outMin = newMin;
+    *outMax = newMax;
+}
+
+/**
+ * Constructor function, registers the item with the scene graph & connects it
+ * to the dashboard events. Like the Qwt plots, the curve data is refreshed on
+ * the first widget update slice of every UI interval, so the adaptive UI
+ * timer of @c Misc::TimerEvents bounds the refresh rate of this item too.
+ */
+UI::QuickPlot::QuickPlot(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_index(-1)
+    , m_relativeIndex(-1)
+    , m_widgetVisible(true)
+    , m_autoscale(true)
+    , m_min(INT_MAX)
+    , m_max(INT_MIN)
+{
+    // The item renders its own scene graph node
+    setFlag(QQuickItem::ItemHasContents, true);
+
+    // React to dashboard events
+    // clang-format off
+    auto dash = &UI::Dashboard::instance();
+    connect(dash, SIGNAL(updatedSlice0()),
+            this, SLOT(updateData()),
+            Qt::QueuedConnection);
+    connect(dash, SIGNAL(pointsChanged()),
+            this, SLOT(updateData()),
+            Qt::QueuedConnection);
+    // clang-format on
+}
+
+/**
+ * Returns the global index of the widget rendered by this item
+ */
+int UI::QuickPlot::widgetIndex() const
+{
+    return m_index;
+}
+
+/**
+ * Returns @c true if the item should consume dashboard updates, used by the
+ * external widget windows to stop the curve refresh while they are hidden
+ */
+bool UI::QuickPlot::widgetVisible() const
+{
+    return m_widgetVisible;
+}
+
+/**
+ * Returns the path of the SVG icon to display for this widget
+ */
+QString UI::QuickPlot::widgetIcon() const
+{
+    return UI::Dashboard::instance().widgetIcon(widgetIndex());
+}
+
+/**
+ * Returns the appropiate window title for the given widget
+ */
+QString UI::QuickPlot::widgetTitle() const
+{
+    if (widgetIndex() >= 0)
+    {
+        auto titles = UI::Dashboard::instance().widgetTitles();
+        if (widgetIndex() < titles.count())
+            return titles.at(widgetIndex());
+    }
+
+    return tr("Invalid");
+}
+
+/**
+ * Returns @c false, the snapshot image export works by cloning the curves of
+ * a Qwt plot & this item does not have one. The QML interface hides the
+ * export button for widgets rendered through this item.
+ */
+bool UI::QuickPlot::supportsImageExport() const
+{
+    return false;
+}
+
+/**
+ * Selects the plot to render by this item & configures the curve color and
+ * the vertical scale for the matching dataset
+ */
+void UI::QuickPlot::setWidgetIndex(const int index)
+{
+    // Register the new index & reset the autoscale state
+    m_index = index;
+    m_min = INT_MAX;
+    m_max = INT_MIN;
+    m_autoscale = true;
+    m_samples.clear();
+
+    // Resolve the relative index of the plot & its dataset
+    auto dash = &UI::Dashboard::instance();
+    m_relativeIndex = dash->relativeIndex(m_index);
+    if (m_index >= 0 && m_relativeIndex >= 0
+        && m_relativeIndex < dash->plotCount())
+    {
+        // Get curve color
+        auto theme = &Misc::ThemeManager::instance();
+        StringList colors = theme->widgetColors();
+        if (colors.count() > m_relativeIndex)
+            m_color = QColor(colors.at(m_relativeIndex));
+        else
+            m_color = QColor(colors.at(m_relativeIndex % colors.count()));
+
+        // Use the fixed vertical scale of the dataset when one is configured
+        auto dataset = dash->getPlot(m_relativeIndex);
+        if (dataset.max() > dataset.min())
+        {
+            m_max = dataset.max();
+            m_min = dataset.min();
+            m_autoscale = false;
+        }
+    }
+
+    // Invalid index, do not render anything
+    else
+        m_relativeIndex = -1;
+
+    // Update user interface
+    Q_EMIT widgetIndexChanged();
+    updateData();
+}
+
+/**
+ * Shows or hides the curve & starts/stops consuming the dashboard updates
+ */
+void UI::QuickPlot::setWidgetVisible(const bool visible)
+{
+    if (m_widgetVisible != visible)
+    {
+        m_widgetVisible = visible;
+        Q_EMIT widgetVisibleChanged();
+
+        if (visible)
+            updateData();
+    }
+}
+
+/**
+ * Copies the latest samples of the plot buffer into the curve snapshot &
+ * schedules a scene graph update. The decimation & the autoscale logic match
+ * the Qwt plot widget, the rescale throttle is omitted because rebuilding the
+ * vertex data is plain arithmetic (there is no cached tick layout to keep
+ * alive, the axes are drawn by the Qwt implementation only).
+ */
+void UI::QuickPlot::updateData()
+{
+    // Item not visible, do not consume the update
+    if (!m_widgetVisible || !isVisible())
+        return;
+
+    // Invalid index, abort
+    auto dash = &UI::Dashboard::instance();
+    if (m_relativeIndex < 0 || m_relativeIndex >= dash->plotCount())
+        return;
+
+    // Decimate the curve to roughly two samples per device pixel with min/max
+    // binning, the item cannot display more detail anyway
+    const int maxPoints = qMax(256, static_cast<int>(width()) * 2);
+    dash->linearPlotValues().at(m_relativeIndex).decimate(m_samples, maxPoints);
+
+    // Update the vertical scale, the min/max binning of the decimator
+    // preserves the extrema of the full history
+    if (m_autoscale && !m_samples.isEmpty())
+    {
+        // Scan the extrema of the displayed values
+        double dataMin = m_samples.first();
+        double dataMax = dataMin;
+        for (int i = 1; i < m_samples.count(); ++i)
+        {
+            const auto v = m_samples.at(i);
+            if (v > dataMax)
+                dataMax = v;
+            if (v < dataMin)
+                dataMin = v;
+        }
+
+        // The scale must grow when the data leaves the current range & may
+        // shrink back once the data occupies less than the hysteresis
+        // fraction of the span
+        const bool grow = dataMax > m_max || dataMin < m_min;
+        const bool shrink = !grow && m_max > m_min
+                            && (dataMax - dataMin)
+                                   < (m_max - m_min) * kQuickShrinkThreshold;
+        if (grow || shrink)
+            QuickPaddedScale(dataMin - 1, dataMax + 1, &m_min, &m_max);
+    }
+
+    // Upload the new curve on the next scene graph sync
+    update();
+}
+
+/**
+ * Builds the line-strip geometry node that renders the curve. Called by the
+ * render thread while the GUI thread is blocked, so the sample snapshot can
+ * be read without locking. The node & its vertex allocation are re-used
+ * across frames, only the vertex values are rewritten.
+ */
+QSGNode *UI::QuickPlot::updatePaintNode(QSGNode *oldNode,
+                                        UpdatePaintNodeData *updateData)
+{
+    Q_UNUSED(updateData);
+
+    // Nothing to draw, release the previous node
+    if (m_samples.count() < 2 || width() <= 0 || height() <= 0)
+    {
+        delete oldNode;
+        return Q_NULLPTR;
+    }
+
+    // Re-use the node & geometry of the previous frame when possible
+    QSGGeometry *geometry;
+    auto node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node)
+    {
+        geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),
+                                   m_samples.count());
+        geometry->setLineWidth(2);
+        geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+
+        auto material = new QSGFlatColorMaterial;
+        material->setColor(m_color);
+
+        node = new QSGGeometryNode;
+        node->setGeometry(geometry);
+        node->setMaterial(material);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    else
+    {
+        geometry = node->geometry();
+        geometry->allocate(m_samples.count());
+
+        // Theme or dataset changes can recolor the curve
+        auto material = static_cast<QSGFlatColorMaterial *>(node->material());
+        if (material->color() != m_color)
+        {
+            material->setColor(m_color);
+            node->markDirty(QSGNode::DirtyMaterial);
+        }
+    }
+
+    // Map the samples onto the item rectangle, values outside the configured
+    // fixed scale are clamped to the edges (just like the Qwt canvas clips
+    // the curve)
+    const double span = (m_max > m_min) ? (m_max - m_min) : 1;
+    const double dx = width() / (m_samples.count() - 1);
+    auto vertices = geometry->vertexDataAsPoint2D();
+    for (int i = 0; i < m_samples.count(); ++i)
+    {
+        const double ratio = qBound(0.0, (m_samples.at(i) - m_min) / span, 1.0);
+        vertices[i].set(static_cast<float>(i * dx),
+                        static_cast<float>((1 - ratio) * height()));
+    }
+
+    // Commit the new vertex data
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_QuickPlot.cpp"
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QQuickItem>
+#include <DataTypes.h>
+
+namespace UI
+{
+/**
+ * @brief The QuickPlot class
+ *
+ * Scene graph implementation of the scrolling plot widget. The curve is
+ * uploaded to the render thread as the vertex data of a single line-strip
+ * geometry node, built directly from the plot buffers of @c UI::Dashboard.
+ *
+ * This avoids the Qwt widget -> QPixmap -> QQuickPaintedItem chain used by
+ * @c UI::DashboardWidget, which rasterizes & copies every frame of the plot
+ * three times before it reaches the scene graph. The dashboard uses this item
+ * for plain plot widgets (see @c UI::Dashboard::useQuickPlot()); plots that
+ * need a logarithmic scale & the rest of the widget family keep the Qwt
+ * implementation, together with its pan/zoom navigation & image export.
+ */
+class QuickPlot : public QQuickItem
+{
+    // clang-format off
+    Q_OBJECT
+    Q_PROPERTY(int widgetIndex
+               READ widgetIndex
+               WRITE setWidgetIndex
+               NOTIFY widgetIndexChanged)
+    Q_PROPERTY(QString widgetIcon
+               READ widgetIcon
+               NOTIFY widgetIndexChanged)
+    Q_PROPERTY(QString widgetTitle
+               READ widgetTitle
+               NOTIFY widgetIndexChanged)
+    Q_PROPERTY(bool widgetVisible
+               READ widgetVisible
+               WRITE setWidgetVisible
+               NOTIFY widgetVisibleChanged)
+    // clang-format on
+
+Q_SIGNALS:
+    void widgetIndexChanged();
+    void widgetVisibleChanged();
+
+public:
+    QuickPlot(QQuickItem *parent = 0);
+
+    int widgetIndex() const;
+    bool widgetVisible() const;
+    QString widgetIcon() const;
+    QString widgetTitle() const;
+
+    Q_INVOKABLE bool supportsImageExport() const;
+
+public Q_SLOTS:
+    void setWidgetIndex(const int index);
+    void setWidgetVisible(const bool visible);
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode,
+                             UpdatePaintNodeData *updateData) override;
+
+private Q_SLOTS:
+    void updateData();
+
+private:
+    int m_index;
+    int m_relativeIndex;
+    bool m_widgetVisible;
+
+    bool m_autoscale;
+    double m_min;
+    double m_max;
+
+    // Curve snapshot shared with the render thread, only written from the GUI
+    // thread while the render thread is blocked inside updatePaintNode()
+    QColor m_color;
+    PlotData m_samples;
+};
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Statistics.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <qmath.h>
+
+#include <JSON/Group.h>
+#include <JSON/Dataset.h>
+
+/**
+ * Constructor function
+ */
+UI::Statistics::Statistics()
+{
+}
+
+/**
+ * Returns the only instance of the class
+ */
+UI::Statistics &UI::Statistics::instance()
+{
+    static Statistics singleton;
+    return singleton;
+}
+
+/**
+ * Returns the number of dataset channels tracked by the engine
+ */
+int UI::Statistics::columnCount() const
+{
+    return m_channels.count();
+}
+
+/**
+ * Returns the "group / dataset" title of each tracked channel
+ */
+StringList UI::Statistics::columnTitles() const
+{
+    return m_columnTitles;
+}
+
+/**
+ * Returns the channel index of the dataset with the given @a groupTitle &
+ * @a datasetTitle, or @c -1 when the dataset is not tracked
+ */
+int UI::Statistics::columnIndex(const QString &groupTitle,
+                                const QString &datasetTitle) const
+{
+    return m_columnTitles.indexOf(groupTitle + " / " + datasetTitle);
+}
+
+/**
+ * Returns the number of samples registered for the given @a column
+ */
+quint64 UI::Statistics::samples(const int column) const
+{
+    if (column < 0 || column >= m_channels.count())
+        return 0;
+
+    return m_channels.at(column).count;
+}
+
+/**
+ * Returns the smallest value registered for the given @a column
+ */
+double UI::Statistics::minimum(const int column) const
+{
+    if (column < 0 || column >= m_channels.count())
+        return 0;
+
+    return m_channels.at(column).min;
+}
+
+/**
+ * Returns the largest value registered for the given @a column
+ */
+double UI::Statistics::maximum(const int column) const
+{
+    if (column < 0 || column >= m_channels.count())
+        return 0;
+
+    return m_channels.at(column).max;
+}
+
+/**
+ * Returns the arithmetic mean of the values registered for the given
+ * @a column
+ */
+double UI::Statistics::mean(const int column) const
+{
+    if (column < 0 || column >= m_channels.count())
+        return 0;
+
+    return m_channels.at(column).mean;
+}
+
+/**
+ * Returns the sample standard deviation of the values registered for the
+ * given @a column
+ */
+double UI::Statistics::standardDeviation(const int column) const
+{
+    if (column < 0 || column >= m_channels.count())
+        return 0;
+
+    const auto &channel = m_channels.at(column);
+    if (channel.count < 2)
+        return 0;
+
+    return qSqrt(channel.m2 / (channel.count - 1));
+}
+
+/**
+ * Returns a JSON document with the current statistics of every dataset,
+ * sent by @c Plugins::Server as the answer to @c {"statistics"} queries
+ */
+QString UI::Statistics::statisticsJson() const
+{
+    QJsonArray channels;
+    for (int i = 0; i < m_channels.count(); ++i)
+    {
+        QJsonObject channel;
+        channel.insert("title", m_columnTitles.at(i));
+        channel.insert("samples", qint64(m_channels.at(i).count));
+        channel.insert("min", minimum(i));
+        channel.insert("max", maximum(i));
+        channel.insert("mean", mean(i));
+        channel.insert("stddev", standardDeviation(i));
+        channels.append(channel);
+    }
+
+    QJsonObject object;
+    object.insert("statistics", channels);
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * Registers the dataset values of the given @a frame. Each value updates the
+ * running moments of its channel with Welford's algorithm, which costs a
+ * handful of floating point operations & is numerically stable even over
+ * very long sessions.
+ *
+ * The channels are rebuilt (and the statistics reset) when the dataset
+ * layout of the frames changes, e.g. when another project file is loaded.
+ */
+void UI::Statistics::append(const JSON::Frame &frame)
+{
+    // Count the datasets of the frame & rebuild the channel list when the
+    // dataset layout differs from the one the channels were built for
+    int datasets = 0;
+    for (int g = 0; g < frame.groupCount(); ++g)
+        datasets += frame.getGroup(g).datasetCount();
+    if (datasets != m_channels.count())
+    {
+        m_columnTitles.clear();
+        m_columnTitles.reserve(datasets);
+        for (int g = 0; g < frame.groupCount(); ++g)
+        {
+            const auto &group = frame.getGroup(g);
+            for (int d = 0; d < group.datasetCount(); ++d)
+                m_columnTitles.append(group.title() + " / "
+                                      + group.getDataset(d).title());
+        }
+
+        m_channels.resize(datasets);
+        for (int i = 0; i < datasets; ++i)
+            m_channels[i].count = 0;
+
+        Q_EMIT statisticsReset();
+    }
+
+    // Update the running moments of every channel
+    int column = 0;
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.getGroup(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            const double value = group.getDataset(d).numericValue();
+            auto &channel = m_channels[column++];
+
+            // First sample of the channel initializes the extrema
+            if (channel.count == 0)
+            {
+                channel.min = value;
+                channel.max = value;
+                channel.mean = 0;
+                channel.m2 = 0;
+            }
+
+            else
+            {
+                channel.min = qMin(channel.min, value);
+                channel.max = qMax(channel.max, value);
+            }
+
+            // Welford update of mean & sum of squared differences
+            ++channel.count;
+            const double delta = value - channel.mean;
+            channel.mean += delta / channel.count;
+            channel.m2 += delta * (value - channel.mean);
+        }
+    }
+}
+
+/**
+ * Discards the statistics of every channel, called by the dashboard whenever
+ * its own data model is reset (e.g. on device disconnection)
+ */
+void UI::Statistics::clear()
+{
+    m_channels.clear();
+    m_columnTitles.clear();
+    Q_EMIT statisticsReset();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Statistics.cpp"
+#endif
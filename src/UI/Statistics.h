@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <DataTypes.h>
+#include <JSON/Frame.h>
+
+namespace UI
+{
+/**
+ * @brief The Statistics class
+ *
+ * Online statistics engine, maintains the sample count, minimum, maximum,
+ * mean & standard deviation of every dataset of the current project. The
+ * moments are updated incrementally with Welford's algorithm as frames
+ * arrive, so the memory cost is constant per dataset & no post-processing of
+ * the logged CSV files is needed to obtain the session statistics.
+ *
+ * The figures are displayed as tooltips of the dataset rows of the group
+ * widgets & can be queried by plugins through @c Plugins::Server with a
+ * @c {"statistics"} request.
+ */
+class Statistics : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void statisticsReset();
+
+private:
+    explicit Statistics();
+    Statistics(Statistics &&) = delete;
+    Statistics(const Statistics &) = delete;
+    Statistics &operator=(Statistics &&) = delete;
+    Statistics &operator=(const Statistics &) = delete;
+
+public:
+    static Statistics &instance();
+
+    int columnCount() const;
+    StringList columnTitles() const;
+    Q_INVOKABLE int columnIndex(const QString &groupTitle,
+                                const QString &datasetTitle) const;
+
+    Q_INVOKABLE quint64 samples(const int column) const;
+    Q_INVOKABLE double minimum(const int column) const;
+    Q_INVOKABLE double maximum(const int column) const;
+    Q_INVOKABLE double mean(const int column) const;
+    Q_INVOKABLE double standardDeviation(const int column) const;
+
+    QString statisticsJson() const;
+
+    void append(const JSON::Frame &frame);
+
+public Q_SLOTS:
+    void clear();
+
+private:
+    /**
+     * Running moments of one dataset, updated with Welford's algorithm
+     */
+    struct Channel
+    {
+        quint64 count;
+        double min;
+        double max;
+        double mean;
+        double m2;
+    };
+
+private:
+    StringList m_columnTitles;
+    QVector<Channel> m_channels;
+};
+}
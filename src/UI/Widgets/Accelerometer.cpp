@@ -67,8 +67,10 @@ Widgets::Accelerometer::Accelerometer(const int index)
     // Set widget pointer
     setWidget(&m_gauge);
 
-    // React to dashboard events
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
+    // React to dashboard events, accelerometers are updated on the last slice
+    // of the UI interval
+    connect(dash, SIGNAL(updatedSlice3()), this, SLOT(updateData()),
+            Qt::QueuedConnection);
 }
 
 /**
@@ -89,43 +91,18 @@ void Widgets::Accelerometer::updateData()
     if (m_index < 0 || m_index >= dash->accelerometerCount())
         return;
 
-    // Get accelerometer group & validate it
-    auto accelerometer = dash->getAccelerometer(m_index);
-    if (accelerometer.datasetCount() != 3)
-        return;
-
-    // Initialize x, y, z
-    double x = 0;
-    double y = 0;
-    double z = 0;
-
-    // Extract x, y, z from accelerometer group
-    for (int i = 0; i < 3; ++i)
-    {
-        auto dataset = accelerometer.getDataset(i);
-        if (dataset.widget() == "x")
-            x = dataset.value().toDouble();
-        if (dataset.widget() == "y")
-            y = dataset.value().toDouble();
-        if (dataset.widget() == "z")
-            z = dataset.value().toDouble();
-    }
-
-    // Divide accelerations by gravitational constant
-    x /= 9.18;
-    y /= 9.18;
-    z /= 9.18;
-
-    // Normalize acceleration vector
-    const double G = qSqrt(qPow(x, 2) + qPow(y, 2) + qPow(z, 2));
+    // Get the G-force magnitude computed once per frame by the dashboard,
+    // every widget fed by the group renders the same value
+    const double G = dash->accelerometerValues(m_index).g;
 
     // Update gauge
     m_gauge.setValue(G);
-    setValue(QString("%1 G").arg(
-        QString::number(G, 'f', UI::Dashboard::instance().precision())));
+    setValue(QString("%1 G").arg(dash->formattedValue(G)));
 
-    // Repaint the widget
-    requestRepaint();
+    // Repaint the widget, sub-pixel needle movements are skipped. The scale
+    // is fixed to [0, 12] G & the needle tip travels along a 270° arc.
+    const double arc = 0.75 * M_PI * qMin(m_gauge.width(), m_gauge.height());
+    requestRepaint(G, 0, 12, arc);
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
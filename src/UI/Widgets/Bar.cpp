@@ -73,9 +73,11 @@ Widgets::Bar::Bar(const int index)
     // Set widget pointer & disable auto resize
     setWidget(&m_thermo, Qt::AlignHCenter, false);
 
-    // React to dashboard events
+    // React to dashboard events, bar widgets are updated on the third slice
+    // of the UI interval
     connect(this, SIGNAL(resized()), this, SLOT(onResized()), Qt::QueuedConnection);
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
+    connect(dash, SIGNAL(updatedSlice2()), this, SLOT(updateData()),
+            Qt::QueuedConnection);
 }
 
 /**
@@ -98,14 +100,12 @@ void Widgets::Bar::updateData()
 
     // Update bar level
     auto dataset = dash->getBar(m_index);
-    auto value = dataset.value().toDouble();
+    auto value = dataset.numericValue();
     m_thermo.setValue(value);
-    setValue(QString("%1 %2").arg(
-        QString::number(value, 'f', UI::Dashboard::instance().precision()),
-        dataset.units()));
+    setValue(QString("%1 %2").arg(dash->formattedValue(value), dataset.units()));
 
-    // Repaint widget
-    requestRepaint();
+    // Repaint widget, sub-pixel changes of the fill level are skipped
+    requestRepaint(value, dataset.min(), dataset.max(), m_thermo.height());
 }
 
 /**
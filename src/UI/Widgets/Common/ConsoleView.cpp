@@ -0,0 +1,927 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QPainter>
+#include <QClipboard>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QApplication>
+#include <QFontMetrics>
+
+#include <UI/Widgets/Common/ConsoleView.h>
+
+/**
+ * Configures the grid view & its (initially hidden) vertical scrollbar
+ */
+Widgets::ConsoleView::ConsoleView(QWidget *parent)
+    : QFrame(parent)
+    , m_lineOpen(false)
+    , m_maxLines(0)
+    , m_firstLineSeq(0)
+    , m_firstRowSeq(0)
+    , m_columns(1)
+    , m_cellWidth(1)
+    , m_cellHeight(1)
+    , m_cellAscent(1)
+    , m_scrollRow(0)
+    , m_autoscroll(true)
+    , m_selecting(false)
+    , m_hasSelection(false)
+    , m_allDirty(true)
+    , m_canvasTopRow(0)
+    , m_scrollBar(Qt::Vertical, this)
+{
+    setFrameStyle(QFrame::NoFrame);
+    setMouseTracking(false);
+
+    m_scrollBar.hide();
+    connect(&m_scrollBar, &QScrollBar::valueChanged, this,
+            &Widgets::ConsoleView::onScrollBarMoved);
+
+    updateMetrics();
+}
+
+/**
+ * Returns @c true if the view does not contain any text
+ */
+bool Widgets::ConsoleView::empty() const
+{
+    return m_lines.isEmpty();
+}
+
+/**
+ * Returns the complete text retained by the view, logical lines are joined
+ * with line feeds.
+ */
+QString Widgets::ConsoleView::text() const
+{
+    QString result;
+    for (int i = 0; i < m_lines.count(); ++i)
+    {
+        if (i > 0)
+            result.append(QChar('\n'));
+
+        Q_FOREACH (const auto &chunk, m_lines.at(i).chunks)
+            result.append(chunk.text);
+    }
+
+    return result;
+}
+
+/**
+ * Returns the number of display rows of the grid (logical lines are wrapped
+ * at the column count of the grid, so a long line spans several rows).
+ */
+int Widgets::ConsoleView::rowCount() const
+{
+    return m_rows.count();
+}
+
+/**
+ * Returns the number of complete display rows that fit in the view
+ */
+int Widgets::ConsoleView::visibleRows() const
+{
+    return qMax(1, height() / m_cellHeight);
+}
+
+/**
+ * Returns @c true if the view shall automatically stay scrolled to the
+ * bottom of the stream when new text is appended.
+ */
+bool Widgets::ConsoleView::autoscroll() const
+{
+    return m_autoscroll;
+}
+
+/**
+ * Returns the maximum number of logical lines retained by the view, zero or
+ * negative values stand for an unlimited line count.
+ */
+int Widgets::ConsoleView::maximumLineCount() const
+{
+    return m_maxLines;
+}
+
+/**
+ * Returns the placeholder text displayed while the view is empty
+ */
+QString Widgets::ConsoleView::placeholderText() const
+{
+    return m_placeholderText;
+}
+
+/**
+ * Returns the banner text displayed on top of the grid (if any)
+ */
+QString Widgets::ConsoleView::bannerText() const
+{
+    return m_bannerText;
+}
+
+/**
+ * Returns the bounding rectangle of the view areas touched since the last
+ * paint, so that the QML layer only re-uploads the changed region to the
+ * scenegraph. An invalid rectangle is returned when the whole view must be
+ * re-rendered (e.g. after scrolling).
+ */
+QRect Widgets::ConsoleView::dirtyRect() const
+{
+    if (m_allDirty || m_canvasTopRow != m_scrollRow)
+        return QRect();
+
+    QRect rect;
+    Q_FOREACH (const quint64 row, m_dirtyRows)
+    {
+        if (row < m_scrollRow)
+            continue;
+
+        const quint64 offset = row - m_scrollRow;
+        if (offset * m_cellHeight >= quint64(height()))
+            continue;
+
+        rect = rect.united(
+            QRect(0, int(offset) * m_cellHeight, width(), m_cellHeight));
+    }
+
+    return rect;
+}
+
+/**
+ * Returns the vertical scrollbar of the view
+ */
+QScrollBar *Widgets::ConsoleView::scrollBar()
+{
+    return &m_scrollBar;
+}
+
+/**
+ * Copies the selected cells to the system clipboard
+ */
+void Widgets::ConsoleView::copy()
+{
+    if (!m_hasSelection)
+        return;
+
+    // Normalize the selection so that it runs top to bottom
+    auto begin = m_selectionAnchor;
+    auto end = m_selectionEnd;
+    if (end < begin)
+        qSwap(begin, end);
+
+    // Re-assemble the text row by row, a line feed is only inserted when the
+    // next row starts a new logical line (i.e. it is not a wrapped row)
+    QString result;
+    for (quint64 row = begin.first; row <= end.first; ++row)
+    {
+        if (row < m_firstRowSeq || row >= m_firstRowSeq + quint64(m_rows.count()))
+            continue;
+
+        if (row != begin.first && m_rows.at(int(row - m_firstRowSeq)).second == 0)
+            result.append(QChar('\n'));
+
+        auto text = rowText(row);
+        const int from = (row == begin.first) ? qMin(begin.second, text.length()) : 0;
+        const int to = (row == end.first) ? qMin(end.second, text.length())
+                                          : text.length();
+        result.append(text.mid(from, qMax(0, to - from)));
+    }
+
+    QApplication::clipboard()->setText(result);
+}
+
+/**
+ * Removes all the text retained by the view
+ */
+void Widgets::ConsoleView::clear()
+{
+    m_lines.clear();
+    m_rows.clear();
+    m_lineOpen = false;
+    m_firstLineSeq = 0;
+    m_firstRowSeq = 0;
+    m_scrollRow = 0;
+    m_canvasTopRow = 0;
+
+    clearSelection();
+    updateScrollBar();
+    markAllDirty();
+}
+
+/**
+ * Extends the selection over the whole grid
+ */
+void Widgets::ConsoleView::selectAll()
+{
+    if (m_rows.isEmpty())
+        return;
+
+    m_selectionAnchor = qMakePair(m_firstRowSeq, 0);
+    m_selectionEnd = qMakePair(m_firstRowSeq + quint64(m_rows.count() - 1), m_columns);
+    m_hasSelection = true;
+
+    markAllDirty();
+    Q_EMIT copyAvailable(true);
+}
+
+/**
+ * Removes the current selection (if any)
+ */
+void Widgets::ConsoleView::clearSelection()
+{
+    if (m_hasSelection)
+    {
+        m_hasSelection = false;
+        markAllDirty();
+        Q_EMIT copyAvailable(false);
+    }
+}
+
+/**
+ * Removes the contents of the last (unterminated) logical line, used by the
+ * VT-100 emulation to implement the "erase line" control function.
+ */
+void Widgets::ConsoleView::clearCurrentLine()
+{
+    if (m_lines.isEmpty())
+        return;
+
+    // Remove the wrapped rows of the line, only the first one remains
+    auto &line = m_lines.last();
+    const int rows = qMax(1, (line.length + m_columns - 1) / m_columns);
+    for (int i = 0; i < rows - 1; ++i)
+        m_rows.removeLast();
+
+    // Reset the line contents
+    line.chunks.clear();
+    line.length = 0;
+    m_lineOpen = true;
+
+    updateScrollBar();
+    markAllDirty();
+}
+
+/**
+ * Scrolls the view so that the last row of the grid is visible
+ */
+void Widgets::ConsoleView::scrollToBottom()
+{
+    m_scrollRow = m_firstRowSeq + quint64(qMax(0, rowCount() - visibleRows()));
+    updateScrollBar();
+}
+
+/**
+ * Appends the given styled @a spans to the grid. Line feeds contained in the
+ * spans terminate the current logical line, the rest of the text extends it.
+ */
+void Widgets::ConsoleView::append(const QVector<Widgets::FormattedText> &spans)
+{
+    Q_FOREACH (const auto &span, spans)
+    {
+        const auto parts = span.text.split(QChar('\n'));
+        for (int i = 0; i < parts.count(); ++i)
+        {
+            if (i > 0)
+                m_lineOpen = false;
+
+            if (!parts.at(i).isEmpty())
+                appendChunk(parts.at(i), span.format);
+        }
+    }
+
+    // Drop the oldest lines & update the scrolling range/position
+    evictLines();
+    if (m_autoscroll)
+        m_scrollRow = m_firstRowSeq + quint64(qMax(0, rowCount() - visibleRows()));
+    updateScrollBar();
+}
+
+/**
+ * Appends the given plain @a text to the grid with the default text color
+ */
+void Widgets::ConsoleView::append(const QString &text)
+{
+    append(QVector<FormattedText> { FormattedText(text) });
+}
+
+/**
+ * Enables/disables automatic scrolling to the bottom of the stream
+ */
+void Widgets::ConsoleView::setAutoscroll(const bool enabled)
+{
+    m_autoscroll = enabled;
+    if (enabled)
+        scrollToBottom();
+}
+
+/**
+ * Changes the maximum number of logical lines retained by the view, zero or
+ * negative values lift the limit.
+ */
+void Widgets::ConsoleView::setMaximumLineCount(const int maxLines)
+{
+    m_maxLines = maxLines;
+    evictLines();
+    updateScrollBar();
+}
+
+/**
+ * Changes the placeholder text displayed while the view is empty
+ */
+void Widgets::ConsoleView::setPlaceholderText(const QString &text)
+{
+    m_placeholderText = text;
+    if (empty())
+        markAllDirty();
+}
+
+/**
+ * Changes the banner displayed on top of the grid, an empty string hides
+ * the banner. Used by the terminal widget to announce that rendering is
+ * paused while the device floods the console.
+ */
+void Widgets::ConsoleView::setBannerText(const QString &text)
+{
+    if (m_bannerText != text)
+    {
+        m_bannerText = text;
+        markAllDirty();
+    }
+}
+
+/**
+ * Shows or hides the vertical scrollbar & re-wraps the text to the new
+ * grid width.
+ */
+void Widgets::ConsoleView::setScrollBarVisible(const bool visible)
+{
+    if (visible != m_scrollBar.isVisible())
+    {
+        m_scrollBar.setVisible(visible);
+        updateMetrics();
+        rebuildRowMap();
+    }
+}
+
+/**
+ * Re-renders the rows touched since the previous paint into the retained
+ * canvas & blits the canvas into the widget. When the view was only
+ * scrolled, the canvas contents are shifted in-place & just the newly
+ * exposed rows are rasterized.
+ */
+void Widgets::ConsoleView::paintEvent(QPaintEvent *event)
+{
+    // Re-allocate the canvas when the widget size changes
+    const qreal ratio = devicePixelRatioF();
+    if (m_canvas.size() != size() * ratio)
+    {
+        m_canvas = QPixmap(size() * ratio);
+        m_canvas.setDevicePixelRatio(ratio);
+        m_allDirty = true;
+    }
+
+    // Scroll the canvas in-place & rasterize only the exposed rows
+    const int renderableRows = height() / m_cellHeight + 1;
+    if (m_canvasTopRow != m_scrollRow && !m_allDirty)
+    {
+        const qint64 delta = qint64(m_scrollRow) - qint64(m_canvasTopRow);
+        if (qAbs(delta) < renderableRows)
+        {
+            m_canvas.scroll(0, int(-delta * m_cellHeight * ratio), m_canvas.rect());
+            if (delta > 0)
+            {
+                for (int i = renderableRows - int(delta); i <= renderableRows; ++i)
+                    m_dirtyRows.insert(m_scrollRow + quint64(qMax(0, i)));
+            }
+
+            else
+            {
+                for (int i = 0; i < int(-delta); ++i)
+                    m_dirtyRows.insert(m_scrollRow + quint64(i));
+            }
+        }
+
+        else
+            m_allDirty = true;
+    }
+
+    // The canvas now represents the current scroll position
+    m_canvasTopRow = m_scrollRow;
+
+    // Render the dirty rows into the canvas
+    if (m_allDirty || !m_dirtyRows.isEmpty())
+    {
+        QPainter painter(&m_canvas);
+        if (m_allDirty)
+        {
+            for (int i = 0; i <= renderableRows; ++i)
+                renderRow(painter, m_scrollRow + quint64(i));
+
+            // Display the placeholder text while the view is empty
+            if (m_rows.isEmpty() && !m_placeholderText.isEmpty())
+            {
+                painter.setFont(font());
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+                painter.setPen(palette().color(QPalette::PlaceholderText));
+#else
+                painter.setPen(palette().color(QPalette::Text));
+#endif
+                painter.drawText(QPointF(0, m_cellAscent), m_placeholderText);
+            }
+        }
+
+        else
+        {
+            Q_FOREACH (const quint64 row, m_dirtyRows)
+            {
+                if (row >= m_scrollRow
+                    && row <= m_scrollRow + quint64(renderableRows))
+                    renderRow(painter, row);
+            }
+        }
+
+        m_allDirty = false;
+        m_dirtyRows.clear();
+    }
+
+    // Blit the canvas into the widget
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_canvas);
+
+    // Draw the banner on top of the grid
+    if (!m_bannerText.isEmpty())
+    {
+        const QRect banner(0, 0, width(), m_cellHeight + 8);
+        painter.fillRect(banner, palette().color(QPalette::Highlight));
+        painter.setFont(font());
+        painter.setPen(palette().color(QPalette::HighlightedText));
+        painter.drawText(banner, Qt::AlignCenter, m_bannerText);
+    }
+
+    Q_UNUSED(event);
+}
+
+/**
+ * Re-positions the scrollbar, re-wraps the text to the new column count &
+ * invalidates the rendering canvas.
+ */
+void Widgets::ConsoleView::resizeEvent(QResizeEvent *event)
+{
+    QFrame::resizeEvent(event);
+
+    m_scrollBar.setGeometry(width() - m_scrollBar.width(), 0, m_scrollBar.width(),
+                            height());
+
+    const int columns = m_columns;
+    updateMetrics();
+    if (columns != m_columns)
+        rebuildRowMap();
+
+    if (m_autoscroll)
+        scrollToBottom();
+
+    updateScrollBar();
+    markAllDirty();
+}
+
+/**
+ * Invalidates the glyph cache & the grid layout when the font or the color
+ * palette of the view changes.
+ */
+void Widgets::ConsoleView::changeEvent(QEvent *event)
+{
+    switch (event->type())
+    {
+        case QEvent::FontChange:
+            m_glyphCache.clear();
+            updateMetrics();
+            rebuildRowMap();
+            markAllDirty();
+            break;
+        case QEvent::PaletteChange:
+        case QEvent::StyleChange:
+            m_glyphCache.clear();
+            markAllDirty();
+            break;
+        default:
+            break;
+    }
+
+    QFrame::changeEvent(event);
+}
+
+/**
+ * Forwards wheel events to the scrollbar so that the user can scroll through
+ * the retained lines.
+ */
+void Widgets::ConsoleView::wheelEvent(QWheelEvent *event)
+{
+    QApplication::sendEvent(&m_scrollBar, event);
+}
+
+/**
+ * Starts a new cell-based selection
+ */
+void Widgets::ConsoleView::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton)
+    {
+        m_selecting = true;
+        m_selectionAnchor = cellAt(event->pos());
+        m_selectionEnd = m_selectionAnchor;
+        clearSelection();
+    }
+}
+
+/**
+ * Extends the current selection to the cell under the mouse cursor
+ */
+void Widgets::ConsoleView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_selecting)
+    {
+        const auto cell = cellAt(event->pos());
+        if (cell != m_selectionEnd)
+        {
+            m_selectionEnd = cell;
+            const bool hadSelection = m_hasSelection;
+            m_hasSelection = (m_selectionEnd != m_selectionAnchor);
+            markAllDirty();
+
+            if (hadSelection != m_hasSelection)
+                Q_EMIT copyAvailable(m_hasSelection);
+        }
+    }
+}
+
+/**
+ * Terminates the current selection gesture
+ */
+void Widgets::ConsoleView::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton)
+        m_selecting = false;
+}
+
+/**
+ * Updates the scroll position when the user moves the scrollbar
+ */
+void Widgets::ConsoleView::onScrollBarMoved(const int value)
+{
+    const quint64 row = m_firstRowSeq + quint64(qMax(0, value));
+    if (row != m_scrollRow)
+    {
+        m_scrollRow = row;
+        update();
+    }
+}
+
+/**
+ * Drops the oldest logical lines (and their display rows) when the view
+ * retains more lines than the configured maximum.
+ */
+void Widgets::ConsoleView::evictLines()
+{
+    if (m_maxLines <= 0)
+        return;
+
+    bool evicted = false;
+    while (m_lines.count() > m_maxLines)
+    {
+        const quint64 seq = m_firstLineSeq;
+        m_lines.removeFirst();
+        ++m_firstLineSeq;
+
+        while (!m_rows.isEmpty() && m_rows.first().first == seq)
+        {
+            m_rows.removeFirst();
+            ++m_firstRowSeq;
+        }
+
+        evicted = true;
+    }
+
+    // Keep the scroll position & selection inside the retained window
+    if (evicted)
+    {
+        if (m_scrollRow < m_firstRowSeq)
+        {
+            m_scrollRow = m_firstRowSeq;
+            markAllDirty();
+        }
+
+        if (m_hasSelection
+            && (m_selectionAnchor.first < m_firstRowSeq
+                || m_selectionEnd.first < m_firstRowSeq))
+            clearSelection();
+    }
+}
+
+/**
+ * Re-calculates the cell geometry & the column count of the grid from the
+ * current font & widget width.
+ */
+void Widgets::ConsoleView::updateMetrics()
+{
+    const QFontMetrics metrics(font());
+    m_cellWidth = qMax(1, metrics.horizontalAdvance(QLatin1Char('M')));
+    m_cellHeight = qMax(1, metrics.lineSpacing());
+    m_cellAscent = metrics.ascent();
+
+    int contentWidth = width();
+    if (m_scrollBar.isVisible())
+        contentWidth -= m_scrollBar.width();
+
+    m_columns = qMax(1, contentWidth / m_cellWidth);
+}
+
+/**
+ * Re-wraps every logical line at the current column count. Called when the
+ * grid width or the font changes, appending text extends the row map
+ * incrementally instead.
+ */
+void Widgets::ConsoleView::rebuildRowMap()
+{
+    m_rows.clear();
+    m_firstRowSeq = 0;
+
+    for (int i = 0; i < m_lines.count(); ++i)
+    {
+        const quint64 seq = m_firstLineSeq + quint64(i);
+        const int rows = qMax(1, (m_lines.at(i).length + m_columns - 1) / m_columns);
+        for (int j = 0; j < rows; ++j)
+            m_rows.append(qMakePair(seq, j * m_columns));
+    }
+
+    // Row sequence numbers changed, any existing selection is meaningless
+    m_hasSelection = false;
+    m_selecting = false;
+
+    if (m_autoscroll)
+        scrollToBottom();
+    else
+        m_scrollRow = m_firstRowSeq
+            + quint64(qMax(0, qMin(int(m_scrollRow), rowCount() - visibleRows())));
+
+    updateScrollBar();
+    markAllDirty();
+}
+
+/**
+ * Appends a styled run of text (without line feeds) to the current logical
+ * line, opening a new line if the previous one was terminated. The row map
+ * is extended in-place & only the rows that received new characters are
+ * marked as dirty.
+ */
+void Widgets::ConsoleView::appendChunk(const QString &text,
+                                       const QTextCharFormat &format)
+{
+    // Open a new logical line (and its first display row)
+    if (!m_lineOpen || m_lines.isEmpty())
+    {
+        Line line;
+        line.length = 0;
+        m_lines.append(line);
+        m_lineOpen = true;
+
+        const quint64 seq = m_firstLineSeq + quint64(m_lines.count() - 1);
+        m_rows.append(qMakePair(seq, 0));
+    }
+
+    // Extract the colors from the rich text format once
+    Chunk chunk;
+    chunk.text = text;
+    chunk.bold = format.fontWeight() >= QFont::Bold;
+    chunk.hasForeground = format.hasProperty(QTextFormat::ForegroundBrush);
+    chunk.foreground = format.foreground().color().rgb();
+
+    // Append the run to the line, runs with the same style are merged so
+    // that the paint loop iterates over a handful of chunks per line
+    auto &line = m_lines.last();
+    const int oldRows = qMax(1, (line.length + m_columns - 1) / m_columns);
+    if (!line.chunks.isEmpty() && line.chunks.last().bold == chunk.bold
+        && line.chunks.last().foreground == chunk.foreground
+        && line.chunks.last().hasForeground == chunk.hasForeground)
+        line.chunks.last().text.append(text);
+    else
+        line.chunks.append(chunk);
+    line.length += text.length();
+
+    // The last row of the line received new characters
+    markRowDirty(m_firstRowSeq + quint64(m_rows.count() - 1));
+
+    // Register the display rows added by the new characters
+    const quint64 seq = m_firstLineSeq + quint64(m_lines.count() - 1);
+    const int newRows = qMax(1, (line.length + m_columns - 1) / m_columns);
+    for (int i = oldRows; i < newRows; ++i)
+    {
+        m_rows.append(qMakePair(seq, i * m_columns));
+        markRowDirty(m_firstRowSeq + quint64(m_rows.count() - 1));
+    }
+}
+
+/**
+ * Registers the given display row for re-rendering on the next paint
+ */
+void Widgets::ConsoleView::markRowDirty(const quint64 row)
+{
+    if (!m_allDirty)
+        m_dirtyRows.insert(row);
+}
+
+/**
+ * Registers the whole view for re-rendering on the next paint
+ */
+void Widgets::ConsoleView::markAllDirty()
+{
+    m_allDirty = true;
+    m_dirtyRows.clear();
+}
+
+/**
+ * Renders the given display @a row into the canvas: background fill,
+ * selection highlight & one cached glyph pixmap per non-blank cell.
+ */
+void Widgets::ConsoleView::renderRow(QPainter &painter, const quint64 row)
+{
+    // Fill the row background
+    const int y = int(qint64(row) - qint64(m_scrollRow)) * m_cellHeight;
+    painter.fillRect(0, y, width(), m_cellHeight, palette().color(QPalette::Base));
+
+    // Rows below the last line of the grid are just background
+    if (row < m_firstRowSeq || row >= m_firstRowSeq + quint64(m_rows.count()))
+        return;
+
+    // Obtain the line & starting character offset of the row
+    const auto &entry = m_rows.at(int(row - m_firstRowSeq));
+    const auto &line = m_lines.at(int(entry.first - m_firstLineSeq));
+
+    // Obtain the selected cell range of the row (if any)
+    int selectionFrom = 0;
+    int selectionTo = 0;
+    const bool selected = selectionForRow(row, selectionFrom, selectionTo);
+
+    // Draw the selection highlight behind the glyphs
+    if (selected)
+        painter.fillRect(selectionFrom * m_cellWidth, y,
+                         (selectionTo - selectionFrom) * m_cellWidth, m_cellHeight,
+                         palette().color(QPalette::Highlight));
+
+    // Blit one cached glyph per visible cell
+    int column = 0;
+    int skip = entry.second;
+    const QRgb defaultColor = palette().color(QPalette::Text).rgb();
+    const QRgb selectionColor = palette().color(QPalette::HighlightedText).rgb();
+    Q_FOREACH (const auto &chunk, line.chunks)
+    {
+        const int length = chunk.text.length();
+        if (skip >= length)
+        {
+            skip -= length;
+            continue;
+        }
+
+        for (int i = skip; i < length && column < m_columns; ++i, ++column)
+        {
+            const auto character = chunk.text.at(i);
+            if (character.isSpace())
+                continue;
+
+            QRgb color = chunk.hasForeground ? chunk.foreground : defaultColor;
+            if (selected && column >= selectionFrom && column < selectionTo)
+                color = selectionColor;
+
+            painter.drawPixmap(column * m_cellWidth, y,
+                               glyph(character, color, chunk.bold));
+        }
+
+        skip = 0;
+        if (column >= m_columns)
+            break;
+    }
+}
+
+/**
+ * Synchronizes the scrollbar range & position with the row count & scroll
+ * position of the view.
+ */
+void Widgets::ConsoleView::updateScrollBar()
+{
+    const int maximum = qMax(0, rowCount() - visibleRows());
+
+    m_scrollBar.blockSignals(true);
+    m_scrollBar.setRange(0, maximum);
+    m_scrollBar.setPageStep(visibleRows());
+    m_scrollBar.setValue(int(qMin(quint64(maximum), m_scrollRow - m_firstRowSeq)));
+    m_scrollBar.blockSignals(false);
+}
+
+/**
+ * Returns the text displayed by the given display @a row
+ */
+QString Widgets::ConsoleView::rowText(const quint64 row) const
+{
+    if (row < m_firstRowSeq || row >= m_firstRowSeq + quint64(m_rows.count()))
+        return QString();
+
+    const auto &entry = m_rows.at(int(row - m_firstRowSeq));
+    const auto &line = m_lines.at(int(entry.first - m_firstLineSeq));
+
+    QString text;
+    Q_FOREACH (const auto &chunk, line.chunks)
+        text.append(chunk.text);
+
+    return text.mid(entry.second, m_columns);
+}
+
+/**
+ * Obtains the selected cell range of the given display @a row, returns
+ * @c false if the row does not intersect the selection.
+ */
+bool Widgets::ConsoleView::selectionForRow(const quint64 row, int &from,
+                                           int &to) const
+{
+    if (!m_hasSelection)
+        return false;
+
+    auto begin = m_selectionAnchor;
+    auto end = m_selectionEnd;
+    if (end < begin)
+        qSwap(begin, end);
+
+    if (row < begin.first || row > end.first)
+        return false;
+
+    from = (row == begin.first) ? begin.second : 0;
+    to = (row == end.first) ? end.second : m_columns;
+    return to > from;
+}
+
+/**
+ * Maps the given widget position to absolute (row, column) grid coordinates
+ */
+QPair<quint64, int> Widgets::ConsoleView::cellAt(const QPoint &pos) const
+{
+    const int row = qBound(0, pos.y() / m_cellHeight, qMax(0, rowCount() - 1));
+    const int column = qBound(0, (pos.x() + m_cellWidth / 2) / m_cellWidth,
+                              m_columns);
+    return qMakePair(m_scrollRow + quint64(row), column);
+}
+
+/**
+ * Returns the cached pixmap of the given @a character rendered with the
+ * given @a color & font weight, rasterizing it on the first request. The
+ * cache is keyed on (character, color, weight) & flushed whenever the font
+ * or the palette of the view changes.
+ */
+const QPixmap &Widgets::ConsoleView::glyph(const QChar &character, const QRgb color,
+                                           const bool bold)
+{
+    const quint64 key = (quint64(color & 0xffffffu) << 17)
+        | (quint64(character.unicode()) << 1) | quint64(bold ? 1 : 0);
+
+    auto it = m_glyphCache.find(key);
+    if (it == m_glyphCache.end())
+    {
+        const qreal ratio = devicePixelRatioF();
+        QPixmap pixmap(QSize(m_cellWidth, m_cellHeight) * ratio);
+        pixmap.setDevicePixelRatio(ratio);
+        pixmap.fill(Qt::transparent);
+
+        QFont glyphFont = font();
+        glyphFont.setBold(bold);
+
+        QPainter painter(&pixmap);
+        painter.setFont(glyphFont);
+        painter.setPen(QColor::fromRgb(color));
+        painter.drawText(QPointF(0, m_cellAscent), QString(character));
+
+        it = m_glyphCache.insert(key, pixmap);
+    }
+
+    return it.value();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_ConsoleView.cpp"
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QSet>
+#include <QHash>
+#include <QFrame>
+#include <QPixmap>
+#include <QScrollBar>
+#include <QTextCharFormat>
+
+namespace Widgets
+{
+/**
+ * @brief The FormattedText class
+ *
+ * A run of console text that shall be rendered with the same character
+ * format, produced by the VT-100 escape code handler of the terminal widget.
+ */
+class FormattedText
+{
+public:
+    FormattedText() = default;
+    FormattedText(const FormattedText &other) = default;
+    FormattedText(const QString &txt, const QTextCharFormat &fmt = QTextCharFormat())
+        : text(txt)
+        , format(fmt)
+    {
+    }
+
+    QString text;
+    QTextCharFormat format;
+};
+
+/**
+ * @brief The ConsoleView class
+ *
+ * Monospace console renderer with a fixed character cell grid, used by the
+ * @c Widgets::Terminal widget in place of a @c QPlainTextEdit.
+ *
+ * The view keeps a sliding window of styled lines, wraps them at the column
+ * count of the grid & rasterizes each glyph at most once per color/weight
+ * combination into a pixmap cache. Rendering happens into a retained canvas
+ * pixmap, only the rows touched since the previous paint are re-drawn &
+ * appending while the view is pinned to the bottom scrolls the canvas instead
+ * of re-rendering it. This keeps the repaint cost proportional to the amount
+ * of new data instead of the amount of visible text, which is what makes the
+ * console usable at full serial line rates.
+ *
+ * The view is strictly an output device: it supports scrolling, cell-based
+ * text selection & clipboard copies, but no editing.
+ */
+class ConsoleView : public QFrame
+{
+    Q_OBJECT
+
+Q_SIGNALS:
+    void copyAvailable(bool available);
+
+public:
+    ConsoleView(QWidget *parent = Q_NULLPTR);
+
+    bool empty() const;
+    QString text() const;
+    int rowCount() const;
+    int visibleRows() const;
+    bool autoscroll() const;
+    int maximumLineCount() const;
+    QString placeholderText() const;
+    QString bannerText() const;
+    QRect dirtyRect() const;
+
+    QScrollBar *scrollBar();
+
+public Q_SLOTS:
+    void copy();
+    void clear();
+    void selectAll();
+    void clearSelection();
+    void clearCurrentLine();
+    void scrollToBottom();
+    void append(const QVector<Widgets::FormattedText> &spans);
+    void append(const QString &text);
+    void setAutoscroll(const bool enabled);
+    void setMaximumLineCount(const int maxLines);
+    void setPlaceholderText(const QString &text);
+    void setBannerText(const QString &text);
+    void setScrollBarVisible(const bool visible);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void changeEvent(QEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+private Q_SLOTS:
+    void onScrollBarMoved(const int value);
+
+private:
+    /**
+     * A run of characters of a logical line sharing the same foreground
+     * color & font weight, the colors are extracted from the rich text
+     * format once at append time so that the paint loop only deals with
+     * plain integers.
+     */
+    struct Chunk
+    {
+        QString text;
+        QRgb foreground;
+        bool hasForeground;
+        bool bold;
+    };
+
+    /**
+     * A logical console line (everything between two line feeds), the
+     * display rows of the grid are derived from the logical lines by
+     * wrapping them at the column count.
+     */
+    struct Line
+    {
+        QVector<Chunk> chunks;
+        int length;
+    };
+
+    void evictLines();
+    void updateMetrics();
+    void rebuildRowMap();
+    void appendChunk(const QString &text, const QTextCharFormat &format);
+
+    void markRowDirty(const quint64 row);
+    void markAllDirty();
+    void renderRow(QPainter &painter, const quint64 row);
+    void updateScrollBar();
+    QString rowText(const quint64 row) const;
+    bool selectionForRow(const quint64 row, int &from, int &to) const;
+    QPair<quint64, int> cellAt(const QPoint &pos) const;
+    const QPixmap &glyph(const QChar &character, const QRgb color, const bool bold);
+
+private:
+    QList<Line> m_lines;
+    bool m_lineOpen;
+    int m_maxLines;
+    quint64 m_firstLineSeq;
+
+    // Display row map, each entry is the character offset at which the row
+    // starts inside its logical line, rows are stored oldest-first & the
+    // sequence number of the first entry increases as old lines are evicted
+    QList<QPair<quint64, int>> m_rows;
+    quint64 m_firstRowSeq;
+
+    int m_columns;
+    int m_cellWidth;
+    int m_cellHeight;
+    int m_cellAscent;
+
+    quint64 m_scrollRow;
+    bool m_autoscroll;
+
+    // Selection anchor & moving end in absolute (row, column) coordinates,
+    // the selection survives line eviction by going stale instead of moving
+    bool m_selecting;
+    bool m_hasSelection;
+    QPair<quint64, int> m_selectionAnchor;
+    QPair<quint64, int> m_selectionEnd;
+
+    // Retained rendering canvas & row-level dirty tracking, the canvas holds
+    // the rendering of the rows starting at m_canvasTopRow & is scrolled
+    // in-place when the view is pinned to the bottom of the stream
+    QPixmap m_canvas;
+    bool m_allDirty;
+    QSet<quint64> m_dirtyRows;
+    quint64 m_canvasTopRow;
+
+    QScrollBar m_scrollBar;
+    QString m_bannerText;
+    QString m_placeholderText;
+    QHash<quint64, QPixmap> m_glyphCache;
+};
+}
@@ -56,6 +56,10 @@ void Widgets::ElidedLabel::resizeEvent(QResizeEvent *event)
 
 void Widgets::ElidedLabel::setText(const QString &text)
 {
+    // Do not re-elide & re-layout the label when the text did not change
+    if (m_originalText == text)
+        return;
+
     m_originalText = text;
     QLabel::setText(text);
     elide();
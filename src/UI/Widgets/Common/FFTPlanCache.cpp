@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QtMath>
+
+#include <Misc/MemoryRegistry.h>
+#include <UI/Widgets/Common/FFTPlanCache.h>
+
+/*
+ * Largest FFT window size with a fixed-size calculator in the vendored
+ * transform library, larger windows would silently fall back to the (much
+ * slower) variable-size path & are not offered to the widgets.
+ */
+static const int kMaxFftSize = 1 << 14;
+
+/**
+ * Returns a pointer to the only instance of this class
+ */
+Widgets::FFTPlanCache &Widgets::FFTPlanCache::instance()
+{
+    static FFTPlanCache singleton;
+    return singleton;
+}
+
+/**
+ * Constructor function
+ */
+Widgets::FFTPlanCache::FFTPlanCache() {}
+
+/**
+ * Destructor function, deletes the pooled transformer plans
+ */
+Widgets::FFTPlanCache::~FFTPlanCache()
+{
+    for (auto it = m_plans.begin(); it != m_plans.end(); ++it)
+        qDeleteAll(it.value());
+}
+
+/**
+ * Returns the largest FFT window size supported by the fixed-size transform
+ * path that is not larger than the @a requested dataset size. The result is
+ * computed arithmetically, probing candidate sizes through a transformer (as
+ * the widgets used to do) derives a full set of transform tables per probe.
+ */
+int Widgets::FFTPlanCache::validSize(const int requested) const
+{
+    // Clamp the size into the fixed-calculator range & clear the lower bits
+    // until only the highest power of two remains
+    int size = qBound(8, requested, kMaxFftSize);
+    while (size & (size - 1))
+        size &= size - 1;
+
+    return size;
+}
+
+/**
+ * Returns the Hann window table for the given segment @a size. The table is
+ * generated on first use & cached for the lifetime of the process, the
+ * returned vector shares the cached storage (implicit sharing) & must not be
+ * modified by the caller.
+ */
+QVector<float> Widgets::FFTPlanCache::hannWindow(const int size)
+{
+    QMutexLocker locker(&m_lock);
+    auto it = m_windows.find(size);
+    if (it == m_windows.end())
+    {
+        QVector<float> window(size);
+        for (int i = 0; i < size; ++i)
+            window[i] = static_cast<float>(
+                0.5 * (1 - qCos((2 * M_PI * i) / (size - 1))));
+
+        it = m_windows.insert(size, window);
+        reportMemoryUsage();
+    }
+
+    return it.value();
+}
+
+/**
+ * Returns a transformer plan for the given FFT @a size, reusing an idle plan
+ * from the pool when one is available. The scratch buffers of a plan are
+ * interleaved with its tables inside the vendored calculator, so the returned
+ * plan is owned exclusively by the caller until it is handed back through
+ * @c releasePlan().
+ */
+QFourierTransformer *Widgets::FFTPlanCache::acquirePlan(const int size)
+{
+    // Reuse an idle plan of the requested size when one is available
+    {
+        QMutexLocker locker(&m_lock);
+        auto &pool = m_plans[size];
+        if (!pool.isEmpty())
+            return pool.takeLast();
+    }
+
+    // Derive the tables for a new plan outside the lock, so widgets of other
+    // sizes are not serialized behind the table generation
+    return new QFourierTransformer(size);
+}
+
+/**
+ * Returns the given @a plan (obtained with @c acquirePlan()) to the idle pool,
+ * the next widget of the same @a size reuses it without re-deriving tables.
+ */
+void Widgets::FFTPlanCache::releasePlan(const int size, QFourierTransformer *plan)
+{
+    if (!plan)
+        return;
+
+    QMutexLocker locker(&m_lock);
+    m_plans[size].append(plan);
+    reportMemoryUsage();
+}
+
+/**
+ * Reports the memory held by the cached window tables & the idle plans to the
+ * memory registry. The per-plan figure is an estimate covering the scratch,
+ * bit-reversal & twiddle tables of the vendored fixed-size calculator. Called
+ * with the cache lock held.
+ */
+void Widgets::FFTPlanCache::reportMemoryUsage()
+{
+    qint64 bytes = 0;
+    for (auto it = m_windows.constBegin(); it != m_windows.constEnd(); ++it)
+        bytes += qint64(it.value().size()) * sizeof(float);
+    for (auto it = m_plans.constBegin(); it != m_plans.constEnd(); ++it)
+        bytes += qint64(it.value().count()) * it.key()
+            * (2 * sizeof(float) + sizeof(long));
+
+    Misc::MemoryRegistry::instance().report("Widgets::FFT (plan cache)", bytes);
+}
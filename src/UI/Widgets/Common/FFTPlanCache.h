@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QMap>
+#include <QList>
+#include <QMutex>
+#include <QVector>
+
+#include <qfouriertransformer.h>
+
+namespace Widgets
+{
+/**
+ * @brief The FFTPlanCache class
+ *
+ * Process-wide cache of the per-size FFT resources shared by the FFT plot &
+ * spectrogram widgets. Constructing a fixed-size transformer derives its
+ * twiddle & bit-reversal tables, and every widget used to derive a private
+ * copy (plus a throwaway copy per size probed during window-size validation)
+ * on every project rebuild.
+ *
+ * The cache keeps:
+ *
+ * - The Hann window table of every segment size. The tables are immutable
+ *   once generated & handed out as implicitly shared vectors, so all FFT
+ *   workers read the same storage.
+ * - A pool of idle transformer plans keyed by transform size. The scratch
+ *   state of a plan is interleaved with its tables inside the vendored
+ *   calculator, so a plan is owned by exactly one worker while in use;
+ *   released plans are handed to the next widget of the same size, which
+ *   makes widget construction on a project reload instant instead of
+ *   re-deriving the tables.
+ *
+ * Window-size validation is performed arithmetically through @c validSize(),
+ * so probing a candidate size no longer constructs transform tables.
+ */
+class FFTPlanCache
+{
+public:
+    static FFTPlanCache &instance();
+
+    int validSize(const int requested) const;
+    QVector<float> hannWindow(const int size);
+
+    QFourierTransformer *acquirePlan(const int size);
+    void releasePlan(const int size, QFourierTransformer *plan);
+
+private:
+    explicit FFTPlanCache();
+    FFTPlanCache(FFTPlanCache &&) = delete;
+    FFTPlanCache(const FFTPlanCache &) = delete;
+    FFTPlanCache &operator=(FFTPlanCache &&) = delete;
+    FFTPlanCache &operator=(const FFTPlanCache &) = delete;
+
+    ~FFTPlanCache();
+
+private:
+    void reportMemoryUsage();
+
+private:
+    QMutex m_lock;
+    QMap<int, QVector<float>> m_windows;
+    QMap<int, QList<QFourierTransformer *>> m_plans;
+};
+}
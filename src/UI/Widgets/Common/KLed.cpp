@@ -81,8 +81,10 @@ void KLed::setState(State state)
         return;
     }
 
+    // The pixmap cache holds one rendering per state, so a state change only
+    // needs a repaint with the already cached pixmap of the other state
     d->state = (state == Off ? Off : On);
-    updateCachedPixmap();
+    update();
     updateAccessibleName();
 }
 
@@ -138,7 +140,7 @@ void KLed::setLook(Look look)
 void KLed::toggle()
 {
     d->state = (d->state == On ? Off : On);
-    updateCachedPixmap();
+    update();
     updateAccessibleName();
 }
 
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UI/Widgets/Common/PlotSeriesData.h>
+
+/**
+ * Constructor function, stores references to the x/y vectors of the widget
+ */
+Widgets::PlotSeriesData::PlotSeriesData(const PlotData &xData, const PlotData &yData)
+    : m_xData(xData)
+    , m_yData(yData)
+{
+}
+
+/**
+ * Returns the number of points of the series
+ */
+int Widgets::PlotSeriesData::size() const
+{
+    return qMin(m_xData.count(), m_yData.count());
+}
+
+/**
+ * Returns the point at the given @a index of the series
+ */
+QPointF Widgets::PlotSeriesData::sample(int index) const
+{
+    return QPointF(m_xData.at(index), m_yData.at(index));
+}
+
+/**
+ * Returns the bounding rectangle of the series, which is re-calculated after
+ * every call to @c invalidate() & cached until the next one.
+ */
+QRectF Widgets::PlotSeriesData::boundingRect() const
+{
+    if (cachedBoundingRect.width() < 0)
+        cachedBoundingRect = qwtBoundingRect(*this);
+
+    return cachedBoundingRect;
+}
+
+/**
+ * Resets the cached bounding rectangle of the series, shall be called by the
+ * widget that owns the x/y vectors every time their contents are modified.
+ */
+void Widgets::PlotSeriesData::invalidate()
+{
+    cachedBoundingRect = QRectF(0.0, 0.0, -1.0, -1.0);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QwtSeriesData>
+
+#include <DataTypes.h>
+
+namespace Widgets
+{
+/**
+ * @brief The PlotSeriesData class
+ *
+ * Zero-copy bridge between the sample vectors maintained by the plot widgets
+ * and the Qwt curves. The class implements @c QwtSeriesData by referencing
+ * the x/y vectors of the widget directly, so updating a curve does not
+ * require copying both arrays into Qwt through @c setSamples() anymore.
+ *
+ * The referenced vectors must outlive the curve that owns this object. After
+ * modifying the vectors, the widget shall call @c invalidate() so that the
+ * cached bounding rectangle of the series is re-calculated on the next
+ * replot.
+ */
+class PlotSeriesData : public QwtSeriesData<QPointF>
+{
+public:
+    PlotSeriesData(const PlotData &xData, const PlotData &yData);
+
+    virtual int size() const QWT_OVERRIDE;
+    virtual QPointF sample(int index) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    void invalidate();
+
+private:
+    const PlotData &m_xData;
+    const PlotData &m_yData;
+};
+}
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <QtMath>
 #include <QResizeEvent>
 #include <QwtCompassScaleDraw>
 #include <QwtCompassMagnetNeedle>
@@ -66,8 +67,10 @@ Widgets::Compass::Compass(const int index)
     // Set widget pointer
     setWidget(&m_compass);
 
-    // React to dashboard events
-    connect(dash, SIGNAL(updated()), this, SLOT(update()), Qt::QueuedConnection);
+    // React to dashboard events, compasses are updated on the last slice of
+    // the UI interval
+    connect(dash, SIGNAL(updatedSlice3()), this, SLOT(update()),
+            Qt::QueuedConnection);
 }
 
 /**
@@ -88,11 +91,10 @@ void Widgets::Compass::update()
     if (m_index < 0 || m_index >= dash->compassCount())
         return;
 
-    // Get dataset value & set text format
-    auto dataset = dash->getCompass(m_index);
-    auto value = dataset.value().toDouble();
-    auto text = QString("%1°").arg(
-        QString::number(value, 'f', UI::Dashboard::instance().precision()));
+    // Get the heading computed once per frame by the dashboard, the value is
+    // normalized to the [0, 360) range
+    auto value = dash->compassHeading(m_index);
+    auto text = QString("%1°").arg(dash->formattedValue(value));
 
     // Ensure that angle always has 3 characters
     if (text.length() == 2)
@@ -104,8 +106,10 @@ void Widgets::Compass::update()
     setValue(text);
     m_compass.setValue(value);
 
-    // Repaint the widget
-    requestRepaint();
+    // Repaint the widget, sub-pixel needle movements are skipped. Over the
+    // full 360° range the needle tip travels along the compass circumference.
+    const double arc = M_PI * qMin(m_compass.width(), m_compass.height());
+    requestRepaint(value, 0, 360, arc);
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
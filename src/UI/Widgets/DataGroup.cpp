@@ -24,6 +24,7 @@
 #include <QRegularExpression>
 
 #include <UI/Dashboard.h>
+#include <UI/Statistics.h>
 #include <Misc/ThemeManager.h>
 #include <UI/Widgets/DataGroup.h>
 
@@ -40,21 +41,86 @@
     }
 
 /**
- * Generates the user interface elements & layout
+ * Generates the user interface elements & layout. The group-specific dataset rows are
+ * generated by @c rebind() so that the widget pool can recycle this instance for
+ * another group.
  */
 Widgets::DataGroup::DataGroup(const int index)
-    : m_index(index)
+    : m_index(-1)
+    , m_precision(-1)
 {
     // Get pointers to serial studio modules
     auto dash = &UI::Dashboard::instance();
     auto theme = &Misc::ThemeManager::instance();
 
-    // Invalid index, abort initialization
+    // Set window palette
+    QPalette windowPalette;
+    windowPalette.setColor(QPalette::Base, theme->widgetWindowBackground());
+    windowPalette.setColor(QPalette::Window, theme->widgetWindowBackground());
+    setPalette(windowPalette);
+
+    // Configure scroll area container & (initially empty) grid layout
+    m_dataContainer = new QWidget(this);
+    m_gridLayout = new QGridLayout(m_dataContainer);
+    m_gridLayout->setColumnStretch(0, 2);
+    m_gridLayout->setColumnStretch(1, 1);
+    m_gridLayout->setColumnStretch(2, 2);
+    m_gridLayout->setColumnStretch(3, 0);
+    m_dataContainer->setLayout(m_gridLayout);
+
+    // Configure scroll area
+    m_scrollArea = new QScrollArea(this);
+    m_scrollArea->setWidgetResizable(true);
+    m_scrollArea->setWidget(m_dataContainer);
+    m_scrollArea->setFrameShape(QFrame::NoFrame);
+    m_scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    m_scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+
+    // Configure main layout
+    m_mainLayout = new QVBoxLayout(this);
+    m_mainLayout->addWidget(m_scrollArea);
+    m_mainLayout->setContentsMargins(0, 0, 0, 0);
+    setLayout(m_mainLayout);
+
+    // React to dashboard events, group widgets are updated on the third slice
+    // of the UI interval
+    connect(dash, SIGNAL(updatedSlice2()), this, SLOT(updateData()),
+            Qt::QueuedConnection);
+
+    // Generate the dataset rows for the given group
+    rebind(index);
+}
+
+/**
+ * Group widgets can be recycled by the widget pool, the dataset rows are re-generated
+ * (or re-used) by @c rebind().
+ */
+bool Widgets::DataGroup::supportsRebind() const
+{
+    return true;
+}
+
+/**
+ * Re-binds the widget to the group with the given relative @a index. Existing dataset
+ * rows are re-used & re-titled when possible, label rows are only created or destroyed
+ * when the dataset count of the new group differs from the previous one. Called from
+ * the constructor and every time the widget pool recycles this instance for another
+ * dashboard build.
+ */
+void Widgets::DataGroup::rebind(const int index)
+{
+    // Register new index & force a full re-render on the next update
+    m_index = index;
+    m_precision = -1;
+
+    // Invalid index, abort configuration
+    auto dash = &UI::Dashboard::instance();
     if (m_index < 0 || m_index >= dash->groupCount())
         return;
 
-    // Get group reference
+    // Get group reference & theme
     auto group = dash->getGroups(m_index);
+    auto theme = &Misc::ThemeManager::instance();
 
     // Generate widget stylesheets
     auto titleQSS = QSS("color:%1", theme->widgetTextPrimary());
@@ -62,28 +128,28 @@ Widgets::DataGroup::DataGroup(const int index)
     auto valueQSS = QSS("color:%1", theme->widgetForegroundPrimary());
     auto iconsQSS = QSS("color:%1; font-weight:600;", theme->widgetTextSecondary());
 
-    // Set window palette
-    QPalette windowPalette;
-    windowPalette.setColor(QPalette::Base, theme->widgetWindowBackground());
-    windowPalette.setColor(QPalette::Window, theme->widgetWindowBackground());
-    setPalette(windowPalette);
-
-    // Configure scroll area container
-    m_dataContainer = new QWidget(this);
-
     // Make the value label larger
     auto valueFont = dash->monoFont();
     valueFont.setPixelSize(dash->monoFont().pixelSize() * 1.3);
 
-    // Configure grid layout
+    // Destroy the surplus rows of the previous group
+    while (m_titles.count() > group.datasetCount())
+    {
+        delete m_icons.takeLast();
+        delete m_units.takeLast();
+        delete m_titles.takeLast();
+        delete m_values.takeLast();
+    }
+
+    // Create the missing rows
     m_units.reserve(group.datasetCount());
     m_icons.reserve(group.datasetCount());
     m_titles.reserve(group.datasetCount());
     m_values.reserve(group.datasetCount());
-    m_gridLayout = new QGridLayout(m_dataContainer);
-    for (int dataset = 0; dataset < group.datasetCount(); ++dataset)
+    while (m_titles.count() < group.datasetCount())
     {
         // Create labels
+        const int dataset = m_titles.count();
         m_units.append(new QLabel(m_dataContainer));
         m_icons.append(new QLabel(m_dataContainer));
         m_titles.append(new ElidedLabel(m_dataContainer));
@@ -114,12 +180,6 @@ Widgets::DataGroup::DataGroup(const int index)
         units->setStyleSheet(unitsQSS);
         dicon->setStyleSheet(iconsQSS);
 
-        // Set label initial data
-        auto set = group.getDataset(dataset);
-        title->setText(set.title());
-        if (!set.units().isEmpty())
-            units->setText(QString("[%1]").arg(set.units()));
-
         // Set icon text
         dicon->setText("⤑");
 
@@ -128,31 +188,27 @@ Widgets::DataGroup::DataGroup(const int index)
         m_gridLayout->addWidget(dicon, dataset, 1);
         m_gridLayout->addWidget(value, dataset, 2);
         m_gridLayout->addWidget(units, dataset, 3);
-    }
 
-    // Load layout into container widget
-    m_gridLayout->setColumnStretch(0, 2);
-    m_gridLayout->setColumnStretch(1, 1);
-    m_gridLayout->setColumnStretch(2, 2);
-    m_gridLayout->setColumnStretch(3, 0);
-    m_dataContainer->setLayout(m_gridLayout);
-
-    // Configure scroll area
-    m_scrollArea = new QScrollArea(this);
-    m_scrollArea->setWidgetResizable(true);
-    m_scrollArea->setWidget(m_dataContainer);
-    m_scrollArea->setFrameShape(QFrame::NoFrame);
-    m_scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    m_scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        // Show the labels, rows created after the widget is visible would
+        // stay hidden otherwise
+        dicon->show();
+        units->show();
+        title->show();
+        value->show();
+    }
 
-    // Configure main layout
-    m_mainLayout = new QVBoxLayout(this);
-    m_mainLayout->addWidget(m_scrollArea);
-    m_mainLayout->setContentsMargins(0, 0, 0, 0);
-    setLayout(m_mainLayout);
+    // Update the texts of every row
+    for (int dataset = 0; dataset < group.datasetCount(); ++dataset)
+    {
+        auto set = group.getDataset(dataset);
+        m_titles.at(dataset)->setText(set.title());
+        m_values.at(dataset)->setText("");
 
-    // React to dashboard events
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
+        if (!set.units().isEmpty())
+            m_units.at(dataset)->setText(QString("[%1]").arg(set.units()));
+        else
+            m_units.at(dataset)->setText("");
+    }
 }
 
 /**
@@ -198,27 +254,72 @@ void Widgets::DataGroup::updateData()
     // Get group reference
     auto group = dash->getGroups(m_index);
 
-    // Regular expresion handler
-    const QRegularExpression regex("^[+-]?(\\d*\\.)?\\d+$");
+    // Re-render every label (even if its value did not change) when the user
+    // modifies the decimal precision of the dashboard
+    const bool force = (m_precision != dash->precision());
+    m_precision = dash->precision();
+
+    // Regular expresion handler, only compiled once
+    static const QRegularExpression regex("^[+-]?(\\d*\\.)?\\d+$");
 
     // Update labels
+    bool changed = false;
     for (int i = 0; i < group.datasetCount(); ++i)
     {
+        // Get dataset & skip the row if its value did not change since the
+        // last update
+        auto set = group.getDataset(i);
+        if (!force && !set.changed())
+            continue;
+
         // Get dataset value
-        auto value = group.getDataset(i).value();
+        auto value = set.value();
+        changed = true;
 
         // Check if value is a number, if so make sure that
         // we always show a fixed number of decimal places
         if (regex.match(value).hasMatch())
-            value = QString::number(value.toDouble(), 'f', dash->precision());
+            value = dash->formattedValue(value.toDouble());
 
         // Update label
         if (m_values.count() > i)
             m_values.at(i)->setText(value + " ");
+
+        // Show the running statistics of the dataset as row tooltip
+        auto stats = &UI::Statistics::instance();
+        const int column = stats->columnIndex(group.title(), set.title());
+        if (column >= 0 && m_values.count() > i)
+        {
+            const QString tooltip
+                = tr("Samples: %1\nMinimum: %2\nMaximum: %3\nMean: %4\n"
+                     "Std. deviation: %5")
+                      .arg(stats->samples(column))
+                      .arg(dash->formattedValue(stats->minimum(column)),
+                           dash->formattedValue(stats->maximum(column)),
+                           dash->formattedValue(stats->mean(column)),
+                           dash->formattedValue(
+                               stats->standardDeviation(column)));
+            m_titles.at(i)->setToolTip(tooltip);
+            m_values.at(i)->setToolTip(tooltip);
+        }
     }
 
     // Repaint widget
-    requestRepaint();
+    if (changed)
+        requestRepaint();
+}
+
+/**
+ * Forces a full re-render when the widget is re-enabled, rows are normally
+ * skipped when their value did not change since the last update, but the
+ * values displayed by a hidden widget may be arbitrarily old.
+ */
+void Widgets::DataGroup::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::EnabledChange && isEnabled())
+        m_precision = -1;
+
+    DashboardWidgetBase::changeEvent(event);
 }
 
 /**
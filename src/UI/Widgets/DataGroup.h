@@ -39,10 +39,14 @@ public:
     DataGroup(const int index = -1);
     ~DataGroup();
 
+    bool supportsRebind() const override;
+    void rebind(const int index) override;
+
 private Q_SLOTS:
     void updateData();
 
 protected:
+    void changeEvent(QEvent *event);
     void resizeEvent(QResizeEvent *event);
     void wheelEvent(QWheelEvent *event);
     void mouseMoveEvent(QMouseEvent *event);
@@ -52,6 +56,7 @@ protected:
 
 private:
     int m_index;
+    int m_precision;
 
     QVector<QLabel *> m_icons;
     QVector<QLabel *> m_units;
@@ -20,9 +20,170 @@
  * THE SOFTWARE.
  */
 
+#include <QtMath>
+#include <QwtPlotCanvas>
+#include <QwtPlotOpenGLCanvas>
+
 #include <UI/Dashboard.h>
+#include <Misc/TimerEvents.h>
 #include <Misc/ThemeManager.h>
+#include <Misc/ThreadPolicy.h>
 #include <UI/Widgets/FFTPlot.h>
+#include <UI/Widgets/Common/FFTPlanCache.h>
+
+/*
+ * Lowest level displayed in decibel mode, magnitudes below the floor are
+ * clamped so that silence does not stretch the plot towards minus infinity
+ */
+static const float kDecibelFloor = -60.0f;
+
+/*
+ * Scale factor between base-2 logarithms & decibels: 20 * log10(2)
+ */
+static const float kDecibelsPerLog2 = 6.0205999f;
+
+/**
+ * Branch-free base-2 logarithm approximation, accurate to about 0.01 within
+ * the displayed decibel range. The exponent is read straight from the float
+ * bit pattern & the mantissa is mapped through a small polynomial, so the
+ * compiler can vectorize the per-bin conversion loop (an exact log10 per bin
+ * at full analysis rate would dominate the cost of the transform itself).
+ */
+static inline float FastLog2(const float value)
+{
+    // Split the float into its exponent & mantissa
+    quint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const float exponent = float(int((bits >> 23) & 0xFF) - 127);
+    bits = (bits & 0x007FFFFF) | 0x3F800000;
+
+    // Polynomial approximation of log2(m) for m in [1, 2)
+    float mantissa;
+    memcpy(&mantissa, &bits, sizeof(mantissa));
+    return exponent
+        + ((-0.34484843f * mantissa + 2.02466578f) * mantissa - 1.67487759f);
+}
+
+//----------------------------------------------------------------------------------------
+// FFT worker (runs on a dedicated thread)
+//----------------------------------------------------------------------------------------
+
+/**
+ * Constructor function, obtains the transformer plan & allocates the
+ * double-buffered output spectra for the given FFT window @a size.
+ */
+Widgets::FFTWorker::FFTWorker(const int size, QObject *parent)
+    : QObject(parent)
+    , m_size(size)
+    , m_decibels(false)
+    , m_bufferIndex(0)
+    , m_transformer(Q_NULLPTR)
+{
+    // Split the sample window into 50% overlapping segments, the averaged
+    // periodogram of the segments has far less variance than the raw transform
+    // of the full window (Welch's method)
+    m_segment = qMax(8, m_size / 2);
+    m_hop = qMax(1, m_segment / 2);
+    m_segments = (m_size - m_segment) / m_hop + 1;
+
+    // Obtain the transformer plan & the shared Hann window table from the
+    // plan cache, the window is multiplied into every segment while it is
+    // copied to reduce spectral leakage
+    auto &cache = FFTPlanCache::instance();
+    m_transformer = cache.acquirePlan(m_segment);
+    m_window = cache.hannWindow(m_segment);
+
+    // Allocate scratch buffers & double-buffered output spectra
+    m_fft.resize(m_segment);
+    m_input.resize(m_segment);
+    m_buffers[0].resize(m_segment / 2 + 1);
+    m_buffers[1].resize(m_segment / 2 + 1);
+}
+
+/**
+ * Destructor function, returns the transformer plan to the cache so that the
+ * next widget of the same size can reuse it.
+ */
+Widgets::FFTWorker::~FFTWorker()
+{
+    FFTPlanCache::instance().releasePlan(m_segment, m_transformer);
+    m_transformer = Q_NULLPTR;
+}
+
+/**
+ * Enables or disables the decibel conversion stage of the worker. Invoked
+ * through a queued connection, so the flag never changes in the middle of a
+ * transform.
+ */
+void Widgets::FFTWorker::setDecibels(const bool enabled)
+{
+    m_decibels = enabled;
+}
+
+/**
+ * Computes the averaged periodogram of the given @a samples window & emits the
+ * finished spectrum. Segments are copied into a worker-owned scratch buffer
+ * because the sample vector is shared with the widget, the shared Hann window
+ * table is multiplied in during the copy.
+ */
+void Widgets::FFTWorker::transform(const QVector<float> &samples)
+{
+    // Validate sample window size
+    if (samples.count() != m_size)
+        return;
+
+    // Select the output buffer that is not being rendered by the GUI thread
+    auto &spectrum = m_buffers[m_bufferIndex];
+    m_bufferIndex = (m_bufferIndex + 1) & 1;
+    spectrum.fill(0);
+
+    // Accumulate the periodogram of every segment
+    const int last = m_segment / 2;
+    for (int s = 0; s < m_segments; ++s)
+    {
+        // Copy the segment into the scratch buffer (multiplying in the shared
+        // Hann window) & execute the FFT
+        const float *window = m_window.constData();
+        const float *source = samples.constData() + s * m_hop;
+        for (int i = 0; i < m_segment; ++i)
+            m_input[i] = source[i] * window[i];
+        m_transformer->forwardTransform(m_input.data(), m_fft.data());
+        m_transformer->rescale(m_fft.data());
+
+        // Add the magnitude of every frequency bin, the transform output is in
+        // half-complex layout (real parts in [0, last], imaginary parts in
+        // (last, size))
+        spectrum[0] += qAbs(m_fft[0]);
+        spectrum[last] += qAbs(m_fft[last]);
+        for (int i = 1; i < last; ++i)
+            spectrum[i]
+                += qSqrt(m_fft[i] * m_fft[i] + m_fft[last + i] * m_fft[last + i]);
+    }
+
+    // Average the accumulated periodograms
+    for (int i = 0; i <= last; ++i)
+        spectrum[i] /= m_segments;
+
+    // Convert the averaged magnitudes to decibels. The conversion uses the
+    // vectorizable @c FastLog2() approximation for the bins, the exact axis
+    // labels are drawn by the plot scale & are not affected by it.
+    if (m_decibels)
+    {
+        for (int i = 0; i <= last; ++i)
+        {
+            const float magnitude = qMax(spectrum[i], 1e-9f);
+            const float decibels = kDecibelsPerLog2 * FastLog2(magnitude);
+            spectrum[i] = qBound(kDecibelFloor, decibels, 0.0f);
+        }
+    }
+
+    // Notify the GUI thread
+    Q_EMIT spectrumReady(spectrum);
+}
+
+//----------------------------------------------------------------------------------------
+// FFT plot widget (runs on the GUI thread)
+//----------------------------------------------------------------------------------------
 
 /**
  * Constructor function, configures widget style & signal/slot connections.
@@ -30,15 +191,14 @@
 Widgets::FFTPlot::FFTPlot(const int index)
     : m_size(0)
     , m_index(index)
+    , m_busy(false)
+    , m_sampleIndex(0)
+    , m_worker(Q_NULLPTR)
 {
     // Get pointers to serial studio modules
     auto dash = &UI::Dashboard::instance();
     auto theme = &Misc::ThemeManager::instance();
 
-    // Initialize pointers to NULL
-    m_fft = Q_NULLPTR;
-    m_samples = Q_NULLPTR;
-
     // Invalid index, abort initialization
     if (m_index < 0 || m_index >= dash->fftCount())
         return;
@@ -70,7 +230,12 @@ Widgets::FFTPlot::FFTPlot(const int index)
     auto xAxisEngine = m_plot.axisScaleEngine(QwtPlot::xBottom);
     xAxisEngine->setAttribute(QwtScaleEngine::Floating, true);
 
-    // Create curve from data
+    // Create curve from data, the paint attributes enable the large-curve
+    // fast path of Qwt (viewport clipping & sub-pixel point weeding before
+    // the batched polyline draw calls)
+    m_curve.setPaintAttribute(QwtPlotCurve::ClipPolygons, true);
+    m_curve.setPaintAttribute(QwtPlotCurve::FilterPoints, true);
+    m_curve.setPaintAttribute(QwtPlotCurve::FilterPointsAggressive, true);
     m_curve.attach(&m_plot);
     m_plot.replot();
     m_plot.show();
@@ -86,92 +251,214 @@ Widgets::FFTPlot::FFTPlot(const int index)
     // Set curve color & plot style
     m_curve.setPen(QColor(color), 2, Qt::SolidLine);
 
-    // Get dataset max freq. & calculate fft size
+    // Get dataset max freq. & calculate fft size, the plan cache validates
+    // the size arithmetically instead of probing transformer tables
     auto dataset = UI::Dashboard::instance().getFFT(m_index);
-    int size = qMax(8, dataset.fftSamples());
-
-    // Ensure that FFT size is valid
-    while (m_transformer.setSize(size) != QFourierTransformer::FixedSize)
-        --size;
-
-    // Set FFT size
-    m_size = size;
+    m_size = FFTPlanCache::instance().validSize(dataset.fftSamples());
 
-    // Initialize samples & FFT arrays
-    m_fft = (float *)calloc(m_size, sizeof(float));
-    m_samples = (float *)calloc(m_size, sizeof(float));
+    // Initialize sample window buffers
+    m_samples[0].resize(m_size);
+    m_samples[1].resize(m_size);
+    m_samples[0].fill(0);
+    m_samples[1].fill(0);
 
-    // Clear Y-axis data
+    // Clear Y-axis data, the spectrum has one point per frequency bin
     PlotData xData;
     PlotData yData;
-    xData.reserve(m_size);
-    yData.reserve(m_size);
-    for (int i = 0; i < m_size; ++i)
+    const int bins = qMax(8, m_size / 2) / 2 + 1;
+    xData.reserve(bins);
+    yData.reserve(bins);
+    for (int i = 0; i < bins; ++i)
     {
         yData.append(0);
         xData.append(i);
     }
 
-    // Set y-scale from -1 to 1
-    m_plot.setAxisScale(QwtPlot::yLeft, -1, 1);
-
-    // Set axis titles
+    // Set x-axis title, the y-axis depends on the linear/decibel display mode
     m_plot.setAxisTitle(QwtPlot::xBottom, tr("Samples"));
-    m_plot.setAxisTitle(QwtPlot::yLeft, tr("FFT of %1").arg(dataset.title()));
 
     // Set curve data & replot
     m_curve.setSamples(xData, yData);
     m_plot.replot();
 
+    // Use the OpenGL canvas if hardware acceleration is enabled, otherwise
+    // cache the static layer of the default canvas in a pixmap so that
+    // data-only repaints just render the curve on top of it
+    if (dash->hardwareAcceleration())
+        updateCanvas();
+    else
+    {
+        auto canvas = qobject_cast<QwtPlotCanvas *>(m_plot.canvas());
+        if (canvas)
+            canvas->setPaintAttribute(QwtPlotCanvas::StaticLayerStore, true);
+    }
+
+    // Register the sample vector type for queued signal/slot connections
+    qRegisterMetaType<QVector<float>>("QVector<float>");
+
+    // Move the FFT worker to a dedicated thread, the transform must never block
+    // the GUI thread
+    // clang-format off
+    m_worker = new FFTWorker(m_size);
+    m_worker->moveToThread(&m_workerThread);
+    connect(&m_workerThread, &QThread::finished,
+            m_worker, &QObject::deleteLater);
+    connect(this, &FFTPlot::samplesReady,
+            m_worker, &FFTWorker::transform,
+            Qt::QueuedConnection);
+    connect(m_worker, &FFTWorker::spectrumReady,
+            this, &FFTPlot::displaySpectrum,
+            Qt::QueuedConnection);
+    // clang-format on
+    Misc::ThreadPolicy::instance().startThread(m_workerThread, m_worker, "fft",
+                                               QThread::InheritPriority);
+
+    // Apply the current linear/decibel display mode to the y-axis & worker
+    updateScale();
+
+    // Recompute the spectrum at a fixed analysis rate instead of once per
+    // dashboard frame, the sample window barely changes between consecutive
+    // frames & the transform is by far the most expensive part of the widget
+    // clang-format off
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout10Hz,
+            this, &FFTPlot::updateData);
+    // clang-format on
+
     // React to dashboard events
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
+    connect(dash, SIGNAL(fftDecibelsChanged()), this, SLOT(updateScale()));
+    connect(dash, SIGNAL(hardwareAccelerationChanged()), this, SLOT(updateCanvas()));
 }
 
 /**
- * Destructor function
+ * Configures the y-axis of the plot for the current linear/decibel display
+ * mode & forwards the mode to the worker thread. The axis labels are drawn
+ * from the exact plot scale, only the per-bin values use the fast logarithm
+ * approximation of the worker.
+ */
+void Widgets::FFTPlot::updateScale()
+{
+    // Invalid index, widget was not initialized
+    if (!m_worker)
+        return;
+
+    // Get dataset title for the y-axis label
+    auto dash = &UI::Dashboard::instance();
+    const auto title = dash->getFFT(m_index).title();
+
+    // Configure the y-axis for the selected display mode
+    if (dash->fftDecibels())
+    {
+        m_plot.setAxisScale(QwtPlot::yLeft, kDecibelFloor, 0);
+        m_plot.setAxisTitle(QwtPlot::yLeft, tr("FFT of %1 (dB)").arg(title));
+    }
+
+    else
+    {
+        m_plot.setAxisScale(QwtPlot::yLeft, 0, 1);
+        m_plot.setAxisTitle(QwtPlot::yLeft, tr("FFT of %1").arg(title));
+    }
+
+    // Forward the display mode to the worker thread, the queued call cannot
+    // interrupt a transform that is already running
+    // clang-format off
+    QMetaObject::invokeMethod(m_worker, "setDecibels", Qt::QueuedConnection,
+                              Q_ARG(bool, dash->fftDecibels()));
+    // clang-format on
+
+    // Redraw the plot with the new scale
+    m_plot.replot();
+    requestRepaint();
+}
+
+/**
+ * Replaces the canvas of the plot with an OpenGL-accelerated canvas when the
+ * user enables hardware acceleration (& with the default software-rasterized
+ * canvas when the user disables it).
+ */
+void Widgets::FFTPlot::updateCanvas()
+{
+    // Select the appropiate canvas for the current settings, the software
+    // canvas caches the static layer (background & frame) in a pixmap so
+    // that data-only repaints just render the curve on top of it
+    if (UI::Dashboard::instance().hardwareAcceleration())
+        m_plot.setCanvas(new QwtPlotOpenGLCanvas(&m_plot));
+    else
+    {
+        auto canvas = new QwtPlotCanvas(&m_plot);
+        canvas->setPaintAttribute(QwtPlotCanvas::StaticLayerStore, true);
+        m_plot.setCanvas(canvas);
+    }
+
+    // Re-apply canvas background & redraw the plot
+    m_plot.setCanvasBackground(Misc::ThemeManager::instance().base());
+    m_plot.replot();
+}
+
+/**
+ * Destructor function, stops the FFT worker thread
  */
 Widgets::FFTPlot::~FFTPlot()
 {
-    free(m_fft);
-    free(m_samples);
-    m_fft = Q_NULLPTR;
-    m_samples = Q_NULLPTR;
+    m_workerThread.quit();
+    m_workerThread.wait();
+}
+
+/**
+ * Returns the Qwt plot of the widget, used by the snapshot image export.
+ */
+QwtPlot *Widgets::FFTPlot::qwtPlot()
+{
+    return &m_plot;
 }
 
 /**
  * Checks if the widget is enabled, if so, the widget shall be updated
  * to display the latest data frame.
  *
- * If the widget is disabled (e.g. the user hides it, or the external
- * window is hidden), then the new data shall be saved to the plot
- * vector, but the widget shall not be redrawn.
+ * The transform itself runs on the worker thread, this function only copies
+ * the current sample window & dispatches it to the worker. While the worker
+ * is busy new windows are skipped, the dashboard keeps the full sample
+ * history so the next dispatch transforms a complete window anyway.
  */
 void Widgets::FFTPlot::updateData()
 {
-    // Verify that FFT sample arrays are valid
-    if (!m_samples || !m_fft)
+    // Verify that the worker is valid & idle
+    if (!m_worker || m_busy)
         return;
 
-    // Replot
+    // Widget not enabled, do not dispatch a new window to the worker
+    if (!isEnabled())
+        return;
+
+    // Dispatch the current sample window to the worker thread
     auto plotData = UI::Dashboard::instance().fftPlotValues();
     if (plotData.count() > m_index)
     {
-        // Copy data to samples array
-        auto data = plotData.at(m_index);
+        // Copy samples into the buffer that is not referenced by the worker
+        auto &samples = m_samples[m_sampleIndex];
+        m_sampleIndex = (m_sampleIndex + 1) & 1;
+        const auto &data = plotData.at(m_index);
         for (int i = 0; i < m_size; ++i)
-            m_samples[i] = static_cast<float>(data[i]);
-
-        // Execute FFT
-        m_transformer.forwardTransform(m_samples, m_fft);
-        m_transformer.rescale(m_fft);
-        m_curve.setSamples(m_fft, m_size);
-        m_plot.replot();
+            samples[i] = static_cast<float>(data.sampleAt(i));
 
-        // Repaint widget
-        requestRepaint();
+        // Wake up the worker thread
+        m_busy = true;
+        Q_EMIT samplesReady(samples);
     }
 }
 
+/**
+ * Uploads the finished @a spectrum computed by the worker thread to the plot
+ * & redraws the widget.
+ */
+void Widgets::FFTPlot::displaySpectrum(const QVector<float> &spectrum)
+{
+    m_busy = false;
+    m_curve.setSamples(spectrum);
+    m_plot.replot();
+    requestRepaint();
+}
+
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
 #    include "moc_FFTPlot.cpp"
 #endif
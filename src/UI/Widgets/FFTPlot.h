@@ -23,6 +23,7 @@
 #pragma once
 
 #include <QWidget>
+#include <QThread>
 #include <QwtPlot>
 #include <QVBoxLayout>
 #include <QwtPlotCurve>
@@ -33,26 +34,84 @@
 
 namespace Widgets
 {
+/**
+ * @brief The FFTWorker class
+ *
+ * Worker object that computes the spectrum of a sample window from a dedicated
+ * thread, the GUI thread only uploads finished spectra to the plot.
+ *
+ * The sample window is split into overlapping segments, each segment is
+ * multiplied with a Hann window & transformed, and the magnitudes of the
+ * resulting periodograms are averaged (Welch's method). Output spectra are
+ * double-buffered, while the GUI thread renders one buffer the worker writes
+ * the next spectrum into the other one.
+ *
+ * The transformer plan & the Hann window table are obtained from the
+ * process-wide @c FFTPlanCache: the window table is shared between all
+ * workers of the same size & the plan returns to the cache when the worker
+ * is destroyed, so rebuilding a project does not re-derive any tables.
+ */
+class FFTWorker : public QObject
+{
+    // clang-format off
+    Q_OBJECT
+    // clang-format on
+
+Q_SIGNALS:
+    void spectrumReady(const QVector<float> &spectrum);
+
+public:
+    explicit FFTWorker(const int size, QObject *parent = Q_NULLPTR);
+    ~FFTWorker();
+
+public Q_SLOTS:
+    void setDecibels(const bool enabled);
+    void transform(const QVector<float> &samples);
+
+private:
+    int m_size;
+    int m_hop;
+    int m_segment;
+    int m_segments;
+    bool m_decibels;
+    int m_bufferIndex;
+    QVector<float> m_fft;
+    QVector<float> m_input;
+    QVector<float> m_window;
+    QVector<float> m_buffers[2];
+    QFourierTransformer *m_transformer;
+};
+
 class FFTPlot : public DashboardWidgetBase
 {
     Q_OBJECT
 
+Q_SIGNALS:
+    void samplesReady(const QVector<float> &samples);
+
 public:
     FFTPlot(const int index = -1);
     ~FFTPlot();
 
+    QwtPlot *qwtPlot() override;
+
 private Q_SLOTS:
     void updateData();
+    void updateScale();
+    void updateCanvas();
+    void displaySpectrum(const QVector<float> &spectrum);
 
 private:
-    float *m_fft;
-    float *m_samples;
-
     int m_size;
     int m_index;
+    bool m_busy;
     QwtPlot m_plot;
     QwtPlotCurve m_curve;
     QVBoxLayout m_layout;
-    QFourierTransformer m_transformer;
+
+    int m_sampleIndex;
+    QVector<float> m_samples[2];
+    QThread m_workerThread;
+    FFTWorker *m_worker;
 };
 }
@@ -20,17 +20,100 @@
  * THE SOFTWARE.
  */
 
+#include <point.h>
+#include <linestring.h>
 #include <googlemapadapter.h>
 
+#include <QDir>
+#include <QtMath>
+#include <QStandardPaths>
+
 #include <UI/Dashboard.h>
 #include <UI/Widgets/GPS.h>
 #include <Misc/ThemeManager.h>
 
+/**
+ * Minimum distance in meters between two kept trail points, closer readings
+ * are culled so that a stationary or slow receiver does not grow the trail
+ */
+static const double kTrailMinDistance = 5.0;
+
+/**
+ * Maximum perpendicular deviation in meters tolerated when extending the last
+ * trail segment instead of appending a new point, straight drives collapse
+ * into a handful of long segments
+ */
+static const double kTrailMaxDeviation = 10.0;
+
+/**
+ * Maximum number of points of the trail polyline, when exceeded the trail is
+ * re-simplified with a doubled distance threshold so that map redraws stay
+ * constant-cost no matter how long the session runs
+ */
+static const int kTrailMaxPoints = 4096;
+
+/**
+ * Size of the persistent map tile cache in megabytes
+ */
+static const int kTileCacheSizeMB = 256;
+
+/**
+ * Minimum movement in meters of the reported position before the map view is
+ * re-centered & redrawn, closer readings are treated as GPS noise so that a
+ * parked vehicle does not keep the map rendering pipeline busy
+ */
+static const double kViewMinDistance = 2.0;
+
+/**
+ * Maximum number of map redraws per second, re-centering is coalesced to this
+ * rate independently of the dashboard tick rate
+ */
+static const int kMapMaxRedrawRate = 5;
+
+/**
+ * Returns the approximate distance in meters between the given coordinates
+ * (x = longitude, y = latitude). The equirectangular approximation is exact
+ * enough at trail scale & costs a single cosine.
+ */
+static double DistanceMeters(const QPointF &a, const QPointF &b)
+{
+    const double metersPerDegree = 111320.0;
+    const double dLat = (b.y() - a.y()) * metersPerDegree;
+    const double dLon = (b.x() - a.x()) * metersPerDegree
+                        * qCos(qDegreesToRadians((a.y() + b.y()) / 2));
+    return qSqrt(dLat * dLat + dLon * dLon);
+}
+
+/**
+ * Returns the perpendicular deviation in meters of point @a p from the
+ * segment that runs from @a a to @a b
+ */
+static double DeviationMeters(const QPointF &a, const QPointF &b,
+                              const QPointF &p)
+{
+    const double length = DistanceMeters(a, b);
+    if (length <= 0)
+        return DistanceMeters(a, p);
+
+    // Cross product of (b - a) & (p - a) in local planar meters
+    const double metersPerDegree = 111320.0;
+    const double lonScale = qCos(qDegreesToRadians(a.y()));
+    const double abX = (b.x() - a.x()) * metersPerDegree * lonScale;
+    const double abY = (b.y() - a.y()) * metersPerDegree;
+    const double apX = (p.x() - a.x()) * metersPerDegree * lonScale;
+    const double apY = (p.y() - a.y()) * metersPerDegree;
+    return qFabs(abX * apY - abY * apX) / length;
+}
+
 /**
  * Generates the user interface elements & layout
  */
 Widgets::GPS::GPS(const int index)
     : m_index(index)
+    , m_minDistance(kTrailMinDistance)
+    , m_trailLayer(Q_NULLPTR)
+    , m_lastTrailPoint(Q_NULLPTR)
+    , m_trail(Q_NULLPTR)
 {
     // Get pointers to serial studio modules
     auto dash = &UI::Dashboard::instance();
@@ -83,6 +166,16 @@ Widgets::GPS::GPS(const int index)
     m_mapControl.setMouseMode(qmapcontrol::MapControl::None);
     m_mapControl.resize(QSize(width() - 28, height() - 36 - m_titleWidget.height()));
 
+    // Enable the persistent tile cache, the directory is shared by every GPS
+    // widget & survives across sessions so that previously visited areas
+    // render without re-downloading a single tile. The in-memory pixmap
+    // cache of the image manager keeps the tiles of the visible area in
+    // front of the disk cache.
+    const auto cachePath
+        = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+          + "/MapTiles";
+    m_mapControl.enablePersistentCache(QDir(cachePath), kTileCacheSizeMB);
+
     // Load google maps adapter
     auto *mapadapter = new qmapcontrol::GoogleMapAdapter();
     auto *l = new qmapcontrol::Layer("Custom Layer", mapadapter,
@@ -90,6 +183,16 @@ Widgets::GPS::GPS(const int index)
     m_mapControl.addLayer(l);
     m_mapControl.setZoom(14);
 
+    // Create the trail layer with the traversed track
+    m_trailPen = QPen(theme->alternativeHighlight());
+    m_trailPen.setWidth(3);
+    m_trail = new qmapcontrol::LineString(QList<qmapcontrol::Point *>(),
+                                          "GPS Trail", &m_trailPen);
+    m_trailLayer = new qmapcontrol::Layer("Trail Layer", mapadapter,
+                                          qmapcontrol::Layer::GeometryLayer);
+    m_trailLayer->addGeometry(m_trail);
+    m_mapControl.addLayer(m_trailLayer);
+
     // Configure layout
     m_layout.setSpacing(8);
     m_layout.addWidget(&m_titleWidget, 0);
@@ -97,8 +200,10 @@ Widgets::GPS::GPS(const int index)
     m_layout.setContentsMargins(12, 12, 12, 12);
     setLayout(&m_layout);
 
-    // React to Qt signals
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
+    // React to Qt signals, map widgets are updated on the last slice of the
+    // UI interval
+    connect(dash, SIGNAL(updatedSlice3()), this, SLOT(updateData()),
+            Qt::QueuedConnection);
 }
 
 /**
@@ -123,6 +228,7 @@ void Widgets::GPS::updateData()
     auto group = dash->getGPS(m_index);
 
     // Get latitiude/longitude from datasets
+    bool found = false;
     qreal lat = -1;
     qreal lon = -1;
     qreal alt = -1;
@@ -130,28 +236,139 @@ void Widgets::GPS::updateData()
     {
         auto dataset = group.getDataset(i);
         if (dataset.widget() == "lat")
-            lat = dataset.value().toDouble();
+        {
+            lat = dataset.numericValue();
+            found = true;
+        }
         else if (dataset.widget() == "lon")
-            lon = dataset.value().toDouble();
+        {
+            lon = dataset.numericValue();
+            found = true;
+        }
         else if (dataset.widget() == "alt")
-            alt = dataset.value().toDouble();
+            alt = dataset.numericValue();
     }
 
-    // Update map position
-    m_mapControl.setView(QPointF(lon, lat));
+    // Update map position & append the fix to the traversed track. Position
+    // changes below the gating threshold are treated as GPS noise & skipped,
+    // and re-centering is coalesced to at most @c kMapMaxRedrawRate redraws
+    // per second independently of the dashboard tick rate.
+    if (found)
+    {
+        const QPointF position(lon, lat);
+        const bool moved = m_viewCenter.isNull()
+                           || DistanceMeters(m_viewCenter, position) >= kViewMinDistance;
+        const bool redrawDue = !m_mapElapsed.isValid()
+                               || m_mapElapsed.elapsed() >= 1000 / kMapMaxRedrawRate;
+        if (moved && redrawDue)
+        {
+            m_viewCenter = position;
+            m_mapElapsed.restart();
+            m_mapControl.setView(position);
+            appendToTrail(lat, lon);
+            requestRepaint();
+        }
+    }
 
     // Update map title
-    auto latstr = QString::number(lat, 'f', dash->precision());
-    auto lonstr = QString::number(lon, 'f', dash->precision());
-    auto altstr = QString::number(alt, 'f', dash->precision());
+    auto latstr = dash->formattedValue(lat);
+    auto lonstr = dash->formattedValue(lon);
+    auto altstr = dash->formattedValue(alt);
 
     // clang-format off
-    m_label->setText(QString("<u>POS:</u><i> %1,%2</i>&nbsp;<u>ALT:</u><i> %3 m</i>")
-                     .arg(latstr, lonstr, altstr));
+    auto text = QString("<u>POS:</u><i> %1,%2</i>&nbsp;<u>ALT:</u><i> %3 m</i>")
+                .arg(latstr, lonstr, altstr);
     // clang-format on
 
-    // Repaint widget
-    requestRepaint();
+    // Repaint the widget when the displayed text changed, the rounding of
+    // formattedValue() filters out sub-precision coordinate noise
+    if (text != m_label->text())
+    {
+        m_label->setText(text);
+        requestRepaint();
+    }
+}
+
+/**
+ * Appends the given position to the traversed track. The trail polyline is
+ * simplified on the fly: readings within @c kTrailMinDistance of the last
+ * kept point are culled & near-collinear continuations only move the end of
+ * the last segment, so a long straight drive costs a handful of points
+ * instead of one per frame.
+ */
+void Widgets::GPS::appendToTrail(const qreal lat, const qreal lon)
+{
+    if (!m_trail)
+        return;
+
+    // First fix of the session
+    const QPointF position(lon, lat);
+    if (m_trail->numberOfPoints() == 0)
+    {
+        m_lastTrailPoint = new qmapcontrol::Point(lon, lat);
+        m_trail->addPoint(m_lastTrailPoint);
+        m_prevKept = position;
+        m_lastKept = position;
+        return;
+    }
+
+    // Radial distance culling, the receiver did not move far enough for the
+    // new reading to change the rendered trail
+    if (DistanceMeters(m_lastKept, position) < m_minDistance)
+        return;
+
+    // Near-collinear continuation of the last segment, move its end instead
+    // of appending a new point
+    if (m_trail->numberOfPoints() >= 2
+        && DeviationMeters(m_prevKept, position, m_lastKept) < kTrailMaxDeviation)
+    {
+        m_lastTrailPoint->setCoordinate(position);
+        m_lastKept = position;
+        return;
+    }
+
+    // Direction changed, keep the previous point & start a new segment
+    m_lastTrailPoint = new qmapcontrol::Point(lon, lat);
+    m_trail->addPoint(m_lastTrailPoint);
+    m_prevKept = m_lastKept;
+    m_lastKept = position;
+
+    // Keep the point count bounded for multi-hour sessions
+    if (m_trail->numberOfPoints() > kTrailMaxPoints)
+        coarsenTrail();
+}
+
+/**
+ * Re-simplifies the trail with a doubled distance threshold, called when the
+ * polyline exceeds @c kTrailMaxPoints. Doubling the threshold roughly halves
+ * the point count, so the amortized cost per appended point is constant.
+ */
+void Widgets::GPS::coarsenTrail()
+{
+    // Cull the kept points with the doubled distance threshold
+    m_minDistance *= 2;
+    const auto points = m_trail->points();
+    QList<qmapcontrol::Point *> simplified;
+    QPointF last;
+    for (int i = 0; i < points.count(); ++i)
+    {
+        const QPointF position = points.at(i)->coordinate();
+        if (i == 0 || i == points.count() - 1
+            || DistanceMeters(last, position) >= m_minDistance)
+        {
+            simplified.append(
+                new qmapcontrol::Point(position.x(), position.y()));
+            last = position;
+        }
+    }
+
+    // Replace the trail points, setPoints() deletes the old ones
+    m_trail->setPoints(simplified);
+    m_lastTrailPoint = simplified.last();
+    m_lastKept = m_lastTrailPoint->coordinate();
+    m_prevKept = simplified.count() >= 2
+                     ? simplified.at(simplified.count() - 2)->coordinate()
+                     : m_lastKept;
 }
 
 /**
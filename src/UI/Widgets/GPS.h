@@ -22,16 +22,24 @@
 
 #pragma once
 
+#include <QPen>
 #include <QLabel>
 #include <QPushButton>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
+#include <QElapsedTimer>
 
 #include <mapcontrol.h>
 #include <UI/DashboardWidget.h>
 
 class QNetworkReply;
 
+namespace qmapcontrol
+{
+class Point;
+class LineString;
+}
+
 namespace Widgets
 {
 class GPS : public DashboardWidgetBase
@@ -48,6 +56,10 @@ protected:
     void resizeEvent(QResizeEvent *event);
     void mousePressEvent(QMouseEvent *event);
 
+private:
+    void appendToTrail(const qreal lat, const qreal lon);
+    void coarsenTrail();
+
 private:
     int m_index;
     QLabel *m_label;
@@ -57,5 +69,20 @@ private:
     QWidget m_titleWidget;
     QHBoxLayout m_titleLayout;
     qmapcontrol::MapControl m_mapControl;
+
+    // Last rendered view center & redraw timestamp, used to skip map updates
+    // for sub-threshold position noise & to cap the map redraw rate
+    QPointF m_viewCenter;
+    QElapsedTimer m_mapElapsed;
+
+    // Traversed track, incrementally simplified so that the number of points
+    // stays bounded no matter how long the session runs
+    QPen m_trailPen;
+    QPointF m_lastKept;
+    QPointF m_prevKept;
+    double m_minDistance;
+    qmapcontrol::Layer *m_trailLayer;
+    qmapcontrol::Point *m_lastTrailPoint;
+    qmapcontrol::LineString *m_trail;
 };
 }
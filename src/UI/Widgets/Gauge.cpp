@@ -20,26 +20,71 @@
  * THE SOFTWARE.
  */
 
+#include <QtMath>
+
 #include <UI/Dashboard.h>
 #include <UI/Widgets/Gauge.h>
 #include <Misc/ThemeManager.h>
 
 /**
- * Constructor function, configures widget style & signal/slot connections.
+ * Constructor function, configures widget style & signal/slot connections. The
+ * dataset-specific configuration lives in @c rebind() so that the widget pool can
+ * recycle this instance for another dataset.
  */
 Widgets::Gauge::Gauge(const int index)
-    : m_index(index)
+    : m_index(-1)
 {
     // Get pointers to Serial Studio modules
     auto dash = &UI::Dashboard::instance();
     auto theme = &Misc::ThemeManager::instance();
 
-    // Invalid index, abort initialization
+    // Set gauge font & palette
+    QPalette palette;
+    palette.setColor(QPalette::WindowText, theme->base());
+    palette.setColor(QPalette::Text, theme->widgetIndicator());
+    m_gauge.setPalette(palette);
+    m_gauge.setFont(dash->monoFont());
+
+    // Set widget pointer
+    setWidget(&m_gauge);
+
+    // React to dashboard events, gauges are updated on the last slice of the
+    // UI interval
+    connect(dash, SIGNAL(updatedSlice3()), this, SLOT(updateData()),
+            Qt::QueuedConnection);
+
+    // Configure the widget for the given dataset
+    rebind(index);
+}
+
+/**
+ * Gauge widgets can be recycled by the widget pool, the per-dataset state is
+ * re-generated by @c rebind().
+ */
+bool Widgets::Gauge::supportsRebind() const
+{
+    return true;
+}
+
+/**
+ * Re-configures the gauge for the dataset with the given relative @a index: needle
+ * color & scale. Called from the constructor and every time the widget pool recycles
+ * this instance for another dashboard build.
+ */
+void Widgets::Gauge::rebind(const int index)
+{
+    // Register new index & clear the value of the previous dataset
+    m_index = index;
+    setValue("");
+
+    // Invalid index, abort configuration
+    auto dash = &UI::Dashboard::instance();
     if (m_index < 0 || m_index >= dash->gaugeCount())
         return;
 
     // Get needle & knob color
     QString needleColor;
+    auto theme = &Misc::ThemeManager::instance();
     auto colors = theme->widgetColors();
     auto knobColor = theme->widgetControlBackground();
     if (colors.count() > m_index)
@@ -47,27 +92,14 @@ Widgets::Gauge::Gauge(const int index)
     else
         needleColor = colors.at(colors.count() % m_index);
 
-    // Configure gauge needle
+    // Configure gauge needle (the dial deletes the previous needle)
     auto needle = new QwtDialSimpleNeedle(QwtDialSimpleNeedle::Arrow, true,
                                           QColor(needleColor), knobColor);
     m_gauge.setNeedle(needle);
-    m_gauge.setFont(dash->monoFont());
 
     // Set gauge scale
     auto dataset = dash->getGauge(m_index);
     m_gauge.setScale(dataset.min(), dataset.max());
-
-    // Set gauge palette
-    QPalette palette;
-    palette.setColor(QPalette::WindowText, theme->base());
-    palette.setColor(QPalette::Text, theme->widgetIndicator());
-    m_gauge.setPalette(palette);
-
-    // Set widget pointer
-    setWidget(&m_gauge);
-
-    // React to dashboard events
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
 }
 
 /**
@@ -90,13 +122,15 @@ void Widgets::Gauge::updateData()
 
     // Update gauge value
     auto dataset = dash->getGauge(m_index);
-    m_gauge.setValue(dataset.value().toDouble());
-    setValue(QString("%1 %2").arg(
-        QString::number(dataset.value().toDouble(), 'f', dash->precision()),
-        dataset.units()));
+    m_gauge.setValue(dataset.numericValue());
+    setValue(QString("%1 %2").arg(dash->formattedValue(dataset.numericValue()),
+                                  dataset.units()));
 
-    // Repaint widget
-    requestRepaint();
+    // Repaint widget, sub-pixel needle movements are skipped. Over the full
+    // scale the needle tip travels along a 270° arc, which is roughly 3/4 of
+    // the gauge circumference.
+    const double arc = 0.75 * M_PI * qMin(m_gauge.width(), m_gauge.height());
+    requestRepaint(dataset.numericValue(), dataset.min(), dataset.max(), arc);
 }
 
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
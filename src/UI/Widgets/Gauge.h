@@ -34,6 +34,9 @@ class Gauge : public BaseWidget
 public:
     Gauge(const int index = -1);
 
+    bool supportsRebind() const override;
+    void rebind(const int index) override;
+
 private Q_SLOTS:
     void updateData();
 
@@ -57,8 +57,10 @@ Widgets::Gyroscope::Gyroscope(const int index)
             this, &Widgets::Gyroscope::updateLabel);
     // clang-format on
 
-    // React to dashboard events
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
+    // React to dashboard events, gyroscopes are updated on the last slice of
+    // the UI interval
+    connect(dash, SIGNAL(updatedSlice3()), this, SLOT(updateData()),
+            Qt::QueuedConnection);
 }
 
 /**
@@ -78,36 +80,18 @@ void Widgets::Gyroscope::updateData()
     if (m_index < 0 || m_index >= dash->gyroscopeCount())
         return;
 
-    // Get group reference & validate dataset count
-    auto group = dash->getGyroscope(m_index);
-    if (group.datasetCount() != 3)
-        return;
-
-    // Initialize values for pitch, roll & yaw
-    double p = 0;
-    double r = 0;
-    double y = 0;
-
-    // Extract pitch, roll & yaw from group datasets
-    for (int i = 0; i < 3; ++i)
-    {
-        auto dataset = group.getDataset(i);
-        if (dataset.widget() == "pitch")
-            p = dataset.value().toDouble();
-        if (dataset.widget() == "roll")
-            r = dataset.value().toDouble();
-        if (dataset.widget() == "yaw")
-            y = dataset.value().toDouble();
-    }
+    // Get the attitude computed once per frame by the dashboard, every widget
+    // fed by the group renders the same values
+    const auto &attitude = dash->gyroscopeValues(m_index);
 
     // Construct strings from pitch, roll & yaw
-    m_yaw = QString::number(qAbs(y), 'f', dash->precision());
-    m_roll = QString::number(qAbs(r), 'f', dash->precision());
-    m_pitch = QString::number(qAbs(p), 'f', dash->precision());
+    m_yaw = dash->formattedValue(qAbs(attitude.yaw));
+    m_roll = dash->formattedValue(qAbs(attitude.roll));
+    m_pitch = dash->formattedValue(qAbs(attitude.pitch));
 
     // Update gauge
-    m_gauge.setValue(p);
-    m_gauge.setGradient(r / 360.0);
+    m_gauge.setValue(attitude.pitch);
+    m_gauge.setGradient(attitude.roll / 360.0);
 
     // Repaint the widget
     requestRepaint();
@@ -31,6 +31,7 @@
  */
 Widgets::LEDPanel::LEDPanel(const int index)
     : m_index(index)
+    , m_stale(false)
 {
     // Get pointers to serial studio modules
     auto dash = &UI::Dashboard::instance();
@@ -59,12 +60,37 @@ Widgets::LEDPanel::LEDPanel(const int index)
     auto valueFont = dash->monoFont();
     valueFont.setPixelSize(dash->monoFont().pixelSize() * 1.3);
 
+    // Build the list of LED slots: regular datasets produce one LED each, while
+    // bitmask datasets are expanded into one LED per bit label (bit 0 first)
+    StringList slotTitles;
+    for (int dataset = 0; dataset < group.datasetCount(); ++dataset)
+    {
+        auto set = group.getDataset(dataset);
+        if (set.ledBitmask() && !set.ledLabels().isEmpty())
+        {
+            const auto labels = set.ledLabels();
+            for (int bit = 0; bit < labels.count(); ++bit)
+            {
+                slotTitles.append(labels.at(bit));
+                m_datasets.append(dataset);
+                m_bits.append(bit);
+            }
+        }
+
+        else
+        {
+            slotTitles.append(set.title());
+            m_datasets.append(dataset);
+            m_bits.append(-1);
+        }
+    }
+
     // Configure grid layout
-    m_leds.reserve(group.datasetCount());
-    m_titles.reserve(group.datasetCount());
+    m_leds.reserve(slotTitles.count());
+    m_titles.reserve(slotTitles.count());
     m_gridLayout = new QGridLayout(m_dataContainer);
     m_gridLayout->setSpacing(16);
-    for (int dataset = 0; dataset < group.datasetCount(); ++dataset)
+    for (int slot = 0; slot < slotTitles.count(); ++slot)
     {
         // Create labels
         m_leds.append(new KLed(m_dataContainer));
@@ -77,7 +103,7 @@ Widgets::LEDPanel::LEDPanel(const int index)
         // Set label styles & fonts
         title->setStyleSheet(titleQSS);
         title->setFont(dash->monoFont());
-        title->setText(group.getDataset(dataset).title());
+        title->setText(slotTitles.at(slot));
 
         // Set LED color & style
         led->setLook(KLed::Sunken);
@@ -86,8 +112,8 @@ Widgets::LEDPanel::LEDPanel(const int index)
 
         // Calculate column and row
         int column = 0;
-        int row = dataset;
-        int count = dataset + 1;
+        int row = slot;
+        int count = slot + 1;
         while (count > 3)
         {
             count -= 3;
@@ -119,8 +145,10 @@ Widgets::LEDPanel::LEDPanel(const int index)
     m_mainLayout->setContentsMargins(0, 0, 0, 0);
     setLayout(m_mainLayout);
 
-    // React to dashboard events
-    connect(dash, SIGNAL(updated()), this, SLOT(updateData()), Qt::QueuedConnection);
+    // React to dashboard events, LED panels are updated on the third slice of
+    // the UI interval
+    connect(dash, SIGNAL(updatedSlice2()), this, SLOT(updateData()),
+            Qt::QueuedConnection);
 }
 
 /**
@@ -161,22 +189,64 @@ void Widgets::LEDPanel::updateData()
     auto group = dash->getLED(m_index);
 
     // Update labels
-    for (int i = 0; i < group.datasetCount(); ++i)
+    bool changed = false;
+    for (int i = 0; i < m_leds.count(); ++i)
     {
-        // Check vector size
-        if (m_leds.count() < i)
+        // Check dataset index of the LED slot
+        const int index = m_datasets.at(i);
+        if (index >= group.datasetCount())
             break;
 
+        // Skip the LED if its value did not change since the last update,
+        // unless the widget was hidden & its LEDs may be arbitrarily old
+        auto set = group.getDataset(index);
+        if (!m_stale && !set.changed())
+            continue;
+
+        // Bitmask slot, test the bit assigned to this LED
+        const int bit = m_bits.at(i);
+        if (bit >= 0)
+        {
+            const auto bits = static_cast<quint32>(set.numericValue());
+            if (bits & (1u << bit))
+                m_leds.at(i)->on();
+            else
+                m_leds.at(i)->off();
+        }
+
         // Get dataset value (we compare with 0.1 for low voltages)
-        auto value = group.getDataset(i).value().toDouble();
-        if (qAbs(value) < 0.10)
-            m_leds.at(i)->off();
         else
-            m_leds.at(i)->on();
+        {
+            auto value = set.numericValue();
+            if (qAbs(value) < 0.10)
+                m_leds.at(i)->off();
+            else
+                m_leds.at(i)->on();
+        }
+
+        // Update repaint flag
+        changed = true;
     }
 
+    // All LEDs are up to date again
+    m_stale = false;
+
     // Repaint widget
-    requestRepaint();
+    if (changed)
+        requestRepaint();
+}
+
+/**
+ * Marks the LED states as stale when the widget is re-enabled, LEDs are
+ * normally skipped when their value did not change since the last update, but
+ * the states displayed by a hidden widget may be arbitrarily old.
+ */
+void Widgets::LEDPanel::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::EnabledChange && isEnabled())
+        m_stale = true;
+
+    DashboardWidgetBase::changeEvent(event);
 }
 
 /**
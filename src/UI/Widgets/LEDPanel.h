@@ -44,14 +44,21 @@ private Q_SLOTS:
     void updateData();
 
 protected:
+    void changeEvent(QEvent *event);
     void resizeEvent(QResizeEvent *event);
 
 private:
     int m_index;
+    bool m_stale;
 
     QVector<KLed *> m_leds;
     QVector<QLabel *> m_titles;
 
+    // Dataset index & bit number of every LED slot, regular datasets use a bit
+    // number of -1 while bitmask datasets produce one slot per bit label
+    QVector<int> m_bits;
+    QVector<int> m_datasets;
+
     QWidget *m_dataContainer;
     QVBoxLayout *m_mainLayout;
     QGridLayout *m_gridLayout;
@@ -20,6 +20,10 @@
  * THE SOFTWARE.
  */
 
+#include <QwtPlotCanvas>
+#include <QwtLegendLabel>
+#include <QwtPlotOpenGLCanvas>
+
 #include <CSV/Player.h>
 #include <UI/Dashboard.h>
 #include <Misc/ThemeManager.h>
@@ -30,6 +34,7 @@
  */
 Widgets::MultiPlot::MultiPlot(const int index)
     : m_index(index)
+    , m_normalized(false)
 {
     // Get pointers to serial studio modules
     auto dash = &UI::Dashboard::instance();
@@ -89,21 +94,55 @@ Widgets::MultiPlot::MultiPlot(const int index)
         else if (i > 0)
             color = colors.at(colors.count() % i);
 
-        // Configure curve
+        // Configure curve, the paint attributes enable the large-curve fast
+        // path of Qwt (viewport clipping & sub-pixel point weeding before
+        // the batched polyline draw calls)
         curve->setPen(QColor(color), 2, Qt::SolidLine);
+        curve->setPaintAttribute(QwtPlotCurve::ClipPolygons, true);
+        curve->setPaintAttribute(QwtPlotCurve::FilterPoints, true);
+        curve->setPaintAttribute(QwtPlotCurve::FilterPointsAggressive, true);
         curve->attach(&m_plot);
 
         // Register curve
         m_curves.append(curve);
     }
 
-    // Add plot legend to display curve names
+    // Allocate the decimated sample vectors & bridge them to the curves, the
+    // series reference the vectors of the widget directly so updating a
+    // curve does not copy the x/y arrays into Qwt anymore. All curves hold
+    // the same number of samples, so they share a single x-axis vector.
+    m_series.reserve(group.datasetCount());
+    m_yCurveData.resize(group.datasetCount());
+    for (int i = 0; i < group.datasetCount(); ++i)
+    {
+        auto series = new PlotSeriesData(m_xData, m_yCurveData[i]);
+        m_curves.at(i)->setData(series);
+        m_series.append(series);
+    }
+
+    // Add plot legend to display curve names, the legend entries are
+    // checkable & toggle the visibility of their curve
     m_legend.setFrameStyle(QFrame::Plain);
+    m_legend.setDefaultItemMode(QwtLegendData::Checkable);
     m_plot.setAxisTitle(QwtPlot::yLeft, group.title());
     m_plot.setAxisTitle(QwtPlot::xBottom, tr("Samples"));
     m_plot.insertLegend(&m_legend, QwtPlot::BottomLegend);
 
+    // All curves are visible initially
+    Q_FOREACH (auto curve, m_curves)
+    {
+        auto label = qobject_cast<QwtLegendLabel *>(
+            m_legend.legendWidget(m_plot.itemToInfo(curve)));
+        if (label)
+            label->setChecked(true);
+    }
+
+    // React to the visibility checkboxes of the legend
+    connect(&m_legend, SIGNAL(checked(QVariant,bool,int)), this,
+            SLOT(onLegendChecked(QVariant,bool,int)));
+
     // Normalize data curves
+    m_normalized = normalize;
     if (normalize)
         m_plot.setAxisScale(QwtPlot::yLeft, 0, 1);
 
@@ -112,17 +151,40 @@ Widgets::MultiPlot::MultiPlot(const int index)
     m_plot.replot();
     m_plot.show();
 
-    // React to dashboard events
+    // Use the OpenGL canvas if hardware acceleration is enabled, otherwise
+    // cache the static layer of the default canvas in a pixmap so that
+    // data-only repaints just render the curves on top of it
+    if (dash->hardwareAcceleration())
+        updateCanvas();
+    else
+    {
+        auto canvas = qobject_cast<QwtPlotCanvas *>(m_plot.canvas());
+        if (canvas)
+            canvas->setPaintAttribute(QwtPlotCanvas::StaticLayerStore, true);
+    }
+
+    // React to dashboard events, multiplots are updated on the second slice
+    // of the UI interval
     // clang-format off
-    connect(dash, SIGNAL(updated()),
+    connect(dash, SIGNAL(updatedSlice1()),
             this, SLOT(updateData()),
             Qt::QueuedConnection);
     connect(dash, SIGNAL(pointsChanged()),
             this, SLOT(updateRange()),
             Qt::QueuedConnection);
+    connect(dash, SIGNAL(hardwareAccelerationChanged()),
+            this, SLOT(updateCanvas()));
     // clang-format on
 }
 
+/**
+ * Returns the Qwt plot of the widget, used by the snapshot image export.
+ */
+QwtPlot *Widgets::MultiPlot::qwtPlot()
+{
+    return &m_plot;
+}
+
 /**
  * Checks if the widget is enabled, if so, the widget shall be updated
  * to display the latest data frame.
@@ -141,6 +203,12 @@ void Widgets::MultiPlot::updateData()
     // Get group
     auto group = dash->getMultiplot(m_index);
 
+    // Refresh the shared x-axis vector, it only depends on the sample count
+    // & the canvas width, so one pass covers every curve of the plot
+    const int maxPoints = qMax(256, m_plot.canvas()->width() * 2);
+    if (isEnabled() && !m_yData.isEmpty())
+        UI::PlotBuffer::binAxis(m_xData, m_yData.first().count(), maxPoints);
+
     // Plot each dataset
     for (int i = 0; i < group.datasetCount(); ++i)
     {
@@ -151,40 +219,77 @@ void Widgets::MultiPlot::updateData()
         // Get dataset
         auto dataset = group.getDataset(i);
 
-        // Add point to plot data
-        auto data = m_yData[i].data();
-        auto count = m_yData[i].count();
-        memmove(data, data + 1, count * sizeof(double));
-
-        // Normalize dataset value
+        // Add point to plot data & normalize dataset value, appending is a
+        // constant-time operation because the plot buffers are circular
         if (dataset.max() > dataset.min())
         {
             auto vmin = dataset.min();
             auto vmax = dataset.max();
-            auto v = dataset.value().toDouble();
-            m_yData[i][count - 1] = (v - vmin) / (vmax - vmin);
+            auto v = dataset.numericValue();
+            m_yData[i].append((v - vmin) / (vmax - vmin));
         }
 
         // Plot dataset value directly
         else
-            m_yData[i][count - 1] = dataset.value().toDouble();
+            m_yData[i].append(dataset.numericValue());
 
         // Widget not enabled, do not redraw
         if (!isEnabled())
             continue;
 
-        // Plot new data
-        m_curves.at(i)->setSamples(m_yData[i]);
+        // Curve hidden through the legend, skip the decimation/upload work
+        // (the sample buffer stays up to date & is re-uploaded on re-show)
+        if (m_curves.count() > i && !m_curves.at(i)->isVisible())
+            continue;
+
+        // Refresh curve data, decimated to roughly two samples per canvas
+        // pixel with min/max binning to keep the render cost flat
+        if (m_series.count() > i)
+        {
+            m_yData.at(i).decimate(m_yCurveData[i], maxPoints);
+            m_series.at(i)->invalidate();
+        }
     }
 
-    // Plot widget again
+    // Plot widget again, when the y-axis is normalized both axis scales are
+    // fixed & we only need to repaint the canvas contents instead of doing a
+    // full QwtPlot::replot() call
     if (isEnabled())
     {
-        m_plot.replot();
+        auto canvas = qobject_cast<QwtPlotCanvas *>(m_plot.canvas());
+        if (m_normalized && canvas)
+            canvas->replot();
+        else
+            m_plot.replot();
+
         requestRepaint();
     }
 }
 
+/**
+ * Replaces the canvas of the plot with an OpenGL-accelerated canvas when the
+ * user enables hardware acceleration (& with the default software-rasterized
+ * canvas when the user disables it).
+ */
+void Widgets::MultiPlot::updateCanvas()
+{
+    // Select the appropiate canvas for the current settings, the software
+    // canvas caches the static layer (background & frame) in a pixmap so
+    // that data-only repaints just render the curves on top of it
+    if (UI::Dashboard::instance().hardwareAcceleration())
+        m_plot.setCanvas(new QwtPlotOpenGLCanvas(&m_plot));
+    else
+    {
+        auto canvas = new QwtPlotCanvas(&m_plot);
+        canvas->setPaintAttribute(QwtPlotCanvas::StaticLayerStore, true);
+        m_plot.setCanvas(canvas);
+    }
+
+    // Re-apply canvas background & redraw the plot
+    m_plot.setCanvasBackground(Misc::ThemeManager::instance().base());
+    m_plot.replot();
+}
+
 /**
  * Updates the number of horizontal divisions of the plot
  */
@@ -200,20 +305,59 @@ void Widgets::MultiPlot::updateRange()
     auto group = UI::Dashboard::instance().getMultiplot(m_index);
     for (int i = 0; i < group.datasetCount(); ++i)
     {
-        m_yData.append(PlotData());
+        m_yData.append(UI::PlotBuffer());
         m_yData.last().resize(dash->points());
-        std::fill(m_yData.last().begin(), m_yData.last().end(), 0.0001);
+        m_yData.last().fill(0.0001);
     }
 
-    // Create curve from data
+    // Refresh curve data
+    const int maxPoints = qMax(256, m_plot.canvas()->width() * 2);
+    if (!m_yData.isEmpty())
+        UI::PlotBuffer::binAxis(m_xData, m_yData.first().count(), maxPoints);
     for (int i = 0; i < group.datasetCount(); ++i)
-        if (m_curves.count() > i)
-            m_curves.at(i)->setSamples(dash->xPlotValues(), m_yData[i]);
+        if (m_series.count() > i)
+        {
+            m_yData.at(i).decimate(m_yCurveData[i], maxPoints);
+            m_series.at(i)->invalidate();
+        }
 
     // Repaint widget
     requestRepaint();
 }
 
+/**
+ * Shows/hides the curve associated with the given legend entry. Hidden curves
+ * skip the per-frame decimation & data upload in @c updateData(), so the
+ * re-shown curve is refreshed here before the plot is redrawn.
+ */
+void Widgets::MultiPlot::onLegendChecked(const QVariant &info, bool checked,
+                                         int index)
+{
+    Q_UNUSED(index);
+
+    // Get curve associated with the legend entry
+    auto item = m_plot.infoToItem(info);
+    if (!item)
+        return;
+
+    // Update curve visibility
+    item->setVisible(checked);
+
+    // Refresh the data of the curve, its series may be arbitrarily old
+    const int i = m_curves.indexOf(static_cast<QwtPlotCurve *>(item));
+    if (checked && i >= 0 && m_series.count() > i && m_yData.count() > i)
+    {
+        const int maxPoints = qMax(256, m_plot.canvas()->width() * 2);
+        UI::PlotBuffer::binAxis(m_xData, m_yData.at(i).count(), maxPoints);
+        m_yData.at(i).decimate(m_yCurveData[i], maxPoints);
+        m_series.at(i)->invalidate();
+    }
+
+    // Redraw the plot
+    m_plot.replot();
+    requestRepaint();
+}
+
 #ifdef SERIAL_STUDIO_INCLUDE_MOC
 #    include "moc_MultiPlot.cpp"
 #endif
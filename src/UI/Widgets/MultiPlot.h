@@ -31,6 +31,7 @@
 
 #include <UI/Dashboard.h>
 #include <UI/DashboardWidget.h>
+#include <UI/Widgets/Common/PlotSeriesData.h>
 
 namespace Widgets
 {
@@ -41,16 +42,27 @@ class MultiPlot : public DashboardWidgetBase
 public:
     MultiPlot(const int index = -1);
 
+    QwtPlot *qwtPlot() override;
+
 private Q_SLOTS:
     void updateData();
     void updateRange();
+    void updateCanvas();
+    void onLegendChecked(const QVariant &info, bool checked, int index);
 
 private:
     int m_index;
+    bool m_normalized;
     QwtPlot m_plot;
     QwtLegend m_legend;
     QVBoxLayout m_layout;
     QVector<QwtPlotCurve *> m_curves;
-    QVector<PlotData> m_yData;
+    QVector<UI::PlotBuffer> m_yData;
+
+    // Decimated curve data, the x-axis vector only depends on the sample
+    // count & is shared by all curves of the plot
+    PlotData m_xData;
+    QVector<PlotData> m_yCurveData;
+    QVector<PlotSeriesData *> m_series;
 };
 }
@@ -20,28 +20,128 @@
  * THE SOFTWARE.
  */
 
+#include <QtMath>
+#include <QwtPlotCanvas>
+#include <QwtPlotOpenGLCanvas>
+
 #include <CSV/Player.h>
 #include <UI/Dashboard.h>
+#include <UI/HistoryStore.h>
 #include <UI/Widgets/Plot.h>
+#include <Misc/Clock.h>
 #include <Misc/ThemeManager.h>
 
 /**
- * Constructor function, configures widget style & signal/slot connections.
+ * Returns the history store column that holds the values of the plot widget
+ * with the given relative @a plotIndex, or @c -1 when the column cannot be
+ * resolved. The store keeps one column per dataset in frame order, the plot
+ * family only covers the datasets with the "graph" flag, so the column is
+ * found by walking the current frame with both counters.
+ */
+static int HistoryColumnForPlot(const int plotIndex)
+{
+    int plots = 0;
+    int column = 0;
+    auto &frame = UI::Dashboard::instance().currentFrame();
+    for (int g = 0; g < frame.groupCount(); ++g)
+    {
+        const auto &group = frame.getGroup(g);
+        for (int d = 0; d < group.datasetCount(); ++d)
+        {
+            if (group.getDataset(d).graph())
+            {
+                if (plots == plotIndex)
+                    return column;
+
+                ++plots;
+            }
+
+            ++column;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Minimum interval in milliseconds between two vertical rescales of the same
+ * plot. Recomputing the scale divisions & tick layout is one of the most
+ * expensive parts of the Qwt replot path, limiting the rescale frequency
+ * keeps the cached scale layout alive even when a value wiggles across the
+ * current scale boundary at frame rate.
+ */
+static const qint64 kMinRescaleIntervalMsecs = 500;
+
+/**
+ * Fraction of the vertical axis span that the data must fall below before the
+ * scale shrinks back down. The wide hysteresis band prevents the axes from
+ * thrashing between two adjacent scales when the signal amplitude hovers
+ * around a scale boundary.
+ */
+static const double kShrinkThreshold = 0.4;
+
+/**
+ * Computes the padded axis scale for data in the range [@a min, @a max],
+ * centering the graph vertically & handling the equal/zero corner cases
+ */
+static void PaddedScale(double min, double max, double *outMin, double *outMax)
+{
+    // Get central value
+    double median = qMax<double>(1, (max + min)) / 2;
+    if (max == min)
+        median = max;
+
+    // Center graph verticaly
+    double mostDiff = qMax<double>(qAbs<double>(min), qAbs<double>(max));
+    double newMin = median * (1 - 0.5) - qAbs<double>(median - mostDiff);
+    double newMax = median * (1 + 0.5) + qAbs<double>(median - mostDiff);
+    if (min < 0)
+        newMin = newMax * -1;
+
+    // Fix issues when min & max are equal
+    if (newMin == newMax)
+    {
+        newMax = qAbs<double>(newMax);
+        newMin = newMax * -1;
+    }
+
+    // Fix issues on min = max = (0,0)
+    if (newMin == 0 && newMax == 0)
+    {
+        newMax = 1;
+        newMin = -1;
+    }
+
+    *outMin = newMin;
+    *outMax = newMax;
+}
+
+/**
+ * Constructor function, configures widget style & signal/slot connections. The
+ * dataset-specific configuration lives in @c rebind() so that the widget pool can
+ * recycle this instance for another dataset without re-doing the expensive Qwt
+ * construction work.
  */
 Widgets::Plot::Plot(const int index)
-    : m_index(index)
+    : m_index(-1)
     , m_min(INT_MAX)
     , m_max(INT_MIN)
     , m_autoscale(true)
+    , m_pendingMin(0)
+    , m_pendingMax(0)
+    , m_rescalePending(false)
+    , m_lastRescaleMsecs(0)
+    , m_series(Q_NULLPTR)
+    , m_navigating(false)
+    , m_historyColumn(-1)
+    , m_navigationBase(0)
+    , m_panner(Q_NULLPTR)
+    , m_zoomer(Q_NULLPTR)
 {
     // Get pointers to serial studio modules
     auto dash = &UI::Dashboard::instance();
     auto theme = &Misc::ThemeManager::instance();
 
-    // Invalid index, abort initialization
-    if (m_index < 0 || m_index >= dash->plotCount())
-        return;
-
     // Set window palette
     QPalette palette;
     palette.setColor(QPalette::Base, theme->widgetWindowBackground());
@@ -69,14 +169,109 @@ Widgets::Plot::Plot(const int index)
     auto xAxisEngine = m_plot.axisScaleEngine(QwtPlot::xBottom);
     xAxisEngine->setAttribute(QwtScaleEngine::Floating, true);
 
-    // Create curve from data
-    updateRange();
+    // Bridge the curve to the sample vectors of the widget, the series
+    // references the vectors directly so updating the curve does not copy
+    // the x/y arrays into Qwt anymore
+    m_series = new PlotSeriesData(m_xData, m_yData);
+    m_curve.setData(m_series);
     m_curve.attach(&m_plot);
-    m_plot.replot();
+
+    // Enable the large-curve fast path of Qwt: clip the polyline against the
+    // canvas before painting & weed out the points that map to the same
+    // device pixel, so the render cost tracks the canvas size instead of the
+    // sample count. The surviving points are batched into chunked
+    // QPainter::drawPolyline() calls by the Qwt point mapper.
+    m_curve.setPaintAttribute(QwtPlotCurve::ClipPolygons, true);
+    m_curve.setPaintAttribute(QwtPlotCurve::FilterPoints, true);
+    m_curve.setPaintAttribute(QwtPlotCurve::FilterPointsAggressive, true);
+
+    // Use the OpenGL canvas if hardware acceleration is enabled, otherwise
+    // attach the pan/zoom tools to the default canvas (updateCanvas() takes
+    // care of them when the canvas is replaced)
+    if (dash->hardwareAcceleration())
+        updateCanvas();
+    else
+    {
+        // Cache the static layer of the default canvas in a pixmap so that
+        // data-only repaints just render the curve on top of it
+        auto canvas = qobject_cast<QwtPlotCanvas *>(m_plot.canvas());
+        if (canvas)
+            canvas->setPaintAttribute(QwtPlotCanvas::StaticLayerStore, true);
+
+        rebuildNavigation();
+    }
+
+    // React to dashboard events, plots are updated on the first slice of the
+    // UI interval
+    // clang-format off
+    connect(dash, SIGNAL(updatedSlice0()),
+            this, SLOT(updateData()),
+            Qt::QueuedConnection);
+    connect(dash, SIGNAL(pointsChanged()),
+            this, SLOT(updateRange()),
+            Qt::QueuedConnection);
+    connect(dash, SIGNAL(hardwareAccelerationChanged()),
+            this, SLOT(updateCanvas()));
+    // clang-format on
+
+    // Configure the widget for the given dataset & display it
+    rebind(index);
     m_plot.show();
+}
+
+/**
+ * Plot widgets can be recycled by the widget pool, the per-dataset state is
+ * re-generated by @c rebind().
+ */
+bool Widgets::Plot::supportsRebind() const
+{
+    return true;
+}
+
+/**
+ * Returns the Qwt plot of the widget, used by the snapshot image export.
+ */
+QwtPlot *Widgets::Plot::qwtPlot()
+{
+    return &m_plot;
+}
+
+/**
+ * Re-configures the plot for the dataset with the given relative @a index: curve
+ * color, vertical scale, scale engine & axis titles. Called from the constructor and
+ * every time the widget pool recycles this instance for another dashboard build.
+ */
+void Widgets::Plot::rebind(const int index)
+{
+    // Register new index & reset the autoscale state
+    m_index = index;
+    m_min = INT_MAX;
+    m_max = INT_MIN;
+    m_autoscale = true;
+    m_rescalePending = false;
+    m_lastRescaleMsecs = 0;
+
+    // Leave any history navigation of the previous dataset
+    m_navigating = false;
+    m_historyColumn = -1;
+    if (m_zoomer)
+    {
+        m_zoomer->blockSignals(true);
+        m_zoomer->zoom(0);
+        m_zoomer->blockSignals(false);
+    }
+
+    // Invalid index, abort configuration
+    auto dash = &UI::Dashboard::instance();
+    if (m_index < 0 || m_index >= dash->plotCount())
+        return;
+
+    // Resolve the history store column that backs the pan/zoom navigation
+    m_historyColumn = HistoryColumnForPlot(m_index);
 
     // Get curve color
     QString color;
+    auto theme = &Misc::ThemeManager::instance();
     StringList colors = theme->widgetColors();
     if (colors.count() > m_index)
         color = colors.at(m_index);
@@ -87,7 +282,7 @@ Widgets::Plot::Plot(const int index)
     m_curve.setPen(QColor(color), 2, Qt::SolidLine);
 
     // Update graph scale
-    auto dataset = UI::Dashboard::instance().getPlot(m_index);
+    auto dataset = dash->getPlot(m_index);
     auto max = dataset.max();
     auto min = dataset.min();
     if (max > min)
@@ -98,26 +293,23 @@ Widgets::Plot::Plot(const int index)
         m_plot.setAxisScale(QwtPlot::yLeft, m_min, m_max);
     }
 
-    // Enable logarithmic scale
+    // Select the vertical scale engine, a recycled instance may come from a
+    // dataset with a different (logarithmic/linear) scale
     // clang-format off
     if (dataset.log())
         m_plot.setAxisScaleEngine(QwtPlot::yLeft,
                                   new QwtLogScaleEngine(10));
+    else
+        m_plot.setAxisScaleEngine(QwtPlot::yLeft,
+                                  new QwtLinearScaleEngine());
     // clang-format on
 
     // Set axis titles
     m_plot.setAxisTitle(QwtPlot::xBottom, tr("Samples"));
     m_plot.setAxisTitle(QwtPlot::yLeft, dataset.title());
 
-    // React to dashboard events
-    // clang-format off
-    connect(dash, SIGNAL(updated()),
-            this, SLOT(updateData()),
-            Qt::QueuedConnection);
-    connect(dash, SIGNAL(pointsChanged()),
-            this, SLOT(updateRange()),
-            Qt::QueuedConnection);
-    // clang-format on
+    // Reset the sample vectors & redraw the graph
+    updateRange();
 }
 
 /**
@@ -134,76 +326,247 @@ void Widgets::Plot::updateData()
     if (!isEnabled())
         return;
 
+    // While the user pans/zooms through the history the live view is frozen,
+    // the zoomer resumes live updates when it returns to its base rectangle
+    if (m_navigating)
+        return;
+
     // Get new data
     auto plotData = UI::Dashboard::instance().linearPlotValues();
     if (plotData.count() > m_index)
     {
+        // Decimate the curve to roughly two samples per canvas pixel with
+        // min/max binning, the canvas cannot display more detail anyway and
+        // this keeps the render cost flat regardless of the history depth
+        const int maxPoints = qMax(256, m_plot.canvas()->width() * 2);
+        plotData.at(m_index).decimate(m_xData, m_yData, maxPoints);
+        m_series->invalidate();
+
         // Check if we need to update graph scale
+        bool scaleChanged = false;
         if (m_autoscale)
         {
-            // Scan new values to see if chart should be updated
-            bool changed = false;
-            for (int i = 0; i < plotData.at(m_index).count(); ++i)
+            // Scan the extrema of the displayed values, the min/max binning
+            // of the decimator preserves the extrema of the full history
+            double dataMin = m_yData.isEmpty() ? 0 : m_yData.first();
+            double dataMax = dataMin;
+            for (int i = 1; i < m_yData.count(); ++i)
+            {
+                const auto v = m_yData.at(i);
+                if (v > dataMax)
+                    dataMax = v;
+                if (v < dataMin)
+                    dataMin = v;
+            }
+
+            // The scale must grow when the data leaves the current axis
+            // range & may shrink back once the data occupies less than the
+            // hysteresis fraction of the axis span
+            const bool grow = dataMax > m_max || dataMin < m_min;
+            const bool shrink = !grow && m_max > m_min
+                                && (dataMax - dataMin)
+                                       < (m_max - m_min) * kShrinkThreshold;
+
+            // Register the scale that the axis should eventually show
+            if (grow || shrink)
             {
-                auto v = plotData.at(m_index).at(i);
-                if (v > m_max)
-                {
-                    m_max = v + 1;
-                    changed = true;
-                }
-
-                if (v < m_min)
-                {
-                    m_min = v - 1;
-                    changed = true;
-                }
+                PaddedScale(dataMin - 1, dataMax + 1, &m_pendingMin,
+                            &m_pendingMax);
+                m_rescalePending
+                    = (m_pendingMin != m_min) || (m_pendingMax != m_max);
             }
 
-            // Update graph scale
-            if (changed)
+            // Apply the pending scale, at most once per rescale interval so
+            // that the cached scale divisions & tick layout survive between
+            // rescales instead of being recomputed at frame rate
+            const auto now = Misc::Clock::instance().currentMSecsSinceEpoch();
+            if (m_rescalePending
+                && (now - m_lastRescaleMsecs >= kMinRescaleIntervalMsecs
+                    || m_min > m_max))
             {
-                // Get central value
-                double median = qMax<double>(1, (m_max + m_min)) / 2;
-                if (m_max == m_min)
-                    median = m_max;
-
-                // Center graph verticaly
-                double mostDiff = qMax<double>(qAbs<double>(m_min), qAbs<double>(m_max));
-                double min = median * (1 - 0.5) - qAbs<double>(median - mostDiff);
-                double max = median * (1 + 0.5) + qAbs<double>(median - mostDiff);
-                if (m_min < 0)
-                    min = max * -1;
-
-                // Fix issues when min & max are equal
-                if (min == max)
-                {
-                    max = qAbs<double>(max);
-                    min = max * -1;
-                }
-
-                // Fix issues on min = max = (0,0)
-                if (min == 0 && max == 0)
-                {
-                    max = 1;
-                    min = -1;
-                }
-
-                // Update axis scale
-                m_max = max;
-                m_min = min;
+                m_min = m_pendingMin;
+                m_max = m_pendingMax;
+                m_lastRescaleMsecs = now;
+                m_rescalePending = false;
+                scaleChanged = true;
                 m_plot.setAxisScale(m_plot.yLeft, m_min, m_max);
             }
         }
 
-        // Replot graph
-        m_curve.setSamples(plotData.at(m_index));
-        m_plot.replot();
+        // Replot graph, when the axis scales did not change we only repaint
+        // the canvas contents & skip the axis/layout update work of a full
+        // QwtPlot::replot() call
+        auto canvas = qobject_cast<QwtPlotCanvas *>(m_plot.canvas());
+        if (scaleChanged || !canvas)
+            m_plot.replot();
+        else
+            canvas->replot();
+
+        // Keep the zoom base in sync with the live view, so that the first
+        // zoom of the user starts from what is currently on screen
+        if (m_zoomer)
+            m_zoomer->setZoomBase(false);
 
         // Repaint widget
         requestRepaint();
     }
 }
 
+/**
+ * Replaces the canvas of the plot with an OpenGL-accelerated canvas when the
+ * user enables hardware acceleration (& with the default software-rasterized
+ * canvas when the user disables it).
+ */
+void Widgets::Plot::updateCanvas()
+{
+    // Select the appropiate canvas for the current settings, the software
+    // canvas caches the static layer (background & frame) in a pixmap so
+    // that data-only repaints just render the curve on top of it
+    if (UI::Dashboard::instance().hardwareAcceleration())
+        m_plot.setCanvas(new QwtPlotOpenGLCanvas(&m_plot));
+    else
+    {
+        auto canvas = new QwtPlotCanvas(&m_plot);
+        canvas->setPaintAttribute(QwtPlotCanvas::StaticLayerStore, true);
+        m_plot.setCanvas(canvas);
+    }
+
+    // Re-apply canvas background & redraw the plot
+    m_plot.setCanvasBackground(Misc::ThemeManager::instance().base());
+    m_plot.replot();
+
+    // The pan/zoom tools died with the previous canvas, re-create them
+    rebuildNavigation();
+}
+
+/**
+ * (Re)creates the pan/zoom tools on the current plot canvas. The tools are
+ * children of the canvas widget & are destroyed with it whenever
+ * @c updateCanvas() swaps the canvas, so they cannot be created once in the
+ * constructor.
+ *
+ * The zoomer owns the left mouse button (rubber-band zoom, right click to
+ * zoom back out), the panner uses middle-button drags.
+ */
+void Widgets::Plot::rebuildNavigation()
+{
+    auto canvas = m_plot.canvas();
+    if (!canvas)
+        return;
+
+    m_zoomer = new QwtPlotZoomer(canvas, false);
+    m_zoomer->setTrackerMode(QwtPicker::AlwaysOff);
+    m_panner = new QwtPlotPanner(canvas);
+    m_panner->setMouseButton(Qt::MiddleButton);
+    connect(m_zoomer, &QwtPlotZoomer::zoomed, this, &Widgets::Plot::onZoomed);
+    connect(m_panner, &QwtPlotPanner::panned, this, &Widgets::Plot::onPanned);
+    m_navigating = false;
+}
+
+/**
+ * Freezes the live view & records which global history sample the left edge
+ * of the frozen view corresponds to, so that the x axis coordinates of the
+ * zoomed/panned views can be mapped to history store samples.
+ */
+void Widgets::Plot::beginNavigation()
+{
+    // Replicate the per-dataset plot depth logic of the dashboard
+    auto dash = &UI::Dashboard::instance();
+    int points = dash->points();
+    if (m_index >= 0 && m_index < dash->plotCount())
+    {
+        const auto dataset = dash->getPlot(m_index);
+        if (dataset.plotPoints() > 0)
+            points = dataset.plotPoints();
+    }
+
+    // The live view always shows the newest samples of the history
+    m_navigating = true;
+    m_navigationBase = qMax<qint64>(
+        0, UI::HistoryStore::instance().totalSampleCount() - points);
+}
+
+/**
+ * Redraws the curve with the history samples that fall inside the currently
+ * visible x axis interval. The data is fetched from the min/max decimation
+ * pyramid of the history store, so the cost of this function only depends on
+ * the canvas width, never on the size of the visible range.
+ */
+void Widgets::Plot::renderHistoryView()
+{
+    // History column could not be resolved, nothing to show
+    if (m_historyColumn < 0)
+        return;
+
+    // Map the visible axis interval to global history sample indices
+    const auto interval = m_plot.axisScaleDiv(QwtPlot::xBottom).interval();
+    const qint64 first
+        = m_navigationBase + qint64(qFloor(interval.minValue()));
+    const qint64 last
+        = m_navigationBase + qint64(qCeil(interval.maxValue())) + 1;
+
+    // Fetch a canvas-width-bounded view of the range & shift the x values
+    // back into axis coordinates
+    const int maxPoints = qMax(256, m_plot.canvas()->width() * 2);
+    UI::HistoryStore::instance().decimate(m_historyColumn, first, last,
+                                          maxPoints, m_xData, m_yData);
+    for (int i = 0; i < m_xData.count(); ++i)
+        m_xData[i] -= m_navigationBase;
+
+    // Redraw the curve
+    m_series->invalidate();
+    m_plot.replot();
+    requestRepaint();
+}
+
+/**
+ * Invoked when the user pans the plot, enters history navigation (when not
+ * navigating already) & redraws the curve for the new visible range
+ */
+void Widgets::Plot::onPanned(int dx, int dy)
+{
+    Q_UNUSED(dx)
+    Q_UNUSED(dy)
+
+    if (!m_navigating)
+        beginNavigation();
+
+    renderHistoryView();
+}
+
+/**
+ * Invoked when the zoom stack of the plot changes. Zooming into the plot
+ * enters history navigation, returning to the base rectangle (right click)
+ * resumes the live view.
+ */
+void Widgets::Plot::onZoomed(const QRectF &rect)
+{
+    Q_UNUSED(rect)
+
+    // Back at the base rectangle, restore the vertical scale & resume the
+    // live view
+    if (m_zoomer->zoomRectIndex() == 0)
+    {
+        m_navigating = false;
+        if (m_min <= m_max)
+            m_plot.setAxisScale(QwtPlot::yLeft, m_min, m_max);
+        else
+            m_plot.setAxisAutoScale(QwtPlot::yLeft);
+
+        m_plot.setAxisAutoScale(QwtPlot::xBottom);
+        updateData();
+    }
+
+    // Zoomed into the plot, render the selected history range
+    else
+    {
+        if (!m_navigating)
+            beginNavigation();
+
+        renderHistoryView();
+    }
+}
+
 /**
  * Updates the number of horizontal divisions of the plot
  */
@@ -212,14 +575,17 @@ void Widgets::Plot::updateRange()
     // Get pointer to dashboard manager
     auto dash = &UI::Dashboard::instance();
 
-    // Clear Y-axis data
-    PlotData tempYData;
-    tempYData.reserve(dash->points());
+    // Clear X/Y axis data
+    m_xData.resize(dash->points());
+    m_yData.resize(dash->points());
     for (int i = 0; i < dash->points(); ++i)
-        tempYData.append(0);
+    {
+        m_xData[i] = i;
+        m_yData[i] = 0;
+    }
 
     // Redraw graph
-    m_curve.setSamples(dash->xPlotValues(), tempYData);
+    m_series->invalidate();
     m_plot.replot();
 
     // Repaint widget
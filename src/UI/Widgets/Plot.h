@@ -26,8 +26,11 @@
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QwtPlotCurve>
+#include <QwtPlotPanner>
+#include <QwtPlotZoomer>
 #include <QwtScaleEngine>
 #include <UI/DashboardWidget.h>
+#include <UI/Widgets/Common/PlotSeriesData.h>
 
 namespace Widgets
 {
@@ -38,9 +41,21 @@ class Plot : public DashboardWidgetBase
 public:
     Plot(const int index = -1);
 
+    bool supportsRebind() const override;
+    void rebind(const int index) override;
+    QwtPlot *qwtPlot() override;
+
 private Q_SLOTS:
     void updateData();
     void updateRange();
+    void updateCanvas();
+    void onPanned(int dx, int dy);
+    void onZoomed(const QRectF &rect);
+
+private:
+    void beginNavigation();
+    void rebuildNavigation();
+    void renderHistoryView();
 
 private:
     int m_index;
@@ -48,6 +63,22 @@ private:
     double m_max;
     bool m_autoscale;
 
+    // Deferred autoscale state, scale changes are rate-limited so that the
+    // cached axis layout survives between rescales
+    double m_pendingMin;
+    double m_pendingMax;
+    bool m_rescalePending;
+    qint64 m_lastRescaleMsecs;
+    PlotData m_xData;
+    PlotData m_yData;
+    PlotSeriesData *m_series;
+
+    bool m_navigating;
+    int m_historyColumn;
+    qint64 m_navigationBase;
+    QwtPlotPanner *m_panner;
+    QwtPlotZoomer *m_zoomer;
+
     QwtPlot m_plot;
     QwtPlotCurve m_curve;
     QVBoxLayout m_layout;
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <QPainter>
+#include <QPaintEvent>
+
+#include <UI/Dashboard.h>
+#include <Misc/TimerEvents.h>
+#include <Misc/ThemeManager.h>
+#include <Misc/ThreadPolicy.h>
+#include <UI/Widgets/Spectrogram.h>
+#include <UI/Widgets/Common/FFTPlanCache.h>
+
+/*
+ * Number of spectra kept by the waterfall, at the fixed 10 Hz analysis rate
+ * this amounts to roughly half a minute of spectral history
+ */
+static const int kHistoryRows = 256;
+
+/*
+ * Number of entries of the magnitude -> color lookup table
+ */
+static const int kColorTableSize = 256;
+
+/**
+ * Constructor function, configures widget style, allocates the row-ring
+ * history image & sets up the FFT worker thread.
+ */
+Widgets::Spectrogram::Spectrogram(const int index)
+    : m_size(0)
+    , m_index(index)
+    , m_busy(false)
+    , m_row(0)
+    , m_sampleIndex(0)
+    , m_worker(Q_NULLPTR)
+{
+    // Get pointers to serial studio modules
+    auto dash = &UI::Dashboard::instance();
+    auto theme = &Misc::ThemeManager::instance();
+
+    // Invalid index, abort initialization
+    if (m_index < 0 || m_index >= dash->spectrogramCount())
+        return;
+
+    // Set window palette
+    QPalette palette;
+    palette.setColor(QPalette::Base, theme->widgetWindowBackground());
+    palette.setColor(QPalette::Window, theme->widgetWindowBackground());
+    setPalette(palette);
+
+    // Get dataset FFT window size & ensure that it is valid, the plan cache
+    // validates the size arithmetically instead of probing transformer tables
+    auto dataset = dash->getSpectrogram(m_index);
+    m_size = FFTPlanCache::instance().validSize(dataset.fftSamples());
+
+    // Initialize sample window buffers
+    m_samples[0].resize(m_size);
+    m_samples[1].resize(m_size);
+    m_samples[0].fill(0);
+    m_samples[1].fill(0);
+
+    // Generate the magnitude -> color lookup table, low magnitudes fade into
+    // the plot background & high magnitudes into the curve color of the widget
+    QString color;
+    const StringList colors = theme->widgetColors();
+    if (colors.count() > m_index)
+        color = colors.at(m_index);
+    else
+        color = colors.at(colors.count() % m_index);
+    const QColor hot = QColor(color);
+    const QColor cold = theme->base();
+    m_colorTable.resize(kColorTableSize);
+    for (int i = 0; i < kColorTableSize; ++i)
+    {
+        const qreal t = qreal(i) / (kColorTableSize - 1);
+        // clang-format off
+        m_colorTable[i] = qRgb(cold.red()   + t * (hot.red()   - cold.red()),
+                               cold.green() + t * (hot.green() - cold.green()),
+                               cold.blue()  + t * (hot.blue()  - cold.blue()));
+        // clang-format on
+    }
+
+    // Allocate the row-ring history image, one row per spectrum & one column
+    // per frequency bin. New spectra only ever write their own row, the
+    // waterfall scroll happens in paintEvent() by shifting source coordinates.
+    const int bins = qMax(8, m_size / 2) / 2 + 1;
+    m_history = QImage(bins, kHistoryRows, QImage::Format_RGB32);
+    m_history.fill(cold);
+
+    // Register the sample vector type for queued signal/slot connections
+    qRegisterMetaType<QVector<float>>("QVector<float>");
+
+    // Move the FFT worker to a dedicated thread, the transform must never block
+    // the GUI thread
+    // clang-format off
+    m_worker = new FFTWorker(m_size);
+    m_worker->moveToThread(&m_workerThread);
+    connect(&m_workerThread, &QThread::finished,
+            m_worker, &QObject::deleteLater);
+    connect(this, &Spectrogram::samplesReady,
+            m_worker, &FFTWorker::transform,
+            Qt::QueuedConnection);
+    connect(m_worker, &FFTWorker::spectrumReady,
+            this, &Spectrogram::appendSpectrum,
+            Qt::QueuedConnection);
+    // clang-format on
+    Misc::ThreadPolicy::instance().startThread(m_workerThread, m_worker, "fft",
+                                               QThread::InheritPriority);
+
+    // Compute a new spectrum row at the fixed analysis rate of the FFT plots,
+    // the waterfall advances by one row per finished transform
+    // clang-format off
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout10Hz,
+            this, &Spectrogram::updateData);
+    // clang-format on
+}
+
+/**
+ * Destructor function, stops the FFT worker thread
+ */
+Widgets::Spectrogram::~Spectrogram()
+{
+    m_workerThread.quit();
+    m_workerThread.wait();
+}
+
+/**
+ * Draws the waterfall by blitting the two sub-rectangles of the row-ring
+ * image that surround the write cursor, which scrolls the display without
+ * ever moving the stored rows (the repaint itself only runs at the UI rate,
+ * appending spectra stays a one-row write).
+ */
+void Widgets::Spectrogram::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    // Widget not initialized, paint the background only
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().color(QPalette::Window));
+    if (m_history.isNull())
+        return;
+
+    // Calculate the display rectangle, margins match the other plot widgets
+    const QRect view = rect().adjusted(24, 24, -24, -24);
+    if (view.isEmpty())
+        return;
+
+    // Rows [m_row, kHistoryRows) are older than rows [0, m_row), draw the old
+    // section on top so that time increases towards the bottom of the widget
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    const int oldRows = kHistoryRows - m_row;
+    const qreal rowHeight = qreal(view.height()) / kHistoryRows;
+    const QRectF oldTarget(view.x(), view.y(), view.width(), oldRows * rowHeight);
+    const QRectF newTarget(view.x(), view.y() + oldRows * rowHeight, view.width(),
+                           m_row * rowHeight);
+    painter.drawImage(oldTarget, m_history,
+                      QRectF(0, m_row, m_history.width(), oldRows));
+    if (m_row > 0)
+        painter.drawImage(newTarget, m_history,
+                          QRectF(0, 0, m_history.width(), m_row));
+}
+
+/**
+ * Checks if the widget is enabled, if so, the widget shall be updated
+ * to display the latest data frame.
+ *
+ * The transform itself runs on the worker thread, this function only copies
+ * the current sample window & dispatches it to the worker. While the worker
+ * is busy new windows are skipped, the dashboard keeps the full sample
+ * history so the next dispatch transforms a complete window anyway.
+ */
+void Widgets::Spectrogram::updateData()
+{
+    // Verify that the worker is valid & idle
+    if (!m_worker || m_busy)
+        return;
+
+    // Widget not enabled, do not dispatch a new window to the worker
+    if (!isEnabled())
+        return;
+
+    // Dispatch the current sample window to the worker thread
+    auto plotData = UI::Dashboard::instance().spectrogramPlotValues();
+    if (plotData.count() > m_index)
+    {
+        // Copy samples into the buffer that is not referenced by the worker
+        auto &samples = m_samples[m_sampleIndex];
+        m_sampleIndex = (m_sampleIndex + 1) & 1;
+        const auto &data = plotData.at(m_index);
+        for (int i = 0; i < m_size; ++i)
+            samples[i] = static_cast<float>(data.sampleAt(i));
+
+        // Wake up the worker thread
+        m_busy = true;
+        Q_EMIT samplesReady(samples);
+    }
+}
+
+/**
+ * Writes the finished @a spectrum computed by the worker thread into the
+ * current row of the history image, advances the write cursor & redraws the
+ * widget. This is the only per-spectrum pixel work of the waterfall, the
+ * already-stored rows are never touched.
+ */
+void Widgets::Spectrogram::appendSpectrum(const QVector<float> &spectrum)
+{
+    // Worker is idle again
+    m_busy = false;
+
+    // Map every frequency bin magnitude to a color of the lookup table, the
+    // magnitudes are averaged bin values in the [0, 1] range (same scale as
+    // the y-axis of the FFT plot widget)
+    const int bins = qMin(int(spectrum.count()), m_history.width());
+    QRgb *row = reinterpret_cast<QRgb *>(m_history.scanLine(m_row));
+    for (int i = 0; i < bins; ++i)
+    {
+        const int v = qBound(0.0f, spectrum[i], 1.0f) * (kColorTableSize - 1);
+        row[i] = m_colorTable.at(v);
+    }
+
+    // Advance the ring cursor & request a repaint on the next UI tick
+    m_row = (m_row + 1) % kHistoryRows;
+    requestRepaint();
+}
+
+#ifdef SERIAL_STUDIO_INCLUDE_MOC
+#    include "moc_Spectrogram.cpp"
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020-2021 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QWidget>
+#include <QThread>
+
+#include <UI/DashboardWidget.h>
+#include <UI/Widgets/FFTPlot.h>
+
+namespace Widgets
+{
+/**
+ * @brief The Spectrogram class
+ *
+ * Waterfall display of the spectral history of a dataset. The spectra are
+ * computed by a @c FFTWorker on a dedicated thread (exactly like the FFT plot
+ * widget), and every finished spectrum is written into a single row of a
+ * row-ring image. Scrolling is done by shifting the source coordinates of the
+ * two blits that compose the waterfall, so appending a spectrum never moves
+ * or re-writes the rows that are already stored.
+ */
+class Spectrogram : public DashboardWidgetBase
+{
+    Q_OBJECT
+
+Q_SIGNALS:
+    void samplesReady(const QVector<float> &samples);
+
+public:
+    Spectrogram(const int index = -1);
+    ~Spectrogram();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private Q_SLOTS:
+    void updateData();
+    void appendSpectrum(const QVector<float> &spectrum);
+
+private:
+    int m_size;
+    int m_index;
+    bool m_busy;
+
+    int m_row;
+    QImage m_history;
+    QVector<QRgb> m_colorTable;
+
+    int m_sampleIndex;
+    QVector<float> m_samples[2];
+    QThread m_workerThread;
+    FFTWorker *m_worker;
+};
+}
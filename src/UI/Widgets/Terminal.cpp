@@ -20,7 +20,6 @@
  * THE SOFTWARE.
  */
 
-#include <QtMath>
 #include <QScrollBar>
 
 #include <IO/Console.h>
@@ -28,8 +27,21 @@
 #include <Misc/ThemeManager.h>
 #include <UI/Widgets/Terminal.h>
 
+/**
+ * Ingest rate (in characters per second) above which console rendering is
+ * paused. Capture into the @c IO::Console ring continues losslessly while
+ * the display is frozen, so nothing is dropped.
+ */
+static const qint64 kPauseThresholdChars = 512 * 1024;
+
+/**
+ * Ingest rate (in characters per second) below which a paused console
+ * automatically resumes & re-synchronizes with the tail of the capture ring.
+ */
+static const qint64 kResumeThresholdChars = 64 * 1024;
+
 //----------------------------------------------------------------------------------------
-// QML PlainTextEdit implementation
+// QML console widget implementation
 //----------------------------------------------------------------------------------------
 
 /**
@@ -37,20 +49,29 @@
  */
 Widgets::Terminal::Terminal(QQuickItem *parent)
     : UI::DeclarativeWidget(parent)
+    , m_scrollbackBlockCount(0)
     , m_repaint(false)
+    , m_readOnly(true)
     , m_autoscroll(true)
     , m_textChanged(false)
     , m_emulateVt100(false)
     , m_copyAvailable(false)
+    , m_centerOnScroll(false)
+    , m_undoRedoEnabled(false)
+    , m_wordWrapMode(0)
+    , m_paused(false)
+    , m_ingestChars(0)
+    , m_capturedChars(0)
+    , m_newLineCount(0)
+    , m_announcedLineCount(0)
 {
     // Set widget & configure VT-100 emulator
-    setWidget(&m_textEdit);
-    m_escapeCodeHandler.setTextEdit(&m_textEdit);
+    setWidget(&m_view);
+    m_escapeCodeHandler.setView(&m_view);
 
     // Setup default options
     setScrollbarWidth(14);
-    m_textEdit.setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    m_textEdit.setSizeAdjustPolicy(QPlainTextEdit::AdjustToContents);
+    m_view.setScrollBarVisible(false);
 
     // Set widget palette
     QPalette palette;
@@ -64,7 +85,7 @@ Widgets::Terminal::Terminal(QQuickItem *parent)
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
     palette.setColor(QPalette::PlaceholderText, theme->consolePlaceholderText());
 #endif
-    m_textEdit.setPalette(palette);
+    m_view.setPalette(palette);
 
     // Connect signals/slots
     // clang-format off
@@ -72,42 +93,46 @@ Widgets::Terminal::Terminal(QQuickItem *parent)
             this, &Widgets::Terminal::insertText);
     connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout10Hz,
             this, &Widgets::Terminal::repaint);
+    connect(&Misc::TimerEvents::instance(), &Misc::TimerEvents::timeout1Hz,
+            this, &Widgets::Terminal::evaluateIngestRate);
     // clang-format on
 
     // React to widget events
-    connect(&m_textEdit, SIGNAL(copyAvailable(bool)), this, SLOT(setCopyAvailable(bool)));
+    connect(&m_view, SIGNAL(copyAvailable(bool)), this, SLOT(setCopyAvailable(bool)));
 }
 
 /**
- * Returns the font used by the QPlainTextEdit widget
+ * Returns the font used by the console view
  */
 QFont Widgets::Terminal::font() const
 {
-    return m_textEdit.font();
+    return m_view.font();
 }
 
 /**
- * Returns the plain text of the QPlainTextEdit widget
+ * Returns the plain text retained by the console view
  */
 QString Widgets::Terminal::text() const
 {
-    return m_textEdit.toPlainText();
+    return m_view.text();
 }
 
 /**
- * Returns @c true if the text document is empty
+ * Returns @c true if the console view is empty
  */
 bool Widgets::Terminal::empty() const
 {
-    return m_textEdit.document()->isEmpty();
+    return m_view.empty();
 }
 
 /**
- * Returns @c true if the widget is set to read-only
+ * Returns @c true if the widget is set to read-only. The console view itself
+ * is always an output-only device, the flag only mirrors what the QML layer
+ * configured.
  */
 bool Widgets::Terminal::readOnly() const
 {
-    return m_textEdit.isReadOnly();
+    return m_readOnly;
 }
 
 /**
@@ -120,20 +145,21 @@ bool Widgets::Terminal::autoscroll() const
 }
 
 /**
- * Returns the palette used by the QPlainTextEdit widget
+ * Returns the palette used by the console view
  */
 QPalette Widgets::Terminal::palette() const
 {
-    return m_textEdit.palette();
+    return m_view.palette();
 }
 
 /**
- * Returns the wrap mode of the QPlainTextEdit casted to an integer type (so that it
- * can be used from the QML interface).
+ * Returns the wrap mode configured by the QML layer. The console view always
+ * wraps text at the column count of its character grid, the value is only
+ * stored for API compatibility.
  */
 int Widgets::Terminal::wordWrapMode() const
 {
-    return static_cast<int>(m_textEdit.wordWrapMode());
+    return m_wordWrapMode;
 }
 
 /**
@@ -141,12 +167,12 @@ int Widgets::Terminal::wordWrapMode() const
  */
 int Widgets::Terminal::scrollbarWidth() const
 {
-    return m_textEdit.verticalScrollBar()->width();
+    return m_view.scrollBar()->width();
 }
 
 /**
  * Returns @c true if the user is able to copy any text from the document. This value is
- * updated through the copyAvailable() signal sent by the QPlainTextEdit.
+ * updated through the copyAvailable() signal sent by the console view.
  */
 bool Widgets::Terminal::copyAvailable() const
 {
@@ -154,22 +180,20 @@ bool Widgets::Terminal::copyAvailable() const
 }
 
 /**
- * Returns @c true if the QPlainTextEdit widget is enabled
+ * Returns @c true if the console view widget is enabled
  */
 bool Widgets::Terminal::widgetEnabled() const
 {
-    return m_textEdit.isEnabled();
+    return m_view.isEnabled();
 }
 
 /**
- * If set to true, the plain text edit scrolls the document vertically to make the cursor
- * visible at the center of the viewport. This also allows the text edit to scroll below
- * the end of the document. Otherwise, if set to false, the plain text edit scrolls the
- * smallest amount possible to ensure the cursor is visible.
+ * Returns the center-on-scroll flag configured by the QML layer, the value
+ * has no effect on the console view & is only stored for API compatibility.
  */
 bool Widgets::Terminal::centerOnScroll() const
 {
-    return m_textEdit.centerOnScroll();
+    return m_centerOnScroll;
 }
 
 /**
@@ -182,47 +206,48 @@ bool Widgets::Terminal::vt100emulation() const
 }
 
 /**
- * This property holds whether undo and redo are enabled.
- * Users are only able to undo or redo actions if this property is true, and if there is
- * an action that can be undone (or redone).
+ * Returns the undo/redo flag configured by the QML layer, the console view
+ * is not editable so the value is only stored for API compatibility.
  */
 bool Widgets::Terminal::undoRedoEnabled() const
 {
-    return m_textEdit.isUndoRedoEnabled();
+    return m_undoRedoEnabled;
 }
 
 /**
- * This property holds the limit for blocks in the document.
+ * This property holds the limit for lines in the console view.
  *
- * Specifies the maximum number of blocks the document may have. If there are more blocks
- * in the document that specified with this property blocks are removed from the beginning
- * of the document.
+ * Specifies the maximum number of lines the view may retain. If more lines are
+ * appended, lines are removed from the beginning of the view.
  *
- * A negative or zero value specifies that the document may contain an unlimited amount
- * of blocks.
+ * A negative or zero value specifies that the view may retain an unlimited
+ * amount of lines.
  */
 int Widgets::Terminal::maximumBlockCount() const
 {
-    return m_textEdit.maximumBlockCount();
+    return m_view.maximumLineCount();
 }
 
 /**
- * This property holds the editor placeholder text.
+ * This property holds the placeholder text.
  *
- * Setting this property makes the editor display a grayed-out placeholder text as long as
- * the document is empty.
+ * Setting this property makes the view display a grayed-out placeholder text as
+ * long as it is empty.
  */
 QString Widgets::Terminal::placeholderText() const
 {
-    return m_textEdit.placeholderText();
+    return m_view.placeholderText();
 }
 
 /**
- * Returns the pointer to the text document
+ * Returns the number of lines that arrived while the user was scrolled back
+ * in the view. Layout of the arriving text is suspended while the user
+ * inspects earlier output, the QML layer displays the counter & jumping back
+ * to the tail re-synchronizes the view with the @c IO::Console capture ring.
  */
-QTextDocument *Widgets::Terminal::document() const
+int Widgets::Terminal::newLineCount() const
 {
-    return m_textEdit.document();
+    return m_newLineCount;
 }
 
 /**
@@ -230,25 +255,36 @@ QTextDocument *Widgets::Terminal::document() const
  */
 void Widgets::Terminal::copy()
 {
-    m_textEdit.copy();
+    m_view.copy();
 }
 
 /**
- * Deletes all the text in the text edit.
+ * Deletes all the text in the console view.
  */
 void Widgets::Terminal::clear()
 {
-    m_textEdit.clear();
+    restoreMaximumBlockCount();
+
+    m_pendingText.clear();
+    m_view.clear();
     updateScrollbarVisibility();
     requestRepaint(true);
+
+    // Nothing left to jump to
+    if (m_newLineCount > 0)
+    {
+        m_newLineCount = 0;
+        m_announcedLineCount = 0;
+        Q_EMIT newLineCountChanged();
+    }
 }
 
 /**
- * Selects all the text of the text edit.
+ * Selects all the text of the console view.
  */
 void Widgets::Terminal::selectAll()
 {
-    m_textEdit.selectAll();
+    m_view.selectAll();
     requestRepaint();
 }
 
@@ -257,33 +293,29 @@ void Widgets::Terminal::selectAll()
  */
 void Widgets::Terminal::clearSelection()
 {
-    auto cursor = QTextCursor(m_textEdit.document());
-    cursor.clearSelection();
-    m_textEdit.setTextCursor(cursor);
+    m_view.clearSelection();
     updateScrollbarVisibility();
     requestRepaint();
 }
 
 /**
- * Changes the read-only state of the text edit.
- *
- * In a read-only text edit the user can only navigate through the text and select text;
- * modifying the text is not possible.
+ * Changes the read-only state of the widget. The console view is always an
+ * output-only device, so the flag is only stored.
  */
 void Widgets::Terminal::setReadOnly(const bool ro)
 {
-    m_textEdit.setReadOnly(ro);
+    m_readOnly = ro;
     requestRepaint();
 
     Q_EMIT readOnlyChanged();
 }
 
 /**
- * Changes the font used to display the text of the text edit.
+ * Changes the font used to display the text of the console view.
  */
 void Widgets::Terminal::setFont(const QFont &font)
 {
-    m_textEdit.setFont(font);
+    m_view.setFont(font);
     updateScrollbarVisibility();
     requestRepaint();
 
@@ -291,14 +323,14 @@ void Widgets::Terminal::setFont(const QFont &font)
 }
 
 /**
- * Appends a new paragraph with text to the end of the text edit.
+ * Appends a new paragraph with text to the end of the console view.
  *
  * If @c autoscroll() is enabled, this function shall also update the scrollbar position
  * to scroll to the bottom of the text.
  */
 void Widgets::Terminal::append(const QString &text)
 {
-    m_textEdit.appendPlainText(text);
+    m_view.append(text + QStringLiteral("\n"));
     updateScrollbarVisibility();
 
     if (autoscroll())
@@ -308,14 +340,15 @@ void Widgets::Terminal::append(const QString &text)
 }
 
 /**
- * Replaces the text of the text editor with @c text.
+ * Replaces the text of the console view with @c text.
  *
  * If @c autoscroll() is enabled, this function shall also update the scrollbar position
  * to scroll to the bottom of the text.
  */
 void Widgets::Terminal::setText(const QString &text)
 {
-    m_textEdit.setPlainText(text);
+    m_view.clear();
+    m_view.append(text);
     updateScrollbarVisibility();
 
     if (autoscroll())
@@ -329,30 +362,29 @@ void Widgets::Terminal::setText(const QString &text)
  */
 void Widgets::Terminal::setScrollbarWidth(const int width)
 {
-    auto bar = m_textEdit.verticalScrollBar();
-    bar->setFixedWidth(width);
+    m_view.scrollBar()->setFixedWidth(width);
     requestRepaint();
 
     Q_EMIT scrollbarWidthChanged();
 }
 
 /**
- * Changes the @c QPalette of the text editor widget and its children.
+ * Changes the @c QPalette of the console view.
  */
 void Widgets::Terminal::setPalette(const QPalette &palette)
 {
-    m_textEdit.setPalette(palette);
+    m_view.setPalette(palette);
     requestRepaint();
 
     Q_EMIT colorPaletteChanged();
 }
 
 /**
- * Enables or disables the text editor widget.
+ * Enables or disables the console view widget.
  */
 void Widgets::Terminal::setWidgetEnabled(const bool enabled)
 {
-    m_textEdit.setEnabled(enabled);
+    m_view.setEnabled(enabled);
     requestRepaint();
 
     Q_EMIT widgetEnabledChanged();
@@ -360,18 +392,35 @@ void Widgets::Terminal::setWidgetEnabled(const bool enabled)
 
 /**
  * Enables/disable automatic scrolling. If automatic scrolling is enabled, then the
- * vertical scrollbar shall automatically scroll to the end of the document when the
- * text of the text editor is changed.
+ * vertical scrollbar shall automatically scroll to the end of the view when the
+ * text of the console is changed.
  */
 void Widgets::Terminal::setAutoscroll(const bool enabled)
 {
     // Change internal variables
     m_autoscroll = enabled;
+    m_view.setAutoscroll(enabled);
     updateScrollbarVisibility();
 
-    // Scroll to bottom if autoscroll is enabled
+    // Scroll to bottom if autoscroll is enabled & return to the live sliding
+    // window if the complete scrollback was paged into the view
     if (enabled)
+    {
+        restoreMaximumBlockCount();
+
+        // Text arrived while the user was scrolled back & its layout was
+        // suspended, re-synchronize the view with the tail of the capture
+        // ring before jumping to it
+        if (m_newLineCount > 0)
+        {
+            m_newLineCount = 0;
+            m_announcedLineCount = 0;
+            setText(IO::Console::instance().text());
+            Q_EMIT newLineCountChanged();
+        }
+
         scrollToBottom(true);
+    }
 
     // Update console configuration
     IO::Console::instance().setAutoscroll(enabled);
@@ -382,22 +431,71 @@ void Widgets::Terminal::setAutoscroll(const bool enabled)
 }
 
 /**
- * Inserts the given @a text directly, no additional line breaks added.
+ * Loads the complete text retained by the @c IO::Console scrollback buffer into the
+ * console view, which lets the user inspect output that was already dropped from
+ * the sliding window of the widget.
+ *
+ * The line count limit of the view is lifted while the scrollback is displayed,
+ * it is restored when the user re-enables autoscroll or clears the console.
+ */
+void Widgets::Terminal::loadScrollback()
+{
+    // Lift the line count limit, the scrollback buffer may retain more lines
+    // than the sliding window of the view allows
+    if (maximumBlockCount() > 0)
+    {
+        m_scrollbackBlockCount = maximumBlockCount();
+        m_view.setMaximumLineCount(0);
+    }
+
+    // Replace the view contents with the retained text, which includes any
+    // lines that were counted instead of laid out while scrolled back
+    setText(IO::Console::instance().text());
+    if (m_newLineCount > 0)
+    {
+        m_newLineCount = 0;
+        m_announcedLineCount = 0;
+        Q_EMIT newLineCountChanged();
+    }
+}
+
+/**
+ * Registers the given @a text so that it is added to the console view the next time
+ * that the display timer expires. Delaying the insertion of received text allows us to
+ * add all the data chunks received during a timer period in a single rendering pass.
  */
 void Widgets::Terminal::insertText(const QString &text)
 {
-    if (widgetEnabled())
-        addText(text, vt100emulation());
+    if (!widgetEnabled())
+        return;
+
+    // Track the ingest rate for the load-shedding logic
+    m_ingestChars += text.length();
+
+    // While the display is paused, the text is only counted for the banner,
+    // the full data is already retained by the IO::Console capture ring &
+    // the view re-synchronizes with it on resume
+    if (m_paused)
+        m_capturedChars += text.length();
+
+    // The user is scrolled back inspecting earlier output, laying out the
+    // arriving tail would only fight the scroll position, so the text is
+    // only counted; the view re-synchronizes with the capture ring when the
+    // user jumps back to the tail (see setAutoscroll())
+    else if (!autoscroll())
+        m_newLineCount += text.count(QChar('\n'));
+
+    else
+        m_pendingText.append(text);
 }
 
 /**
- * Changes the word wrap mode of the text editor.
- *
- * This property holds the mode QPlainTextEdit will use when wrapping text by words.
+ * Stores the word wrap mode configured by the QML layer. The console view
+ * always wraps text at the column count of its character grid.
  */
 void Widgets::Terminal::setWordWrapMode(const int mode)
 {
-    m_textEdit.setWordWrapMode(static_cast<QTextOption::WrapMode>(mode));
+    m_wordWrapMode = mode;
     updateScrollbarVisibility();
     requestRepaint();
 
@@ -405,14 +503,12 @@ void Widgets::Terminal::setWordWrapMode(const int mode)
 }
 
 /**
- * If set to true, the plain text edit scrolls the document vertically to make the cursor
- * visible at the center of the viewport. This also allows the text edit to scroll below
- * the end of the document. Otherwise, if set to false, the plain text edit scrolls the
- * smallest amount possible to ensure the cursor is visible.
+ * Stores the center-on-scroll flag configured by the QML layer, the value has
+ * no effect on the console view.
  */
 void Widgets::Terminal::setCenterOnScroll(const bool enabled)
 {
-    m_textEdit.setCenterOnScroll(enabled);
+    m_centerOnScroll = enabled;
     requestRepaint();
 
     Q_EMIT centerOnScrollChanged();
@@ -430,51 +526,35 @@ void Widgets::Terminal::setVt100Emulation(const bool enabled)
 }
 
 /**
- * Enables/disables undo/redo history support.
+ * Stores the undo/redo flag configured by the QML layer, the console view is
+ * not editable so the value has no effect.
  */
 void Widgets::Terminal::setUndoRedoEnabled(const bool enabled)
 {
-    m_textEdit.setUndoRedoEnabled(enabled);
+    m_undoRedoEnabled = enabled;
     requestRepaint();
 
     Q_EMIT undoRedoEnabledChanged();
 }
 
 /**
- * Changes the placeholder text of the text editor. The placeholder text is only displayed
- * when the document is empty.
+ * Changes the placeholder text of the console view. The placeholder text is only
+ * displayed when the view is empty.
  */
 void Widgets::Terminal::setPlaceholderText(const QString &text)
 {
-    m_textEdit.setPlaceholderText(text);
+    m_view.setPlaceholderText(text);
     requestRepaint();
 
     Q_EMIT placeholderTextChanged();
 }
 
 /**
- * Moves the position of the vertical scrollbar to the end of the document.
+ * Moves the position of the vertical scrollbar to the end of the view.
  */
 void Widgets::Terminal::scrollToBottom(const bool repaint)
 {
-    // Get scrollbar pointer, calculate line count & visible text lines
-    auto *bar = m_textEdit.verticalScrollBar();
-    auto lineCount = m_textEdit.document()->blockCount();
-    auto visibleLines = qRound(height() / m_textEdit.fontMetrics().height());
-
-    // Abort operation if control is not visible
-    if (visibleLines <= 0)
-        return;
-
-    // Update scrolling range
-    bar->setMinimum(0);
-    bar->setMaximum(lineCount);
-
-    // Do not scroll to bottom if all text fits in current window
-    if (lineCount > visibleLines)
-        bar->setValue(lineCount - visibleLines + 2);
-    else
-        bar->setValue(0);
+    m_view.scrollToBottom();
 
     // Trigger UI repaint
     if (repaint)
@@ -482,16 +562,15 @@ void Widgets::Terminal::scrollToBottom(const bool repaint)
 }
 
 /**
- * Specifies the maximum number of blocks the document may have. If there are more blocks
- * in the document that specified with this property blocks are removed from the beginning
- * of the document.
+ * Specifies the maximum number of lines the view may retain. If more lines are
+ * appended, lines are removed from the beginning of the view.
  *
- * A negative or zero value specifies that the document may contain an unlimited amount of
- * blocks.
+ * A negative or zero value specifies that the view may retain an unlimited amount of
+ * lines.
  */
 void Widgets::Terminal::setMaximumBlockCount(const int maxBlockCount)
 {
-    m_textEdit.setMaximumBlockCount(maxBlockCount);
+    m_view.setMaximumLineCount(maxBlockCount);
     requestRepaint();
 
     Q_EMIT maximumBlockCountChanged();
@@ -500,17 +579,86 @@ void Widgets::Terminal::setMaximumBlockCount(const int maxBlockCount)
 /**
  * Redraws the widget. This function is called by a timer to reduce the number of paint
  * requests (and thus avoid considerable slow-downs).
+ *
+ * The function also inserts all the text received since the last timer expiration in
+ * a single operation & only re-uploads the rows of the character grid that actually
+ * changed to the scenegraph.
  */
 void Widgets::Terminal::repaint()
 {
+    // Insert the text received since the last timeout
+    if (!m_pendingText.isEmpty())
+    {
+        addText(m_pendingText, vt100emulation());
+        m_pendingText.clear();
+    }
+
+    // Repaint the widget (if needed)
     if (m_repaint)
     {
         m_repaint = false;
-        update();
+        update(m_view.dirtyRect());
 
         if (m_textChanged)
             Q_EMIT textChanged();
     }
+
+    // Refresh the new-line counter displayed by the QML layer at the same
+    // cadence as the display instead of once per received chunk
+    if (m_newLineCount != m_announcedLineCount)
+    {
+        m_announcedLineCount = m_newLineCount;
+        Q_EMIT newLineCountChanged();
+    }
+}
+
+/**
+ * Load-shedding logic, called once per second. When a device floods the
+ * console faster than the grid can reasonably render, the display freezes
+ * on the current view & a banner reports how much data has been captured in
+ * the meantime; once the data rate drops, the view re-synchronizes with the
+ * tail of the @c IO::Console capture ring. Capture, export & the scrollback
+ * ring are unaffected by the pause, so no data is ever lost.
+ */
+void Widgets::Terminal::evaluateIngestRate()
+{
+    // Freeze the display when the ingest rate exceeds the threshold
+    if (!m_paused && m_ingestChars > kPauseThresholdChars)
+    {
+        m_paused = true;
+        m_capturedChars = 0;
+
+        // Drop the text queued for display, it is already stored in the
+        // capture ring & re-loaded from there on resume
+        m_pendingText.clear();
+        updatePauseBanner();
+    }
+
+    // Already paused, resume when the flood is over or refresh the banner
+    else if (m_paused)
+    {
+        if (m_ingestChars < kResumeThresholdChars)
+        {
+            m_paused = false;
+            m_view.setBannerText(QString());
+            setText(IO::Console::instance().text());
+
+            // The view was re-synchronized with the full capture ring, the
+            // lines counted while scrolled back are already displayed
+            if (m_newLineCount > 0)
+            {
+                m_newLineCount = 0;
+                m_announcedLineCount = 0;
+                Q_EMIT newLineCountChanged();
+            }
+        }
+
+        else
+            updatePauseBanner();
+    }
+
+    // Restart the per-second ingest counter
+    m_ingestChars = 0;
 }
 
 /**
@@ -518,22 +666,18 @@ void Widgets::Terminal::repaint()
  */
 void Widgets::Terminal::updateScrollbarVisibility()
 {
-    // Get current line count & visible lines
-    auto lineCount = m_textEdit.document()->blockCount();
-    auto visibleLines = qCeil(height() / m_textEdit.fontMetrics().height());
-
     // Autoscroll enabled or text content is less than widget height
-    if (autoscroll() || visibleLines >= lineCount)
-        m_textEdit.setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    if (autoscroll() || m_view.visibleRows() >= m_view.rowCount())
+        m_view.setScrollBarVisible(false);
 
     // Show the scrollbar if the text content is greater than the widget height
     else
-        m_textEdit.setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+        m_view.setScrollBarVisible(true);
 }
 
 /**
- * Updates the value of copy-available. This function is automatically called by the text
- * editor widget when the user makes any text selection/deselection.
+ * Updates the value of copy-available. This function is automatically called by the
+ * console view when the user makes any text selection/deselection.
  */
 void Widgets::Terminal::setCopyAvailable(const bool yes)
 {
@@ -543,24 +687,20 @@ void Widgets::Terminal::setCopyAvailable(const bool yes)
 
 /**
  * Inserts the given @a text directly, no additional line breaks added.
+ *
+ * When VT-100 emulation is enabled, the text is run through the escape code
+ * handler & inserted as styled spans, so ANSI-colored firmware logs are
+ * rendered with their colors instead of the raw escape bytes.
  */
 void Widgets::Terminal::addText(const QString &text, const bool enableVt100)
 {
-    // Get text to insert
-    QString textToInsert = text;
+    // Add text at the end of the character grid, lines that exceed the maximum
+    // line count of the view are automatically removed from its beginning,
+    // older output can still be inspected through loadScrollback()
     if (enableVt100)
-        textToInsert = vt100Processing(text);
-
-    // Clear terminal scrollback after 10000 lines
-    if (m_textEdit.blockCount() >= 10000)
-        m_textEdit.clear();
-
-    // Add text at the end of the text document
-    QTextCursor cursor(m_textEdit.document());
-    cursor.beginEditBlock();
-    cursor.movePosition(QTextCursor::End);
-    cursor.insertText(textToInsert);
-    cursor.endEditBlock();
+        m_view.append(m_escapeCodeHandler.parseText(FormattedText(text)));
+    else
+        m_view.append(text);
 
     // Autoscroll to bottom (if needed)
     updateScrollbarVisibility();
@@ -572,50 +712,53 @@ void Widgets::Terminal::addText(const QString &text, const bool enableVt100)
 }
 
 /**
- * Enables the re-paint flag, which is later used by the @c repaint() function to know
- * if the widget shall be repainted.
+ * Updates the banner displayed while console rendering is paused with the
+ * amount of data captured since the pause started.
  */
-void Widgets::Terminal::requestRepaint(const bool textChanged)
+void Widgets::Terminal::updatePauseBanner()
 {
-    m_repaint = true;
-    m_textChanged = textChanged;
+    const double megabytes = double(m_capturedChars) / (1024.0 * 1024.0);
+    m_view.setBannerText(tr("Console paused, %1 MB captured")
+                             .arg(QString::number(megabytes, 'f', 1)));
+    requestRepaint();
 }
 
 /**
- * Processes the given @a data to remove the escape sequences from the text using code
- * from Qt Creator output terminal. Check the next code block for more info.
+ * Re-applies the line count limit that was lifted by @c loadScrollback(), so that
+ * the console view behaves as a sliding window over the latest data again.
  */
-QString Widgets::Terminal::vt100Processing(const QString &data)
+void Widgets::Terminal::restoreMaximumBlockCount()
 {
-    auto formattedText = m_escapeCodeHandler.parseText(FormattedText(data));
-    const QString cleanLine = std::accumulate(
-        formattedText.begin(), formattedText.end(), QString(),
-        [](const FormattedText &t1, const FormattedText &t2) -> QString {
-            return t1.text + t2.text;
-        });
-    m_escapeCodeHandler.endFormatScope();
+    if (m_scrollbackBlockCount > 0)
+    {
+        m_view.setMaximumLineCount(m_scrollbackBlockCount);
+        m_scrollbackBlockCount = 0;
+    }
+}
 
-    return cleanLine;
+/**
+ * Enables the re-paint flag, which is later used by the @c repaint() function to know
+ * if the widget shall be repainted.
+ */
+void Widgets::Terminal::requestRepaint(const bool textChanged)
+{
+    m_repaint = true;
+    m_textChanged = textChanged;
 }
 
 //----------------------------------------------------------------------------------------
-// VT-100 / ANSI terminal hacks
+// VT-100 / ANSI escape sequence handling, the SGR color mappings follow the
+// Qt Creator output terminal:
 // https://code.qt.io/cgit/qt-creator/qt-creator.git/tree/src/libs/utils/ansiescapecodehandler.cpp
-//---------------------------------------------------------º-----------------------------------------
-
-#define QTC_ASSERT(cond, action)                                                         \
-    if (Q_LIKELY(cond)) { }                                                              \
-    else                                                                                 \
-    {                                                                                    \
-        action;                                                                          \
-    }                                                                                    \
-    do                                                                                   \
-    {                                                                                    \
-    } while (0)
+//----------------------------------------------------------------------------------------
 
-static QColor ansiColor(uint code)
+/**
+ * Returns the color of one of the 8 standard low-intensity ANSI colors
+ */
+static QColor AnsiColor(const uint code)
 {
-    QTC_ASSERT(code < 8, return QColor());
+    if (code >= 8)
+        return QColor();
 
     const int red = code & 1 ? 170 : 0;
     const int green = code & 2 ? 170 : 0;
@@ -623,312 +766,382 @@ static QColor ansiColor(uint code)
     return QColor(red, green, blue);
 }
 
+/**
+ * Splits the given @a input chunk into styled text spans & strips/executes
+ * the ANSI escape sequences found in it.
+ *
+ * The parser walks the chunk exactly once with a per-byte state machine
+ * (see @c State), so no intermediate string copies are made on the console
+ * hot path. The character format selected by the SGR codes stays active
+ * until it is changed or reset, even across chunk boundaries; incomplete
+ * control sequences at the end of a chunk are buffered & re-parsed when the
+ * next chunk arrives.
+ */
 QVector<Widgets::FormattedText>
 Widgets::AnsiEscapeCodeHandler::parseText(const FormattedText &input)
 {
-    enum AnsiEscapeCodes
-    {
-        ResetFormat = 0,
-        BoldText = 1,
-        TextColorStart = 30,
-        TextColorEnd = 37,
-        RgbTextColor = 38,
-        DefaultTextColor = 39,
-        BackgroundColorStart = 40,
-        BackgroundColorEnd = 47,
-        RgbBackgroundColor = 48,
-        DefaultBackgroundColor = 49
-    };
-
-    const QString escape = "\x1b[";
-    const QChar semicolon = ';';
-    const QChar colorTerminator = 'm';
-    const QChar eraseToEol = 'K';
+    const QChar kEscape = QChar(0x1b);
+    const QChar kBell = QChar(0x07);
 
     QVector<FormattedText> outputData;
-    QTextCharFormat charFormat = m_previousFormatClosed ? input.format : m_previousFormat;
-    QString strippedText;
-    if (m_pendingText.isEmpty())
-        strippedText = input.text;
 
+    // Continue with the format left open by the previous chunk, SGR state
+    // persists until the firmware resets it
+    QTextCharFormat charFormat
+        = m_previousFormatClosed ? input.format : m_previousFormat;
+
+    // Prepend the unterminated escape sequence of the previous chunk
+    QString text;
+    if (m_pendingText.isEmpty())
+        text = input.text;
     else
     {
-        strippedText = m_pendingText.append(input.text);
+        text = m_pendingText + input.text;
         m_pendingText.clear();
     }
 
-    while (!strippedText.isEmpty())
+    // Process the chunk byte by byte
+    int i = 0;
+    int spanStart = 0;
+    int sequenceStart = 0;
+    const int length = text.length();
+    while (i < length)
     {
-        QTC_ASSERT(m_pendingText.isEmpty(), break);
-        if (m_waitingForTerminator)
-        {
-            // We ignore all escape codes taking string arguments.
-            QString terminator = "\x1b\\";
-            int terminatorPos = strippedText.indexOf(terminator);
-            if (terminatorPos == -1 && !m_alternateTerminator.isEmpty())
-            {
-                terminator = m_alternateTerminator;
-                terminatorPos = strippedText.indexOf(terminator);
-            }
-            if (terminatorPos == -1)
-            {
-                m_pendingText = strippedText;
-                break;
-            }
-            m_waitingForTerminator = false;
-            m_alternateTerminator.clear();
-            strippedText.remove(0, terminatorPos + terminator.length());
-            if (strippedText.isEmpty())
-                break;
-        }
-        const int escapePos = strippedText.indexOf(escape.at(0));
-        if (escapePos < 0)
-        {
-            outputData << FormattedText(strippedText, charFormat);
-            break;
-        }
-        else if (escapePos != 0)
+        const QChar c = text.at(i);
+        switch (m_state)
         {
-            outputData << FormattedText(strippedText.left(escapePos), charFormat);
-            strippedText.remove(0, escapePos);
-        }
-        QTC_ASSERT(strippedText.at(0) == escape.at(0), break);
+            // Printable data, flush the current span when an escape
+            // character is found
+            case TextState:
+                if (c == kEscape)
+                {
+                    if (i > spanStart)
+                        outputData << FormattedText(
+                            text.mid(spanStart, i - spanStart), charFormat);
 
-        while (!strippedText.isEmpty() && escape.at(0) == strippedText.at(0))
-        {
-            if (escape.startsWith(strippedText))
-            {
-                // control secquence is not complete
-                m_pendingText += strippedText;
-                strippedText.clear();
+                    sequenceStart = i;
+                    m_state = EscapeState;
+                }
+
+                ++i;
                 break;
-            }
-            if (!strippedText.startsWith(escape))
-            {
-                switch (strippedText.at(1).toLatin1())
+
+            // Dispatch on the byte following the escape character
+            case EscapeState:
+                switch (c.toLatin1())
                 {
-                    case '\\': // Unexpected terminator sequence.
-                        Q_FALLTHROUGH();
-                    case 'N':
-                    case 'O': // Ignore unsupported single-character sequences.
-                        strippedText.remove(0, 2);
+                    // Control sequence introducer
+                    case '[':
+                        m_parameter = -1;
+                        m_parameters.clear();
+                        m_state = CsiState;
+                        ++i;
                         break;
+
+                    // Operating system command, terminated by BEL or ST
                     case ']':
-                        m_alternateTerminator = QChar(7);
-                        Q_FALLTHROUGH();
+                        m_stringEscSeen = false;
+                        m_stringTerminatedByBell = true;
+                        m_state = StringState;
+                        ++i;
+                        break;
+
+                    // Sequences with string arguments, terminated by ST
                     case 'P':
                     case 'X':
                     case '^':
                     case '_':
-                        strippedText.remove(0, 2);
-                        m_waitingForTerminator = true;
+                        m_stringEscSeen = false;
+                        m_stringTerminatedByBell = false;
+                        m_state = StringState;
+                        ++i;
                         break;
+
+                    // Ignore unsupported single-character sequences
+                    case '\\':
+                    case 'N':
+                    case 'O':
+                        m_state = TextState;
+                        spanStart = i + 1;
+                        ++i;
+                        break;
+
+                    // Not a control sequence, print the escape character &
+                    // re-process the current byte as text
                     default:
-                        // not a control sequence
-                        m_pendingText.clear();
-                        outputData << FormattedText(strippedText.left(1), charFormat);
-                        strippedText.remove(0, 1);
-                        continue;
+                        outputData << FormattedText(QString(kEscape), charFormat);
+                        m_state = TextState;
+                        spanStart = i;
+                        break;
                 }
                 break;
-            }
 
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-            m_pendingText += strippedText.midRef(0, escape.length());
-#else
-            m_pendingText
-                += QStringView { strippedText }.mid(0, escape.length()).toString();
-#endif
+            // Accumulate the numeric parameters & dispatch the control
+            // function selected by the final byte
+            case CsiState:
+                if (c.isDigit())
+                {
+                    m_parameter = qMax(0, m_parameter) * 10 + c.digitValue();
+                    ++i;
+                }
 
-            strippedText.remove(0, escape.length());
+                else if (c == QChar(';'))
+                {
+                    m_parameters.append(qMax(0, m_parameter));
+                    m_parameter = -1;
+                    ++i;
+                }
 
-            // Get stripped text in uppercase
-            auto upperCase = strippedText.toUpper();
+                // Private parameter/intermediate markers (e.g. "\e[?25l")
+                else if (c == QChar('?') || c == QChar('<') || c == QChar('=')
+                         || c == QChar('>') || c == QChar(':'))
+                    ++i;
 
-            // Clear line
-            if (upperCase.contains("2K"))
-            {
-                textEdit->setFocus();
-                auto storedCursor = textEdit->textCursor();
-                textEdit->moveCursor(QTextCursor::End, QTextCursor::MoveAnchor);
-                textEdit->moveCursor(QTextCursor::StartOfLine, QTextCursor::MoveAnchor);
-                textEdit->moveCursor(QTextCursor::End, QTextCursor::KeepAnchor);
-                textEdit->textCursor().removeSelectedText();
-                textEdit->textCursor().deletePreviousChar();
-                textEdit->setTextCursor(storedCursor);
-                return outputData;
-            }
+                else
+                {
+                    // Register the last parameter
+                    if (m_parameter >= 0)
+                        m_parameters.append(m_parameter);
+                    m_parameter = -1;
 
-            // Clear screen
-            if (upperCase.contains("2J"))
-            {
-                textEdit->clear();
-                return QVector<FormattedText>();
-            }
+                    // Execute the control function
+                    switch (c.toLatin1())
+                    {
+                        // Select graphic rendition
+                        case 'm':
+                            applySgrCodes(input.format, charFormat);
+                            break;
 
-            // \e[K is not supported. Just strip it.
-            if (strippedText.startsWith(eraseToEol))
-            {
-                m_pendingText.clear();
-                strippedText.remove(0, 1);
-                continue;
-            }
-            // get the number
-            QString strNumber;
-            StringList numbers;
-            while (!strippedText.isEmpty())
-            {
-                if (strippedText.at(0).isDigit())
-                {
-                    strNumber += strippedText.at(0);
+                        // Clear screen
+                        case 'J':
+                            if (m_parameters.contains(2) && m_view)
+                            {
+                                m_view->clear();
+                                outputData.clear();
+                            }
+                            break;
+
+                        // Clear current line, other erase modes & the
+                        // remaining cursor functions are stripped (the
+                        // terminal is an append-only log view)
+                        case 'K':
+                            if (m_parameters.contains(2) && m_view)
+                                m_view->clearCurrentLine();
+                            break;
+
+                        default:
+                            break;
+                    }
+
+                    m_parameters.clear();
+                    m_state = TextState;
+                    spanStart = i + 1;
+                    ++i;
                 }
-                else
+                break;
+
+            // Skip string arguments up to their terminator, the content is
+            // not displayed
+            case StringState:
+                if ((m_stringEscSeen && c == QChar('\\'))
+                    || (m_stringTerminatedByBell && c == kBell))
                 {
-                    if (!strNumber.isEmpty())
-                        numbers << strNumber;
-                    if (strNumber.isEmpty() || strippedText.at(0) != semicolon)
-                        break;
-                    strNumber.clear();
+                    m_state = TextState;
+                    spanStart = i + 1;
                 }
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-                m_pendingText += strippedText.midRef(0, 1);
-#else
-                m_pendingText += QStringView { strippedText }.mid(0, 1).toString();
-#endif
-                strippedText.remove(0, 1);
-            }
-            if (strippedText.isEmpty())
-                break;
 
-            // remove terminating char
-            if (!strippedText.startsWith(colorTerminator))
-            {
-                m_pendingText.clear();
-                strippedText.remove(0, 1);
+                m_stringEscSeen = (c == kEscape);
+                ++i;
                 break;
-            }
-            // got consistent control sequence, ok to clear pending text
-            m_pendingText.clear();
-            strippedText.remove(0, 1);
+        }
+    }
 
-            if (numbers.isEmpty())
-            {
-                charFormat = input.format;
-                endFormatScope();
-            }
+    // Flush the open plain-text span
+    if (m_state == TextState && spanStart < length)
+        outputData << FormattedText(text.mid(spanStart), charFormat);
 
-            for (int i = 0; i < numbers.size(); ++i)
-            {
-                const uint code = numbers.at(i).toUInt();
+    // Buffer incomplete control sequences until the next chunk arrives
+    if (m_state == EscapeState || m_state == CsiState)
+    {
+        m_pendingText = text.mid(sequenceStart);
+        m_state = TextState;
+    }
 
-                if (code >= TextColorStart && code <= TextColorEnd)
-                {
-                    charFormat.setForeground(ansiColor(code - TextColorStart));
+    return outputData;
+}
+
+/**
+ * Applies the SGR codes accumulated in @c m_parameters to the given
+ * @a charFormat; @a baseFormat supplies the colors restored by the
+ * reset/default codes.
+ */
+void Widgets::AnsiEscapeCodeHandler::applySgrCodes(const QTextCharFormat &baseFormat,
+                                                   QTextCharFormat &charFormat)
+{
+    enum AnsiEscapeCodes
+    {
+        ResetFormat = 0,
+        BoldText = 1,
+        TextColorStart = 30,
+        TextColorEnd = 37,
+        RgbTextColor = 38,
+        DefaultTextColor = 39,
+        BackgroundColorStart = 40,
+        BackgroundColorEnd = 47,
+        RgbBackgroundColor = 48,
+        DefaultBackgroundColor = 49,
+        BrightTextColorStart = 90,
+        BrightTextColorEnd = 97,
+        BrightBackgroundColorStart = 100,
+        BrightBackgroundColorEnd = 107
+    };
+
+    // "\e[m" is equivalent to a format reset
+    if (m_parameters.isEmpty())
+    {
+        charFormat = baseFormat;
+        endFormatScope();
+        return;
+    }
+
+    for (int i = 0; i < m_parameters.count(); ++i)
+    {
+        const int code = m_parameters.at(i);
+
+        // Standard low-intensity colors
+        if (code >= TextColorStart && code <= TextColorEnd)
+        {
+            charFormat.setForeground(AnsiColor(code - TextColorStart));
+            setFormatScope(charFormat);
+        }
+
+        else if (code >= BackgroundColorStart && code <= BackgroundColorEnd)
+        {
+            charFormat.setBackground(AnsiColor(code - BackgroundColorStart));
+            setFormatScope(charFormat);
+        }
+
+        // Standard high-intensity colors
+        else if (code >= BrightTextColorStart && code <= BrightTextColorEnd)
+        {
+            charFormat.setForeground(
+                AnsiColor(code - BrightTextColorStart).lighter(150));
+            setFormatScope(charFormat);
+        }
+
+        else if (code >= BrightBackgroundColorStart
+                 && code <= BrightBackgroundColorEnd)
+        {
+            charFormat.setBackground(
+                AnsiColor(code - BrightBackgroundColorStart).lighter(150));
+            setFormatScope(charFormat);
+        }
+
+        else
+        {
+            switch (code)
+            {
+                case ResetFormat:
+                    charFormat = baseFormat;
+                    endFormatScope();
+                    break;
+                case BoldText:
+                    charFormat.setFontWeight(QFont::Bold);
                     setFormatScope(charFormat);
-                }
-                else if (code >= BackgroundColorStart && code <= BackgroundColorEnd)
-                {
-                    charFormat.setBackground(ansiColor(code - BackgroundColorStart));
+                    break;
+                case DefaultTextColor:
+                    charFormat.setForeground(baseFormat.foreground());
                     setFormatScope(charFormat);
-                }
-                else
-                {
-                    switch (code)
+                    break;
+                case DefaultBackgroundColor:
+                    charFormat.setBackground(baseFormat.background());
+                    setFormatScope(charFormat);
+                    break;
+                case RgbTextColor:
+                case RgbBackgroundColor:
+                    // See http://en.wikipedia.org/wiki/ANSI_escape_code#Colors
+                    if (++i >= m_parameters.count())
+                        break;
+                    switch (m_parameters.at(i))
                     {
-                        case ResetFormat:
-                            charFormat = input.format;
-                            endFormatScope();
-                            break;
-                        case BoldText:
-                            charFormat.setFontWeight(QFont::Bold);
-                            setFormatScope(charFormat);
-                            break;
-                        case DefaultTextColor:
-                            charFormat.setForeground(input.format.foreground());
-                            setFormatScope(charFormat);
-                            break;
-                        case DefaultBackgroundColor:
-                            charFormat.setBackground(input.format.background());
-                            setFormatScope(charFormat);
+                        // RGB set with format: 38;2;<r>;<g>;<b>
+                        case 2:
+                            if ((i + 3) < m_parameters.count())
+                            {
+                                const QColor color(m_parameters.at(i + 1),
+                                                   m_parameters.at(i + 2),
+                                                   m_parameters.at(i + 3));
+                                if (code == RgbTextColor)
+                                    charFormat.setForeground(color);
+                                else
+                                    charFormat.setBackground(color);
+                                setFormatScope(charFormat);
+                            }
+                            i += 3;
                             break;
-                        case RgbTextColor:
-                        case RgbBackgroundColor:
-                            // See http://en.wikipedia.org/wiki/ANSI_escape_code#Colors
-                            if (++i >= numbers.size())
-                                break;
-                            switch (numbers.at(i).toInt())
+
+                        // 256 color mode with format: 38;5;<i>
+                        case 5:
+                            if (++i < m_parameters.count())
                             {
-                                case 2:
-                                    // RGB set with format: 38;2;<r>;<g>;<b>
-                                    if ((i + 3) < numbers.size())
-                                    {
-                                        (code == RgbTextColor)
-                                            ? charFormat.setForeground(
-                                                QColor(numbers.at(i + 1).toInt(),
-                                                       numbers.at(i + 2).toInt(),
-                                                       numbers.at(i + 3).toInt()))
-                                            : charFormat.setBackground(
-                                                QColor(numbers.at(i + 1).toInt(),
-                                                       numbers.at(i + 2).toInt(),
-                                                       numbers.at(i + 3).toInt()));
-                                        setFormatScope(charFormat);
-                                    }
-                                    i += 3;
-                                    break;
-                                case 5:
-                                    // 256 color mode with format: 38;5;<i>
-                                    uint index = numbers.at(i + 1).toUInt();
-
-                                    QColor color;
-                                    if (index < 8)
-                                    {
-                                        // The first 8 colors are standard low-intensity
-                                        // ANSI colors.
-                                        color = ansiColor(index);
-                                    }
-                                    else if (index < 16)
-                                    {
-                                        // The next 8 colors are standard high-intensity
-                                        // ANSI colors.
-                                        color = ansiColor(index - 8).lighter(150);
-                                    }
-                                    else if (index < 232)
-                                    {
-                                        // The next 216 colors are a 6x6x6 RGB cube.
-                                        uint o = index - 16;
-                                        color = QColor((o / 36) * 51, ((o / 6) % 6) * 51,
-                                                       (o % 6) * 51);
-                                    }
-                                    else
-                                    {
-                                        // The last 24 colors are a greyscale gradient.
-                                        int grey = int((index - 232) * 11);
-                                        color = QColor(grey, grey, grey);
-                                    }
-
-                                    if (code == RgbTextColor)
-                                        charFormat.setForeground(color);
-                                    else
-                                        charFormat.setBackground(color);
-
-                                    setFormatScope(charFormat);
-                                    ++i;
-                                    break;
+                                const uint index = m_parameters.at(i);
+
+                                QColor color;
+
+                                // The first 8 colors are standard
+                                // low-intensity ANSI colors
+                                if (index < 8)
+                                    color = AnsiColor(index);
+
+                                // The next 8 colors are standard
+                                // high-intensity ANSI colors
+                                else if (index < 16)
+                                    color = AnsiColor(index - 8).lighter(150);
+
+                                // The next 216 colors are a 6x6x6 RGB cube
+                                else if (index < 232)
+                                {
+                                    const uint o = index - 16;
+                                    color = QColor((o / 36) * 51,
+                                                   ((o / 6) % 6) * 51,
+                                                   (o % 6) * 51);
+                                }
+
+                                // The last 24 colors are a greyscale gradient
+                                else
+                                {
+                                    const int grey = int((index - 232) * 11);
+                                    color = QColor(grey, grey, grey);
+                                }
+
+                                if (code == RgbTextColor)
+                                    charFormat.setForeground(color);
+                                else
+                                    charFormat.setBackground(color);
+
+                                setFormatScope(charFormat);
                             }
                             break;
+
                         default:
                             break;
                     }
-                }
+                    break;
+
+                default:
+                    break;
             }
         }
     }
-    return outputData;
 }
 
-void Widgets::AnsiEscapeCodeHandler::setTextEdit(QPlainTextEdit *widget)
+/**
+ * Changes the console view manipulated by the clear-line & clear-screen
+ * control functions.
+ */
+void Widgets::AnsiEscapeCodeHandler::setView(ConsoleView *view)
 {
-    textEdit = widget;
+    m_view = view;
 }
 
 void Widgets::AnsiEscapeCodeHandler::endFormatScope()
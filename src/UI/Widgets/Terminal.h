@@ -22,42 +22,59 @@
 
 #pragma once
 
-#include <QPlainTextEdit>
 #include <UI/DeclarativeWidget.h>
+#include <UI/Widgets/Common/ConsoleView.h>
 
 namespace Widgets
 {
-class FormattedText
-{
-public:
-    FormattedText() = default;
-    FormattedText(const FormattedText &other) = default;
-    FormattedText(const QString &txt, const QTextCharFormat &fmt = QTextCharFormat())
-        : text(txt)
-        , format(fmt)
-    {
-    }
-
-    QString text;
-    QTextCharFormat format;
-};
-
+/**
+ * @brief The AnsiEscapeCodeHandler class
+ *
+ * Incremental ANSI/VT-100 escape sequence parser implemented as a per-byte
+ * state machine. @c parseText() splits an input chunk into styled spans with
+ * the character format implied by the SGR ("select graphic rendition") codes
+ * seen so far, strips the escape sequences from the text & executes the few
+ * control functions that make sense in an append-only log view (clear line,
+ * clear screen). The parser state persists across calls, so sequences may be
+ * split at arbitrary chunk boundaries.
+ */
 class AnsiEscapeCodeHandler
 {
 public:
     QVector<FormattedText> parseText(const FormattedText &input);
-    void setTextEdit(QPlainTextEdit *widget);
+    void setView(ConsoleView *view);
     void endFormatScope();
 
 private:
     void setFormatScope(const QTextCharFormat &charFormat);
+    void applySgrCodes(const QTextCharFormat &baseFormat,
+                       QTextCharFormat &charFormat);
+
+    /**
+     * Parser states, one per escape sequence family: @c TextState consumes
+     * printable data, @c EscapeState dispatches on the byte after ESC,
+     * @c CsiState accumulates the parameters & final byte of a control
+     * sequence & @c StringState skips string arguments (OSC, DCS, etc.) up
+     * to their terminator.
+     */
+    enum State
+    {
+        TextState,
+        EscapeState,
+        CsiState,
+        StringState
+    };
+
+    State m_state = TextState;
+    int m_parameter = -1;
+    QVector<int> m_parameters;
+    bool m_stringEscSeen = false;
+    bool m_stringTerminatedByBell = false;
 
     QString m_pendingText;
-    QPlainTextEdit *textEdit;
-    QString m_alternateTerminator;
+    ConsoleView *m_view = nullptr;
     QTextCharFormat m_previousFormat;
     bool m_previousFormatClosed = true;
-    bool m_waitingForTerminator = false;
 };
 
 class Terminal : public UI::DeclarativeWidget
@@ -122,6 +139,9 @@ class Terminal : public UI::DeclarativeWidget
                READ vt100emulation
                WRITE setVt100Emulation
                NOTIFY vt100EmulationChanged)
+    Q_PROPERTY(int newLineCount
+               READ newLineCount
+               NOTIFY newLineCountChanged)
     // clang-format on
 
 Q_SIGNALS:
@@ -137,6 +157,7 @@ Q_SIGNALS:
     void centerOnScrollChanged();
     void vt100EmulationChanged();
     void placeholderTextChanged();
+    void newLineCountChanged();
     void undoRedoEnabledChanged();
     void maximumBlockCountChanged();
 
@@ -158,8 +179,8 @@ public:
     bool vt100emulation() const;
     bool undoRedoEnabled() const;
     int maximumBlockCount() const;
+    int newLineCount() const;
     QString placeholderText() const;
-    QTextDocument *document() const;
 
 public Q_SLOTS:
     void copy();
@@ -170,6 +191,7 @@ public Q_SLOTS:
     void setFont(const QFont &font);
     void append(const QString &text);
     void setText(const QString &text);
+    void loadScrollback();
     void insertText(const QString &text);
     void setWordWrapMode(const int mode);
     void setAutoscroll(const bool enabled);
@@ -185,22 +207,40 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void repaint();
+    void evaluateIngestRate();
     void updateScrollbarVisibility();
     void setCopyAvailable(const bool yes);
     void addText(const QString &text, const bool enableVt100);
 
 private:
-    QString vt100Processing(const QString &data);
+    void updatePauseBanner();
+    void restoreMaximumBlockCount();
     void requestRepaint(const bool textChanged = false);
 
 private:
+    int m_scrollbackBlockCount;
+
+    bool m_paused;
+    qint64 m_ingestChars;
+    qint64 m_capturedChars;
+
+    // Number of lines that arrived while the user was scrolled back in the
+    // view, layout of the tail is suspended until the user jumps back to it
+    int m_newLineCount;
+    int m_announcedLineCount;
+
     bool m_repaint;
+    bool m_readOnly;
     bool m_autoscroll;
     bool m_textChanged;
     bool m_emulateVt100;
     bool m_copyAvailable;
+    bool m_centerOnScroll;
+    bool m_undoRedoEnabled;
+    int m_wordWrapMode;
 
-    QPlainTextEdit m_textEdit;
+    QString m_pendingText;
+    ConsoleView m_view;
     AnsiEscapeCodeHandler m_escapeCodeHandler;
 };
 }
@@ -28,7 +28,9 @@
 
 #include <AppInfo.h>
 #include <JSON/Frame.h>
+#include <PgoTraining.h>
 #include <Misc/Utilities.h>
+#include <Misc/ThreadPolicy.h>
 #include <Misc/ModuleManager.h>
 
 #ifdef Q_OS_WIN
@@ -85,6 +87,13 @@ int main(int argc, char **argv)
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 #endif
 
+    // Render every top-level QML window from its own render thread, so that a
+    // heavy dashboard window on one monitor (e.g. a detached plot wall) cannot
+    // drop the frames of the other windows. Users can still select another
+    // render loop through the environment.
+    if (qEnvironmentVariableIsEmpty("QSG_RENDER_LOOP"))
+        qputenv("QSG_RENDER_LOOP", "threaded");
+
     // Init. application
     QApplication app(argc, argv);
     app.setApplicationName(APP_NAME);
@@ -102,6 +111,7 @@ int main(int argc, char **argv)
         arguments = app.arguments().at(1);
 
     // There are some CLI arguments, read them
+    bool headless = false;
     if (!arguments.isEmpty() && arguments.startsWith("-"))
     {
         if (arguments == "-v" || arguments == "--version")
@@ -115,11 +125,37 @@ int main(int argc, char **argv)
             cliResetSettings();
             return EXIT_SUCCESS;
         }
+
+        // Headless training workload for the PGO build (see Serial-Studio.pro)
+        else if (arguments == "--pgo-train")
+            return runPgoTrainingWorkload();
+
+        // Logging-only mode, the pipeline runs without the QML interface & is
+        // controlled through the plugin bridge socket
+        else if (arguments == "--headless")
+            headless = true;
     }
 
-    // Create module manager
-    Misc::ModuleManager moduleManager;
-    moduleManager.configureUpdater();
+    // Apply the threading policy given on the command line (if any) before any
+    // module starts its worker threads, see Misc::ThreadPolicy for the format
+    for (int i = 1; i < app.arguments().count(); ++i)
+    {
+        const auto &argument = app.arguments().at(i);
+        if (argument.startsWith("--threads="))
+            Misc::ThreadPolicy::instance().setCommandLineSpec(
+                argument.mid(static_cast<int>(qstrlen("--threads="))));
+    }
+
+    // Create module manager, the auto-updater is configured after the first paint
+    // of the main window (see Misc::ModuleManager::runDeferredStartupTasks())
+    Misc::ModuleManager moduleManager(headless);
+
+    // Headless logger, start the pipeline without the user interface
+    if (headless)
+    {
+        moduleManager.initializeHeadless();
+        return app.exec();
+    }
 
     // Initialize QML interface
     moduleManager.registerQmlTypes();